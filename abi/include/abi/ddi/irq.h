@@ -35,6 +35,7 @@
 #ifndef _ABI_DDI_IRQ_H_
 #define _ABI_DDI_IRQ_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 typedef struct {
@@ -116,6 +117,36 @@ typedef enum {
 	 */
 	CMD_PREDICATE,
 
+	/** Masked read-modify-write of an 8-bit register.
+	 *
+	 * tmp = read(addr)
+	 * write(addr, (tmp & ~value) | (scratch[srcarg] & value))
+	 * tmp -> scratch[dstarg]
+	 */
+	CMD_PIO_RMW_8,
+
+	/** Masked read-modify-write of a 16-bit register. */
+	CMD_PIO_RMW_16,
+
+	/** Masked read-modify-write of a 32-bit register. */
+	CMD_PIO_RMW_32,
+
+	/** Subtract value.
+	 *
+	 * scratch[srcarg] - value -> scratch[dstarg]
+	 */
+	CMD_SUB,
+
+	/** Bounded backward jump (for ring acknowledgment loops).
+	 *
+	 * if (scratch[srcarg] != 0)
+	 *  (go back 'value' commands)
+	 *
+	 * The interpreter bounds total command execution, so a
+	 * misprogrammed loop terminates by declining the interrupt.
+	 */
+	CMD_JUMP_NZ,
+
 	/** Accept the interrupt. */
 	CMD_ACCEPT,
 
@@ -137,6 +168,17 @@ typedef struct {
 	irq_pio_range_t *ranges;
 	size_t cmdcount;
 	irq_cmd_t *cmds;
+	/**
+	 * Coalesce notifications: while one notification of this IRQ
+	 * is still undelivered, further interrupts only bump its
+	 * counter and OR their scratch arguments into it instead of
+	 * queueing new calls. Only suitable for drivers whose scratch
+	 * arguments are status bitmasks and whose bottom half polls
+	 * the device for all accumulated events (NIC style); drivers
+	 * whose arguments carry data (e.g. PS/2 bytes) must leave
+	 * this off.
+	 */
+	bool coalesce;
 } irq_code_t;
 
 #endif
@@ -45,6 +45,8 @@ typedef enum event_type {
 	EVENT_FAULT,
 	/** New data available in kernel log */
 	EVENT_KLOG,
+	/** The sysinfo tree has changed */
+	EVENT_SYSINFO_CHANGE,
 	EVENT_END
 } event_type_t;
 
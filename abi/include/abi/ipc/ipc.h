@@ -98,8 +98,26 @@ enum {
 
 	/** Restrict the transfer size if necessary. */
 	IPC_XF_RESTRICT = 1 << 0,
+	/**
+	 * Allow the kernel to pin the sender's pages and copy straight
+	 * from them to the recipient instead of going through a kernel
+	 * bounce buffer. The sender must not modify the buffer until
+	 * the call is answered.
+	 */
+	IPC_XF_ZEROCOPY = 1 << 1,
 };
 
+/** One entry of the batched asynchronous call syscall. */
+typedef struct {
+	/** Call arguments, including the method. */
+	sysarg_t args[IPC_CALL_LEN];
+	/** User-defined label delivered with the answer. */
+	sysarg_t label;
+} ipc_call_batch_entry_t;
+
+/** Maximum number of calls sent by one batch syscall. */
+#define IPC_CALL_BATCH_LIMIT  32
+
 /** User-defined IPC methods */
 enum {
 	IPC_FIRST_USER_METHOD = 1024,
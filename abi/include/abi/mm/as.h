@@ -45,6 +45,12 @@ enum {
 	AS_AREA_CACHEABLE    = 0x08,
 	AS_AREA_GUARD        = 0x10,
 	AS_AREA_LATE_RESERVE = 0x20,
+	/**
+	 * The area shares its frames copy-on-write: writes are
+	 * intercepted and served by private copies of the affected
+	 * pages.
+	 */
+	AS_AREA_COW          = 0x40,
 };
 
 static void *const AS_AREA_ANY = (void *) -1;
@@ -70,6 +76,18 @@ typedef struct {
 	sysarg_t id3;
 } as_area_pager_info_t;
 
+/** Access pattern advice for address space areas */
+typedef enum {
+	/** Default behavior */
+	AS_ADVISE_NORMAL,
+	/** Random access; do not fault ahead */
+	AS_ADVISE_RANDOM,
+	/** Sequential access; fault far ahead */
+	AS_ADVISE_SEQUENTIAL,
+	/** The whole area will be needed soon */
+	AS_ADVISE_WILLNEED
+} as_area_advice_t;
+
 #endif
 
 /** @}
@@ -49,6 +49,7 @@ typedef enum {
 	SYS_THREAD_GET_ID,
 	SYS_THREAD_USLEEP,
 	SYS_THREAD_UDELAY,
+	SYS_THREAD_SET_REALTIME,
 
 	SYS_TASK_GET_ID,
 	SYS_TASK_SET_NAME,
@@ -67,11 +68,14 @@ typedef enum {
 	SYS_AS_AREA_CHANGE_FLAGS,
 	SYS_AS_AREA_GET_INFO,
 	SYS_AS_AREA_DESTROY,
+	SYS_AS_AREA_DISCARD,
+	SYS_AS_AREA_ADVISE,
 
 	SYS_PAGE_FIND_MAPPING,
 
 	SYS_IPC_CALL_ASYNC_FAST,
 	SYS_IPC_CALL_ASYNC_SLOW,
+	SYS_IPC_CALL_ASYNC_BATCH,
 	SYS_IPC_ANSWER_FAST,
 	SYS_IPC_ANSWER_SLOW,
 	SYS_IPC_FORWARD_FAST,
@@ -104,6 +108,7 @@ typedef enum {
 	SYS_SYSINFO_GET_VALUE,
 	SYS_SYSINFO_GET_DATA_SIZE,
 	SYS_SYSINFO_GET_DATA,
+	SYS_SYSINFO_GET_GENERATION,
 
 	SYS_DEBUG_CONSOLE,
 
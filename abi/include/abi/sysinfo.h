@@ -122,6 +122,9 @@ typedef struct {
 	uint64_t kcycles;       /**< Number of CPU cycles in kernel */
 	bool on_cpu;            /**< Associated with a CPU */
 	unsigned int cpu;       /**< Associated CPU ID (if on_cpu is true) */
+	uint64_t switches;      /**< Number of times dispatched onto a CPU */
+	uint64_t migrations;    /**< Number of times moved to another CPU */
+	uint64_t preemptions;   /**< Number of involuntary preemptions */
 } stats_thread_t;
 
 /** Statistics about a single IPC connection
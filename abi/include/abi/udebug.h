@@ -35,6 +35,8 @@
 #ifndef _ABI_UDEBUG_H_
 #define _ABI_UDEBUG_H_
 
+#include <_bits/native.h>
+
 #define UDEBUG_EVMASK(event)  (1 << ((event) - 1))
 
 typedef enum { /* udebug_method_t */
@@ -150,9 +152,53 @@ typedef enum { /* udebug_method_t */
 	 * - ARG4 - size of receiving buffer in bytes
 	 *
 	 */
-	UDEBUG_M_MEM_READ
+	UDEBUG_M_MEM_READ,
+
+	/** Select which system calls generate events.
+	 *
+	 * The argument is a bitmap with one bit per system call number
+	 * (bit n set means syscall n is traced). An empty bitmap
+	 * removes the filter, i.e. all system calls are traced again.
+	 *
+	 * - ARG2 - source address of the bitmap in the caller's address
+	 *          space
+	 * - ARG3 - size of the bitmap in bytes (0 to remove the filter)
+	 *
+	 */
+	UDEBUG_M_SET_SYSMASK,
+
+	/** Drain the batched trace event buffer.
+	 *
+	 * The first request enables batching: from then on syscall
+	 * events are appended to an in-kernel buffer and the threads
+	 * keep running instead of stopping on every event. The reply
+	 * carries an array of udebug_event_rec_t.
+	 *
+	 * - ARG2 - destination address in the caller's address space
+	 * - ARG3 - size of receiving buffer in bytes
+	 *
+	 * In the reply:
+	 * - ARG2 - number of bytes copied
+	 * - ARG3 - number of events dropped since the last drain
+	 *
+	 */
+	UDEBUG_M_EVENTS_READ
 } udebug_method_t;
 
+/** Buffered trace event record as returned by UDEBUG_M_EVENTS_READ. */
+typedef struct {
+	/** Hash of the thread that generated the event */
+	sysarg_t thread;
+	/** Event type (UDEBUG_EVENT_SYSCALL_B or UDEBUG_EVENT_SYSCALL_E) */
+	sysarg_t etype;
+	/** System call number */
+	sysarg_t sc_id;
+	/** System call return code (end events only) */
+	sysarg_t sc_rc;
+	/** System call arguments */
+	sysarg_t args[6];
+} udebug_event_rec_t;
+
 typedef enum {
 	UDEBUG_EVENT_FINISHED = 1,  /**< Debuging session has finished */
 	UDEBUG_EVENT_STOP,          /**< Stopped on DEBUG_STOP request */
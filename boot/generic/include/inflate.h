@@ -32,5 +32,7 @@
 #include <stddef.h>
 
 extern int inflate(const void *, size_t, void *, size_t);
+extern int inflate_stream(const void *, size_t, void *, size_t, size_t *,
+    size_t *);
 
 #endif
@@ -30,13 +30,16 @@
 /** @file
  * @brief Implementation of inflate decompression
  *
- * A simple inflate implementation (decompression of `deflate' stream as
- * described by RFC 1951) based on puff.c by Mark Adler. It is not optimized
- * for speed but for readability as it is used as part of the bootloader and
- * any miss-optimization might be hard to debug.
+ * An inflate implementation (decompression of `deflate' stream as
+ * described by RFC 1951) based on puff.c by Mark Adler, sped up with
+ * a 64-bit bit buffer refilled in bulk, table-driven Huffman decoding
+ * (with the original bit-by-bit decoder as the fallback for long
+ * codes) and memcpy-based match copies; boot components dominate the
+ * decompression time of the boot image, so the speedup directly cuts
+ * boot latency.
  *
  * All dynamically allocated memory memory is taken from the stack. The
- * stack usage should be typically bounded by 2 KB.
+ * stack usage should be typically bounded by 8 KB.
  *
  * Original copyright notice:
  *
@@ -67,6 +70,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <byteorder.h>
 #include <errno.h>
 #include <memstr.h>
 #include <inflate.h>
@@ -88,6 +92,13 @@
 /** Number of all codes */
 #define MAX_CODE  (MAX_LITLEN + MAX_DIST)
 
+/** Bits resolved by the Huffman lookup table */
+#define HUFF_TBL_BITS  9
+/** Huffman lookup table size */
+#define HUFF_TBL_SIZE  (1 << HUFF_TBL_BITS)
+/** Huffman lookup table index mask */
+#define HUFF_TBL_MASK  (HUFF_TBL_SIZE - 1)
+
 /** Check for input buffer overrun condition */
 #define CHECK_OVERRUN(state) \
 	do { \
@@ -107,7 +118,7 @@ typedef struct {
 	size_t srclen;    /**< Input buffer size */
 	size_t srccnt;    /**< Position in the input buffer */
 
-	uint16_t bitbuf;  /**< Bit buffer */
+	uint64_t bitbuf;  /**< Bit buffer */
 	size_t bitlen;    /**< Number of bits in the bit buffer */
 
 	bool overrun;     /**< Overrun condition */
@@ -119,6 +130,10 @@ typedef struct {
 typedef struct {
 	uint16_t *count;   /**< Array of symbol counts */
 	uint16_t *symbol;  /**< Array of symbols */
+	/** Lookup table resolving codes of up to HUFF_TBL_BITS bits
+	 * in one step ((symbol << 4) | code length entries, zero
+	 * meaning a longer code), or NULL */
+	uint16_t *table;
 } huffman_t;
 
 /** Length codes
@@ -211,21 +226,37 @@ static uint16_t dist_symbol[MAX_DIST] = {
 	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29
 };
 
-/** Huffman code for lengths
+/** Refill the bit buffer
  *
- */
-static huffman_t len_code = {
-	.count = len_count,
-	.symbol = len_symbol
-};
-
-/** Huffman code for distances
+ * Load as many whole input bytes as fit, eight at a time while
+ * enough input remains.
+ *
+ * @param state Inflate state.
  *
  */
-static huffman_t dist_code = {
-	.count = dist_count,
-	.symbol = dist_symbol
-};
+static inline void refill_bits(inflate_state_t *state)
+{
+	if (state->srccnt + sizeof(uint64_t) <= state->srclen) {
+		uint64_t chunk;
+
+		memcpy(&chunk, state->src + state->srccnt, sizeof(chunk));
+		chunk = uint64_t_le2host(chunk);
+
+		state->bitbuf |= chunk << state->bitlen;
+
+		size_t loaded = (63 - state->bitlen) >> 3;
+		state->srccnt += loaded;
+		state->bitlen += loaded << 3;
+		return;
+	}
+
+	while ((state->bitlen <= 56) && (state->srccnt < state->srclen)) {
+		state->bitbuf |=
+		    ((uint64_t) state->src[state->srccnt]) << state->bitlen;
+		state->srccnt++;
+		state->bitlen += 8;
+	}
+}
 
 /** Get bits from the bit buffer
  *
@@ -237,26 +268,21 @@ static huffman_t dist_code = {
  */
 static inline uint16_t get_bits(inflate_state_t *state, size_t cnt)
 {
-	/* Bit accumulator for at least 20 bits */
-	uint32_t val = state->bitbuf;
+	if (state->bitlen < cnt) {
+		refill_bits(state);
 
-	while (state->bitlen < cnt) {
-		if (state->srccnt == state->srclen) {
+		if (state->bitlen < cnt) {
 			state->overrun = true;
 			return 0;
 		}
-
-		/* Load 8 more bits */
-		val |= ((uint32_t) state->src[state->srccnt]) << state->bitlen;
-		state->srccnt++;
-		state->bitlen += 8;
 	}
 
-	/* Update bits in the buffer */
-	state->bitbuf = (uint16_t) (val >> cnt);
+	uint16_t val = (uint16_t) (state->bitbuf & ((1U << cnt) - 1));
+
+	state->bitbuf >>= cnt;
 	state->bitlen -= cnt;
 
-	return ((uint16_t) (val & ((1 << cnt) - 1)));
+	return val;
 }
 
 /** Decode `stored' block
@@ -271,7 +297,11 @@ static inline uint16_t get_bits(inflate_state_t *state, size_t cnt)
  */
 static int inflate_stored(inflate_state_t *state)
 {
-	/* Discard bits in the bit buffer */
+	/*
+	 * Discard bits up to the next byte boundary. Whole bytes
+	 * sitting in the bit buffer are given back to the input.
+	 */
+	state->srccnt -= state->bitlen >> 3;
 	state->bitbuf = 0;
 	state->bitlen = 0;
 
@@ -318,6 +348,26 @@ static int inflate_stored(inflate_state_t *state)
 static int huffman_decode(inflate_state_t *state, huffman_t *huffman,
     uint16_t *symbol)
 {
+	/*
+	 * Fast path: resolve short codes (the vast majority) with a
+	 * single table lookup instead of bit-by-bit tree walking.
+	 */
+	if (huffman->table != NULL) {
+		if (state->bitlen < HUFF_TBL_BITS)
+			refill_bits(state);
+
+		uint16_t entry =
+		    huffman->table[state->bitbuf & HUFF_TBL_MASK];
+		size_t len = entry & 0xf;
+
+		if ((len != 0) && (len <= state->bitlen)) {
+			state->bitbuf >>= len;
+			state->bitlen -= len;
+			*symbol = entry >> 4;
+			return EOK;
+		}
+	}
+
 	/* Decode bits */
 	uint16_t code = 0;
 
@@ -411,6 +461,54 @@ static int16_t huffman_construct(huffman_t *huffman, uint16_t *length, size_t n)
 	return left;
 }
 
+/** Build the Huffman lookup table
+ *
+ * Fill huffman->table so that codes of up to HUFF_TBL_BITS bits
+ * resolve with one lookup. The canonical codes are enumerated from
+ * the count/symbol arrays; since stream bits arrive LSB first, each
+ * code is stored bit-reversed, replicated over all indices sharing
+ * its low bits.
+ *
+ * @param huffman Huffman code with a table to fill.
+ *
+ */
+static void huffman_table_build(huffman_t *huffman)
+{
+	memset(huffman->table, 0, HUFF_TBL_SIZE * sizeof(uint16_t));
+
+	/* First canonical code of the current length */
+	size_t first = 0;
+	/* First symbol index of the current length */
+	size_t index = 0;
+
+	size_t len;
+	for (len = 1; len <= HUFF_TBL_BITS; len++) {
+		uint16_t count = huffman->count[len];
+
+		size_t i;
+		for (i = 0; i < count; i++) {
+			size_t code = first + i;
+
+			/* Bit-reverse the code */
+			size_t rev = 0;
+			size_t bit;
+			for (bit = 0; bit < len; bit++)
+				rev |= ((code >> bit) & 1) << (len - 1 - bit);
+
+			uint16_t entry =
+			    (uint16_t) ((huffman->symbol[index + i] << 4) | len);
+
+			size_t idx;
+			for (idx = rev; idx < HUFF_TBL_SIZE; idx += (1 << len))
+				huffman->table[idx] = entry;
+		}
+
+		index += count;
+		first += count;
+		first <<= 1;
+	}
+}
+
 /** Decode literal/length and distance codes
  *
  * Decode until end-of-block code.
@@ -466,12 +564,30 @@ static int inflate_codes(inflate_state_t *state, huffman_t *len_code,
 			if (state->destcnt + len > state->destlen)
 				return ENOMEM;
 
-			while (len > 0) {
-				/* Copy len bytes from distance bytes back */
-				state->dest[state->destcnt] =
-				    state->dest[state->destcnt - dist];
-				state->destcnt++;
-				len--;
+			/* Copy len bytes from distance bytes back */
+			uint8_t *dst = state->dest + state->destcnt;
+			state->destcnt += len;
+
+			if (dist >= len) {
+				memcpy(dst, dst - dist, len);
+			} else if (dist == 1) {
+				memset(dst, dst[-1], len);
+			} else {
+				/*
+				 * Overlapping match: the written
+				 * prefix doubles as the source, so
+				 * the copyable run doubles each pass.
+				 */
+				memcpy(dst, dst - dist, dist);
+
+				size_t copied = dist;
+				while (copied < len) {
+					size_t chunk = (copied < len - copied) ?
+					    copied : (len - copied);
+
+					memcpy(dst + copied, dst, chunk);
+					copied += chunk;
+				}
 			}
 		}
 	} while (symbol != 256);
@@ -514,16 +630,20 @@ static int inflate_dynamic(inflate_state_t *state)
 	uint16_t length[MAX_CODE];
 	uint16_t dyn_len_count[MAX_HUFFMAN_BIT + 1];
 	uint16_t dyn_len_symbol[MAX_LITLEN];
+	uint16_t dyn_len_table[HUFF_TBL_SIZE];
 	uint16_t dyn_dist_count[MAX_HUFFMAN_BIT + 1];
 	uint16_t dyn_dist_symbol[MAX_DIST];
+	uint16_t dyn_dist_table[HUFF_TBL_SIZE];
 	huffman_t dyn_len_code;
 	huffman_t dyn_dist_code;
 
 	dyn_len_code.count = dyn_len_count;
 	dyn_len_code.symbol = dyn_len_symbol;
+	dyn_len_code.table = dyn_len_table;
 
 	dyn_dist_code.count = dyn_dist_count;
 	dyn_dist_code.symbol = dyn_dist_symbol;
+	dyn_dist_code.table = dyn_dist_table;
 
 	/* Get number of bits in each table */
 	uint16_t nlen = get_bits(state, 5) + 257;
@@ -555,6 +675,8 @@ static int inflate_dynamic(inflate_state_t *state)
 	if (rc != 0)
 		return EINVAL;
 
+	huffman_table_build(&dyn_len_code);
+
 	/* Read length/literal and distance code length tables */
 	index = 0;
 	while (index < nlen + ndist) {
@@ -604,20 +726,32 @@ static int inflate_dynamic(inflate_state_t *state)
 	if ((rc < 0) || ((rc > 0) && (dyn_len_code.count[0] + 1 != nlen)))
 		return EINVAL;
 
+	huffman_table_build(&dyn_len_code);
+
 	/* Build Huffman tables for distance codes */
 	rc = huffman_construct(&dyn_dist_code, length + nlen, ndist);
 	if ((rc < 0) || ((rc > 0) && (dyn_dist_code.count[0] + 1 != ndist)))
 		return EINVAL;
 
+	huffman_table_build(&dyn_dist_code);
+
 	return inflate_codes(state, &dyn_len_code, &dyn_dist_code);
 }
 
-/** Inflate data
+/** Inflate a single deflate stream
  *
- * @param src     Source data buffer.
- * @param srclen  Source buffer size (bytes).
- * @param dest    Destination data buffer.
- * @param destlen Destination buffer size (bytes).
+ * Like inflate(), but also reports how much of the input and output
+ * buffer the stream actually used, allowing further data (e.g. the
+ * next member of a multi-member archive) to follow in the source
+ * buffer.
+ *
+ * @param src       Source data buffer.
+ * @param srclen    Source buffer size (bytes).
+ * @param dest      Destination data buffer.
+ * @param destlen   Destination buffer size (bytes).
+ * @param srcread   Bytes of the source consumed by the stream
+ *                  (may be NULL).
+ * @param destwrite Bytes written to the destination (may be NULL).
  *
  * @return EOK on success.
  * @return ENOENT on distance too large.
@@ -626,7 +760,8 @@ static int inflate_dynamic(inflate_state_t *state)
  * @return ENOMEM on output buffer overrun.
  *
  */
-int inflate(const void *src, size_t srclen, void *dest, size_t destlen)
+int inflate_stream(const void *src, size_t srclen, void *dest, size_t destlen,
+    size_t *srcread, size_t *destwrite)
 {
 	/* Initialize the state */
 	inflate_state_t state;
@@ -644,8 +779,26 @@ int inflate(const void *src, size_t srclen, void *dest, size_t destlen)
 
 	state.overrun = false;
 
+	/*
+	 * Fixed-code lookup tables, built on the first fixed block.
+	 * They are per-call so that concurrent decoders do not share
+	 * mutable state.
+	 */
+	uint16_t fixed_len_table[HUFF_TBL_SIZE];
+	uint16_t fixed_dist_table[HUFF_TBL_SIZE];
+	huffman_t fixed_len_code = {
+		.count = len_count,
+		.symbol = len_symbol,
+		.table = NULL
+	};
+	huffman_t fixed_dist_code = {
+		.count = dist_count,
+		.symbol = dist_symbol,
+		.table = NULL
+	};
+
 	uint16_t last;
-	int ret = 0;
+	int ret = EOK;
 
 	do {
 		/* Last block is indicated by a non-zero bit */
@@ -661,7 +814,15 @@ int inflate(const void *src, size_t srclen, void *dest, size_t destlen)
 			ret = inflate_stored(&state);
 			break;
 		case 1:
-			ret = inflate_fixed(&state, &len_code, &dist_code);
+			if (fixed_len_code.table == NULL) {
+				fixed_len_code.table = fixed_len_table;
+				fixed_dist_code.table = fixed_dist_table;
+				huffman_table_build(&fixed_len_code);
+				huffman_table_build(&fixed_dist_code);
+			}
+
+			ret = inflate_fixed(&state, &fixed_len_code,
+			    &fixed_dist_code);
 			break;
 		case 2:
 			ret = inflate_dynamic(&state);
@@ -671,5 +832,35 @@ int inflate(const void *src, size_t srclen, void *dest, size_t destlen)
 		}
 	} while ((!last) && (ret == 0));
 
+	if (ret == EOK) {
+		/*
+		 * The stream ends mid-byte; whole bytes left in the
+		 * bit buffer belong to whatever follows.
+		 */
+		if (srcread != NULL)
+			*srcread = state.srccnt - (state.bitlen >> 3);
+		if (destwrite != NULL)
+			*destwrite = state.destcnt;
+	}
+
 	return ret;
 }
+
+/** Inflate data
+ *
+ * @param src     Source data buffer.
+ * @param srclen  Source buffer size (bytes).
+ * @param dest    Destination data buffer.
+ * @param destlen Destination buffer size (bytes).
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code or invalid deflate data.
+ * @return ELIMIT on input buffer overrun.
+ * @return ENOMEM on output buffer overrun.
+ *
+ */
+int inflate(const void *src, size_t srclen, void *dest, size_t destlen)
+{
+	return inflate_stream(src, srclen, dest, destlen, NULL, NULL);
+}
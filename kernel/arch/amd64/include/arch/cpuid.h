@@ -59,6 +59,7 @@ typedef struct {
 extern int has_cpuid(void);
 
 extern void cpuid(uint32_t cmd, cpu_info_t *info);
+extern void cpuid_subleaf(uint32_t cmd, uint32_t subcmd, cpu_info_t *info);
 
 #endif /* !def __ASSEMBLER__ */
 #endif
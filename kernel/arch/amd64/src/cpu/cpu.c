@@ -53,6 +53,15 @@
 #define INTEL_CPUID_ECX  UINT32_C(0x6c65746e)
 #define INTEL_CPUID_EDX  UINT32_C(0x49656e69)
 
+/* Topology enumeration leaves */
+#define INTEL_CPUID_CACHE     0x00000004
+#define INTEL_CPUID_TOPOLOGY  0x0000000b
+#define AMD_CPUID_ADDR_SIZES  0x80000008
+#define AMD_CPUID_CACHE_PROPS 0x8000001d
+
+/** Topology extensions bit of CPUID 0x80000001 ECX */
+#define AMD_EXT2_TOPOEXT  22
+
 enum vendor {
 	VendorUnknown = 0,
 	VendorAMD,
@@ -93,12 +102,118 @@ void fpu_enable(void)
 	write_cr0(read_cr0() & ~CR0_TS);
 }
 
+/** Number of APIC ID bits needed to cover @a count identifiers */
+static unsigned int apic_id_width(uint32_t count)
+{
+	unsigned int width = 0;
+
+	while ((UINT32_C(1) << width) < count)
+		width++;
+
+	return width;
+}
+
+/** Read the calling processor's topology out of CPUID.
+ *
+ * Determines the APIC ID bit widths of the SMT, core and last-level
+ * cache levels and hands them to cpu_topology_refine(). On hardware
+ * that exposes none of the topology leaves the flat default from
+ * cpu_init() is kept.
+ */
+static void cpu_topology_detect(void)
+{
+	cpu_info_t info;
+
+	cpuid(INTEL_CPUID_LEVEL, &info);
+	uint32_t max_level = info.cpuid_eax;
+
+	cpuid(INTEL_CPUID_STANDARD, &info);
+
+	unsigned int apic_id = (info.cpuid_ebx >> 24) & 0xffU;
+
+	/* Logical processors per package (valid with the HTT flag). */
+	uint32_t logical = 1;
+	if ((info.cpuid_edx >> 28) & 1U)
+		logical = (info.cpuid_ebx >> 16) & 0xffU;
+	if (logical == 0)
+		logical = 1;
+
+	unsigned int core_width = apic_id_width(logical);
+	unsigned int smt_width = 0;
+	unsigned int llc_width = core_width;
+
+	if ((CPU->arch.vendor == VendorIntel) &&
+	    (max_level >= INTEL_CPUID_CACHE)) {
+		if (max_level >= INTEL_CPUID_TOPOLOGY) {
+			/* Level type 1 is SMT; EAX[4:0] is its shift. */
+			cpuid_subleaf(INTEL_CPUID_TOPOLOGY, 0, &info);
+			if (((info.cpuid_ecx >> 8) & 0xffU) == 1)
+				smt_width = info.cpuid_eax & 0x1fU;
+		}
+
+		/*
+		 * Walk the deterministic cache parameters; the last
+		 * valid subleaf describes the last-level cache and
+		 * EAX[25:14] how many logical processors share it.
+		 */
+		unsigned int width = 0;
+		for (uint32_t sub = 0; sub < 64; sub++) {
+			cpuid_subleaf(INTEL_CPUID_CACHE, sub, &info);
+			if ((info.cpuid_eax & 0x1fU) == 0)
+				break;
+
+			width = apic_id_width(((info.cpuid_eax >> 14) &
+			    0xfffU) + 1);
+		}
+		if (width != 0)
+			llc_width = width;
+	}
+
+	if (CPU->arch.vendor == VendorAMD) {
+		cpuid(INTEL_CPUID_EXTENDED, &info);
+		uint32_t max_ext = info.cpuid_eax;
+
+		if (max_ext >= AMD_CPUID_ADDR_SIZES) {
+			cpuid(AMD_CPUID_ADDR_SIZES, &info);
+
+			/* ApicIdCoreIdSize, or the core count when zero. */
+			unsigned int size = (info.cpuid_ecx >> 12) & 0xfU;
+			core_width = (size != 0) ? size :
+			    apic_id_width((info.cpuid_ecx & 0xffU) + 1);
+			llc_width = core_width;
+		}
+
+		cpuid(AMD_CPUID_EXTENDED, &info);
+		if ((max_ext >= AMD_CPUID_CACHE_PROPS) &&
+		    ((info.cpuid_ecx >> AMD_EXT2_TOPOEXT) & 1U)) {
+			/* Same format as the Intel cache leaf. */
+			unsigned int width = 0;
+			for (uint32_t sub = 0; sub < 64; sub++) {
+				cpuid_subleaf(AMD_CPUID_CACHE_PROPS, sub,
+				    &info);
+				if ((info.cpuid_eax & 0x1fU) == 0)
+					break;
+
+				width = apic_id_width(((info.cpuid_eax >> 14) &
+				    0xfffU) + 1);
+			}
+			if (width != 0)
+				llc_width = width;
+		}
+	}
+
+	cpu_topology_refine(apic_id, smt_width, core_width, llc_width);
+}
+
 void cpu_arch_init(void)
 {
 	CPU->arch.tss = tss_p;
 	CPU->arch.tss->iomap_base = &CPU->arch.tss->iomap[0] -
 	    ((uint8_t *) CPU->arch.tss);
 	CPU->fpu_owner = NULL;
+
+	if (has_cpuid())
+		cpu_topology_detect();
 }
 
 void cpu_identify(void)
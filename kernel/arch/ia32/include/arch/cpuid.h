@@ -115,6 +115,17 @@ static inline void cpuid(uint32_t cmd, cpu_info_t *info)
 	);
 }
 
+static inline void cpuid_subleaf(uint32_t cmd, uint32_t subcmd,
+    cpu_info_t *info)
+{
+	asm volatile (
+	    "cpuid\n"
+	    : "=a" (info->cpuid_eax), "=b" (info->cpuid_ebx),
+	      "=c" (info->cpuid_ecx), "=d" (info->cpuid_edx)
+	    : "a" (cmd), "c" (subcmd)
+	);
+}
+
 #endif /* !def __ASSEMBLER__ */
 #endif
 
@@ -438,7 +438,7 @@ static void fb_putuchar(outdev_t *dev, char32_t ch)
 			instance->position--;
 		break;
 	case '\t':
-		cursor_remove(instance);
+		/* The first drawn space overwrites the cursor cell. */
 		do {
 			glyph_draw(instance, fb_font_glyph(' '),
 			    instance->position % instance->cols,
@@ -448,6 +448,13 @@ static void fb_putuchar(outdev_t *dev, char32_t ch)
 		    (instance->position < instance->cols * instance->rows));
 		break;
 	default:
+		/*
+		 * No cursor_remove() needed: drawing the glyph into
+		 * the cursor's cell overwrites the cursor anyway.
+		 * This cuts one full glyph render from every printed
+		 * character, which dominates the cost of verbose
+		 * output and panic dumps.
+		 */
 		glyph_draw(instance, fb_font_glyph(ch),
 		    instance->position % instance->cols,
 		    instance->position / instance->cols, false);
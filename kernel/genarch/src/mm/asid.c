@@ -67,6 +67,14 @@
 
 static size_t asids_allocated = 0;
 
+/**
+ * ASID generation counter. A new generation starts with the global
+ * TLB flush performed when the allocator runs out of clean ASIDs;
+ * all ASIDs freed during the previous generation become allocable
+ * again without any per-ASID invalidation.
+ */
+size_t asids_generation = 1;
+
 /** Allocate free address space identifier.
  *
  * @return New ASID.
@@ -136,14 +144,32 @@ asid_t asid_get(void)
 		 */
 
 		asid = asid_find_free();
+		if (asid == ASID_INVALID) {
+			/*
+			 * All free ASIDs are dirty. Start a new
+			 * generation: one global TLB flush declares
+			 * every freed ASID clean at once, which
+			 * amortizes to constant time per allocation
+			 * and removes the per-allocation shootdown.
+			 */
+			ipl_t ipl = tlb_shootdown_start(TLB_INVL_ALL,
+			    ASID_INVALID, 0, 0);
+			tlb_invalidate_all();
+			tlb_shootdown_finalize(ipl);
+
+			asids_generation++;
+			asid_reclaim_dirty();
+
+			asid = asid_find_free();
+			assert(asid != ASID_INVALID);
+		}
+
 		asids_allocated++;
 
 		/*
-		 * Purge the allocated ASID from TLBs.
+		 * Clean ASIDs have no stale TLB entries, so no
+		 * per-ASID purge is necessary here.
 		 */
-		ipl_t ipl = tlb_shootdown_start(TLB_INVL_ASID, asid, 0, 0);
-		tlb_invalidate_asid(asid);
-		tlb_shootdown_finalize(ipl);
 	}
 
 	return asid;
@@ -48,7 +48,8 @@
 #define FIFO_STATIC		(ASIDS_ALLOCABLE<FIFO_STATIC_LIMIT)
 
 /**
- * FIFO queue containing unassigned ASIDs.
+ * FIFO queue containing unassigned ASIDs that are known to have no
+ * stale TLB entries (clean ASIDs).
  * Can be only accessed when asidlock is held.
  */
 #if FIFO_STATIC
@@ -57,6 +58,23 @@ FIFO_INITIALIZE_STATIC(free_asids, asid_t, ASIDS_ALLOCABLE);
 FIFO_INITIALIZE_DYNAMIC(free_asids, asid_t, ASIDS_ALLOCABLE);
 #endif
 
+/**
+ * FIFO queue containing ASIDs released since the last global TLB
+ * flush (dirty ASIDs). They may still be represented in the TLBs and
+ * become clean only when a new ASID generation starts.
+ * Can be only accessed when asidlock is held.
+ */
+#if FIFO_STATIC
+FIFO_INITIALIZE_STATIC(dirty_asids, asid_t, ASIDS_ALLOCABLE);
+#else
+FIFO_INITIALIZE_DYNAMIC(dirty_asids, asid_t, ASIDS_ALLOCABLE);
+#endif
+
+/** Number of ASIDs in free_asids. */
+static size_t free_count;
+/** Number of ASIDs in dirty_asids. */
+static size_t dirty_count;
+
 /** Initialize data structures for O(1) ASID allocation and deallocation. */
 void asid_fifo_init(void)
 {
@@ -66,6 +84,9 @@ void asid_fifo_init(void)
 	fifo_create(free_asids);
 	if (!free_asids.fifo)
 		panic("Not enough memory to allocate ASID FIFO");
+	fifo_create(dirty_asids);
+	if (!dirty_asids.fifo)
+		panic("Not enough memory to allocate ASID FIFO");
 	// TODO: There really is no reason not to statically allocate it
 	//       except to keep binary size low. Once kernel is a regular ELF
 	//       binary supporting .bss section (wip as of the late 2018),
@@ -75,28 +96,63 @@ void asid_fifo_init(void)
 	for (i = 0; i < ASIDS_ALLOCABLE; i++) {
 		fifo_push(free_asids, ASID_START + i);
 	}
+	free_count = ASIDS_ALLOCABLE;
 }
 
 /** Allocate free ASID.
  *
  * Allocation runs in O(1).
  *
- * @return Free ASID.
+ * @return Clean free ASID or ASID_INVALID when only dirty free
+ *         ASIDs remain (see asid_reclaim_dirty()).
  */
 asid_t asid_find_free(void)
 {
+	if (free_count == 0)
+		return ASID_INVALID;
+
+	free_count--;
 	return fifo_pop(free_asids);
 }
 
 /** Return ASID among free ASIDs.
  *
- * This operation runs in O(1).
+ * This operation runs in O(1). The ASID may still be represented in
+ * the TLBs, so it is parked in the dirty queue until the next global
+ * flush declares a new generation.
  *
  * @param asid ASID being freed.
  */
 void asid_put_arch(asid_t asid)
 {
-	fifo_push(free_asids, asid);
+	fifo_push(dirty_asids, asid);
+	dirty_count++;
+}
+
+/** Declare all dirty ASIDs clean.
+ *
+ * Called after a global TLB flush, which starts a new ASID
+ * generation: no freed ASID can be represented in any TLB anymore,
+ * so the whole dirty queue is moved to the free queue. Runs in time
+ * linear to the number of dirty ASIDs, which amortizes to constant
+ * per allocation.
+ *
+ * @return Number of ASIDs reclaimed.
+ */
+size_t asid_reclaim_dirty(void)
+{
+	size_t reclaimed = 0;
+
+	while (dirty_count > 0) {
+		asid_t asid = fifo_pop(dirty_asids);
+		dirty_count--;
+
+		fifo_push(free_asids, asid);
+		free_count++;
+		reclaimed++;
+	}
+
+	return reclaimed;
 }
 
 /** @}
@@ -75,6 +75,11 @@ typedef struct {
 	hash_table_ops_t *op;
 	list_t *bucket;
 	size_t bucket_cnt;
+	/** Superseded buckets still being migrated, or NULL */
+	list_t *old_bucket;
+	size_t old_bucket_cnt;
+	/** Next old bucket to migrate */
+	size_t migrate_idx;
 	size_t full_item_cnt;
 	size_t item_cnt;
 	size_t max_load;
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_generic_adt
+ * @{
+ */
+/** @file
+ * @brief Intrusive lock-free multi-producer single-consumer queue.
+ *
+ * Producers push with one atomic exchange and never spin or block,
+ * which makes the push side safe even in interrupt context. The
+ * single consumer pops without atomic read-modify-write operations.
+ * Based on the well-known stub-node algorithm by Dmitry Vyukov.
+ *
+ * The queue is intrusive: users embed mpsc_link_t in their items the
+ * same way link_t is embedded for list_t.
+ */
+
+#ifndef KERN_MPSC_QUEUE_H_
+#define KERN_MPSC_QUEUE_H_
+
+#include <member.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Queue link, to be embedded in the queued structure. */
+typedef struct mpsc_link {
+	struct mpsc_link *_Atomic next;
+} mpsc_link_t;
+
+/** Multi-producer single-consumer queue. */
+typedef struct {
+	/** Where producers push; the most recently pushed item. */
+	mpsc_link_t *_Atomic head;
+	/** Where the consumer pops; only the consumer touches this. */
+	mpsc_link_t *tail;
+	/** Permanent dummy node making empty/non-empty uniform. */
+	mpsc_link_t stub;
+} mpsc_queue_t;
+
+/** Get typed structure from the queue link.
+ *
+ * @param link   Pointer to the embedded mpsc_link_t.
+ * @param type   Type of the structure.
+ * @param member Name of the embedded member.
+ */
+#define mpsc_queue_get_instance(link, type, member) \
+	member_to_inst(link, type, member)
+
+/** Initialize the queue.
+ *
+ * @param queue Queue to initialize.
+ */
+static inline void mpsc_queue_initialize(mpsc_queue_t *queue)
+{
+	atomic_store_explicit(&queue->stub.next, NULL, memory_order_relaxed);
+	atomic_store_explicit(&queue->head, &queue->stub,
+	    memory_order_relaxed);
+	queue->tail = &queue->stub;
+}
+
+/** Push an item into the queue.
+ *
+ * Wait-free; may be called from any context, including interrupt
+ * handlers, by any number of producers concurrently.
+ *
+ * @param queue Queue.
+ * @param link  Link of the item to push.
+ */
+static inline void mpsc_queue_push(mpsc_queue_t *queue, mpsc_link_t *link)
+{
+	atomic_store_explicit(&link->next, NULL, memory_order_relaxed);
+
+	mpsc_link_t *prev = atomic_exchange_explicit(&queue->head, link,
+	    memory_order_acq_rel);
+
+	/*
+	 * Between the exchange and this store the queue is briefly
+	 * disconnected; the consumer observes that as "empty" and
+	 * retries later.
+	 */
+	atomic_store_explicit(&prev->next, link, memory_order_release);
+}
+
+/** Pop the oldest item from the queue.
+ *
+ * Must only be called by the single consumer.
+ *
+ * @param queue Queue.
+ *
+ * @return Link of the popped item or NULL if the queue is empty (or
+ *         a producer has not finished linking its item yet).
+ */
+static inline mpsc_link_t *mpsc_queue_pop(mpsc_queue_t *queue)
+{
+	mpsc_link_t *tail = queue->tail;
+	mpsc_link_t *next = atomic_load_explicit(&tail->next,
+	    memory_order_acquire);
+
+	if (tail == &queue->stub) {
+		/* Skip over the stub. */
+		if (next == NULL)
+			return NULL;
+
+		queue->tail = next;
+		tail = next;
+		next = atomic_load_explicit(&tail->next,
+		    memory_order_acquire);
+	}
+
+	if (next != NULL) {
+		queue->tail = next;
+		return tail;
+	}
+
+	/*
+	 * Tail is the last item; push the stub back so that the item
+	 * can be unlinked even with producers racing.
+	 */
+	if (atomic_load_explicit(&queue->head,
+	    memory_order_acquire) != tail)
+		return NULL;
+
+	mpsc_queue_push(queue, &queue->stub);
+
+	next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	if (next != NULL) {
+		queue->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+/** Check whether the queue appears empty.
+ *
+ * Only a hint under concurrent pushes.
+ *
+ * @param queue Queue.
+ *
+ * @return True if the queue appears empty.
+ */
+static inline bool mpsc_queue_empty(mpsc_queue_t *queue)
+{
+	return atomic_load_explicit(&queue->head,
+	    memory_order_acquire) == &queue->stub;
+}
+
+#endif
+
+/** @}
+ */
@@ -59,6 +59,22 @@
  */
 #define IS_ALIGNED(s, a)	(ALIGN_UP((s), (a)) == (s))
 
+/**
+ * Assumed size of one cache line. An architecture with a different
+ * coherence granularity may override this with a compiler-level
+ * definition.
+ */
+#ifndef CACHELINE_SIZE
+#define CACHELINE_SIZE  64
+#endif
+
+/**
+ * Attribute aligning a type or object to a cache line boundary.
+ * Intended for structures accessed by different CPUs side by side
+ * (per-CPU arrays, sharded locks) to prevent false sharing.
+ */
+#define CACHELINE_ALIGNED  __attribute__((aligned(CACHELINE_SIZE)))
+
 #endif
 
 /** @}
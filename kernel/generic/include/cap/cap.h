@@ -96,7 +96,10 @@ typedef struct kobject {
 } kobject_t;
 
 /*
- * A cap_t may only be accessed under the protection of the cap_info_t lock.
+ * A cap_t may only be modified under the protection of the cap_info_t
+ * lock. The lock-free lookup fast path of kobject_get() additionally
+ * reads the state and kobject members optimistically, which is made
+ * safe by the reader accounting in cap_info_t (see cap.c).
  */
 typedef struct cap {
 	cap_state_t state;
@@ -116,6 +119,14 @@ typedef struct cap {
 	kobject_t *kobject;
 } cap_t;
 
+/** Direct-indexed capability lookup table. */
+typedef struct {
+	/** Number of slots. */
+	size_t len;
+	/** Slot i belongs to handle CAPS_START + i. */
+	struct cap *cap[];
+} cap_slots_t;
+
 typedef struct cap_info {
 	mutex_t lock;
 
@@ -123,6 +134,16 @@ typedef struct cap_info {
 
 	hash_table_t caps;
 	ra_arena_t *handles;
+
+	/**
+	 * Direct-indexed table used by the lock-free lookup fast
+	 * path. Swapped as a whole when it needs to grow; the old
+	 * table is freed only after all readers have drained.
+	 */
+	cap_slots_t *slots;
+
+	/** Number of lock-free lookups currently in flight. */
+	atomic_size_t active_readers;
 } cap_info_t;
 
 extern void caps_init(void);
@@ -41,10 +41,25 @@
 #include <arch/cpu.h>
 #include <arch/context.h>
 #include <adt/list.h>
+#include <bitops.h>
 #include <arch.h>
 
 #define CPU                  CURRENT->cpu
 
+/** CPU cache/NUMA topology description.
+ *
+ * Initialized by cpu_init() to a flat default in which no two
+ * processors share anything. Architecture code refines the map in
+ * cpu_arch_init() when the hardware topology can be enumerated.
+ */
+typedef struct {
+	unsigned int package_id;  /**< Physical package (socket). */
+	unsigned int core_id;     /**< Core within the package. */
+	unsigned int smt_id;      /**< SMT sibling within the core. */
+	unsigned int llc_id;      /**< Last-level cache domain. */
+	unsigned int numa_node;   /**< NUMA node of local memory. */
+} cpu_topology_t;
+
 /** CPU structure.
  *
  * There is one structure like this for every processor.
@@ -62,7 +77,43 @@ typedef struct cpu {
 	volatile size_t needs_relink;
 
 	IRQ_SPINLOCK_DECLARE(timeoutlock);
-	list_t timeout_active_list;
+
+	/**
+	 * Number of buckets of the timer wheel. Must be a power of two.
+	 * Timeouts further in the future than this many ticks stay in
+	 * their bucket and are re-examined once per wheel revolution.
+	 */
+#define TIMEOUT_WHEEL_LEN  256
+
+	/** Timer wheel buckets of active timeouts, hashed by expiry tick. */
+	list_t timeout_wheel[TIMEOUT_WHEEL_LEN];
+	/** Monotonic tick counter driving the timer wheel. */
+	uint64_t timeout_current_tick;
+
+	/** Size of the per-CPU kernel log staging buffer. */
+#define CPU_LOG_STAGE_SIZE  512
+
+	/**
+	 * Staging buffer for one kernel log entry. The entry is
+	 * formatted here without any lock held and committed to the
+	 * shared log ring in one go. Guarded by disabled preemption
+	 * and the busy flag (nested log calls from interrupt context
+	 * fall back to the locked path).
+	 */
+	uint8_t log_stage[CPU_LOG_STAGE_SIZE];
+	size_t log_stage_len;
+	bool log_stage_busy;
+
+	/** Capacity of the per-CPU cache of single low-memory frames. */
+#define FRAME_CACHE_SIZE  8
+
+	/**
+	 * Per-CPU cache of single low-memory frames kept in allocated
+	 * state. Accessed only by the owning CPU with interrupts
+	 * disabled, so no lock is needed.
+	 */
+	uintptr_t frame_cache[FRAME_CACHE_SIZE];
+	size_t frame_cache_count;
 
 	/**
 	 * When system clock loses a tick, it is
@@ -81,6 +132,18 @@ typedef struct cpu {
 	uint64_t idle_cycles;
 	uint64_t busy_cycles;
 
+	/** Number of log-scale latency histogram buckets. */
+#define LATHIST_BUCKETS  32
+
+	/**
+	 * Latency histograms with power-of-two cycle buckets (bucket n
+	 * counts samples of 2^n..2^(n+1)-1 cycles, the last bucket is
+	 * open-ended). Updated by the owning CPU with interrupts or
+	 * preemption disabled and merged across CPUs on sysinfo reads.
+	 */
+	uint64_t exc_latency[LATHIST_BUCKETS];
+	uint64_t syscall_latency[LATHIST_BUCKETS];
+
 	/**
 	 * Processor ID assigned by kernel.
 	 */
@@ -94,23 +157,58 @@ typedef struct cpu {
 
 	cpu_arch_t arch;
 
+	cpu_topology_t topology;
+
 	struct thread *fpu_owner;
 
 	/**
 	 * Stack used by scheduler when there is no running thread.
 	 */
 	uint8_t *stack;
-} cpu_t;
+} CACHELINE_ALIGNED cpu_t;
+
+/** Record a latency sample into a log-scale histogram.
+ *
+ * The caller must pin itself to the CPU owning @a buckets (interrupts
+ * or preemption disabled).
+ */
+_NO_TRACE static inline void latency_record(uint64_t *buckets,
+    uint64_t cycles)
+{
+	uint8_t bucket = fnzb64(cycles | 1);
+
+	if (bucket >= LATHIST_BUCKETS)
+		bucket = LATHIST_BUCKETS - 1;
+
+	buckets[bucket]++;
+}
 
 extern cpu_t *cpus;
 
 extern void cpu_init(void);
 extern void cpu_list(void);
 
+extern void cpu_topology_refine(unsigned int, unsigned int, unsigned int,
+    unsigned int);
+extern void cpu_topology_export(void);
+extern cpu_t *cpu_find_idle_llc_sibling(cpu_t *);
+
 extern void cpu_arch_init(void);
 extern void cpu_identify(void);
 extern void cpu_print_report(cpu_t *);
 
+/*
+ * To be optionally overridden by architectures which can stop the
+ * periodic clock tick while idle (tickless idle). The horizon is the
+ * number of ticks until the next pending timeout, or (uint64_t) -1
+ * when none is due; the architecture is expected to account skipped
+ * ticks in CPU->missed_clock_ticks so that clock() catches up on
+ * timekeeping after the wakeup. The default takes a single-tick nap.
+ */
+#ifndef cpu_sleep_tickless
+#define cpu_sleep_tickless(horizon)  ((void) (horizon), cpu_sleep())
+#endif
+
 #endif
 
 /** @}
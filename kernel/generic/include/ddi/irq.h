@@ -82,6 +82,14 @@ typedef struct {
 	irq_code_t *code;
 	/** Counter. */
 	size_t counter;
+	/**
+	 * Last queued notification call, referenced. Only maintained
+	 * when the subscription opted in via irq_code_t.coalesce:
+	 * while the call is still undelivered, further interrupts
+	 * bump its counter and OR their scratch arguments into it
+	 * instead of queueing new calls.
+	 */
+	struct call *pending_call;
 } ipc_notif_cfg_t;
 
 /** Structure representing one device IRQ.
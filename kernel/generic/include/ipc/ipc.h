@@ -97,6 +97,12 @@ typedef struct answerbox {
 	list_t calls;
 	list_t dispatched_calls;  /* Should be hash table in the future */
 
+	/**
+	 * Lock protecting the answers list, sharded off the main
+	 * answerbox lock so that clients posting answers do not
+	 * contend with the server fetching calls.
+	 */
+	IRQ_SPINLOCK_DECLARE(answers_lock);
 	/** Answered calls. */
 	list_t answers;
 
@@ -165,6 +171,18 @@ typedef struct call {
 
 	/** Buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ. */
 	uint8_t *buffer;
+
+	/**
+	 * Pinned source frames for zero-copy IPC_M_DATA_WRITE
+	 * (IPC_XF_ZEROCOPY), each holding one reference.
+	 */
+	uintptr_t *zc_frames;
+	/** Number of pinned frames. */
+	size_t zc_count;
+	/** Offset of the data within the first pinned frame. */
+	size_t zc_offset;
+	/** Size of the pinned data. */
+	size_t zc_size;
 } call_t;
 
 extern slab_cache_t *phone_cache;
@@ -182,7 +200,7 @@ extern errno_t ipc_call(phone_t *, call_t *);
 extern errno_t ipc_wait_for_call(answerbox_t *, uint32_t, unsigned int, call_t **);
 extern errno_t ipc_forward(call_t *, phone_t *, answerbox_t *, unsigned int);
 extern void ipc_answer(answerbox_t *, call_t *);
-extern void _ipc_answer_free_call(call_t *, bool);
+extern void _ipc_answer_free_call(call_t *);
 
 extern void ipc_phone_init(phone_t *, struct task *);
 extern bool ipc_phone_connect(phone_t *, answerbox_t *);
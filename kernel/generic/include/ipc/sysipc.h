@@ -43,6 +43,8 @@ extern errno_t ipc_req_internal(cap_phone_handle_t, ipc_data_t *, sysarg_t);
 
 extern sys_errno_t sys_ipc_call_async_fast(cap_phone_handle_t, sysarg_t,
     sysarg_t, sysarg_t, sysarg_t, sysarg_t);
+extern sys_errno_t sys_ipc_call_async_batch(cap_phone_handle_t,
+    uspace_ptr_ipc_call_batch_entry_t, sysarg_t, uspace_ptr_sysarg_t);
 extern sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t, uspace_ptr_ipc_data_t,
     sysarg_t);
 extern sys_errno_t sys_ipc_answer_fast(cap_call_handle_t, sysarg_t, sysarg_t,
@@ -126,6 +126,11 @@ typedef struct as {
 	 */
 	odict_t as_areas;
 
+	/** Last area found by lookup; faults are spatially local,
+	 * so consecutive lookups usually hit the same area. Valid
+	 * only under the address space lock. */
+	struct as_area *area_hint;
+
 	/** Non-generic content. */
 	as_genarch_t genarch;
 
@@ -285,6 +290,9 @@ typedef struct {
 
 	/** Data to be used by the backend. */
 	mem_backend_data_t backend_data;
+
+	/** How many extra pages to fault ahead on a page fault */
+	unsigned int fault_ahead;
 } as_area_t;
 
 /** Address space area backend structure. */
@@ -320,6 +328,8 @@ extern int as_page_fault(uintptr_t, pf_access_t, istate_t *);
 extern as_area_t *as_area_create(as_t *, unsigned int, size_t, unsigned int,
     mem_backend_t *, mem_backend_data_t *, uintptr_t *, uintptr_t);
 extern errno_t as_area_destroy(as_t *, uintptr_t);
+extern errno_t as_area_discard(as_t *, uintptr_t, size_t);
+extern errno_t as_area_advise(as_t *, uintptr_t, unsigned int);
 extern errno_t as_area_resize(as_t *, uintptr_t, size_t, unsigned int);
 extern errno_t as_area_share(as_t *, uintptr_t, size_t, as_t *, unsigned int,
     uintptr_t *, uintptr_t);
@@ -378,6 +388,8 @@ extern sys_errno_t sys_as_area_resize(uintptr_t, size_t, unsigned int);
 extern sys_errno_t sys_as_area_change_flags(uintptr_t, unsigned int);
 extern sys_errno_t sys_as_area_get_info(uintptr_t, uspace_ptr_as_area_info_t);
 extern sys_errno_t sys_as_area_destroy(uintptr_t);
+extern sys_errno_t sys_as_area_discard(uintptr_t, size_t);
+extern sys_errno_t sys_as_area_advise(uintptr_t, unsigned int);
 
 /* Introspection functions. */
 extern as_area_info_t *as_get_area_info(as_t *, size_t *);
@@ -81,6 +81,12 @@ extern asid_t asid_find_free(void);
 extern void asid_put_arch(asid_t asid);
 #endif /* !def asid_put_arch */
 
+#ifndef asid_reclaim_dirty
+extern size_t asid_reclaim_dirty(void);
+#endif /* !def asid_reclaim_dirty */
+
+extern size_t asids_generation;
+
 #endif
 
 #endif
@@ -115,6 +115,9 @@ typedef struct {
 
 	/** Array of frame_t structures in this zone */
 	frame_t *frames;
+
+	/** Frame metadata initialization deferred to kinit */
+	bool deferred;
 } zone_t;
 
 /*
@@ -138,10 +141,13 @@ extern void frame_free_generic(uintptr_t, size_t, frame_flags_t);
 extern void frame_free(uintptr_t, size_t);
 extern void frame_free_noreserve(uintptr_t, size_t);
 extern void frame_reference_add(pfn_t);
+extern bool frame_reference_try_add(pfn_t);
 extern size_t frame_total_free_get(void);
+extern void kreclaimd(void *);
 
 extern size_t find_zone(pfn_t, size_t, size_t);
 extern size_t zone_create(pfn_t, size_t, pfn_t, zone_flags_t);
+extern void frame_init_deferred(void);
 extern void *frame_get_parent(pfn_t, size_t);
 extern void frame_set_parent(pfn_t, void *, size_t);
 extern void frame_mark_unavailable(pfn_t, size_t);
@@ -50,6 +50,15 @@ typedef struct {
 	bool (*mapping_find)(as_t *, uintptr_t, bool, pte_t *);
 	void (*mapping_update)(as_t *, uintptr_t, bool, pte_t *);
 	void (*mapping_make_global)(uintptr_t, size_t);
+	/**
+	 * Insert one mapping covering count pages backed by a
+	 * physically contiguous, naturally aligned frame block using a
+	 * large page translation. Optional; may be left NULL when the
+	 * architecture has no large page support, in which case
+	 * page_mapping_insert_span() falls back to base page mappings.
+	 */
+	void (*mapping_insert_large)(as_t *, uintptr_t, uintptr_t,
+	    unsigned int, size_t);
 } page_mapping_operations_t;
 
 extern page_mapping_operations_t *page_mapping_operations;
@@ -59,6 +68,8 @@ extern void page_table_lock(as_t *, bool);
 extern void page_table_unlock(as_t *, bool);
 extern bool page_table_locked(as_t *);
 extern void page_mapping_insert(as_t *, uintptr_t, uintptr_t, unsigned int);
+extern void page_mapping_insert_span(as_t *, uintptr_t, uintptr_t,
+    unsigned int, size_t);
 extern void page_mapping_remove(as_t *, uintptr_t);
 extern bool page_mapping_find(as_t *, uintptr_t, bool, pte_t *);
 extern void page_mapping_update(as_t *, uintptr_t, bool, pte_t *);
@@ -123,6 +123,7 @@ extern void slab_cache_destroy(slab_cache_t *);
 extern void *slab_alloc(slab_cache_t *, unsigned int)
     __attribute__((malloc));
 extern void slab_free(slab_cache_t *, void *);
+extern size_t slab_cache_prefill(slab_cache_t *, size_t);
 extern size_t slab_reclaim(unsigned int);
 
 /* slab subsytem initialization */
@@ -131,6 +132,7 @@ extern void slab_enable_cpucache(void);
 
 /* kconsole debug */
 extern void slab_print_list(void);
+extern void slab_print_audit(void);
 
 #endif
 
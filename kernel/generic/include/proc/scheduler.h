@@ -35,6 +35,7 @@
 #ifndef KERN_SCHEDULER_H_
 #define KERN_SCHEDULER_H_
 
+#include <align.h>
 #include <stddef.h>
 #include <synch/spinlock.h>
 #include <time/clock.h>
@@ -44,12 +45,17 @@
 #define RQ_COUNT          16
 #define NEEDS_RELINK_MAX  (HZ)
 
-/** Scheduler run queue structure. */
+/** Scheduler run queue structure.
+ *
+ * Aligned to a cache line so that neighbouring run queues of one CPU
+ * (and their locks) do not false-share when poked by remote CPUs
+ * during wakeups and work stealing.
+ */
 typedef struct {
 	IRQ_SPINLOCK_DECLARE(lock);
 	list_t rq;			/**< List of ready threads. */
 	size_t n;			/**< Number of threads in rq_ready. */
-} runq_t;
+} CACHELINE_ALIGNED runq_t;
 
 extern atomic_size_t nrdy;
 extern void scheduler_init(void);
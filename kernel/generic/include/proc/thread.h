@@ -64,7 +64,9 @@ typedef enum {
 	/** Thread will be attached by the caller. */
 	THREAD_FLAG_NOATTACH = (1 << 1),
 	/** Thread accounting doesn't affect accumulated task accounting. */
-	THREAD_FLAG_UNCOUNTED = (1 << 2)
+	THREAD_FLAG_UNCOUNTED = (1 << 2),
+	/** Thread belongs to the latency-critical scheduling class. */
+	THREAD_FLAG_REALTIME = (1 << 3)
 } thread_flags_t;
 
 /** Thread structure. There is one per thread. */
@@ -173,6 +175,15 @@ typedef struct thread {
 	bool wired;
 	/** Thread was migrated to another CPU and has not run yet. */
 	bool stolen;
+	/**
+	 * Thread belongs to the latency-critical class: it is always
+	 * enqueued in the most priority run queue and is exempt from
+	 * priority aging.
+	 */
+	bool realtime;
+
+	/** One-shot dispatch boost for the next thread_ready() */
+	bool wakeup_boost;
 	/** Thread is executed in user space. */
 	bool uspace;
 
@@ -182,6 +193,10 @@ typedef struct thread {
 	/** Thread accounting. */
 	uint64_t ucycles;
 	uint64_t kcycles;
+	/** Scheduling statistics. */
+	uint64_t switches;
+	uint64_t migrations;
+	uint64_t preemptions;
 	/** Last sampled cycle. */
 	uint64_t last_cycle;
 	/** Thread doesn't affect accumulated accounting. */
@@ -270,6 +285,7 @@ extern sys_errno_t sys_thread_exit(int);
 extern sys_errno_t sys_thread_get_id(uspace_ptr_thread_id_t);
 extern sys_errno_t sys_thread_usleep(uint32_t);
 extern sys_errno_t sys_thread_udelay(uint32_t);
+extern sys_errno_t sys_thread_set_realtime(sysarg_t);
 
 #endif
 
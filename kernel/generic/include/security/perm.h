@@ -70,6 +70,12 @@
  */
 #define PERM_IRQ_REG     (1 << 3)
 
+/**
+ * PERM_REALTIME entitles its holder to move its threads into the
+ * latency-critical scheduling class.
+ */
+#define PERM_REALTIME    (1 << 4)
+
 typedef uint32_t perm_t;
 
 #ifdef __32_BITS__
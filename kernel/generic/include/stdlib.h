@@ -43,6 +43,19 @@ extern void *realloc(void *, size_t)
     __attribute__((warn_unused_result));
 extern void free(void *);
 
+/*
+ * Size class arena interface: callers which know the size (and
+ * alignment) of their allocation avoid the malloc() size header, but
+ * must pass the same size and alignment when freeing.
+ */
+extern void *mem_alloc(size_t, size_t)
+    __attribute__((malloc));
+extern void *mem_realloc(void *, size_t, size_t, size_t)
+    __attribute__((warn_unused_result));
+extern void mem_free(void *, size_t, size_t);
+
+extern void malloc_print_profile(void);
+
 #endif
 
 /** @}
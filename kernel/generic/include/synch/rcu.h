@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+/** @file
+ */
+
+#ifndef KERN_RCU_H_
+#define KERN_RCU_H_
+
+#include <adt/mpsc_queue.h>
+#include <preemption.h>
+
+/** RCU callback item, to be embedded in the protected structure. */
+typedef struct rcu_item {
+	mpsc_link_t link;
+	void (*func)(struct rcu_item *);
+} rcu_item_t;
+
+/** Enter an RCU read-side critical section.
+ *
+ * Read-side critical sections must not block or sleep; the grace
+ * period detection treats any context switch of a CPU as a quiescent
+ * state.
+ */
+static inline void rcu_read_lock(void)
+{
+	preemption_disable();
+}
+
+/** Leave an RCU read-side critical section. */
+static inline void rcu_read_unlock(void)
+{
+	preemption_enable();
+}
+
+extern void rcu_init(void);
+extern void rcu_synchronize(void);
+extern void rcu_call(rcu_item_t *, void (*)(rcu_item_t *));
+
+#endif
+
+/** @}
+ */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+/** @file
+ */
+
+#ifndef KERN_RWLOCK_H_
+#define KERN_RWLOCK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <synch/condvar.h>
+#include <synch/mutex.h>
+
+/** Reader-writer lock.
+ *
+ * Blocking lock allowing multiple concurrent readers or one writer.
+ * Writers are preferred: once a writer is waiting, new readers block,
+ * which prevents writer starvation on read-mostly data.
+ */
+typedef struct {
+	mutex_t lock;
+	condvar_t cv;
+
+	/** Number of active readers. */
+	size_t readers;
+	/** True if a writer holds the lock. */
+	bool writer;
+	/** Number of writers waiting for the lock. */
+	size_t writers_waiting;
+} rwlock_t;
+
+extern void rwlock_initialize(rwlock_t *);
+extern void rwlock_read_lock(rwlock_t *);
+extern void rwlock_read_unlock(rwlock_t *);
+extern void rwlock_write_lock(rwlock_t *);
+extern void rwlock_write_unlock(rwlock_t *);
+extern bool rwlock_write_trylock(rwlock_t *);
+
+#endif
+
+/** @}
+ */
@@ -43,8 +43,16 @@
 
 #ifdef CONFIG_SMP
 
+/** Ticket spinlock.
+ *
+ * Each waiter draws a ticket from @c tail and spins until @c head
+ * reaches it; the owner advances @c head on unlock. Waiters are thus
+ * served in FIFO order, which prevents the starvation and cache-line
+ * stampedes inherent to the plain test-and-set lock under contention.
+ */
 typedef struct spinlock {
-	atomic_flag flag;
+	atomic_uint_fast32_t head;
+	atomic_uint_fast32_t tail;
 
 #ifdef CONFIG_DEBUG_SPINLOCK
 	const char *name;
@@ -68,13 +76,15 @@ typedef struct spinlock {
 #define SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	spinlock_t lock_name = { \
 		.name = desc_name, \
-		.flag = ATOMIC_FLAG_INIT \
+		.head = 0, \
+		.tail = 0 \
 	}
 
 #define SPINLOCK_STATIC_INITIALIZE_NAME(lock_name, desc_name) \
 	static spinlock_t lock_name = { \
 		.name = desc_name, \
-		.flag = ATOMIC_FLAG_INIT \
+		.head = 0, \
+		.tail = 0 \
 	}
 
 #define ASSERT_SPINLOCK(expr, lock) \
@@ -87,12 +97,14 @@ typedef struct spinlock {
 
 #define SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	spinlock_t lock_name = { \
-		.flag = ATOMIC_FLAG_INIT \
+		.head = 0, \
+		.tail = 0 \
 	}
 
 #define SPINLOCK_STATIC_INITIALIZE_NAME(lock_name, desc_name) \
 	static spinlock_t lock_name = { \
-		.flag = ATOMIC_FLAG_INIT \
+		.head = 0, \
+		.tail = 0 \
 	}
 
 #define ASSERT_SPINLOCK(expr, lock) \
@@ -105,8 +117,10 @@ typedef struct spinlock {
 _NO_TRACE static inline void spinlock_lock(spinlock_t *lock)
 {
 	preemption_disable();
-	while (atomic_flag_test_and_set_explicit(&lock->flag,
-	    memory_order_acquire))
+	uint_fast32_t ticket = atomic_fetch_add_explicit(&lock->tail, 1,
+	    memory_order_relaxed);
+	while (atomic_load_explicit(&lock->head,
+	    memory_order_acquire) != ticket)
 		;
 }
 
@@ -116,7 +130,13 @@ _NO_TRACE static inline void spinlock_lock(spinlock_t *lock)
  */
 _NO_TRACE static inline void spinlock_unlock(spinlock_t *lock)
 {
-	atomic_flag_clear_explicit(&lock->flag, memory_order_release);
+	/*
+	 * Only the lock owner advances head, so a plain increment
+	 * published with release semantics is sufficient.
+	 */
+	atomic_store_explicit(&lock->head,
+	    atomic_load_explicit(&lock->head, memory_order_relaxed) + 1,
+	    memory_order_release);
 	preemption_enable();
 }
 
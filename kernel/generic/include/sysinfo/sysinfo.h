@@ -167,6 +167,7 @@ extern sysarg_t sys_sysinfo_get_val_type(uspace_addr_t, size_t);
 extern sys_errno_t sys_sysinfo_get_value(uspace_addr_t, size_t, uspace_addr_t);
 extern sys_errno_t sys_sysinfo_get_data_size(uspace_addr_t, size_t, uspace_addr_t);
 extern sys_errno_t sys_sysinfo_get_data(uspace_addr_t, size_t, uspace_addr_t, size_t, uspace_ptr_size_t);
+extern sysarg_t sys_sysinfo_get_generation(void);
 
 #endif
 
@@ -39,11 +39,19 @@
 
 #define HZ  100
 
+/** Number of load averages exported in the uptime page. */
+#define UPTIME_LOAD_STEPS  3
+
 /** Uptime structure */
 typedef struct {
 	sysarg_t seconds1;
 	sysarg_t useconds;
 	sysarg_t seconds2;
+	/**
+	 * Load averages (fixed point, see stats.c), published here so
+	 * that userspace can sample them without entering the kernel.
+	 */
+	sysarg_t load[UPTIME_LOAD_STEPS];
 } uptime_t;
 
 extern uptime_t *uptime;
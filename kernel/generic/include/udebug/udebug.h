@@ -35,7 +35,12 @@
 #ifndef KERN_UDEBUG_H_
 #define KERN_UDEBUG_H_
 
+#include <abi/syscall.h>
 #include <abi/udebug.h>
+
+/** Capacity of the batched trace event buffer (in events) */
+#define UDEBUG_EV_BUF_SIZE  256
+
 #include <ipc/ipc.h>
 #include <synch/mutex.h>
 #include <synch/condvar.h>
@@ -63,6 +68,20 @@ typedef struct {
 	int not_stoppable_count;
 	struct task *debugger;
 	udebug_evmask_t evmask;
+
+	/** True if only the system calls set in @c sc_mask are traced */
+	bool sc_filter;
+	/** Bitmap of traced system call numbers */
+	uint8_t sc_mask[(SYSCALL_END + 7) / 8];
+
+	/** Batched trace event buffer (NULL unless batching is enabled) */
+	udebug_event_rec_t *ev_buf;
+	/** Index of the oldest buffered event */
+	size_t ev_head;
+	/** Number of buffered events */
+	size_t ev_cnt;
+	/** Events dropped because the buffer was full */
+	size_t ev_dropped;
 } udebug_task_t;
 
 /** Debugging part of thread_t structure.
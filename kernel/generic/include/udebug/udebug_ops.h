@@ -43,6 +43,9 @@
 errno_t udebug_begin(call_t *call, bool *active);
 errno_t udebug_end(void);
 errno_t udebug_set_evmask(udebug_evmask_t mask);
+errno_t udebug_sysmask_set(uspace_addr_t uspace_mask, size_t size);
+errno_t udebug_events_read(void **buffer, size_t *rsize, size_t *rdropped,
+    size_t max_size);
 
 errno_t udebug_go(thread_t *t, call_t *call);
 errno_t udebug_stop(thread_t *t, call_t *call);
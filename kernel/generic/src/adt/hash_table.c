@@ -63,6 +63,8 @@ static size_t round_up_size(size_t);
 static bool alloc_table(size_t, list_t **);
 static void clear_items(hash_table_t *);
 static void resize(hash_table_t *, size_t);
+static void migrate_step(hash_table_t *);
+static void migrate_finish(hash_table_t *);
 static void grow_if_needed(hash_table_t *);
 static void shrink_if_needed(hash_table_t *);
 
@@ -108,6 +110,9 @@ bool hash_table_create(hash_table_t *h, size_t init_size, size_t max_load,
 	h->op = op;
 	h->full_item_cnt = h->max_load * h->bucket_cnt;
 	h->apply_ongoing = false;
+	h->old_bucket = NULL;
+	h->old_bucket_cnt = 0;
+	h->migrate_idx = 0;
 
 	if (h->op->remove_callback == NULL) {
 		h->op->remove_callback = nop_remove_callback;
@@ -129,9 +134,12 @@ void hash_table_destroy(hash_table_t *h)
 	clear_items(h);
 
 	free(h->bucket);
+	free(h->old_bucket);
 
 	h->bucket = NULL;
 	h->bucket_cnt = 0;
+	h->old_bucket = NULL;
+	h->old_bucket_cnt = 0;
 }
 
 /** Returns true if there are no items in the table. */
@@ -181,6 +189,16 @@ static void clear_items(hash_table_t *h)
 		}
 	}
 
+	for (size_t idx = 0; idx < h->old_bucket_cnt; ++idx) {
+		list_foreach_safe(h->old_bucket[idx], cur, next) {
+			assert(cur);
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			list_remove(cur);
+			h->op->remove_callback(cur_link);
+		}
+	}
+
 	h->item_cnt = 0;
 }
 
@@ -195,6 +213,8 @@ void hash_table_insert(hash_table_t *h, ht_link_t *item)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
+	migrate_step(h);
+
 	size_t idx = h->op->hash(item) % h->bucket_cnt;
 
 	list_append(&item->link, &h->bucket[idx]);
@@ -217,6 +237,8 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 	assert(h->op && h->op->hash && h->op->equal);
 	assert(!h->apply_ongoing);
 
+	migrate_step(h);
+
 	size_t idx = h->op->hash(item) % h->bucket_cnt;
 
 	/* Check for duplicates. */
@@ -229,6 +251,16 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 			return false;
 	}
 
+	/* Items not yet migrated live in the old table. */
+	if (h->old_bucket != NULL) {
+		size_t old_idx = h->op->hash(item) % h->old_bucket_cnt;
+
+		list_foreach(h->old_bucket[old_idx], link, ht_link_t, cur_link) {
+			if (h->op->equal(cur_link, item))
+				return false;
+		}
+	}
+
 	list_append(&item->link, &h->bucket[idx]);
 	++h->item_cnt;
 	grow_if_needed(h);
@@ -261,6 +293,17 @@ ht_link_t *hash_table_find(const hash_table_t *h, const void *key)
 		}
 	}
 
+	/* Items not yet migrated live in the old table. */
+	if (h->old_bucket != NULL) {
+		size_t old_idx = h->op->key_hash(key) % h->old_bucket_cnt;
+
+		list_foreach(h->old_bucket[old_idx], link, ht_link_t, cur_link) {
+			if (h->op->key_equal(key, cur_link)) {
+				return cur_link;
+			}
+		}
+	}
+
 	return NULL;
 }
 
@@ -272,6 +315,8 @@ hash_table_find_next(const hash_table_t *h, ht_link_t *first, ht_link_t *item)
 	assert(h && h->bucket);
 
 	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	size_t old_idx = (h->old_bucket != NULL) ?
+	    (h->op->hash(item) % h->old_bucket_cnt) : 0;
 
 	/* Traverse the circular list until we reach the starting item again. */
 	for (link_t *cur = item->link.next; cur != &first->link;
@@ -281,6 +326,10 @@ hash_table_find_next(const hash_table_t *h, ht_link_t *first, ht_link_t *item)
 		if (cur == &h->bucket[idx].head)
 			continue;
 
+		if (h->old_bucket != NULL &&
+		    cur == &h->old_bucket[old_idx].head)
+			continue;
+
 		ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
 		/*
 		 * Is this is the item we are looking for? We could have first
@@ -310,6 +359,8 @@ size_t hash_table_remove(hash_table_t *h, const void *key)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
+	migrate_step(h);
+
 	size_t idx = h->op->key_hash(key) % h->bucket_cnt;
 
 	size_t removed = 0;
@@ -324,6 +375,21 @@ size_t hash_table_remove(hash_table_t *h, const void *key)
 		}
 	}
 
+	/* Items not yet migrated live in the old table. */
+	if (h->old_bucket != NULL) {
+		size_t old_idx = h->op->key_hash(key) % h->old_bucket_cnt;
+
+		list_foreach_safe(h->old_bucket[old_idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			if (h->op->key_equal(key, cur_link)) {
+				++removed;
+				list_remove(cur);
+				h->op->remove_callback(cur_link);
+			}
+		}
+	}
+
 	h->item_cnt -= removed;
 	shrink_if_needed(h);
 
@@ -373,6 +439,15 @@ void hash_table_apply(hash_table_t *h, bool (*f)(ht_link_t *, void *), void *arg
 				goto out;
 		}
 	}
+
+	for (size_t idx = 0; idx < h->old_bucket_cnt; ++idx) {
+		list_foreach_safe(h->old_bucket[idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			if (!f(cur_link, arg))
+				goto out;
+		}
+	}
 out:
 	h->apply_ongoing = false;
 
@@ -432,7 +507,51 @@ static inline void grow_if_needed(hash_table_t *h)
 	}
 }
 
-/** Allocates and rehashes items to a new table. Frees the old table. */
+/** Buckets of the old table migrated per table operation. */
+#define HT_MIGRATE_STEP  8
+
+/** Move a bounded number of buckets from the old table.
+ *
+ * Incremental rehashing: each call drains at most HT_MIGRATE_STEP
+ * buckets of the superseded table, so no single operation ever
+ * pays for rehashing the entire table.
+ */
+static void migrate_step(hash_table_t *h)
+{
+	if (!h->old_bucket || h->apply_ongoing)
+		return;
+
+	size_t moved = 0;
+	while (h->migrate_idx < h->old_bucket_cnt &&
+	    moved < HT_MIGRATE_STEP) {
+		list_foreach_safe(h->old_bucket[h->migrate_idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			size_t idx = h->op->hash(cur_link) % h->bucket_cnt;
+			list_remove(cur);
+			list_append(cur, &h->bucket[idx]);
+		}
+
+		h->migrate_idx++;
+		moved++;
+	}
+
+	if (h->migrate_idx >= h->old_bucket_cnt) {
+		free(h->old_bucket);
+		h->old_bucket = NULL;
+		h->old_bucket_cnt = 0;
+		h->migrate_idx = 0;
+	}
+}
+
+/** Complete any migration still in progress. */
+static void migrate_finish(hash_table_t *h)
+{
+	while (h->old_bucket != NULL)
+		migrate_step(h);
+}
+
+/** Allocates a new table and migrates the items to it incrementally. */
 static void resize(hash_table_t *h, size_t new_bucket_cnt)
 {
 	assert(h && h->bucket);
@@ -442,29 +561,25 @@ static void resize(hash_table_t *h, size_t new_bucket_cnt)
 	if (h->apply_ongoing)
 		return;
 
+	/* Only one migration can be in flight. */
+	migrate_finish(h);
+
 	list_t *new_buckets;
 
 	/* Leave the table as is if we cannot resize. */
 	if (!alloc_table(new_bucket_cnt, &new_buckets))
 		return;
 
-	if (0 < h->item_cnt) {
-		/* Rehash all the items to the new table. */
-		for (size_t old_idx = 0; old_idx < h->bucket_cnt; ++old_idx) {
-			list_foreach_safe(h->bucket[old_idx], cur, next) {
-				ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
-
-				size_t new_idx = h->op->hash(cur_link) % new_bucket_cnt;
-				list_remove(cur);
-				list_append(cur, &new_buckets[new_idx]);
-			}
-		}
-	}
+	/* Retire the current table; operations drain it gradually. */
+	h->old_bucket = h->bucket;
+	h->old_bucket_cnt = h->bucket_cnt;
+	h->migrate_idx = 0;
 
-	free(h->bucket);
 	h->bucket = new_buckets;
 	h->bucket_cnt = new_bucket_cnt;
 	h->full_item_cnt = h->max_load * h->bucket_cnt;
+
+	migrate_step(h);
 }
 
 /** @}
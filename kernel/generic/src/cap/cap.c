@@ -87,7 +87,9 @@
 #include <ipc/ipc.h>
 #include <ipc/irq.h>
 
+#include <atomic.h>
 #include <limits.h>
+#include <mem.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -95,6 +97,9 @@
 #define CAPS_SIZE	(INT_MAX - (int) CAPS_START)
 #define CAPS_LAST	(CAPS_SIZE - 1)
 
+/** Initial number of slots of the direct-indexed lookup table. */
+#define CAPS_SLOTS_INITIAL	64
+
 static slab_cache_t *cap_cache;
 static slab_cache_t *kobject_cache;
 
@@ -154,8 +159,18 @@ errno_t caps_task_alloc(task_t *task)
 		goto error_span;
 	if (!hash_table_create(&task->cap_info->caps, 0, 0, &caps_ops))
 		goto error_span;
+	task->cap_info->slots = malloc(sizeof(cap_slots_t) +
+	    CAPS_SLOTS_INITIAL * sizeof(cap_t *));
+	if (!task->cap_info->slots)
+		goto error_table;
+	memsetb(task->cap_info->slots, sizeof(cap_slots_t) +
+	    CAPS_SLOTS_INITIAL * sizeof(cap_t *), 0);
+	task->cap_info->slots->len = CAPS_SLOTS_INITIAL;
+	atomic_store(&task->cap_info->active_readers, 0);
 	return EOK;
 
+error_table:
+	hash_table_destroy(&task->cap_info->caps);
 error_span:
 	ra_arena_destroy(task->cap_info->handles);
 error_handles:
@@ -183,6 +198,7 @@ void caps_task_free(task_t *task)
 {
 	hash_table_destroy(&task->cap_info->caps);
 	ra_arena_destroy(task->cap_info->handles);
+	free(task->cap_info->slots);
 	free(task->cap_info);
 }
 
@@ -229,6 +245,80 @@ static void cap_initialize(cap_t *cap, task_t *task, cap_handle_t handle)
 	link_initialize(&cap->type_link);
 }
 
+/** Wait until no lock-free capability lookup is in flight.
+ *
+ * Must be called with the cap_info lock held, after the update that
+ * the readers must not miss (a state change or a slot swap) has been
+ * made. Reader critical sections are a handful of loads, so the busy
+ * wait is short.
+ *
+ * @param ci  Capability info structure to drain.
+ */
+static void caps_drain_readers(cap_info_t *ci)
+{
+	assert(mutex_locked(&ci->lock));
+
+	while (atomic_load(&ci->active_readers) > 0)
+		;
+}
+
+/** Install a capability into the direct-indexed lookup table.
+ *
+ * Grows the table when the handle does not fit. Growth failure is
+ * tolerated: lookups of the affected handle simply take the locked
+ * slow path.
+ *
+ * @param ci   Capability info structure.
+ * @param cap  Capability to install.
+ */
+static void caps_slot_install(cap_info_t *ci, cap_t *cap)
+{
+	assert(mutex_locked(&ci->lock));
+
+	size_t idx = cap_handle_raw(cap->handle) - CAPS_START;
+
+	if (idx >= ci->slots->len) {
+		size_t new_len = ci->slots->len;
+		while (new_len <= idx)
+			new_len *= 2;
+
+		cap_slots_t *new_slots = malloc(sizeof(cap_slots_t) +
+		    new_len * sizeof(cap_t *));
+		if (!new_slots)
+			return;
+
+		memsetb(new_slots, sizeof(cap_slots_t) +
+		    new_len * sizeof(cap_t *), 0);
+		new_slots->len = new_len;
+		for (size_t i = 0; i < ci->slots->len; i++)
+			new_slots->cap[i] = ci->slots->cap[i];
+
+		cap_slots_t *old_slots = ci->slots;
+		ci->slots = new_slots;
+
+		/* Free the old table only when nobody reads it. */
+		caps_drain_readers(ci);
+		free(old_slots);
+	}
+
+	ci->slots->cap[idx] = cap;
+}
+
+/** Remove a capability from the direct-indexed lookup table.
+ *
+ * @param ci   Capability info structure.
+ * @param cap  Capability to remove.
+ */
+static void caps_slot_remove(cap_info_t *ci, cap_t *cap)
+{
+	assert(mutex_locked(&ci->lock));
+
+	size_t idx = cap_handle_raw(cap->handle) - CAPS_START;
+
+	if (idx < ci->slots->len)
+		ci->slots->cap[idx] = NULL;
+}
+
 /** Get capability using capability handle
  *
  * @param task    Task whose capability to get.
@@ -278,6 +368,7 @@ errno_t cap_alloc(task_t *task, cap_handle_t *handle)
 	}
 	cap_initialize(cap, task, (cap_handle_t) hbase);
 	hash_table_insert(&task->cap_info->caps, &cap->caps_link);
+	caps_slot_install(task->cap_info, cap);
 
 	cap->state = CAP_STATE_ALLOCATED;
 	*handle = cap->handle;
@@ -353,6 +444,14 @@ restart:
 			}
 			cap_unpublish_unsafe(cap);
 			mutex_unlock(&kobj->caps_list_lock);
+
+			/*
+			 * Make sure no lock-free lookup is still
+			 * working with the capability before the
+			 * reference is handed over to the caller
+			 * (which may drop it right away).
+			 */
+			caps_drain_readers(task->cap_info);
 		}
 	}
 	mutex_unlock(&task->cap_info->lock);
@@ -379,6 +478,13 @@ void cap_revoke(kobject_t *kobj)
 		cap_t *cap = list_get_instance(cur, cap_t, kobj_link);
 		mutex_lock(&cap->task->cap_info->lock);
 		cap_unpublish_unsafe(cap);
+
+		/*
+		 * Let in-flight lock-free lookups finish before the
+		 * capability's reference is dropped.
+		 */
+		caps_drain_readers(cap->task->cap_info);
+
 		/* Drop the reference for the unpublished capability */
 		kobject_put(kobj);
 		mutex_unlock(&cap->task->cap_info->lock);
@@ -402,7 +508,15 @@ void cap_free(task_t *task, cap_handle_t handle)
 	assert(cap);
 
 	hash_table_remove_item(&task->cap_info->caps, &cap->caps_link);
+	caps_slot_remove(task->cap_info, cap);
 	ra_free(task->cap_info->handles, cap_handle_raw(handle), 1);
+
+	/*
+	 * A lock-free lookup may still be examining the capability;
+	 * let it finish before the memory is recycled.
+	 */
+	caps_drain_readers(task->cap_info);
+
 	slab_free(cap_cache, cap);
 	mutex_unlock(&task->cap_info->lock);
 }
@@ -444,12 +558,77 @@ void kobject_initialize(kobject_t *kobj, kobject_type_t type, void *raw)
  * @return Kernel object with incremented reference count on success.
  * @return NULL if there is no matching capability or kernel object.
  */
+/** Try to grab a reference to a kernel object.
+ *
+ * Fails when the reference count has already dropped to zero, i.e.
+ * when the object is on its way to destruction.
+ *
+ * @param kobj  Kernel object.
+ *
+ * @return True if a reference was taken.
+ */
+static bool kobject_try_ref(kobject_t *kobj)
+{
+	size_t ref = atomic_load(&kobj->refcnt);
+
+	while (ref > 0) {
+		if (atomic_compare_exchange_weak(&kobj->refcnt, &ref,
+		    ref + 1))
+			return true;
+	}
+
+	return false;
+}
+
 kobject_t *
 kobject_get(struct task *task, cap_handle_t handle, kobject_type_t type)
 {
+	cap_info_t *ci = task->cap_info;
+	uintptr_t raw = cap_handle_raw(handle);
 	kobject_t *kobj = NULL;
 
-	mutex_lock(&task->cap_info->lock);
+	if ((raw < CAPS_START) || (raw > CAPS_LAST))
+		return NULL;
+
+	/*
+	 * Optimistic lock-free fast path. The reader accounting makes
+	 * capability teardown wait for us, so the capability and its
+	 * kernel object stay valid for the duration of this block;
+	 * the revalidation after taking the reference catches
+	 * concurrent unpublishing.
+	 */
+	atomic_fetch_add(&ci->active_readers, 1);
+
+	cap_slots_t *slots = ci->slots;
+	size_t idx = raw - CAPS_START;
+
+	if (idx < slots->len) {
+		cap_t *cap = slots->cap[idx];
+
+		if ((cap != NULL) && (cap->state == CAP_STATE_PUBLISHED)) {
+			kobject_t *k = cap->kobject;
+
+			if ((k != NULL) && (k->type == type) &&
+			    (kobject_try_ref(k))) {
+				if ((cap->state == CAP_STATE_PUBLISHED) &&
+				    (cap->kobject == k))
+					kobj = k;
+				else
+					kobject_put(k);
+			}
+		}
+	}
+
+	atomic_fetch_sub(&ci->active_readers, 1);
+
+	if (kobj)
+		return kobj;
+
+	/*
+	 * Slow path for handles not (or no longer) covered by the
+	 * direct-indexed table.
+	 */
+	mutex_lock(&ci->lock);
 	cap_t *cap = cap_get(task, handle, CAP_STATE_PUBLISHED);
 	if (cap) {
 		if (cap->kobject->type == type) {
@@ -457,7 +636,7 @@ kobject_get(struct task *task, cap_handle_t handle, kobject_type_t type)
 			atomic_inc(&kobj->refcnt);
 		}
 	}
-	mutex_unlock(&task->cap_info->lock);
+	mutex_unlock(&ci->lock);
 
 	return kobj;
 }
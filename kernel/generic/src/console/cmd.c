@@ -228,6 +228,28 @@ static cmd_info_t bench_info = {
 	.argv = bench_argv
 };
 
+/* Data and methods for 'kbench' command. */
+static int cmd_kbench(cmd_arg_t *argv);
+static char kbench_buf[MAX_CMDLINE + 1];
+static cmd_arg_t kbench_argv[] = {
+	{
+		.type = ARG_TYPE_STRING,
+		.buffer = kbench_buf,
+		.len = sizeof(kbench_buf)
+	},
+	{
+		.type = ARG_TYPE_INT,
+	}
+};
+static cmd_info_t kbench_info = {
+	.name = "kbench",
+	.description = "<bench> <count> Run kernel micro-benchmark "
+	    "(? lists them).",
+	.func = cmd_kbench,
+	.argc = 2,
+	.argv = kbench_argv
+};
+
 #endif /* CONFIG_TEST */
 
 /* Data and methods for 'description' command. */
@@ -503,6 +525,22 @@ static cmd_info_t caches_info = {
 	.argc = 0
 };
 
+static int cmd_slabaudit(cmd_arg_t *argv);
+static cmd_info_t slabaudit_info = {
+	.name = "slabaudit",
+	.description = "Audit slab cache coloring and waste.",
+	.func = cmd_slabaudit,
+	.argc = 0
+};
+
+static int cmd_memprof(cmd_arg_t *argv);
+static cmd_info_t memprof_info = {
+	.name = "memprof",
+	.description = "Print kernel malloc allocation profile.",
+	.func = cmd_memprof,
+	.argc = 0
+};
+
 static int cmd_sysinfo(cmd_arg_t *argv);
 static cmd_info_t sysinfo_info = {
 	.name = "sysinfo",
@@ -586,6 +624,8 @@ static cmd_info_t *basic_commands[] = {
 	&call0_info,
 	&mcall0_info,
 	&caches_info,
+	&slabaudit_info,
+	&memprof_info,
 	&call1_info,
 	&call2_info,
 	&call3_info,
@@ -612,6 +652,7 @@ static cmd_info_t *basic_commands[] = {
 #ifdef CONFIG_TEST
 	&test_info,
 	&bench_info,
+	&kbench_info,
 #endif
 #ifdef CONFIG_UDEBUG
 	&btrace_info,
@@ -1203,6 +1244,30 @@ int cmd_caches(cmd_arg_t *argv)
 	return 1;
 }
 
+/** Command for auditing slab cache packing and coloring
+ *
+ * @param argv Ignored
+ *
+ * @return Always 1
+ */
+int cmd_slabaudit(cmd_arg_t *argv)
+{
+	slab_print_audit();
+	return 1;
+}
+
+/** Command for printing the kernel malloc allocation profile
+ *
+ * @param argv Ignored
+ *
+ * @return Always 1
+ */
+int cmd_memprof(cmd_arg_t *argv)
+{
+	malloc_print_profile();
+	return 1;
+}
+
 /** Command for dumping sysinfo
  *
  * @param argv Ignores
@@ -1581,6 +1646,13 @@ int cmd_bench(cmd_arg_t *argv)
 	return 1;
 }
 
+/** Run a kernel micro-benchmark. */
+int cmd_kbench(cmd_arg_t *argv)
+{
+	kbench_run((char *) argv->buffer, (size_t) argv[1].intval);
+	return 1;
+}
+
 #endif
 
 /** @}
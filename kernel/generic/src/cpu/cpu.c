@@ -38,6 +38,7 @@
 #include <cpu.h>
 #include <arch.h>
 #include <arch/cpu.h>
+#include <align.h>
 #include <stdlib.h>
 #include <mm/page.h>
 #include <mm/frame.h>
@@ -63,7 +64,13 @@ void cpu_init(void)
 	if (config.cpu_active == 1) {
 #endif /* CONFIG_SMP */
 
-		cpus = (cpu_t *) malloc(sizeof(cpu_t) * config.cpu_count);
+		/*
+		 * The array is cache line aligned so that the per-CPU
+		 * structures of different processors never share a
+		 * line.
+		 */
+		cpus = (cpu_t *) mem_alloc(CACHELINE_SIZE,
+		    sizeof(cpu_t) * config.cpu_count);
 		if (!cpus)
 			panic("Cannot allocate CPU structures.");
 
@@ -85,6 +92,17 @@ void cpu_init(void)
 
 			irq_spinlock_initialize(&cpus[i].lock, "cpus[].lock");
 
+			/*
+			 * Flat topology default: every processor is its own
+			 * package, core and cache domain on node 0. The
+			 * architecture refines this in cpu_arch_init().
+			 */
+			cpus[i].topology.package_id = i;
+			cpus[i].topology.core_id = 0;
+			cpus[i].topology.smt_id = 0;
+			cpus[i].topology.llc_id = i;
+			cpus[i].topology.numa_node = 0;
+
 			for (unsigned int j = 0; j < RQ_COUNT; j++) {
 				irq_spinlock_initialize(&cpus[i].rq[j].lock, "cpus[].rq[].lock");
 				list_initialize(&cpus[i].rq[j].rq);
@@ -109,6 +127,88 @@ void cpu_init(void)
 	cpu_arch_init();
 }
 
+/** Refine the calling processor's topology from APIC ID widths.
+ *
+ * Architecture code calls this once it knows how many bits of the
+ * processor's physical identifier are occupied by the SMT level, by
+ * the SMT and core levels together, and by everything below the
+ * last-level cache domain; the ids of all levels are carved out of
+ * @a apic_id accordingly. The NUMA node is left alone.
+ *
+ * @param apic_id    The processor's physical identifier.
+ * @param smt_width  Identifier bits taken by the SMT level.
+ * @param core_width Identifier bits taken by the SMT + core levels.
+ * @param llc_width  Identifier bits below the last-level cache domain.
+ *
+ */
+void cpu_topology_refine(unsigned int apic_id, unsigned int smt_width,
+    unsigned int core_width, unsigned int llc_width)
+{
+	if (core_width < smt_width)
+		core_width = smt_width;
+
+	CPU->topology.smt_id = apic_id & ((1U << smt_width) - 1);
+	CPU->topology.core_id = (apic_id >> smt_width) &
+	    ((1U << (core_width - smt_width)) - 1);
+	CPU->topology.package_id = apic_id >> core_width;
+	CPU->topology.llc_id = apic_id >> llc_width;
+}
+
+/** Export the CPU topology through sysinfo.
+ *
+ * Called once on the bootstrap processor after all processors have
+ * been initialized, so that userspace (and the scheduler diagnostics)
+ * can see the package/core/SMT/cache/NUMA layout.
+ *
+ */
+void cpu_topology_export(void)
+{
+	char name[32];
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		snprintf(name, sizeof(name), "cpu.%zu.package", i);
+		sysinfo_set_item_val(name, NULL, cpus[i].topology.package_id);
+		snprintf(name, sizeof(name), "cpu.%zu.core", i);
+		sysinfo_set_item_val(name, NULL, cpus[i].topology.core_id);
+		snprintf(name, sizeof(name), "cpu.%zu.smt", i);
+		sysinfo_set_item_val(name, NULL, cpus[i].topology.smt_id);
+		snprintf(name, sizeof(name), "cpu.%zu.llc", i);
+		sysinfo_set_item_val(name, NULL, cpus[i].topology.llc_id);
+		snprintf(name, sizeof(name), "cpu.%zu.numa_node", i);
+		sysinfo_set_item_val(name, NULL, cpus[i].topology.numa_node);
+	}
+}
+
+/** Find an idle processor sharing the last-level cache.
+ *
+ * Scan the active processors for an idle one which belongs to the
+ * same last-level cache domain as @a cpu. The idle indication is
+ * read without taking the CPU lock as the result is only a placement
+ * hint and may be stale by the time the caller acts on it.
+ *
+ * @param cpu Processor whose cache domain is to be searched.
+ *
+ * @return Idle sibling processor or NULL if there is none.
+ *
+ */
+cpu_t *cpu_find_idle_llc_sibling(cpu_t *cpu)
+{
+	for (size_t i = 0; i < config.cpu_active; i++) {
+		cpu_t *other = &cpus[i];
+
+		if ((other == cpu) || (!other->active))
+			continue;
+
+		if (other->topology.llc_id != cpu->topology.llc_id)
+			continue;
+
+		if ((other->idle) && (atomic_load(&other->nrdy) == 0))
+			return other;
+	}
+
+	return NULL;
+}
+
 /** List all processors. */
 void cpu_list(void)
 {
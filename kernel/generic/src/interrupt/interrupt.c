@@ -147,6 +147,10 @@ _NO_TRACE void exc_dispatch(unsigned int n, istate_t *istate)
 	exc_table[n].count++;
 	irq_spinlock_unlock(&exctbl_lock, false);
 
+	/* Interrupts are disabled here, so the CPU cannot change. */
+	if (CPU)
+		latency_record(CPU->exc_latency, end_cycle - begin_cycle);
+
 	/* Do not charge THREAD for exception cycles */
 	if (THREAD) {
 		irq_spinlock_lock(&THREAD->lock, false);
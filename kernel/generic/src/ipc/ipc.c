@@ -50,6 +50,7 @@
 #include <ipc/sysipc_ops.h>
 #include <ipc/sysipc_priv.h>
 #include <errno.h>
+#include <mm/frame.h>
 #include <mm/slab.h>
 #include <arch.h>
 #include <proc/task.h>
@@ -94,6 +95,11 @@ static void call_destroy(void *arg)
 
 	if (call->buffer)
 		free(call->buffer);
+	if (call->zc_frames) {
+		for (size_t i = 0; i < call->zc_count; i++)
+			frame_free_noreserve(call->zc_frames[i], 1);
+		free(call->zc_frames);
+	}
 	if (call->caller_phone)
 		kobject_put(call->caller_phone->kobject);
 	slab_free(call_cache, call);
@@ -141,6 +147,7 @@ call_t *ipc_call_alloc(void)
 void ipc_answerbox_init(answerbox_t *box, task_t *task)
 {
 	irq_spinlock_initialize(&box->lock, "ipc.box.lock");
+	irq_spinlock_initialize(&box->answers_lock, "ipc.box.answerslock");
 	irq_spinlock_initialize(&box->irq_lock, "ipc.box.irqlock");
 	waitq_initialize(&box->wq);
 	list_initialize(&box->connected_phones);
@@ -279,10 +286,8 @@ errno_t ipc_call_sync(phone_t *phone, call_t *request)
 /** Answer a message which was not dispatched and is not listed in any queue.
  *
  * @param call       Call structure to be answered.
- * @param selflocked If true, then TASK->answebox is locked.
- *
  */
-void _ipc_answer_free_call(call_t *call, bool selflocked)
+void _ipc_answer_free_call(call_t *call)
 {
 	/* Count sent answer */
 	irq_spinlock_lock(&TASK->lock, true);
@@ -311,21 +316,22 @@ void _ipc_answer_free_call(call_t *call, bool selflocked)
 
 	answerbox_t *callerbox = call->callerbox ? call->callerbox :
 	    &call->sender->answerbox;
-	bool do_lock = ((!selflocked) || (callerbox != &TASK->answerbox));
 
 	call->flags |= IPC_CALL_ANSWERED;
 
 	call->data.task_id = TASK->taskid;
 
-	if (do_lock)
-		irq_spinlock_lock(&callerbox->lock, true);
-
+	/*
+	 * The answers list has its own lock shard, so it is safe to
+	 * take it even when the caller already holds the main lock of
+	 * the very same answerbox.
+	 */
+	irq_spinlock_lock(&callerbox->answers_lock, true);
 	list_append(&call->ab_link, &callerbox->answers);
+	irq_spinlock_unlock(&callerbox->answers_lock, true);
 
-	if (do_lock)
-		irq_spinlock_unlock(&callerbox->lock, true);
-
-	waitq_wakeup(&callerbox->wq, WAKEUP_FIRST);
+	/* The answered caller gets a dispatch boost (handoff). */
+	waitq_wakeup_boost(&callerbox->wq);
 }
 
 /** Answer a message which is in a callee queue.
@@ -342,7 +348,7 @@ void ipc_answer(answerbox_t *box, call_t *call)
 	irq_spinlock_unlock(&box->lock, true);
 
 	/* Send back answer */
-	_ipc_answer_free_call(call, false);
+	_ipc_answer_free_call(call);
 }
 
 static void _ipc_call_actions_internal(phone_t *phone, call_t *call,
@@ -387,7 +393,7 @@ void ipc_backsend_err(phone_t *phone, call_t *call, errno_t err)
 {
 	_ipc_call_actions_internal(phone, call, false);
 	ipc_set_retval(&call->data, err);
-	_ipc_answer_free_call(call, false);
+	_ipc_answer_free_call(call);
 }
 
 /** Unsafe unchecking version of ipc_call.
@@ -575,9 +581,14 @@ errno_t ipc_wait_for_call(answerbox_t *box, uint32_t usec, unsigned int flags,
 		answer_cnt++;
 
 		/* Handle asynchronous answers */
+		irq_spinlock_lock(&box->answers_lock, false);
+
 		request = list_get_instance(list_first(&box->answers),
 		    call_t, ab_link);
 		list_remove(&request->ab_link);
+
+		irq_spinlock_unlock(&box->answers_lock, false);
+
 		atomic_dec(&request->caller_phone->active_calls);
 		atomic_dec(&box->active_calls);
 		kobject_put(request->caller_phone->kobject);
@@ -620,13 +631,21 @@ errno_t ipc_wait_for_call(answerbox_t *box, uint32_t usec, unsigned int flags,
  */
 void ipc_cleanup_call_list(answerbox_t *box, list_t *lst)
 {
+	/* The answers list additionally lives under its lock shard. */
+	bool shard = (lst == &box->answers);
+
 	irq_spinlock_lock(&box->lock, true);
+	if (shard)
+		irq_spinlock_lock(&box->answers_lock, false);
+
 	while (!list_empty(lst)) {
 		call_t *call = list_get_instance(list_first(lst), call_t,
 		    ab_link);
 
 		list_remove(&call->ab_link);
 
+		if (shard)
+			irq_spinlock_unlock(&box->answers_lock, false);
 		irq_spinlock_unlock(&box->lock, true);
 
 		if (lst == &box->calls)
@@ -635,10 +654,15 @@ void ipc_cleanup_call_list(answerbox_t *box, list_t *lst)
 		ipc_data_t old = call->data;
 		ipc_set_retval(&call->data, EHANGUP);
 		answer_preprocess(call, &old);
-		_ipc_answer_free_call(call, true);
+		_ipc_answer_free_call(call);
 
 		irq_spinlock_lock(&box->lock, true);
+		if (shard)
+			irq_spinlock_lock(&box->answers_lock, false);
 	}
+
+	if (shard)
+		irq_spinlock_unlock(&box->answers_lock, false);
 	irq_spinlock_unlock(&box->lock, true);
 }
 
@@ -891,6 +915,13 @@ void ipc_init(void)
 	    NULL, 0);
 	answerbox_cache = slab_cache_create("answerbox_t", sizeof(answerbox_t),
 	    0, NULL, NULL, 0);
+
+	/*
+	 * Call structures churn at the highest rate of the three;
+	 * warm up the boot CPU's magazines so that the first IPC
+	 * bursts recycle objects instead of growing the cache.
+	 */
+	(void) slab_cache_prefill(call_cache, SLAB_MAG_SIZE);
 }
 
 static void ipc_print_call_list(list_t *list)
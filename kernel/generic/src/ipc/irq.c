@@ -113,16 +113,19 @@ static errno_t ranges_map_and_apply(irq_pio_range_t *ranges, size_t rangecount,
 		case CMD_PIO_READ_8:
 		case CMD_PIO_WRITE_8:
 		case CMD_PIO_WRITE_A_8:
+		case CMD_PIO_RMW_8:
 			size = 1;
 			break;
 		case CMD_PIO_READ_16:
 		case CMD_PIO_WRITE_16:
 		case CMD_PIO_WRITE_A_16:
+		case CMD_PIO_RMW_16:
 			size = 2;
 			break;
 		case CMD_PIO_READ_32:
 		case CMD_PIO_WRITE_32:
 		case CMD_PIO_WRITE_A_32:
+		case CMD_PIO_RMW_32:
 			size = 4;
 			break;
 		default:
@@ -191,6 +194,12 @@ static errno_t code_check(irq_cmd_t *cmds, size_t cmdcount)
 			if (i + cmds[i].value > cmdcount)
 				return EINVAL;
 
+			break;
+		case CMD_JUMP_NZ:
+			/* The backward jump must stay in the code. */
+			if (cmds[i].value > i)
+				return EINVAL;
+
 			break;
 		default:
 			break;
@@ -300,6 +309,10 @@ static void irq_destroy(void *arg)
 
 	irq_hash_out(irq);
 
+	/* Drop the coalescing reference, if any. */
+	if (irq->notif_cfg.pending_call)
+		kobject_put(irq->notif_cfg.pending_call->kobject);
+
 	/* Free up the IRQ code and associated structures. */
 	code_free(irq->notif_cfg.code);
 	slab_free(irq_cache, irq);
@@ -371,6 +384,7 @@ errno_t ipc_irq_subscribe(answerbox_t *box, inr_t inr, sysarg_t imethod,
 	irq->notif_cfg.imethod = imethod;
 	irq->notif_cfg.code = code;
 	irq->notif_cfg.counter = 0;
+	irq->notif_cfg.pending_call = NULL;
 
 	/*
 	 * Insert the IRQ structure into the uspace IRQ hash table.
@@ -431,6 +445,69 @@ static void send_call(irq_t *irq, call_t *call)
 	waitq_wakeup(&irq->notif_cfg.answerbox->wq, WAKEUP_FIRST);
 }
 
+/** Coalesce the interrupt into a still-undelivered notification.
+ *
+ * Only used when the subscription opted in via irq_code_t.coalesce.
+ * If the previous notification of this IRQ has not been fetched by
+ * the driver yet, there is no point in queueing another one: the
+ * driver will poll the device for everything that accumulated when
+ * it gets to run, NAPI style. The counter is updated so that the
+ * driver can see how many interrupts the notification stands for
+ * and the scratch arguments of this interrupt are OR-ed into the
+ * pending call, so status bits read by the top half accumulate
+ * rather than vanish.
+ *
+ * Expects interrupts to be disabled and irq->lock held.
+ *
+ * @param irq IRQ structure.
+ *
+ * @return True if the interrupt was coalesced, false when a new
+ *         notification has to be sent.
+ *
+ */
+static bool ipc_irq_coalesce(irq_t *irq)
+{
+	call_t *pending = irq->notif_cfg.pending_call;
+	uint32_t *scratch = irq->notif_cfg.scratch;
+
+	if (pending == NULL)
+		return false;
+
+	answerbox_t *box = irq->notif_cfg.answerbox;
+	bool coalesced = false;
+
+	irq_spinlock_lock(&box->irq_lock, false);
+
+	if (link_in_use(&pending->ab_link)) {
+		/*
+		 * Still queued (thus not copied out to uspace yet);
+		 * merge this interrupt into it.
+		 */
+		pending->priv = ++irq->notif_cfg.counter;
+		ipc_set_arg1(&pending->data,
+		    ipc_get_arg1(&pending->data) | scratch[1]);
+		ipc_set_arg2(&pending->data,
+		    ipc_get_arg2(&pending->data) | scratch[2]);
+		ipc_set_arg3(&pending->data,
+		    ipc_get_arg3(&pending->data) | scratch[3]);
+		ipc_set_arg4(&pending->data,
+		    ipc_get_arg4(&pending->data) | scratch[4]);
+		ipc_set_arg5(&pending->data,
+		    ipc_get_arg5(&pending->data) | scratch[5]);
+		coalesced = true;
+	}
+
+	irq_spinlock_unlock(&box->irq_lock, false);
+
+	if (!coalesced) {
+		/* Delivered meanwhile; drop the coalescing reference. */
+		irq->notif_cfg.pending_call = NULL;
+		kobject_put(pending->kobject);
+	}
+
+	return coalesced;
+}
+
 /** Apply the top-half IRQ code to find out whether to accept the IRQ or not.
  *
  * @param irq IRQ structure.
@@ -450,10 +527,20 @@ irq_ownership_t ipc_irq_top_half_claim(irq_t *irq)
 	if (!code)
 		return IRQ_DECLINE;
 
+	/*
+	 * With backward jumps in the instruction set, bound the
+	 * total work done in the top half; a misprogrammed loop
+	 * declines the interrupt instead of wedging the CPU.
+	 */
+	size_t executed = 0;
+
 	for (size_t i = 0; i < code->cmdcount; i++) {
 		uintptr_t srcarg = code->cmds[i].srcarg;
 		uintptr_t dstarg = code->cmds[i].dstarg;
 
+		if (++executed > 4096)
+			return IRQ_DECLINE;
+
 		switch (code->cmds[i].cmd) {
 		case CMD_PIO_READ_8:
 			scratch[dstarg] =
@@ -502,6 +589,42 @@ irq_ownership_t ipc_irq_top_half_claim(irq_t *irq)
 			if (scratch[srcarg] == 0)
 				i += code->cmds[i].value;
 
+			break;
+		case CMD_PIO_RMW_8: {
+			uint8_t tmp =
+			    pio_read_8((ioport8_t *) code->cmds[i].addr);
+			pio_write_8((ioport8_t *) code->cmds[i].addr,
+			    (uint8_t) ((tmp & ~code->cmds[i].value) |
+			    (scratch[srcarg] & code->cmds[i].value)));
+			scratch[dstarg] = tmp;
+			break;
+		}
+		case CMD_PIO_RMW_16: {
+			uint16_t tmp =
+			    pio_read_16((ioport16_t *) code->cmds[i].addr);
+			pio_write_16((ioport16_t *) code->cmds[i].addr,
+			    (uint16_t) ((tmp & ~code->cmds[i].value) |
+			    (scratch[srcarg] & code->cmds[i].value)));
+			scratch[dstarg] = tmp;
+			break;
+		}
+		case CMD_PIO_RMW_32: {
+			uint32_t tmp =
+			    pio_read_32((ioport32_t *) code->cmds[i].addr);
+			pio_write_32((ioport32_t *) code->cmds[i].addr,
+			    (tmp & ~code->cmds[i].value) |
+			    (scratch[srcarg] & code->cmds[i].value));
+			scratch[dstarg] = tmp;
+			break;
+		}
+		case CMD_SUB:
+			scratch[dstarg] = scratch[srcarg] -
+			    code->cmds[i].value;
+			break;
+		case CMD_JUMP_NZ:
+			if (scratch[srcarg] != 0)
+				i -= code->cmds[i].value;
+
 			break;
 		case CMD_ACCEPT:
 			return IRQ_ACCEPT;
@@ -529,6 +652,11 @@ void ipc_irq_top_half_handler(irq_t *irq)
 	assert(irq_spinlock_locked(&irq->lock));
 
 	if (irq->notif_cfg.answerbox) {
+		bool coalesce = irq->notif_cfg.code->coalesce;
+
+		if (coalesce && ipc_irq_coalesce(irq))
+			return;
+
 		call_t *call = ipc_call_alloc();
 		if (!call)
 			return;
@@ -545,6 +673,12 @@ void ipc_irq_top_half_handler(irq_t *irq)
 		ipc_set_arg4(&call->data, irq->notif_cfg.scratch[4]);
 		ipc_set_arg5(&call->data, irq->notif_cfg.scratch[5]);
 
+		if (coalesce) {
+			/* Keep a reference for coalescing. */
+			kobject_add_ref(call->kobject);
+			irq->notif_cfg.pending_call = call;
+		}
+
 		send_call(irq, call);
 	}
 }
@@ -32,14 +32,127 @@
 /** @file
  */
 
+#include <align.h>
 #include <assert.h>
 #include <ipc/sysipc_ops.h>
 #include <ipc/ipc.h>
+#include <macros.h>
+#include <mm/frame.h>
+#include <mm/km.h>
+#include <mm/page.h>
 #include <stdlib.h>
 #include <abi/errno.h>
+#include <arch.h>
 #include <syscall/copy.h>
 #include <config.h>
 
+/** Pin the sender's pages backing the outgoing data.
+ *
+ * Resolve and reference the physical frames of the source buffer so
+ * that the answer phase can copy straight from them, avoiding both
+ * the kernel bounce buffer and the second copy. Fails (and lets the
+ * caller fall back to the copying path) whenever any page of the
+ * buffer is not present in the sender's address space.
+ *
+ * @param call Call structure.
+ * @param src  Source address in the sender's address space.
+ * @param size Size of the data.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+static errno_t zc_pin_source(call_t *call, uspace_addr_t src, size_t size)
+{
+	uintptr_t first = ALIGN_DOWN(src, PAGE_SIZE);
+	size_t count = (ALIGN_UP(src + size, PAGE_SIZE) - first) / PAGE_SIZE;
+
+	uintptr_t *frames = malloc(count * sizeof(uintptr_t));
+	if (!frames)
+		return ENOMEM;
+
+	page_table_lock(AS, true);
+
+	for (size_t i = 0; i < count; i++) {
+		pte_t pte;
+
+		/*
+		 * Pages which are not resident or which are not backed
+		 * by zone memory (e.g. memory-mapped I/O) disqualify
+		 * the buffer from pinning.
+		 */
+		if ((!page_mapping_find(AS, first + P2SZ(i), false, &pte)) ||
+		    (!PTE_PRESENT(&pte)) ||
+		    (!frame_reference_try_add(ADDR2PFN(PTE_GET_FRAME(&pte))))) {
+			page_table_unlock(AS, true);
+
+			/* Drop the references taken so far. */
+			for (size_t j = 0; j < i; j++)
+				frame_free_noreserve(frames[j], 1);
+
+			free(frames);
+			return ENOENT;
+		}
+
+		frames[i] = PTE_GET_FRAME(&pte);
+	}
+
+	page_table_unlock(AS, true);
+
+	call->zc_frames = frames;
+	call->zc_count = count;
+	call->zc_offset = src - first;
+	call->zc_size = size;
+
+	return EOK;
+}
+
+/** Copy pinned data directly to the recipient.
+ *
+ * @param answer Answered call with pinned source frames.
+ * @param dst    Destination address in the recipient's address space.
+ * @param size   Number of bytes to copy.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+static errno_t zc_copy_to_recipient(call_t *answer, uspace_addr_t dst,
+    size_t size)
+{
+	size_t done = 0;
+	size_t offset = answer->zc_offset;
+
+	for (size_t i = 0; (i < answer->zc_count) && (done < size); i++) {
+		size_t chunk = min(PAGE_SIZE - offset, size - done);
+		uintptr_t frame = answer->zc_frames[i];
+
+		/*
+		 * Low-memory frames are accessible through the identity
+		 * mapping; high-memory frames need a temporary window.
+		 */
+		uintptr_t kaddr;
+		bool mapped = (frame >= config.identity_size);
+		if (mapped)
+			kaddr = km_map(frame, PAGE_SIZE, PAGE_SIZE,
+			    PAGE_READ | PAGE_CACHEABLE);
+		else
+			kaddr = PA2KA(frame);
+
+		errno_t rc = copy_to_uspace(dst + done,
+		    (void *) (kaddr + offset), chunk);
+
+		if (mapped)
+			km_unmap(kaddr, PAGE_SIZE);
+
+		if (rc != EOK)
+			return rc;
+
+		done += chunk;
+		offset = 0;
+	}
+
+	return EOK;
+}
+
 static errno_t request_preprocess(call_t *call, phone_t *phone)
 {
 	uspace_addr_t src = ipc_get_arg1(&call->data);
@@ -55,6 +168,17 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 			return ELIMIT;
 	}
 
+	int flags = ipc_get_arg3(&call->data);
+	if ((flags & IPC_XF_ZEROCOPY) && (size >= PAGE_SIZE)) {
+		/*
+		 * Pin the sender's pages and copy only once, at answer
+		 * time, straight to the recipient. Fall back to the
+		 * bounce buffer when any page is not resident.
+		 */
+		if (zc_pin_source(call, src, size) == EOK)
+			return EOK;
+	}
+
 	call->buffer = (uint8_t *) malloc(size);
 	if (!call->buffer)
 		return ENOMEM;
@@ -72,7 +196,7 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 
 static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 {
-	assert(answer->buffer);
+	assert(answer->buffer || answer->zc_frames);
 
 	if (!ipc_get_retval(&answer->data)) {
 		/* The recipient agreed to receive data. */
@@ -81,8 +205,12 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		size_t max_size = ipc_get_arg2(olddata);
 
 		if (size <= max_size) {
-			errno_t rc = copy_to_uspace(dst,
-			    answer->buffer, size);
+			errno_t rc;
+			if (answer->zc_frames)
+				rc = zc_copy_to_recipient(answer, dst, size);
+			else
+				rc = copy_to_uspace(dst,
+				    answer->buffer, size);
 			if (rc)
 				ipc_set_retval(&answer->data, rc);
 		} else {
@@ -458,6 +458,82 @@ sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_da
 	return EOK;
 }
 
+/** Make a batch of asynchronous calls over one phone.
+ *
+ * Amortizes the cost of the kernel entry over up to
+ * IPC_CALL_BATCH_LIMIT calls. The batch stops at the first entry
+ * that cannot be sent; entries sent up to that point stay sent.
+ *
+ * @param handle       Phone capability handle for the calls.
+ * @param uspace_batch Userspace address of an array of batch entries.
+ * @param count        Number of entries in the array.
+ * @param uspace_sent  Userspace address of a variable receiving the
+ *                     number of successfully sent entries. May be
+ *                     USPACE_NULL.
+ *
+ * @return EOK when the whole batch was sent or an error code
+ *         describing why the batch stopped early.
+ *
+ */
+sys_errno_t sys_ipc_call_async_batch(cap_phone_handle_t handle,
+    uspace_ptr_ipc_call_batch_entry_t uspace_batch, sysarg_t count,
+    uspace_ptr_sysarg_t uspace_sent)
+{
+	if ((count == 0) || (count > IPC_CALL_BATCH_LIMIT))
+		return ELIMIT;
+
+	kobject_t *kobj = kobject_get(TASK, handle, KOBJECT_TYPE_PHONE);
+	if (!kobj)
+		return ENOENT;
+
+	ipc_call_batch_entry_t entries[IPC_CALL_BATCH_LIMIT];
+	errno_t rc = copy_from_uspace(entries, uspace_batch,
+	    count * sizeof(ipc_call_batch_entry_t));
+	if (rc != EOK) {
+		kobject_put(kobj);
+		return (sys_errno_t) rc;
+	}
+
+	sysarg_t sent = 0;
+	errno_t ret = EOK;
+
+	for (sysarg_t i = 0; i < count; i++) {
+		if (check_call_limit(kobj->phone)) {
+			ret = ELIMIT;
+			break;
+		}
+
+		call_t *call = ipc_call_alloc();
+		if (!call) {
+			ret = ENOMEM;
+			break;
+		}
+
+		memcpy(call->data.args, entries[i].args,
+		    sizeof(call->data.args));
+		call->data.answer_label = entries[i].label;
+
+		errno_t res = request_preprocess(call, kobj->phone);
+
+		if (!res)
+			ipc_call(kobj->phone, call);
+		else
+			ipc_backsend_err(kobj->phone, call, res);
+
+		sent++;
+	}
+
+	kobject_put(kobj);
+
+	if (uspace_sent != USPACE_NULL) {
+		rc = copy_to_uspace(uspace_sent, &sent, sizeof(sent));
+		if (rc != EOK)
+			return (sys_errno_t) rc;
+	}
+
+	return (sys_errno_t) ret;
+}
+
 /** Forward a received call to another destination
  *
  * Common code for both the fast and the slow version.
@@ -565,7 +641,7 @@ error:
 	ipc_set_retval(&call->data, EFORWARD);
 	(void) answer_preprocess(call, need_old ? &old : NULL);
 	if (after_forward)
-		_ipc_answer_free_call(call, false);
+		_ipc_answer_free_call(call);
 	else
 		ipc_answer(&TASK->answerbox, call);
 
@@ -40,7 +40,9 @@
 #include <ipc/event.h>
 #include <ipc/irq.h>
 #include <arch.h>
+#include <cpu.h>
 #include <panic.h>
+#include <preemption.h>
 #include <putchar.h>
 #include <atomic.h>
 #include <syscall/copy.h>
@@ -112,6 +114,32 @@ static size_t log_copy_to(const uint8_t *data, size_t pos, size_t len)
 	return pos;
 }
 
+/** Check whether the current entry is being staged per-CPU.
+ *
+ * Only meaningful between log_begin() and log_end(), which disable
+ * preemption, so CPU is stable.
+ */
+static bool log_stage_active(void)
+{
+	return (CPU != NULL) && (CPU->log_stage_busy);
+}
+
+/** Append data to the per-CPU staging buffer.
+ *
+ * Data beyond the staging capacity is silently dropped; the capacity
+ * comfortably exceeds ordinary log lines.
+ */
+static void log_stage_append(const uint8_t *data, size_t len)
+{
+	if (len > CPU_LOG_STAGE_SIZE - CPU->log_stage_len)
+		len = CPU_LOG_STAGE_SIZE - CPU->log_stage_len;
+
+	for (size_t i = 0; i < len; i++)
+		CPU->log_stage[CPU->log_stage_len + i] = data[i];
+
+	CPU->log_stage_len += len;
+}
+
 /** Append data to the currently open log entry.
  *
  * This function requires that the log_lock is acquired by the caller.
@@ -145,11 +173,43 @@ static void log_append(const uint8_t *data, size_t len)
 
 /** Begin writing an entry to the log.
  *
- * This acquires the log and output buffer locks, so only calls to log_* functions should
- * be used until calling log_end.
+ * The entry is normally formatted into a per-CPU staging buffer with
+ * preemption disabled and no locks held; early boot and nested calls
+ * acquire the log and output buffer locks instead. Either way, only
+ * calls to log_* functions should be used until calling log_end().
  */
 void log_begin(log_facility_t fac, log_level_t level)
 {
+	preemption_disable();
+
+	uint32_t fac32 = fac;
+	uint32_t lvl32 = level;
+
+	if ((CPU != NULL) && (!CPU->log_stage_busy)) {
+		/*
+		 * Format the whole entry into the per-CPU staging
+		 * buffer without taking any lock; log_end() commits
+		 * it to the shared ring in one go. The counter field
+		 * is filled in at commit time.
+		 */
+		CPU->log_stage_busy = true;
+		CPU->log_stage_len = 0;
+
+		size_t len_placeholder = 0;
+		uint32_t counter_placeholder = 0;
+		log_stage_append((uint8_t *) &len_placeholder,
+		    sizeof(size_t));
+		log_stage_append((uint8_t *) &counter_placeholder,
+		    sizeof(uint32_t));
+		log_stage_append((uint8_t *) &fac32, sizeof(uint32_t));
+		log_stage_append((uint8_t *) &lvl32, sizeof(uint32_t));
+		return;
+	}
+
+	/*
+	 * Early boot or a log call nested in an interrupt while this
+	 * CPU stages another entry: use the locked path directly.
+	 */
 	spinlock_lock(&log_lock);
 	spinlock_lock(&kio_lock);
 
@@ -159,8 +219,6 @@ void log_begin(log_facility_t fac, log_level_t level)
 	/* Write header of the log entry, the length will be written in log_end() */
 	log_append((uint8_t *) &log_current_len, sizeof(size_t));
 	log_append((uint8_t *) &log_counter, sizeof(uint32_t));
-	uint32_t fac32 = fac;
-	uint32_t lvl32 = level;
 	log_append((uint8_t *) &fac32, sizeof(uint32_t));
 	log_append((uint8_t *) &lvl32, sizeof(uint32_t));
 
@@ -169,17 +227,58 @@ void log_begin(log_facility_t fac, log_level_t level)
 
 /** Finish writing an entry to the log.
  *
- * This releases the log and output buffer locks.
+ * Commits a staged entry to the shared ring (taking the locks only
+ * for the bulk copy and console output), or releases the locks held
+ * by the fallback path.
  */
 void log_end(void)
 {
-	/* Set the length in the header to correct value */
-	log_copy_to((uint8_t *) &log_current_len, log_current_start, sizeof(size_t));
-	log_used += log_current_len;
+	if (log_stage_active()) {
+		/*
+		 * Commit the staged entry: the locks are held only
+		 * for the counter assignment, one bulk copy into the
+		 * ring and the console output of the finished line.
+		 */
+		spinlock_lock(&log_lock);
+		spinlock_lock(&kio_lock);
+
+		/* Fill in the counter field of the staged header. */
+		for (size_t i = 0; i < sizeof(uint32_t); i++)
+			CPU->log_stage[sizeof(size_t) + i] =
+			    ((uint8_t *) &log_counter)[i];
+		log_counter++;
+
+		log_current_start = (log_start + log_used) % LOG_LENGTH;
+		log_current_len = 0;
+		log_append(CPU->log_stage, CPU->log_stage_len);
+
+		/* Set the length in the header to correct value */
+		log_copy_to((uint8_t *) &log_current_len,
+		    log_current_start, sizeof(size_t));
+		log_used += log_current_len;
+
+		/* Send the finished line to the console. */
+		size_t offset = sizeof(size_t) + 3 * sizeof(uint32_t);
+		while (offset < CPU->log_stage_len)
+			kio_push_char(str_decode((char *) CPU->log_stage,
+			    &offset, CPU->log_stage_len));
+		kio_push_char('\n');
+
+		spinlock_unlock(&kio_lock);
+		spinlock_unlock(&log_lock);
 
-	kio_push_char('\n');
-	spinlock_unlock(&kio_lock);
-	spinlock_unlock(&log_lock);
+		CPU->log_stage_busy = false;
+	} else {
+		/* Set the length in the header to correct value */
+		log_copy_to((uint8_t *) &log_current_len, log_current_start, sizeof(size_t));
+		log_used += log_current_len;
+
+		kio_push_char('\n');
+		spinlock_unlock(&kio_lock);
+		spinlock_unlock(&log_lock);
+	}
+
+	preemption_enable();
 
 	/* This has to be called after we released the locks above */
 	kio_flush();
@@ -203,6 +302,17 @@ static int log_printf_str_write(const char *str, size_t size, void *data)
 	size_t offset = 0;
 	size_t chars = 0;
 
+	if (log_stage_active()) {
+		log_stage_append((const uint8_t *) str, size);
+
+		while (offset < size) {
+			str_decode(str, &offset, size);
+			chars++;
+		}
+
+		return chars;
+	}
+
 	while (offset < size) {
 		kio_push_char(str_decode(str, &offset, size));
 		chars++;
@@ -220,14 +330,19 @@ static int log_printf_wstr_write(const char32_t *wstr, size_t size, void *data)
 	size_t chars = 0;
 
 	for (offset = 0; offset < size; offset += sizeof(char32_t), chars++) {
-		kio_push_char(wstr[chars]);
-
 		size_t buffer_offset = 0;
 		errno_t rc = chr_encode(wstr[chars], buffer, &buffer_offset, 16);
 		if (rc != EOK) {
 			return EOF;
 		}
 
+		if (log_stage_active()) {
+			log_stage_append((const uint8_t *) buffer,
+			    buffer_offset);
+			continue;
+		}
+
+		kio_push_char(wstr[chars]);
 		log_append((const uint8_t *)buffer, buffer_offset);
 	}
 
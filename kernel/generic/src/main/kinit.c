@@ -78,6 +78,7 @@
 #endif /* CONFIG_SMP */
 
 #include <synch/waitq.h>
+#include <synch/rcu.h>
 #include <synch/spinlock.h>
 
 #define ALIVE_CHARS  4
@@ -151,6 +152,12 @@ void kinit(void *arg)
 	 */
 	ARCH_OP(post_smp_init);
 
+	/*
+	 * Scrub frame zones whose metadata initialization was
+	 * deferred at boot, using all of the CPUs brought up above.
+	 */
+	frame_init_deferred();
+
 	/* Start thread computing system load */
 	thread = thread_create(kload, NULL, TASK, THREAD_FLAG_NONE,
 	    "kload");
@@ -159,6 +166,17 @@ void kinit(void *arg)
 	else
 		log(LF_OTHER, LVL_ERROR, "Unable to create kload thread");
 
+	/* Initialize RCU and start its reclaimer thread */
+	rcu_init();
+
+	/* Start the background page reclamation thread */
+	thread = thread_create(kreclaimd, NULL, TASK, THREAD_FLAG_NONE,
+	    "kreclaimd");
+	if (thread != NULL)
+		thread_ready(thread);
+	else
+		log(LF_OTHER, LVL_ERROR, "Unable to create kreclaimd thread");
+
 #ifdef CONFIG_KCONSOLE
 	if (stdin) {
 		/*
@@ -180,6 +198,11 @@ void kinit(void *arg)
 	 */
 	sysinfo_set_item_val("default.stack_size", NULL, STACK_SIZE_USER);
 
+	/*
+	 * Export the processor topology now that all processors are up.
+	 */
+	cpu_topology_export();
+
 	interrupts_enable();
 
 	/*
@@ -175,6 +175,7 @@ as_t *as_create(unsigned int flags)
 	(void) as_create_arch(as, 0);
 
 	odict_initialize(&as->as_areas, as_areas_getkey, as_areas_cmp);
+	as->area_hint = NULL;
 
 	if (flags & FLAG_AS_KERNEL)
 		as->asid = ASID_KERNEL;
@@ -789,6 +790,7 @@ as_area_t *as_area_create(as_t *as, unsigned int flags, size_t size,
 	area->as = as;
 	odlink_initialize(&area->las_areas);
 	area->flags = flags;
+	area->fault_ahead = 3;
 	area->attributes = attrs;
 	area->pages = pages;
 	area->base = *base;
@@ -864,6 +866,20 @@ _NO_TRACE static as_area_t *find_area_and_lock(as_t *as, uintptr_t va)
 {
 	assert(mutex_locked(&as->lock));
 
+	/*
+	 * Page faults come with strong spatial locality; the last
+	 * area found almost always covers the next lookup too, so
+	 * try it before descending into the area tree.
+	 */
+	as_area_t *hint = as->area_hint;
+	if (hint != NULL && hint->base <= va) {
+		mutex_lock(&hint->lock);
+		if (va <= hint->base + (P2SZ(hint->pages) - 1))
+			return hint;
+
+		mutex_unlock(&hint->lock);
+	}
+
 	odlink_t *odlink = odict_find_leq(&as->as_areas, &va, NULL);
 	if (odlink == NULL)
 		return NULL;
@@ -873,8 +889,10 @@ _NO_TRACE static as_area_t *find_area_and_lock(as_t *as, uintptr_t va)
 
 	assert(area->base <= va);
 
-	if (va <= area->base + (P2SZ(area->pages) - 1))
+	if (va <= area->base + (P2SZ(area->pages) - 1)) {
+		as->area_hint = area;
 		return area;
+	}
 
 	mutex_unlock(&area->lock);
 	return NULL;
@@ -1164,6 +1182,9 @@ errno_t as_area_destroy(as_t *as, uintptr_t address)
 	 */
 	odict_remove(&area->las_areas);
 
+	if (as->area_hint == area)
+		as->area_hint = NULL;
+
 	free(area);
 
 	mutex_unlock(&as->lock);
@@ -1229,6 +1250,14 @@ errno_t as_area_share(as_t *src_as, uintptr_t src_base, size_t acc_size,
 	if (src_flags & AS_AREA_CACHEABLE)
 		dst_flags_mask |= AS_AREA_CACHEABLE;
 
+	/*
+	 * Copy-on-write is a property of the destination area only;
+	 * exclude it from the source flag subset check and reinstate
+	 * it for the area creation below.
+	 */
+	unsigned int dst_cow = dst_flags_mask & AS_AREA_COW;
+	dst_flags_mask &= ~AS_AREA_COW;
+
 	if ((src_size != acc_size) ||
 	    ((src_flags & dst_flags_mask) != dst_flags_mask)) {
 		mutex_unlock(&src_area->lock);
@@ -1268,7 +1297,7 @@ errno_t as_area_share(as_t *src_as, uintptr_t src_base, size_t acc_size,
 	 * The flags of the source area are masked against dst_flags_mask
 	 * to support sharing in less privileged mode.
 	 */
-	as_area_t *dst_area = as_area_create(dst_as, dst_flags_mask,
+	as_area_t *dst_area = as_area_create(dst_as, dst_flags_mask | dst_cow,
 	    src_size, AS_AREA_ATTR_PARTIAL, src_backend,
 	    &src_backend_data, dst_base, bound);
 	if (!dst_area) {
@@ -1581,6 +1610,28 @@ int as_page_fault(uintptr_t address, pf_access_t access, istate_t *istate)
 		goto page_fault;
 	}
 
+	/*
+	 * Fault ahead: spatially local access patterns make the
+	 * following pages of the area very likely to fault next, so
+	 * populate a few of them on the same trip (best effort,
+	 * skipping pages that are mapped already). The window is
+	 * tunable per area through as_area_advise().
+	 */
+	for (unsigned int i = 1; i <= area->fault_ahead; i++) {
+		uintptr_t ahead = page + P2SZ(i);
+
+		if (ahead - area->base >= P2SZ(area->pages))
+			break;
+
+		bool afound = page_mapping_find(AS, ahead, false, &pte);
+		if (afound && PTE_PRESENT(&pte))
+			continue;
+
+		if (area->backend->page_fault(area, ahead,
+		    PF_ACCESS_READ) != AS_PF_OK)
+			break;
+	}
+
 	page_table_unlock(AS, false);
 	mutex_unlock(&area->lock);
 	mutex_unlock(&AS->lock);
@@ -1701,7 +1752,17 @@ _NO_TRACE unsigned int as_area_get_flags(as_area_t *area)
 {
 	assert(mutex_locked(&area->lock));
 
-	return area_flags_to_page_flags(area->flags);
+	unsigned int flags = area_flags_to_page_flags(area->flags);
+
+	/*
+	 * Copy-on-write areas are mapped write-protected so that the
+	 * first write to each page is intercepted; the backend then
+	 * upgrades the mapping after making a private copy.
+	 */
+	if (area->flags & AS_AREA_COW)
+		flags &= ~PAGE_WRITE;
+
+	return flags;
 }
 
 /** Get key function for the @c as_t.as_areas ordered dictionary.
@@ -2150,11 +2211,195 @@ sys_errno_t sys_as_area_get_info(uintptr_t address, uspace_ptr_as_area_info_t de
 	return EOK;
 }
 
+/** Discard a range of an anonymous address space area.
+ *
+ * Present pages in the range are unmapped and their frames
+ * returned to the free pool; a later access faults a fresh zeroed
+ * frame in, exactly as for never-touched anonymous memory. Only
+ * plain (never shared) anonymous areas can be discarded.
+ *
+ * @param as      Address space.
+ * @param address Page-aligned start of the range.
+ * @param size    Page-aligned size of the range.
+ *
+ * @return Zero on success or an error code.
+ *
+ */
+errno_t as_area_discard(as_t *as, uintptr_t address, size_t size)
+{
+	if (!IS_ALIGNED(address, PAGE_SIZE) || !IS_ALIGNED(size, PAGE_SIZE))
+		return EINVAL;
+
+	if (size == 0)
+		return EOK;
+
+	mutex_lock(&as->lock);
+
+	as_area_t *area = find_area_and_lock(as, address);
+	if (!area) {
+		mutex_unlock(&as->lock);
+		return ENOENT;
+	}
+
+	if ((area->backend != &anon_backend) || (area->sh_info->shared)) {
+		mutex_unlock(&area->lock);
+		mutex_unlock(&as->lock);
+		return ENOTSUP;
+	}
+
+	if ((address - area->base) + size > P2SZ(area->pages)) {
+		mutex_unlock(&area->lock);
+		mutex_unlock(&as->lock);
+		return EINVAL;
+	}
+
+	uintptr_t end = address + size;
+	size_t pages = size >> PAGE_WIDTH;
+
+	page_table_lock(as, false);
+
+	ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES, as->asid, address,
+	    pages);
+
+	/*
+	 * Process every used space interval overlapping the range.
+	 * Intervals are re-fetched from the start after each
+	 * mutation, since trimming may remove or split them.
+	 */
+	bool again = true;
+	while (again) {
+		again = false;
+
+		used_space_ival_t *ival = used_space_first(&area->used_space);
+		while (ival != NULL) {
+			uintptr_t ib = ival->page;
+			uintptr_t ie = ival->page + P2SZ(ival->count);
+
+			if ((ie <= address) || (ib >= end)) {
+				ival = used_space_next(ival);
+				continue;
+			}
+
+			uintptr_t lo = max(ib, address);
+			uintptr_t hi = min(ie, end);
+
+			for (uintptr_t ptr = lo; ptr < hi; ptr += PAGE_SIZE) {
+				pte_t pte;
+				bool found = page_mapping_find(as, ptr,
+				    false, &pte);
+
+				(void) found;
+				assert(found);
+				assert(PTE_VALID(&pte));
+				assert(PTE_PRESENT(&pte));
+
+				if (area->backend->frame_free) {
+					area->backend->frame_free(area, ptr,
+					    PTE_GET_FRAME(&pte));
+				}
+
+				page_mapping_remove(as, ptr);
+			}
+
+			/* Adjust the interval around the hole. */
+			if (lo == ib && hi == ie) {
+				used_space_remove_ival(ival);
+			} else if (lo == ib) {
+				used_space_remove_ival(ival);
+				used_space_insert(&area->used_space, hi,
+				    (ie - hi) >> PAGE_WIDTH);
+			} else if (hi == ie) {
+				used_space_shorten_ival(ival,
+				    (lo - ib) >> PAGE_WIDTH);
+			} else {
+				used_space_shorten_ival(ival,
+				    (lo - ib) >> PAGE_WIDTH);
+				used_space_insert(&area->used_space, hi,
+				    (ie - hi) >> PAGE_WIDTH);
+			}
+
+			/* The interval set changed; rescan. */
+			again = true;
+			break;
+		}
+	}
+
+	tlb_invalidate_pages(as->asid, address, pages);
+
+	as_invalidate_translation_cache(as, address, pages);
+	tlb_shootdown_finalize(ipl);
+
+	page_table_unlock(as, false);
+
+	mutex_unlock(&area->lock);
+	mutex_unlock(&as->lock);
+
+	return EOK;
+}
+
 sys_errno_t sys_as_area_destroy(uintptr_t address)
 {
 	return (sys_errno_t) as_area_destroy(AS, address);
 }
 
+sys_errno_t sys_as_area_discard(uintptr_t address, size_t size)
+{
+	return (sys_errno_t) as_area_discard(AS, address, size);
+}
+
+/** Set the access pattern advice of an address space area.
+ *
+ * Adjusts how many pages a page fault populates ahead of the
+ * faulting address.
+ *
+ * @param as      Address space.
+ * @param address Address within the area.
+ * @param advice  One of the AS_ADVISE_* values.
+ *
+ * @return Zero on success or an error code.
+ *
+ */
+errno_t as_area_advise(as_t *as, uintptr_t address, unsigned int advice)
+{
+	unsigned int window;
+
+	switch (advice) {
+	case AS_ADVISE_NORMAL:
+		window = 3;
+		break;
+	case AS_ADVISE_RANDOM:
+		window = 0;
+		break;
+	case AS_ADVISE_SEQUENTIAL:
+		window = 15;
+		break;
+	case AS_ADVISE_WILLNEED:
+		window = 63;
+		break;
+	default:
+		return EINVAL;
+	}
+
+	mutex_lock(&as->lock);
+
+	as_area_t *area = find_area_and_lock(as, address);
+	if (!area) {
+		mutex_unlock(&as->lock);
+		return ENOENT;
+	}
+
+	area->fault_ahead = window;
+
+	mutex_unlock(&area->lock);
+	mutex_unlock(&as->lock);
+	return EOK;
+}
+
+sys_errno_t sys_as_area_advise(uintptr_t address, unsigned int advice)
+{
+	return (sys_errno_t) as_area_advise(AS, address, advice);
+}
+
 /** Get list of address space areas.
  *
  * @param as    Address space.
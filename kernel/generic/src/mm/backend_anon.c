@@ -45,6 +45,7 @@
 #include <mm/frame.h>
 #include <mm/slab.h>
 #include <mm/km.h>
+#include <mm/tlb.h>
 #include <synch/mutex.h>
 #include <adt/list.h>
 #include <errno.h>
@@ -64,6 +65,11 @@ static bool anon_is_shareable(as_area_t *);
 static int anon_page_fault(as_area_t *, uintptr_t, pf_access_t);
 static void anon_frame_free(as_area_t *, uintptr_t, uintptr_t);
 
+/** Number of base pages in one large (huge) page block. */
+#define ANON_LARGE_PAGES  (1 << 9)
+/** Size of one large page block in bytes (2M with 4K base pages). */
+#define ANON_LARGE_SIZE   P2SZ(ANON_LARGE_PAGES)
+
 mem_backend_t anon_backend = {
 	.create = anon_create,
 	.resize = anon_resize,
@@ -170,6 +176,141 @@ bool anon_is_shareable(as_area_t *area)
 	return !(area->flags & AS_AREA_LATE_RESERVE);
 }
 
+/** Service a write fault in a copy-on-write area.
+ *
+ * Give the faulting page a private, writable copy of its current
+ * content: the write-protected shared frame if one is mapped, the
+ * frame recorded in the share pagemap if the page has not been
+ * touched here yet, or a zero page when the page never existed in
+ * the shared snapshot. The reference to the replaced shared frame is
+ * dropped, so frames become exclusively owned once all sharers have
+ * copied them.
+ *
+ * Must be called with the area, the page table and the share info
+ * locked.
+ *
+ * @param area  Address space area.
+ * @param upage Faulting virtual page address.
+ *
+ * @return AS_PF_OK on success.
+ *
+ */
+static int anon_cow_fault(as_area_t *area, uintptr_t upage)
+{
+	uintptr_t old_frame = 0;
+	bool mapped = false;
+	bool have_old = false;
+
+	pte_t pte;
+	if (page_mapping_find(AS, upage, false, &pte) && PTE_PRESENT(&pte)) {
+		old_frame = PTE_GET_FRAME(&pte);
+		mapped = true;
+		have_old = true;
+	} else if (as_pagemap_find(&area->sh_info->pagemap,
+	    upage - area->base, &old_frame) == EOK) {
+		have_old = true;
+	}
+
+	/*
+	 * Prepare the private copy.
+	 */
+	uintptr_t frame;
+	uintptr_t kpage = km_temporary_page_get(&frame, FRAME_NO_RESERVE);
+	if (have_old) {
+		uintptr_t ksrc = km_map(old_frame, PAGE_SIZE, PAGE_SIZE,
+		    PAGE_READ | PAGE_CACHEABLE);
+		memcpy((void *) kpage, (void *) ksrc, PAGE_SIZE);
+		km_unmap(ksrc, PAGE_SIZE);
+	} else
+		memsetb((void *) kpage, PAGE_SIZE, 0);
+	km_temporary_page_put(kpage);
+
+	if (mapped) {
+		/*
+		 * Evict the write-protected mapping everywhere before
+		 * the private copy takes its place.
+		 */
+		ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES,
+		    area->as->asid, upage, 1);
+		page_mapping_remove(AS, upage);
+		tlb_invalidate_pages(area->as->asid, upage, 1);
+		as_invalidate_translation_cache(area->as, upage, 1);
+		tlb_shootdown_finalize(ipl);
+
+		/* Drop the mapping's reference to the shared frame. */
+		frame_free_noreserve(old_frame, 1);
+	}
+
+	page_mapping_insert(AS, upage, frame,
+	    as_area_get_flags(area) | PAGE_WRITE);
+
+	if (!mapped) {
+		if (!used_space_insert(&area->used_space, upage, 1))
+			panic("Cannot insert used space.");
+	}
+
+	return AS_PF_OK;
+}
+
+/** Try to service a page fault with a large page block.
+ *
+ * Attempt to back the naturally aligned large page window around
+ * upage with one physically contiguous, aligned frame block and map
+ * it in a single span. This gives large page translations on
+ * architectures that support them (via mapping_insert_large) and
+ * contiguous physical backing everywhere else, and it cuts the
+ * number of faults taken on sequentially touched areas.
+ *
+ * Only plain private areas are eligible; shared and late-reserve
+ * areas keep the page-at-a-time path. The attempt is best effort:
+ * it backs off when the window does not fit in the area, when any
+ * page of the window is already backed, or when no contiguous
+ * low-memory block is available.
+ *
+ * @param area  Address space area (locked).
+ * @param upage Faulting virtual page address.
+ *
+ * @return AS_PF_OK on success, AS_PF_FAULT when the fault must be
+ *         serviced by the base page path.
+ *
+ */
+static int anon_large_page_fault(as_area_t *area, uintptr_t upage)
+{
+	uintptr_t window = ALIGN_DOWN(upage, ANON_LARGE_SIZE);
+
+	if ((window < area->base) ||
+	    (window + ANON_LARGE_SIZE > area->base + P2SZ(area->pages)))
+		return AS_PF_FAULT;
+
+	/*
+	 * The block must be naturally aligned for a large page
+	 * translation and in low memory so that it can be zeroed
+	 * through the identity mapping.
+	 */
+	uintptr_t frame = frame_alloc(ANON_LARGE_PAGES,
+	    FRAME_NO_RESERVE | FRAME_ATOMIC | FRAME_LOWMEM,
+	    ANON_LARGE_SIZE - 1);
+	if (!frame)
+		return AS_PF_FAULT;
+
+	memsetb((void *) PA2KA(frame), ANON_LARGE_SIZE, 0);
+
+	/*
+	 * used_space_insert() fails on overlap, which doubles as the
+	 * check that no page of the window is backed yet.
+	 */
+	if (!used_space_insert(&area->used_space, window,
+	    ANON_LARGE_PAGES)) {
+		frame_free_noreserve(frame, ANON_LARGE_PAGES);
+		return AS_PF_FAULT;
+	}
+
+	page_mapping_insert_span(AS, window, frame,
+	    as_area_get_flags(area), ANON_LARGE_PAGES);
+
+	return AS_PF_OK;
+}
+
 /** Service a page fault in the anonymous memory address space area.
  *
  * The address space area and page tables must be already locked.
@@ -195,6 +336,17 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 
 	mutex_lock(&area->sh_info->lock);
 	if (area->sh_info->shared) {
+		/*
+		 * Writes to a copy-on-write area are served by private
+		 * copies of the shared frames.
+		 */
+		if ((area->flags & AS_AREA_COW) &&
+		    (access == PF_ACCESS_WRITE)) {
+			int rc = anon_cow_fault(area, upage);
+			mutex_unlock(&area->sh_info->lock);
+			return rc;
+		}
+
 		/*
 		 * The area is shared, chances are that the mapping can be found
 		 * in the pagemap of the address space area share info
@@ -244,6 +396,13 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 				mutex_unlock(&area->sh_info->lock);
 				return AS_PF_SILENT;
 			}
+		} else if (anon_large_page_fault(area, upage) == AS_PF_OK) {
+			/*
+			 * The whole large page window around upage has
+			 * been backed and mapped.
+			 */
+			mutex_unlock(&area->sh_info->lock);
+			return AS_PF_OK;
 		}
 
 		kpage = km_temporary_page_get(&frame, FRAME_NO_RESERVE);
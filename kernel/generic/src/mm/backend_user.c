@@ -42,8 +42,10 @@
 #include <abi/mm/as.h>
 #include <abi/ipc/methods.h>
 #include <ipc/sysipc.h>
+#include <mm/km.h>
 #include <synch/mutex.h>
 #include <typedefs.h>
+#include <barrier.h>
 #include <align.h>
 #include <assert.h>
 #include <errno.h>
@@ -145,6 +147,20 @@ int user_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 	 */
 
 	uintptr_t frame = ipc_get_arg1(&data);
+
+	if ((area->flags & AS_AREA_EXEC) != 0) {
+		/*
+		 * Enforce I/D cache coherence for freshly paged-in code,
+		 * the same way the ELF backend does for its faults.
+		 */
+		uintptr_t kpage = km_map(frame, PAGE_SIZE, PAGE_SIZE,
+		    PAGE_READ | PAGE_CACHEABLE);
+		if (kpage != 0) {
+			smc_coherence((void *) kpage, PAGE_SIZE);
+			km_unmap(kpage, PAGE_SIZE);
+		}
+	}
+
 	page_mapping_insert(AS, upage, frame, as_area_get_flags(area));
 	if (!used_space_insert(&area->used_space, upage, 1))
 		panic("Cannot insert used space.");
@@ -50,6 +50,7 @@
 #include <adt/list.h>
 #include <synch/mutex.h>
 #include <synch/condvar.h>
+#include <synch/waitq.h>
 #include <arch/asm.h>
 #include <arch.h>
 #include <stdio.h>
@@ -59,6 +60,7 @@
 #include <bitops.h>
 #include <macros.h>
 #include <config.h>
+#include <cpu.h>
 #include <str.h>
 #include <proc/thread.h> /* THREAD */
 
@@ -73,6 +75,9 @@ static condvar_t mem_avail_cv;
 static size_t mem_avail_req = 0;  /**< Number of frames requested. */
 static size_t mem_avail_gen = 0;  /**< Generation counter. */
 
+/** Wait queue used to kick the background reclamation thread. */
+static waitq_t kreclaimd_wq;
+
 /** Initialize frame structure.
  *
  * @param frame Frame structure to be initialized.
@@ -574,7 +579,8 @@ bool zone_merge(size_t z1, size_t z2)
 	 * set of flags
 	 */
 	if ((z1 >= zones.count) || (z2 >= zones.count) || (z2 - z1 != 1) ||
-	    (zones.info[z1].flags != zones.info[z2].flags)) {
+	    (zones.info[z1].flags != zones.info[z2].flags) ||
+	    (zones.info[z1].deferred) || (zones.info[z2].deferred)) {
 		ret = false;
 		goto errout;
 	}
@@ -641,6 +647,205 @@ void zone_merge_all(void)
 	}
 }
 
+/** No further zones may be deferred (activation already ran) */
+static bool frame_defer_closed = false;
+
+/** Minimum zone size worth deferring (frames) */
+#define FRAME_DEFER_MIN_FRAMES  (((size_t) 512 << 20) >> FRAME_WIDTH)
+
+/** Frames that must stay eagerly available for early boot */
+#define FRAME_DEFER_KEEP_FRAMES  (((size_t) 32 << 20) >> FRAME_WIDTH)
+
+/** Decide whether a new zone's metadata setup may be deferred.
+ *
+ * Large zones are left unavailable with uninitialized frame
+ * metadata; kinit scrubs them on all CPUs and only then makes them
+ * available. Enough memory must remain eagerly initialized to get
+ * the kernel through early boot. Must be called with the zones
+ * lock held.
+ *
+ * @param count Size of the new zone in frames.
+ *
+ */
+_NO_TRACE static bool frame_defer_possible(size_t count)
+{
+	if (frame_defer_closed)
+		return false;
+
+	if (count < FRAME_DEFER_MIN_FRAMES)
+		return false;
+
+	size_t avail = 0;
+	for (size_t i = 0; i < zones.count; i++) {
+		if (zones.info[i].flags & ZONE_AVAILABLE)
+			avail += zones.info[i].free_count;
+	}
+
+	return avail >= FRAME_DEFER_KEEP_FRAMES;
+}
+
+/** Initialize a deferred zone's metadata and make it available.
+ *
+ * Single-threaded variant of the scrubbing done by
+ * frame_init_deferred(), for when a deferred zone's metadata is
+ * needed before the parallel activation runs (e.g. early boot code
+ * marking a frame range unavailable). Must be called with the zones
+ * lock held.
+ *
+ * @param zone Deferred zone to activate.
+ *
+ */
+_NO_TRACE static void zone_activate_deferred(zone_t *zone)
+{
+	assert(zone->deferred);
+
+	bitmap_clear_range(&zone->bitmap, 0, zone->count);
+
+	for (size_t i = 0; i < zone->count; i++)
+		frame_initialize(&zone->frames[i]);
+
+	zone->deferred = false;
+	zone->flags |= ZONE_AVAILABLE;
+
+	/* The zone's own configuration frames are busy. */
+	pfn_t confframe = ADDR2PFN(KA2PA(zone->frames));
+	size_t confcount = SIZE2FRAMES(zone_conf_size(zone->count));
+
+	if ((confframe >= zone->base) &&
+	    (confframe < zone->base + zone->count)) {
+		for (size_t i = confframe; i < confframe + confcount; i++)
+			zone_mark_unavailable(zone, i - zone->base);
+	}
+}
+
+/** One slice of deferred zone scrubbing work */
+typedef struct {
+	frame_t *frames;
+	bitmap_t *bitmap;
+	size_t first;
+	size_t count;
+} zone_scrub_t;
+
+/** Initialize a slice of a deferred zone's frame metadata */
+static void zone_scrub_worker(void *arg)
+{
+	zone_scrub_t *scrub = (zone_scrub_t *) arg;
+
+	bitmap_clear_range(scrub->bitmap, scrub->first, scrub->count);
+
+	for (size_t i = 0; i < scrub->count; i++)
+		frame_initialize(&scrub->frames[scrub->first + i]);
+}
+
+/** Scrub and activate zones with deferred metadata initialization.
+ *
+ * Called from kinit once all CPUs are up. The frame arrays and
+ * bitmaps of deferred zones are initialized by worker threads
+ * running in parallel (the zones are not available yet, so nothing
+ * else touches them), then each zone's configuration frames are
+ * marked busy and the zone is made available for allocation.
+ *
+ */
+void frame_init_deferred(void)
+{
+	irq_spinlock_lock(&zones.lock, true);
+	frame_defer_closed = true;
+
+	size_t dcount = 0;
+	pfn_t bases[ZONES_MAX];
+	for (size_t i = 0; i < zones.count; i++) {
+		if (zones.info[i].deferred)
+			bases[dcount++] = zones.info[i].base;
+	}
+	irq_spinlock_unlock(&zones.lock, true);
+
+	for (size_t z = 0; z < dcount; z++) {
+		irq_spinlock_lock(&zones.lock, true);
+		size_t znum = find_zone(bases[z], 1, 0);
+		if (znum == (size_t) -1 || !zones.info[znum].deferred) {
+			irq_spinlock_unlock(&zones.lock, true);
+			continue;
+		}
+
+		zone_t *zone = &zones.info[znum];
+		frame_t *frames = zone->frames;
+		bitmap_t *zbitmap = &zone->bitmap;
+		size_t count = zone->count;
+		irq_spinlock_unlock(&zones.lock, true);
+
+		/*
+		 * The zone is invisible to the allocator; scrub it
+		 * outside the zones lock, split across CPUs.
+		 */
+		size_t nslices = config.cpu_count;
+		if (nslices > 8)
+			nslices = 8;
+		if (nslices < 1)
+			nslices = 1;
+
+		zone_scrub_t scrubs[8];
+		thread_t *threads[8];
+		size_t per_slice = count / nslices;
+
+		for (size_t i = 0; i < nslices; i++) {
+			scrubs[i].frames = frames;
+			scrubs[i].bitmap = zbitmap;
+			scrubs[i].first = i * per_slice;
+			scrubs[i].count = (i + 1 == nslices) ?
+			    (count - i * per_slice) : per_slice;
+
+			threads[i] = NULL;
+			if (i + 1 < nslices) {
+				threads[i] = thread_create(
+				    zone_scrub_worker, &scrubs[i], TASK,
+				    THREAD_FLAG_UNCOUNTED, "kzonescrub");
+			}
+
+			if (threads[i] != NULL)
+				thread_ready(threads[i]);
+			else if (i + 1 < nslices)
+				zone_scrub_worker(&scrubs[i]);
+		}
+
+		/* The last slice is ours. */
+		zone_scrub_worker(&scrubs[nslices - 1]);
+
+		for (size_t i = 0; i + 1 < nslices; i++) {
+			if (threads[i] != NULL) {
+				thread_join(threads[i]);
+				thread_detach(threads[i]);
+			}
+		}
+
+		/* Mark the configuration frames and go live. */
+		irq_spinlock_lock(&zones.lock, true);
+		znum = find_zone(bases[z], 1, 0);
+		if (znum != (size_t) -1 && zones.info[znum].deferred) {
+			zone = &zones.info[znum];
+
+			zone->deferred = false;
+			zone->flags |= ZONE_AVAILABLE;
+
+			pfn_t confframe = ADDR2PFN(KA2PA(zone->frames));
+			size_t confcount = SIZE2FRAMES(zone_conf_size(
+			    zone->count));
+
+			if ((confframe >= zone->base) &&
+			    (confframe < zone->base + zone->count)) {
+				for (size_t i = confframe;
+				    i < confframe + confcount; i++)
+					zone_mark_unavailable(zone,
+					    i - zone->base);
+			}
+
+			log(LF_OTHER, LVL_NOTE,
+			    "Activated deferred frame zone %zu (%zu frames)",
+			    znum, zone->count);
+		}
+		irq_spinlock_unlock(&zones.lock, true);
+	}
+}
+
 /** Create new frame zone.
  *
  * @param zone     Zone to construct.
@@ -653,13 +858,15 @@ void zone_merge_all(void)
  *
  */
 _NO_TRACE static void zone_construct(zone_t *zone, pfn_t start, size_t count,
-    zone_flags_t flags, void *confdata)
+    zone_flags_t flags, void *confdata, bool deferred)
 {
 	zone->base = start;
 	zone->count = count;
-	zone->flags = flags;
+	/* A deferred zone stays unavailable until it is scrubbed. */
+	zone->flags = deferred ? (flags & ~ZONE_AVAILABLE) : flags;
 	zone->free_count = count;
 	zone->busy_count = 0;
+	zone->deferred = deferred;
 
 	if (flags & ZONE_AVAILABLE) {
 		/*
@@ -669,14 +876,18 @@ _NO_TRACE static void zone_construct(zone_t *zone, pfn_t start, size_t count,
 
 		bitmap_initialize(&zone->bitmap, count, confdata +
 		    (sizeof(frame_t) * count));
+
+		zone->frames = (frame_t *) confdata;
+
+		if (deferred)
+			return;
+
 		bitmap_clear_range(&zone->bitmap, 0, count);
 
 		/*
 		 * Initialize the array of frame_t structures.
 		 */
 
-		zone->frames = (frame_t *) confdata;
-
 		for (size_t i = 0; i < count; i++)
 			frame_initialize(&zone->frames[i]);
 	} else {
@@ -775,17 +986,26 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 				panic("Cannot find configuration data for zone.");
 		}
 
-		size_t znum = zones_insert_zone(start, count, flags);
+		bool deferred = frame_defer_possible(count);
+
+		size_t znum = zones_insert_zone(start, count,
+		    deferred ? (flags & ~ZONE_AVAILABLE) : flags);
 		if (znum == (size_t) -1) {
 			irq_spinlock_unlock(&zones.lock, true);
 			return (size_t) -1;
 		}
 
 		void *confdata = (void *) PA2KA(PFN2ADDR(confframe));
-		zone_construct(&zones.info[znum], start, count, flags, confdata);
+		zone_construct(&zones.info[znum], start, count, flags, confdata,
+		    deferred);
 
-		/* If confdata in zone, mark as unavailable */
-		if ((confframe >= start) && (confframe < start + count)) {
+		/*
+		 * If confdata in zone, mark as unavailable. For a
+		 * deferred zone the bitmap is not initialized yet;
+		 * the conf frames are marked during activation.
+		 */
+		if (!deferred && (confframe >= start) &&
+		    (confframe < start + count)) {
 			for (size_t i = confframe; i < confframe + confcount; i++)
 				zone_mark_unavailable(&zones.info[znum],
 				    i - zones.info[znum].base);
@@ -803,7 +1023,7 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 		return (size_t) -1;
 	}
 
-	zone_construct(&zones.info[znum], start, count, flags, NULL);
+	zone_construct(&zones.info[znum], start, count, flags, NULL, false);
 
 	irq_spinlock_unlock(&zones.lock, true);
 
@@ -884,6 +1104,26 @@ uintptr_t frame_alloc_generic(size_t count, frame_flags_t flags,
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_force_alloc(count);
 
+	/*
+	 * Serve single unconstrained frames from the per-CPU frame
+	 * cache when possible. Cached frames are low-memory and thus
+	 * satisfy any zone preference; they are kept unreserved, so
+	 * the reservation made above pairs with the cached frame.
+	 */
+	if ((count == 1) && (constraint == 0) && (CPU != NULL)) {
+		ipl_t ipl = interrupts_disable();
+
+		if (CPU->frame_cache_count > 0) {
+			uintptr_t addr =
+			    CPU->frame_cache[--CPU->frame_cache_count];
+			interrupts_restore(ipl);
+
+			return addr;
+		}
+
+		interrupts_restore(ipl);
+	}
+
 loop:
 	irq_spinlock_lock(&zones.lock, true);
 
@@ -900,6 +1140,13 @@ loop:
 	 * if it does not help, reclaim all.
 	 */
 	if ((znum == (size_t) -1) && (!(flags & FRAME_NO_RECLAIM))) {
+		/*
+		 * Let the background reclamation thread keep freeing
+		 * memory after this allocation is served, so that
+		 * future allocations do not hit this slow path.
+		 */
+		waitq_wakeup(&kreclaimd_wq, WAKEUP_FIRST);
+
 		irq_spinlock_unlock(&zones.lock, true);
 		size_t freed = slab_reclaim(0);
 		irq_spinlock_lock(&zones.lock, true);
@@ -978,6 +1225,26 @@ loop:
 	pfn_t pfn = zone_frame_alloc(&zones.info[znum], count,
 	    frame_constraint) + zones.info[znum].base;
 
+	/*
+	 * Refill the per-CPU frame cache while the zone lock is held
+	 * anyway, so that subsequent single-frame allocations on this
+	 * CPU avoid the zones.lock altogether. The extra frames carry
+	 * no reservation; whoever pops them reserves first. Only
+	 * low-memory frames are cached.
+	 */
+	if ((count == 1) && (constraint == 0) && (CPU != NULL) &&
+	    (zones.info[znum].flags & ZONE_LOWMEM)) {
+		while (CPU->frame_cache_count < FRAME_CACHE_SIZE) {
+			if (!zone_can_alloc(&zones.info[znum], 1, 0))
+				break;
+
+			pfn_t extra = zone_frame_alloc(&zones.info[znum],
+			    1, 0) + zones.info[znum].base;
+			CPU->frame_cache[CPU->frame_cache_count++] =
+			    PFN2ADDR(extra);
+		}
+	}
+
 	irq_spinlock_unlock(&zones.lock, true);
 
 	if (pzone)
@@ -1082,6 +1349,35 @@ _NO_TRACE void frame_reference_add(pfn_t pfn)
 	irq_spinlock_unlock(&zones.lock, true);
 }
 
+/** Add reference to frame if it belongs to a zone.
+ *
+ * Unlike frame_reference_add(), tolerates physical addresses outside
+ * of any zone (e.g. memory-mapped I/O), reporting them instead of
+ * asserting.
+ *
+ * @param pfn Frame number of the frame to be referenced.
+ *
+ * @return True if the reference was added, false when the frame
+ *         belongs to no zone.
+ *
+ */
+_NO_TRACE bool frame_reference_try_add(pfn_t pfn)
+{
+	bool ok = false;
+
+	irq_spinlock_lock(&zones.lock, true);
+
+	size_t znum = find_zone(pfn, 1, 0);
+	if (znum != (size_t) -1) {
+		zones.info[znum].frames[pfn - zones.info[znum].base].refcount++;
+		ok = true;
+	}
+
+	irq_spinlock_unlock(&zones.lock, true);
+
+	return ok;
+}
+
 /** Mark given range unavailable in frame zones.
  *
  */
@@ -1095,6 +1391,14 @@ _NO_TRACE void frame_mark_unavailable(pfn_t start, size_t count)
 		if (znum == (size_t) -1)  /* PFN not found */
 			continue;
 
+		/*
+		 * A deferred zone has no frame metadata to mark into
+		 * yet (e.g. a boot loader placed an init task high up);
+		 * give up on deferring it and scrub it right here.
+		 */
+		if (zones.info[znum].deferred)
+			zone_activate_deferred(&zones.info[znum]);
+
 		zone_mark_unavailable(&zones.info[znum],
 		    start + i - zones.info[znum].base);
 	}
@@ -1102,6 +1406,50 @@ _NO_TRACE void frame_mark_unavailable(pfn_t start, size_t count)
 	irq_spinlock_unlock(&zones.lock, true);
 }
 
+/** Background page reclamation thread.
+ *
+ * Keeps a reserve of free frames by reclaiming slab memory in the
+ * background whenever free memory drops below a low watermark, so
+ * that allocations do not have to reclaim synchronously in their
+ * slow path. The thread wakes up either periodically or when an
+ * allocation actually enters the reclaim path.
+ *
+ * @param arg Generic thread argument (unused).
+ *
+ */
+void kreclaimd(void *arg)
+{
+	/*
+	 * Detach most likely as nobody will call thread_join_timeout()
+	 * on this thread.
+	 */
+	thread_detach(THREAD);
+
+	/*
+	 * React when free memory drops below 1/32 of the boot-time
+	 * amount and reclaim aggressively until 1/16 is free again.
+	 */
+	size_t total = frame_total_free_get();
+	size_t low_wm = total / 32;
+	size_t high_wm = total / 16;
+
+	while (true) {
+		(void) waitq_sleep_timeout(&kreclaimd_wq, 1000000,
+		    SYNCH_FLAGS_NONE, NULL);
+
+		if (frame_total_free_get() >= low_wm)
+			continue;
+
+		/*
+		 * Light reclaim first; escalate when still below the
+		 * high watermark.
+		 */
+		slab_reclaim(0);
+		if (frame_total_free_get() < high_wm)
+			slab_reclaim(SLAB_RECLAIM_ALL);
+	}
+}
+
 /** Initialize physical memory management.
  *
  */
@@ -1112,6 +1460,7 @@ void frame_init(void)
 		irq_spinlock_initialize(&zones.lock, "frame.zones.lock");
 		mutex_initialize(&mem_avail_mtx, MUTEX_ACTIVE);
 		condvar_initialize(&mem_avail_cv);
+		waitq_initialize(&kreclaimd_wq);
 	}
 
 	/* Tell the architecture to create some memory */
@@ -27,8 +27,11 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic.h>
 #include <stdalign.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <align.h>
 #include <bitops.h>
@@ -46,6 +49,17 @@
 /** Caches for malloc */
 static slab_cache_t *malloc_caches[SLAB_MAX_MALLOC_W - SLAB_MIN_MALLOC_W + 1];
 
+/** Allocation profile of one malloc size class. */
+typedef struct {
+	atomic_size_t allocs;    /**< Successful allocations. */
+	atomic_size_t frees;     /**< Deallocations. */
+	atomic_size_t failures;  /**< Failed allocations. */
+	atomic_size_t live;      /**< Currently outstanding objects. */
+	atomic_size_t peak;      /**< Maximum of live ever observed. */
+} malloc_stats_t;
+
+static malloc_stats_t malloc_stats[SLAB_MAX_MALLOC_W - SLAB_MIN_MALLOC_W + 1];
+
 static const char *malloc_names[] =  {
 	"malloc-16",
 	"malloc-32",
@@ -104,7 +118,7 @@ static void _check_sizes(size_t *alignment, size_t *size)
 		*size = (1 << SLAB_MIN_MALLOC_W);
 }
 
-static slab_cache_t *cache_for_size(size_t size)
+static size_t index_for_size(size_t size)
 {
 	assert(size > 0);
 	assert(size <= (1 << SLAB_MAX_MALLOC_W));
@@ -113,17 +127,62 @@ static slab_cache_t *cache_for_size(size_t size)
 
 	assert(idx < sizeof(malloc_caches) / sizeof(malloc_caches[0]));
 
-	slab_cache_t *cache = malloc_caches[idx];
+	return idx;
+}
+
+/** Account one allocation attempt of a size class. */
+static void profile_alloc(size_t idx, bool success)
+{
+	malloc_stats_t *stats = &malloc_stats[idx];
+
+	if (!success) {
+		atomic_fetch_add(&stats->failures, 1);
+		return;
+	}
+
+	atomic_fetch_add(&stats->allocs, 1);
+
+	size_t live = atomic_fetch_add(&stats->live, 1) + 1;
+	size_t peak = atomic_load(&stats->peak);
+	while ((live > peak) &&
+	    (!atomic_compare_exchange_weak(&stats->peak, &peak, live)))
+		;
+}
+
+/** Account one deallocation of a size class. */
+static void profile_free(size_t idx)
+{
+	malloc_stats_t *stats = &malloc_stats[idx];
 
-	assert(cache != NULL);
-	return cache;
+	atomic_fetch_add(&stats->frees, 1);
+	atomic_fetch_sub(&stats->live, 1);
 }
 
-// TODO: Expose publicly and use mem_alloc() and mem_free() instead of malloc()
+/** Print the kernel malloc allocation profile. */
+void malloc_print_profile(void)
+{
+	printf("[cache name      ] [allocs] [frees ] [failed] [live  ]"
+	    " [peak  ]\n");
+
+	for (size_t i = 0;
+	    i < (SLAB_MAX_MALLOC_W - SLAB_MIN_MALLOC_W + 1); i++) {
+		malloc_stats_t *stats = &malloc_stats[i];
 
-static void *mem_alloc(size_t, size_t) __attribute__((malloc));
+		printf("%-18s %8zu %8zu %8zu %8zu %8zu\n", malloc_names[i],
+		    atomic_load(&stats->allocs), atomic_load(&stats->frees),
+		    atomic_load(&stats->failures), atomic_load(&stats->live),
+		    atomic_load(&stats->peak));
+	}
+}
 
-static void *mem_alloc(size_t alignment, size_t size)
+/** Allocate memory of known size and alignment.
+ *
+ * Unlike malloc(), no size header is kept with the object: callers
+ * which know their allocation size get the exact size class arena
+ * without the bookkeeping overhead, but must pass the same size and
+ * alignment to mem_free().
+ */
+void *mem_alloc(size_t alignment, size_t size)
 {
 	_check_sizes(&alignment, &size);
 
@@ -132,11 +191,16 @@ static void *mem_alloc(size_t alignment, size_t size)
 		assert(size <= (1 << SLAB_MAX_MALLOC_W));
 	}
 
+	size_t idx = index_for_size(size);
+
 	/* We assume that slab objects are aligned naturally */
-	return slab_alloc(cache_for_size(size), FRAME_ATOMIC);
+	void *ptr = slab_alloc(malloc_caches[idx], FRAME_ATOMIC);
+	profile_alloc(idx, ptr != NULL);
+
+	return ptr;
 }
 
-static void *mem_realloc(void *old_ptr, size_t alignment, size_t old_size,
+void *mem_realloc(void *old_ptr, size_t alignment, size_t old_size,
     size_t new_size)
 {
 	assert(old_ptr);
@@ -146,17 +210,19 @@ static void *mem_realloc(void *old_ptr, size_t alignment, size_t old_size,
 	// TODO: handle big objects
 	assert(new_size <= (1 << SLAB_MAX_MALLOC_W));
 
-	slab_cache_t *old_cache = cache_for_size(old_size);
-	slab_cache_t *new_cache = cache_for_size(new_size);
-	if (old_cache == new_cache)
+	size_t old_idx = index_for_size(old_size);
+	size_t new_idx = index_for_size(new_size);
+	if (old_idx == new_idx)
 		return old_ptr;
 
-	void *new_ptr = slab_alloc(new_cache, FRAME_ATOMIC);
+	void *new_ptr = slab_alloc(malloc_caches[new_idx], FRAME_ATOMIC);
+	profile_alloc(new_idx, new_ptr != NULL);
 	if (!new_ptr)
 		return NULL;
 
 	memcpy(new_ptr, old_ptr, min(old_size, new_size));
-	slab_free(old_cache, old_ptr);
+	slab_free(malloc_caches[old_idx], old_ptr);
+	profile_free(old_idx);
 	return new_ptr;
 }
 
@@ -167,7 +233,7 @@ static void *mem_realloc(void *old_ptr, size_t alignment, size_t old_size,
  * @param size       Size used to call mem_alloc().
  * @param alignment  Alignment used to call mem_alloc().
  */
-static void mem_free(void *ptr, size_t alignment, size_t size)
+void mem_free(void *ptr, size_t alignment, size_t size)
 {
 	if (!ptr)
 		return;
@@ -179,7 +245,10 @@ static void mem_free(void *ptr, size_t alignment, size_t size)
 		assert(size <= (1 << SLAB_MAX_MALLOC_W));
 	}
 
-	return slab_free(cache_for_size(size), ptr);
+	size_t idx = index_for_size(size);
+
+	slab_free(malloc_caches[idx], ptr);
+	profile_free(idx);
 }
 
 static const size_t _offset = ALIGN_UP(sizeof(size_t), alignof(max_align_t));
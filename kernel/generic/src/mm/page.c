@@ -109,6 +109,46 @@ _NO_TRACE void page_mapping_insert(as_t *as, uintptr_t page, uintptr_t frame,
 	memory_barrier();
 }
 
+/** Map a physically contiguous span of pages.
+ *
+ * Map count pages starting at page to the naturally aligned,
+ * physically contiguous frame block starting at frame. When the
+ * architecture provides large page translations, a single large
+ * mapping is installed; otherwise the span is mapped with base
+ * pages one by one.
+ *
+ * The page table must be locked and interrupts must be disabled.
+ *
+ * @param as    Address space to which the pages belong.
+ * @param page  Virtual address of the first page to be mapped.
+ * @param frame Physical address of the first frame of the block.
+ * @param flags Flags to be used for the mapping.
+ * @param count Number of pages in the span.
+ *
+ */
+_NO_TRACE void page_mapping_insert_span(as_t *as, uintptr_t page,
+    uintptr_t frame, unsigned int flags, size_t count)
+{
+	assert(page_table_locked(as));
+
+	assert(page_mapping_operations);
+	assert(page_mapping_operations->mapping_insert);
+
+	if (page_mapping_operations->mapping_insert_large) {
+		page_mapping_operations->mapping_insert_large(as,
+		    ALIGN_DOWN(page, PAGE_SIZE), ALIGN_DOWN(frame, FRAME_SIZE),
+		    flags, count);
+	} else {
+		for (size_t i = 0; i < count; i++)
+			page_mapping_operations->mapping_insert(as,
+			    ALIGN_DOWN(page, PAGE_SIZE) + P2SZ(i),
+			    ALIGN_DOWN(frame, FRAME_SIZE) + P2SZ(i), flags);
+	}
+
+	/* Repel prefetched accesses to the old mapping. */
+	memory_barrier();
+}
+
 /** Remove mapping of page.
  *
  * Remove any mapping of page within address space as.
@@ -172,6 +172,108 @@ void scheduler_init(void)
 {
 }
 
+#ifdef CONFIG_SMP
+
+/** Maximum number of threads stolen by one steal_threads() pass. */
+#define STEAL_BATCH  4
+
+/** Steal ready threads from other CPUs.
+ *
+ * Pick a victim CPU pseudo-randomly and migrate a small batch of its
+ * ready threads to the current CPU. This lets an idle CPU refill its
+ * run queues directly instead of sleeping until the next periodic
+ * kcpulb pass, which keeps cores busy under bursty load.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @return Number of threads stolen.
+ *
+ */
+static size_t steal_threads(void)
+{
+	size_t stolen = 0;
+
+	/*
+	 * Randomize the victim order so that concurrently idling CPUs
+	 * do not all contend for the queues of the same victim.
+	 */
+	size_t bias = (size_t) get_cycle() + CPU->id;
+
+	for (size_t acpu = 0; (acpu < config.cpu_active) && (stolen == 0);
+	    acpu++) {
+		cpu_t *cpu = &cpus[(acpu + bias) % config.cpu_active];
+
+		if ((cpu == CPU) || (!cpu->active))
+			continue;
+
+		if (atomic_load(&cpu->nrdy) == 0)
+			continue;
+
+		/*
+		 * Steal from the least priority queues first so that
+		 * interactive threads keep their CPU affinity.
+		 */
+		for (int rq = RQ_COUNT - 1; (rq >= 0) &&
+		    (stolen < STEAL_BATCH); rq--) {
+			irq_spinlock_lock(&(cpu->rq[rq].lock), false);
+
+			/* Search rq from the back */
+			link_t *link = list_last(&cpu->rq[rq].rq);
+
+			while ((link != NULL) && (stolen < STEAL_BATCH)) {
+				thread_t *thread = (thread_t *)
+				    list_get_instance(link, thread_t, rq_link);
+				link = list_prev(link, &cpu->rq[rq].rq);
+
+				/*
+				 * Do not steal CPU-wired threads, threads
+				 * already stolen, threads for which migration
+				 * was temporarily disabled or threads whose
+				 * FPU context is still in the victim CPU.
+				 */
+				irq_spinlock_lock(&thread->lock, false);
+
+				if ((thread->wired) || (thread->stolen) ||
+				    (thread->nomigrate) ||
+				    (thread->fpu_context_engaged)) {
+					irq_spinlock_unlock(&thread->lock,
+					    false);
+					continue;
+				}
+
+				/*
+				 * Remove thread from the victim's ready
+				 * queue and ready it on the local CPU.
+				 */
+				atomic_dec(&cpu->nrdy);
+				atomic_dec(&nrdy);
+
+				cpu->rq[rq].n--;
+				list_remove(&thread->rq_link);
+
+				thread->stolen = true;
+				thread->state = Entering;
+
+				irq_spinlock_unlock(&thread->lock, false);
+				irq_spinlock_unlock(&(cpu->rq[rq].lock),
+				    false);
+
+				thread_ready(thread);
+				stolen++;
+
+				irq_spinlock_lock(&(cpu->rq[rq].lock), false);
+				link = list_last(&cpu->rq[rq].rq);
+			}
+
+			irq_spinlock_unlock(&(cpu->rq[rq].lock), false);
+		}
+	}
+
+	return stolen;
+}
+
+#endif /* CONFIG_SMP */
+
 /** Get thread to be scheduled
  *
  * Get the optimal thread to be scheduled
@@ -188,6 +290,15 @@ static thread_t *find_best_thread(void)
 loop:
 
 	if (atomic_load(&CPU->nrdy) == 0) {
+#ifdef CONFIG_SMP
+		/*
+		 * Try to refill the local run queues from another CPU
+		 * before committing to sleep.
+		 */
+		if (steal_threads() > 0)
+			goto loop;
+#endif
+
 		/*
 		 * For there was nothing to run, the CPU goes to sleep
 		 * until a hardware interrupt or an IPI comes.
@@ -196,6 +307,14 @@ loop:
 		irq_spinlock_lock(&CPU->lock, false);
 		CPU->idle = true;
 		irq_spinlock_unlock(&CPU->lock, false);
+
+		/*
+		 * Tell the architecture how long the periodic tick may
+		 * be stopped for; with no timeout due, ticking while
+		 * idle is pure waste.
+		 */
+		uint64_t sleep_horizon = timeout_ticks_until_next();
+
 		interrupts_enable();
 
 		/*
@@ -203,7 +322,7 @@ loop:
 		 * In such case, the CPU will continue to go to sleep
 		 * even though there is a runnable thread.
 		 */
-		cpu_sleep();
+		cpu_sleep_tickless(sleep_horizon);
 		interrupts_disable();
 		goto loop;
 	}
@@ -234,6 +353,11 @@ loop:
 
 		irq_spinlock_pass(&(CPU->rq[i].lock), &thread->lock);
 
+		/* Scheduling statistics. */
+		thread->switches++;
+		if ((thread->cpu != NULL) && (thread->cpu != CPU))
+			thread->migrations++;
+
 		thread->cpu = CPU;
 		thread->ticks = us2ticks((i + 1) * 10000);
 		thread->priority = i;  /* Correct rq index */
@@ -407,6 +531,10 @@ void scheduler_separated_stack(void)
 
 		switch (THREAD->state) {
 		case Running:
+			/*
+			 * The thread was preempted while still runnable.
+			 */
+			THREAD->preemptions++;
 			irq_spinlock_unlock(&THREAD->lock, false);
 			thread_ready(THREAD);
 			break;
@@ -511,8 +639,10 @@ void scheduler_separated_stack(void)
 #ifdef SCHEDULER_VERBOSE
 	log(LF_OTHER, LVL_DEBUG,
 	    "cpu%u: tid %" PRIu64 " (priority=%d, ticks=%" PRIu64
-	    ", nrdy=%zu)", CPU->id, THREAD->tid, THREAD->priority,
-	    THREAD->ticks, atomic_load(&CPU->nrdy));
+	    ", nrdy=%zu, switches=%" PRIu64 ", migrations=%" PRIu64
+	    ", preemptions=%" PRIu64 ")", CPU->id, THREAD->tid,
+	    THREAD->priority, THREAD->ticks, atomic_load(&CPU->nrdy),
+	    THREAD->switches, THREAD->migrations, THREAD->preemptions);
 #endif
 
 	/*
@@ -207,6 +207,14 @@ static errno_t thr_constructor(void *obj, unsigned int kmflags)
 
 	thread->kstack = (uint8_t *) PA2KA(stack_phys);
 
+	/*
+	 * Fresh stacks are scrubbed once here; the slab magazines
+	 * then recycle the whole shell (stack, FPU context,
+	 * thread_t) between short-lived threads, and creation does
+	 * not touch all of it again.
+	 */
+	memsetb(thread->kstack, STACK_SIZE, 0);
+
 #ifdef CONFIG_UDEBUG
 	mutex_initialize(&thread->udebug.lock, MUTEX_PASSIVE);
 #endif
@@ -245,6 +253,12 @@ void thread_init(void)
 	thread_cache = slab_cache_create("thread_t", sizeof(thread_t), 0,
 	    thr_constructor, thr_destructor, 0);
 
+	/*
+	 * Warm up the boot CPU's magazines so that the initial burst
+	 * of kernel thread creation is served from the magazine layer.
+	 */
+	(void) slab_cache_prefill(thread_cache, SLAB_MAG_SIZE);
+
 #ifdef CONFIG_FPU
 	fpu_context_cache = slab_cache_create("fpu_context_t",
 	    sizeof(fpu_context_t), FPU_CONTEXT_ALIGN, NULL, NULL, 0);
@@ -287,8 +301,26 @@ void thread_ready(thread_t *thread)
 
 	before_thread_is_ready(thread);
 
-	int i = (thread->priority < RQ_COUNT - 1) ?
-	    ++thread->priority : thread->priority;
+	/*
+	 * Latency-critical threads always go to the most priority run
+	 * queue and do not age; other threads age by one queue per
+	 * wakeup up to the least priority queue.
+	 */
+	int i;
+	if (thread->realtime) {
+		i = thread->priority = 0;
+	} else if (thread->wakeup_boost) {
+		/*
+		 * One-shot boost: a thread woken by an IPC answer
+		 * dispatches from the top queue, approximating a
+		 * direct handoff from the answering thread.
+		 */
+		thread->wakeup_boost = false;
+		i = thread->priority = 0;
+	} else {
+		i = (thread->priority < RQ_COUNT - 1) ?
+		    ++thread->priority : thread->priority;
+	}
 
 	cpu_t *cpu;
 	if (thread->wired || thread->nomigrate || thread->fpu_context_engaged) {
@@ -302,6 +334,20 @@ void thread_ready(thread_t *thread)
 		/* Prefer the CPU on which the thread ran last */
 		assert(thread->cpu != NULL);
 		cpu = thread->cpu;
+
+#ifdef CONFIG_SMP
+		/*
+		 * If the preferred CPU has work queued while an idle CPU
+		 * shares its last-level cache, wake the thread on the idle
+		 * sibling: the warm cache is shared and the dispatch
+		 * latency is lower.
+		 */
+		if (atomic_load(&cpu->nrdy) > 0) {
+			cpu_t *sibling = cpu_find_idle_llc_sibling(cpu);
+			if (sibling != NULL)
+				cpu = sibling;
+		}
+#endif
 	} else {
 		cpu = CPU;
 	}
@@ -351,7 +397,12 @@ thread_t *thread_create(void (*func)(void *), void *arg, task_t *task,
 	}
 
 	/* Not needed, but good for debugging */
-	memsetb(thread->kstack, STACK_SIZE, 0);
+	/*
+	 * A stack reused from the slab magazine only carries data
+	 * of a previous kernel thread; fresh stacks were zeroed by
+	 * the constructor. Clearing the whole stack here again cost
+	 * a multi-KiB memset on every thread creation.
+	 */
 
 	irq_spinlock_lock(&tidlock, true);
 	thread->tid = ++last_tid;
@@ -374,12 +425,18 @@ thread_t *thread_create(void (*func)(void *), void *arg, task_t *task,
 	thread->ticks = -1;
 	thread->ucycles = 0;
 	thread->kcycles = 0;
+	thread->switches = 0;
+	thread->migrations = 0;
+	thread->preemptions = 0;
 	thread->uncounted =
 	    ((flags & THREAD_FLAG_UNCOUNTED) == THREAD_FLAG_UNCOUNTED);
 	thread->priority = -1;          /* Start in rq[0] */
 	thread->cpu = NULL;
 	thread->wired = false;
 	thread->stolen = false;
+	thread->wakeup_boost = false;
+	thread->realtime =
+	    ((flags & THREAD_FLAG_REALTIME) == THREAD_FLAG_REALTIME);
 	thread->uspace =
 	    ((flags & THREAD_FLAG_USPACE) == THREAD_FLAG_USPACE);
 
@@ -1113,5 +1170,30 @@ sys_errno_t sys_thread_udelay(uint32_t usec)
 	return 0;
 }
 
+/** Process syscall to set the calling thread's scheduling class.
+ *
+ * Move the calling thread in or out of the latency-critical class.
+ * The change takes effect the next time the thread becomes ready.
+ * Threads in this class are exempt from priority aging, so a
+ * runaway thread would starve all time-sharing work on its CPU;
+ * the syscall is therefore reserved for tasks holding
+ * PERM_REALTIME.
+ */
+sys_errno_t sys_thread_set_realtime(sysarg_t realtime)
+{
+	/*
+	 * Make sure the caller is authorised to make this syscall.
+	 */
+	perm_t perms = perm_get(TASK);
+	if (!(perms & PERM_REALTIME))
+		return (sys_errno_t) EPERM;
+
+	irq_spinlock_lock(&THREAD->lock, true);
+	THREAD->realtime = (realtime != 0);
+	irq_spinlock_unlock(&THREAD->lock, true);
+
+	return 0;
+}
+
 /** @}
  */
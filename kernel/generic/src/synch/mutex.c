@@ -70,6 +70,41 @@ bool mutex_locked(mutex_t *mtx)
 
 #define MUTEX_DEADLOCK_THRESHOLD	100000000
 
+#ifdef CONFIG_SMP
+
+/** Upper bound on the adaptive spinning done by a passive mutex. */
+#define MUTEX_SPIN_LIMIT	1000
+
+/** Spin for a short while in the hope the mutex gets unlocked.
+ *
+ * As long as the owner is running on another CPU, the critical
+ * section is likely to end soon and spinning is cheaper than the
+ * sleep/wakeup round trip through the semaphore. The owner pointer
+ * is read without synchronization: it is a mere heuristic and
+ * thread structures come from a slab cache, so the memory stays
+ * valid even if the owner exits concurrently.
+ *
+ * @param mtx  Mutex.
+ *
+ * @return EOK if the mutex was acquired by spinning, ETIMEOUT otherwise.
+ */
+static errno_t mutex_trylock_spin(mutex_t *mtx)
+{
+	for (unsigned int cnt = 0; cnt < MUTEX_SPIN_LIMIT; cnt++) {
+		if (semaphore_trydown(&mtx->sem) == EOK)
+			return EOK;
+
+		thread_t *owner = mtx->owner;
+		if ((owner == NULL) || (owner->state != Running) ||
+		    (owner == THREAD))
+			break;
+	}
+
+	return ETIMEOUT;
+}
+
+#endif /* CONFIG_SMP */
+
 /** Acquire mutex.
  *
  * Timeout mode and non-blocking mode can be requested.
@@ -89,7 +124,21 @@ errno_t _mutex_lock_timeout(mutex_t *mtx, uint32_t usec, unsigned int flags)
 	errno_t rc;
 
 	if (mtx->type == MUTEX_PASSIVE && THREAD) {
+#ifdef CONFIG_SMP
+		/*
+		 * Be adaptive: spin briefly while the owner runs
+		 * elsewhere, block only when the spin did not pay off.
+		 * Non-blocking requests must not spin at all.
+		 */
+		if (!(flags & SYNCH_FLAGS_NON_BLOCKING) &&
+		    mutex_trylock_spin(mtx) == EOK) {
+			mtx->owner = THREAD;
+			return EOK;
+		}
+#endif
 		rc = _semaphore_down_timeout(&mtx->sem, usec, flags);
+		if (rc == EOK)
+			mtx->owner = THREAD;
 	} else if (mtx->type == MUTEX_RECURSIVE) {
 		assert(THREAD);
 
@@ -137,8 +186,8 @@ void mutex_unlock(mutex_t *mtx)
 		assert(mtx->owner == THREAD);
 		if (--mtx->nesting > 0)
 			return;
-		mtx->owner = NULL;
 	}
+	mtx->owner = NULL;
 	semaphore_up(&mtx->sem);
 }
 
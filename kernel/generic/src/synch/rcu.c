@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Read-copy update.
+ *
+ * Minimal RCU implementation for read-mostly kernel data. Read-side
+ * critical sections simply disable preemption and are therefore
+ * practically free; a grace period has elapsed once every active CPU
+ * has passed through a context switch. Grace periods are detected by
+ * running a short-lived wired thread on each CPU in turn: once it has
+ * run, the CPU has switched context and thus left any read-side
+ * critical section that was in flight.
+ *
+ * Updaters either wait for a grace period synchronously with
+ * rcu_synchronize() or hand the old data to rcu_call(), whose
+ * callback the krcu reclaimer thread invokes after the next grace
+ * period.
+ */
+
+#include <adt/mpsc_queue.h>
+#include <assert.h>
+#include <config.h>
+#include <cpu.h>
+#include <panic.h>
+#include <proc/thread.h>
+#include <synch/rcu.h>
+#include <synch/waitq.h>
+
+/** Callbacks waiting for the next grace period. */
+static mpsc_queue_t rcu_callbacks;
+
+/** Kicks the krcu reclaimer thread. */
+static waitq_t rcu_wq;
+
+/** Body of the per-CPU quiescent state threads.
+ *
+ * Merely running constitutes the quiescent state, so there is
+ * nothing to do.
+ */
+static void rcu_qs_thread(void *arg)
+{
+	/* Nothing. */
+}
+
+/** Wait for a grace period to elapse.
+ *
+ * Blocks until every active CPU has passed through at least one
+ * context switch. After the call, no read-side critical section that
+ * was in progress when the call was made can still be running.
+ *
+ * Must be called from thread context with no spinlocks held.
+ */
+void rcu_synchronize(void)
+{
+	for (size_t i = 0; i < config.cpu_active; i++) {
+		if (!cpus[i].active)
+			continue;
+
+		thread_t *thread;
+		while ((thread = thread_create(rcu_qs_thread, NULL,
+		    TASK, THREAD_FLAG_NONE, "rcu-qs")) == NULL) {
+			/*
+			 * Out of memory. The grace period must be
+			 * proven, not guessed, so wait for memory to
+			 * reappear and try this CPU again.
+			 */
+			thread_sleep(1);
+		}
+
+		thread_wire(thread, &cpus[i]);
+		thread_ready(thread);
+		thread_join(thread);
+		thread_detach(thread);
+	}
+}
+
+/** Invoke a callback after the next grace period.
+ *
+ * Typically used to free the old copy of an RCU protected structure
+ * once all readers that may still see it are gone. The rcu_item_t is
+ * owned by the callee until the callback fires.
+ *
+ * @param item Callback item embedded in the protected structure.
+ * @param func Callback function.
+ */
+void rcu_call(rcu_item_t *item, void (*func)(rcu_item_t *))
+{
+	item->func = func;
+
+	/* Wait-free; rcu_call() is safe in any context. */
+	mpsc_queue_push(&rcu_callbacks, &item->link);
+
+	waitq_wakeup(&rcu_wq, WAKEUP_FIRST);
+}
+
+/** RCU reclaimer thread.
+ *
+ * Batches queued callbacks, waits for one grace period per batch and
+ * invokes them.
+ *
+ * @param arg Generic thread argument (unused).
+ */
+static void krcu(void *arg)
+{
+	thread_detach(THREAD);
+
+	while (true) {
+		(void) waitq_sleep_timeout(&rcu_wq, 1000000,
+		    SYNCH_FLAGS_NONE, NULL);
+
+		/*
+		 * Pop the current batch into a private chain; callbacks
+		 * queued from now on belong to the next grace period.
+		 */
+		mpsc_link_t *first = NULL;
+		mpsc_link_t *last = NULL;
+		mpsc_link_t *link;
+
+		while ((link = mpsc_queue_pop(&rcu_callbacks)) != NULL) {
+			atomic_store_explicit(&link->next, NULL,
+			    memory_order_relaxed);
+
+			if (last == NULL)
+				first = link;
+			else
+				atomic_store_explicit(&last->next, link,
+				    memory_order_relaxed);
+
+			last = link;
+		}
+
+		if (first == NULL)
+			continue;
+
+		rcu_synchronize();
+
+		while (first != NULL) {
+			rcu_item_t *item = mpsc_queue_get_instance(first,
+			    rcu_item_t, link);
+
+			first = atomic_load_explicit(&first->next,
+			    memory_order_relaxed);
+			item->func(item);
+		}
+	}
+}
+
+/** Initialize the RCU subsystem and start the reclaimer thread. */
+void rcu_init(void)
+{
+	mpsc_queue_initialize(&rcu_callbacks);
+	waitq_initialize(&rcu_wq);
+
+	thread_t *thread = thread_create(krcu, NULL, TASK,
+	    THREAD_FLAG_NONE, "krcu");
+	if (thread != NULL)
+		thread_ready(thread);
+	else
+		panic("Cannot create krcu thread.");
+}
+
+/** @}
+ */
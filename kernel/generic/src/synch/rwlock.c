@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Reader-writer locks.
+ */
+
+#include <assert.h>
+#include <synch/rwlock.h>
+
+/** Initialize reader-writer lock.
+ *
+ * @param rwl  Reader-writer lock.
+ */
+void rwlock_initialize(rwlock_t *rwl)
+{
+	mutex_initialize(&rwl->lock, MUTEX_PASSIVE);
+	condvar_initialize(&rwl->cv);
+	rwl->readers = 0;
+	rwl->writer = false;
+	rwl->writers_waiting = 0;
+}
+
+/** Acquire reader-writer lock for reading.
+ *
+ * Multiple readers may hold the lock concurrently; blocks while a
+ * writer holds or awaits the lock.
+ *
+ * @param rwl  Reader-writer lock.
+ */
+void rwlock_read_lock(rwlock_t *rwl)
+{
+	mutex_lock(&rwl->lock);
+
+	while ((rwl->writer) || (rwl->writers_waiting > 0))
+		condvar_wait(&rwl->cv, &rwl->lock);
+
+	rwl->readers++;
+	mutex_unlock(&rwl->lock);
+}
+
+/** Release reader-writer lock held for reading.
+ *
+ * @param rwl  Reader-writer lock.
+ */
+void rwlock_read_unlock(rwlock_t *rwl)
+{
+	mutex_lock(&rwl->lock);
+
+	assert(rwl->readers > 0);
+	rwl->readers--;
+	if (rwl->readers == 0)
+		condvar_broadcast(&rwl->cv);
+
+	mutex_unlock(&rwl->lock);
+}
+
+/** Acquire reader-writer lock for writing.
+ *
+ * Blocks until the lock can be held exclusively.
+ *
+ * @param rwl  Reader-writer lock.
+ */
+void rwlock_write_lock(rwlock_t *rwl)
+{
+	mutex_lock(&rwl->lock);
+
+	rwl->writers_waiting++;
+	while ((rwl->writer) || (rwl->readers > 0))
+		condvar_wait(&rwl->cv, &rwl->lock);
+	rwl->writers_waiting--;
+
+	rwl->writer = true;
+	mutex_unlock(&rwl->lock);
+}
+
+/** Release reader-writer lock held for writing.
+ *
+ * @param rwl  Reader-writer lock.
+ */
+void rwlock_write_unlock(rwlock_t *rwl)
+{
+	mutex_lock(&rwl->lock);
+
+	assert(rwl->writer);
+	rwl->writer = false;
+	condvar_broadcast(&rwl->cv);
+
+	mutex_unlock(&rwl->lock);
+}
+
+/** Try to acquire reader-writer lock for writing.
+ *
+ * @param rwl  Reader-writer lock.
+ *
+ * @return True if the lock was acquired.
+ */
+bool rwlock_write_trylock(rwlock_t *rwl)
+{
+	bool locked = false;
+
+	mutex_lock(&rwl->lock);
+
+	if ((!rwl->writer) && (rwl->readers == 0)) {
+		rwl->writer = true;
+		locked = true;
+	}
+
+	mutex_unlock(&rwl->lock);
+
+	return locked;
+}
+
+/** @}
+ */
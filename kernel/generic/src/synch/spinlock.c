@@ -55,7 +55,8 @@
  */
 void spinlock_initialize(spinlock_t *lock, const char *name)
 {
-	atomic_flag_clear_explicit(&lock->flag, memory_order_relaxed);
+	atomic_store_explicit(&lock->head, 0, memory_order_relaxed);
+	atomic_store_explicit(&lock->tail, 0, memory_order_relaxed);
 #ifdef CONFIG_DEBUG_SPINLOCK
 	lock->name = name;
 #endif
@@ -78,7 +79,10 @@ void spinlock_lock_debug(spinlock_t *lock)
 	bool deadlock_reported = false;
 
 	preemption_disable();
-	while (atomic_flag_test_and_set_explicit(&lock->flag, memory_order_acquire)) {
+	uint_fast32_t ticket = atomic_fetch_add_explicit(&lock->tail, 1,
+	    memory_order_relaxed);
+	while (atomic_load_explicit(&lock->head, memory_order_acquire) !=
+	    ticket) {
 		/*
 		 * We need to be careful about particular locks
 		 * which are directly used to report deadlocks
@@ -126,7 +130,9 @@ void spinlock_unlock_debug(spinlock_t *lock)
 {
 	ASSERT_SPINLOCK(spinlock_locked(lock), lock);
 
-	atomic_flag_clear_explicit(&lock->flag, memory_order_release);
+	atomic_store_explicit(&lock->head,
+	    atomic_load_explicit(&lock->head, memory_order_relaxed) + 1,
+	    memory_order_release);
 	preemption_enable();
 }
 
@@ -145,7 +151,17 @@ void spinlock_unlock_debug(spinlock_t *lock)
 bool spinlock_trylock(spinlock_t *lock)
 {
 	preemption_disable();
-	bool ret = !atomic_flag_test_and_set_explicit(&lock->flag, memory_order_acquire);
+
+	/*
+	 * The lock is free iff head == tail. Draw a ticket only if it
+	 * would be served immediately; otherwise do not join the queue
+	 * at all.
+	 */
+	uint_fast32_t ticket = atomic_load_explicit(&lock->head,
+	    memory_order_relaxed);
+	uint_fast32_t expected = ticket;
+	bool ret = atomic_compare_exchange_strong_explicit(&lock->tail,
+	    &expected, ticket + 1, memory_order_acquire, memory_order_relaxed);
 
 	if (!ret)
 		preemption_enable();
@@ -160,15 +176,8 @@ bool spinlock_trylock(spinlock_t *lock)
  */
 bool spinlock_locked(spinlock_t *lock)
 {
-	// NOTE: Atomic flag doesn't support simple atomic read (by design),
-	//       so instead we test_and_set and then clear if necessary.
-	//       This function is only used inside assert, so we don't need
-	//       any preemption_disable/enable here.
-
-	bool ret = atomic_flag_test_and_set_explicit(&lock->flag, memory_order_relaxed);
-	if (!ret)
-		atomic_flag_clear_explicit(&lock->flag, memory_order_relaxed);
-	return ret;
+	return atomic_load_explicit(&lock->head, memory_order_relaxed) !=
+	    atomic_load_explicit(&lock->tail, memory_order_relaxed);
 }
 
 #endif
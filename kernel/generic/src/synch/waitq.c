@@ -60,6 +60,7 @@
 
 static void waitq_sleep_timed_out(void *);
 static void waitq_complete_wakeup(waitq_t *);
+static void _waitq_detach_sleepers_unsafe(waitq_t *, list_t *, wakeup_mode_t);
 
 /** Initialize wait queue
  *
@@ -437,11 +438,52 @@ errno_t waitq_sleep_timeout_unsafe(waitq_t *wq, uint32_t usec, unsigned int flag
  * @param mode Wakeup mode.
  *
  */
+static void _waitq_wakeup_common(waitq_t *, wakeup_mode_t, bool);
+
 void waitq_wakeup(waitq_t *wq, wakeup_mode_t mode)
 {
+	_waitq_wakeup_common(wq, mode, false);
+}
+
+/** Wake up the first sleeper with a one-shot dispatch boost.
+ *
+ * The woken thread is placed into the top-priority run queue for
+ * this dispatch. Used for request/response IPC, where the thread
+ * waiting for the answer should run as soon as the answering
+ * thread lets go of the CPU, instead of queueing behind unrelated
+ * work - the closest thing to a direct handoff without donating
+ * the timeslice outright.
+ *
+ * @param wq Pointer to wait queue.
+ */
+void waitq_wakeup_boost(waitq_t *wq)
+{
+	_waitq_wakeup_common(wq, WAKEUP_FIRST, true);
+}
+
+static void _waitq_wakeup_common(waitq_t *wq, wakeup_mode_t mode, bool boost)
+{
+	list_t batch;
+	list_initialize(&batch);
+
 	irq_spinlock_lock(&wq->lock, true);
-	_waitq_wakeup_unsafe(wq, mode);
+	_waitq_detach_sleepers_unsafe(wq, &batch, mode);
 	irq_spinlock_unlock(&wq->lock, true);
+
+	/*
+	 * Ready the detached threads only after the wait queue lock has
+	 * been dropped. The run queue locks are therefore never nested
+	 * inside wq->lock on this path and a slow enqueue on a remote
+	 * CPU no longer blocks other sleepers and wakers of this queue.
+	 */
+	while (!list_empty(&batch)) {
+		thread_t *thread = list_get_instance(list_first(&batch),
+		    thread_t, wq_link);
+		list_remove(&thread->wq_link);
+		if (boost)
+			thread->wakeup_boost = true;
+		thread_ready(thread);
+	}
 }
 
 /** If there is a wakeup in progress actively waits for it to complete.
@@ -487,20 +529,23 @@ static void waitq_complete_wakeup(waitq_t *wq)
 	irq_spinlock_unlock(&wq->lock, false);
 }
 
-/** Internal SMP- and IRQ-unsafe version of waitq_wakeup()
+/** Detach sleepers eligible for wakeup from the wait queue.
  *
- * This is the internal SMP- and IRQ-unsafe version of waitq_wakeup(). It
- * assumes wq->lock is already locked and interrupts are already disabled.
+ * Common core of waitq_wakeup() and _waitq_wakeup_unsafe(). Performs
+ * the missed/ignored wakeup bookkeeping and moves the threads to be
+ * woken from wq->sleepers to the caller-supplied batch list, leaving
+ * the actual thread_ready() calls to the caller.
  *
- * @param wq   Pointer to wait queue.
- * @param mode If mode is WAKEUP_FIRST, then the longest waiting
- *             thread, if any, is woken up. If mode is WAKEUP_ALL, then
- *             all waiting threads, if any, are woken up. If there are
- *             no waiting threads to be woken up, the missed wakeup is
- *             recorded in the wait queue.
+ * Assumes wq->lock is locked and interrupts are disabled.
+ *
+ * @param wq    Pointer to wait queue.
+ * @param batch List to collect the detached threads (linked through
+ *              their wq_link).
+ * @param mode  See waitq_wakeup().
  *
  */
-void _waitq_wakeup_unsafe(waitq_t *wq, wakeup_mode_t mode)
+static void _waitq_detach_sleepers_unsafe(waitq_t *wq, list_t *batch,
+    wakeup_mode_t mode)
 {
 	size_t count = 0;
 
@@ -555,12 +600,47 @@ loop:
 	thread->sleep_queue = NULL;
 	irq_spinlock_unlock(&thread->lock, false);
 
-	thread_ready(thread);
+	list_append(&thread->wq_link, batch);
 
 	if (mode == WAKEUP_ALL)
 		goto loop;
 }
 
+/** Internal SMP- and IRQ-unsafe version of waitq_wakeup()
+ *
+ * This is the internal SMP- and IRQ-unsafe version of waitq_wakeup(). It
+ * assumes wq->lock is already locked and interrupts are already disabled.
+ *
+ * @param wq   Pointer to wait queue.
+ * @param mode If mode is WAKEUP_FIRST, then the longest waiting
+ *             thread, if any, is woken up. If mode is WAKEUP_ALL, then
+ *             all waiting threads, if any, are woken up. If there are
+ *             no waiting threads to be woken up, the missed wakeup is
+ *             recorded in the wait queue.
+ *
+ */
+void _waitq_wakeup_unsafe(waitq_t *wq, wakeup_mode_t mode)
+{
+	assert(interrupts_disabled());
+	assert(irq_spinlock_locked(&wq->lock));
+
+	list_t batch;
+	list_initialize(&batch);
+
+	_waitq_detach_sleepers_unsafe(wq, &batch, mode);
+
+	/*
+	 * The caller holds wq->lock, so the threads have to be readied
+	 * under it, as before.
+	 */
+	while (!list_empty(&batch)) {
+		thread_t *thread = list_get_instance(list_first(&batch),
+		    thread_t, wq_link);
+		list_remove(&thread->wq_link);
+		thread_ready(thread);
+	}
+}
+
 /** Get the missed wakeups count.
  *
  * @param wq	Pointer to wait queue.
@@ -42,7 +42,10 @@
 #include <mm/as.h>
 #include <mm/page.h>
 #include <arch.h>
+#include <arch/cycle.h>
+#include <cpu.h>
 #include <debug.h>
+#include <preemption.h>
 #include <interrupt.h>
 #include <ipc/sysipc.h>
 #include <synch/smc.h>
@@ -65,6 +68,7 @@ static syshandler_t syscall_table[] = {
 	[SYS_THREAD_GET_ID] = (syshandler_t) sys_thread_get_id,
 	[SYS_THREAD_USLEEP] = (syshandler_t) sys_thread_usleep,
 	[SYS_THREAD_UDELAY] = (syshandler_t) sys_thread_udelay,
+	[SYS_THREAD_SET_REALTIME] = (syshandler_t) sys_thread_set_realtime,
 
 	[SYS_TASK_GET_ID] = (syshandler_t) sys_task_get_id,
 	[SYS_TASK_SET_NAME] = (syshandler_t) sys_task_set_name,
@@ -85,6 +89,8 @@ static syshandler_t syscall_table[] = {
 	[SYS_AS_AREA_CHANGE_FLAGS] = (syshandler_t) sys_as_area_change_flags,
 	[SYS_AS_AREA_GET_INFO] = (syshandler_t) sys_as_area_get_info,
 	[SYS_AS_AREA_DESTROY] = (syshandler_t) sys_as_area_destroy,
+	[SYS_AS_AREA_DISCARD] = (syshandler_t) sys_as_area_discard,
+	[SYS_AS_AREA_ADVISE] = (syshandler_t) sys_as_area_advise,
 
 	/* Page mapping related syscalls. */
 	[SYS_PAGE_FIND_MAPPING] = (syshandler_t) sys_page_find_mapping,
@@ -92,6 +98,7 @@ static syshandler_t syscall_table[] = {
 	/* IPC related syscalls. */
 	[SYS_IPC_CALL_ASYNC_FAST] = (syshandler_t) sys_ipc_call_async_fast,
 	[SYS_IPC_CALL_ASYNC_SLOW] = (syshandler_t) sys_ipc_call_async_slow,
+	[SYS_IPC_CALL_ASYNC_BATCH] = (syshandler_t) sys_ipc_call_async_batch,
 	[SYS_IPC_ANSWER_FAST] = (syshandler_t) sys_ipc_answer_fast,
 	[SYS_IPC_ANSWER_SLOW] = (syshandler_t) sys_ipc_answer_slow,
 	[SYS_IPC_FORWARD_FAST] = (syshandler_t) sys_ipc_forward_fast,
@@ -128,6 +135,7 @@ static syshandler_t syscall_table[] = {
 	[SYS_SYSINFO_GET_VALUE] = (syshandler_t) sys_sysinfo_get_value,
 	[SYS_SYSINFO_GET_DATA_SIZE] = (syshandler_t) sys_sysinfo_get_data_size,
 	[SYS_SYSINFO_GET_DATA] = (syshandler_t) sys_sysinfo_get_data,
+	[SYS_SYSINFO_GET_GENERATION] = (syshandler_t) sys_sysinfo_get_generation,
 
 	/* Kernel console syscalls. */
 	[SYS_DEBUG_CONSOLE] = (syshandler_t) sys_debug_console,
@@ -160,6 +168,8 @@ sysarg_t syscall_handler(sysarg_t a1, sysarg_t a2, sysarg_t a3,
 		udebug_syscall_event(a1, a2, a3, a4, a5, a6, id, 0, false);
 #endif
 
+	uint64_t begin_cycle = get_cycle();
+
 	sysarg_t rc;
 	if (id < sizeof_array(syscall_table)) {
 		rc = syscall_table[id](a1, a2, a3, a4, a5, a6);
@@ -169,6 +179,14 @@ sysarg_t syscall_handler(sysarg_t a1, sysarg_t a2, sysarg_t a3,
 		task_kill_self(true);
 	}
 
+	/*
+	 * The thread may have migrated while servicing the call; the
+	 * sample simply lands on the CPU finishing it.
+	 */
+	preemption_disable();
+	latency_record(CPU->syscall_latency, get_cycle() - begin_cycle);
+	preemption_enable();
+
 	if (THREAD->interrupted)
 		thread_exit();
 
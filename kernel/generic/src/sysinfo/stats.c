@@ -309,6 +309,9 @@ static void produce_stats_thread(thread_t *thread, stats_thread_t *stats_thread)
 	stats_thread->priority = thread->priority;
 	stats_thread->ucycles = thread->ucycles;
 	stats_thread->kcycles = thread->kcycles;
+	stats_thread->switches = thread->switches;
+	stats_thread->migrations = thread->migrations;
+	stats_thread->preemptions = thread->preemptions;
 
 	if (thread->cpu != NULL) {
 		stats_thread->on_cpu = true;
@@ -855,15 +858,96 @@ void kload(void *arg)
 		mutex_lock(&load_lock);
 
 		unsigned int i;
-		for (i = 0; i < LOAD_STEPS; i++)
+		for (i = 0; i < LOAD_STEPS; i++) {
 			avenrdy[i] = load_calc(avenrdy[i], load_exp[i], ready);
 
+			/*
+			 * Publish into the shared uptime page so that
+			 * userspace can sample the load without a
+			 * kernel entry. Word-sized stores need no
+			 * extra synchronization for sampling readers.
+			 */
+			if ((uptime) && (i < UPTIME_LOAD_STEPS))
+				uptime->load[i] = avenrdy[i] << LOAD_KERNEL_SHIFT;
+		}
+
 		mutex_unlock(&load_lock);
 
 		thread_sleep(LOAD_INTERVAL);
 	}
 }
 
+/** Get merged IRQ/exception latency histogram
+ *
+ * Summed over all CPUs. Bucket n counts samples of 2^n to 2^(n+1)-1
+ * cycles; the last bucket is open-ended.
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing uint64_t buckets.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_exc_latency(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+	*size = sizeof(uint64_t) * LATHIST_BUCKETS;
+	if (dry_run)
+		return NULL;
+
+	uint64_t *buckets = (uint64_t *) malloc(*size);
+	if (buckets == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	for (unsigned int i = 0; i < LATHIST_BUCKETS; i++) {
+		buckets[i] = 0;
+		for (unsigned int cpu = 0; cpu < config.cpu_count; cpu++)
+			buckets[i] += cpus[cpu].exc_latency[i];
+	}
+
+	return ((void *) buckets);
+}
+
+/** Get merged syscall latency histogram
+ *
+ * Summed over all CPUs, same format as the IRQ histogram.
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing uint64_t buckets.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_syscall_latency(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+	*size = sizeof(uint64_t) * LATHIST_BUCKETS;
+	if (dry_run)
+		return NULL;
+
+	uint64_t *buckets = (uint64_t *) malloc(*size);
+	if (buckets == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	for (unsigned int i = 0; i < LATHIST_BUCKETS; i++) {
+		buckets[i] = 0;
+		for (unsigned int cpu = 0; cpu < config.cpu_count; cpu++)
+			buckets[i] += cpus[cpu].syscall_latency[i];
+	}
+
+	return ((void *) buckets);
+}
+
 /** Register sysinfo statistical items
  *
  */
@@ -872,6 +956,10 @@ void stats_init(void)
 	mutex_initialize(&load_lock, MUTEX_PASSIVE);
 
 	sysinfo_set_item_gen_data("system.cpus", NULL, get_stats_cpus, NULL);
+	sysinfo_set_item_gen_data("system.latency.irq", NULL,
+	    get_stats_exc_latency, NULL);
+	sysinfo_set_item_gen_data("system.latency.syscall", NULL,
+	    get_stats_syscall_latency, NULL);
 	sysinfo_set_item_gen_data("system.physmem", NULL, get_stats_physmem, NULL);
 	sysinfo_set_item_gen_data("system.load", NULL, get_stats_load, NULL);
 	sysinfo_set_item_gen_data("system.tasks", NULL, get_stats_tasks, NULL);
@@ -35,6 +35,7 @@
 
 #include <assert.h>
 #include <sysinfo/sysinfo.h>
+#include <ipc/event.h>
 #include <mm/slab.h>
 #include <stdio.h>
 #include <syscall/copy.h>
@@ -58,6 +59,14 @@ static slab_cache_t *sysinfo_item_cache;
 /** Sysinfo lock */
 static mutex_t sysinfo_lock;
 
+/**
+ * Tree generation, incremented on every mutation of the sysinfo tree
+ * (values set or removed, subtrees attached). Function-backed items
+ * generate their values at query time and are inherently outside of
+ * change tracking.
+ */
+static sysarg_t sysinfo_generation;
+
 /** Sysinfo item constructor
  *
  */
@@ -316,6 +325,17 @@ _NO_TRACE static sysinfo_item_t *sysinfo_create_path(const char *name,
 	unreachable();
 }
 
+/** Note a sysinfo tree mutation.
+ *
+ * Should be called with sysinfo_lock held. Bumps the generation and
+ * pokes subscribed monitors through the event interface.
+ */
+_NO_TRACE static void sysinfo_note_change(void)
+{
+	sysinfo_generation++;
+	event_notify_1(EVENT_SYSINFO_CHANGE, true, sysinfo_generation);
+}
+
 /** Set sysinfo item with a constant numeric value
  *
  * @param name Sysinfo path.
@@ -330,6 +350,8 @@ void sysinfo_set_item_val(const char *name, sysinfo_item_t **root,
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -363,6 +385,8 @@ void sysinfo_set_item_data(const char *name, sysinfo_item_t **root,
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -393,6 +417,8 @@ void sysinfo_set_item_gen_val(const char *name, sysinfo_item_t **root,
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -428,6 +454,8 @@ void sysinfo_set_item_gen_data(const char *name, sysinfo_item_t **root,
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -455,6 +483,8 @@ void sysinfo_set_item_undefined(const char *name, sysinfo_item_t **root)
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -482,6 +512,8 @@ void sysinfo_set_subtree_fn(const char *name, sysinfo_item_t **root,
 	/* Protect sysinfo tree consistency */
 	mutex_lock(&sysinfo_lock);
 
+	sysinfo_note_change();
+
 	if (root == NULL)
 		root = &global_root;
 
@@ -1061,5 +1093,24 @@ sys_errno_t sys_sysinfo_get_data(uspace_addr_t path_ptr, size_t path_size,
 	return (sys_errno_t) rc;
 }
 
+/** Get the sysinfo tree generation (syscall).
+ *
+ * The generation moves whenever the tree is mutated. A monitor can
+ * remember it and skip re-reading keys while it stands still; the
+ * EVENT_SYSINFO_CHANGE event delivers the new generation on change.
+ * Function-backed items are generated at query time and do not
+ * participate.
+ *
+ * @return Current sysinfo tree generation.
+ */
+sysarg_t sys_sysinfo_get_generation(void)
+{
+	/*
+	 * Reading a single word; monitors only compare successive
+	 * values, so no need to take the lock.
+	 */
+	return sysinfo_generation;
+}
+
 /** @}
  */
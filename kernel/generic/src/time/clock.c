@@ -163,15 +163,26 @@ void clock(void)
 
 		irq_spinlock_lock(&CPU->timeoutlock, false);
 
-		link_t *cur;
-		while ((cur = list_first(&CPU->timeout_active_list)) != NULL) {
+		/*
+		 * Advance the timer wheel by one tick and fire all
+		 * expired timeouts hashed into the current bucket.
+		 * Timeouts more than one wheel revolution away share
+		 * the bucket and are merely skipped over.
+		 */
+		CPU->timeout_current_tick++;
+		list_t *bucket = &CPU->timeout_wheel[
+		    CPU->timeout_current_tick % TIMEOUT_WHEEL_LEN];
+
+	restart:
+		for (link_t *cur = list_first(bucket); cur != NULL;
+		    cur = list_next(cur, bucket)) {
 			timeout_t *timeout = list_get_instance(cur, timeout_t,
 			    link);
 
 			irq_spinlock_lock(&timeout->lock, false);
-			if (timeout->ticks-- != 0) {
+			if (timeout->expires > CPU->timeout_current_tick) {
 				irq_spinlock_unlock(&timeout->lock, false);
-				break;
+				continue;
 			}
 
 			list_remove(cur);
@@ -184,7 +195,12 @@ void clock(void)
 
 			handler(arg);
 
+			/*
+			 * The handler ran without the wheel lock, so the
+			 * bucket may have changed under us; rescan it.
+			 */
 			irq_spinlock_lock(&CPU->timeoutlock, false);
+			goto restart;
 		}
 
 		irq_spinlock_unlock(&CPU->timeoutlock, false);
@@ -53,7 +53,11 @@
 void timeout_init(void)
 {
 	irq_spinlock_initialize(&CPU->timeoutlock, "cpu.timeoutlock");
-	list_initialize(&CPU->timeout_active_list);
+
+	for (unsigned int i = 0; i < TIMEOUT_WHEEL_LEN; i++)
+		list_initialize(&CPU->timeout_wheel[i]);
+
+	CPU->timeout_current_tick = 0;
 }
 
 /** Reinitialize timeout
@@ -66,7 +70,7 @@ void timeout_init(void)
 void timeout_reinitialize(timeout_t *timeout)
 {
 	timeout->cpu = NULL;
-	timeout->ticks = 0;
+	timeout->expires = 0;
 	timeout->handler = NULL;
 	timeout->arg = NULL;
 	link_initialize(&timeout->link);
@@ -85,11 +89,54 @@ void timeout_initialize(timeout_t *timeout)
 	timeout_reinitialize(timeout);
 }
 
+/** Compute the number of ticks until the nearest active timeout.
+ *
+ * Scan the whole timer wheel of the current CPU. The scan is linear
+ * in the number of active timeouts, so this is meant to be called
+ * only on the way to idle, where it tells the architecture how long
+ * the periodic tick may be stopped.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @return Ticks until the next timeout expires, 0 if one is already
+ *         due, or (uint64_t) -1 if no timeout is pending at all.
+ *
+ */
+uint64_t timeout_ticks_until_next(void)
+{
+	uint64_t nearest = (uint64_t) -1;
+
+	irq_spinlock_lock(&CPU->timeoutlock, false);
+
+	for (unsigned int i = 0; i < TIMEOUT_WHEEL_LEN; i++) {
+		/*
+		 * The expiry tick is stable under the wheel lock, no
+		 * need to take the individual timeout locks.
+		 */
+		list_foreach(CPU->timeout_wheel[i], link, timeout_t, timeout) {
+			if (timeout->expires < nearest)
+				nearest = timeout->expires;
+		}
+	}
+
+	uint64_t current = CPU->timeout_current_tick;
+
+	irq_spinlock_unlock(&CPU->timeoutlock, false);
+
+	if (nearest == (uint64_t) -1)
+		return (uint64_t) -1;
+
+	if (nearest <= current)
+		return 0;
+
+	return nearest - current;
+}
+
 /** Register timeout
  *
- * Insert timeout handler f (with argument arg)
- * to timeout list and make it execute in
- * time microseconds (or slightly more).
+ * Hash the timeout into the timer wheel bucket corresponding
+ * to its expiry tick and make it execute in time microseconds
+ * (or slightly more).
  *
  * @param timeout Timeout structure.
  * @param time    Number of usec in the future to execute the handler.
@@ -107,52 +154,17 @@ void timeout_register(timeout_t *timeout, uint64_t time,
 		panic("Unexpected: timeout->cpu != 0.");
 
 	timeout->cpu = CPU;
-	timeout->ticks = us2ticks(time);
-
 	timeout->handler = handler;
 	timeout->arg = arg;
 
 	/*
-	 * Insert timeout into the active timeouts list according to timeout->ticks.
+	 * The extra tick makes sure the timeout never fires earlier
+	 * than requested, even when registered just before clock().
 	 */
-	uint64_t sum = 0;
-	timeout_t *target = NULL;
-	link_t *cur, *prev;
-	prev = NULL;
-	for (cur = list_first(&CPU->timeout_active_list);
-	    cur != NULL; cur = list_next(cur, &CPU->timeout_active_list)) {
-		target = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&target->lock, false);
-
-		if (timeout->ticks < sum + target->ticks) {
-			irq_spinlock_unlock(&target->lock, false);
-			break;
-		}
+	timeout->expires = CPU->timeout_current_tick + us2ticks(time) + 1;
 
-		sum += target->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-		prev = cur;
-	}
-
-	if (prev == NULL)
-		list_prepend(&timeout->link, &CPU->timeout_active_list);
-	else
-		list_insert_after(&timeout->link, prev);
-
-	/*
-	 * Adjust timeout->ticks according to ticks
-	 * accumulated in target's predecessors.
-	 */
-	timeout->ticks -= sum;
-
-	/*
-	 * Decrease ticks of timeout's immediate succesor by timeout->ticks.
-	 */
-	if (cur != NULL) {
-		irq_spinlock_lock(&target->lock, false);
-		target->ticks -= timeout->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-	}
+	list_append(&timeout->link,
+	    &CPU->timeout_wheel[timeout->expires % TIMEOUT_WHEEL_LEN]);
 
 	irq_spinlock_unlock(&timeout->lock, false);
 	irq_spinlock_unlock(&CPU->timeoutlock, true);
@@ -186,18 +198,10 @@ grab_locks:
 
 	/*
 	 * Now we know for sure that timeout hasn't been activated yet
-	 * and is lurking in timeout->cpu->timeout_active_list.
+	 * and is lurking in its timer wheel bucket. Unlike with the
+	 * old delta list, no successor needs to be adjusted.
 	 */
 
-	link_t *cur = list_next(&timeout->link,
-	    &timeout->cpu->timeout_active_list);
-	if (cur != NULL) {
-		timeout_t *tmp = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&tmp->lock, false);
-		tmp->ticks += timeout->ticks;
-		irq_spinlock_unlock(&tmp->lock, false);
-	}
-
 	list_remove(&timeout->link);
 	irq_spinlock_unlock(&timeout->cpu->timeoutlock, false);
 
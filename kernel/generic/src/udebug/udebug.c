@@ -42,6 +42,7 @@
 #include <synch/waitq.h>
 #include <udebug/udebug.h>
 #include <errno.h>
+#include <mm/slab.h>
 #include <arch.h>
 #include <proc/task.h>
 #include <proc/thread.h>
@@ -59,6 +60,11 @@ void udebug_task_init(udebug_task_t *ut)
 	ut->begin_call = NULL;
 	ut->not_stoppable_count = 0;
 	ut->evmask = 0;
+	ut->sc_filter = false;
+	ut->ev_buf = NULL;
+	ut->ev_head = 0;
+	ut->ev_cnt = 0;
+	ut->ev_dropped = 0;
 }
 
 /** Initialize udebug part of thread structure.
@@ -238,6 +244,47 @@ void udebug_syscall_event(sysarg_t a1, sysarg_t a2, sysarg_t a3,
 		return;
 	}
 
+	/* Events for system calls outside the filter are not generated. */
+	if ((TASK->udebug.sc_filter) &&
+	    ((id >= SYSCALL_END) ||
+	    ((TASK->udebug.sc_mask[id / 8] & (1 << (id % 8))) == 0))) {
+		mutex_unlock(&THREAD->udebug.lock);
+		mutex_unlock(&TASK->udebug.lock);
+		return;
+	}
+
+	/*
+	 * With batching enabled the event is recorded in the trace
+	 * buffer and the thread continues running; the debugger drains
+	 * the buffer with UDEBUG_M_EVENTS_READ at its own pace.
+	 */
+	if (TASK->udebug.ev_buf != NULL) {
+		udebug_task_t *ut = &TASK->udebug;
+
+		if (ut->ev_cnt < UDEBUG_EV_BUF_SIZE) {
+			udebug_event_rec_t *rec = &ut->ev_buf[
+			    (ut->ev_head + ut->ev_cnt) % UDEBUG_EV_BUF_SIZE];
+
+			rec->thread = (sysarg_t) THREAD;
+			rec->etype = etype;
+			rec->sc_id = id;
+			rec->sc_rc = rc;
+			rec->args[0] = a1;
+			rec->args[1] = a2;
+			rec->args[2] = a3;
+			rec->args[3] = a4;
+			rec->args[4] = a5;
+			rec->args[5] = a6;
+			ut->ev_cnt++;
+		} else {
+			ut->ev_dropped++;
+		}
+
+		mutex_unlock(&THREAD->udebug.lock);
+		mutex_unlock(&TASK->udebug.lock);
+		return;
+	}
+
 	/* Fill in the GO response. */
 	call_t *call = THREAD->udebug.go_call;
 	THREAD->udebug.go_call = NULL;
@@ -404,6 +451,16 @@ errno_t udebug_task_cleanup(struct task *task)
 		return EINVAL;
 	}
 
+	/* Drop the trace buffer and the syscall filter. */
+	if (task->udebug.ev_buf != NULL) {
+		free(task->udebug.ev_buf);
+		task->udebug.ev_buf = NULL;
+		task->udebug.ev_head = 0;
+		task->udebug.ev_cnt = 0;
+		task->udebug.ev_dropped = 0;
+	}
+	task->udebug.sc_filter = false;
+
 	LOG("Task %" PRIu64, task->taskid);
 
 	/* Finish debugging of all userspace threads */
@@ -435,6 +435,46 @@ static void udebug_receive_mem_read(call_t *call)
 	ipc_answer(&TASK->kb.box, call);
 }
 
+static void udebug_receive_set_sysmask(call_t *call)
+{
+	uspace_addr_t uspace_mask = ipc_get_arg2(&call->data);
+	size_t size = ipc_get_arg3(&call->data);
+
+	errno_t rc = udebug_sysmask_set(uspace_mask, size);
+
+	ipc_set_retval(&call->data, rc);
+	ipc_answer(&TASK->kb.box, call);
+}
+
+static void udebug_receive_events_read(call_t *call)
+{
+	uspace_addr_t uspace_dst = ipc_get_arg2(&call->data);
+	size_t max_size = ipc_get_arg3(&call->data);
+	void *buffer = NULL;
+	size_t size;
+	size_t dropped;
+
+	errno_t rc = udebug_events_read(&buffer, &size, &dropped, max_size);
+	if (rc != EOK) {
+		ipc_set_retval(&call->data, rc);
+		ipc_answer(&TASK->kb.box, call);
+		return;
+	}
+
+	ipc_set_retval(&call->data, EOK);
+	/*
+	 * ARG1=dest, ARG2=size as in IPC_M_DATA_READ so that
+	 * same code in process_answer() can be used
+	 * (no way to distinguish method in answer)
+	 */
+	ipc_set_arg1(&call->data, uspace_dst);
+	ipc_set_arg2(&call->data, size);
+	ipc_set_arg3(&call->data, dropped);
+	call->buffer = buffer;
+
+	ipc_answer(&TASK->kb.box, call);
+}
+
 /** Handle a debug call received on the kernel answerbox.
  *
  * This is called by the kbox servicing thread. Verifies that the sender
@@ -495,6 +535,12 @@ void udebug_call_receive(call_t *call)
 	case UDEBUG_M_MEM_READ:
 		udebug_receive_mem_read(call);
 		break;
+	case UDEBUG_M_SET_SYSMASK:
+		udebug_receive_set_sysmask(call);
+		break;
+	case UDEBUG_M_EVENTS_READ:
+		udebug_receive_events_read(call);
+		break;
 	}
 }
 
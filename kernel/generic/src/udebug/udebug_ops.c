@@ -50,6 +50,7 @@
 #include <ipc/ipc.h>
 #include <udebug/udebug.h>
 #include <udebug/udebug_ops.h>
+#include <macros.h>
 #include <mem.h>
 #include <stdlib.h>
 
@@ -255,6 +256,120 @@ errno_t udebug_set_evmask(udebug_evmask_t mask)
 	return EOK;
 }
 
+/** Install or remove the system call filter.
+ *
+ * Copies the bitmap of traced system call numbers from the debugger's
+ * address space. An empty bitmap (@a size == 0) removes the filter.
+ *
+ * @param uspace_mask Source address of the bitmap.
+ * @param size        Size of the bitmap in bytes.
+ *
+ * @return Zero on success or an error code.
+ *
+ */
+errno_t udebug_sysmask_set(uspace_addr_t uspace_mask, size_t size)
+{
+	uint8_t mask[sizeof(TASK->udebug.sc_mask)];
+
+	if (size > sizeof(mask))
+		size = sizeof(mask);
+
+	memset(mask, 0, sizeof(mask));
+
+	if (size != 0) {
+		errno_t rc = copy_from_uspace(mask, uspace_mask, size);
+		if (rc != EOK)
+			return rc;
+	}
+
+	mutex_lock(&TASK->udebug.lock);
+
+	if (TASK->udebug.dt_state != UDEBUG_TS_ACTIVE) {
+		mutex_unlock(&TASK->udebug.lock);
+		return EINVAL;
+	}
+
+	if (size != 0) {
+		memcpy(TASK->udebug.sc_mask, mask,
+		    sizeof(TASK->udebug.sc_mask));
+		TASK->udebug.sc_filter = true;
+	} else {
+		TASK->udebug.sc_filter = false;
+	}
+
+	mutex_unlock(&TASK->udebug.lock);
+	return EOK;
+}
+
+/** Drain the batched trace event buffer.
+ *
+ * The first call enables batching. Up to @a max_size bytes worth of
+ * buffered events are moved into a newly allocated buffer for the IPC
+ * answer to copy out.
+ *
+ * @param buffer   Place to store pointer to a new buffer holding the
+ *                 drained events.
+ * @param rsize    Place to store the size of the drained data in bytes.
+ * @param rdropped Place to store the number of events dropped since the
+ *                 last drain.
+ * @param max_size Size of the debugger's receive buffer.
+ *
+ * @return Zero on success or an error code.
+ *
+ */
+errno_t udebug_events_read(void **buffer, size_t *rsize, size_t *rdropped,
+    size_t max_size)
+{
+	mutex_lock(&TASK->udebug.lock);
+
+	if (TASK->udebug.dt_state != UDEBUG_TS_ACTIVE) {
+		mutex_unlock(&TASK->udebug.lock);
+		return EINVAL;
+	}
+
+	udebug_task_t *ut = &TASK->udebug;
+
+	if (ut->ev_buf == NULL) {
+		ut->ev_buf = malloc(UDEBUG_EV_BUF_SIZE *
+		    sizeof(udebug_event_rec_t));
+		if (ut->ev_buf == NULL) {
+			mutex_unlock(&TASK->udebug.lock);
+			return ENOMEM;
+		}
+
+		ut->ev_head = 0;
+		ut->ev_cnt = 0;
+		ut->ev_dropped = 0;
+	}
+
+	size_t n = min(ut->ev_cnt, max_size / sizeof(udebug_event_rec_t));
+
+	udebug_event_rec_t *recs = NULL;
+	if (n > 0) {
+		recs = malloc(n * sizeof(udebug_event_rec_t));
+		if (recs == NULL) {
+			mutex_unlock(&TASK->udebug.lock);
+			return ENOMEM;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			recs[i] = ut->ev_buf[(ut->ev_head + i) %
+			    UDEBUG_EV_BUF_SIZE];
+		}
+
+		ut->ev_head = (ut->ev_head + n) % UDEBUG_EV_BUF_SIZE;
+		ut->ev_cnt -= n;
+	}
+
+	*buffer = recs;
+	*rsize = n * sizeof(udebug_event_rec_t);
+	*rdropped = ut->ev_dropped;
+	ut->ev_dropped = 0;
+
+	mutex_unlock(&TASK->udebug.lock);
+	return EOK;
+}
+
 /** Give thread GO.
  *
  * Upon recieving a go message, the thread is given GO. Being GO
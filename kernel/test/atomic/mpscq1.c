@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <atomic.h>
+#include <adt/mpsc_queue.h>
+#include <proc/thread.h>
+#include <stdlib.h>
+
+#define PRODUCERS       4
+#define ITEMS_PER_PROD  2000
+
+typedef struct {
+	mpsc_link_t link;
+	unsigned int producer;
+	unsigned int seq;
+} mpscq_item_t;
+
+static mpsc_queue_t queue;
+static atomic_size_t producers_finished;
+
+static void producer(void *arg)
+{
+	unsigned int id = (unsigned int) (uintptr_t) arg;
+	mpscq_item_t *items = malloc(sizeof(mpscq_item_t) * ITEMS_PER_PROD);
+
+	if (items != NULL) {
+		for (unsigned int i = 0; i < ITEMS_PER_PROD; i++) {
+			items[i].producer = id;
+			items[i].seq = i;
+			mpsc_queue_push(&queue, &items[i].link);
+		}
+	}
+
+	atomic_inc(&producers_finished);
+}
+
+const char *test_mpscq1(void)
+{
+	mpsc_queue_initialize(&queue);
+	atomic_store(&producers_finished, 0);
+
+	unsigned int expected_seq[PRODUCERS];
+	thread_t *threads[PRODUCERS];
+	mpscq_item_t *allocs[PRODUCERS];
+	size_t popped = 0;
+	const char *error = NULL;
+
+	for (unsigned int i = 0; i < PRODUCERS; i++) {
+		expected_seq[i] = 0;
+		allocs[i] = NULL;
+	}
+
+	TPRINTF("Creating %u producers...", PRODUCERS);
+
+	for (unsigned int i = 0; i < PRODUCERS; i++) {
+		threads[i] = thread_create(producer, (void *) (uintptr_t) i,
+		    TASK, THREAD_FLAG_NONE, "mpscq-prod");
+		if (threads[i])
+			thread_ready(threads[i]);
+		else
+			TPRINTF("could not create producer %u\n", i);
+	}
+
+	TPRINTF("ok\nConsuming...\n");
+
+	/*
+	 * Consume concurrently with the producers. Per-producer FIFO
+	 * order must hold even though the producers interleave.
+	 */
+	while (true) {
+		mpsc_link_t *link = mpsc_queue_pop(&queue);
+
+		if (link == NULL) {
+			if (atomic_load(&producers_finished) == PRODUCERS &&
+			    mpsc_queue_empty(&queue))
+				break;
+
+			continue;
+		}
+
+		mpscq_item_t *item = mpsc_queue_get_instance(link,
+		    mpscq_item_t, link);
+
+		if (item->seq != expected_seq[item->producer])
+			error = "per-producer FIFO order violated";
+
+		expected_seq[item->producer] = item->seq + 1;
+		popped++;
+
+		/* The first item of a producer owns the whole array. */
+		if (item->seq == 0)
+			allocs[item->producer] = item;
+	}
+
+	for (unsigned int i = 0; i < PRODUCERS; i++) {
+		if (threads[i]) {
+			thread_join(threads[i]);
+			thread_detach(threads[i]);
+		}
+		free(allocs[i]);
+	}
+
+	TPRINTF("Popped %zu items\n", popped);
+
+	if (error != NULL)
+		return error;
+
+	for (unsigned int i = 0; i < PRODUCERS; i++) {
+		if (allocs[i] != NULL &&
+		    expected_seq[i] != ITEMS_PER_PROD)
+			return "items were lost";
+	}
+
+	return NULL;
+}
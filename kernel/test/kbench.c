@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Micro-benchmarks of kernel primitives.
+ *
+ * Unlike the functional tests, these measure individual operations
+ * with the CPU cycle counter and report distribution statistics, so
+ * a change to a lock or allocator can be evaluated from kconsole
+ * without booting userspace. Results are in CPU cycles; they are only
+ * meaningful relative to other runs on the same machine.
+ */
+
+#include <test.h>
+#include <arch/cycle.h>
+#include <cap/cap.h>
+#include <gsort.h>
+#include <inttypes.h>
+#include <ipc/ipc.h>
+#include <mm/frame.h>
+#include <mm/slab.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include <synch/mutex.h>
+#include <synch/spinlock.h>
+#include <synch/waitq.h>
+
+/** Upper bound on the sample count to keep the sample buffer sane. */
+#define KBENCH_MAX_COUNT  (1 << 20)
+
+/** Iterations executed before measurement starts */
+#define KBENCH_WARMUP  64
+
+typedef struct {
+	const char *name;
+	const char *desc;
+	void (*op)(void);
+} kbench_t;
+
+IRQ_SPINLOCK_STATIC_INITIALIZE(kbench_spinlock);
+
+static void op_spinlock(void)
+{
+	irq_spinlock_lock(&kbench_spinlock, true);
+	irq_spinlock_unlock(&kbench_spinlock, true);
+}
+
+static mutex_t kbench_mutex;
+static bool kbench_mutex_inited = false;
+
+static void op_mutex(void)
+{
+	if (!kbench_mutex_inited) {
+		mutex_initialize(&kbench_mutex, MUTEX_PASSIVE);
+		kbench_mutex_inited = true;
+	}
+
+	mutex_lock(&kbench_mutex);
+	mutex_unlock(&kbench_mutex);
+}
+
+static waitq_t kbench_waitq;
+static bool kbench_waitq_inited = false;
+
+static void op_waitq(void)
+{
+	if (!kbench_waitq_inited) {
+		waitq_initialize(&kbench_waitq);
+		kbench_waitq_inited = true;
+	}
+
+	waitq_wakeup(&kbench_waitq, WAKEUP_FIRST);
+}
+
+static void op_frame(void)
+{
+	uintptr_t frame = frame_alloc(1, FRAME_ATOMIC, 0);
+	if (frame != 0)
+		frame_free(frame, 1);
+}
+
+static void op_malloc(void)
+{
+	void *p = malloc(64);
+	free(p);
+}
+
+static void op_ipc_call(void)
+{
+	call_t *call = ipc_call_alloc();
+	if (call != NULL)
+		kobject_put(call->kobject);
+}
+
+static kbench_t kbenchs[] = {
+	{
+		.name = "spinlock",
+		.desc = "Uncontended IRQ spinlock lock/unlock pair",
+		.op = op_spinlock
+	},
+	{
+		.name = "mutex",
+		.desc = "Uncontended passive mutex lock/unlock pair",
+		.op = op_mutex
+	},
+	{
+		.name = "waitq",
+		.desc = "Wait queue wakeup on an empty queue",
+		.op = op_waitq
+	},
+	{
+		.name = "frame",
+		.desc = "Single frame allocation and free",
+		.op = op_frame
+	},
+	{
+		.name = "malloc",
+		.desc = "64-byte kernel heap allocation and free",
+		.op = op_malloc
+	},
+	{
+		.name = "ipc_call",
+		.desc = "IPC call structure allocation and release",
+		.op = op_ipc_call
+	}
+};
+
+static int sample_cmp(void *a, void *b, void *arg)
+{
+	uint64_t va = *(uint64_t *) a;
+	uint64_t vb = *(uint64_t *) b;
+
+	if (va < vb)
+		return -1;
+	if (va > vb)
+		return 1;
+	return 0;
+}
+
+static void kbench_list(void)
+{
+	printf("Available benchmarks:\n");
+	for (size_t i = 0; i < sizeof(kbenchs) / sizeof(kbenchs[0]); i++)
+		printf("  %-10s %s\n", kbenchs[i].name, kbenchs[i].desc);
+}
+
+/** Run a named micro-benchmark and print its statistics.
+ *
+ * @param name  Benchmark name ("?" or an unknown name lists them).
+ * @param count Number of measured iterations.
+ */
+void kbench_run(const char *name, size_t count)
+{
+	kbench_t *bench = NULL;
+
+	for (size_t i = 0; i < sizeof(kbenchs) / sizeof(kbenchs[0]); i++) {
+		if (str_cmp(kbenchs[i].name, name) == 0) {
+			bench = &kbenchs[i];
+			break;
+		}
+	}
+
+	if (bench == NULL) {
+		kbench_list();
+		return;
+	}
+
+	if (count == 0)
+		count = 1;
+	if (count > KBENCH_MAX_COUNT)
+		count = KBENCH_MAX_COUNT;
+
+	uint64_t *samples = malloc(count * sizeof(uint64_t));
+	if (samples == NULL) {
+		printf("Failed to allocate sample buffer.\n");
+		return;
+	}
+
+	for (size_t i = 0; i < KBENCH_WARMUP; i++)
+		bench->op();
+
+	for (size_t i = 0; i < count; i++) {
+		uint64_t start = get_cycle();
+		bench->op();
+		samples[i] = get_cycle() - start;
+	}
+
+	if (!gsort(samples, count, sizeof(uint64_t), sample_cmp, NULL)) {
+		printf("Failed to sort samples.\n");
+		free(samples);
+		return;
+	}
+
+	uint64_t sum = 0;
+	for (size_t i = 0; i < count; i++)
+		sum += samples[i];
+
+	printf("%s: %zu iterations (cycles per operation)\n",
+	    bench->name, count);
+	printf("min=%" PRIu64 " avg=%" PRIu64 " median=%" PRIu64
+	    " p99=%" PRIu64 " max=%" PRIu64 "\n",
+	    samples[0], sum / count, samples[count / 2],
+	    samples[(count * 99) / 100 >= count ? count - 1 :
+	    (count * 99) / 100], samples[count - 1]);
+
+	free(samples);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <atomic.h>
+#include <barrier.h>
+#include <member.h>
+#include <proc/thread.h>
+#include <stdlib.h>
+#include <synch/rcu.h>
+
+#define READERS     8
+#define UPDATES     20
+#define READ_LOOPS  2000
+
+/** RCU protected payload */
+typedef struct {
+	rcu_item_t rcu;
+	/** Set once no reader may see this version anymore */
+	bool stale;
+} rcu_data_t;
+
+static rcu_data_t *current_data;
+
+static atomic_size_t threads_finished;
+static atomic_size_t failures;
+static atomic_size_t callbacks_fired;
+static atomic_bool updates_done;
+
+static void reader(void *arg)
+{
+	thread_detach(THREAD);
+
+	while (!atomic_load(&updates_done)) {
+		for (unsigned int i = 0; i < READ_LOOPS; i++) {
+			rcu_read_lock();
+
+			rcu_data_t *data = current_data;
+			if (data->stale) {
+				/*
+				 * The updater retired this version even
+				 * though our read-side section was
+				 * (possibly) still running.
+				 */
+				atomic_inc(&failures);
+			}
+
+			rcu_read_unlock();
+		}
+	}
+
+	atomic_inc(&threads_finished);
+}
+
+static void data_free(rcu_item_t *item)
+{
+	free(member_to_inst(item, rcu_data_t, rcu));
+	atomic_inc(&callbacks_fired);
+}
+
+const char *test_rcu1(void)
+{
+	atomic_store(&threads_finished, 0);
+	atomic_store(&failures, 0);
+	atomic_store(&callbacks_fired, 0);
+	atomic_store(&updates_done, false);
+
+	current_data = malloc(sizeof(rcu_data_t));
+	if (current_data == NULL)
+		return "out of memory";
+
+	current_data->stale = false;
+
+	TPRINTF("Creating %u readers...", READERS);
+
+	for (unsigned int i = 0; i < READERS; i++) {
+		thread_t *thrd = thread_create(reader, NULL, TASK,
+		    THREAD_FLAG_NONE, "rcu-reader");
+		if (thrd)
+			thread_ready(thrd);
+		else
+			TPRINTF("could not create reader %u\n", i);
+	}
+
+	TPRINTF("ok\nRunning %u updates...\n", UPDATES);
+
+	/*
+	 * Each update publishes a fresh version, waits out a grace
+	 * period, and only then marks the old version stale and hands
+	 * it to the reclaimer. A reader catching a stale version means
+	 * the grace period detection let a read-side section through.
+	 */
+	unsigned int updates = 0;
+	for (unsigned int i = 0; i < UPDATES; i++) {
+		rcu_data_t *new_data = malloc(sizeof(rcu_data_t));
+		if (new_data == NULL)
+			break;
+
+		new_data->stale = false;
+
+		rcu_data_t *old_data = current_data;
+
+		/* Publish only after the new version is initialized. */
+		write_barrier();
+		current_data = new_data;
+
+		rcu_synchronize();
+
+		old_data->stale = true;
+		rcu_call(&old_data->rcu, data_free);
+		updates++;
+	}
+
+	atomic_store(&updates_done, true);
+
+	while (atomic_load(&threads_finished) < READERS) {
+		TPRINTF("%zu readers remaining\n",
+		    READERS - atomic_load(&threads_finished));
+		thread_sleep(1);
+	}
+
+	TPRINTF("Waiting for the reclaimer callbacks...\n");
+
+	unsigned int waited = 0;
+	while (atomic_load(&callbacks_fired) < updates) {
+		if (++waited > 10)
+			return "rcu_call() callbacks did not fire";
+		thread_sleep(1);
+	}
+
+	if (atomic_load(&failures) > 0)
+		return "reader observed a retired version";
+
+	return NULL;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <atomic.h>
+#include <proc/thread.h>
+#include <synch/rwlock.h>
+#include <synch/waitq.h>
+
+#define READERS  40
+#define WRITERS  10
+
+static rwlock_t rwl;
+
+static waitq_t can_start;
+static atomic_size_t threads_finished;
+static atomic_size_t readers_in;
+static atomic_size_t failures;
+
+/** Value only ever modified under the write lock. */
+static size_t counter;
+
+static void reader(void *arg)
+{
+	thread_detach(THREAD);
+
+	waitq_sleep(&can_start);
+
+	rwlock_read_lock(&rwl);
+
+	atomic_inc(&readers_in);
+
+	size_t snapshot = counter;
+	thread_usleep(500);
+	if (counter != snapshot) {
+		/* A writer ran while we held the read lock. */
+		atomic_inc(&failures);
+	}
+
+	atomic_dec(&readers_in);
+
+	rwlock_read_unlock(&rwl);
+
+	atomic_inc(&threads_finished);
+}
+
+static void writer(void *arg)
+{
+	thread_detach(THREAD);
+
+	waitq_sleep(&can_start);
+
+	rwlock_write_lock(&rwl);
+
+	if (atomic_load(&readers_in) > 0) {
+		/* Writer ran concurrently with a reader. */
+		atomic_inc(&failures);
+	}
+
+	counter++;
+	thread_usleep(250);
+
+	rwlock_write_unlock(&rwl);
+
+	atomic_inc(&threads_finished);
+}
+
+const char *test_rwlock1(void)
+{
+	waitq_initialize(&can_start);
+	rwlock_initialize(&rwl);
+
+	atomic_store(&threads_finished, 0);
+	atomic_store(&readers_in, 0);
+	atomic_store(&failures, 0);
+	counter = 0;
+
+	TPRINTF("Creating %u readers and %u writers...", READERS, WRITERS);
+
+	for (unsigned int i = 0; i < READERS; i++) {
+		thread_t *thrd = thread_create(reader, NULL, TASK,
+		    THREAD_FLAG_NONE, "reader");
+		if (thrd)
+			thread_ready(thrd);
+		else
+			TPRINTF("could not create reader %u\n", i);
+	}
+
+	for (unsigned int i = 0; i < WRITERS; i++) {
+		thread_t *thrd = thread_create(writer, NULL, TASK,
+		    THREAD_FLAG_NONE, "writer");
+		if (thrd)
+			thread_ready(thrd);
+		else
+			TPRINTF("could not create writer %u\n", i);
+	}
+
+	TPRINTF("ok\n");
+
+	thread_sleep(1);
+	waitq_wakeup(&can_start, WAKEUP_ALL);
+
+	while (atomic_load(&threads_finished) < READERS + WRITERS) {
+		TPRINTF("%zu threads remaining\n",
+		    READERS + WRITERS - atomic_load(&threads_finished));
+		thread_sleep(1);
+	}
+
+	if (atomic_load(&failures) > 0)
+		return "reader/writer exclusion violated";
+
+	if (counter != WRITERS)
+		return "lost writer updates";
+
+	return NULL;
+}
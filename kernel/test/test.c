@@ -40,6 +40,7 @@ bool test_quiet;
 
 test_t tests[] = {
 #include <atomic/atomic1.def>
+#include <atomic/mpscq1.def>
 #include <debug/mips1.def>
 #include <fault/fault1.def>
 #include <mm/falloc1.def>
@@ -47,6 +48,8 @@ test_t tests[] = {
 #include <mm/mapping1.def>
 #include <mm/slab1.def>
 #include <mm/slab2.def>
+#include <synch/rcu1.def>
+#include <synch/rwlock1.def>
 #include <synch/semaphore1.def>
 #include <synch/semaphore2.def>
 #include <print/print1.def>
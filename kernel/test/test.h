@@ -57,6 +57,7 @@ typedef struct {
 } test_t;
 
 extern const char *test_atomic1(void);
+extern const char *test_mpscq1(void);
 extern const char *test_mips1(void);
 extern const char *test_fault1(void);
 extern const char *test_falloc1(void);
@@ -65,6 +66,8 @@ extern const char *test_mapping1(void);
 extern const char *test_purge1(void);
 extern const char *test_slab1(void);
 extern const char *test_slab2(void);
+extern const char *test_rcu1(void);
+extern const char *test_rwlock1(void);
 extern const char *test_semaphore1(void);
 extern const char *test_semaphore2(void);
 extern const char *test_print1(void);
@@ -76,6 +79,8 @@ extern const char *test_thread1(void);
 
 extern test_t tests[];
 
+extern void kbench_run(const char *, size_t);
+
 extern const char *tests_hints_enum(const char *, const char **, void **);
 
 #endif
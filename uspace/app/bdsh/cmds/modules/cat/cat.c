@@ -48,7 +48,7 @@
 
 static const char *cmdname = "cat";
 #define CAT_VERSION "0.0.1"
-#define CAT_DEFAULT_BUFLEN 1024
+#define CAT_DEFAULT_BUFLEN 65536
 #define CAT_FULL_FILE 0
 
 static const char *hexchars = "0123456789abcdef";
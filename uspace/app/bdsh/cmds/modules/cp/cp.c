@@ -44,7 +44,7 @@
 #include "cmds.h"
 
 #define CP_VERSION "0.0.1"
-#define CP_DEFAULT_BUFLEN  1024
+#define CP_DEFAULT_BUFLEN  65536
 
 static const char *cmdname = "cp";
 static console_ctrl_t *con;
@@ -428,6 +428,21 @@ static int copy_file(const char *src, const char *dest,
 	if (vb)
 		printf("%" PRIu64 " bytes to copy\n", total);
 
+	/*
+	 * A same-filesystem copy can be done entirely by the file
+	 * system server, moving the data through its caches without
+	 * a userspace round trip per buffer. EXDEV or ENOTSUP mean
+	 * we have to do it by hand.
+	 */
+	rc = vfs_copy(fd1, fd2);
+	if (rc == EOK)
+		goto out;
+
+	if ((rc != EXDEV) && (rc != ENOTSUP)) {
+		printf("\nError copying %s: %s\n", src, str_error(rc));
+		goto out;
+	}
+
 	if (NULL == (buff = (char *) malloc(blen))) {
 		printf("Unable to allocate enough memory to read %s\n",
 		    src);
@@ -441,10 +456,8 @@ static int copy_file(const char *src, const char *dest,
 			break;
 	}
 
-	if (rc != EOK) {
+	if (rc != EOK)
 		printf("\nError copying %s: %s\n", src, str_error(rc));
-		return -1;
-	}
 
 out:
 	vfs_put(fd1);
@@ -110,14 +110,19 @@ static errno_t find_command(char *cmd, char **found)
 	return EOK;
 }
 
-unsigned int try_exec(char *cmd, char **argv, iostate_t *io)
+/** Spawn an external command without waiting for it.
+ *
+ * On success the caller collects the task through try_exec_wait(),
+ * which allows several commands (e.g. pipeline stages) to run
+ * concurrently.
+ */
+unsigned int try_exec_spawn(char *cmd, char **argv, iostate_t *io,
+    task_wait_t *twait)
 {
 	task_id_t tid;
-	task_wait_t twait;
-	task_exit_t texit;
 	char *tmp;
 	errno_t rc;
-	int retval, i;
+	int i;
 	int file_handles[3] = { -1, -1, -1 };
 	FILE *files[3];
 
@@ -140,7 +145,7 @@ unsigned int try_exec(char *cmd, char **argv, iostate_t *io)
 		vfs_fhandle(files[i], &file_handles[i]);
 	}
 
-	rc = task_spawnvf(&tid, &twait, tmp, (const char **) argv,
+	rc = task_spawnvf(&tid, twait, tmp, (const char **) argv,
 	    file_handles[0], file_handles[1], file_handles[2]);
 	free(tmp);
 
@@ -150,7 +155,17 @@ unsigned int try_exec(char *cmd, char **argv, iostate_t *io)
 		return 1;
 	}
 
-	rc = task_wait(&twait, &texit, &retval);
+	return 0;
+}
+
+/** Wait for a spawned command and report how it fared */
+unsigned int try_exec_wait(task_wait_t *twait)
+{
+	task_exit_t texit;
+	int retval;
+	errno_t rc;
+
+	rc = task_wait(twait, &texit, &retval);
 	if (rc != EOK) {
 		printf("%s: Failed waiting for command (%s)\n", progname,
 		    str_error(rc));
@@ -166,3 +181,13 @@ unsigned int try_exec(char *cmd, char **argv, iostate_t *io)
 
 	return 0;
 }
+
+unsigned int try_exec(char *cmd, char **argv, iostate_t *io)
+{
+	task_wait_t twait;
+
+	if (try_exec_spawn(cmd, argv, io, &twait) != 0)
+		return 1;
+
+	return try_exec_wait(&twait);
+}
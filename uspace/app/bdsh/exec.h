@@ -35,5 +35,8 @@
 extern const char *search_dir[];
 
 extern unsigned int try_exec(char *, char **, iostate_t *);
+extern unsigned int try_exec_spawn(char *, char **, iostate_t *,
+    task_wait_t *);
+extern unsigned int try_exec_wait(task_wait_t *);
 
 #endif
@@ -45,6 +45,9 @@
 #include <tinput.h>
 #include <adt/odict.h>
 #include <adt/list.h>
+#include <pipesrv.h>
+#include <str_error.h>
+#include <task.h>
 
 #include "config.h"
 #include "compl.h"
@@ -60,8 +63,12 @@ extern volatile unsigned int cli_quit;
 /** Text input field. */
 static tinput_t *tinput;
 
+/** Cap on concurrently connected pipeline stages */
+#define PIPELINE_MAX_STAGES  8
+
 /* Private helpers */
 static int run_command(char **, cliuser_t *, iostate_t *);
+static int run_pipeline(char **, unsigned int *, unsigned int, iostate_t *);
 static void print_pipe_usage(void);
 
 typedef struct {
@@ -101,7 +108,8 @@ static errno_t process_input_nohup(cliuser_t *usr, list_t *alias_hups, size_t co
 	errno_t rc = EOK;
 	tokenizer_t tok;
 	unsigned int i, pipe_count, processed_pipes;
-	unsigned int pipe_pos[2];
+	unsigned int first_pipe = 0;
+	unsigned int last_pipe = 0;
 	char *redir_from = NULL;
 	char *redir_to = NULL;
 
@@ -131,19 +139,15 @@ static errno_t process_input_nohup(cliuser_t *usr, list_t *alias_hups, size_t co
 	}
 
 	/*
-	 * Until full support for pipes is implemented, allow for a simple case:
-	 * [from <file> |] command [| to <file>]
-	 *
-	 * First find the pipes and check that there are no more
+	 * Pipes: the legacy [from <file> |] prefix and [| to <file>]
+	 * suffix redirections are recognized first; any remaining
+	 * pipes split the command into concurrently running stages.
 	 */
 	for (i = 0, pipe_count = 0; i < tokens_length; i++) {
 		if (tokens[i].type == TOKTYPE_PIPE) {
-			if (pipe_count >= 2) {
-				print_pipe_usage();
-				rc = ENOTSUP;
-				goto finit;
-			}
-			pipe_pos[pipe_count] = i;
+			if (pipe_count == 0)
+				first_pipe = i;
+			last_pipe = i;
 			pipe_count++;
 		}
 	}
@@ -154,41 +158,56 @@ static errno_t process_input_nohup(cliuser_t *usr, list_t *alias_hups, size_t co
 	processed_pipes = 0;
 
 	/* Check if the first part (from <file> |) is present */
-	if (pipe_count > 0 && (pipe_pos[0] == 3 || pipe_pos[0] == 4) && str_cmp(tokens[0].text, "from") == 0) {
+	if (pipe_count > 0 && (first_pipe == 3 || first_pipe == 4) && str_cmp(tokens[0].text, "from") == 0) {
 		/* Ignore the first three tokens (from, file, pipe) and set from */
 		redir_from = tokens[2].text;
-		cmd_token_start = pipe_pos[0] + 1;
+		cmd_token_start = first_pipe + 1;
 		processed_pipes++;
 	}
 
 	/* Check if the second part (| to <file>) is present */
 	if ((pipe_count - processed_pipes) > 0 &&
-	    (pipe_pos[processed_pipes] == tokens_length - 4 ||
-	    (pipe_pos[processed_pipes] == tokens_length - 5 &&
+	    (last_pipe == tokens_length - 4 ||
+	    (last_pipe == tokens_length - 5 &&
 	    tokens[tokens_length - 4].type == TOKTYPE_SPACE)) &&
 	    str_cmp(tokens[tokens_length - 3].text, "to") == 0) {
 		/* Ignore the last three tokens (pipe, to, file) and set to */
 		redir_to = tokens[tokens_length - 1].text;
-		cmd_token_end = pipe_pos[processed_pipes];
+		cmd_token_end = last_pipe;
 		processed_pipes++;
 	}
 
-	if (processed_pipes != pipe_count) {
-		print_pipe_usage();
-		rc = ENOTSUP;
-		goto finit;
-	}
-
-	/* Convert tokens of the command to string array */
+	/*
+	 * Convert tokens of the command to string array, splitting
+	 * into pipeline stages at the remaining pipes.
+	 */
 	unsigned int cmd_pos = 0;
+	unsigned int stage_count = 1;
+	unsigned int stage_start[PIPELINE_MAX_STAGES];
+
+	stage_start[0] = 0;
 	for (i = cmd_token_start; i < cmd_token_end; i++) {
-		if (tokens[i].type != TOKTYPE_SPACE) {
-			cmd[cmd_pos++] = tokens[i].text;
+		if (tokens[i].type == TOKTYPE_SPACE)
+			continue;
+
+		if (tokens[i].type == TOKTYPE_PIPE) {
+			if ((stage_count >= PIPELINE_MAX_STAGES) ||
+			    (cmd_pos == 0) || (cmd[cmd_pos - 1] == NULL)) {
+				print_pipe_usage();
+				rc = ENOTSUP;
+				goto finit;
+			}
+
+			cmd[cmd_pos++] = NULL;
+			stage_start[stage_count++] = cmd_pos;
+			continue;
 		}
+
+		cmd[cmd_pos++] = tokens[i].text;
 	}
 	cmd[cmd_pos++] = NULL;
 
-	if (cmd[0] == NULL) {
+	if (cmd[0] == NULL || cmd[stage_start[stage_count - 1]] == NULL) {
 		print_pipe_usage();
 		rc = ENOTSUP;
 		goto finit;
@@ -273,7 +292,14 @@ static errno_t process_input_nohup(cliuser_t *usr, list_t *alias_hups, size_t co
 		new_iostate.stdout = to;
 	}
 
-	if (run_command(cmd, usr, &new_iostate) == 0) {
+	int run_rc;
+	if (stage_count == 1)
+		run_rc = run_command(cmd, usr, &new_iostate);
+	else
+		run_rc = run_pipeline(cmd, stage_start, stage_count,
+		    &new_iostate);
+
+	if (run_rc == 0) {
 		rc = EOK;
 	} else {
 		rc = EINVAL;
@@ -316,11 +342,95 @@ errno_t process_input(cliuser_t *usr)
 void print_pipe_usage(void)
 {
 	printf("Invalid syntax!\n");
-	printf("Usage of redirection (pipes in the future):\n");
+	printf("Usage of pipes and redirection:\n");
 	printf("from filename | command ...\n");
 	printf("from filename | command ... | to filename\n");
 	printf("command ... | to filename\n");
+	printf("command ... | command ... [| command ...]\n");
+}
+
+/** Run pipeline stages concurrently, connected by anonymous pipes */
+static int run_pipeline(char **cmd, unsigned int *stage_start,
+    unsigned int stage_count, iostate_t *io)
+{
+	FILE *rfile[PIPELINE_MAX_STAGES - 1] = { NULL };
+	FILE *wfile[PIPELINE_MAX_STAGES - 1] = { NULL };
+	task_wait_t waits[PIPELINE_MAX_STAGES];
+	bool spawned[PIPELINE_MAX_STAGES] = { false };
+	unsigned int i;
+	int ret = 0;
+
+	/*
+	 * Builtins redirect the process-wide I/O state, so only
+	 * external commands can run concurrently.
+	 */
+	for (i = 0; i < stage_count; i++) {
+		char *name = cmd[stage_start[i]];
+		if ((is_builtin(name) > -1) || (is_module(name) > -1)) {
+			cli_error(CL_ENOTSUP,
+			    "%s: Only external commands can form a pipeline",
+			    name);
+			return 1;
+		}
+	}
+
+	/* Connect adjacent stages through the pipe service. */
+	for (i = 0; i < stage_count - 1; i++) {
+		int id;
+		char *rpath;
+		char *wpath;
+
+		errno_t rc = pipesrv_create(&id);
+		if (rc == EOK)
+			rc = pipesrv_paths(id, &rpath, &wpath);
+		if (rc != EOK) {
+			printf("Cannot create pipe (%s)\n", str_error(rc));
+			ret = 1;
+			goto cleanup;
+		}
+
+		/* Open the write end first so readers never see EOF early. */
+		wfile[i] = fopen(wpath, "w");
+		rfile[i] = fopen(rpath, "r");
+		free(rpath);
+		free(wpath);
+
+		if ((wfile[i] == NULL) || (rfile[i] == NULL)) {
+			printf("Cannot open pipe ends\n");
+			ret = 1;
+			goto cleanup;
+		}
+	}
+
+	for (i = 0; i < stage_count; i++) {
+		iostate_t sio = {
+			.stdin = (i == 0) ? io->stdin : rfile[i - 1],
+			.stdout = (i == stage_count - 1) ? io->stdout : wfile[i],
+			.stderr = io->stderr
+		};
+
+		if (try_exec_spawn(cmd[stage_start[i]], &cmd[stage_start[i]],
+		    &sio, &waits[i]) == 0)
+			spawned[i] = true;
+		else
+			ret = 1;
+	}
+
+cleanup:
+	/* Drop our copies so EOF propagates between the stages. */
+	for (i = 0; i < stage_count - 1; i++) {
+		if (wfile[i] != NULL)
+			fclose(wfile[i]);
+		if (rfile[i] != NULL)
+			fclose(rfile[i]);
+	}
+
+	for (i = 0; i < stage_count; i++) {
+		if (spawned[i] && (try_exec_wait(&waits[i]) != 0))
+			ret = 1;
+	}
 
+	return ret;
 }
 
 int run_command(char **cmd, cliuser_t *usr, iostate_t *new_iostate)
@@ -113,6 +113,11 @@ int main()
     ts.add<std::test::set_test>();
     ts.add<std::test::unordered_map_test>();
     ts.add<std::test::unordered_set_test>();
+    ts.add<std::test::flat_unordered_test>();
+    ts.add<std::test::execution_test>();
+    ts.add<std::test::memory_resource_test>();
+    ts.add<std::test::charconv_test>();
+    ts.add<std::test::synch_test>();
     ts.add<std::test::numeric_test>();
     ts.add<std::test::adaptors_test>();
     ts.add<std::test::memory_test>();
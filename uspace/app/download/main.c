@@ -43,6 +43,7 @@
 #include <task.h>
 #include <macros.h>
 
+#include <http/body.h>
 #include <http/http.h>
 #include <uri.h>
 
@@ -224,8 +225,22 @@ int main(int argc, char *argv[])
 			goto error;
 		}
 
+		/*
+		 * Stream the body through the framing decoder, so
+		 * Content-Length delimited and chunked responses
+		 * both end where the server says they do instead of
+		 * relying on the connection closing.
+		 */
+		http_body_t body;
+		rc = http_body_init(&body, &http->recv_buffer, response);
+		if (rc != EOK) {
+			fprintf(stderr, "Failed parsing body framing: %s\n",
+			    str_error(rc));
+			goto error;
+		}
+
 		size_t body_size;
-		while ((rc = recv_buffer(&http->recv_buffer, buf, buf_size, &body_size)) == EOK && body_size > 0) {
+		while ((rc = http_body_read(&body, buf, buf_size, &body_size)) == EOK && body_size > 0) {
 			fwrite(buf, 1, body_size, ofile != NULL ? ofile : stdout);
 		}
 
@@ -51,6 +51,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <types/common.h>
 #include <ui/control.h>
@@ -953,11 +954,11 @@ static void file_save_as(void)
 static errno_t file_insert(char *fname)
 {
 	FILE *f;
-	char32_t c;
-	char buf[BUF_SIZE];
-	int bcnt;
-	int n_read;
-	size_t off;
+	char buf[ROW_BUF_SIZE + 1];
+	size_t bcnt;
+	size_t n_read;
+	size_t take;
+	spt_t pt;
 
 	f = fopen(fname, "rt");
 	if (f == NULL)
@@ -965,21 +966,57 @@ static errno_t file_insert(char *fname)
 
 	bcnt = 0;
 
+	/*
+	 * Stream the file in whole buffers, inserting each as one
+	 * sheet operation instead of character by character.
+	 */
 	while (true) {
-		if (bcnt < STR_BOUNDS(1)) {
-			n_read = fread(buf + bcnt, 1, BUF_SIZE - bcnt, f);
-			bcnt += n_read;
-		}
+		n_read = fread(buf + bcnt, 1, ROW_BUF_SIZE - bcnt, f);
+		bcnt += n_read;
 
-		off = 0;
-		c = str_decode(buf, &off, bcnt);
-		if (c == '\0')
+		if (bcnt == 0)
 			break;
 
-		bcnt -= off;
-		memmove(buf, buf + off, bcnt);
+		/*
+		 * Unless the file has ended, keep an incomplete
+		 * trailing multi-byte character for the next round.
+		 */
+		take = bcnt;
+		if (n_read > 0) {
+			size_t last = bcnt;
+			while (last > 0 && bcnt - last < STR_BOUNDS(1) &&
+			    ((uint8_t) buf[last - 1] & 0xc0) == 0x80)
+				last--;
+
+			if (last > 0 && ((uint8_t) buf[last - 1] & 0x80) != 0) {
+				uint8_t lead = (uint8_t) buf[last - 1];
+				size_t need = ((lead & 0xe0) == 0xc0) ? 2 :
+				    ((lead & 0xf0) == 0xe0) ? 3 :
+				    ((lead & 0xf8) == 0xf0) ? 4 : 1;
+
+				if (last - 1 + need > bcnt)
+					take = last - 1;
+			}
+		}
 
-		insert_char(c);
+		/* Malformed trailer; take it as-is to make progress. */
+		if (take == 0 && n_read > 0 && bcnt == ROW_BUF_SIZE)
+			take = bcnt;
+
+		if (take > 0) {
+			char saved = buf[take];
+			buf[take] = '\0';
+
+			tag_get_pt(&pane.caret_pos, &pt);
+			(void) sheet_insert(doc.sh, &pt, dir_before, buf);
+
+			buf[take] = saved;
+			memmove(buf, buf + take, bcnt - take);
+			bcnt -= take;
+		}
+
+		if (n_read == 0)
+			break;
 	}
 
 	fclose(f);
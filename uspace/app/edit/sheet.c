@@ -31,7 +31,7 @@
  */
 /**
  * @file
- * @brief Prototype implementation of Sheet data structure.
+ * @brief Sheet data structure on a gap buffer.
  *
  * The sheet is an abstract data structure representing a piece of text.
  * On top of this data structure we can implement a text editor. It is
@@ -43,9 +43,13 @@
  * versa. The text that is inserted or deleted can contain tabs and newlines
  * which are interpreted and properly acted upon.
  *
- * This is a trivial implementation with poor efficiency with O(N+n)
- * insertion and deletion and O(N) mapping (in both directions), where
- * N is the size of the file and n is the size of the inserted/deleted text.
+ * The text is kept in a gap buffer, so an edit only moves the text
+ * between the gap and the edit point rather than the whole tail of
+ * the document; consecutive edits at one spot (i.e. typing) cost
+ * amortized O(n) in the size of the edit. Coordinate mapping scans
+ * resume from an anchor left by the previous query instead of from
+ * the start of the file, and the line count is maintained across
+ * edits instead of recounted.
  */
 
 #include <stdlib.h>
@@ -54,6 +58,7 @@
 #include <adt/list.h>
 #include <align.h>
 #include <macros.h>
+#include <mem.h>
 
 #include "sheet.h"
 #include "sheet_impl.h"
@@ -61,10 +66,67 @@
 enum {
 	TAB_WIDTH	= 8,
 
-	/** Initial  of dat buffer in bytes */
+	/** Initial size of the data buffer in bytes */
 	INITIAL_SIZE	= 32
 };
 
+/** Decode the character at logical offset @a *off, advancing it.
+ *
+ * The gap always sits on a character boundary, so each character
+ * lies entirely within one of the two text segments.
+ */
+static char32_t sheet_decode(sheet_t *sh, size_t *off)
+{
+	if (*off < sh->gap_off)
+		return str_decode(sh->data, off, sh->gap_off);
+
+	size_t poff = *off + sh->gap_size;
+	char32_t c = str_decode(sh->data, &poff, sh->dbuf_size);
+	*off = poff - sh->gap_size;
+	return c;
+}
+
+/** Move the gap to logical offset @a off */
+static void sheet_move_gap(sheet_t *sh, size_t off)
+{
+	if (off == sh->gap_off)
+		return;
+
+	if (off < sh->gap_off) {
+		/* Text between off and the gap moves up. */
+		memmove(sh->data + off + sh->gap_size, sh->data + off,
+		    sh->gap_off - off);
+	} else {
+		/* Text between the gap and off moves down. */
+		memmove(sh->data + sh->gap_off,
+		    sh->data + sh->gap_off + sh->gap_size, off - sh->gap_off);
+	}
+
+	sh->gap_off = off;
+}
+
+/** Count newlines in a range of raw bytes */
+static size_t count_newlines(char const *data, size_t size)
+{
+	size_t cnt = 0;
+	size_t i;
+
+	for (i = 0; i < size; i++) {
+		if (data[i] == '\n')
+			cnt++;
+	}
+
+	return cnt;
+}
+
+/** Reset the coordinate anchor to the start of the file */
+static void sheet_anchor_reset(sheet_t *sh)
+{
+	sh->anchor_off = 0;
+	sh->anchor_row = 1;
+	sh->anchor_col = 1;
+}
+
 /** Initialize an empty sheet. */
 errno_t sheet_create(sheet_t **rsh)
 {
@@ -83,6 +145,11 @@ errno_t sheet_create(sheet_t **rsh)
 		return ENOMEM;
 	}
 
+	sh->gap_off = 0;
+	sh->gap_size = sh->dbuf_size;
+	sh->nlines = 0;
+	sheet_anchor_reset(sh);
+
 	list_initialize(&sh->tags);
 
 	*rsh = sh;
@@ -104,27 +171,42 @@ errno_t sheet_create(sheet_t **rsh)
  */
 errno_t sheet_insert(sheet_t *sh, spt_t *pos, enum dir_spec dir, char *str)
 {
-	char *ipp;
-	size_t sz;
 	char *newp;
+	size_t sz;
 
 	sz = str_size(str);
 	if (sh->text_size + sz > sh->dbuf_size) {
 		/* Enlarge data buffer. */
-		newp = realloc(sh->data, sh->dbuf_size * 2);
+		size_t nsize = sh->dbuf_size;
+		while (sh->text_size + sz > nsize)
+			nsize = nsize * 2;
+
+		/* Keep the tail segment at the buffer's end. */
+		sheet_move_gap(sh, sh->text_size);
+
+		newp = realloc(sh->data, nsize);
 		if (newp == NULL)
 			return ELIMIT;
 
 		sh->data = newp;
-		sh->dbuf_size = sh->dbuf_size * 2;
+		sh->dbuf_size = nsize;
+		sh->gap_size = nsize - sh->text_size;
 	}
 
-	ipp = sh->data + pos->b_off;
+	sheet_move_gap(sh, pos->b_off);
+
+	/* The gap now starts physically right at the insertion point. */
+	memcpy(sh->data + sh->gap_off, str, sz);
 
-	/* Copy data. */
-	memmove(ipp + sz, ipp, sh->text_size - pos->b_off);
-	memcpy(ipp, str, sz);
+	sh->gap_off += sz;
+	sh->gap_size -= sz;
 	sh->text_size += sz;
+	sh->nlines += count_newlines(str, sz);
+
+	/* The anchor is stale past the insertion point. */
+	if (sh->anchor_off > pos->b_off ||
+	    (sh->anchor_off == pos->b_off && dir == dir_before))
+		sheet_anchor_reset(sh);
 
 	/* Adjust tags. */
 
@@ -150,17 +232,28 @@ errno_t sheet_insert(sheet_t *sh, spt_t *pos, enum dir_spec dir, char *str)
  */
 errno_t sheet_delete(sheet_t *sh, spt_t *spos, spt_t *epos)
 {
-	char *spp;
-	size_t sz;
 	char *newp;
+	size_t sz;
 	size_t shrink_size;
 
-	spp = sh->data + spos->b_off;
 	sz = epos->b_off - spos->b_off;
 
-	memmove(spp, spp + sz, sh->text_size - (spos->b_off + sz));
+	/*
+	 * Move the gap right before the deleted range; the range is
+	 * then contiguous and removing it only means growing the gap
+	 * over it.
+	 */
+	sheet_move_gap(sh, spos->b_off);
+
+	sh->nlines -= count_newlines(sh->data + spos->b_off + sh->gap_size,
+	    sz);
+
+	sh->gap_size += sz;
 	sh->text_size -= sz;
 
+	if (sh->anchor_off > spos->b_off)
+		sheet_anchor_reset(sh);
+
 	/* Adjust tags. */
 	list_foreach(sh->tags, link, tag_t, tag) {
 		if (tag->b_off >= epos->b_off)
@@ -173,6 +266,8 @@ errno_t sheet_delete(sheet_t *sh, spt_t *spos, spt_t *epos)
 	shrink_size = max(sh->dbuf_size / 4, INITIAL_SIZE);
 	if (sh->text_size <= shrink_size && sh->dbuf_size > INITIAL_SIZE) {
 		/* Shrink data buffer. */
+		sheet_move_gap(sh, sh->text_size);
+
 		newp = realloc(sh->data, shrink_size);
 		if (newp == NULL) {
 			/* Failed to shrink buffer... no matter. */
@@ -181,6 +276,7 @@ errno_t sheet_delete(sheet_t *sh, spt_t *spos, spt_t *epos)
 
 		sh->data = newp;
 		sh->dbuf_size = shrink_size;
+		sh->gap_size = shrink_size - sh->text_size;
 	}
 
 	return EOK;
@@ -190,26 +286,45 @@ errno_t sheet_delete(sheet_t *sh, spt_t *spos, spt_t *epos)
 void sheet_copy_out(sheet_t *sh, spt_t const *spos, spt_t const *epos,
     char *buf, size_t bufsize, spt_t *fpos)
 {
-	char *spp;
 	size_t range_sz;
 	size_t copy_sz;
 	size_t off, prev;
 	char32_t c;
 
-	spp = sh->data + spos->b_off;
 	range_sz = epos->b_off - spos->b_off;
 	copy_sz = (range_sz < bufsize - 1) ? range_sz : bufsize - 1;
 
-	prev = off = 0;
-	do {
+	/*
+	 * Advance over whole characters until the copy size is
+	 * reached; this both crops to a character boundary and
+	 * handles the range possibly spanning the gap.
+	 */
+	off = spos->b_off;
+	prev = off;
+	while (off - spos->b_off < copy_sz) {
 		prev = off;
-		c = str_decode(spp, &off, copy_sz);
-	} while (c != '\0');
+		c = sheet_decode(sh, &off);
+		if (c == '\0')
+			break;
+
+		if (off - spos->b_off <= copy_sz)
+			prev = off;
+		else
+			break;
+	}
+
+	copy_sz = prev - spos->b_off;
 
-	/* Crop copy_sz down to the last full character. */
-	copy_sz = prev;
+	/* Copy out, possibly in two runs around the gap. */
+	if (spos->b_off < sh->gap_off) {
+		size_t lower = min(copy_sz, sh->gap_off - spos->b_off);
+		memcpy(buf, sh->data + spos->b_off, lower);
+		memcpy(buf + lower,
+		    sh->data + sh->gap_off + sh->gap_size, copy_sz - lower);
+	} else {
+		memcpy(buf, sh->data + spos->b_off + sh->gap_size, copy_sz);
+	}
 
-	memcpy(buf, spp, copy_sz);
 	buf[copy_sz] = '\0';
 
 	fpos->b_off = spos->b_off + copy_sz;
@@ -224,8 +339,18 @@ void sheet_get_cell_pt(sheet_t *sh, coord_t const *coord, enum dir_spec dir,
 	char32_t c;
 	coord_t cc;
 
-	cc.row = cc.column = 1;
-	cur_pos = prev_pos = 0;
+	/* Resume from the anchor when the target is not above it. */
+	if (coord->row > sh->anchor_row ||
+	    (coord->row == sh->anchor_row &&
+	    coord->column >= sh->anchor_col)) {
+		cc.row = sh->anchor_row;
+		cc.column = sh->anchor_col;
+		cur_pos = prev_pos = sh->anchor_off;
+	} else {
+		cc.row = cc.column = 1;
+		cur_pos = prev_pos = 0;
+	}
+
 	while (true) {
 		if (prev_pos >= sh->text_size) {
 			/* Cannot advance any further. */
@@ -240,7 +365,7 @@ void sheet_get_cell_pt(sheet_t *sh, coord_t const *coord, enum dir_spec dir,
 
 		prev_pos = cur_pos;
 
-		c = str_decode(sh->data, &cur_pos, sh->text_size);
+		c = sheet_decode(sh, &cur_pos);
 		if (c == '\n') {
 			++cc.row;
 			cc.column = 1;
@@ -273,16 +398,7 @@ void sheet_get_row_width(sheet_t *sh, int row, int *length)
 /** Get the number of rows in a sheet. */
 void sheet_get_num_rows(sheet_t *sh, int *rows)
 {
-	int cnt;
-	size_t bo;
-
-	cnt = 1;
-	for (bo = 0; bo < sh->dbuf_size; ++bo) {
-		if (sh->data[bo] == '\n')
-			cnt += 1;
-	}
-
-	*rows = cnt;
+	*rows = 1 + (int) sh->nlines;
 }
 
 /** Get the coordinates of an s-point. */
@@ -294,11 +410,19 @@ void spt_get_coord(spt_t const *pos, coord_t *coord)
 	sheet_t *sh;
 
 	sh = pos->sh;
-	cc.row = cc.column = 1;
 
-	off = 0;
+	/* Resume from the anchor when the point is not above it. */
+	if (pos->b_off >= sh->anchor_off) {
+		cc.row = sh->anchor_row;
+		cc.column = sh->anchor_col;
+		off = sh->anchor_off;
+	} else {
+		cc.row = cc.column = 1;
+		off = 0;
+	}
+
 	while (off < pos->b_off && off < sh->text_size) {
-		c = str_decode(sh->data, &off, sh->text_size);
+		c = sheet_decode(sh, &off);
 		if (c == '\n') {
 			++cc.row;
 			cc.column = 1;
@@ -309,6 +433,11 @@ void spt_get_coord(spt_t const *pos, coord_t *coord)
 		}
 	}
 
+	/* Leave the anchor here for the next query. */
+	sh->anchor_off = off;
+	sh->anchor_row = cc.row;
+	sh->anchor_col = cc.column;
+
 	*coord = cc;
 }
 
@@ -321,7 +450,13 @@ bool spt_equal(spt_t const *a, spt_t const *b)
 /** Get a character at spt and return next spt */
 char32_t spt_next_char(spt_t spt, spt_t *next)
 {
-	char32_t ch = str_decode(spt.sh->data, &spt.b_off, spt.sh->text_size);
+	char32_t ch;
+
+	if (spt.b_off >= spt.sh->text_size)
+		ch = '\0';
+	else
+		ch = sheet_decode(spt.sh, &spt.b_off);
+
 	if (next)
 		*next = spt;
 	return ch;
@@ -329,7 +464,17 @@ char32_t spt_next_char(spt_t spt, spt_t *next)
 
 char32_t spt_prev_char(spt_t spt, spt_t *prev)
 {
-	char32_t ch = str_decode_reverse(spt.sh->data, &spt.b_off, spt.sh->text_size);
+	char32_t ch;
+	sheet_t *sh = spt.sh;
+
+	if (spt.b_off <= sh->gap_off) {
+		ch = str_decode_reverse(sh->data, &spt.b_off, sh->gap_off);
+	} else {
+		size_t poff = spt.b_off + sh->gap_size;
+		ch = str_decode_reverse(sh->data, &poff, sh->dbuf_size);
+		spt.b_off = poff - sh->gap_size;
+	}
+
 	if (prev)
 		*prev = spt;
 	return ch;
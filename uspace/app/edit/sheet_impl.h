@@ -38,7 +38,14 @@
 
 #include "sheet.h"
 
-/** Sheet */
+/** Sheet
+ *
+ * The text is stored in a gap buffer: @c data holds the text with a
+ * movable gap of unused space at @c gap_off, so insertions and
+ * deletions at or near the last edit point only shuffle the gap,
+ * not the whole tail of the document. All offsets in the public
+ * interface are logical (gap-less) offsets.
+ */
 struct sheet {
 	/* Note: This structure is opaque for the user. */
 
@@ -46,6 +53,20 @@ struct sheet {
 	size_t dbuf_size;
 	char *data;
 
+	/** Logical offset of the gap */
+	size_t gap_off;
+	/** Size of the gap (dbuf_size - text_size) */
+	size_t gap_size;
+
+	/** Number of newlines in the text */
+	size_t nlines;
+
+	/** Coordinate anchor: a known offset/coordinate pair from
+	 * which mapping queries scan instead of from offset zero. */
+	size_t anchor_off;
+	int anchor_row;
+	int anchor_col;
+
 	list_t tags;
 };
 
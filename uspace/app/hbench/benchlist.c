@@ -43,8 +43,11 @@ benchmark_t *benchmarks[] = {
 	&benchmark_file_read,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_malloc3,
 	&benchmark_ns_ping,
-	&benchmark_ping_pong
+	&benchmark_ns_ping_n,
+	&benchmark_ping_pong,
+	&benchmark_stat_parallel
 };
 
 size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
@@ -33,12 +33,141 @@
  * @file
  */
 
+#include <adt/list.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <str.h>
 #include "hbench.h"
 
 static FILE *csv_output = NULL;
 
+/** Mean throughput of one benchmark loaded from a baseline CSV. */
+typedef struct {
+	link_t link;
+	char *name;
+	double thruput_sum;
+	size_t sample_count;
+} baseline_entry_t;
+
+static LIST_INITIALIZE(baseline_entries);
+
+static baseline_entry_t *baseline_find(const char *name)
+{
+	list_foreach(baseline_entries, link, baseline_entry_t, entry) {
+		if (str_cmp(entry->name, name) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/** Load a baseline from a CSV file produced by the -o option.
+ *
+ * Warm-up entries (negative run index) are skipped; the remaining
+ * entries accumulate into a per-benchmark mean throughput that
+ * summaries are later compared against.
+ *
+ * @param filename Baseline CSV.
+ * @return EOK on success or an error code.
+ */
+errno_t csv_baseline_load(const char *filename)
+{
+	char line[256];
+
+	FILE *input = fopen(filename, "r");
+	if (input == NULL)
+		return errno;
+
+	/* Skip the header line. */
+	if (fgets(line, sizeof(line), input) == NULL) {
+		fclose(input);
+		return EINVAL;
+	}
+
+	while (fgets(line, sizeof(line), input) != NULL) {
+		char *comma = str_chr(line, ',');
+		if (comma == NULL)
+			continue;
+		*comma = 0;
+
+		const char *cur = comma + 1;
+
+		/* Run index: skip warm-up lines. */
+		if (*cur == '-')
+			continue;
+
+		comma = str_chr(cur, ',');
+		if (comma == NULL)
+			continue;
+		cur = comma + 1;
+
+		uint64_t size;
+		if (str_uint64_t(cur, &cur, 10, false, &size) != EOK)
+			continue;
+		if (*cur != ',')
+			continue;
+
+		uint64_t duration;
+		if (str_uint64_t(cur + 1, NULL, 10, false, &duration) != EOK)
+			continue;
+		if (duration == 0)
+			continue;
+
+		baseline_entry_t *entry = baseline_find(line);
+		if (entry == NULL) {
+			entry = calloc(1, sizeof(baseline_entry_t));
+			if (entry == NULL)
+				break;
+
+			entry->name = str_dup(line);
+			if (entry->name == NULL) {
+				free(entry);
+				break;
+			}
+
+			link_initialize(&entry->link);
+			list_append(&entry->link, &baseline_entries);
+		}
+
+		entry->thruput_sum += (double) size * 1000000000.0 /
+		    (double) duration;
+		entry->sample_count++;
+	}
+
+	fclose(input);
+	return EOK;
+}
+
+/** Get the baseline mean throughput of a benchmark.
+ *
+ * @param name Benchmark name.
+ * @param thruput Place to store the throughput in ops/s.
+ * @return Whether the baseline contains the benchmark.
+ */
+bool csv_baseline_get(const char *name, double *thruput)
+{
+	baseline_entry_t *entry = baseline_find(name);
+	if ((entry == NULL) || (entry->sample_count == 0))
+		return false;
+
+	*thruput = entry->thruput_sum / entry->sample_count;
+	return true;
+}
+
+/** Release loaded baseline data. */
+void csv_baseline_free(void)
+{
+	link_t *link;
+
+	while ((link = list_first(&baseline_entries)) != NULL) {
+		baseline_entry_t *entry =
+		    list_get_instance(link, baseline_entry_t, link);
+		list_remove(link);
+		free(entry->name);
+		free(entry);
+	}
+}
+
 /** Open CSV benchmark report.
  *
  * @param filename Filename where to store the CSV.
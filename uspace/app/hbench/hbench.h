@@ -39,6 +39,7 @@
 #include <adt/hash_table.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <perf.h>
 
 #define DEFAULT_RUN_COUNT 10
@@ -98,8 +99,21 @@ typedef struct {
 } benchmark_t;
 
 extern void bench_run_init(bench_run_t *, char *, size_t);
+extern uint64_t bench_env_param_get_uint64(bench_env_t *, const char *,
+    uint64_t);
 extern bool bench_run_fail(bench_run_t *, const char *, ...);
 
+/** Per-worker body of a parallel benchmark.
+ *
+ * Receives the worker's share of the iterations and the opaque
+ * argument given to bench_run_workers(). Returns false to fail the
+ * whole run.
+ */
+typedef bool (*bench_worker_entry_t)(uint64_t, void *);
+
+extern bool bench_run_workers(bench_env_t *, bench_run_t *, uint64_t,
+    bench_worker_entry_t, void *, const char *);
+
 /*
  * We keep the following two functions inline to ensure that we start
  * measurement as close to the surrounding code as possible. Note that
@@ -122,6 +136,10 @@ extern errno_t csv_report_open(const char *);
 extern void csv_report_add_entry(bench_run_t *, int, benchmark_t *, uint64_t);
 extern void csv_report_close(void);
 
+extern errno_t csv_baseline_load(const char *);
+extern bool csv_baseline_get(const char *, double *);
+extern void csv_baseline_free(void);
+
 extern errno_t bench_env_init(bench_env_t *);
 extern errno_t bench_env_param_set(bench_env_t *, const char *, const char *);
 extern const char *bench_env_param_get(bench_env_t *, const char *, const char *);
@@ -136,8 +154,11 @@ extern benchmark_t benchmark_fibril_mutex;
 extern benchmark_t benchmark_file_read;
 extern benchmark_t benchmark_malloc1;
 extern benchmark_t benchmark_malloc2;
+extern benchmark_t benchmark_malloc3;
 extern benchmark_t benchmark_ns_ping;
+extern benchmark_t benchmark_ns_ping_n;
 extern benchmark_t benchmark_ping_pong;
+extern benchmark_t benchmark_stat_parallel;
 
 #endif
 
@@ -147,6 +147,16 @@ static void summary_stats(bench_run_t *runs, size_t run_count,
 	    "%.0f ops/s; Samples: %zu\n",
 	    workload_size, duration_avg / 1000.0, duration_sigma / 1000.0,
 	    thruput_avg * 1000000000.0, run_count);
+
+	double baseline_thruput;
+	if (csv_baseline_get(bench->name, &baseline_thruput)) {
+		double current = thruput_avg * 1000000000.0;
+		double change = (current - baseline_thruput) * 100.0 /
+		    baseline_thruput;
+
+		printf("Baseline: %.0f ops/s; change: %+.1f%%\n",
+		    baseline_thruput, change);
+	}
 }
 
 static bool run_benchmark(bench_env_t *env, benchmark_t *bench)
@@ -314,6 +324,8 @@ static void print_usage(const char *progname)
 	    "Set number of measured runs\n");
 	printf("-o, --output filename.csv  "
 	    "Store machine-readable data in filename.csv\n");
+	printf("-b, --baseline filename.csv  "
+	    "Compare against a previously stored run\n");
 	printf("-p, --param KEY=VALUE      "
 	    "Additional parameters for the benchmark\n");
 	printf("<benchmark> is one of the following:\n");
@@ -337,8 +349,9 @@ int main(int argc, char *argv[])
 		return -5;
 	}
 
-	const char *short_options = "ho:p:n:d:";
+	const char *short_options = "hb:o:p:n:d:";
 	struct option long_options[] = {
+		{ "baseline", required_argument, NULL, 'b' },
 		{ "duration", required_argument, NULL, 'd' },
 		{ "help", optional_argument, NULL, 'h' },
 		{ "count", required_argument, NULL, 'n' },
@@ -348,6 +361,7 @@ int main(int argc, char *argv[])
 	};
 
 	char *csv_output_filename = NULL;
+	char *csv_baseline_filename = NULL;
 
 	int opt = 0;
 	while ((opt = getopt_long(argc, argv, short_options, long_options, NULL)) > 0) {
@@ -371,6 +385,9 @@ int main(int argc, char *argv[])
 				return -3;
 			}
 			break;
+		case 'b':
+			csv_baseline_filename = optarg;
+			break;
 		case 'o':
 			csv_output_filename = optarg;
 			break;
@@ -400,6 +417,15 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	if (csv_baseline_filename != NULL) {
+		errno_t rc = csv_baseline_load(csv_baseline_filename);
+		if (rc != EOK) {
+			fprintf(stderr, "Failed to load baseline '%s': %s\n",
+			    csv_baseline_filename, str_error(rc));
+			return -4;
+		}
+	}
+
 	int exit_code = 0;
 
 	if (str_cmp(benchmark, "*") == 0) {
@@ -420,6 +446,7 @@ int main(int argc, char *argv[])
 	}
 
 	csv_report_close();
+	csv_baseline_free();
 	bench_env_cleanup(&bench_env);
 
 	return exit_code;
@@ -33,8 +33,12 @@
  * @file
  */
 
+#include <fibril.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
 #include "hbench.h"
 
 /** Initialize bench run structure.
@@ -75,5 +79,122 @@ bool bench_run_fail(bench_run_t *run, const char *fmt, ...)
 	return false;
 }
 
+/** Read an unsigned integer benchmark parameter.
+ *
+ * @param env Benchmark environment.
+ * @param key Parameter name.
+ * @param default_value Value to use when the parameter is not set or
+ *                      cannot be parsed.
+ * @return Parameter value.
+ */
+uint64_t bench_env_param_get_uint64(bench_env_t *env, const char *key,
+    uint64_t default_value)
+{
+	const char *str = bench_env_param_get(env, key, NULL);
+	if (str == NULL)
+		return default_value;
+
+	uint64_t value;
+	errno_t rc = str_uint64_t(str, NULL, 10, true, &value);
+	if (rc != EOK)
+		return default_value;
+
+	return value;
+}
+
+/** One slice of a parallel benchmark run */
+typedef struct {
+	bench_worker_entry_t func;
+	void *arg;
+	uint64_t iters;
+	atomic_size_t *remaining;
+	atomic_bool *failed;
+} bench_worker_t;
+
+static errno_t bench_worker_main(void *arg)
+{
+	bench_worker_t *worker = arg;
+
+	fibril_detach(fibril_get_id());
+
+	if (!worker->func(worker->iters, worker->arg))
+		atomic_store(worker->failed, true);
+
+	atomic_fetch_sub(worker->remaining, 1);
+
+	return EOK;
+}
+
+/** Run a benchmark body on a pool of concurrent worker fibrils.
+ *
+ * Splits @a size iterations among the fibrils (their number is set
+ * by the "workers" parameter, default 4) and measures the time from
+ * the first spawn until the last worker finishes. The caller should
+ * have called fibril_enable_multithreaded() in its setup hook so
+ * the workers actually run in parallel.
+ *
+ * @param env Benchmark environment.
+ * @param run Current benchmark run.
+ * @param size Total number of iterations.
+ * @param func Per-worker body; receives its share of the iterations.
+ * @param arg Opaque argument passed to every worker.
+ * @param fail_msg Error message to report when a worker fails.
+ * @retval true The run succeeded.
+ * @retval false The run failed (error message is filled in).
+ */
+bool bench_run_workers(bench_env_t *env, bench_run_t *run, uint64_t size,
+    bench_worker_entry_t func, void *arg, const char *fail_msg)
+{
+	uint64_t workers = bench_env_param_get_uint64(env, "workers", 4);
+	if (workers == 0)
+		return bench_run_fail(run, "workers must be positive");
+
+	bench_worker_t *work = calloc(workers, sizeof(bench_worker_t));
+	if (work == NULL)
+		return bench_run_fail(run, "failed allocating worker data");
+
+	atomic_size_t remaining;
+	atomic_bool failed;
+	atomic_store(&remaining, (size_t) workers);
+	atomic_store(&failed, false);
+
+	bool spawn_failed = false;
+
+	bench_run_start(run);
+
+	for (uint64_t i = 0; i < workers; i++) {
+		work[i].func = func;
+		work[i].arg = arg;
+		work[i].iters = size / workers + ((i == 0) ? size % workers : 0);
+		work[i].remaining = &remaining;
+		work[i].failed = &failed;
+
+		fid_t fid = fibril_create(bench_worker_main, &work[i]);
+		if (fid == 0) {
+			/* Account for the slots that never started. */
+			atomic_fetch_sub(&remaining, (size_t) (workers - i));
+			spawn_failed = true;
+			break;
+		}
+		fibril_add_ready(fid);
+	}
+
+	/* The spawned workers reference @c work; always wait them out. */
+	while (atomic_load(&remaining) > 0)
+		fibril_yield();
+
+	bench_run_stop(run);
+
+	free(work);
+
+	if (spawn_failed)
+		return bench_run_fail(run, "failed creating worker fibril");
+
+	if (atomic_load(&failed))
+		return bench_run_fail(run, "%s", fail_msg);
+
+	return true;
+}
+
 /** @}
  */
@@ -33,12 +33,13 @@
  * @file
  */
 
-#include <fibril.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <vfs/vfs.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
 #include <task.h>
 #include <stdlib.h>
 #include <macros.h>
@@ -414,6 +415,207 @@ error:
 	return rc;
 }
 
+/** One step of the startup dependency graph */
+typedef struct {
+	const char *name;
+	/** Service binary to start, or NULL when func is used */
+	const char *path;
+	/** Arbitrary step (mounts etc.) */
+	errno_t (*func)(void);
+	/** Names of steps that must complete first */
+	const char *deps[4];
+
+	bool disabled;
+	bool done;
+	errno_t rc;
+} init_step_t;
+
+static FIBRIL_MUTEX_INITIALIZE(graph_lock);
+static FIBRIL_CONDVAR_INITIALIZE(graph_cv);
+static size_t graph_remaining;
+
+static errno_t step_mount_locfs(void)
+{
+	return mount_locfs() ? EOK : EIO;
+}
+
+static errno_t step_mount_tmpfs(void)
+{
+	return mount_tmpfs() ? EOK : EIO;
+}
+
+static errno_t step_input(void)
+{
+	return srv_start("/srv/hid/input", HID_INPUT);
+}
+
+static errno_t step_output(void)
+{
+	return srv_start("/srv/hid/output", HID_OUTPUT);
+}
+
+/**
+ * The startup graph. Dependencies express ordering only; as in the
+ * sequential days, a failed service does not stop the rest of the
+ * boot (failures are logged by srv_startl()). Readiness of each
+ * service is signalled by its task return value, which
+ * srv_startl() already waits for. Keep the table in dependency
+ * order (dependencies above their dependents); run_graph() relies
+ * on it when a step has to run without a fibril of its own.
+ */
+static init_step_t steps[] = {
+	{ .name = "tmpfs-srv", .path = "/srv/fs/tmpfs" },
+	{ .name = "exfat-srv", .path = "/srv/fs/exfat" },
+	{ .name = "fat-srv", .path = "/srv/fs/fat" },
+	{ .name = "cdfs-srv", .path = "/srv/fs/cdfs" },
+	{ .name = "mfs-srv", .path = "/srv/fs/mfs" },
+
+	{ .name = "klog", .path = "/srv/klog" },
+	{ .name = "locfs-srv", .path = "/srv/fs/locfs" },
+	{ .name = "taskmon", .path = "/srv/taskmon" },
+
+	{ .name = "locfs", .func = step_mount_locfs,
+	    .deps = { "locfs-srv" } },
+	{ .name = "tmpfs", .func = step_mount_tmpfs,
+	    .deps = { "tmpfs-srv" } },
+
+	{ .name = "devman", .path = "/srv/devman", .deps = { "locfs" } },
+	{ .name = "s3c24xx_uart", .path = "/srv/hid/s3c24xx_uart",
+	    .deps = { "devman" } },
+	{ .name = "s3c24xx_ts", .path = "/srv/hid/s3c24xx_ts",
+	    .deps = { "devman" } },
+
+	{ .name = "vbd", .path = "/srv/bd/vbd", .deps = { "devman" } },
+	{ .name = "volsrv", .path = "/srv/volsrv", .deps = { "vbd" } },
+
+	{ .name = "loopip", .path = "/srv/net/loopip", .deps = { "locfs" } },
+	{ .name = "ethip", .path = "/srv/net/ethip", .deps = { "locfs" } },
+	{ .name = "inetsrv", .path = "/srv/net/inetsrv",
+	    .deps = { "locfs" } },
+	{ .name = "tcp", .path = "/srv/net/tcp", .deps = { "inetsrv" } },
+	{ .name = "udp", .path = "/srv/net/udp", .deps = { "inetsrv" } },
+	{ .name = "dnsrsrv", .path = "/srv/net/dnsrsrv", .deps = { "udp" } },
+	{ .name = "dhcp", .path = "/srv/net/dhcp", .deps = { "udp" } },
+	{ .name = "nconfsrv", .path = "/srv/net/nconfsrv",
+	    .deps = { "inetsrv" } },
+
+	{ .name = "clipboard", .path = "/srv/clipboard" },
+	{ .name = "pipesrv", .path = "/srv/pipesrv", .deps = { "locfs" } },
+	{ .name = "remcons", .path = "/srv/hid/remcons", .deps = { "tcp" } },
+
+	{ .name = "input", .func = step_input, .deps = { "locfs" } },
+	{ .name = "output", .func = step_output, .deps = { "locfs" } },
+	{ .name = "hound", .path = "/srv/audio/hound", .deps = { "devman" } },
+};
+
+#define STEP_COUNT  (sizeof(steps) / sizeof(steps[0]))
+
+static init_step_t *step_find(const char *name)
+{
+	size_t i;
+	for (i = 0; i < STEP_COUNT; i++) {
+		if (str_cmp(steps[i].name, name) == 0)
+			return &steps[i];
+	}
+
+	return NULL;
+}
+
+/** Whether all dependencies of a step completed. Graph lock held. */
+static bool step_ready(init_step_t *step)
+{
+	size_t i;
+	for (i = 0; i < sizeof(step->deps) / sizeof(step->deps[0]); i++) {
+		if (step->deps[i] == NULL)
+			break;
+
+		init_step_t *dep = step_find(step->deps[i]);
+		if (dep != NULL && !dep->done)
+			return false;
+	}
+
+	return true;
+}
+
+/** Fibril driving one step of the graph */
+static errno_t step_fibril(void *arg)
+{
+	init_step_t *step = (init_step_t *) arg;
+
+	fibril_mutex_lock(&graph_lock);
+	while (!step_ready(step))
+		fibril_condvar_wait(&graph_cv, &graph_lock);
+	fibril_mutex_unlock(&graph_lock);
+
+	if (step->path != NULL)
+		step->rc = srv_start(step->path);
+	else
+		step->rc = step->func();
+
+	fibril_mutex_lock(&graph_lock);
+	step->done = true;
+	graph_remaining--;
+	fibril_condvar_broadcast(&graph_cv);
+	fibril_mutex_unlock(&graph_lock);
+
+	return EOK;
+}
+
+/** Execute the whole startup graph with maximal parallelism */
+static void run_graph(void)
+{
+	size_t i;
+
+	fibril_mutex_lock(&graph_lock);
+	graph_remaining = 0;
+	for (i = 0; i < STEP_COUNT; i++) {
+		if (steps[i].disabled)
+			steps[i].done = true;
+		else
+			graph_remaining++;
+	}
+	fibril_mutex_unlock(&graph_lock);
+
+	/*
+	 * Create the fibrils for all steps before running anything
+	 * inline: an inline step blocks until its dependencies are
+	 * done, which must not happen while those dependencies still
+	 * wait for their fibrils to be created.
+	 */
+	bool inline_step[STEP_COUNT];
+
+	for (i = 0; i < STEP_COUNT; i++) {
+		inline_step[i] = false;
+
+		if (steps[i].disabled)
+			continue;
+
+		fid_t fid = fibril_create(step_fibril, &steps[i]);
+		if (fid == 0) {
+			inline_step[i] = true;
+			continue;
+		}
+
+		fibril_add_ready(fid);
+	}
+
+	/*
+	 * Leftovers without a fibril run right here. The steps table
+	 * is in dependency order, so an inline step's dependencies are
+	 * either inline steps already finished above it or fibrils
+	 * that make progress while step_fibril() waits.
+	 */
+	for (i = 0; i < STEP_COUNT; i++) {
+		if (inline_step[i])
+			step_fibril(&steps[i]);
+	}
+
+	fibril_mutex_lock(&graph_lock);
+	while (graph_remaining > 0)
+		fibril_condvar_wait(&graph_cv, &graph_lock);
+	fibril_mutex_unlock(&graph_lock);
+}
+
 int main(int argc, char *argv[])
 {
 	errno_t rc;
@@ -425,50 +627,21 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	/* Make sure file systems are running. */
-	if (str_cmp(STRING(RDFMT), "tmpfs") != 0)
-		srv_start("/srv/fs/tmpfs");
-	if (str_cmp(STRING(RDFMT), "exfat") != 0)
-		srv_start("/srv/fs/exfat");
-	if (str_cmp(STRING(RDFMT), "fat") != 0)
-		srv_start("/srv/fs/fat");
-	srv_start("/srv/fs/cdfs");
-	srv_start("/srv/fs/mfs");
-
-	srv_start("/srv/klog");
-	srv_start("/srv/fs/locfs");
-	srv_start("/srv/taskmon");
-
-	if (!mount_locfs()) {
+	/* The file system serving the root is already up. */
+	if (str_cmp(STRING(RDFMT), "tmpfs") == 0)
+		step_find("tmpfs-srv")->disabled = true;
+	if (str_cmp(STRING(RDFMT), "exfat") == 0)
+		step_find("exfat-srv")->disabled = true;
+	if (str_cmp(STRING(RDFMT), "fat") == 0)
+		step_find("fat-srv")->disabled = true;
+
+	run_graph();
+
+	if (step_find("locfs")->rc != EOK) {
 		printf("%s: Exiting\n", NAME);
 		return 2;
 	}
 
-	mount_tmpfs();
-
-	srv_start("/srv/devman");
-	srv_start("/srv/hid/s3c24xx_uart");
-	srv_start("/srv/hid/s3c24xx_ts");
-
-	srv_start("/srv/bd/vbd");
-	srv_start("/srv/volsrv");
-
-	srv_start("/srv/net/loopip");
-	srv_start("/srv/net/ethip");
-	srv_start("/srv/net/inetsrv");
-	srv_start("/srv/net/tcp");
-	srv_start("/srv/net/udp");
-	srv_start("/srv/net/dnsrsrv");
-	srv_start("/srv/net/dhcp");
-	srv_start("/srv/net/nconfsrv");
-
-	srv_start("/srv/clipboard");
-	srv_start("/srv/hid/remcons");
-
-	srv_start("/srv/hid/input", HID_INPUT);
-	srv_start("/srv/hid/output", HID_OUTPUT);
-	srv_start("/srv/audio/hound");
-
 	init_sysvol();
 
 #ifdef CONFIG_WINSYS
@@ -51,6 +51,7 @@
 #include <elf/elf_linux.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <errno.h>
@@ -58,6 +59,7 @@
 #include <mem.h>
 #include <as.h>
 #include <udebug.h>
+#include <vfs/aio.h>
 #include <macros.h>
 #include <libarch/istate.h>
 #include <vfs/vfs.h>
@@ -68,8 +70,13 @@
 static off64_t align_foff_up(off64_t, uintptr_t, size_t);
 static errno_t write_mem_area(int, aoff64_t *, as_area_info_t *, async_sess_t *);
 
-#define BUFFER_SIZE 0x1000
-static uint8_t buffer[BUFFER_SIZE];
+/*
+ * Memory is captured in large chunks (fewer debug calls) through
+ * two buffers: while one chunk is written out asynchronously, the
+ * next is already being read from the dumped task.
+ */
+#define BUFFER_SIZE 0x40000
+static uint8_t buffer[2][BUFFER_SIZE];
 
 /** Save ELF core file.
  *
@@ -299,27 +306,59 @@ static errno_t write_mem_area(int fd, aoff64_t *pos, as_area_info_t *area,
 	size_t total;
 	uintptr_t addr;
 	errno_t rc;
-	size_t nwr;
+	vfs_aio_req_t req;
+	bool pending = false;
+	unsigned cur = 0;
 
 	addr = area->start_addr;
 	total = 0;
 
 	while (total < area->size) {
 		to_copy = min(area->size - total, BUFFER_SIZE);
-		rc = udebug_mem_read(sess, buffer, addr, to_copy);
+		rc = udebug_mem_read(sess, buffer[cur], addr, to_copy);
 		if (rc != EOK) {
 			printf("Failed reading task memory.\n");
+			if (pending)
+				(void) vfs_aio_wait(&req);
 			return EIO;
 		}
 
-		rc = vfs_write(fd, pos, buffer, to_copy, &nwr);
+		/*
+		 * Wait for the previous chunk only now; its write
+		 * overlapped the read above.
+		 */
+		if (pending) {
+			rc = vfs_aio_wait(&req);
+			pending = false;
+			if ((rc == EOK) && (req.ntransferred != req.nbytes))
+				rc = EIO;
+			if (rc != EOK) {
+				printf("Failed writing memory contents.\n");
+				return EIO;
+			}
+		}
+
+		rc = vfs_aio_write(&req, fd, *pos, buffer[cur], to_copy);
 		if (rc != EOK) {
 			printf("Failed writing memory contents.\n");
 			return EIO;
 		}
+		pending = true;
 
+		*pos += to_copy;
 		addr += to_copy;
 		total += to_copy;
+		cur ^= 1;
+	}
+
+	if (pending) {
+		rc = vfs_aio_wait(&req);
+		if ((rc == EOK) && (req.ntransferred != req.nbytes))
+			rc = EIO;
+		if (rc != EOK) {
+			printf("Failed writing memory contents.\n");
+			return EIO;
+		}
 	}
 
 	return EOK;
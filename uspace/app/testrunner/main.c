@@ -26,15 +26,70 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/** @file
+ * Test runner with parallel scheduling.
+ *
+ * Tests run as independent tasks driven by a pool of worker
+ * fibrils, so the wall time of a run is bounded by the longest
+ * tests rather than the sum of them. Tests carrying the same
+ * serialization tag (i.e. exercising the same service) never run
+ * concurrently with each other. Per-test wall time is captured and
+ * the slowest tests are reported at the end.
+ */
+
+#include <adt/list.h>
 #include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <str_error.h>
 #include <task.h>
+#include <time.h>
 #include <vfs/vfs.h>
 #include <dirent.h>
 #include <str.h>
 
+/** Worker fibrils running tests concurrently */
+#define RUNNER_WORKERS  4
+
+/** Tests reported in the slowest-tests summary */
+#define RUNNER_SLOWEST  10
+
+/** One test to run */
+typedef struct {
+	link_t link;
+
+	char *name;
+	char *path;
+	char *arg;
+	char *logfile;
+	/** Tests with equal tags are serialized; NULL runs freely */
+	char *tag;
+
+	/* Results */
+	errno_t rc;
+	task_exit_t ex;
+	int retval;
+	nsec_t wall;
+} test_job_t;
+
+/** Serialization tag lock */
+typedef struct {
+	link_t link;
+	const char *tag;
+	fibril_mutex_t lock;
+} tag_lock_t;
+
+static LIST_INITIALIZE(jobs);
+static LIST_INITIALIZE(tag_locks);
+
+static FIBRIL_MUTEX_INITIALIZE(sched_lock);
+static FIBRIL_CONDVAR_INITIALIZE(sched_cv);
+static link_t *next_job = NULL;
+static size_t workers_running = 0;
+
 static errno_t run_test(const char *logfile, const char *logmode,
     const char *path, const char *const args[], task_exit_t *ex, int *retval)
 {
@@ -73,74 +128,231 @@ static errno_t run_test(const char *logfile, const char *logmode,
 		return rc;
 	}
 
-	// TODO: check that we are managing resources correctly
 	fclose(f);
 	return EOK;
 }
 
-static void run_tester(const char *logfile)
+/** Add a test to the schedule. Ownership of the strings is taken. */
+static void job_add(char *name, char *path, char *arg, char *logfile,
+    char *tag)
 {
-	const char *const tests[] = {
-		"thread1",
-		"setjmp1",
-		"print1",
-		"print2",
-		"print3",
-		"print4",
-		"print5",
-		"print6",
-		"stdio1",
-		"stdio2",
-		"logger1",
-		"fault1",
-		"fault2",
-		"fault3",
-		"float1",
-		"float2",
-		"vfs1",
-		"ping_pong",
-		"malloc1",
-		// FIXME: malloc2 doesn't work as expected
-		// "malloc2",
-		"malloc3",
-		"mapping1",
-		"pager1",
-		// "serial1",
-		// "chardev1",
-	};
+	test_job_t *job = calloc(1, sizeof(test_job_t));
+	if (job == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
 
-	int tests_count = sizeof(tests) / sizeof(const char *);
+	link_initialize(&job->link);
+	job->name = name;
+	job->path = path;
+	job->arg = arg;
+	job->logfile = logfile;
+	job->tag = tag;
+	job->rc = EOK;
 
-	task_exit_t ex;
-	int retval;
-	int failed = 0;
+	list_append(&job->link, &jobs);
+}
 
-	const char *app = "/app/tester";
+/** Get the lock serializing a tag, creating it on first use */
+static tag_lock_t *tag_lock_get(const char *tag)
+{
+	list_foreach(tag_locks, link, tag_lock_t, tl) {
+		if (str_cmp(tl->tag, tag) == 0)
+			return tl;
+	}
 
-	for (int i = 0; i < tests_count; i++) {
-		const char *const args[] = { app, tests[i], NULL };
-		errno_t rc = run_test(logfile, "a", app, args, &ex, &retval);
-		if (rc != EOK) {
-			/* Reason already printed in run_test(). */
+	tag_lock_t *tl = calloc(1, sizeof(tag_lock_t));
+	if (tl == NULL)
+		return NULL;
+
+	link_initialize(&tl->link);
+	tl->tag = tag;
+	fibril_mutex_initialize(&tl->lock);
+	list_append(&tl->link, &tag_locks);
+
+	return tl;
+}
+
+/** Run one test, timing it */
+static void job_run(test_job_t *job)
+{
+	const char *const args[] = { job->path, job->arg, NULL };
+
+	struct timespec start;
+	struct timespec end;
+
+	getuptime(&start);
+	job->rc = run_test(job->logfile, "w", job->path, args, &job->ex,
+	    &job->retval);
+	getuptime(&end);
+
+	job->wall = ts_sub_diff(&end, &start);
+}
+
+/** Worker fibril: claim and run jobs until the schedule drains */
+static errno_t runner_fibril(void *arg)
+{
+	while (true) {
+		fibril_mutex_lock(&sched_lock);
+		if (next_job == NULL) {
+			workers_running--;
+			fibril_condvar_signal(&sched_cv);
+			fibril_mutex_unlock(&sched_lock);
+			return EOK;
+		}
+
+		test_job_t *job = list_get_instance(next_job, test_job_t,
+		    link);
+		next_job = (next_job == list_last(&jobs)) ? NULL :
+		    next_job->next;
+
+		tag_lock_t *tl = (job->tag != NULL) ?
+		    tag_lock_get(job->tag) : NULL;
+		fibril_mutex_unlock(&sched_lock);
+
+		/* Tests touching the same service must serialize. */
+		if (tl != NULL)
+			fibril_mutex_lock(&tl->lock);
+
+		job_run(job);
+
+		if (tl != NULL)
+			fibril_mutex_unlock(&tl->lock);
+	}
+}
+
+/** Run all scheduled jobs and report the outcome */
+static int run_jobs(void)
+{
+	fibril_mutex_lock(&sched_lock);
+	next_job = list_first(&jobs);
+	workers_running = RUNNER_WORKERS;
+	fibril_mutex_unlock(&sched_lock);
+
+	size_t i;
+	for (i = 1; i < RUNNER_WORKERS; i++) {
+		fid_t fid = fibril_create(runner_fibril, NULL);
+		if (fid == 0) {
+			/* Unfilled worker slot */
+			fibril_mutex_lock(&sched_lock);
+			workers_running--;
+			fibril_mutex_unlock(&sched_lock);
 			continue;
 		}
 
-		if (ex != TASK_EXIT_NORMAL) {
-			fprintf(stderr, "tester %s CRASHED\n",
-			    tests[i]);
+		fibril_add_ready(fid);
+	}
+
+	/* Work the schedule ourselves as well. */
+	runner_fibril(NULL);
+
+	fibril_mutex_lock(&sched_lock);
+	while (workers_running > 0)
+		fibril_condvar_wait(&sched_cv, &sched_lock);
+	fibril_mutex_unlock(&sched_lock);
+
+	/* Report in schedule order. */
+	int failed = 0;
+	list_foreach(jobs, link, test_job_t, job) {
+		if (job->rc != EOK) {
+			/* Reason already printed in run_test(). */
 			failed++;
 			continue;
 		}
 
-		if (retval == 0) {
-			printf("tester %s ok\n", tests[i]);
+		if (job->ex != TASK_EXIT_NORMAL) {
+			fprintf(stderr, "%s CRASHED\n", job->name);
+			failed++;
+		} else if (job->retval == 0) {
+			printf("%s ok (%lld ms)\n", job->name,
+			    NSEC2MSEC(job->wall));
 		} else {
-			printf("tester %s FAILED\n", tests[i]);
+			printf("%s FAILED (%lld ms)\n", job->name,
+			    NSEC2MSEC(job->wall));
 			failed++;
 		}
 	}
 
-	printf("tester: %d failed tests\n", failed);
+	/* Slowest tests first; these are the ones worth attacking. */
+	printf("Slowest tests:\n");
+	for (i = 0; i < RUNNER_SLOWEST; i++) {
+		test_job_t *slowest = NULL;
+
+		list_foreach(jobs, link, test_job_t, job) {
+			if (job->wall < 0)
+				continue;
+			if (slowest == NULL || job->wall > slowest->wall)
+				slowest = job;
+		}
+
+		if (slowest == NULL)
+			break;
+
+		printf("  %s: %lld ms\n", slowest->name,
+		    NSEC2MSEC(slowest->wall));
+		slowest->wall = -1;
+	}
+
+	return failed;
+}
+
+/** Schedule the classic tester tests.
+ *
+ * Tests sharing a service carry its serialization tag; the rest
+ * run in parallel with anything.
+ */
+static void sched_tester(void)
+{
+	static const struct {
+		const char *name;
+		const char *tag;
+	} tests[] = {
+		{ "thread1", NULL },
+		{ "setjmp1", NULL },
+		{ "print1", "console" },
+		{ "print2", "console" },
+		{ "print3", "console" },
+		{ "print4", "console" },
+		{ "print5", "console" },
+		{ "print6", "console" },
+		{ "stdio1", "vfs" },
+		{ "stdio2", "vfs" },
+		{ "logger1", "logger" },
+		{ "fault1", NULL },
+		{ "fault2", NULL },
+		{ "fault3", NULL },
+		{ "float1", NULL },
+		{ "float2", NULL },
+		{ "vfs1", "vfs" },
+		{ "ping_pong", NULL },
+		{ "malloc1", NULL },
+		// FIXME: malloc2 doesn't work as expected
+		// { "malloc2", NULL },
+		{ "malloc3", NULL },
+		{ "mapping1", NULL },
+		{ "pager1", NULL },
+		// { "serial1", NULL },
+		// { "chardev1", NULL },
+	};
+
+	size_t count = sizeof(tests) / sizeof(tests[0]);
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		char *name;
+		char *logfile;
+
+		if (asprintf(&name, "tester %s", tests[i].name) < 0 ||
+		    asprintf(&logfile, "/data/web/result-tester-%s.txt",
+		    tests[i].name) < 0) {
+			fprintf(stderr, "out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		job_add(name, str_dup("/app/tester"),
+		    str_dup(tests[i].name), logfile,
+		    (tests[i].tag != NULL) ? str_dup(tests[i].tag) : NULL);
+	}
 }
 
 static void run_tester_fault(const char *logfile)
@@ -165,10 +377,14 @@ static void run_tester_fault(const char *logfile)
 	printf("`tester fault1`: terminated as expected\n");
 }
 
-static void run_pcut_tests(void)
+/** Schedule all pcut tests.
+ *
+ * The component name after the test- prefix (up to the next dash)
+ * doubles as the serialization tag, so suites exercising the same
+ * subsystem do not race each other.
+ */
+static void sched_pcut_tests(void)
 {
-	printf("Running all pcut tests...\n");
-
 	DIR *d = opendir("/test");
 	if (!d)
 		return;
@@ -179,41 +395,26 @@ static void run_pcut_tests(void)
 		if (str_lcmp(e->d_name, "test-", 5) != 0)
 			continue;
 
-		task_exit_t ex;
-		int retval;
-
+		char *name = str_dup(e->d_name);
 		char *bin;
-		if (asprintf(&bin, "/test/%s", e->d_name) < 0) {
-			fprintf(stderr, "out of memory\n");
-			exit(EXIT_FAILURE);
-		}
-
 		char *logfile;
-		if (asprintf(&logfile, "/data/web/result-%s.txt", e->d_name) < 0) {
+
+		if (name == NULL ||
+		    asprintf(&bin, "/test/%s", e->d_name) < 0 ||
+		    asprintf(&logfile, "/data/web/result-%s.txt",
+		    e->d_name) < 0) {
 			fprintf(stderr, "out of memory\n");
 			exit(EXIT_FAILURE);
 		}
 
-		const char *const args[] = { bin, NULL };
-		errno_t rc = run_test(logfile, "w", bin, args, &ex, &retval);
-		free(bin);
-		free(logfile);
-
-		if (rc != EOK) {
-			/* Reason already printed in run_test(). */
-			return;
-		}
-
-		if (ex != TASK_EXIT_NORMAL) {
-			fprintf(stderr, "%s CRASHED\n", e->d_name);
-			return;
+		char *tag = str_dup(e->d_name + 5);
+		if (tag != NULL) {
+			char *dash = str_chr(tag, '-');
+			if (dash != NULL)
+				*dash = '\0';
 		}
 
-		if (retval == 0) {
-			printf("%s ok\n", e->d_name);
-		} else {
-			printf("%s FAILED\n", e->d_name);
-		}
+		job_add(name, bin, NULL, logfile, tag);
 	}
 
 	closedir(d);
@@ -232,19 +433,12 @@ static void gen_index(const char *fname)
 	    "</title></head><body>\n");
 	fprintf(f, "<h1>HelenOS test results</h1><ul>\n");
 
-	fprintf(f, "<li><a href=\"result-tester.txt\">tester</a></li>\n");
-
-	DIR *d = opendir("/test");
-	if (d) {
-		struct dirent *e;
-
-		while ((e = readdir(d))) {
-			if (str_lcmp(e->d_name, "test-", 5) != 0)
-				continue;
+	list_foreach(jobs, link, test_job_t, job) {
+		const char *base = str_rchr(job->logfile, '/');
+		base = (base != NULL) ? base + 1 : job->logfile;
 
-			fprintf(f, "<li><a href=\"result-%s.txt\">%s"
-			    "</a></li>\n", e->d_name, e->d_name);
-		}
+		fprintf(f, "<li><a href=\"%s\">%s</a></li>\n", base,
+		    job->name);
 	}
 
 	fprintf(f, "</ul></body></html>\n");
@@ -253,9 +447,13 @@ static void gen_index(const char *fname)
 
 int main(int argc, char **argv)
 {
-	run_tester("/data/web/result-tester.txt");
+	sched_tester();
+	sched_pcut_tests();
+
+	int failed = run_jobs();
+	printf("testrunner: %d failed tests\n", failed);
+
 	run_tester_fault("/tmp/tester_fault.log");
-	run_pcut_tests();
 
 	const char *fname = "/data/web/test.html";
 	printf("Generating HTML report in %s\n", fname);
@@ -35,6 +35,7 @@
  * @file
  */
 
+#include <mem.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <task.h>
@@ -68,6 +69,7 @@ static const column_t task_columns[] = {
 	{ "%virt",    'V',  7 },
 	{ "%user",    'U',  7 },
 	{ "%kern",    'K',  7 },
+	{ "trend",    'T',  9 },
 	{ "name",     'd',  0 },
 };
 
@@ -80,6 +82,7 @@ enum {
 	TASK_COL_PERCENT_VIRTUAL,
 	TASK_COL_PERCENT_USER,
 	TASK_COL_PERCENT_KERNEL,
+	TASK_COL_TREND,
 	TASK_COL_NAME,
 	TASK_NUM_COLUMNS,
 };
@@ -130,6 +133,195 @@ static size_t sort_column = TASK_COL_PERCENT_USER;
 static int sort_reverse = -1;
 static bool excs_all = false;
 
+/** Length of the per-task CPU trend sparkline */
+#define HISTORY_LEN  8
+
+/** Ring of the last HISTORY_LEN CPU share samples of one task */
+typedef struct {
+	task_id_t task_id;
+	uint8_t samples[HISTORY_LEN];
+	char spark[HISTORY_LEN + 1];
+	bool seen;
+} task_history_t;
+
+static task_history_t *history = NULL;
+static size_t history_count = 0;
+static size_t history_cap = 0;
+
+/** Sample log appended to with the -o option */
+static FILE *export_file = NULL;
+
+#define EXPORT_MAGIC  UINT32_C(0x30504f54)  /* "TOP0" */
+
+typedef struct {
+	uint32_t magic;
+	uint32_t task_count;
+	uint64_t uptime_sec;
+} __attribute__((packed)) export_sample_t;
+
+typedef struct {
+	uint64_t task_id;
+	uint64_t virtmem;
+	uint64_t resmem;
+	uint64_t ucycles_diff;
+	uint64_t kcycles_diff;
+} __attribute__((packed)) export_task_t;
+
+/** Sparkline glyphs from idle to saturated */
+static const char spark_chars[] = " .:-=+*#@";
+
+static task_history_t *history_get(task_id_t task_id)
+{
+	size_t i;
+	for (i = 0; i < history_count; i++) {
+		if (history[i].task_id == task_id)
+			return &history[i];
+	}
+
+	if (history_count == history_cap) {
+		size_t cap = (history_cap > 0) ? (2 * history_cap) : 16;
+		task_history_t *nhist =
+		    realloc(history, cap * sizeof(task_history_t));
+		if (nhist == NULL)
+			return NULL;
+
+		history = nhist;
+		history_cap = cap;
+	}
+
+	task_history_t *hist = &history[history_count++];
+	memset(hist, 0, sizeof(task_history_t));
+	hist->task_id = task_id;
+	return hist;
+}
+
+/** Append this interval's CPU shares to the task history rings */
+static void update_history(data_t *data)
+{
+	uint64_t total = 0;
+	size_t i;
+
+	for (i = 0; i < data->tasks_count; i++)
+		total += data->ucycles_diff[i] + data->kcycles_diff[i];
+
+	for (i = 0; i < history_count; i++)
+		history[i].seen = false;
+
+	for (i = 0; i < data->tasks_count; i++) {
+		task_history_t *hist = history_get(data->tasks[i].task_id);
+		if (hist == NULL)
+			return;
+
+		hist->seen = true;
+
+		uint8_t pct = 0;
+		if (total > 0) {
+			pct = (uint8_t) ((data->ucycles_diff[i] +
+			    data->kcycles_diff[i]) * 100 / total);
+		}
+
+		memmove(hist->samples, hist->samples + 1, HISTORY_LEN - 1);
+		hist->samples[HISTORY_LEN - 1] = pct;
+
+		size_t j;
+		for (j = 0; j < HISTORY_LEN; j++) {
+			size_t level = hist->samples[j] *
+			    (sizeof(spark_chars) - 2) / 100;
+			hist->spark[j] = spark_chars[level];
+		}
+		hist->spark[HISTORY_LEN] = '\0';
+	}
+
+	/* Forget tasks that have gone away. */
+	for (i = 0; i < history_count; i++) {
+		if (!history[i].seen) {
+			history[i] = history[history_count - 1];
+			history_count--;
+			i--;
+		}
+	}
+}
+
+static const char *history_trend(task_id_t task_id)
+{
+	size_t i;
+	for (i = 0; i < history_count; i++) {
+		if (history[i].task_id == task_id)
+			return history[i].spark;
+	}
+
+	return "";
+}
+
+/** Append one binary sample record for offline capacity planning */
+static void export_sample(data_t *data)
+{
+	export_sample_t sample = {
+		.magic = EXPORT_MAGIC,
+		.task_count = (uint32_t) data->tasks_count,
+		.uptime_sec = (uint64_t) data->udays * DAY +
+		    data->uhours * HOUR + data->uminutes * MINUTE +
+		    data->useconds
+	};
+
+	if (fwrite(&sample, sizeof(sample), 1, export_file) != 1)
+		return;
+
+	size_t i;
+	for (i = 0; i < data->tasks_count; i++) {
+		export_task_t rec = {
+			.task_id = data->tasks[i].task_id,
+			.virtmem = data->tasks[i].virtmem,
+			.resmem = data->tasks[i].resmem,
+			.ucycles_diff = data->ucycles_diff[i],
+			.kcycles_diff = data->kcycles_diff[i]
+		};
+
+		if (fwrite(&rec, sizeof(rec), 1, export_file) != 1)
+			return;
+	}
+
+	fflush(export_file);
+}
+
+/** Sorted (id, position) index for delta matching */
+typedef struct {
+	uint64_t id;
+	size_t idx;
+} id_index_t;
+
+static int id_index_cmp(void *a, void *b, void *arg)
+{
+	uint64_t ida = ((id_index_t *) a)->id;
+	uint64_t idb = ((id_index_t *) b)->id;
+
+	if (ida > idb)
+		return 1;
+	if (ida < idb)
+		return -1;
+	return 0;
+}
+
+/** Find an entry in a sorted id index; (size_t) -1 when not present */
+static size_t id_index_find(id_index_t *index, size_t count, uint64_t id)
+{
+	size_t lo = 0;
+	size_t hi = count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (index[mid].id == id)
+			return index[mid].idx;
+		if (index[mid].id < id)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return (size_t) -1;
+}
+
 static const char *read_data(data_t *target)
 {
 	/* Initialize data */
@@ -270,19 +462,33 @@ static void compute_percentages(data_t *old_data, data_t *new_data)
 	uint64_t ucycles_total = 0;
 	uint64_t kcycles_total = 0;
 
+	/*
+	 * Match tasks with their previous instances through a sorted
+	 * index instead of rescanning the whole old table per task.
+	 */
+	id_index_t *task_index = calloc(old_data->tasks_count,
+	    sizeof(id_index_t));
+
+	if (task_index != NULL) {
+		for (i = 0; i < old_data->tasks_count; i++) {
+			task_index[i].id = old_data->tasks[i].task_id;
+			task_index[i].idx = i;
+		}
+
+		gsort(task_index, old_data->tasks_count, sizeof(id_index_t),
+		    id_index_cmp, NULL);
+	}
+
 	for (i = 0; i < new_data->tasks_count; i++) {
 		/* Match task with the previous instance */
 
-		bool found = false;
-		size_t j;
-		for (j = 0; j < old_data->tasks_count; j++) {
-			if (new_data->tasks[i].task_id == old_data->tasks[j].task_id) {
-				found = true;
-				break;
-			}
+		size_t j = (size_t) -1;
+		if (task_index != NULL) {
+			j = id_index_find(task_index, old_data->tasks_count,
+			    new_data->tasks[i].task_id);
 		}
 
-		if (!found) {
+		if (j == (size_t) -1) {
 			/* This is newly borned task, ignore it */
 			new_data->ucycles_diff[i] = 0;
 			new_data->kcycles_diff[i] = 0;
@@ -300,6 +506,8 @@ static void compute_percentages(data_t *old_data, data_t *new_data)
 		kcycles_total += new_data->kcycles_diff[i];
 	}
 
+	free(task_index);
+
 	/* For each task compute percential change */
 
 	for (i = 0; i < new_data->tasks_count; i++) {
@@ -344,7 +552,7 @@ static void compute_percentages(data_t *old_data, data_t *new_data)
 		new_data->ecycles_diff[i] =
 		    new_data->exceptions[i].cycles - old_data->exceptions[j].cycles;
 		new_data->ecount_diff[i] =
-		    new_data->exceptions[i].count - old_data->exceptions[i].count;
+		    new_data->exceptions[i].count - old_data->exceptions[j].count;
 
 		ecycles_total += new_data->ecycles_diff[i];
 		ecount_total += new_data->ecount_diff[i];
@@ -437,6 +645,8 @@ static const char *fill_task_table(data_t *data)
 		field[TASK_COL_PERCENT_USER].fixed = perc->ucycles;
 		field[TASK_COL_PERCENT_KERNEL].type = FIELD_PERCENT;
 		field[TASK_COL_PERCENT_KERNEL].fixed = perc->kcycles;
+		field[TASK_COL_TREND].type = FIELD_STRING;
+		field[TASK_COL_TREND].string = history_trend(task->task_id);
 		field[TASK_COL_NAME].type = FIELD_STRING;
 		field[TASK_COL_NAME].string = task->name;
 		field += TASK_NUM_COLUMNS;
@@ -585,6 +795,18 @@ int main(int argc, char *argv[])
 	errno_t rc;
 	int c;
 
+	if ((argc == 3) && (str_cmp(argv[1], "-o") == 0)) {
+		export_file = fopen(argv[2], "ab");
+		if (export_file == NULL) {
+			fprintf(stderr, "%s: Cannot open %s for appending\n",
+			    NAME, argv[2]);
+			return 1;
+		}
+	} else if (argc != 1) {
+		fprintf(stderr, "Usage: %s [-o sample-log]\n", NAME);
+		return 1;
+	}
+
 	screen_init();
 	printf("Reading initial data...\n");
 
@@ -593,6 +815,7 @@ int main(int argc, char *argv[])
 
 	/* Compute some rubbish to have initialised values */
 	compute_percentages(&data, &data);
+	update_history(&data);
 
 	/* And paint screen until death */
 	while (true) {
@@ -608,6 +831,10 @@ int main(int argc, char *argv[])
 			compute_percentages(&data_prev, &data);
 			free_data(&data_prev);
 
+			update_history(&data);
+			if (export_file != NULL)
+				export_sample(&data);
+
 			c = -1;
 		} else if (rc != EOK) {
 			/* Error (e.g. communication with console lost) */
@@ -682,6 +909,9 @@ out:
 	screen_done();
 	free_data(&data);
 
+	if (export_file != NULL)
+		fclose(export_file);
+
 	if (ret != NULL) {
 		fprintf(stderr, "%s: %s\n", NAME, ret);
 		return 1;
@@ -46,6 +46,7 @@ const sc_desc_t syscall_desc[] = {
 	[SYS_THREAD_GET_ID] = { "thread_get_id", 1, V_ERRNO },
 	[SYS_THREAD_USLEEP] = { "thread_usleep", 1, V_ERRNO },
 	[SYS_THREAD_UDELAY] = { "thread_udelay", 1, V_ERRNO },
+	[SYS_THREAD_SET_REALTIME] = { "thread_set_realtime", 1, V_ERRNO },
 
 	[SYS_TASK_GET_ID] = { "task_get_id", 1, V_ERRNO },
 	[SYS_TASK_SET_NAME] = { "task_set_name", 2, V_ERRNO },
@@ -73,6 +74,7 @@ const sc_desc_t syscall_desc[] = {
 	/* IPC related syscalls. */
 	[SYS_IPC_CALL_ASYNC_FAST] = { "ipc_call_async_fast", 6, V_HASH },
 	[SYS_IPC_CALL_ASYNC_SLOW] = { "ipc_call_async_slow", 3, V_HASH },
+	[SYS_IPC_CALL_ASYNC_BATCH] = { "ipc_call_async_batch", 4, V_ERRNO },
 	[SYS_IPC_ANSWER_FAST] = { "ipc_answer_fast", 6, V_ERRNO },
 	[SYS_IPC_ANSWER_SLOW] = { "ipc_answer_slow", 2, V_ERRNO },
 	[SYS_IPC_FORWARD_FAST] = { "ipc_forward_fast", 6, V_ERRNO },
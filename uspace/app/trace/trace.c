@@ -168,6 +168,30 @@ static errno_t connect_task(task_id_t task_id)
 		return rc;
 	}
 
+	/*
+	 * When individual system calls are not displayed, only the IPC
+	 * calls decoded by the protocol tracer are of interest. Filter
+	 * the rest out in the kernel so the task does not stop for
+	 * events that would be thrown away; failure just means every
+	 * event is delivered, as before.
+	 */
+	if ((display_mask & DM_SYSCALL) == 0) {
+		static const unsigned ipc_scs[] = {
+			SYS_IPC_CALL_ASYNC_FAST, SYS_IPC_CALL_ASYNC_SLOW,
+			SYS_IPC_WAIT
+		};
+		uint8_t sc_mask[(SYSCALL_END + 7) / 8];
+		unsigned i;
+
+		memset(sc_mask, 0, sizeof(sc_mask));
+		for (i = 0; i < sizeof(ipc_scs) / sizeof(ipc_scs[0]); i++)
+			sc_mask[ipc_scs[i] / 8] |= 1 << (ipc_scs[i] % 8);
+
+		(void) udebug_set_sysmask(sess, sc_mask, sizeof(sc_mask));
+	} else {
+		(void) udebug_set_sysmask(sess, NULL, 0);
+	}
+
 	return EOK;
 error:
 	if (wait_set_up)
@@ -35,6 +35,9 @@
 
 #include <errno.h>
 #include <assert.h>
+#include <fibril_synch.h>
+#include <libarch/config.h>
+#include <malloc.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -62,6 +65,21 @@
 /** Buffer for receiving the request. */
 #define BUFFER_SIZE  1024
 
+/**
+ * Buffer for streaming file contents. Page-aligned and a multiple
+ * of the page size so the sends take the pinned zero-copy path to
+ * the TCP server instead of being bounced through a kernel buffer.
+ */
+#define SEND_BUFFER_SIZE  (8 * PAGE_SIZE)
+
+/**
+ * Cap on concurrently serviced connections. Connections over the
+ * limit are accepted by TCP but their fibrils wait their turn
+ * before the request is read, so the clients see backpressure
+ * (filling receive windows) rather than resets.
+ */
+#define MAX_CONNECTIONS  32
+
 static void websrv_new_conn(tcp_listener_t *, tcp_conn_t *);
 
 static tcp_listen_cb_t listen_cb = {
@@ -83,18 +101,20 @@ typedef struct {
 
 	char lbuf[BUFFER_SIZE + 1];
 	size_t lbuf_used;
+
+	/** File streaming buffer (page-aligned). */
+	char *fbuf;
 } recv_t;
 
 static bool verbose = false;
 
-/** Responses to send to client. */
+static FIBRIL_SEMAPHORE_INITIALIZE(conn_sem, MAX_CONNECTIONS);
 
-static const char *msg_ok =
-    "HTTP/1.0 200 OK\r\n"
-    "\r\n";
+/** Responses to send to client. */
 
 static const char *msg_bad_request =
-    "HTTP/1.0 400 Bad Request\r\n"
+    "HTTP/1.1 400 Bad Request\r\n"
+    "Connection: close\r\n"
     "\r\n"
     "<!DOCTYPE HTML PUBLIC \"-//IETF//DTD HTML 2.0//EN\">\r\n"
     "<html><head>\r\n"
@@ -107,7 +127,8 @@ static const char *msg_bad_request =
     "</html>\r\n";
 
 static const char *msg_not_found =
-    "HTTP/1.0 404 Not Found\r\n"
+    "HTTP/1.1 404 Not Found\r\n"
+    "Connection: close\r\n"
     "\r\n"
     "<!DOCTYPE HTML PUBLIC \"-//IETF//DTD HTML 2.0//EN\">\r\n"
     "<html><head>\r\n"
@@ -120,7 +141,8 @@ static const char *msg_not_found =
     "</html>\r\n";
 
 static const char *msg_not_implemented =
-    "HTTP/1.0 501 Not Implemented\r\n"
+    "HTTP/1.1 501 Not Implemented\r\n"
+    "Connection: close\r\n"
     "\r\n"
     "<!DOCTYPE HTML PUBLIC \"-//IETF//DTD HTML 2.0//EN\">\r\n"
     "<html><head>\r\n"
@@ -140,6 +162,12 @@ static errno_t recv_create(tcp_conn_t *conn, recv_t **rrecv)
 	if (recv == NULL)
 		return ENOMEM;
 
+	recv->fbuf = memalign(PAGE_SIZE, SEND_BUFFER_SIZE);
+	if (recv->fbuf == NULL) {
+		free(recv);
+		return ENOMEM;
+	}
+
 	recv->conn = conn;
 	recv->rbuf_out = 0;
 	recv->rbuf_in = 0;
@@ -151,6 +179,8 @@ static errno_t recv_create(tcp_conn_t *conn, recv_t **rrecv)
 
 static void recv_destroy(recv_t *recv)
 {
+	if (recv != NULL)
+		free(recv->fbuf);
 	free(recv);
 }
 
@@ -166,7 +196,11 @@ static errno_t recv_char(recv_t *recv, char *c)
 
 		rc = tcp_conn_recv_wait(recv->conn, recv->rbuf, BUFFER_SIZE, &nrecv);
 		if (rc != EOK) {
-			fprintf(stderr, "tcp_conn_recv() failed: %s\n", str_error(rc));
+			/* Reached routinely when a keep-alive peer hangs up. */
+			if (verbose) {
+				fprintf(stderr, "tcp_conn_recv() failed: %s\n",
+				    str_error(rc));
+			}
 			return rc;
 		}
 
@@ -240,20 +274,15 @@ static errno_t send_response(tcp_conn_t *conn, const char *msg)
 	return EOK;
 }
 
-static errno_t uri_get(const char *uri, tcp_conn_t *conn)
+static errno_t uri_get(const char *uri, recv_t *recv, bool *keep_alive)
 {
-	char *fbuf = NULL;
+	tcp_conn_t *conn = recv->conn;
+	char *hdr = NULL;
 	char *fname = NULL;
 	errno_t rc;
 	size_t nr;
 	int fd = -1;
 
-	fbuf = calloc(BUFFER_SIZE, 1);
-	if (fbuf == NULL) {
-		rc = ENOMEM;
-		goto out;
-	}
-
 	if (str_cmp(uri, "/") == 0)
 		uri = "/index.html";
 
@@ -264,6 +293,8 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 
 	rc = vfs_lookup_open(fname, WALK_REGULAR, MODE_READ, &fd);
 	if (rc != EOK) {
+		/* The 404 body is delimited by the connection close. */
+		*keep_alive = false;
 		rc = send_response(conn, msg_not_found);
 		goto out;
 	}
@@ -271,20 +302,47 @@ static errno_t uri_get(const char *uri, tcp_conn_t *conn)
 	free(fname);
 	fname = NULL;
 
-	rc = send_response(conn, msg_ok);
+	/*
+	 * Keep-alive framing needs a Content-Length, which also
+	 * spares HTTP/1.1 clients waiting for the connection to
+	 * close.
+	 */
+	vfs_stat_t stat;
+	rc = vfs_stat(fd, &stat);
+	if (rc != EOK) {
+		*keep_alive = false;
+		rc = send_response(conn, msg_not_found);
+		goto out;
+	}
+
+	if (asprintf(&hdr, "HTTP/1.1 200 OK\r\n"
+	    "Content-Length: %" PRIu64 "\r\n"
+	    "Connection: %s\r\n"
+	    "\r\n", stat.size,
+	    *keep_alive ? "keep-alive" : "close") < 0) {
+		rc = ENOMEM;
+		goto out;
+	}
+
+	rc = send_response(conn, hdr);
 	if (rc != EOK)
 		goto out;
 
+	/*
+	 * Stream the file through the page-aligned buffer; these
+	 * sends are large enough to be pinned by the kernel and
+	 * handed to the TCP server without a bounce copy.
+	 */
 	aoff64_t pos = 0;
 	while (true) {
-		rc = vfs_read(fd, &pos, fbuf, BUFFER_SIZE, &nr);
+		rc = vfs_read(fd, &pos, recv->fbuf, SEND_BUFFER_SIZE, &nr);
 		if (rc != EOK)
 			goto out;
 
 		if (nr == 0)
 			break;
 
-		rc = tcp_conn_send(conn, fbuf, nr);
+		rc = tcp_conn_send(conn, recv->fbuf, nr);
 		if (rc != EOK) {
 			fprintf(stderr, "tcp_conn_send() failed\n");
 			goto out;
@@ -296,45 +354,87 @@ out:
 	if (fd >= 0)
 		vfs_put(fd);
 	free(fname);
-	free(fbuf);
+	free(hdr);
 	return rc;
 }
 
-static errno_t req_process(tcp_conn_t *conn, recv_t *recv)
+/** Consume request headers, noting any Connection preference */
+static errno_t recv_headers(recv_t *recv, bool *keep_alive)
+{
+	while (true) {
+		char *hline = NULL;
+
+		errno_t rc = recv_line(recv, &hline);
+		if (rc != EOK)
+			return rc;
+
+		/* Empty line terminates the header section. */
+		if (str_cmp(hline, "\r\n") == 0)
+			return EOK;
+
+		if (str_lcasecmp(hline, "connection:", 11) == 0) {
+			char *val = hline + 11;
+			while (*val == ' ')
+				++val;
+
+			if (str_lcasecmp(val, "close", 5) == 0)
+				*keep_alive = false;
+			else if (str_lcasecmp(val, "keep-alive", 10) == 0)
+				*keep_alive = true;
+		}
+	}
+}
+
+static errno_t req_process(tcp_conn_t *conn, recv_t *recv, bool *close_conn)
 {
 	char *reqline = NULL;
 
+	*close_conn = true;
+
 	errno_t rc = recv_line(recv, &reqline);
-	if (rc != EOK) {
-		fprintf(stderr, "recv_line() failed\n");
+	if (rc != EOK)
 		return rc;
-	}
 
 	if (verbose)
 		fprintf(stderr, "Request: %s", reqline);
 
 	if (str_lcmp(reqline, "GET ", 4) != 0) {
-		rc = send_response(conn, msg_not_implemented);
-		return rc;
+		(void) recv_headers(recv, close_conn);
+		*close_conn = true;
+		return send_response(conn, msg_not_implemented);
 	}
 
 	char *uri = reqline + 4;
 	char *end_uri = str_chr(uri, ' ');
+	bool have_version = (end_uri != NULL);
 	if (end_uri == NULL) {
 		end_uri = reqline + str_size(reqline) - 2;
 		assert(*end_uri == '\r');
 	}
 
+	/* HTTP/1.1 defaults to keep-alive, earlier versions to close. */
+	bool keep_alive = have_version &&
+	    (str_lcmp(end_uri + 1, "HTTP/1.1", 8) == 0);
+
 	*end_uri = '\0';
 	if (verbose)
 		fprintf(stderr, "Requested URI: %s\n", uri);
 
-	if (!uri_is_valid(uri)) {
-		rc = send_response(conn, msg_bad_request);
-		return rc;
+	if (have_version) {
+		rc = recv_headers(recv, &keep_alive);
+		if (rc != EOK)
+			return rc;
 	}
 
-	return uri_get(uri, conn);
+	if (!uri_is_valid(uri))
+		return send_response(conn, msg_bad_request);
+
+	rc = uri_get(uri, recv, &keep_alive);
+	if (rc != EOK)
+		return rc;
+
+	*close_conn = !keep_alive;
+	return EOK;
 }
 
 static void usage(void)
@@ -403,6 +503,9 @@ static void websrv_new_conn(tcp_listener_t *lst, tcp_conn_t *conn)
 {
 	errno_t rc;
 	recv_t *recv = NULL;
+	bool close_conn = false;
+
+	fibril_semaphore_down(&conn_sem);
 
 	if (verbose)
 		fprintf(stderr, "New connection, waiting for request\n");
@@ -413,20 +516,30 @@ static void websrv_new_conn(tcp_listener_t *lst, tcp_conn_t *conn)
 		goto error;
 	}
 
-	rc = req_process(conn, recv);
-	if (rc != EOK) {
-		fprintf(stderr, "Error processing request (%s)\n",
-		    str_error(rc));
-		goto error;
+	/*
+	 * Service requests until the client closes or asks us to.
+	 * Pipelined requests work naturally: surplus bytes stay in
+	 * the receive buffer for the next iteration.
+	 */
+	while (!close_conn) {
+		rc = req_process(conn, recv, &close_conn);
+		if (rc != EOK) {
+			/*
+			 * A keep-alive peer hanging up between
+			 * requests is the normal end of the
+			 * conversation, not an error worth a reset.
+			 */
+			goto close;
+		}
 	}
 
+close:
 	rc = tcp_conn_send_fin(conn);
-	if (rc != EOK) {
+	if (rc != EOK && verbose)
 		fprintf(stderr, "Error sending FIN.\n");
-		goto error;
-	}
 
 	recv_destroy(recv);
+	fibril_semaphore_up(&conn_sem);
 	return;
 error:
 	rc = tcp_conn_reset(conn);
@@ -434,6 +547,7 @@ error:
 		fprintf(stderr, "Error resetting connection.\n");
 
 	recv_destroy(recv);
+	fibril_semaphore_up(&conn_sem);
 }
 
 int main(int argc, char *argv[])
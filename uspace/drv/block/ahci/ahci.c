@@ -116,8 +116,8 @@ static errno_t write_blocks(ddf_fun_t *, uint64_t, size_t, void *);
 
 static errno_t ahci_identify_device(sata_dev_t *);
 static errno_t ahci_set_highest_ultra_dma_mode(sata_dev_t *);
-static errno_t ahci_rb_fpdma(sata_dev_t *, uintptr_t, uint64_t);
-static errno_t ahci_wb_fpdma(sata_dev_t *, uintptr_t, uint64_t);
+static errno_t ahci_rb_fpdma(sata_dev_t *, uintptr_t, uint64_t, size_t);
+static errno_t ahci_wb_fpdma(sata_dev_t *, uintptr_t, uint64_t, size_t);
 
 static void ahci_sata_devices_create(ahci_dev_t *, ddf_dev_t *);
 static ahci_dev_t *ahci_ahci_create(ddf_dev_t *);
@@ -127,6 +127,13 @@ static errno_t ahci_dev_add(ddf_dev_t *);
 
 static void ahci_get_model_name(uint16_t *, char *);
 
+/**
+ * Maximum number of blocks transferred by one FPDMA command. Bounded
+ * by the 4 MiB limit of a single PRD entry; 32 blocks keep the
+ * bounce buffer small while amortizing the per-command latency.
+ */
+#define AHCI_MAX_XFER_BLOCKS  32
+
 static fibril_mutex_t sata_devices_count_lock;
 static int sata_devices_count = 0;
 
@@ -231,24 +238,30 @@ static errno_t read_blocks(ddf_fun_t *fun, uint64_t blocknum,
 
 	uintptr_t phys;
 	void *ibuf = AS_AREA_ANY;
-	errno_t rc = dmamem_map_anonymous(sata->block_size, DMAMEM_4GiB,
+	errno_t rc = dmamem_map_anonymous(
+	    sata->block_size * AHCI_MAX_XFER_BLOCKS, DMAMEM_4GiB,
 	    AS_AREA_READ | AS_AREA_WRITE, 0, &phys, &ibuf);
 	if (rc != EOK) {
 		ddf_msg(LVL_ERROR, "Cannot allocate read buffer.");
 		return rc;
 	}
 
-	memset(buf, 0, sata->block_size);
-
 	fibril_mutex_lock(&sata->lock);
 
-	for (size_t cur = 0; cur < count; cur++) {
-		rc = ahci_rb_fpdma(sata, phys, blocknum + cur);
+	/* Transfer as many blocks per command as the PRD entry holds. */
+	size_t cur = 0;
+	while (cur < count) {
+		size_t now = count - cur;
+		if (now > AHCI_MAX_XFER_BLOCKS)
+			now = AHCI_MAX_XFER_BLOCKS;
+
+		rc = ahci_rb_fpdma(sata, phys, blocknum + cur, now);
 		if (rc != EOK)
 			break;
 
 		memcpy((void *) (((uint8_t *) buf) + (sata->block_size * cur)),
-		    ibuf, sata->block_size);
+		    ibuf, sata->block_size * now);
+		cur += now;
 	}
 
 	fibril_mutex_unlock(&sata->lock);
@@ -274,7 +287,8 @@ static errno_t write_blocks(ddf_fun_t *fun, uint64_t blocknum,
 
 	uintptr_t phys;
 	void *ibuf = AS_AREA_ANY;
-	errno_t rc = dmamem_map_anonymous(sata->block_size, DMAMEM_4GiB,
+	errno_t rc = dmamem_map_anonymous(
+	    sata->block_size * AHCI_MAX_XFER_BLOCKS, DMAMEM_4GiB,
 	    AS_AREA_READ | AS_AREA_WRITE, 0, &phys, &ibuf);
 	if (rc != EOK) {
 		ddf_msg(LVL_ERROR, "Cannot allocate write buffer.");
@@ -283,12 +297,21 @@ static errno_t write_blocks(ddf_fun_t *fun, uint64_t blocknum,
 
 	fibril_mutex_lock(&sata->lock);
 
-	for (size_t cur = 0; cur < count; cur++) {
-		memcpy(ibuf, (void *) (((uint8_t *) buf) + (sata->block_size * cur)),
-		    sata->block_size);
-		rc = ahci_wb_fpdma(sata, phys, blocknum + cur);
+	/* Transfer as many blocks per command as the PRD entry holds. */
+	size_t cur = 0;
+	while (cur < count) {
+		size_t now = count - cur;
+		if (now > AHCI_MAX_XFER_BLOCKS)
+			now = AHCI_MAX_XFER_BLOCKS;
+
+		memcpy(ibuf,
+		    (void *) (((uint8_t *) buf) + (sata->block_size * cur)),
+		    sata->block_size * now);
+		rc = ahci_wb_fpdma(sata, phys, blocknum + cur, now);
 		if (rc != EOK)
 			break;
+
+		cur += now;
 	}
 
 	fibril_mutex_unlock(&sata->lock);
@@ -676,7 +699,7 @@ error:
  *
  */
 static void ahci_rb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
-    uint64_t blocknum)
+    uint64_t blocknum, size_t count)
 {
 	volatile sata_ncq_command_frame_t *cmd =
 	    (sata_ncq_command_frame_t *) sata->cmd_table;
@@ -694,8 +717,8 @@ static void ahci_rb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
 	cmd->reserved5 = 0;
 	cmd->reserved6 = 0;
 
-	cmd->sector_count_low = 1;
-	cmd->sector_count_high = 0;
+	cmd->sector_count_low = count & 0xff;
+	cmd->sector_count_high = (count >> 8) & 0xff;
 
 	cmd->lba0 = blocknum & 0xff;
 	cmd->lba1 = (blocknum >> 8) & 0xff;
@@ -710,7 +733,7 @@ static void ahci_rb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
 	prdt->data_address_low = LO(phys);
 	prdt->data_address_upper = HI(phys);
 	prdt->reserved1 = 0;
-	prdt->dbc = sata->block_size - 1;
+	prdt->dbc = (sata->block_size * count) - 1;
 	prdt->reserved2 = 0;
 	prdt->ioc = 0;
 
@@ -733,7 +756,8 @@ static void ahci_rb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
  * @return EOK if succeed, error code otherwise
  *
  */
-static errno_t ahci_rb_fpdma(sata_dev_t *sata, uintptr_t phys, uint64_t blocknum)
+static errno_t ahci_rb_fpdma(sata_dev_t *sata, uintptr_t phys,
+    uint64_t blocknum, size_t count)
 {
 	if (sata->is_invalid_device) {
 		ddf_msg(LVL_ERROR,
@@ -741,7 +765,7 @@ static errno_t ahci_rb_fpdma(sata_dev_t *sata, uintptr_t phys, uint64_t blocknum
 		return EINTR;
 	}
 
-	ahci_rb_fpdma_cmd(sata, phys, blocknum);
+	ahci_rb_fpdma_cmd(sata, phys, blocknum, count);
 	ahci_port_is_t pxis = ahci_wait_event(sata);
 
 	if ((sata->is_invalid_device) || (ahci_port_is_error(pxis))) {
@@ -763,7 +787,7 @@ static errno_t ahci_rb_fpdma(sata_dev_t *sata, uintptr_t phys, uint64_t blocknum
  *
  */
 static void ahci_wb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
-    uint64_t blocknum)
+    uint64_t blocknum, size_t count)
 {
 	volatile sata_ncq_command_frame_t *cmd =
 	    (sata_ncq_command_frame_t *) sata->cmd_table;
@@ -781,8 +805,8 @@ static void ahci_wb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
 	cmd->reserved5 = 0;
 	cmd->reserved6 = 0;
 
-	cmd->sector_count_low = 1;
-	cmd->sector_count_high = 0;
+	cmd->sector_count_low = count & 0xff;
+	cmd->sector_count_high = (count >> 8) & 0xff;
 
 	cmd->lba0 = blocknum & 0xff;
 	cmd->lba1 = (blocknum >> 8) & 0xff;
@@ -797,7 +821,7 @@ static void ahci_wb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
 	prdt->data_address_low = LO(phys);
 	prdt->data_address_upper = HI(phys);
 	prdt->reserved1 = 0;
-	prdt->dbc = sata->block_size - 1;
+	prdt->dbc = (sata->block_size * count) - 1;
 	prdt->reserved2 = 0;
 	prdt->ioc = 0;
 
@@ -821,7 +845,8 @@ static void ahci_wb_fpdma_cmd(sata_dev_t *sata, uintptr_t phys,
  * @return EOK if succeed, error code otherwise
  *
  */
-static errno_t ahci_wb_fpdma(sata_dev_t *sata, uintptr_t phys, uint64_t blocknum)
+static errno_t ahci_wb_fpdma(sata_dev_t *sata, uintptr_t phys,
+    uint64_t blocknum, size_t count)
 {
 	if (sata->is_invalid_device) {
 		ddf_msg(LVL_ERROR,
@@ -829,7 +854,7 @@ static errno_t ahci_wb_fpdma(sata_dev_t *sata, uintptr_t phys, uint64_t blocknum
 		return EINTR;
 	}
 
-	ahci_wb_fpdma_cmd(sata, phys, blocknum);
+	ahci_wb_fpdma_cmd(sata, phys, blocknum, count);
 	ahci_port_is_t pxis = ahci_wait_event(sata);
 
 	if ((sata->is_invalid_device) || (ahci_port_is_error(pxis))) {
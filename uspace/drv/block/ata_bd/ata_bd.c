@@ -120,6 +120,12 @@ static void coord_sc_program(ata_ctrl_t *ctrl, const block_coord_t *bc,
 static errno_t wait_status(ata_ctrl_t *ctrl, unsigned set, unsigned n_reset,
     uint8_t *pstatus, unsigned timeout);
 
+/**
+ * Maximum number of blocks transferred by one read/write command.
+ * Bounded by the 8-bit sector count of CHS/LBA28 commands.
+ */
+#define ATA_MAX_XFER_BLOCKS  128
+
 bd_ops_t ata_bd_ops = {
 	.open = ata_bd_open,
 	.close = ata_bd_close,
@@ -520,12 +526,28 @@ static errno_t ata_bd_read_blocks(bd_srv_t *bd, uint64_t ba, size_t cnt,
 
 	while (cnt > 0) {
 		if (disk->dev_type == ata_reg_dev) {
-			rc = ata_rcmd_read(disk, ba, 1, buf);
-		} else {
-			rc = ata_pcmd_read_12(disk, ba, 1, buf,
-			    disk->block_size);
+			/*
+			 * Read as many sectors per command as the
+			 * sector count register allows; the PIO data
+			 * loop transfers them back to back.
+			 */
+			size_t now = cnt;
+			if (now > ATA_MAX_XFER_BLOCKS)
+				now = ATA_MAX_XFER_BLOCKS;
+
+			rc = ata_rcmd_read(disk, ba, now, buf);
+			if (rc != EOK)
+				return rc;
+
+			ba += now;
+			cnt -= now;
+			buf += disk->block_size * now;
+			continue;
 		}
 
+		rc = ata_pcmd_read_12(disk, ba, 1, buf,
+		    disk->block_size);
+
 		if (rc != EOK)
 			return rc;
 
@@ -559,13 +581,17 @@ static errno_t ata_bd_write_blocks(bd_srv_t *bd, uint64_t ba, size_t cnt,
 		return EINVAL;
 
 	while (cnt > 0) {
-		rc = ata_rcmd_write(disk, ba, 1, buf);
+		size_t now = cnt;
+		if (now > ATA_MAX_XFER_BLOCKS)
+			now = ATA_MAX_XFER_BLOCKS;
+
+		rc = ata_rcmd_write(disk, ba, now, buf);
 		if (rc != EOK)
 			return rc;
 
-		++ba;
-		--cnt;
-		buf += disk->block_size;
+		ba += now;
+		cnt -= now;
+		buf += disk->block_size * now;
 	}
 
 	return EOK;
@@ -610,24 +636,27 @@ static errno_t ata_pio_data_in(disk_t *disk, void *obuf, size_t obuf_size,
 	size_t i;
 	uint8_t status;
 
-	/* XXX Support multiple blocks */
-	assert(nblocks == 1);
 	assert(blk_size % 2 == 0);
+	assert(obuf_size >= nblocks * blk_size);
 
-	if (wait_status(ctrl, 0, ~SR_BSY, &status, TIMEOUT_BSY) != EOK)
-		return EIO;
+	/* The device asserts DRQ once per block. */
+	for (size_t blk = 0; blk < nblocks; blk++) {
+		if (wait_status(ctrl, 0, ~SR_BSY, &status, TIMEOUT_BSY) != EOK)
+			return EIO;
 
-	if ((status & SR_DRQ) != 0) {
-		/* Read data from the device buffer. */
+		if ((status & SR_DRQ) != 0) {
+			/* Read data from the device buffer. */
 
-		for (i = 0; i < blk_size / 2; i++) {
-			data = pio_read_16(&ctrl->cmd->data_port);
-			((uint16_t *) obuf)[i] = data;
+			for (i = 0; i < blk_size / 2; i++) {
+				data = pio_read_16(&ctrl->cmd->data_port);
+				((uint16_t *) obuf)[blk * (blk_size / 2) + i] =
+				    data;
+			}
 		}
-	}
 
-	if ((status & SR_ERR) != 0)
-		return EIO;
+		if ((status & SR_ERR) != 0)
+			return EIO;
+	}
 
 	return EOK;
 }
@@ -640,23 +669,26 @@ static errno_t ata_pio_data_out(disk_t *disk, const void *buf, size_t buf_size,
 	size_t i;
 	uint8_t status;
 
-	/* XXX Support multiple blocks */
-	assert(nblocks == 1);
 	assert(blk_size % 2 == 0);
+	assert(buf_size >= nblocks * blk_size);
 
-	if (wait_status(ctrl, 0, ~SR_BSY, &status, TIMEOUT_BSY) != EOK)
-		return EIO;
+	/* The device asserts DRQ once per block. */
+	for (size_t blk = 0; blk < nblocks; blk++) {
+		if (wait_status(ctrl, 0, ~SR_BSY, &status, TIMEOUT_BSY) != EOK)
+			return EIO;
 
-	if ((status & SR_DRQ) != 0) {
-		/* Write data to the device buffer. */
+		if ((status & SR_DRQ) != 0) {
+			/* Write data to the device buffer. */
 
-		for (i = 0; i < blk_size / 2; i++) {
-			pio_write_16(&ctrl->cmd->data_port, ((uint16_t *) buf)[i]);
+			for (i = 0; i < blk_size / 2; i++) {
+				pio_write_16(&ctrl->cmd->data_port,
+				    ((uint16_t *) buf)[blk * (blk_size / 2) + i]);
+			}
 		}
-	}
 
-	if (status & SR_ERR)
-		return EIO;
+		if (status & SR_ERR)
+			return EIO;
+	}
 
 	return EOK;
 }
@@ -1039,7 +1071,7 @@ static errno_t ata_rcmd_read(disk_t *disk, uint64_t ba, size_t blk_cnt,
 	}
 
 	/* Program block coordinates into the device. */
-	coord_sc_program(ctrl, &bc, 1);
+	coord_sc_program(ctrl, &bc, blk_cnt);
 
 	pio_write_8(&ctrl->cmd->command, disk->amode == am_lba48 ?
 	    CMD_READ_SECTORS_EXT : CMD_READ_SECTORS);
@@ -1099,7 +1131,7 @@ static errno_t ata_rcmd_write(disk_t *disk, uint64_t ba, size_t cnt,
 	}
 
 	/* Program block coordinates into the device. */
-	coord_sc_program(ctrl, &bc, 1);
+	coord_sc_program(ctrl, &bc, blk_cnt);
 
 	pio_write_8(&ctrl->cmd->command, disk->amode == am_lba48 ?
 	    CMD_WRITE_SECTORS_EXT : CMD_WRITE_SECTORS);
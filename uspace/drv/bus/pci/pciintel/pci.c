@@ -254,9 +254,19 @@ static void pci_conf_read(pci_fun_t *fun, int reg, uint8_t *buf, size_t len)
 	pci_bus_t *bus = pci_bus_from_fun(fun);
 	uint32_t val;
 
+	const unsigned dword = (reg >> 2) & 0x3f;
+	const bool cacheable = (reg < 64) && (dword != 1);
+
 	fibril_mutex_lock(&bus->conf_mutex);
 
-	if (bus->conf_addr_reg) {
+	if (cacheable && (fun->conf_cache_valid & (1 << dword))) {
+		/*
+		 * Serve the read-mostly part of the standard header
+		 * from the cache; the status register dword is always
+		 * read from the hardware.
+		 */
+		val = fun->conf_cache[dword];
+	} else if (bus->conf_addr_reg) {
 		pio_write_32(bus->conf_addr_reg,
 		    host2uint32_t_le(CONF_ADDR_ENABLE | conf_addr));
 		/*
@@ -271,6 +281,11 @@ static void pci_conf_read(pci_fun_t *fun, int reg, uint8_t *buf, size_t len)
 		    &bus->conf_space[conf_addr / sizeof(ioport32_t)]));
 	}
 
+	if (cacheable) {
+		fun->conf_cache[dword] = val;
+		fun->conf_cache_valid |= (1 << dword);
+	}
+
 	switch (len) {
 	case 1:
 		*buf = (uint8_t) (val >> ((reg & 3) * 8));
@@ -338,6 +353,16 @@ static void pci_conf_write(pci_fun_t *fun, int reg, uint8_t *buf, size_t len)
 		    host2uint32_t_le(val));
 	}
 
+	/*
+	 * Invalidate the written dword in the header cache. Written
+	 * values must not be cached verbatim: registers such as the
+	 * BARs do not read back what was written (the all-ones write
+	 * of the BAR sizing protocol reads back as the size mask).
+	 */
+	const unsigned dword = (reg >> 2) & 0x3f;
+	if (reg < 64)
+		fun->conf_cache_valid &= ~(1 << dword);
+
 	fibril_mutex_unlock(&bus->conf_mutex);
 }
 
@@ -64,6 +64,15 @@ typedef struct pci_fun_data {
 	int bus;
 	int dev;
 	int fn;
+
+	/**
+	 * Cache of the standard configuration header (dword granular).
+	 * The dword holding the volatile status register is never
+	 * cached. Protected by the bus configuration mutex.
+	 */
+	uint32_t conf_cache[16];
+	uint16_t conf_cache_valid;
+
 	uint16_t vendor_id;
 	uint16_t device_id;
 	uint16_t command;
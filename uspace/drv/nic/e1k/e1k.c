@@ -282,7 +282,9 @@ irq_code_t e1000_irq_code = {
 	    sizeof(irq_pio_range_t),
 	.ranges = e1000_irq_pio_ranges,
 	.cmdcount = sizeof(e1000_irq_commands) / sizeof(irq_cmd_t),
-	.cmds = e1000_irq_commands
+	.cmds = e1000_irq_commands,
+	/* ICR is a bitmask and the bottom half polls the rings. */
+	.coalesce = true
 };
 
 /** Get the device information
@@ -1177,32 +1179,48 @@ static void e1000_receive_frames(nic_t *nic)
 	fibril_mutex_lock(&e1000->rx_lock);
 
 	uint32_t *tail_addr = E1000_REG_ADDR(e1000, E1000_RDT);
-	uint32_t next_tail = e1000_inc_tail(*tail_addr, E1000_RX_FRAME_COUNT);
+	uint32_t tail = *tail_addr;
+	uint32_t next_tail = e1000_inc_tail(tail, E1000_RX_FRAME_COUNT);
 
 	e1000_rx_descriptor_t *rx_descriptor = (e1000_rx_descriptor_t *)
 	    (e1000->rx_ring_virt + next_tail * sizeof(e1000_rx_descriptor_t));
 
+	list_t frames;
+	list_initialize(&frames);
+
+	/*
+	 * Drain the ring in one pass: collect the frames, refill the
+	 * descriptors and publish the new tail to the device with a
+	 * single register write at the end instead of one per frame.
+	 */
 	while (rx_descriptor->status & 0x01) {
 		uint32_t frame_size = rx_descriptor->length - E1000_CRC_SIZE;
 
 		nic_frame_t *frame = nic_alloc_frame(nic, frame_size);
 		if (frame != NULL) {
 			memcpy(frame->data, e1000->rx_frame_virt[next_tail], frame_size);
-			nic_received_frame(nic, frame);
+			list_append(&frame->link, &frames);
 		} else {
 			ddf_msg(LVL_ERROR, "Memory allocation failed. Frame dropped.");
 		}
 
 		e1000_fill_new_rx_descriptor(nic, next_tail);
 
-		*tail_addr = e1000_inc_tail(*tail_addr, E1000_RX_FRAME_COUNT);
-		next_tail = e1000_inc_tail(*tail_addr, E1000_RX_FRAME_COUNT);
+		tail = next_tail;
+		next_tail = e1000_inc_tail(tail, E1000_RX_FRAME_COUNT);
 
 		rx_descriptor = (e1000_rx_descriptor_t *)
 		    (e1000->rx_ring_virt + next_tail * sizeof(e1000_rx_descriptor_t));
 	}
 
+	if (tail != *tail_addr)
+		*tail_addr = tail;
+
 	fibril_mutex_unlock(&e1000->rx_lock);
+
+	/* Deliver the batch without holding the receive lock. */
+	if (!list_empty(&frames))
+		nic_received_frame_list(nic, &frames);
 }
 
 /** Enable E1000 interupts
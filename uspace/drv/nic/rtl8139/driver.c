@@ -665,7 +665,9 @@ irq_code_t rtl8139_irq_code = {
 	.rangecount = sizeof(rtl8139_irq_pio_ranges) / sizeof(irq_pio_range_t),
 	.ranges = rtl8139_irq_pio_ranges,
 	.cmdcount = sizeof(rtl8139_irq_commands) / sizeof(irq_cmd_t),
-	.cmds = rtl8139_irq_commands
+	.cmds = rtl8139_irq_commands,
+	/* ISR is a bitmask and the bottom half polls the rings. */
+	.coalesce = true
 };
 
 /** Deal with transmitter interrupt
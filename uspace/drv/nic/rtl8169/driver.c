@@ -156,7 +156,9 @@ irq_code_t rtl8169_irq_code = {
 	.rangecount = sizeof(rtl8169_irq_pio_ranges) / sizeof(irq_pio_range_t),
 	.ranges = rtl8169_irq_pio_ranges,
 	.cmdcount = sizeof(rtl8169_irq_commands) / sizeof(irq_cmd_t),
-	.cmds = rtl8169_irq_commands
+	.cmds = rtl8169_irq_commands,
+	/* ISR is a bitmask and the bottom half polls the rings. */
+	.coalesce = true
 };
 
 /** Basic device operations for RTL8169 driver */
@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <fibril.h>
 
 #include <as.h>
 #include <ddf/driver.h>
@@ -69,35 +70,97 @@ static driver_t virtio_net_driver = {
 	.driver_ops = &virtio_net_driver_ops
 };
 
+/** RX delivery fibril.
+ *
+ * Frames are handed over from the interrupt notification handler and
+ * delivered to the networking stack from here, in batches, so that
+ * the notification handler only recycles descriptors and the ring
+ * can be replenished while earlier frames are still being pushed up
+ * the stack. One such fibril serves each receive queue.
+ */
+static errno_t virtio_net_rx_fibril(void *arg)
+{
+	nic_t *nic = (nic_t *) arg;
+	virtio_net_t *virtio_net = nic_get_specific(nic);
+
+	while (true) {
+		list_t frames;
+		list_initialize(&frames);
+
+		fibril_mutex_lock(&virtio_net->rx_lock);
+		while (list_empty(&virtio_net->rx_frames))
+			fibril_condvar_wait(&virtio_net->rx_cv,
+			    &virtio_net->rx_lock);
+
+		list_concat(&frames, &virtio_net->rx_frames);
+		fibril_mutex_unlock(&virtio_net->rx_lock);
+
+		nic_received_frame_list(nic, &frames);
+	}
+
+	return EOK;
+}
+
 static void virtio_net_irq_handler(ipc_call_t *icall, ddf_dev_t *dev)
 {
 	nic_t *nic = ddf_dev_data_get(dev);
 	virtio_net_t *virtio_net = nic_get_specific(nic);
 	virtio_dev_t *vdev = &virtio_net->virtio_dev;
 
+	list_t frames;
+	list_initialize(&frames);
+
 	uint16_t descno;
 	uint32_t len;
-	while (virtio_virtq_consume_used(vdev, RX_QUEUE_1, &descno, &len)) {
-		virtio_net_hdr_t *hdr =
-		    (virtio_net_hdr_t *) virtio_net->rx_buf[descno];
-		if (len <= sizeof(*hdr)) {
-			ddf_msg(LVL_WARN,
-			    "RX data length too short, packet dropped");
-			virtio_virtq_produce_available(vdev, RX_QUEUE_1,
-			    descno);
-			continue;
-		}
+	uint16_t descnos[RX_BUFFERS];
+	uint32_t lens[RX_BUFFERS];
+	size_t cnt;
 
-		nic_frame_t *frame = nic_alloc_frame(nic, len - sizeof(*hdr));
-		if (frame) {
-			memcpy(frame->data, &hdr[1], len - sizeof(*hdr));
-			nic_received_frame(nic, frame);
-		} else {
-			ddf_msg(LVL_WARN,
-			    "Cannot allocate RX frame, packet dropped");
+	/*
+	 * Reap the used ring in batches and recycle the descriptors
+	 * without notifying the device for each; one notification
+	 * per batch is enough.
+	 */
+	while ((cnt = virtio_virtq_consume_used_batch(vdev, RX_QUEUE_1,
+	    descnos, lens, RX_BUFFERS)) > 0) {
+		for (size_t i = 0; i < cnt; i++) {
+			descno = descnos[i];
+			len = lens[i];
+
+			virtio_net_hdr_t *hdr =
+			    (virtio_net_hdr_t *) virtio_net->rx_buf[descno];
+			if (len <= sizeof(*hdr)) {
+				ddf_msg(LVL_WARN,
+				    "RX data length too short, packet dropped");
+				virtio_virtq_produce_available_nonotify(vdev,
+				    RX_QUEUE_1, descno);
+				continue;
+			}
+
+			nic_frame_t *frame = nic_alloc_frame(nic,
+			    len - sizeof(*hdr));
+			if (frame) {
+				memcpy(frame->data, &hdr[1],
+				    len - sizeof(*hdr));
+				list_append(&frame->link, &frames);
+			} else {
+				ddf_msg(LVL_WARN,
+				    "Cannot allocate RX frame, packet dropped");
+			}
+
+			virtio_virtq_produce_available_nonotify(vdev,
+			    RX_QUEUE_1, descno);
 		}
 
-		virtio_virtq_produce_available(vdev, RX_QUEUE_1, descno);
+		virtio_virtq_notify(vdev, RX_QUEUE_1);
+	}
+
+	if (!list_empty(&frames)) {
+		/* Hand the batch over to the RX delivery fibril. */
+		fibril_mutex_lock(&virtio_net->rx_lock);
+		list_concat(&virtio_net->rx_frames, &frames);
+		fibril_mutex_unlock(&virtio_net->rx_lock);
+		fibril_condvar_signal(&virtio_net->rx_cv);
 	}
 
 	while (virtio_virtq_consume_used(vdev, TX_QUEUE_1, &descno, &len)) {
@@ -159,7 +222,9 @@ static errno_t virtio_net_register_interrupt(ddf_dev_t *dev)
 		.rangecount = sizeof(pio_ranges) / sizeof(irq_pio_range_t),
 		.ranges = pio_ranges,
 		.cmdcount = sizeof(irq_commands) / sizeof(irq_cmd_t),
-		.cmds = irq_commands
+		.cmds = irq_commands,
+		/* The bottom half reaps the used rings on its own. */
+		.coalesce = true
 	};
 
 	return register_interrupt_handler(dev, virtio_net->irq,
@@ -180,6 +245,14 @@ static errno_t virtio_net_initialize(ddf_dev_t *dev)
 
 	nic_set_specific(nic, virtio_net);
 
+	/*
+	 * The RX hand-off must be operational before the interrupt
+	 * handler can fire.
+	 */
+	fibril_mutex_initialize(&virtio_net->rx_lock);
+	fibril_condvar_initialize(&virtio_net->rx_cv);
+	list_initialize(&virtio_net->rx_frames);
+
 	errno_t rc = virtio_pci_dev_initialize(dev, &virtio_net->virtio_dev);
 	if (rc != EOK)
 		return rc;
@@ -415,6 +488,14 @@ static errno_t virtio_net_dev_add(ddf_dev_t *dev)
 	    virtio_net_on_multicast_mode_change,
 	    virtio_net_on_broadcast_mode_change, NULL, NULL);
 
+	/* Start the RX delivery fibril. */
+	fid_t rx_fid = fibril_create(virtio_net_rx_fibril, nic);
+	if (rx_fid == 0) {
+		rc = ENOMEM;
+		goto destroy;
+	}
+	fibril_add_ready(rx_fid);
+
 	rc = ddf_fun_bind(fun);
 	if (rc != EOK) {
 		ddf_msg(LVL_ERROR, "Failed binding device function");
@@ -29,6 +29,8 @@
 #ifndef _VIRTIO_NET_H_
 #define _VIRTIO_NET_H_
 
+#include <adt/list.h>
+#include <fibril_synch.h>
 #include <virtio-pci.h>
 #include <abi/cap.h>
 #include <nic/nic.h>
@@ -75,6 +77,14 @@ typedef struct {
 
 	int irq;
 	cap_irq_handle_t irq_handle;
+
+	/**
+	 * Hand-off of received frames from the interrupt notification
+	 * handler to the RX delivery fibril.
+	 */
+	fibril_mutex_t rx_lock;
+	fibril_condvar_t rx_cv;
+	list_t rx_frames;
 } virtio_net_t;
 
 #endif
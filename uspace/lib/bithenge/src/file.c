@@ -35,8 +35,16 @@
  * @todo Provide more information about the file.
  */
 
+#include <align.h>
+#include <as.h>
 #include <assert.h>
+#include <async.h>
 #include <errno.h>
+#include <ipc/services.h>
+#include <libarch/config.h>
+#include <macros.h>
+#include <mem.h>
+#include <ns.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vfs/vfs.h>
@@ -50,6 +58,11 @@ typedef struct {
 	int fd;
 	aoff64_t size; // needed by file_read()
 	bool needs_close;
+
+	/** Pager-backed mapping of the file, or AS_MAP_FAILED */
+	void *map;
+	size_t map_size;
+	async_sess_t *pager_sess;
 } file_blob_t;
 
 static inline file_blob_t *blob_as_file(bithenge_blob_t *base)
@@ -76,17 +89,35 @@ static errno_t file_read(bithenge_blob_t *base, aoff64_t offset, char *buffer,
 	if (offset > blob->size)
 		return ELIMIT;
 
+	if (blob->map != AS_MAP_FAILED) {
+		/*
+		 * The file is mapped through the VFS pager: random
+		 * access just touches the pages, which fault in (and
+		 * stay cached) on demand instead of being read and
+		 * copied through the fd.
+		 */
+		*size = min(*size, blob->size - offset);
+		memcpy(buffer, blob->map + offset, *size);
+		return EOK;
+	}
+
 	size_t amount_read;
 	errno_t rc = vfs_read(blob->fd, &offset, buffer, *size, &amount_read);
 	if (rc != EOK)
 		return errno;
-	*size += amount_read;
+	*size = amount_read;
 	return EOK;
 }
 
 static void file_destroy(bithenge_blob_t *base)
 {
 	file_blob_t *blob = blob_as_file(base);
+
+	if (blob->map != AS_MAP_FAILED)
+		as_area_destroy(blob->map);
+	if (blob->pager_sess != NULL)
+		async_hangup(blob->pager_sess);
+
 	vfs_put(blob->fd);
 	free(blob);
 }
@@ -130,6 +161,34 @@ static errno_t new_file_blob(bithenge_node_t **out, int fd, bool needs_close)
 	blob->size = stat.st_size;
 #endif
 	blob->needs_close = needs_close;
+
+	/*
+	 * Prefer mapping the file through the VFS pager; huge blobs
+	 * are then paged on access rather than read. Any failure
+	 * (no pager, exhausted address space) falls back to reads.
+	 */
+	blob->map = AS_MAP_FAILED;
+	blob->map_size = 0;
+	blob->pager_sess = NULL;
+#ifdef __HELENOS__
+	if (blob->size > 0) {
+		blob->pager_sess = service_connect(SERVICE_VFS,
+		    INTERFACE_PAGER, 0, NULL);
+		if (blob->pager_sess != NULL) {
+			blob->map_size = ALIGN_UP(blob->size, PAGE_SIZE);
+			blob->map = async_as_area_create(AS_AREA_ANY,
+			    blob->map_size,
+			    AS_AREA_READ | AS_AREA_CACHEABLE,
+			    blob->pager_sess, fd, 0, 0);
+
+			if (blob->map == AS_MAP_FAILED) {
+				async_hangup(blob->pager_sess);
+				blob->pager_sess = NULL;
+			}
+		}
+	}
+#endif
+
 	*out = bithenge_blob_as_node(file_as_blob(blob));
 
 	return EOK;
@@ -43,6 +43,7 @@
 #include <as.h>
 #include <assert.h>
 #include <bd.h>
+#include <fibril.h>
 #include <fibril_synch.h>
 #include <adt/list.h>
 #include <adt/hash_table.h>
@@ -72,6 +73,28 @@ typedef struct {
 	hash_table_t block_hash;
 	list_t free_list;
 	enum cache_mode mode;
+
+	/** Tells the write-back flusher fibril to exit. */
+	bool flusher_stop;
+	/** Posted by the flusher fibril when it exits. */
+	fibril_semaphore_t flusher_done;
+
+	/** Last logical block requested (sequential detection). */
+	aoff64_t ra_last_ba;
+	/** Length of the current sequential streak. */
+	unsigned ra_streak;
+	/** First block of the posted readahead window. */
+	aoff64_t ra_next;
+	/** Number of blocks in the posted readahead window. */
+	unsigned ra_count;
+	/** True while a readahead request is posted or running. */
+	bool ra_pending;
+	/** Kicks the readahead fibril. */
+	fibril_semaphore_t ra_sem;
+	/** Tells the readahead fibril to exit. */
+	bool ra_stop;
+	/** Posted by the readahead fibril when it exits. */
+	fibril_semaphore_t ra_done;
 } cache_t;
 
 typedef struct {
@@ -267,6 +290,328 @@ static hash_table_ops_t cache_ops = {
 	.remove_callback = NULL
 };
 
+/** Interval between write-back flusher passes. */
+#define FLUSHER_INTERVAL  (1000 * 1000)
+
+/** Maximum number of dirty blocks collected per flusher pass. */
+#define FLUSH_BATCH  16
+
+typedef struct {
+	block_t *blocks[FLUSH_BATCH];
+	size_t count;
+} flush_batch_t;
+
+static bool flush_collect_visitor(ht_link_t *item, void *arg)
+{
+	flush_batch_t *batch = (flush_batch_t *) arg;
+	block_t *b = hash_table_get_inst(item, block_t, hash_link);
+
+	fibril_mutex_lock(&b->lock);
+	/*
+	 * Only blocks nobody holds may be written: a client with a
+	 * reference may be mid-update and its block must not hit the
+	 * disk half-written. Held blocks are written by the final
+	 * block_put() or by a later pass.
+	 */
+	if (b->dirty && !b->toxic && (b->refcnt == 0)) {
+		/* Pin the block the same way block_get() does. */
+		b->refcnt = 1;
+		list_remove(&b->free_link);
+		batch->blocks[batch->count++] = b;
+	}
+	fibril_mutex_unlock(&b->lock);
+
+	return batch->count < FLUSH_BATCH;
+}
+
+/** Flush a batch of dirty blocks, clustering adjacent ones.
+ *
+ * Collects up to FLUSH_BATCH dirty blocks, sorts them by physical
+ * address and writes runs of physically consecutive blocks with a
+ * single device request each, using @a staging as the gather buffer.
+ *
+ * @param devcon  Device connection.
+ * @param staging Gather buffer of FLUSH_BATCH logical blocks.
+ */
+static size_t cache_flush_pass(devcon_t *devcon, uint8_t *staging)
+{
+	cache_t *cache = devcon->cache;
+	flush_batch_t batch = { .count = 0 };
+
+	fibril_mutex_lock(&cache->lock);
+	hash_table_apply(&cache->block_hash, flush_collect_visitor, &batch);
+	fibril_mutex_unlock(&cache->lock);
+
+	if (batch.count == 0)
+		return 0;
+
+	/* Sort by physical address (tiny insertion sort). */
+	for (size_t i = 1; i < batch.count; i++) {
+		block_t *key = batch.blocks[i];
+		size_t j = i;
+		while ((j > 0) && (batch.blocks[j - 1]->pba > key->pba)) {
+			batch.blocks[j] = batch.blocks[j - 1];
+			j--;
+		}
+		batch.blocks[j] = key;
+	}
+
+	size_t i = 0;
+	while (i < batch.count) {
+		/* Find a run of physically consecutive dirty blocks. */
+		size_t run = 1;
+		while ((i + run < batch.count) &&
+		    (batch.blocks[i + run]->pba ==
+		    batch.blocks[i]->pba + run * cache->blocks_cluster) &&
+		    (batch.blocks[i + run]->size == batch.blocks[i]->size))
+			run++;
+
+		/*
+		 * Snapshot the run into the staging buffer and mark
+		 * the blocks clean; a failed write marks them dirty
+		 * again below. A block that was re-acquired since
+		 * collection ends the run and is left dirty for its
+		 * holder's block_put().
+		 */
+		size_t bsize = batch.blocks[i]->size;
+		size_t snap = 0;
+		for (size_t k = 0; k < run; k++) {
+			block_t *b = batch.blocks[i + k];
+
+			fibril_mutex_lock(&b->lock);
+			if (b->refcnt > 1) {
+				fibril_mutex_unlock(&b->lock);
+				break;
+			}
+			memcpy(staging + snap * bsize, b->data, bsize);
+			b->dirty = false;
+			fibril_mutex_unlock(&b->lock);
+			snap++;
+		}
+
+		if (snap > 0) {
+			errno_t rc = write_blocks(devcon, batch.blocks[i]->pba,
+			    snap * cache->blocks_cluster, staging, snap * bsize);
+
+			if (rc != EOK) {
+				for (size_t k = 0; k < snap; k++) {
+					block_t *b = batch.blocks[i + k];
+
+					fibril_mutex_lock(&b->lock);
+					b->dirty = true;
+					fibril_mutex_unlock(&b->lock);
+				}
+			}
+		}
+
+		i += (snap < run) ? snap + 1 : run;
+	}
+
+	/* Drop the pins. */
+	for (size_t k = 0; k < batch.count; k++)
+		(void) block_put(batch.blocks[k]);
+
+	return batch.count;
+}
+
+/** Flush all dirty blocks of a device and sync its caches.
+ *
+ * Group commit entry point: everything dirtied by the operations so
+ * far is clustered and written out, and the device is asked to
+ * persist its own caches afterwards.
+ *
+ * @param service_id Service ID of the block device.
+ *
+ * @return EOK on success or an error code.
+ */
+errno_t block_cache_flush_all(service_id_t service_id)
+{
+	devcon_t *devcon = devcon_search(service_id);
+
+	if (!devcon)
+		return ENOENT;
+	if (!devcon->cache)
+		return EOK;
+
+	uint8_t *staging = malloc(FLUSH_BATCH *
+	    devcon->cache->lblock_size);
+	if (staging == NULL)
+		return ENOMEM;
+
+	/*
+	 * Failed writes re-dirty their blocks, so bound the number of
+	 * passes to avoid spinning on a persistently failing device.
+	 */
+	unsigned passes = 0;
+	while (cache_flush_pass(devcon, staging) > 0) {
+		if (++passes > 1024) {
+			free(staging);
+			return EIO;
+		}
+	}
+
+	free(staging);
+
+	return bd_sync_cache(devcon->bd, 0, 0);
+}
+
+/** Write-back flusher fibril.
+ *
+ * Periodically writes dirty blocks back to the device so that a
+ * write-back cache does not keep modified data in memory
+ * indefinitely, and so that eviction rarely meets dirty blocks.
+ *
+ * @param arg Device connection.
+ */
+static errno_t cache_flusher(void *arg)
+{
+	devcon_t *devcon = (devcon_t *) arg;
+	cache_t *cache = devcon->cache;
+
+	uint8_t *staging = malloc(FLUSH_BATCH * cache->lblock_size);
+	if (staging == NULL) {
+		fibril_semaphore_up(&cache->flusher_done);
+		return ENOMEM;
+	}
+
+	while (true) {
+		fibril_usleep(FLUSHER_INTERVAL);
+
+		if (cache->flusher_stop)
+			break;
+
+		cache_flush_pass(devcon, staging);
+	}
+
+	free(staging);
+	fibril_semaphore_up(&cache->flusher_done);
+	return EOK;
+}
+
+/** Number of sequential hits before readahead starts. */
+#define RA_MIN_STREAK  2
+
+/** Maximum number of blocks read ahead at once. */
+#define RA_MAX_WINDOW  8
+
+/** True while the calling fibril performs readahead itself. */
+static fibril_local bool ra_in_progress;
+
+/** Readahead fibril.
+ *
+ * Waits for a posted readahead window and populates the cache with
+ * it by going through the regular block_get()/block_put() path, so
+ * prefetched blocks are cached, reference counted and evicted like
+ * any other. Read errors (e.g. past the end of the device) are
+ * simply ignored.
+ *
+ * @param arg Device connection.
+ */
+static errno_t cache_readahead(void *arg)
+{
+	devcon_t *devcon = (devcon_t *) arg;
+	cache_t *cache = devcon->cache;
+
+	while (true) {
+		fibril_semaphore_down(&cache->ra_sem);
+
+		if (cache->ra_stop)
+			break;
+
+		fibril_mutex_lock(&cache->lock);
+		aoff64_t ba = cache->ra_next;
+		unsigned count = cache->ra_count;
+		fibril_mutex_unlock(&cache->lock);
+
+		ra_in_progress = true;
+
+		for (unsigned i = 0; i < count; i++) {
+			block_t *b;
+			if (block_get(&b, devcon->service_id, ba + i,
+			    BLOCK_FLAGS_NONE) == EOK)
+				(void) block_put(b);
+		}
+
+		ra_in_progress = false;
+
+		fibril_mutex_lock(&cache->lock);
+		cache->ra_pending = false;
+		fibril_mutex_unlock(&cache->lock);
+	}
+
+	fibril_semaphore_up(&cache->ra_done);
+	return EOK;
+}
+
+/** Detect sequential access and post a readahead window.
+ *
+ * Called from block_get() with the cache lock held.
+ *
+ * @param cache Block cache.
+ * @param ba    Logical block being requested.
+ */
+static void cache_readahead_hint(cache_t *cache, aoff64_t ba)
+{
+	/* Do not let our own prefetching feed the detector. */
+	if (ra_in_progress)
+		return;
+
+	if (ba == cache->ra_last_ba + 1)
+		cache->ra_streak++;
+	else
+		cache->ra_streak = 0;
+
+	cache->ra_last_ba = ba;
+
+	if ((cache->ra_streak >= RA_MIN_STREAK) && (!cache->ra_pending)) {
+		unsigned window = cache->ra_streak;
+		if (window > RA_MAX_WINDOW)
+			window = RA_MAX_WINDOW;
+
+		cache->ra_next = ba + 1;
+		cache->ra_count = window;
+		cache->ra_pending = true;
+		fibril_semaphore_up(&cache->ra_sem);
+	}
+}
+
+/** Explicitly prefetch a run of blocks into the cache.
+ *
+ * Posts a readahead window for [ba, ba + cnt) regardless of the
+ * sequential-access detector; useful when the caller knows the
+ * next blocks (e.g. the start of a file's next extent) are not
+ * physically contiguous with the current position. Best effort:
+ * nothing happens if a window is already pending.
+ *
+ * @param service_id Service ID of the block device.
+ * @param ba Address of the first block to prefetch.
+ * @param cnt Number of blocks.
+ *
+ * @return EOK on success or an error code.
+ */
+errno_t block_prefetch(service_id_t service_id, aoff64_t ba, size_t cnt)
+{
+	devcon_t *devcon = devcon_search(service_id);
+
+	if (devcon == NULL)
+		return ENOENT;
+
+	cache_t *cache = devcon->cache;
+	if (cache == NULL)
+		return ENOENT;
+
+	fibril_mutex_lock(&cache->lock);
+	if (!cache->ra_pending && cnt > 0) {
+		cache->ra_next = ba;
+		cache->ra_count = (cnt > RA_MAX_WINDOW) ? RA_MAX_WINDOW : cnt;
+		cache->ra_pending = true;
+		fibril_semaphore_up(&cache->ra_sem);
+	}
+	fibril_mutex_unlock(&cache->lock);
+
+	return EOK;
+}
+
 errno_t block_cache_init(service_id_t service_id, size_t size, unsigned blocks,
     enum cache_mode mode)
 {
@@ -301,6 +646,38 @@ errno_t block_cache_init(service_id_t service_id, size_t size, unsigned blocks,
 	}
 
 	devcon->cache = cache;
+
+	/*
+	 * Write-back caches get a background flusher so that dirty
+	 * blocks do not linger in memory indefinitely.
+	 */
+	cache->flusher_stop = false;
+	fibril_semaphore_initialize(&cache->flusher_done, 0);
+	if (mode == CACHE_MODE_WB) {
+		fid_t fid = fibril_create(cache_flusher, devcon);
+		if (fid != 0)
+			fibril_add_ready(fid);
+		else
+			cache->flusher_stop = true;
+	}
+
+	/*
+	 * Start the readahead fibril; sequential access detected in
+	 * block_get() posts prefetch windows to it.
+	 */
+	cache->ra_last_ba = (aoff64_t) -1;
+	cache->ra_streak = 0;
+	cache->ra_pending = false;
+	cache->ra_stop = false;
+	fibril_semaphore_initialize(&cache->ra_sem, 0);
+	fibril_semaphore_initialize(&cache->ra_done, 0);
+
+	fid_t ra_fid = fibril_create(cache_readahead, devcon);
+	if (ra_fid != 0)
+		fibril_add_ready(ra_fid);
+	else
+		cache->ra_stop = true;
+
 	return EOK;
 }
 
@@ -316,6 +693,19 @@ errno_t block_cache_fini(service_id_t service_id)
 		return EOK;
 	cache = devcon->cache;
 
+	/* Stop the readahead fibril first. */
+	if (!cache->ra_stop) {
+		cache->ra_stop = true;
+		fibril_semaphore_up(&cache->ra_sem);
+		fibril_semaphore_down(&cache->ra_done);
+	}
+
+	/* Stop the write-back flusher first. */
+	if ((cache->mode == CACHE_MODE_WB) && (!cache->flusher_stop)) {
+		cache->flusher_stop = true;
+		fibril_semaphore_down(&cache->flusher_done);
+	}
+
 	/*
 	 * We are expecting to find all blocks for this device handle on the
 	 * free list, i.e. the block reference count should be zero. Do not
@@ -412,6 +802,7 @@ retry:
 	b = NULL;
 
 	fibril_mutex_lock(&cache->lock);
+	cache_readahead_hint(cache, ba);
 	ht_link_t *hlink = hash_table_find(&cache->block_hash, &ba);
 	if (hlink) {
 	found:
@@ -95,7 +95,21 @@ void rela_table_process(module_t *m, elf_rela_t *rt, size_t rt_size)
 
 	DPRINTF("rel table address: 0x%zx, entries: %zd\n", (uintptr_t)rt, rt_entries);
 
-	for (i = 0; i < rt_entries; ++i) {
+	/*
+	 * The linker sorts R_X86_64_RELATIVE entries to the front of the
+	 * table and they typically make up most of it. They need neither
+	 * a symbol lookup nor a type dispatch, so fix them up in one
+	 * tight loop before the general one.
+	 */
+	i = 0;
+	while ((i < rt_entries) &&
+	    (ELF64_R_TYPE(rt[i].r_info) == R_X86_64_RELATIVE)) {
+		r_ptr = (uintptr_t *) (rt[i].r_offset + m->bias);
+		*r_ptr = rt[i].r_addend + m->bias;
+		++i;
+	}
+
+	for (; i < rt_entries; ++i) {
 #if 0
 		DPRINTF("symbol %d: ", i);
 #endif
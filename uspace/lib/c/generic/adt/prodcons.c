@@ -68,5 +68,27 @@ link_t *prodcons_consume(prodcons_t *pc)
 	return head;
 }
 
+/** Consume a queued item without blocking.
+ *
+ * Allows a consumer which is already running to drain the queue in a
+ * batch, paying the wakeup cost only once per batch.
+ *
+ * @param pc Producer-consumer queue.
+ *
+ * @return Consumed item or NULL if the queue is empty.
+ */
+link_t *prodcons_consume_try(prodcons_t *pc)
+{
+	fibril_mutex_lock(&pc->mtx);
+
+	link_t *head = list_first(&pc->list);
+	if (head != NULL)
+		list_remove(head);
+
+	fibril_mutex_unlock(&pc->mtx);
+
+	return head;
+}
+
 /** @}
  */
@@ -92,6 +92,38 @@ errno_t as_area_destroy(void *address)
 	return (errno_t) __SYSCALL1(SYS_AS_AREA_DESTROY, (sysarg_t) address);
 }
 
+/** Discard a page-aligned range of an anonymous address space area.
+ *
+ * The pages' frames are returned to the kernel; the range reads as
+ * zeroes afterwards and is backed again on first write.
+ *
+ * @param address Page-aligned start of the range.
+ * @param size    Page-aligned size of the range.
+ *
+ * @return Zero on success or an error code.
+ */
+errno_t as_area_discard(void *address, size_t size)
+{
+	return (errno_t) __SYSCALL2(SYS_AS_AREA_DISCARD, (sysarg_t) address,
+	    (sysarg_t) size);
+}
+
+/** Advise the kernel about the access pattern of an area.
+ *
+ * Sequential access widens the fault-ahead window, random access
+ * disables it.
+ *
+ * @param address Address within the area.
+ * @param advice  One of the AS_ADVISE_* values.
+ *
+ * @return Zero on success or an error code.
+ */
+errno_t as_area_advise(void *address, unsigned int advice)
+{
+	return (errno_t) __SYSCALL2(SYS_AS_AREA_ADVISE, (sysarg_t) address,
+	    (sysarg_t) advice);
+}
+
 /** Change address-space area flags.
  *
  * @param address Virtual address pointing into the address space area being
@@ -1346,6 +1346,23 @@ errno_t async_data_write_start(async_exch_t *exch, const void *src, size_t size)
 	    (sysarg_t) size);
 }
 
+/** Variant of async_data_write_start() with transfer flags.
+ *
+ * The flags (IPC_XF_*) are passed to the kernel data transfer
+ * machinery; e.g. IPC_XF_ZEROCOPY lets the kernel pin the source
+ * pages instead of copying them into a bounce buffer. The source
+ * buffer may be reused once the call returns.
+ */
+errno_t async_data_write_start_flags(async_exch_t *exch, const void *src,
+    size_t size, unsigned int flags)
+{
+	if (exch == NULL)
+		return ENOENT;
+
+	return async_req_3_0(exch, IPC_M_DATA_WRITE, (sysarg_t) src,
+	    (sysarg_t) size, (sysarg_t) flags);
+}
+
 errno_t async_state_change_start(async_exch_t *exch, sysarg_t arg1, sysarg_t arg2,
     sysarg_t arg3, async_exch_t *other_exch)
 {
@@ -37,6 +37,8 @@
  *
  */
 
+#include <align.h>
+#include <as.h>
 #include <async.h>
 #include <clipboard.h>
 #include <errno.h>
@@ -44,6 +46,8 @@
 #include <ipc/clipboard.h>
 #include <ipc/services.h>
 #include <loc.h>
+#include <macros.h>
+#include <mem.h>
 #include <stdlib.h>
 #include <str.h>
 
@@ -110,9 +114,25 @@ errno_t clipboard_put_str(const char *str)
 		return (errno_t) rc;
 	} else {
 		async_exch_t *exch = clip_exchange_begin();
-		aid_t req = async_send_1(exch, CLIPBOARD_PUT_DATA, CLIPBOARD_TAG_DATA,
-		    NULL);
-		errno_t rc = async_data_write_start(exch, (void *) str, size);
+
+		/*
+		 * Announce the total size so that contents larger than
+		 * a single IPC data transfer can be sent in chunks (and
+		 * stored by the server in a shareable area).
+		 */
+		aid_t req = async_send_2(exch, CLIPBOARD_PUT_DATA,
+		    CLIPBOARD_TAG_DATA, size, NULL);
+
+		errno_t rc = EOK;
+		size_t pos = 0;
+		while (pos < size && rc == EOK) {
+			const size_t chunk = min(size - pos,
+			    (size_t) DATA_XFER_LIMIT);
+			rc = async_data_write_start(exch, (void *) (str + pos),
+			    chunk);
+			pos += chunk;
+		}
+
 		clip_exchange_end(exch);
 
 		if (rc != EOK) {
@@ -170,6 +190,45 @@ errno_t clipboard_get_str(char **str)
 			if (sbuf == NULL)
 				return ENOMEM;
 
+			if (size >= CLIPBOARD_SHARE_THRESHOLD) {
+				/* Large contents come as a shared area. */
+				exch = clip_exchange_begin();
+				aid_t sreq = async_send_1(exch,
+				    CLIPBOARD_GET_SHARED, tag, NULL);
+				void *area = AS_AREA_ANY;
+				rc = async_share_in_start_0_0(exch,
+				    ALIGN_UP(size, PAGE_SIZE), &area);
+				clip_exchange_end(exch);
+
+				if (rc != EOK) {
+					errno_t rc_orig;
+					async_wait_for(sreq, &rc_orig);
+					if (rc_orig != EOK)
+						rc = rc_orig;
+					free(sbuf);
+					if ((errno_t) rc == EOVERFLOW) {
+						/* Contents changed, retry */
+						break;
+					}
+					return (errno_t) rc;
+				}
+
+				async_wait_for(sreq, &rc);
+				if (rc != EOK) {
+					as_area_destroy(area);
+					free(sbuf);
+					if ((errno_t) rc == EOVERFLOW)
+						break;
+					return (errno_t) rc;
+				}
+
+				memcpy(sbuf, area, size);
+				as_area_destroy(area);
+				sbuf[size] = 0;
+				*str = sbuf;
+				return EOK;
+			}
+
 			exch = clip_exchange_begin();
 			aid_t req = async_send_1(exch, CLIPBOARD_GET_DATA, tag, NULL);
 			rc = async_data_read_start(exch, (void *) sbuf, size);
@@ -180,12 +239,14 @@ errno_t clipboard_get_str(char **str)
 				 * The data in the clipboard has changed since
 				 * the last call of CLIPBOARD_CONTENT
 				 */
+				free(sbuf);
 				break;
 			}
 
 			if (rc != EOK) {
 				errno_t rc_orig;
 				async_wait_for(req, &rc_orig);
+				free(sbuf);
 				if (rc_orig == EOK)
 					return (errno_t) rc;
 				else
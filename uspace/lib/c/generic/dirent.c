@@ -46,6 +46,12 @@ struct __dirstream {
 	aoff64_t pos;
 };
 
+/** Get the file handle underlying an open directory stream */
+int dirfd(DIR *dirp)
+{
+	return dirp->fd;
+}
+
 /** Open directory.
  *
  * @param dirname Directory pathname
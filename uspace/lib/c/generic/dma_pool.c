@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ * @brief Pool allocator for physically contiguous DMA buffers.
+ *
+ * Drivers that stream data through fixed-size hardware buffers
+ * typically allocate and free them at a high rate. Mapping each
+ * buffer with dmamem_map_anonymous() costs one syscall per buffer;
+ * the pool maps larger physically contiguous chunks up front and
+ * hands out buffers by list manipulation only.
+ *
+ * When a large contiguous chunk cannot be obtained (physical memory
+ * fragmentation), the pool falls back to scatter-gather backing: it
+ * maps progressively smaller chunks, down to a single buffer per
+ * chunk. Every buffer handed out is always physically contiguous;
+ * only the pool as a whole may be scattered.
+ */
+
+#include <align.h>
+#include <as.h>
+#include <assert.h>
+#include <ddi.h>
+#include <dma_pool.h>
+#include <stdlib.h>
+
+/** One mapped chunk of physically contiguous memory. */
+typedef struct {
+	link_t link;
+	void *virt;
+	uintptr_t phys;
+	size_t size;
+	/** Bookkeeping array of this chunk's buffers. */
+	struct dma_pool_buf *bufs;
+} dma_pool_chunk_t;
+
+/** Bookkeeping of one buffer carved out of a chunk. */
+typedef struct dma_pool_buf {
+	link_t link;
+	void *virt;
+	uintptr_t phys;
+} dma_pool_buf_t;
+
+/** Map one chunk and carve it into buffers.
+ *
+ * @param pool  DMA pool.
+ * @param nbufs Number of buffers the chunk should provide.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+static errno_t dma_pool_add_chunk(dma_pool_t *pool, size_t nbufs)
+{
+	dma_pool_chunk_t *chunk = malloc(sizeof(dma_pool_chunk_t));
+	if (chunk == NULL)
+		return ENOMEM;
+
+	chunk->size = nbufs * pool->bsize;
+	chunk->virt = AS_AREA_ANY;
+
+	errno_t rc = dmamem_map_anonymous(chunk->size, pool->constraint,
+	    pool->map_flags, 0, &chunk->phys, &chunk->virt);
+	if (rc != EOK) {
+		free(chunk);
+		return rc;
+	}
+
+	dma_pool_buf_t *bufs = calloc(nbufs, sizeof(dma_pool_buf_t));
+	if (bufs == NULL) {
+		dmamem_unmap_anonymous(chunk->virt);
+		free(chunk);
+		return ENOMEM;
+	}
+
+	for (size_t i = 0; i < nbufs; i++) {
+		bufs[i].virt = chunk->virt + i * pool->bsize;
+		bufs[i].phys = chunk->phys + i * pool->bsize;
+		list_append(&bufs[i].link, &pool->free_bufs);
+	}
+
+	chunk->bufs = bufs;
+	list_append(&chunk->link, &pool->chunks);
+	return EOK;
+}
+
+/** Create a DMA buffer pool.
+ *
+ * @param pool       Pool structure to initialize.
+ * @param bsize      Size of one buffer; rounded up to a page multiple.
+ * @param nbufs      Number of buffers to provision.
+ * @param constraint Physical address constraint, as understood by
+ *                   dmamem_map_anonymous() (e.g. DMAMEM_4GiB).
+ * @param map_flags  Address space area flags for the backing memory.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+errno_t dma_pool_create(dma_pool_t *pool, size_t bsize, size_t nbufs,
+    uintptr_t constraint, unsigned int map_flags)
+{
+	pool->bsize = ALIGN_UP(bsize, PAGE_SIZE);
+	pool->constraint = constraint;
+	pool->map_flags = map_flags;
+
+	list_initialize(&pool->chunks);
+	list_initialize(&pool->free_bufs);
+	list_initialize(&pool->busy_bufs);
+	fibril_mutex_initialize(&pool->lock);
+
+	/*
+	 * Try to back the pool with as few contiguous chunks as
+	 * possible; halve the chunk size whenever contiguous memory
+	 * is not available (the scatter-gather fallback). A chunk of
+	 * a single buffer must always be attempted since individual
+	 * buffers are required to be contiguous.
+	 */
+	size_t remaining = nbufs;
+	size_t chunk_bufs = nbufs;
+
+	while (remaining > 0) {
+		if (chunk_bufs > remaining)
+			chunk_bufs = remaining;
+
+		errno_t rc = dma_pool_add_chunk(pool, chunk_bufs);
+		if (rc == EOK) {
+			remaining -= chunk_bufs;
+			continue;
+		}
+
+		if (chunk_bufs == 1) {
+			dma_pool_destroy(pool);
+			return rc;
+		}
+
+		chunk_bufs /= 2;
+	}
+
+	return EOK;
+}
+
+/** Destroy a DMA buffer pool.
+ *
+ * All buffers must have been returned to the pool.
+ *
+ * @param pool Pool to destroy.
+ *
+ */
+void dma_pool_destroy(dma_pool_t *pool)
+{
+	assert(list_empty(&pool->busy_bufs));
+
+	/*
+	 * The buffer bookkeeping of each chunk is one array owned by
+	 * the chunk; unhook the free list first, then tear the chunks
+	 * down.
+	 */
+	list_foreach_safe(pool->free_bufs, cur, next) {
+		list_remove(cur);
+	}
+
+	list_foreach_safe(pool->chunks, cur, next) {
+		dma_pool_chunk_t *chunk = list_get_instance(cur,
+		    dma_pool_chunk_t, link);
+
+		list_remove(cur);
+		dmamem_unmap_anonymous(chunk->virt);
+		free(chunk->bufs);
+		free(chunk);
+	}
+}
+
+/** Allocate a buffer from the pool.
+ *
+ * @param pool Pool to allocate from.
+ * @param virt Place to store the virtual address of the buffer.
+ * @param phys Place to store the physical address of the buffer.
+ *
+ * @return EOK on success, ENOMEM when the pool is exhausted.
+ *
+ */
+errno_t dma_pool_alloc(dma_pool_t *pool, void **virt, uintptr_t *phys)
+{
+	fibril_mutex_lock(&pool->lock);
+
+	link_t *link = list_first(&pool->free_bufs);
+	if (link == NULL) {
+		fibril_mutex_unlock(&pool->lock);
+		return ENOMEM;
+	}
+
+	list_remove(link);
+
+	dma_pool_buf_t *buf = list_get_instance(link, dma_pool_buf_t, link);
+	list_append(&buf->link, &pool->busy_bufs);
+
+	fibril_mutex_unlock(&pool->lock);
+
+	*virt = buf->virt;
+	*phys = buf->phys;
+	return EOK;
+}
+
+/** Return a buffer to the pool.
+ *
+ * @param pool Pool the buffer was allocated from.
+ * @param virt Virtual address of the buffer.
+ *
+ */
+void dma_pool_free(dma_pool_t *pool, void *virt)
+{
+	fibril_mutex_lock(&pool->lock);
+
+	list_foreach(pool->busy_bufs, link, dma_pool_buf_t, buf) {
+		if (buf->virt == virt) {
+			list_remove(&buf->link);
+			list_append(&buf->link, &pool->free_bufs);
+			fibril_mutex_unlock(&pool->lock);
+			return;
+		}
+	}
+
+	assert(false);
+}
@@ -54,14 +54,14 @@
  * @param info Place to store ELF program information
  * @return EOK on success or an error code
  */
-errno_t elf_load(int file, elf_info_t *info)
+errno_t elf_load(int file, eld_flags_t flags, elf_info_t *info)
 {
 #ifdef CONFIG_RTLD
 	rtld_t *env;
 #endif
 	errno_t rc;
 
-	rc = elf_load_file(file, 0, &info->finfo);
+	rc = elf_load_file(file, flags, &info->finfo);
 	if (rc != EOK) {
 		DPRINTF("Failed to load executable '%s'.\n", file_name);
 		return rc;
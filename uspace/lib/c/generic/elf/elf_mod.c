@@ -43,6 +43,7 @@
  * the segments will be mapped directly from the file.
  */
 
+#include <async.h>
 #include <errno.h>
 #include <stdio.h>
 #include <vfs/vfs.h>
@@ -53,7 +54,9 @@
 #include <as.h>
 #include <elf/elf.h>
 #include <smc.h>
+#include <ipc/services.h>
 #include <loader/pcb.h>
+#include <ns.h>
 #include <entry_point.h>
 #include <str_error.h>
 #include <stdlib.h>
@@ -98,10 +101,18 @@ errno_t elf_load_file(int file, eld_flags_t flags, elf_finfo_t *info)
 	elf.fd = ofile;
 	elf.info = info;
 	elf.flags = flags;
+	elf.paged = false;
 
 	rc = elf_load_module(&elf);
 
-	vfs_put(ofile);
+	/*
+	 * Demand-paged segments keep faulting pages in from the file
+	 * for as long as the module is mapped, so the descriptor must
+	 * stay open.
+	 */
+	if (!elf.paged || rc != EOK)
+		vfs_put(ofile);
+
 	return rc;
 }
 
@@ -432,6 +443,36 @@ errno_t load_segment(elf_ld_t *elf, elf_segment_header_t *entry)
 	    (void *) (entry->p_vaddr + bias +
 	    ALIGN_UP(entry->p_memsz, PAGE_SIZE)));
 
+	/*
+	 * Non-writable segments that the loader itself does not modify
+	 * are mapped with the VFS pager backing them instead of being
+	 * read in eagerly: pages are faulted in from the file as the
+	 * program touches them. This needs the file offset of the page
+	 * holding the segment start, which exists whenever the segment
+	 * is at least page-aligned within the file.
+	 */
+	if (((elf->flags & ELDF_PAGED) != 0) &&
+	    ((entry->p_flags & PF_W) == 0) &&
+	    ((elf->flags & ELDF_RW) == 0) &&
+	    (entry->p_filesz == entry->p_memsz) &&
+	    (entry->p_offset >= (entry->p_vaddr - base))) {
+		errno_t drc;
+		async_sess_t *pager_sess = service_connect_cached(SERVICE_VFS,
+		    INTERFACE_PAGER, 0, &drc);
+
+		if (pager_sess != NULL) {
+			a = async_as_area_create((uint8_t *) base + bias,
+			    mem_sz, flags, pager_sess, elf->fd,
+			    entry->p_offset - (entry->p_vaddr - base), 0);
+			if (a != AS_MAP_FAILED) {
+				elf->paged = true;
+				return EOK;
+			}
+
+			DPRINTF("paged mapping failed, falling back\n");
+		}
+	}
+
 	/*
 	 * For the course of loading, the area needs to be readable
 	 * and writeable.
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/**
+ * @file
+ */
+
+#include <evmux.h>
+
+/** Initialize an event multiplexer */
+void evmux_initialize(evmux_t *mux)
+{
+	fibril_mutex_initialize(&mux->lock);
+	fibril_condvar_initialize(&mux->cv);
+	list_initialize(&mux->ready);
+	mux->closed = false;
+}
+
+/** Initialize an event source.
+ *
+ * @param src Source to initialize.
+ * @param mux Multiplexer the source reports to.
+ * @param arg User cookie stored with the source.
+ */
+void evmux_src_initialize(evmux_src_t *src, evmux_t *mux, void *arg)
+{
+	link_initialize(&src->link);
+	src->mux = mux;
+	src->arg = arg;
+	src->events = 0;
+	src->queued = false;
+}
+
+/** Post readiness of a source.
+ *
+ * Safe to call from any fibril (e.g. a protocol callback). Posting
+ * an already pending source merges the event bits instead of
+ * queueing it twice.
+ *
+ * @param src Ready source.
+ * @param events Event bits to merge (caller-defined).
+ */
+void evmux_post(evmux_src_t *src, unsigned events)
+{
+	evmux_t *mux = src->mux;
+
+	fibril_mutex_lock(&mux->lock);
+	src->events |= events;
+
+	if (!src->queued) {
+		src->queued = true;
+		list_append(&src->link, &mux->ready);
+		fibril_condvar_signal(&mux->cv);
+	}
+
+	fibril_mutex_unlock(&mux->lock);
+}
+
+/** Withdraw a source's pending events (e.g. before destroying it) */
+void evmux_retract(evmux_src_t *src)
+{
+	evmux_t *mux = src->mux;
+
+	fibril_mutex_lock(&mux->lock);
+	if (src->queued) {
+		list_remove(&src->link);
+		src->queued = false;
+	}
+	src->events = 0;
+	fibril_mutex_unlock(&mux->lock);
+}
+
+/** Collect ready sources; the lock is held. */
+static size_t evmux_collect(evmux_t *mux, evmux_src_t **srcs, size_t n)
+{
+	size_t cnt = 0;
+	link_t *link;
+
+	while (cnt < n && (link = list_first(&mux->ready)) != NULL) {
+		evmux_src_t *src = list_get_instance(link, evmux_src_t, link);
+
+		list_remove(link);
+		src->queued = false;
+		srcs[cnt++] = src;
+		/*
+		 * The collected bits stay in src->events for the
+		 * consumer to read and reset; a racing post after
+		 * this point queues the source anew.
+		 */
+	}
+
+	return cnt;
+}
+
+/** Wait for any sources to become ready.
+ *
+ * Blocks until at least one source is ready or the multiplexer is
+ * closed. Up to @a n ready sources are returned in one batch; each
+ * carries its merged event bits in @c events (the consumer resets
+ * them).
+ *
+ * @param mux Multiplexer.
+ * @param srcs Array for the ready sources.
+ * @param n Capacity of the array.
+ *
+ * @return Number of ready sources, zero when closed.
+ */
+size_t evmux_wait(evmux_t *mux, evmux_src_t **srcs, size_t n)
+{
+	size_t cnt;
+
+	fibril_mutex_lock(&mux->lock);
+
+	while (list_empty(&mux->ready) && !mux->closed)
+		fibril_condvar_wait(&mux->cv, &mux->lock);
+
+	cnt = evmux_collect(mux, srcs, n);
+	fibril_mutex_unlock(&mux->lock);
+
+	return cnt;
+}
+
+/** Like evmux_wait(), giving up after a timeout.
+ *
+ * @param mux Multiplexer.
+ * @param srcs Array for the ready sources.
+ * @param n Capacity of the array.
+ * @param timeout Timeout in microseconds.
+ * @param cnt Number of collected sources is stored here.
+ *
+ * @return EOK on success (including a close), ETIMEOUT on timeout.
+ */
+errno_t evmux_wait_timeout(evmux_t *mux, evmux_src_t **srcs, size_t n,
+    usec_t timeout, size_t *cnt)
+{
+	fibril_mutex_lock(&mux->lock);
+
+	while (list_empty(&mux->ready) && !mux->closed) {
+		errno_t rc = fibril_condvar_wait_timeout(&mux->cv, &mux->lock,
+		    timeout);
+		if (rc == ETIMEOUT) {
+			fibril_mutex_unlock(&mux->lock);
+			*cnt = 0;
+			return ETIMEOUT;
+		}
+	}
+
+	*cnt = evmux_collect(mux, srcs, n);
+	fibril_mutex_unlock(&mux->lock);
+
+	return EOK;
+}
+
+/** Close the multiplexer; waiters return with zero sources. */
+void evmux_close(evmux_t *mux)
+{
+	fibril_mutex_lock(&mux->lock);
+	mux->closed = true;
+	fibril_condvar_broadcast(&mux->cv);
+	fibril_mutex_unlock(&mux->lock);
+}
+
+/** @}
+ */
@@ -34,6 +34,7 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <mem.h>
 #include <str.h>
 #include <errno.h>
 #include <limits.h>
@@ -696,6 +697,24 @@ size_t fwrite(const void *buf, size_t size, size_t nmemb, FILE *stream)
 	total_written = 0;
 	need_flush = false;
 
+	/*
+	 * Writes at least as large as the buffer bypass it entirely:
+	 * pending buffered bytes are flushed first and the payload is
+	 * written directly afterwards, so the two pieces go out back
+	 * to back (gather) instead of the payload being copied
+	 * through the buffer one buffer-full at a time.
+	 */
+	if ((stream->btype == _IOFBF) && (bytes_left >= stream->buf_size)) {
+		if (stream->buf_state == _bs_write)
+			_fflushbuf(stream);
+
+		if (stream->error)
+			return 0;
+
+		now = _fwrite(data, 1, bytes_left, stream);
+		return now / size;
+	}
+
 	while ((!stream->error) && (bytes_left > 0)) {
 		buf_free = stream->buf_size - (stream->buf_head - stream->buf);
 		if (bytes_left > buf_free)
@@ -703,12 +722,17 @@ size_t fwrite(const void *buf, size_t size, size_t nmemb, FILE *stream)
 		else
 			now = bytes_left;
 
-		for (i = 0; i < now; i++) {
-			b = data[i];
-			stream->buf_head[i] = b;
-
-			if ((b == '\n') && (stream->btype == _IOLBF))
-				need_flush = true;
+		if (stream->btype == _IOLBF) {
+			for (i = 0; i < now; i++) {
+				b = data[i];
+				stream->buf_head[i] = b;
+
+				if (b == '\n')
+					need_flush = true;
+			}
+		} else {
+			/* No newline scan needed; copy in bulk. */
+			memcpy(stream->buf_head, data, now);
 		}
 
 		data += now;
@@ -452,6 +452,53 @@ static int print_number(uint64_t num, int width, int precision, int base,
 	if (num == 0) {
 		*ptr-- = '0';
 		size++;
+	} else if (base == 10) {
+		/*
+		 * Fast path for the overwhelmingly common decimal
+		 * case: emitting two digits per division halves the
+		 * number of 64-bit divisions.
+		 */
+		static const char dec_pairs[] =
+		    "00010203040506070809"
+		    "10111213141516171819"
+		    "20212223242526272829"
+		    "30313233343536373839"
+		    "40414243444546474849"
+		    "50515253545556575859"
+		    "60616263646566676869"
+		    "70717273747576777879"
+		    "80818283848586878889"
+		    "90919293949596979899";
+
+		while (num >= 100) {
+			unsigned int rem = (unsigned int) (num % 100) * 2;
+			num /= 100;
+			*ptr-- = dec_pairs[rem + 1];
+			*ptr-- = dec_pairs[rem];
+			size += 2;
+		}
+
+		if (num >= 10) {
+			unsigned int rem = (unsigned int) num * 2;
+			*ptr-- = dec_pairs[rem + 1];
+			*ptr-- = dec_pairs[rem];
+			size += 2;
+		} else {
+			*ptr-- = (char) ('0' + num);
+			size++;
+		}
+	} else if ((base & (base - 1)) == 0) {
+		/*
+		 * Power-of-two bases need no division at all.
+		 */
+		unsigned int shift = (base == 16) ? 4 :
+		    ((base == 8) ? 3 : 1);
+		unsigned int mask = (unsigned int) base - 1;
+
+		do {
+			*ptr-- = digits[num & mask];
+			size++;
+		} while (num >>= shift);
 	} else {
 		do {
 			*ptr-- = digits[num % base];
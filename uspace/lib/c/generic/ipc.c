@@ -109,6 +109,25 @@ errno_t ipc_call_async_slow(cap_phone_handle_t phandle, sysarg_t imethod,
 	    (sysarg_t) label);
 }
 
+/** Make a batch of asynchronous calls over one phone.
+ *
+ * Sends up to IPC_CALL_BATCH_LIMIT prepared calls with a single
+ * kernel entry. The batch stops at the first entry that cannot be
+ * sent; *sent receives the number of entries actually sent.
+ *
+ * @param phandle Phone handle for the calls.
+ * @param batch   Array of prepared batch entries.
+ * @param count   Number of entries in the array.
+ * @param sent    Place to store the number of sent entries.
+ */
+errno_t ipc_call_async_batch(cap_phone_handle_t phandle,
+    ipc_call_batch_entry_t *batch, size_t count, size_t *sent)
+{
+	return (errno_t) __SYSCALL4(SYS_IPC_CALL_ASYNC_BATCH,
+	    cap_handle_raw(phandle), (sysarg_t) batch, (sysarg_t) count,
+	    (sysarg_t) sent);
+}
+
 /** Answer received call (fast version).
  *
  * The fast answer makes use of passing retval and first four arguments in
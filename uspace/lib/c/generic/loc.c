@@ -608,6 +608,25 @@ static size_t loc_count_namespaces_internal(async_exch_t *exch)
 	return count;
 }
 
+/** Get the current namespace generation.
+ *
+ * The generation is incremented by the location service on every
+ * change of the service/category namespace. A consumer reacting to
+ * category change events can remember the generation of its last
+ * sweep and skip re-reading the lists when it has not moved.
+ *
+ * @param rgen		Place to store the generation number
+ * @return		EOK on success or an error code
+ */
+errno_t loc_get_generation(sysarg_t *rgen)
+{
+	async_exch_t *exch = loc_exchange_begin_blocking(INTERFACE_LOC_CONSUMER);
+	errno_t retval = async_req_0_1(exch, LOC_GET_GENERATION, rgen);
+	loc_exchange_end(exch);
+
+	return retval;
+}
+
 /** Add service to category.
  *
  * @param svc_id	Service ID
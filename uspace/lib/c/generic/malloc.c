@@ -207,6 +207,39 @@ static_assert(BASE_ALIGN >= alignof(heap_block_head_t), "");
 static_assert(BASE_ALIGN >= alignof(heap_block_foot_t), "");
 static_assert(BASE_ALIGN >= alignof(max_align_t), "");
 
+/*
+ * Per-fibril front cache of small allocations.
+ *
+ * Small requests are rounded up to a power-of-two size class; freed
+ * blocks of exactly one class size are parked in a small per-fibril
+ * bin instead of being returned to the heap. A subsequent allocation
+ * of the same class pops the block without taking the heap lock or
+ * touching the shared freelists at all. Blocks cached here remain
+ * marked allocated in the heap metadata, so no other path can hand
+ * them out. An exiting fibril returns its bins to the heap via
+ * __malloc_fibril_fini(), before its fibril-local storage is freed.
+ */
+#define CACHE_CLASS_MIN_W   4   /* Smallest class: 16 bytes */
+#define CACHE_CLASS_COUNT   8   /* Classes: 16 B .. 2 KiB */
+#define CACHE_DEPTH         8   /* Blocks kept per class */
+
+#define CACHE_CLASS_MAX_SIZE \
+	((size_t) 1 << (CACHE_CLASS_MIN_W + CACHE_CLASS_COUNT - 1))
+
+static fibril_local void *cache_bins[CACHE_CLASS_COUNT][CACHE_DEPTH];
+static fibril_local size_t cache_fill[CACHE_CLASS_COUNT];
+
+/** Return the size class index for an allocation size. */
+static size_t cache_class(size_t size)
+{
+	size_t w = fnzb(size - 1) + 1;
+
+	if (w < CACHE_CLASS_MIN_W)
+		w = CACHE_CLASS_MIN_W;
+
+	return w - CACHE_CLASS_MIN_W;
+}
+
 /** Serializes access to the heap from multiple threads. */
 static inline void heap_lock(void)
 {
@@ -801,6 +834,24 @@ void *calloc(const size_t nmemb, const size_t size)
  */
 void *malloc(const size_t size)
 {
+	/*
+	 * Small requests are rounded up to their size class and
+	 * preferably served from the per-thread cache.
+	 */
+	if ((size > 0) && (size <= CACHE_CLASS_MAX_SIZE)) {
+		size_t idx = cache_class(size);
+
+		if (cache_fill[idx] > 0)
+			return cache_bins[idx][--cache_fill[idx]];
+
+		heap_lock();
+		void *block = malloc_internal(
+		    (size_t) 1 << (idx + CACHE_CLASS_MIN_W), BASE_ALIGN);
+		heap_unlock();
+
+		return block;
+	}
+
 	heap_lock();
 	void *block = malloc_internal(size, BASE_ALIGN);
 	heap_unlock();
@@ -948,18 +999,15 @@ void *realloc(void *const addr, const size_t size)
 	return ptr;
 }
 
-/** Free a memory block
+/** Return a block to the heap proper.
+ *
+ * Should be called only inside the critical section.
  *
  * @param addr The address of the block.
  *
  */
-void free(void *const addr)
+static void free_unlocked(void *addr)
 {
-	if (addr == NULL)
-		return;
-
-	heap_lock();
-
 	/* Calculate the position of the header. */
 	heap_block_head_t *head =
 	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
@@ -1002,6 +1050,62 @@ void free(void *const addr)
 	}
 
 	heap_shrink(area);
+}
+
+/** Free a memory block
+ *
+ * @param addr The address of the block.
+ *
+ */
+void free(void *const addr)
+{
+	if (addr == NULL)
+		return;
+
+	/* Calculate the position of the header. */
+	heap_block_head_t *head =
+	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
+
+	/*
+	 * Park blocks of exactly one cache class size in the
+	 * per-fibril bin. Reading our own allocated block's header
+	 * needs no lock.
+	 */
+	block_check(head);
+	size_t net_size = NET_SIZE(head->size);
+
+	if ((net_size >= ((size_t) 1 << CACHE_CLASS_MIN_W)) &&
+	    (net_size <= CACHE_CLASS_MAX_SIZE) &&
+	    ((net_size & (net_size - 1)) == 0)) {
+		size_t idx = cache_class(net_size);
+
+		if (cache_fill[idx] < CACHE_DEPTH) {
+			cache_bins[idx][cache_fill[idx]++] = addr;
+			return;
+		}
+	}
+
+	heap_lock();
+	free_unlocked(addr);
+	heap_unlock();
+}
+
+/** Flush the calling fibril's front cache back to the heap.
+ *
+ * The bins live in fibril-local storage, which is freed along with
+ * the fibril without any destructor running; a fibril that exits
+ * with parked blocks would leak them for good. Called on the dying
+ * fibril, while its TCB is still live.
+ *
+ */
+void __malloc_fibril_fini(void)
+{
+	heap_lock();
+
+	for (size_t idx = 0; idx < CACHE_CLASS_COUNT; idx++) {
+		while (cache_fill[idx] > 0)
+			free_unlocked(cache_bins[idx][--cache_fill[idx]]);
+	}
 
 	heap_unlock();
 }
@@ -34,7 +34,10 @@
 
 #include <ns.h>
 #include <ipc/ns.h>
+#include <adt/list.h>
 #include <async.h>
+#include <fibril_synch.h>
+#include <stdlib.h>
 #include <macros.h>
 #include <errno.h>
 #include "private/ns.h"
@@ -44,6 +47,26 @@
  * actual communicaton
  */
 static async_sess_t *sess_ns = NULL;
+static FIBRIL_MUTEX_INITIALIZE(sess_ns_mutex);
+
+/*
+ * Session cache for service_connect_cached(). Connecting to a service
+ * means a round-trip through the naming service, which short-lived
+ * tasks pay several times before doing useful work. Sessions stored
+ * here are owned by the cache and live for the rest of the task, the
+ * same way individual libc modules keep their private sessions; a
+ * caller therefore must never hang a cached session up.
+ */
+typedef struct {
+	link_t link;
+	service_t service;
+	iface_t iface;
+	sysarg_t arg3;
+	async_sess_t *sess;
+} ns_sess_cache_entry_t;
+
+static LIST_INITIALIZE(sess_cache);
+static FIBRIL_MUTEX_INITIALIZE(sess_cache_mutex);
 
 errno_t service_register(service_t service, iface_t iface,
     async_port_handler_t handler, void *data)
@@ -177,6 +200,59 @@ async_sess_t *service_connect_blocking(service_t service, iface_t iface,
 	return csess;
 }
 
+/** Connect to a singleton service, reusing a cached session.
+ *
+ * Unlike service_connect(), repeat calls with the same arguments skip
+ * the naming service and return the session established by the first
+ * call. The session is shared and owned by the cache: it must not be
+ * passed to async_hangup() and stateful exchanges on it must be
+ * serialized by the caller as usual.
+ *
+ * @param service Singleton service ID.
+ * @param iface   Interface to connect to.
+ * @param arg3    Custom connection argument.
+ * @param rc      Placeholder for return code. Unused if NULL.
+ *
+ * @return Shared session on success or NULL on error.
+ *
+ */
+async_sess_t *service_connect_cached(service_t service, iface_t iface,
+    sysarg_t arg3, errno_t *rc)
+{
+	fibril_mutex_lock(&sess_cache_mutex);
+
+	list_foreach(sess_cache, link, ns_sess_cache_entry_t, entry) {
+		if ((entry->service == service) && (entry->iface == iface) &&
+		    (entry->arg3 == arg3)) {
+			fibril_mutex_unlock(&sess_cache_mutex);
+			return entry->sess;
+		}
+	}
+
+	async_sess_t *sess = service_connect(service, iface, arg3, rc);
+
+	if (sess != NULL) {
+		ns_sess_cache_entry_t *entry = malloc(sizeof(*entry));
+
+		/*
+		 * On allocation failure the session is handed out
+		 * uncached; the task is out of memory anyway, so one
+		 * unreleasable session is the least of its problems.
+		 */
+		if (entry != NULL) {
+			link_initialize(&entry->link);
+			entry->service = service;
+			entry->iface = iface;
+			entry->arg3 = arg3;
+			entry->sess = sess;
+			list_append(&entry->link, &sess_cache);
+		}
+	}
+
+	fibril_mutex_unlock(&sess_cache_mutex);
+	return sess;
+}
+
 errno_t ns_ping(void)
 {
 	errno_t rc;
@@ -209,14 +285,19 @@ async_sess_t *ns_session_get(errno_t *rc)
 {
 	async_exch_t *exch;
 
+	fibril_mutex_lock(&sess_ns_mutex);
+
 	if (sess_ns == NULL) {
 		exch = async_exchange_begin(&session_ns);
 		sess_ns = async_connect_me_to(exch, 0, 0, 0, rc);
 		async_exchange_end(exch);
-		if (sess_ns == NULL)
+		if (sess_ns == NULL) {
+			fibril_mutex_unlock(&sess_ns_mutex);
 			return NULL;
+		}
 	}
 
+	fibril_mutex_unlock(&sess_ns_mutex);
 	return sess_ns;
 }
 
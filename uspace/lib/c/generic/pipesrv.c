@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/**
+ * @file Client interface to the anonymous pipe service.
+ */
+
+#include <async.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <ipc/pipesrv.h>
+#include <loc.h>
+#include <pipesrv.h>
+#include <stdio.h>
+#include <vfs/vfs.h>
+#include <stdlib.h>
+
+static FIBRIL_MUTEX_INITIALIZE(pipesrv_mutex);
+static async_sess_t *pipesrv_sess = NULL;
+
+/** Start an async exchange on the pipe service control session */
+static async_exch_t *pipesrv_exchange_begin(void)
+{
+	service_id_t sid;
+	errno_t rc;
+
+	fibril_mutex_lock(&pipesrv_mutex);
+
+	if (pipesrv_sess == NULL) {
+		rc = loc_service_get_id(PIPESRV_CTL_SERVICE, &sid, 0);
+		if (rc != EOK) {
+			fibril_mutex_unlock(&pipesrv_mutex);
+			return NULL;
+		}
+
+		pipesrv_sess = loc_service_connect(sid, INTERFACE_ANY, 0);
+	}
+
+	fibril_mutex_unlock(&pipesrv_mutex);
+
+	if (pipesrv_sess == NULL)
+		return NULL;
+
+	return async_exchange_begin(pipesrv_sess);
+}
+
+/** Create an anonymous pipe.
+ *
+ * On success the pipe's ends exist as location services; use
+ * pipesrv_paths() to get the file system paths to open.
+ *
+ * @param id Place to store the pipe identifier.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+errno_t pipesrv_create(int *id)
+{
+	async_exch_t *exch = pipesrv_exchange_begin();
+	if (exch == NULL)
+		return ENOENT;
+
+	sysarg_t pipe_id;
+	errno_t rc = async_req_0_1(exch, PIPESRV_CREATE, &pipe_id);
+	async_exchange_end(exch);
+
+	if (rc != EOK)
+		return rc;
+
+	*id = (int) pipe_id;
+	return EOK;
+}
+
+/** Create a pipe and open both ends.
+ *
+ * The classic pipe shape: @a *rfd reads what is written to
+ * @a *wfd, with blocking FIFO semantics provided by the pipe
+ * service's ring buffer. Both ends are ordinary file handles and
+ * can be passed to spawned tasks.
+ *
+ * @param rfd Place to store the read end's file handle.
+ * @param wfd Place to store the write end's file handle.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+errno_t pipesrv_pipe(int *rfd, int *wfd)
+{
+	char *rpath = NULL;
+	char *wpath = NULL;
+	int id;
+
+	errno_t rc = pipesrv_create(&id);
+	if (rc != EOK)
+		return rc;
+
+	rc = pipesrv_paths(id, &rpath, &wpath);
+	if (rc != EOK)
+		return rc;
+
+	/* Open the write end first so readers never see EOF early. */
+	rc = vfs_lookup_open(wpath, WALK_REGULAR, MODE_WRITE, wfd);
+	if (rc != EOK)
+		goto out;
+
+	rc = vfs_lookup_open(rpath, WALK_REGULAR, MODE_READ, rfd);
+	if (rc != EOK) {
+		vfs_put(*wfd);
+		goto out;
+	}
+
+out:
+	free(rpath);
+	free(wpath);
+	return rc;
+}
+
+/** Get the locfs paths of a pipe's read and write ends.
+ *
+ * Both paths are newly allocated and must be freed by the caller.
+ *
+ * @param id Pipe identifier from pipesrv_create().
+ * @param rpath Place to store the read end path.
+ * @param wpath Place to store the write end path.
+ *
+ * @return EOK on success, ENOMEM on allocation failure.
+ *
+ */
+errno_t pipesrv_paths(int id, char **rpath, char **wpath)
+{
+	if (asprintf(rpath, "/loc/pipe/%dr", id) < 0)
+		return ENOMEM;
+
+	if (asprintf(wpath, "/loc/pipe/%dw", id) < 0) {
+		free(*rpath);
+		*rpath = NULL;
+		return ENOMEM;
+	}
+
+	return EOK;
+}
+
+/** @}
+ */
@@ -71,6 +71,10 @@ struct fibril {
 	int rmutex_locks;
 	fibril_owner_info_t *waits_for;
 	fibril_event_t *sleep_event;
+
+	/* Profiling counters, see fibril_get_profile(). */
+	nsec_t cpu_time;
+	size_t switches;
 };
 
 extern fibril_t *fibril_alloc(void);
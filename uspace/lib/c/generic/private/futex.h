@@ -46,7 +46,8 @@
 
 typedef struct futex {
 	volatile atomic_int val;
-	volatile cap_waitq_handle_t whandle;
+	/** Kernel wait queue, allocated lazily on first contention. */
+	_Atomic(cap_waitq_handle_t) whandle;
 
 #ifdef CONFIG_DEBUG_FUTEX
 	_Atomic(fibril_t *) owner;
@@ -57,9 +58,11 @@ extern errno_t futex_initialize(futex_t *futex, int value);
 
 static inline errno_t futex_destroy(futex_t *futex)
 {
-	if (futex->whandle) {
+	cap_waitq_handle_t whandle = futex->whandle;
+
+	if (whandle != CAP_NIL) {
 		errno_t rc;
-		rc = __SYSCALL1(SYS_WAITQ_DESTROY, (sysarg_t) futex->whandle);
+		rc = __SYSCALL1(SYS_WAITQ_DESTROY, (sysarg_t) whandle);
 		futex->whandle = CAP_NIL;
 		return rc;
 	}
@@ -95,9 +98,33 @@ void __futex_give_to(futex_t *, void *, const char *);
 
 #endif
 
+/** Make sure the futex has its kernel wait queue.
+ *
+ * The wait queue is allocated lazily, on the first contended
+ * operation, so uncontended futexes never enter the kernel at all.
+ * Racing allocators are resolved by a compare-and-swap; the loser
+ * destroys its extra wait queue.
+ */
 static inline errno_t futex_allocate_waitq(futex_t *futex)
 {
-	return __SYSCALL1(SYS_WAITQ_CREATE, (sysarg_t) &futex->whandle);
+	if (atomic_load_explicit(&futex->whandle,
+	    memory_order_acquire) != CAP_NIL)
+		return EOK;
+
+	cap_waitq_handle_t whandle;
+	errno_t rc = __SYSCALL1(SYS_WAITQ_CREATE, (sysarg_t) &whandle);
+	if (rc != EOK)
+		return rc;
+
+	cap_waitq_handle_t expected = CAP_NIL;
+	if (!atomic_compare_exchange_strong_explicit(&futex->whandle,
+	    &expected, whandle, memory_order_acq_rel,
+	    memory_order_acquire)) {
+		/* Someone else published a wait queue first. */
+		__SYSCALL1(SYS_WAITQ_DESTROY, (sysarg_t) whandle);
+	}
+
+	return EOK;
 }
 
 /** Down the futex with timeout, composably.
@@ -121,9 +148,27 @@ static inline errno_t futex_down_composable(futex_t *futex,
 {
 	// TODO: Add tests for this.
 
-	assert(futex->whandle != CAP_NIL);
+	/*
+	 * The wait queue must be published before our decrement can
+	 * be observed; otherwise a concurrent futex_up() could find
+	 * no queue to wake and the wakeup would be lost. The acq_rel
+	 * ordering on the decrement pairs with the one in futex_up().
+	 */
+	errno_t rc = futex_allocate_waitq(futex);
+	if (rc != EOK) {
+		/*
+		 * Consume the token anyway: callers such as
+		 * futex_down_timeout() compensate every failure with
+		 * futex_up(), so returning without the decrement
+		 * would mint a token out of thin air.
+		 */
+		atomic_fetch_sub_explicit(&futex->val, 1,
+		    memory_order_acq_rel);
+		return rc;
+	}
 
-	if (atomic_fetch_sub_explicit(&futex->val, 1, memory_order_acquire) > 0)
+	if (atomic_fetch_sub_explicit(&futex->val, 1,
+	    memory_order_acq_rel) > 0)
 		return EOK;
 
 	/* There wasn't any token. We must defer to the underlying semaphore. */
@@ -162,8 +207,14 @@ static inline errno_t futex_down_composable(futex_t *futex,
  */
 static inline errno_t futex_up(futex_t *futex)
 {
-	if (atomic_fetch_add_explicit(&futex->val, 1, memory_order_release) < 0)
-		return __SYSCALL1(SYS_WAITQ_WAKEUP, (sysarg_t) futex->whandle);
+	/*
+	 * acq_rel: when we observe a waiter (negative value), we must
+	 * also observe the wait queue it published before decrementing.
+	 */
+	if (atomic_fetch_add_explicit(&futex->val, 1,
+	    memory_order_acq_rel) < 0)
+		return __SYSCALL1(SYS_WAITQ_WAKEUP,
+		    (sysarg_t) futex->whandle);
 
 	return EOK;
 }
@@ -47,6 +47,7 @@ extern errno_t thread_create(void (*)(void *), void *, const char *,
     thread_id_t *);
 extern void thread_exit(int) __attribute__((noreturn));
 extern void thread_detach(thread_id_t);
+extern errno_t thread_set_realtime(bool);
 extern thread_id_t thread_get_id(void);
 extern void thread_usleep(usec_t);
 extern void thread_sleep(sec_t);
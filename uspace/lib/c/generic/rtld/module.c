@@ -209,7 +209,21 @@ module_t *module_load(rtld_t *rtld, const char *name, mlflags_t flags)
 
 	DPRINTF("filename:'%s'\n", name_buf);
 
-	rc = elf_load_file_name(name_buf, RTLD_MODULE_LDF, &info);
+	/*
+	 * Same rule as the program loader applies to the program's
+	 * libraries: regular applications have read-only library
+	 * segments demand-paged, which also means the pager's page
+	 * cache keys them by the library file, so every task mapping
+	 * the same library physically shares one copy of its text.
+	 * Servers and drivers that may themselves sit in the paging
+	 * path keep loading eagerly.
+	 */
+	eld_flags_t ldf = RTLD_MODULE_LDF;
+	if (__pcb != NULL && __pcb->argv != NULL && __pcb->argv[0] != NULL &&
+	    str_test_prefix(__pcb->argv[0], "/app/"))
+		ldf |= ELDF_PAGED;
+
+	rc = elf_load_file_name(name_buf, ldf, &info);
 	if (rc != EOK) {
 		DPRINTF("Failed to load '%s'\n", name_buf);
 		goto error;
@@ -33,6 +33,8 @@
 /** @file
  */
 
+#include <as.h>
+#include <ddi.h>
 #include <stats.h>
 #include <sysinfo.h>
 #include <errno.h>
@@ -262,6 +264,17 @@ stats_exc_t *stats_get_exception(unsigned int excn)
 	return stats_exception;
 }
 
+/** Kernel uptime page with sampled load averages.
+ *
+ * The layout mirrors the kernel's uptime_t.
+ */
+static struct {
+	volatile sysarg_t seconds1;
+	volatile sysarg_t useconds;
+	volatile sysarg_t seconds2;
+	volatile sysarg_t load[3];
+} *kstats = NULL;
+
 /** Get system load
  *
  * @param count Number of load records returned.
@@ -273,6 +286,32 @@ stats_exc_t *stats_get_exception(unsigned int excn)
  */
 load_t *stats_get_load(size_t *count)
 {
+	/*
+	 * Sample the load averages straight from the kernel's shared
+	 * uptime page when it can be mapped, avoiding the kernel
+	 * entry and data copy of the sysinfo protocol on every call.
+	 */
+	if (kstats == NULL) {
+		uintptr_t faddr;
+		if (sysinfo_get_value("clock.faddr", &faddr) == EOK) {
+			void *addr = AS_AREA_ANY;
+			if (physmem_map(faddr, 1,
+			    AS_AREA_READ | AS_AREA_CACHEABLE, &addr) == EOK)
+				kstats = addr;
+		}
+	}
+
+	if (kstats != NULL) {
+		load_t *load = malloc(3 * sizeof(load_t));
+		if (load != NULL) {
+			for (unsigned int i = 0; i < 3; i++)
+				load[i] = (load_t) kstats->load[i];
+
+			*count = 3;
+			return load;
+		}
+	}
+
 	size_t size = 0;
 	load_t *load =
 	    (load_t *) sysinfo_get_data("system.load", &size);
@@ -326,12 +326,34 @@ errno_t chr_encode(const char32_t ch, char *str, size_t *offset, size_t size)
  */
 size_t str_size(const char *str)
 {
-	size_t size = 0;
+	const char *p = str;
 
-	while (*str++ != 0)
-		size++;
+	/* Byte loop up to the first word boundary. */
+	while (((uintptr_t) p & (sizeof(unsigned long) - 1)) != 0) {
+		if (*p == 0)
+			return (size_t) (p - str);
 
-	return size;
+		p++;
+	}
+
+	/*
+	 * Word-at-a-time scan (SWAR zero byte detection). Aligned
+	 * word reads never cross a page boundary, so reading a few
+	 * bytes past the terminator is safe.
+	 */
+	const unsigned long ones = ((unsigned long) -1) / 0xff;
+	const unsigned long highs = ones * 0x80;
+
+	const unsigned long *w = (const unsigned long *) p;
+	while ((((*w - ones) & ~*w) & highs) == 0)
+		w++;
+
+	/* Locate the zero byte within the word. */
+	p = (const char *) w;
+	while (*p != 0)
+		p++;
+
+	return (size_t) (p - str);
 }
 
 /** Get size of wide string.
@@ -34,6 +34,7 @@
 
 #include <errno.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <str_error.h>
 #include <string.h>
@@ -488,17 +489,39 @@ char *strerror(int errnum)
  * @param s String
  * @return Number of characters preceding the null character.
  */
+/* Word-at-a-time zero byte detection (SWAR). */
+#define STR_ONES     (((unsigned long) -1) / 0xff)
+#define STR_HIGHS    (STR_ONES * 0x80)
+#define STR_HASZERO(w) \
+	((((w) - STR_ONES) & ~(w)) & STR_HIGHS)
+
 size_t strlen(const char *s)
 {
-	size_t n;
+	const char *p = s;
 
-	n = 0;
-	while (*s != '\0') {
-		++s;
-		++n;
+	/* Byte loop up to the first word boundary. */
+	while (((uintptr_t) p & (sizeof(unsigned long) - 1)) != 0) {
+		if (*p == '\0')
+			return (size_t) (p - s);
+
+		p++;
 	}
 
-	return n;
+	/*
+	 * Scan one word at a time. Aligned word reads never cross a
+	 * page boundary, so reading a few bytes past the terminator
+	 * is safe.
+	 */
+	const unsigned long *w = (const unsigned long *) p;
+	while (!STR_HASZERO(*w))
+		w++;
+
+	/* Locate the zero byte within the word. */
+	p = (const char *) w;
+	while (*p != '\0')
+		p++;
+
+	return (size_t) (p - s);
 }
 
 /** Return number of characters in string with length limit.
@@ -132,6 +132,21 @@ errno_t sysinfo_get_value(const char *path, sysarg_t *value)
 	    (sysarg_t) str_size(path), (sysarg_t) value);
 }
 
+/** Get sysinfo tree generation
+ *
+ * The generation moves whenever the sysinfo tree is mutated. Monitors
+ * can remember it and skip re-reading keys while it stands still, and
+ * subscribe to EVENT_SYSINFO_CHANGE to learn of changes without
+ * polling.
+ *
+ * @return Current sysinfo tree generation.
+ *
+ */
+sysarg_t sysinfo_get_generation(void)
+{
+	return __SYSCALL0(SYS_SYSINFO_GET_GENERATION);
+}
+
 /** Get sysinfo binary data size
  *
  * @param path Sysinfo path.
@@ -35,6 +35,7 @@
  */
 
 #include <adt/list.h>
+#include <adt/odict.h>
 #include <fibril.h>
 #include <stack.h>
 #include <tls.h>
@@ -52,13 +53,14 @@
 #include "../private/futex.h"
 #include "../private/fibril.h"
 #include "../private/libc.h"
+#include "../private/malloc.h"
 
 #define DPRINTF(...) ((void)0)
 #undef READY_DEBUG
 
-/** Member of timeout_list. */
+/** Member of the timeout dictionary. */
 typedef struct {
-	link_t link;
+	odlink_t odlink;
 	struct timespec expires;
 	fibril_event_t *event;
 } _timeout_t;
@@ -92,7 +94,8 @@ static long ready_st_count;
 
 static LIST_INITIALIZE(ready_list);
 static LIST_INITIALIZE(fibril_list);
-static LIST_INITIALIZE(timeout_list);
+/** Active timeouts ordered by expiration time (_timeout_t). */
+static odict_t timeout_dict;
 
 static futex_t ipc_lists_futex;
 static LIST_INITIALIZE(ipc_waiter_list);
@@ -138,6 +141,21 @@ static inline errno_t _ready_down(const struct timespec *expires)
 
 static atomic_int threads_in_ipc_wait;
 
+/**
+ * Uptime timestamp of the last fibril dispatch on this thread, used
+ * to attribute elapsed CPU time to the outgoing fibril on a switch.
+ */
+static fibril_local struct timespec profile_last_switch;
+
+/**
+ * Nonzero while a poke is in flight towards a thread sleeping in
+ * SYS_IPC_WAIT. Pushes of ready fibrils coalesce their pokes through
+ * this flag, so a burst of wakeups costs one syscall instead of one
+ * per fibril; the woken thread re-pokes (cascade) when more work and
+ * more sleeping threads remain.
+ */
+static atomic_int poke_pending;
+
 /** Function that spans the whole life-cycle of a fibril.
  *
  * Each fibril begins execution in this function. Then the function implementing
@@ -304,6 +322,9 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	atomic_fetch_sub_explicit(&threads_in_ipc_wait, 1,
 	    memory_order_relaxed);
 
+	/* A poke, if any was in flight, has landed. */
+	atomic_store_explicit(&poke_pending, 0, memory_order_release);
+
 	if (rc != EOK && rc != ENOENT) {
 		/* Return token. */
 		_ready_up();
@@ -347,6 +368,17 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 
 	futex_unlock(&ipc_lists_futex);
 
+	/*
+	 * Cascade: if more ready fibrils are queued while other
+	 * threads still sleep in SYS_IPC_WAIT, pass the poke on.
+	 */
+	if (!list_empty(&ready_list) &&
+	    atomic_load_explicit(&threads_in_ipc_wait,
+	    memory_order_relaxed) &&
+	    atomic_exchange_explicit(&poke_pending, 1,
+	    memory_order_acq_rel) == 0)
+		ipc_poke();
+
 	if (!locked)
 		futex_unlock(&fibril_futex);
 
@@ -370,7 +402,9 @@ static void _ready_list_push(fibril_t *f)
 	list_append(&f->link, &ready_list);
 	_ready_up();
 
-	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
+	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed) &&
+	    atomic_exchange_explicit(&poke_pending, 1,
+	    memory_order_acq_rel) == 0) {
 		DPRINTF("Poking.\n");
 		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
 		ipc_poke();
@@ -422,9 +456,9 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 
 	futex_lock(&fibril_futex);
 
-	while (!list_empty(&timeout_list)) {
-		link_t *cur = list_first(&timeout_list);
-		_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+	odlink_t *cur;
+	while ((cur = odict_first(&timeout_dict)) != NULL) {
+		_timeout_t *to = odict_get_instance(cur, _timeout_t, odlink);
 
 		if (ts_gt(&to->expires, &ts)) {
 			*next_timeout = to->expires;
@@ -432,7 +466,7 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 			return next_timeout;
 		}
 
-		list_remove(&to->link);
+		odict_remove(&to->odlink);
 
 		_ready_list_push(_fibril_trigger_internal(
 		    to->event, _EVENT_TIMED_OUT));
@@ -491,9 +525,24 @@ static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
 	/* Just some bookkeeping to allow better debugging of futex locks. */
 	futex_give_to(&fibril_futex, dstf);
 
+	/*
+	 * Attribute the CPU time since the last dispatch on this
+	 * thread to the outgoing fibril. A zero timestamp means no
+	 * dispatch has been accounted on this thread yet.
+	 */
+	struct timespec now;
+	getuptime(&now);
+	if ((profile_last_switch.tv_sec != 0) ||
+	    (profile_last_switch.tv_nsec != 0))
+		srcf->cpu_time += ts_sub_diff(&now, &profile_last_switch);
+	dstf->switches++;
+
 	/* Swap to the next fibril. */
 	context_swap(&srcf->ctx, &dstf->ctx);
 
+	/* Start the time slice of the incoming fibril. */
+	getuptime(&profile_last_switch);
+
 	assert(srcf == fibril_self());
 	assert(srcf->thread_ctx);
 
@@ -600,17 +649,8 @@ static void _insert_timeout(_timeout_t *timeout)
 	futex_assert_is_locked(&fibril_futex);
 	assert(timeout);
 
-	link_t *tmp = timeout_list.head.next;
-	while (tmp != &timeout_list.head) {
-		_timeout_t *cur = list_get_instance(tmp, _timeout_t, link);
-
-		if (ts_gteq(&cur->expires, &timeout->expires))
-			break;
-
-		tmp = tmp->next;
-	}
-
-	list_insert_before(&timeout->link, tmp);
+	odlink_initialize(&timeout->odlink);
+	odict_insert(&timeout->odlink, &timeout_dict, NULL);
 }
 
 /**
@@ -697,7 +737,8 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 	assert(event->fibril != _EVENT_INITIAL);
 	assert(event->fibril == _EVENT_TIMED_OUT || event->fibril == _EVENT_TRIGGERED);
 
-	list_remove(&timeout.link);
+	if (odlink_used(&timeout.odlink))
+		odict_remove(&timeout.odlink);
 	errno_t rc = (event->fibril == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
 	event->fibril = _EVENT_INITIAL;
 
@@ -855,6 +896,13 @@ _Noreturn void fibril_exit(long retval)
 	// TODO: implement fibril_join() and remember retval
 	(void) retval;
 
+	/*
+	 * Return the malloc front cache to the heap while our
+	 * fibril-local storage still exists; it is freed without
+	 * destructors when the fibril is cleaned up.
+	 */
+	__malloc_fibril_fini();
+
 	fibril_t *f = _ready_list_pop_nonblocking(false);
 	if (!f)
 		f = fibril_self()->thread_ctx;
@@ -863,8 +911,32 @@ _Noreturn void fibril_exit(long retval)
 	__builtin_unreachable();
 }
 
+/** Get key function for the timeout dictionary. */
+static void *_timeout_getkey(odlink_t *odlink)
+{
+	_timeout_t *to = odict_get_instance(odlink, _timeout_t, odlink);
+	return (void *) &to->expires;
+}
+
+/** Key comparison function for the timeout dictionary. */
+static int _timeout_cmp(void *a, void *b)
+{
+	struct timespec *ta = (struct timespec *) a;
+	struct timespec *tb = (struct timespec *) b;
+
+	if (ta->tv_sec != tb->tv_sec)
+		return (ta->tv_sec < tb->tv_sec) ? -1 : 1;
+
+	if (ta->tv_nsec != tb->tv_nsec)
+		return (ta->tv_nsec < tb->tv_nsec) ? -1 : 1;
+
+	return 0;
+}
+
 void __fibrils_init(void)
 {
+	odict_initialize(&timeout_dict, _timeout_getkey, _timeout_cmp);
+
 	if (futex_initialize(&fibril_futex, 1) != EOK)
 		abort();
 	if (futex_initialize(&ipc_lists_futex, 1) != EOK)
@@ -891,6 +963,29 @@ void __fibrils_fini(void)
 	futex_destroy(&ipc_lists_futex);
 }
 
+/** Report the calling fibril's profiling counters.
+ *
+ * Samplers can call this periodically (or from instrumentation
+ * points) to attribute CPU time to fibrils, e.g. to feed flamegraph
+ * style profiles. Time spent since the last fibril switch is not yet
+ * included.
+ *
+ * @param cpu_time Place to store accumulated CPU time (nanoseconds).
+ *                 May be NULL.
+ * @param switches Place to store the number of times the fibril was
+ *                 dispatched. May be NULL.
+ */
+void fibril_get_profile(nsec_t *cpu_time, size_t *switches)
+{
+	fibril_t *f = fibril_self();
+
+	if (cpu_time)
+		*cpu_time = f->cpu_time;
+
+	if (switches)
+		*switches = f->switches;
+}
+
 void fibril_usleep(usec_t timeout)
 {
 	struct timespec expires;
@@ -53,8 +53,14 @@
 errno_t futex_initialize(futex_t *futex, int val)
 {
 	atomic_store_explicit(&futex->val, val, memory_order_relaxed);
-	futex->whandle = CAP_NIL;
-	return futex_allocate_waitq(futex);
+	atomic_store_explicit(&futex->whandle, CAP_NIL,
+	    memory_order_relaxed);
+
+	/*
+	 * The kernel wait queue is allocated lazily by the first
+	 * contended operation, so initialization costs no syscall.
+	 */
+	return EOK;
 }
 
 #ifdef CONFIG_DEBUG_FUTEX
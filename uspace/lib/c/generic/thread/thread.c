@@ -46,6 +46,7 @@
 
 #include "../private/thread.h"
 #include "../private/fibril.h"
+#include "../private/malloc.h"
 
 /** Main thread function.
  *
@@ -73,6 +74,9 @@ void __thread_main(uspace_arg_t *uarg)
 	 * free(uarg);
 	 */
 
+	/* Flush the malloc front cache before the TLS goes away. */
+	__malloc_fibril_fini();
+
 	fibril_teardown(fibril);
 	thread_exit(0);
 }
@@ -159,6 +163,22 @@ void thread_detach(thread_id_t thread)
 {
 }
 
+/** Set the calling thread's scheduling class.
+ *
+ * The caller's task must hold the PERM_REALTIME permission.
+ *
+ * @param realtime True to move the thread into the latency-critical
+ *                 class, false to return it to the time-sharing class.
+ *
+ * @return Zero on success, EPERM if the caller lacks the PERM_REALTIME
+ *         permission.
+ */
+errno_t thread_set_realtime(bool realtime)
+{
+	return (errno_t) __SYSCALL1(SYS_THREAD_SET_REALTIME,
+	    (sysarg_t) realtime);
+}
+
 /** Get current thread ID.
  *
  * @return Current thread ID.
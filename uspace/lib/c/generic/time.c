@@ -592,7 +592,31 @@ bool ts_gteq(const struct timespec *ts1, const struct timespec *ts2)
 	return false;
 }
 
+/** Cached difference between the RTC real time and system uptime.
+ *
+ * While fresh, real time queries are answered from the memory mapped
+ * uptime page plus this offset, without any IPC round trip to the
+ * RTC service. The offset is re-validated against the RTC every
+ * REALTIME_SYNC_SEC seconds so that a clock set by another task is
+ * picked up; re-validations that differ by less than the RTC read
+ * granularity keep the cached offset to avoid jitter.
+ */
+static struct timespec realtime_offset;
+static struct timespec realtime_sync_uptime;
+static bool realtime_offset_valid = false;
+
+/** How long a cached RTC offset is served before re-validation */
+#define REALTIME_SYNC_SEC  10
+
+/** Offset drift below this is RTC granularity, not a clock set */
+#define REALTIME_SLEW_SEC  2
+
 /** Get real time from a RTC service.
+ *
+ * The RTC service is consulted only when the cached offset from
+ * uptime is missing or has not been re-validated for a while;
+ * in-between calls derive real time from the kernel's memory mapped
+ * uptime, making them as cheap as getuptime().
  *
  * @param[out] ts  Timespec to hold time read from the RTC service (if
  *                 available). If no such service exists, the returned time
@@ -600,6 +624,18 @@ bool ts_gteq(const struct timespec *ts1, const struct timespec *ts2)
  */
 void getrealtime(struct timespec *ts)
 {
+	if (realtime_offset_valid) {
+		getuptime(ts);
+
+		struct timespec age = *ts;
+		ts_sub(&age, &realtime_sync_uptime);
+
+		if (age.tv_sec < REALTIME_SYNC_SEC) {
+			ts_add(ts, &realtime_offset);
+			return;
+		}
+	}
+
 	if (clock_conn == NULL) {
 		category_id_t cat_id;
 		errno_t rc = loc_category_get_id("clock", &cat_id, IPC_FLAG_BLOCKING);
@@ -641,10 +677,52 @@ void getrealtime(struct timespec *ts)
 	ts->tv_nsec = time.tm_nsec;
 	ts->tv_sec = mktime(&time);
 
+	/*
+	 * Remember the offset of real time against uptime so that
+	 * queries within the validation window do not need the RTC
+	 * service at all.
+	 */
+	struct timespec uptime;
+	getuptime(&uptime);
+
+	struct timespec offset = *ts;
+	ts_sub(&offset, &uptime);
+
+	if (realtime_offset_valid) {
+		/*
+		 * Ignore drift within the RTC read granularity; a real
+		 * clock set moves the offset by much more.
+		 */
+		struct timespec drift = offset;
+		ts_sub(&drift, &realtime_offset);
+
+		if ((drift.tv_sec <= -REALTIME_SLEW_SEC) ||
+		    (drift.tv_sec >= REALTIME_SLEW_SEC))
+			realtime_offset = offset;
+	} else {
+		realtime_offset = offset;
+	}
+
+	realtime_sync_uptime = uptime;
+	realtime_offset_valid = true;
+
+	/* Serve the same offset we will serve until the next sync. */
+	*ts = uptime;
+	ts_add(ts, &realtime_offset);
+
 	return;
 
 fallback:
 	getuptime(ts);
+
+	if (realtime_offset_valid) {
+		/*
+		 * The RTC is transiently unreachable; keep serving the
+		 * cached offset and do not retry before the next window.
+		 */
+		realtime_sync_uptime = *ts;
+		ts_add(ts, &realtime_offset);
+	}
 }
 
 /** Get system uptime.
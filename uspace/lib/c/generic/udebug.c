@@ -65,6 +65,31 @@ errno_t udebug_set_evmask(async_sess_t *sess, udebug_evmask_t mask)
 	return rc;
 }
 
+errno_t udebug_set_sysmask(async_sess_t *sess, const void *mask, size_t size)
+{
+	async_exch_t *exch = async_exchange_begin(sess);
+	errno_t rc = async_req_3_0(exch, IPC_M_DEBUG, UDEBUG_M_SET_SYSMASK,
+	    (sysarg_t) mask, size);
+	async_exchange_end(exch);
+
+	return rc;
+}
+
+errno_t udebug_events_read(async_sess_t *sess, void *buffer, size_t n,
+    size_t *copied, size_t *dropped)
+{
+	sysarg_t a_copied, a_dropped;
+	async_exch_t *exch = async_exchange_begin(sess);
+	errno_t rc = async_req_3_3(exch, IPC_M_DEBUG, UDEBUG_M_EVENTS_READ,
+	    (sysarg_t) buffer, n, NULL, &a_copied, &a_dropped);
+	async_exchange_end(exch);
+
+	*copied = (size_t) a_copied;
+	*dropped = (size_t) a_dropped;
+
+	return rc;
+}
+
 errno_t udebug_thread_read(async_sess_t *sess, void *buffer, size_t n,
     size_t *copied, size_t *needed)
 {
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ * @brief Asynchronous file I/O over the VFS.
+ *
+ * Submit/complete style interface on top of the synchronous VFS
+ * client calls: a submitted request is carried out by a dedicated
+ * fibril, so the submitting fibril can keep computing or queue
+ * further requests (e.g. to overlap reading one block with
+ * processing another). Completion is signalled through the
+ * semaphore embedded in the request.
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stddef.h>
+#include <vfs/aio.h>
+#include <vfs/vfs.h>
+
+/** Fibril function carrying out one request. */
+static errno_t vfs_aio_worker(void *arg)
+{
+	vfs_aio_req_t *req = (vfs_aio_req_t *) arg;
+
+	if (req->write) {
+		req->rc = vfs_write(req->file, &req->pos, req->buf,
+		    req->nbytes, &req->ntransferred);
+	} else {
+		req->rc = vfs_read(req->file, &req->pos, req->buf,
+		    req->nbytes, &req->ntransferred);
+	}
+
+	req->done = true;
+	fibril_semaphore_up(&req->sem);
+	return EOK;
+}
+
+/** Submit a request.
+ *
+ * @return EOK if the request was submitted or an error code.
+ */
+static errno_t vfs_aio_submit(vfs_aio_req_t *req, int file, aoff64_t pos,
+    void *buf, size_t nbytes, bool write)
+{
+	req->file = file;
+	req->pos = pos;
+	req->buf = buf;
+	req->nbytes = nbytes;
+	req->write = write;
+	fibril_semaphore_initialize(&req->sem, 0);
+	req->done = false;
+	req->rc = EOK;
+	req->ntransferred = 0;
+
+	fid_t fid = fibril_create(vfs_aio_worker, req);
+	if (fid == 0)
+		return ENOMEM;
+
+	fibril_add_ready(fid);
+	return EOK;
+}
+
+/** Submit an asynchronous read.
+ *
+ * The request structure and the buffer must stay valid until the
+ * request completes.
+ *
+ * @param req    Caller-owned request structure.
+ * @param file   File handle.
+ * @param pos    Position to read from.
+ * @param buf    Buffer to read into.
+ * @param nbytes Number of bytes to read.
+ *
+ * @return EOK if the request was submitted or an error code.
+ */
+errno_t vfs_aio_read(vfs_aio_req_t *req, int file, aoff64_t pos, void *buf,
+    size_t nbytes)
+{
+	return vfs_aio_submit(req, file, pos, buf, nbytes, false);
+}
+
+/** Submit an asynchronous write.
+ *
+ * The request structure and the buffer must stay valid until the
+ * request completes.
+ *
+ * @param req    Caller-owned request structure.
+ * @param file   File handle.
+ * @param pos    Position to write to.
+ * @param buf    Buffer to write from.
+ * @param nbytes Number of bytes to write.
+ *
+ * @return EOK if the request was submitted or an error code.
+ */
+errno_t vfs_aio_write(vfs_aio_req_t *req, int file, aoff64_t pos, void *buf,
+    size_t nbytes)
+{
+	return vfs_aio_submit(req, file, pos, buf, nbytes, true);
+}
+
+/** Wait for a submitted request to complete.
+ *
+ * @param req Request to wait for.
+ *
+ * @return Result of the I/O operation.
+ */
+errno_t vfs_aio_wait(vfs_aio_req_t *req)
+{
+	fibril_semaphore_down(&req->sem);
+
+	/*
+	 * Re-post the token so that waiting is idempotent.
+	 */
+	fibril_semaphore_up(&req->sem);
+
+	return req->rc;
+}
+
+/** Check whether a submitted request has completed.
+ *
+ * @param req Request to check.
+ *
+ * @return True if the request has completed.
+ */
+bool vfs_aio_done(vfs_aio_req_t *req)
+{
+	return req->done;
+}
+
+/** @}
+ */
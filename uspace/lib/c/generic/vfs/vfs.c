@@ -40,7 +40,9 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <abi/ipc/ipc.h>
 #include <ipc/services.h>
+#include <libarch/config.h>
 #include <ns.h>
 #include <async.h>
 #include <fibril_synch.h>
@@ -861,6 +863,86 @@ errno_t vfs_read(int file, aoff64_t *pos, void *buf, size_t nbyte, size_t *nread
 	return EOK;
 }
 
+/** Read data from a file into multiple buffers (scatter read).
+ *
+ * The segments are filled in order, advancing one file position
+ * across the whole vector, so the result is equivalent to one large
+ * contiguous read.
+ *
+ * @param file       File handle to read from
+ * @param[inout] pos Position to read from; updated by the actual
+ *                   number of bytes read
+ * @param iov        Array of buffer segments
+ * @param iovcnt     Number of segments
+ * @param[out] nread Total number of bytes read
+ *
+ * @return EOK on success or an error code
+ */
+errno_t vfs_readv(int file, aoff64_t *pos, const vfs_iovec_t *iov,
+    size_t iovcnt, size_t *nread)
+{
+	size_t total = 0;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		size_t cnt = 0;
+		errno_t rc = vfs_read(file, pos, iov[i].buf, iov[i].size,
+		    &cnt);
+
+		total += cnt;
+
+		if (rc != EOK) {
+			*nread = total;
+			return rc;
+		}
+
+		if (cnt < iov[i].size)
+			break;
+	}
+
+	*nread = total;
+	return EOK;
+}
+
+/** Write data to a file from multiple buffers (gather write).
+ *
+ * The segments are written in order, advancing one file position
+ * across the whole vector, so the result is equivalent to one large
+ * contiguous write.
+ *
+ * @param file          File handle to write to
+ * @param[inout] pos    Position to write to; updated by the actual
+ *                      number of bytes written
+ * @param iov           Array of buffer segments
+ * @param iovcnt        Number of segments
+ * @param[out] nwritten Total number of bytes written
+ *
+ * @return EOK on success or an error code
+ */
+errno_t vfs_writev(int file, aoff64_t *pos, const vfs_iovec_t *iov,
+    size_t iovcnt, size_t *nwritten)
+{
+	size_t total = 0;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		size_t cnt = 0;
+		errno_t rc = vfs_write(file, pos, iov[i].buf, iov[i].size,
+		    &cnt);
+
+		total += cnt;
+
+		if (rc != EOK) {
+			*nwritten = total;
+			return rc;
+		}
+
+		if (cnt < iov[i].size)
+			break;
+	}
+
+	*nwritten = total;
+	return EOK;
+}
+
 /** Read bytes from a file
  *
  * Read up to @a nbyte bytes from file. The actual number of bytes read
@@ -985,6 +1067,104 @@ errno_t vfs_rename_path(const char *old, const char *new)
  *
  * @return              EOK on success or an error code
  */
+/** Read directory entries together with their stat data.
+ *
+ * Fills @a buf with vfs_dirent_stat_t records (see ipc/vfs.h) in
+ * one exchange, advancing @a *pos past the entries returned. Zero
+ * @a *nentries with EOK return means the end of the directory.
+ *
+ * @param file Directory file handle
+ * @param pos Position in the directory; updated
+ * @param buf Buffer for the records
+ * @param size Buffer size
+ * @param nentries Place to store the number of records returned
+ *
+ * @return EOK on success or an error code
+ */
+errno_t vfs_read_dirents_stat(int file, aoff64_t *pos, void *buf, size_t size,
+    size_t *nentries)
+{
+	ipc_call_t answer;
+
+	async_exch_t *exch = vfs_exchange_begin();
+
+	aid_t req = async_send_3(exch, VFS_IN_READDIR_STAT, file,
+	    LOWER32(*pos), UPPER32(*pos), &answer);
+	errno_t rc = async_data_read_start(exch, buf, size);
+
+	vfs_exchange_end(exch);
+
+	if (rc != EOK) {
+		async_forget(req);
+		return rc;
+	}
+
+	async_wait_for(req, &rc);
+	if (rc != EOK)
+		return rc;
+
+	*nentries = ipc_get_arg1(&answer);
+	*pos = MERGE_LOUP32(ipc_get_arg2(&answer), ipc_get_arg3(&answer));
+	return EOK;
+}
+
+/** Copy the whole contents of one open file over another.
+ *
+ * Both files must reside in the same file system instance and the
+ * file system server must support server-side copying; EXDEV or
+ * ENOTSUP tell the caller to fall back to a read/write loop.
+ *
+ * @param src Source file handle (open for reading)
+ * @param dst Destination file handle (open for writing)
+ *
+ * @return EOK on success or an error code
+ */
+errno_t vfs_copy(int src, int dst)
+{
+	async_exch_t *exch = vfs_exchange_begin();
+	errno_t rc = async_req_2_0(exch, VFS_IN_COPY, src, dst);
+	vfs_exchange_end(exch);
+
+	return rc;
+}
+
+/** Get this task's accumulated VFS I/O counters.
+ *
+ * @param bytes_read Total bytes read (may be NULL)
+ * @param bytes_written Total bytes written (may be NULL)
+ * @param read_ops Number of read operations (may be NULL)
+ * @param write_ops Number of write operations (may be NULL)
+ *
+ * @return EOK on success or an error code
+ */
+errno_t vfs_get_iostats(uint64_t *bytes_read, uint64_t *bytes_written,
+    uint64_t *read_ops, uint64_t *write_ops)
+{
+	sysarg_t br;
+	sysarg_t bw;
+	sysarg_t ro;
+	sysarg_t wo;
+
+	async_exch_t *exch = vfs_exchange_begin();
+	errno_t rc = async_req_0_4(exch, VFS_IN_GET_IOSTATS, &br, &bw, &ro,
+	    &wo);
+	vfs_exchange_end(exch);
+
+	if (rc != EOK)
+		return rc;
+
+	if (bytes_read != NULL)
+		*bytes_read = br;
+	if (bytes_written != NULL)
+		*bytes_written = bw;
+	if (read_ops != NULL)
+		*read_ops = ro;
+	if (write_ops != NULL)
+		*write_ops = wo;
+
+	return EOK;
+}
+
 errno_t vfs_resize(int file, aoff64_t length)
 {
 	async_exch_t *exch = vfs_exchange_begin();
@@ -1354,7 +1534,15 @@ errno_t vfs_write_short(int file, aoff64_t pos, const void *buf, size_t nbyte,
 
 	req = async_send_3(exch, VFS_IN_WRITE, file, LOWER32(pos),
 	    UPPER32(pos), &answer);
-	rc = async_data_write_start(exch, (void *) buf, nbyte);
+
+	/*
+	 * Page-sized and larger payloads are worth pinning in the
+	 * kernel instead of bouncing through a kernel buffer. The
+	 * buffer is ours again once the data write call is answered,
+	 * which happens before async_data_write_start_flags() returns.
+	 */
+	rc = async_data_write_start_flags(exch, (void *) buf, nbyte,
+	    (nbyte >= PAGE_SIZE) ? IPC_XF_ZEROCOPY : 0);
 
 	vfs_exchange_end(exch);
 
@@ -47,6 +47,7 @@ typedef struct {
 extern void prodcons_initialize(prodcons_t *);
 extern void prodcons_produce(prodcons_t *, link_t *);
 extern link_t *prodcons_consume(prodcons_t *);
+extern link_t *prodcons_consume_try(prodcons_t *);
 
 #endif
 
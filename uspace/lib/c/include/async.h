@@ -357,6 +357,8 @@ extern errno_t async_data_write_forward_4_1(async_exch_t *, sysarg_t, sysarg_t,
     sysarg_t, sysarg_t, sysarg_t, ipc_call_t *);
 
 extern errno_t async_data_write_start(async_exch_t *, const void *, size_t);
+extern errno_t async_data_write_start_flags(async_exch_t *, const void *,
+    size_t, unsigned int);
 extern bool async_data_write_receive(ipc_call_t *, size_t *);
 extern errno_t async_data_write_finalize(ipc_call_t *, void *, size_t);
 
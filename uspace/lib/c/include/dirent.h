@@ -49,6 +49,7 @@ extern DIR *opendir(const char *);
 extern struct dirent *readdir(DIR *);
 extern void rewinddir(DIR *);
 extern int closedir(DIR *);
+extern int dirfd(DIR *);
 
 __C_DECLS_END;
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ * @brief Pool allocator for physically contiguous DMA buffers.
+ */
+
+#ifndef _LIBC_DMA_POOL_H_
+#define _LIBC_DMA_POOL_H_
+
+#include <adt/list.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Pool of equally sized, physically contiguous DMA buffers. */
+typedef struct {
+	/** Size of one buffer (page aligned). */
+	size_t bsize;
+	/** Physical address constraint for dmamem_map_anonymous(). */
+	uintptr_t constraint;
+	/** Address space area flags of the backing chunks. */
+	unsigned int map_flags;
+
+	/** Backing chunks of DMA memory (dma_pool_chunk_t). */
+	list_t chunks;
+	/** Buffers ready to be handed out (dma_pool_buf_t). */
+	list_t free_bufs;
+	/** Buffers currently handed out (dma_pool_buf_t). */
+	list_t busy_bufs;
+
+	fibril_mutex_t lock;
+} dma_pool_t;
+
+extern errno_t dma_pool_create(dma_pool_t *, size_t, size_t, uintptr_t,
+    unsigned int);
+extern void dma_pool_destroy(dma_pool_t *);
+extern errno_t dma_pool_alloc(dma_pool_t *, void **, uintptr_t *);
+extern void dma_pool_free(dma_pool_t *, void *);
+
+#endif
+
+/** @}
+ */
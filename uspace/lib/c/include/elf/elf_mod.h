@@ -44,7 +44,9 @@
 
 typedef enum {
 	/** Leave all segments in RW access mode. */
-	ELDF_RW = 1
+	ELDF_RW = 1,
+	/** Demand-page read-only segments from the file */
+	ELDF_PAGED = 2
 } eld_flags_t;
 
 /** TLS info for a module */
@@ -96,6 +98,9 @@ typedef struct {
 
 	/** Store extracted info here */
 	elf_finfo_t *info;
+
+	/** At least one segment is demand-paged from the file */
+	bool paged;
 } elf_ld_t;
 
 extern errno_t elf_load_file(int, eld_flags_t, elf_finfo_t *);
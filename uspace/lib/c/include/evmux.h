@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/**
+ * @file Event multiplexer for fibril servers.
+ *
+ * Lets one fibril wait for readiness of many event sources instead
+ * of dedicating a fibril (and its stack) to each. Producers post
+ * readiness from wherever they learn about it - a protocol
+ * callback, a timer, another fibril - and the consumer collects
+ * ready sources in batches. Delivery is edge style: posting the
+ * same source again before it was collected just merges the event
+ * bits.
+ */
+
+#ifndef _LIBC_EVMUX_H_
+#define _LIBC_EVMUX_H_
+
+#include <adt/list.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+struct evmux;
+
+/** One registered event source */
+typedef struct {
+	/** Link to the multiplexer's ready list */
+	link_t link;
+	/** Owning multiplexer */
+	struct evmux *mux;
+	/** User cookie identifying the source */
+	void *arg;
+	/** Accumulated event bits since last collection */
+	unsigned events;
+	/** Whether the source sits on the ready list */
+	bool queued;
+} evmux_src_t;
+
+/** Event multiplexer */
+typedef struct evmux {
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+	/** Sources with pending events (of evmux_src_t) */
+	list_t ready;
+	/** No more waiting; evmux_wait() returns immediately */
+	bool closed;
+} evmux_t;
+
+extern void evmux_initialize(evmux_t *);
+extern void evmux_src_initialize(evmux_src_t *, evmux_t *, void *);
+extern void evmux_post(evmux_src_t *, unsigned);
+extern void evmux_retract(evmux_src_t *);
+extern size_t evmux_wait(evmux_t *, evmux_src_t **, size_t);
+extern errno_t evmux_wait_timeout(evmux_t *, evmux_src_t **, size_t, usec_t,
+    size_t *);
+extern void evmux_close(evmux_t *);
+
+#endif
+
+/** @}
+ */
@@ -63,6 +63,7 @@ extern fid_t fibril_get_id(void);
 extern void fibril_yield(void);
 
 extern void fibril_usleep(usec_t);
+extern void fibril_get_profile(nsec_t *, size_t *);
 extern void fibril_sleep(sec_t);
 
 extern void fibril_enable_multithreaded(void);
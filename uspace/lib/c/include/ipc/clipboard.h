@@ -40,7 +40,8 @@
 typedef enum {
 	CLIPBOARD_PUT_DATA = IPC_FIRST_USER_METHOD,
 	CLIPBOARD_GET_DATA,
-	CLIPBOARD_CONTENT
+	CLIPBOARD_CONTENT,
+	CLIPBOARD_GET_SHARED
 } clipboard_request_t;
 
 typedef enum {
@@ -48,6 +49,9 @@ typedef enum {
 	CLIPBOARD_TAG_DATA
 } clipboard_tag_t;
 
+/** Payloads at least this large are stored and served as shared areas */
+#define CLIPBOARD_SHARE_THRESHOLD  DATA_XFER_LIMIT
+
 #endif
 
 /** @}
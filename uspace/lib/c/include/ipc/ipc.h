@@ -100,6 +100,8 @@ extern errno_t ipc_answer_slow(cap_call_handle_t, errno_t, sysarg_t, sysarg_t,
 
 extern errno_t ipc_call_async_fast(cap_phone_handle_t, sysarg_t, sysarg_t,
     sysarg_t, sysarg_t, void *);
+extern errno_t ipc_call_async_batch(cap_phone_handle_t,
+    ipc_call_batch_entry_t *, size_t, size_t *);
 extern errno_t ipc_call_async_slow(cap_phone_handle_t, sysarg_t, sysarg_t,
     sysarg_t, sysarg_t, sysarg_t, sysarg_t, void *);
 
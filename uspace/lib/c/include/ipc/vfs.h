@@ -71,12 +71,15 @@ typedef struct {
 
 typedef enum {
 	VFS_IN_CLONE = IPC_FIRST_USER_METHOD,
+	VFS_IN_COPY,
 	VFS_IN_FSPROBE,
 	VFS_IN_FSTYPES,
 	VFS_IN_MOUNT,
 	VFS_IN_OPEN,
 	VFS_IN_PUT,
 	VFS_IN_READ,
+	VFS_IN_READDIR_STAT,
+	VFS_IN_GET_IOSTATS,
 	VFS_IN_REGISTER,
 	VFS_IN_RENAME,
 	VFS_IN_RESIZE,
@@ -92,6 +95,7 @@ typedef enum {
 
 typedef enum {
 	VFS_OUT_CLOSE = IPC_FIRST_USER_METHOD,
+	VFS_OUT_COPY,
 	VFS_OUT_DESTROY,
 	VFS_OUT_FSPROBE,
 	VFS_OUT_IS_EMPTY,
@@ -189,6 +193,24 @@ enum {
 	MODE_APPEND = 4,
 };
 
+
+/** One entry returned by VFS_IN_READDIR_STAT.
+ *
+ * The null-terminated entry name immediately follows the structure;
+ * successive records are aligned to eight bytes.
+ */
+typedef struct {
+	uint64_t size;
+	sysarg_t service;
+	uint8_t is_directory;
+	char name[];
+} vfs_dirent_stat_t;
+
+/** Bytes occupied by one vfs_dirent_stat_t record with a name of
+ * @a namesz bytes (including the terminator). */
+#define VFS_DIRENT_STAT_RECSZ(namesz) \
+	(((sizeof(vfs_dirent_stat_t) + (namesz)) + 7) & ~(size_t) 7)
+
 #endif
 
 /** @}
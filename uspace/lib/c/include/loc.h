@@ -74,6 +74,7 @@ extern size_t loc_count_services(service_id_t);
 extern size_t loc_get_namespaces(loc_sdesc_t **);
 extern size_t loc_get_services(service_id_t, loc_sdesc_t **);
 extern errno_t loc_get_categories(category_id_t **, size_t *);
+extern errno_t loc_get_generation(sysarg_t *);
 extern errno_t loc_register_cat_change_cb(loc_cat_change_cb_t, void *);
 
 #endif
@@ -154,6 +154,14 @@ float cosf(float);
 long double cosl(long double);
 double sin(double);
 float sinf(float);
+
+#ifdef _HELENOS_SOURCE
+/* Array evaluation entry points for bulk workloads */
+extern void math_sinf_array(size_t, const float *, float *);
+extern void math_sin_array(size_t, const double *, double *);
+extern void math_cosf_array(size_t, const float *, float *);
+extern void math_cos_array(size_t, const double *, double *);
+#endif
 long double sinl(long double);
 double tan(double);
 float tanf(float);
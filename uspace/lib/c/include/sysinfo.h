@@ -43,6 +43,7 @@
 extern char *sysinfo_get_keys(const char *, size_t *);
 extern sysinfo_item_val_type_t sysinfo_get_val_type(const char *);
 extern errno_t sysinfo_get_value(const char *, sysarg_t *);
+extern sysarg_t sysinfo_get_generation(void);
 extern void *sysinfo_get_data(const char *, size_t *);
 extern void *sysinfo_get_property(const char *, const char *, size_t *);
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ * @brief Asynchronous file I/O over the VFS.
+ */
+
+#ifndef _LIBC_VFS_AIO_H_
+#define _LIBC_VFS_AIO_H_
+
+#include <errno.h>
+#include <fibril_synch.h>
+#include <offset.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** One asynchronous I/O request.
+ *
+ * The structure is owned by the caller and must stay valid (and the
+ * buffer untouched) until the request completes.
+ */
+typedef struct {
+	/** File handle. */
+	int file;
+	/** File position of the transfer; updated on completion. */
+	aoff64_t pos;
+	/** Data buffer. */
+	void *buf;
+	/** Number of bytes to transfer. */
+	size_t nbytes;
+
+	/** True for write requests, false for reads. */
+	bool write;
+	/** Completion signalling. */
+	fibril_semaphore_t sem;
+	/** True once the request has completed. */
+	bool done;
+
+	/** Result of the operation. */
+	errno_t rc;
+	/** Number of bytes actually transferred. */
+	size_t ntransferred;
+} vfs_aio_req_t;
+
+extern errno_t vfs_aio_read(vfs_aio_req_t *, int, aoff64_t, void *, size_t);
+extern errno_t vfs_aio_write(vfs_aio_req_t *, int, aoff64_t, void *, size_t);
+extern errno_t vfs_aio_wait(vfs_aio_req_t *);
+extern bool vfs_aio_done(vfs_aio_req_t *);
+
+#endif
+
+/** @}
+ */
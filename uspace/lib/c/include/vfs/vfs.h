@@ -82,6 +82,11 @@ extern errno_t vfs_fhandle(FILE *, int *);
 
 extern char *vfs_absolutize(const char *, size_t *);
 extern errno_t vfs_clone(int, int, bool, int *);
+extern errno_t vfs_copy(int, int);
+extern errno_t vfs_read_dirents_stat(int, aoff64_t *, void *, size_t,
+    size_t *);
+extern errno_t vfs_get_iostats(uint64_t *, uint64_t *, uint64_t *,
+    uint64_t *);
 extern errno_t vfs_cwd_get(char *path, size_t);
 extern errno_t vfs_cwd_set(const char *path);
 extern async_exch_t *vfs_exchange_begin(void);
@@ -100,7 +105,15 @@ extern errno_t vfs_mount(int, const char *, service_id_t, const char *, unsigned
 extern errno_t vfs_open(int, int);
 extern errno_t vfs_pass_handle(async_exch_t *, int, async_exch_t *);
 extern errno_t vfs_put(int);
+/** One segment of a scatter-gather transfer. */
+typedef struct {
+	void *buf;
+	size_t size;
+} vfs_iovec_t;
+
 extern errno_t vfs_read(int, aoff64_t *, void *, size_t, size_t *);
+extern errno_t vfs_readv(int, aoff64_t *, const vfs_iovec_t *, size_t,
+    size_t *);
 extern errno_t vfs_read_short(int, aoff64_t, void *, size_t, ssize_t *);
 extern errno_t vfs_receive_handle(bool, int *);
 extern errno_t vfs_rename_path(const char *, const char *);
@@ -118,6 +131,8 @@ extern errno_t vfs_unmount(int);
 extern errno_t vfs_unmount_path(const char *);
 extern errno_t vfs_walk(int, const char *, int, int *);
 extern errno_t vfs_write(int, aoff64_t *, const void *, size_t, size_t *);
+extern errno_t vfs_writev(int, aoff64_t *, const vfs_iovec_t *, size_t,
+    size_t *);
 extern errno_t vfs_write_short(int, aoff64_t, const void *, size_t, ssize_t *);
 
 #endif
@@ -28,7 +28,10 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
 #include <mem.h>
 #include <byteorder.h>
 #include <stdlib.h>
@@ -46,6 +49,9 @@
 #define GZIP_FLAG_FNAME     UINT8_C(1 << 3)
 #define GZIP_FLAG_FCOMMENT  UINT8_C(1 << 4)
 
+/** Worker fibrils decoding members of a multi-member archive */
+#define GZIP_MULTI_WORKERS  4
+
 typedef struct {
 	uint8_t id1;
 	uint8_t id2;
@@ -61,41 +67,27 @@ typedef struct {
 	uint32_t size;
 } __attribute__((packed)) gzip_footer_t;
 
-/** Expand GZIP compressed data
- *
- * The routine allocates the output buffer based
- * on the size encoded in the input stream. This
- * effectively limits the size of the uncompressed
- * data to 4 GiB (expanding input streams that actually
- * encode more data will always fail).
+/** Check and skip the member header
  *
- * So far, no CRC is perfomed.
- *
- * @param[in]  src     Source data buffer.
- * @param[in]  srclen  Source buffer size (bytes).
- * @param[out] dest    Destination data buffer.
- * @param[out] destlen Destination buffer size (bytes).
+ * @param[in]  src            Member data.
+ * @param[in]  srclen         Member data size (bytes).
+ * @param[out] stream         Start of the deflate stream.
+ * @param[out] stream_length  Bytes from the stream start to the
+ *                            end of the member data.
  *
  * @return EOK on success.
- * @return ENOENT on distance too large.
- * @return EINVAL on invalid Huffman code, invalid deflate data,
- *                   invalid compression method or invalid stream.
- * @return ELIMIT on input buffer overrun.
- * @return ENOMEM on output buffer overrun.
+ * @return EINVAL on an invalid or truncated header.
  *
  */
-errno_t gzip_expand(void *src, size_t srclen, void **dest, size_t *destlen)
+static errno_t gzip_hdr_parse(void *src, size_t srclen, void **stream,
+    size_t *stream_length)
 {
 	gzip_header_t header;
-	gzip_footer_t footer;
 
-	if ((srclen < sizeof(header)) || (srclen < sizeof(footer)))
+	if (srclen < sizeof(header))
 		return EINVAL;
 
-	/* Decode header and footer */
-
 	memcpy(&header, src, sizeof(header));
-	memcpy(&footer, src + srclen - sizeof(footer), sizeof(footer));
 
 	if ((header.id1 != GZIP_ID1) ||
 	    (header.id2 != GZIP_ID2) ||
@@ -103,81 +95,438 @@ errno_t gzip_expand(void *src, size_t srclen, void **dest, size_t *destlen)
 	    ((header.flags & (~GZIP_FLAGS_MASK)) != 0))
 		return EINVAL;
 
-	*destlen = uint32_t_le2host(footer.size);
+	void *pos = src + sizeof(header);
+	size_t remain = srclen - sizeof(header);
 
 	/* Ignore extra metadata */
 
-	void *stream = src + sizeof(header);
-	size_t stream_length = srclen - sizeof(header) - sizeof(footer);
-
 	if ((header.flags & GZIP_FLAG_FEXTRA) != 0) {
 		uint16_t extra_length;
 
-		if (stream_length < sizeof(extra_length))
+		if (remain < sizeof(extra_length))
 			return EINVAL;
 
-		memcpy(&extra_length, stream, sizeof(extra_length));
-		stream += sizeof(extra_length);
-		stream_length -= sizeof(extra_length);
+		memcpy(&extra_length, pos, sizeof(extra_length));
+		extra_length = uint16_t_le2host(extra_length);
+		pos += sizeof(extra_length);
+		remain -= sizeof(extra_length);
 
-		if (stream_length < extra_length)
+		if (remain < extra_length)
 			return EINVAL;
 
-		stream += extra_length;
-		stream_length -= extra_length;
+		pos += extra_length;
+		remain -= extra_length;
 	}
 
 	if ((header.flags & GZIP_FLAG_FNAME) != 0) {
-		while (*((uint8_t *) stream) != 0) {
-			if (stream_length == 0)
-				return EINVAL;
-
-			stream++;
-			stream_length--;
+		while ((remain > 0) && (*((uint8_t *) pos) != 0)) {
+			pos++;
+			remain--;
 		}
 
-		if (stream_length == 0)
+		if (remain == 0)
 			return EINVAL;
 
-		stream++;
-		stream_length--;
+		pos++;
+		remain--;
 	}
 
 	if ((header.flags & GZIP_FLAG_FCOMMENT) != 0) {
-		while (*((uint8_t *) stream) != 0) {
-			if (stream_length == 0)
-				return EINVAL;
-
-			stream++;
-			stream_length--;
+		while ((remain > 0) && (*((uint8_t *) pos) != 0)) {
+			pos++;
+			remain--;
 		}
 
-		if (stream_length == 0)
+		if (remain == 0)
 			return EINVAL;
 
-		stream++;
-		stream_length--;
+		pos++;
+		remain--;
 	}
 
 	if ((header.flags & GZIP_FLAG_FHCRC) != 0) {
-		if (stream_length < 2)
+		if (remain < 2)
 			return EINVAL;
 
-		stream += 2;
-		stream_length -= 2;
+		pos += 2;
+		remain -= 2;
 	}
 
-	/* Allocate output buffer and inflate the data */
+	*stream = pos;
+	*stream_length = remain;
+	return EOK;
+}
+
+/** Expand a single GZIP member
+ *
+ * Expand one member of (possibly multi-member) GZIP data into a
+ * caller-provided buffer, reporting how much input the member
+ * occupied so that the next member can follow.
+ *
+ * So far, no CRC is performed (but the size is verified against
+ * the member footer).
+ *
+ * @param[in]  src       Source data buffer.
+ * @param[in]  srclen    Source buffer size (bytes).
+ * @param[out] dest      Destination data buffer.
+ * @param[in]  destlen   Destination buffer size (bytes).
+ * @param[out] srcread   Bytes of the source occupied by the member
+ *                       (may be NULL).
+ * @param[out] destwrite Bytes written to the destination
+ *                       (may be NULL).
+ *
+ * @return EOK on success.
+ * @return EINVAL on an invalid member.
+ * @return ELIMIT on input buffer overrun.
+ * @return ENOMEM on output buffer overrun.
+ *
+ */
+errno_t gzip_expand_member(void *src, size_t srclen, void *dest,
+    size_t destlen, size_t *srcread, size_t *destwrite)
+{
+	void *stream;
+	size_t stream_length;
+
+	errno_t rc = gzip_hdr_parse(src, srclen, &stream, &stream_length);
+	if (rc != EOK)
+		return rc;
+
+	if (stream_length < sizeof(gzip_footer_t))
+		return EINVAL;
 
-	*dest = malloc(*destlen);
-	if (*dest == NULL)
+	size_t stream_read;
+	size_t written;
+	rc = inflate_stream(stream, stream_length, dest, destlen,
+	    &stream_read, &written);
+	if (rc != EOK)
+		return rc;
+
+	gzip_footer_t footer;
+	if (stream_read + sizeof(footer) > stream_length)
+		return EINVAL;
+
+	memcpy(&footer, stream + stream_read, sizeof(footer));
+
+	if (uint32_t_le2host(footer.size) != (uint32_t) written)
+		return EINVAL;
+
+	if (srcread != NULL)
+		*srcread = (stream - src) + stream_read + sizeof(footer);
+	if (destwrite != NULL)
+		*destwrite = written;
+
+	return EOK;
+}
+
+/** Expand GZIP data member by member, growing the output buffer
+ *
+ */
+static errno_t gzip_expand_serial(void *src, size_t srclen, void **dest,
+    size_t *destlen)
+{
+	/* The last footer is a good capacity guess for one member. */
+	gzip_footer_t footer;
+	memcpy(&footer, src + srclen - sizeof(footer), sizeof(footer));
+
+	size_t cap = uint32_t_le2host(footer.size);
+	if (cap == 0)
+		cap = 4096;
+
+	uint8_t *buf = malloc(cap);
+	if (buf == NULL)
 		return ENOMEM;
 
-	errno_t ret = inflate(stream, stream_length, *dest, *destlen);
-	if (ret != EOK) {
-		free(dest);
-		return ret;
+	size_t pos = 0;
+	size_t off = 0;
+
+	while (pos < srclen) {
+		size_t srcread;
+		size_t destwrite;
+
+		errno_t rc = gzip_expand_member(src + pos, srclen - pos,
+		    buf + off, cap - off, &srcread, &destwrite);
+
+		if (rc == ENOMEM) {
+			/* Output full; grow and retry this member. */
+			if (cap > SIZE_MAX / 2) {
+				free(buf);
+				return ENOMEM;
+			}
+
+			cap *= 2;
+			uint8_t *nbuf = realloc(buf, cap);
+			if (nbuf == NULL) {
+				free(buf);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+			continue;
+		}
+
+		if (rc != EOK) {
+			free(buf);
+			return rc;
+		}
+
+		pos += srcread;
+		off += destwrite;
+	}
+
+	*dest = buf;
+	*destlen = off;
+	return EOK;
+}
+
+/** Work shared by the member decoding fibrils */
+typedef struct {
+	uint8_t *src;
+	uint8_t *dest;
+	/** Member boundaries (nmembers + 1 offsets) */
+	size_t *bounds;
+	/** Output offsets (nmembers + 1 offsets) */
+	size_t *offs;
+	size_t nmembers;
+
+	/** Next member to claim */
+	size_t next;
+	/** Workers still running */
+	size_t running;
+	bool failed;
+
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+} gzip_multi_work_t;
+
+static void gzip_multi_work_run(gzip_multi_work_t *work)
+{
+	while (true) {
+		fibril_mutex_lock(&work->lock);
+		size_t member = work->next;
+		if ((member >= work->nmembers) || (work->failed)) {
+			fibril_mutex_unlock(&work->lock);
+			break;
+		}
+		work->next++;
+		fibril_mutex_unlock(&work->lock);
+
+		size_t srclen = work->bounds[member + 1] - work->bounds[member];
+		size_t destlen = work->offs[member + 1] - work->offs[member];
+
+		size_t srcread;
+		size_t destwrite;
+		errno_t rc = gzip_expand_member(work->src + work->bounds[member],
+		    srclen, work->dest + work->offs[member], destlen,
+		    &srcread, &destwrite);
+
+		/*
+		 * Each member must fill its range exactly, otherwise
+		 * the boundary scan guessed wrong.
+		 */
+		if ((rc != EOK) || (srcread != srclen) ||
+		    (destwrite != destlen)) {
+			fibril_mutex_lock(&work->lock);
+			work->failed = true;
+			fibril_mutex_unlock(&work->lock);
+			break;
+		}
 	}
 
+	fibril_mutex_lock(&work->lock);
+	work->running--;
+	fibril_condvar_signal(&work->cv);
+	fibril_mutex_unlock(&work->lock);
+}
+
+static errno_t gzip_multi_fibril(void *arg)
+{
+	fibril_detach(fibril_get_id());
+	gzip_multi_work_run((gzip_multi_work_t *) arg);
+
 	return EOK;
 }
+
+/** Expand GZIP compressed data
+ *
+ * The routine allocates the output buffer and handles multi-member
+ * input (concatenated GZIP streams). Members found by the boundary
+ * scan are decoded independently on worker fibrils (running on
+ * multiple threads); if the scan turns out to have split wrongly
+ * (the magic bytes happened to occur inside compressed data), the
+ * input is decoded again sequentially.
+ *
+ * The size of a single member's uncompressed data is limited to
+ * 4 GiB by the format. So far, no CRC is performed.
+ *
+ * @param[in]  src     Source data buffer.
+ * @param[in]  srclen  Source buffer size (bytes).
+ * @param[out] dest    Destination data buffer.
+ * @param[out] destlen Destination buffer size (bytes).
+ *
+ * @return EOK on success.
+ * @return ENOENT on distance too large.
+ * @return EINVAL on invalid Huffman code, invalid deflate data,
+ *                   invalid compression method or invalid stream.
+ * @return ELIMIT on input buffer overrun.
+ * @return ENOMEM on output buffer overrun.
+ *
+ */
+errno_t gzip_expand(void *src, size_t srclen, void **dest, size_t *destlen)
+{
+	if (srclen < sizeof(gzip_header_t) + sizeof(gzip_footer_t))
+		return EINVAL;
+
+	uint8_t *data = (uint8_t *) src;
+
+	/* The input must begin with a valid member header. */
+	if ((data[0] != GZIP_ID1) || (data[1] != GZIP_ID2) ||
+	    (data[2] != GZIP_METHOD_DEFLATE))
+		return EINVAL;
+
+	/* Scan for candidate member boundaries. */
+	size_t nmembers = 1;
+	size_t pos;
+	for (pos = 1; pos + sizeof(gzip_footer_t) < srclen; pos++) {
+		if ((data[pos] == GZIP_ID1) && (data[pos + 1] == GZIP_ID2) &&
+		    (data[pos + 2] == GZIP_METHOD_DEFLATE) &&
+		    ((data[pos + 3] & ~GZIP_FLAGS_MASK) == 0))
+			nmembers++;
+	}
+
+	if (nmembers == 1) {
+		size_t destwrite;
+		size_t srcread;
+
+		gzip_footer_t footer;
+		memcpy(&footer, src + srclen - sizeof(footer), sizeof(footer));
+
+		*destlen = uint32_t_le2host(footer.size);
+		*dest = malloc(*destlen);
+		if (*dest == NULL)
+			return ENOMEM;
+
+		errno_t ret = gzip_expand_member(src, srclen, *dest, *destlen,
+		    &srcread, &destwrite);
+		if ((ret == EOK) && (srcread != srclen))
+			ret = EINVAL;
+
+		if (ret != EOK) {
+			free(*dest);
+			*dest = NULL;
+			return ret;
+		}
+
+		return EOK;
+	}
+
+	/* Candidate boundaries and the output layout (prefix sums). */
+	size_t *bounds = malloc((nmembers + 1) * sizeof(size_t));
+	size_t *offs = malloc((nmembers + 1) * sizeof(size_t));
+	if ((bounds == NULL) || (offs == NULL)) {
+		free(bounds);
+		free(offs);
+		return ENOMEM;
+	}
+
+	size_t member = 0;
+	bounds[member++] = 0;
+	for (pos = 1; pos + sizeof(gzip_footer_t) < srclen; pos++) {
+		if ((data[pos] == GZIP_ID1) && (data[pos + 1] == GZIP_ID2) &&
+		    (data[pos + 2] == GZIP_METHOD_DEFLATE) &&
+		    ((data[pos + 3] & ~GZIP_FLAGS_MASK) == 0))
+			bounds[member++] = pos;
+	}
+	bounds[member] = srclen;
+
+	bool sane = true;
+	offs[0] = 0;
+	for (member = 0; member < nmembers; member++) {
+		if (bounds[member + 1] - bounds[member] <
+		    sizeof(gzip_header_t) + sizeof(gzip_footer_t)) {
+			sane = false;
+			break;
+		}
+
+		gzip_footer_t footer;
+		memcpy(&footer, data + bounds[member + 1] - sizeof(footer),
+		    sizeof(footer));
+
+		size_t size = uint32_t_le2host(footer.size);
+		if (offs[member] + size < offs[member]) {
+			sane = false;
+			break;
+		}
+
+		offs[member + 1] = offs[member] + size;
+	}
+
+	if (sane) {
+		uint8_t *out = malloc(offs[nmembers] > 0 ? offs[nmembers] : 1);
+		if (out == NULL) {
+			free(bounds);
+			free(offs);
+			return ENOMEM;
+		}
+
+		gzip_multi_work_t work = {
+			.src = data,
+			.dest = out,
+			.bounds = bounds,
+			.offs = offs,
+			.nmembers = nmembers,
+			.next = 0,
+			.failed = false
+		};
+
+		fibril_mutex_initialize(&work.lock);
+		fibril_condvar_initialize(&work.cv);
+
+		size_t nworkers = (nmembers < GZIP_MULTI_WORKERS) ?
+		    nmembers : GZIP_MULTI_WORKERS;
+		work.running = nworkers;
+
+		fibril_enable_multithreaded();
+
+		size_t i;
+		for (i = 1; i < nworkers; i++) {
+			fid_t fid = fibril_create(gzip_multi_fibril, &work);
+			if (fid == 0) {
+				/* Unfilled worker slot */
+				fibril_mutex_lock(&work.lock);
+				work.running--;
+				fibril_mutex_unlock(&work.lock);
+				continue;
+			}
+
+			fibril_add_ready(fid);
+		}
+
+		/* Pitch in ourselves. */
+		gzip_multi_work_run(&work);
+
+		fibril_mutex_lock(&work.lock);
+		while (work.running > 0)
+			fibril_condvar_wait(&work.cv, &work.lock);
+		bool failed = work.failed;
+		fibril_mutex_unlock(&work.lock);
+
+		if (!failed) {
+			*dest = out;
+			*destlen = offs[nmembers];
+			free(bounds);
+			free(offs);
+			return EOK;
+		}
+
+		free(out);
+	}
+
+	free(bounds);
+	free(offs);
+
+	/*
+	 * The boundary scan found magic bytes inside compressed
+	 * data; decode sequentially instead.
+	 */
+	return gzip_expand_serial(src, srclen, dest, destlen);
+}
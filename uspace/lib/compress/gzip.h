@@ -32,5 +32,7 @@
 #include <stddef.h>
 
 extern errno_t gzip_expand(void *, size_t, void **, size_t *);
+extern errno_t gzip_expand_member(void *, size_t, void *, size_t, size_t *,
+    size_t *);
 
 #endif
@@ -32,5 +32,7 @@
 #include <stddef.h>
 
 extern errno_t inflate(void *, size_t, void *, size_t);
+extern errno_t inflate_stream(void *, size_t, void *, size_t, size_t *,
+    size_t *);
 
 #endif
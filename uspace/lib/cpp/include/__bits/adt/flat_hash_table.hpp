@@ -0,0 +1,828 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+#define LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Open-addressing hash table with one control byte per slot.
+     *
+     * Unlike the node-based table behind the standard unordered
+     * containers, all elements live in one flat array: a lookup walks
+     * a byte array of hash fragments and only touches a slot whose
+     * fragment matches, so the common miss costs one cache line
+     * instead of a pointer chase per node. The price is that
+     * references are invalidated by rehashing and elements must be
+     * movable; flat_unordered_map/set document this.
+     *
+     * Control byte values: 0x80 empty, 0xfe deleted (tombstone),
+     * 0x00-0x7f occupied with the low 7 bits of the hash.
+     */
+    template<class Value, class Key, class KeyExtract, class Hash, class Pred>
+    class flat_table
+    {
+        public:
+            using value_type = Value;
+            using key_type   = Key;
+            using size_type  = size_t;
+
+            static constexpr uint8_t ctrl_empty{0x80};
+            static constexpr uint8_t ctrl_deleted{0xfe};
+
+            static constexpr size_type min_capacity{8};
+
+            flat_table(size_type capacity, Hash hasher, Pred pred)
+                : slots_{}, ctrl_{}, capacity_{}, size_{}, deleted_{},
+                  hasher_{hasher}, pred_{pred}, key_extract_{}
+            {
+                init_(pow2_(capacity < min_capacity ? min_capacity : capacity));
+            }
+
+            flat_table(const flat_table& other)
+                : flat_table{other.capacity_, other.hasher_, other.pred_}
+            {
+                for (size_type i = 0; i < other.capacity_; ++i)
+                {
+                    if (is_full_(other.ctrl_[i]))
+                        insert(other.slots_[i]);
+                }
+            }
+
+            flat_table(flat_table&& other)
+                : slots_{other.slots_}, ctrl_{other.ctrl_},
+                  capacity_{other.capacity_}, size_{other.size_},
+                  deleted_{other.deleted_}, hasher_{move(other.hasher_)},
+                  pred_{move(other.pred_)}, key_extract_{}
+            {
+                other.slots_ = nullptr;
+                other.ctrl_ = nullptr;
+                other.capacity_ = 0;
+                other.size_ = 0;
+                other.deleted_ = 0;
+            }
+
+            flat_table& operator=(const flat_table& other)
+            {
+                if (this != &other)
+                {
+                    flat_table tmp{other};
+                    swap(tmp);
+                }
+
+                return *this;
+            }
+
+            flat_table& operator=(flat_table&& other)
+            {
+                if (this != &other)
+                    swap(other);
+
+                return *this;
+            }
+
+            ~flat_table()
+            {
+                destroy_();
+            }
+
+            void swap(flat_table& other)
+            {
+                std::swap(slots_, other.slots_);
+                std::swap(ctrl_, other.ctrl_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(size_, other.size_);
+                std::swap(deleted_, other.deleted_);
+                std::swap(hasher_, other.hasher_);
+                std::swap(pred_, other.pred_);
+            }
+
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            size_type capacity() const noexcept
+            {
+                return capacity_;
+            }
+
+            bool empty() const noexcept
+            {
+                return size_ == 0;
+            }
+
+            void clear()
+            {
+                for (size_type i = 0; i < capacity_; ++i)
+                {
+                    if (is_full_(ctrl_[i]))
+                        slots_[i].~value_type();
+
+                    ctrl_[i] = ctrl_empty;
+                }
+
+                size_ = 0;
+                deleted_ = 0;
+            }
+
+            /** Index of the slot holding the key, or capacity(). */
+            template<class K>
+            size_type find_index(const K& key) const
+            {
+                auto hash = hasher_(key);
+                auto h2 = h2_(hash);
+                auto idx = h1_(hash);
+
+                while (true)
+                {
+                    auto c = ctrl_[idx];
+
+                    if (c == ctrl_empty)
+                        return capacity_;
+
+                    if (c == h2 && pred_(key_extract_(slots_[idx]), key))
+                        return idx;
+
+                    idx = (idx + 1) & (capacity_ - 1);
+                }
+            }
+
+            /** First slot of the table that holds an element. */
+            size_type first_index() const
+            {
+                return next_index(size_type(-1));
+            }
+
+            /** Next slot after idx that holds an element. */
+            size_type next_index(size_type idx) const
+            {
+                for (++idx; idx < capacity_; ++idx)
+                {
+                    if (is_full_(ctrl_[idx]))
+                        break;
+                }
+
+                return idx < capacity_ ? idx : capacity_;
+            }
+
+            value_type* slot(size_type idx) const
+            {
+                return &slots_[idx];
+            }
+
+            /**
+             * Insert an element built from args, unless the key is
+             * present. Returns the slot index and whether an insertion
+             * happened.
+             */
+            template<class... Args>
+            pair<size_type, bool> emplace(const key_type& key, Args&&... args)
+            {
+                auto idx = find_index(key);
+                if (idx != capacity_)
+                    return pair<size_type, bool>{idx, false};
+
+                grow_if_needed_();
+
+                auto hash = hasher_(key);
+                idx = h1_(hash);
+
+                while (is_full_(ctrl_[idx]))
+                    idx = (idx + 1) & (capacity_ - 1);
+
+                if (ctrl_[idx] == ctrl_deleted)
+                    --deleted_;
+
+                new (&slots_[idx]) value_type(forward<Args>(args)...);
+                ctrl_[idx] = h2_(hash);
+                ++size_;
+
+                return pair<size_type, bool>{idx, true};
+            }
+
+            pair<size_type, bool> insert(const value_type& val)
+            {
+                return emplace(key_extract_(val), val);
+            }
+
+            pair<size_type, bool> insert(value_type&& val)
+            {
+                return emplace(key_extract_(val), move(val));
+            }
+
+            template<class K>
+            size_type erase(const K& key)
+            {
+                auto idx = find_index(key);
+                if (idx == capacity_)
+                    return 0;
+
+                erase_index(idx);
+                return 1;
+            }
+
+            void erase_index(size_type idx)
+            {
+                slots_[idx].~value_type();
+                ctrl_[idx] = ctrl_deleted;
+                --size_;
+                ++deleted_;
+            }
+
+            void reserve(size_type count)
+            {
+                /* Keep the load factor below 7/8 after count inserts. */
+                auto needed = count + count / 7 + 1;
+                if (needed > capacity_)
+                    rehash_(pow2_(needed));
+            }
+
+        private:
+            value_type* slots_;
+            uint8_t* ctrl_;
+            size_type capacity_;
+            size_type size_;
+            size_type deleted_;
+            Hash hasher_;
+            Pred pred_;
+            KeyExtract key_extract_;
+
+            static bool is_full_(uint8_t c)
+            {
+                return (c & 0x80) == 0;
+            }
+
+            /*
+             * The bucket comes from the low bits and the control
+             * fragment from the next seven: std::hash is close to the
+             * identity for integers, so the low bits are the ones
+             * that actually differ between nearby keys.
+             */
+            size_type h1_(size_t hash) const
+            {
+                return hash & (capacity_ - 1);
+            }
+
+            static uint8_t h2_(size_t hash)
+            {
+                return static_cast<uint8_t>((hash >> 7) & 0x7f);
+            }
+
+            static size_type pow2_(size_type n)
+            {
+                size_type res{min_capacity};
+                while (res < n)
+                    res <<= 1;
+
+                return res;
+            }
+
+            void init_(size_type capacity)
+            {
+                slots_ = allocator<value_type>{}.allocate(capacity);
+                ctrl_ = allocator<uint8_t>{}.allocate(capacity);
+                capacity_ = capacity;
+                size_ = 0;
+                deleted_ = 0;
+
+                for (size_type i = 0; i < capacity_; ++i)
+                    ctrl_[i] = ctrl_empty;
+            }
+
+            void destroy_()
+            {
+                if (!slots_)
+                    return;
+
+                for (size_type i = 0; i < capacity_; ++i)
+                {
+                    if (is_full_(ctrl_[i]))
+                        slots_[i].~value_type();
+                }
+
+                allocator<value_type>{}.deallocate(slots_, capacity_);
+                allocator<uint8_t>{}.deallocate(ctrl_, capacity_);
+                slots_ = nullptr;
+                ctrl_ = nullptr;
+            }
+
+            void grow_if_needed_()
+            {
+                /*
+                 * Tombstones count against the load factor so that
+                 * erase-heavy workloads do not degrade probes forever.
+                 */
+                if ((size_ + deleted_ + 1) * 8 >= capacity_ * 7)
+                    rehash_(capacity_ * 2);
+            }
+
+            void rehash_(size_type new_capacity)
+            {
+                auto old_slots = slots_;
+                auto old_ctrl = ctrl_;
+                auto old_capacity = capacity_;
+
+                init_(new_capacity);
+
+                for (size_type i = 0; i < old_capacity; ++i)
+                {
+                    if (!is_full_(old_ctrl[i]))
+                        continue;
+
+                    auto hash = hasher_(key_extract_(old_slots[i]));
+                    auto idx = h1_(hash);
+
+                    while (is_full_(ctrl_[idx]))
+                        idx = (idx + 1) & (capacity_ - 1);
+
+                    new (&slots_[idx]) value_type(move(old_slots[i]));
+                    ctrl_[idx] = h2_(hash);
+                    ++size_;
+
+                    old_slots[i].~value_type();
+                }
+
+                allocator<value_type>{}.deallocate(old_slots, old_capacity);
+                allocator<uint8_t>{}.deallocate(old_ctrl, old_capacity);
+            }
+    };
+
+    template<class Table, class Value>
+    class flat_table_iterator
+    {
+        public:
+            using value_type        = Value;
+            using reference         = Value&;
+            using pointer           = Value*;
+            using size_type         = size_t;
+            using difference_type   = ptrdiff_t;
+            using iterator_category = forward_iterator_tag;
+
+            flat_table_iterator(Table* table = nullptr, size_type idx = 0)
+                : table_{table}, idx_{idx}
+            { /* DUMMY BODY */ }
+
+            reference operator*() const
+            {
+                return *reinterpret_cast<pointer>(table_->slot(idx_));
+            }
+
+            pointer operator->() const
+            {
+                return reinterpret_cast<pointer>(table_->slot(idx_));
+            }
+
+            flat_table_iterator& operator++()
+            {
+                idx_ = table_->next_index(idx_);
+                return *this;
+            }
+
+            flat_table_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const flat_table_iterator& other) const
+            {
+                return table_ == other.table_ && idx_ == other.idx_;
+            }
+
+            bool operator!=(const flat_table_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            size_type index() const
+            {
+                return idx_;
+            }
+
+        private:
+            Table* table_;
+            size_type idx_;
+    };
+}
+
+namespace std
+{
+    /**
+     * Flat hash map, a vendor extension.
+     *
+     * Faster than unordered_map for lookup-heavy workloads, but
+     * rehashing invalidates references and iterators, the mapped
+     * value_type is pair<Key, T> (no const Key) and only forward
+     * iteration is provided. find() and erase() accept any key-like
+     * type the hasher and predicate can take (heterogeneous lookup).
+     */
+    template<
+        class Key, class T,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>
+    >
+    class flat_unordered_map
+    {
+        public:
+            using key_type    = Key;
+            using mapped_type = T;
+            using value_type  = pair<Key, T>;
+            using size_type   = size_t;
+            using hasher      = Hash;
+            using key_equal   = Pred;
+
+        private:
+            struct key_extract
+            {
+                const Key& operator()(const value_type& val) const
+                {
+                    return val.first;
+                }
+            };
+
+            using table_type = aux::flat_table<
+                value_type, Key, key_extract, Hash, Pred
+            >;
+
+            table_type table_;
+
+        public:
+            using iterator = aux::flat_table_iterator<table_type, value_type>;
+            using const_iterator = aux::flat_table_iterator<
+                const table_type, const value_type
+            >;
+
+            flat_unordered_map()
+                : table_{table_type::min_capacity, Hash{}, Pred{}}
+            { /* DUMMY BODY */ }
+
+            explicit flat_unordered_map(size_type buckets,
+                                        const Hash& hf = Hash{},
+                                        const Pred& eql = Pred{})
+                : table_{buckets, hf, eql}
+            { /* DUMMY BODY */ }
+
+            template<class InputIterator>
+            flat_unordered_map(InputIterator first, InputIterator last)
+                : flat_unordered_map{}
+            {
+                insert(first, last);
+            }
+
+            flat_unordered_map(initializer_list<value_type> init)
+                : flat_unordered_map{}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            iterator begin()
+            {
+                return iterator{&table_, table_.first_index()};
+            }
+
+            iterator end()
+            {
+                return iterator{&table_, table_.capacity()};
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator{&table_, table_.first_index()};
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator{&table_, table_.capacity()};
+            }
+
+            const_iterator cbegin() const
+            {
+                return begin();
+            }
+
+            const_iterator cend() const
+            {
+                return end();
+            }
+
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            bool empty() const noexcept
+            {
+                return table_.empty();
+            }
+
+            void clear()
+            {
+                table_.clear();
+            }
+
+            void reserve(size_type count)
+            {
+                table_.reserve(count);
+            }
+
+            void swap(flat_unordered_map& other)
+            {
+                table_.swap(other.table_);
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                auto res = table_.insert(val);
+                return pair<iterator, bool>{
+                    iterator{&table_, res.first}, res.second
+                };
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                auto res = table_.insert(move(val));
+                return pair<iterator, bool>{
+                    iterator{&table_, res.first}, res.second
+                };
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                /*
+                 * The key has to be known before a slot can be chosen,
+                 * so emplace builds the pair up front.
+                 */
+                return insert(value_type(forward<Args>(args)...));
+            }
+
+            mapped_type& operator[](const key_type& key)
+            {
+                auto res = table_.emplace(key, key, mapped_type{});
+                return table_.slot(res.first)->second;
+            }
+
+            mapped_type& at(const key_type& key)
+            {
+                // TODO: throw out_of_range if the key is absent
+                return table_.slot(table_.find_index(key))->second;
+            }
+
+            const mapped_type& at(const key_type& key) const
+            {
+                // TODO: throw out_of_range if the key is absent
+                return table_.slot(table_.find_index(key))->second;
+            }
+
+            template<class K>
+            iterator find(const K& key)
+            {
+                return iterator{&table_, table_.find_index(key)};
+            }
+
+            template<class K>
+            const_iterator find(const K& key) const
+            {
+                return const_iterator{&table_, table_.find_index(key)};
+            }
+
+            template<class K>
+            size_type count(const K& key) const
+            {
+                return table_.find_index(key) != table_.capacity() ? 1 : 0;
+            }
+
+            template<class K>
+            bool contains(const K& key) const
+            {
+                return count(key) != 0;
+            }
+
+            template<class K>
+            size_type erase(const K& key)
+            {
+                return table_.erase(key);
+            }
+
+            iterator erase(iterator it)
+            {
+                auto idx = it.index();
+                table_.erase_index(idx);
+
+                return iterator{&table_, table_.next_index(idx)};
+            }
+    };
+
+    /**
+     * Flat hash set, a vendor extension; see flat_unordered_map for
+     * the differences against the standard containers.
+     */
+    template<
+        class Key,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>
+    >
+    class flat_unordered_set
+    {
+        public:
+            using key_type   = Key;
+            using value_type = Key;
+            using size_type  = size_t;
+            using hasher     = Hash;
+            using key_equal  = Pred;
+
+        private:
+            struct key_extract
+            {
+                const Key& operator()(const value_type& val) const
+                {
+                    return val;
+                }
+            };
+
+            using table_type = aux::flat_table<
+                value_type, Key, key_extract, Hash, Pred
+            >;
+
+            table_type table_;
+
+        public:
+            using iterator = aux::flat_table_iterator<
+                const table_type, const value_type
+            >;
+            using const_iterator = iterator;
+
+            flat_unordered_set()
+                : table_{table_type::min_capacity, Hash{}, Pred{}}
+            { /* DUMMY BODY */ }
+
+            explicit flat_unordered_set(size_type buckets,
+                                        const Hash& hf = Hash{},
+                                        const Pred& eql = Pred{})
+                : table_{buckets, hf, eql}
+            { /* DUMMY BODY */ }
+
+            template<class InputIterator>
+            flat_unordered_set(InputIterator first, InputIterator last)
+                : flat_unordered_set{}
+            {
+                insert(first, last);
+            }
+
+            flat_unordered_set(initializer_list<value_type> init)
+                : flat_unordered_set{}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator{&table_, table_.first_index()};
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator{&table_, table_.capacity()};
+            }
+
+            const_iterator cbegin() const
+            {
+                return begin();
+            }
+
+            const_iterator cend() const
+            {
+                return end();
+            }
+
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            bool empty() const noexcept
+            {
+                return table_.empty();
+            }
+
+            void clear()
+            {
+                table_.clear();
+            }
+
+            void reserve(size_type count)
+            {
+                table_.reserve(count);
+            }
+
+            void swap(flat_unordered_set& other)
+            {
+                table_.swap(other.table_);
+            }
+
+            pair<const_iterator, bool> insert(const value_type& val)
+            {
+                auto res = table_.insert(val);
+                return pair<const_iterator, bool>{
+                    const_iterator{&table_, res.first}, res.second
+                };
+            }
+
+            pair<const_iterator, bool> insert(value_type&& val)
+            {
+                auto res = table_.insert(move(val));
+                return pair<const_iterator, bool>{
+                    const_iterator{&table_, res.first}, res.second
+                };
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            template<class... Args>
+            pair<const_iterator, bool> emplace(Args&&... args)
+            {
+                return insert(value_type(forward<Args>(args)...));
+            }
+
+            template<class K>
+            const_iterator find(const K& key) const
+            {
+                return const_iterator{&table_, table_.find_index(key)};
+            }
+
+            template<class K>
+            size_type count(const K& key) const
+            {
+                return table_.find_index(key) != table_.capacity() ? 1 : 0;
+            }
+
+            template<class K>
+            bool contains(const K& key) const
+            {
+                return count(key) != 0;
+            }
+
+            template<class K>
+            size_type erase(const K& key)
+            {
+                return table_.erase(key);
+            }
+
+            const_iterator erase(const_iterator it)
+            {
+                auto idx = it.index();
+                table_.erase_index(idx);
+
+                return const_iterator{&table_, table_.next_index(idx)};
+            }
+    };
+}
+
+#endif
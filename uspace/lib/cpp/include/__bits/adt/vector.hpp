@@ -30,7 +30,9 @@
 #define LIBCPP_BITS_ADT_VECTOR
 
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
+#include <type_traits>
 #include <iterator>
 #include <memory>
 #include <utility>
@@ -82,7 +84,8 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = val;
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i, val);
             }
 
             template<class InputIterator>
@@ -100,7 +103,9 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i,
+                                                           other.data_[i]);
             }
 
             vector(vector&& other) noexcept
@@ -119,7 +124,9 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i,
+                                                           other.data_[i]);
             }
 
             vector(initializer_list<T> init, const Allocator& alloc = Allocator{})
@@ -131,12 +138,14 @@ namespace std
                 auto it = init.begin();
                 for (size_type i = 0; it != init.end(); ++i, ++it)
                 {
-                    data_[i] = *it;
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i, *it);
                 }
             }
 
             ~vector()
             {
+                destroy_from_end_until_(begin());
                 allocator_.deallocate(data_, capacity_);
             }
 
@@ -274,16 +283,22 @@ namespace std
 
             void resize(size_type sz)
             {
-                resize_with_copy_(size_, capacity_);
+                auto old_size = size_;
+                resize_with_copy_(sz, max(sz, capacity_));
+
+                for (size_type i = old_size; i < size_; ++i)
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i);
             }
 
             void resize(size_type sz, const value_type& val)
             {
                 auto old_size = size_;
-                resize_with_copy_(sz, capacity_);
+                resize_with_copy_(sz, max(sz, capacity_));
 
-                for (size_type i = old_size - 1; i < size_; ++i)
-                    data_[i] = val;
+                for (size_type i = old_size; i < size_; ++i)
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           data_ + i, val);
             }
 
             size_type capacity() const noexcept
@@ -385,14 +400,17 @@ namespace std
             {
                 if (size_ >= capacity_)
                     resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = x;
+                allocator_traits<Allocator>::construct(allocator_,
+                                                       data_ + size_++, x);
             }
 
             void push_back(T&& x)
             {
                 if (size_ >= capacity_)
                     resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = forward<T>(x);
+                allocator_traits<Allocator>::construct(allocator_,
+                                                       data_ + size_++,
+                                                       forward<T>(x));
             }
 
             void pop_back()
@@ -407,7 +425,8 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, 1);
-                allocator_.construct(pos, forward<Args>(args)...);
+                allocator_traits<Allocator>::construct(allocator_, pos,
+                                                       forward<Args>(args)...);
 
                 return pos;
             }
@@ -417,7 +436,7 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, 1);
-                *pos = x;
+                allocator_traits<Allocator>::construct(allocator_, pos, x);
 
                 return pos;
             }
@@ -427,7 +446,8 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, 1);
-                *pos = forward<value_type>(x);
+                allocator_traits<Allocator>::construct(allocator_, pos,
+                                                       forward<value_type>(x));
 
                 return pos;
             }
@@ -437,9 +457,10 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, count);
-                auto copy_target = pos;
+                auto target = pos;
                 for (size_type i = 0; i < count; ++i)
-                    *copy_target++ = x;
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           target++, x);
 
                 return pos;
             }
@@ -452,7 +473,10 @@ namespace std
                 auto count = static_cast<size_type>(last - first);
 
                 pos = shift_(pos, count);
-                copy(first, last, pos);
+                auto target = pos;
+                while (first != last)
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           target++, *first++);
 
                 return pos;
             }
@@ -462,25 +486,32 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, init.size());
-                copy(init.begin(), init.end(), pos);
+                auto target = pos;
+                for (const auto& val : init)
+                    allocator_traits<Allocator>::construct(allocator_,
+                                                           target++, val);
 
                 return pos;
             }
 
             iterator erase(const_iterator position)
             {
-                iterator pos = const_cast<iterator>(position);
-                copy(position + 1, cend(), pos);
-                --size_;
-
-                return pos;
+                return erase(position, position + 1);
             }
 
             iterator erase(const_iterator first, const_iterator last)
             {
                 iterator pos = const_cast<iterator>(first);
-                copy(last, cend(), pos);
-                size_ -= static_cast<size_type>(last - first);
+                auto count = static_cast<size_type>(last - first);
+
+                auto target = pos;
+                auto source = const_cast<iterator>(last);
+                while (source != end())
+                    *target++ = move(*source++);
+
+                /* The moved-from tail has to be destroyed. */
+                destroy_from_end_until_(end() - count);
+                size_ -= count;
 
                 return pos;
             }
@@ -507,14 +538,44 @@ namespace std
             size_type capacity_;
             allocator_type allocator_;
 
-            void resize_without_copy_(size_type capacity)
+            /**
+             * Move elements into raw storage and destroy the sources.
+             * Trivially copyable types relocate with one memmove; the
+             * ranges may overlap, in which case dst must be below src
+             * for the element-wise direction to be safe.
+             */
+            void relocate_(value_type* dst, value_type* src, size_type count)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                if constexpr (is_trivially_copyable_v<value_type>)
+                    memmove(dst, src, count * sizeof(value_type));
+                else
+                {
+                    for (size_type i = 0; i < count; ++i)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, dst + i, move(src[i]));
+                        allocator_traits<Allocator>::destroy(
+                            allocator_, src + i);
+                    }
+                }
+            }
 
-                data_ = allocator_.allocate(capacity);
-                size_ = 0;
-                capacity_ = capacity;
+            /** As relocate_, but for dst above src (backward pass). */
+            void relocate_backward_(value_type* dst, value_type* src,
+                                    size_type count)
+            {
+                if constexpr (is_trivially_copyable_v<value_type>)
+                    memmove(dst, src, count * sizeof(value_type));
+                else
+                {
+                    for (size_type i = count; i > 0; --i)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, dst + i - 1, move(src[i - 1]));
+                        allocator_traits<Allocator>::destroy(
+                            allocator_, src + i - 1);
+                    }
+                }
             }
 
             void resize_with_copy_(size_type size, size_type capacity)
@@ -526,9 +587,7 @@ namespace std
                 {
                     auto new_data = allocator_.allocate(capacity);
 
-                    auto to_copy = min(size, size_);
-                    for (size_type i = 0; i < to_copy; ++i)
-                        new_data[i] = move(data_[i]);
+                    relocate_(new_data, data_, min(size, size_));
 
                     std::swap(data_, new_data);
 
@@ -557,33 +616,38 @@ namespace std
                     return max(capacity_ * 2, size_type{2u});
             }
 
+            /**
+             * Open a gap of count raw slots before position. The gap
+             * is uninitialized; the caller constructs into it.
+             */
             iterator shift_(iterator position, size_type count)
             {
-                if (size_ + count < capacity_)
+                auto start_idx = static_cast<size_type>(position - begin());
+
+                if (size_ + count <= capacity_)
                 {
-                    copy_backward(position, end(), end() + count);
+                    relocate_backward_(data_ + start_idx + count,
+                                       data_ + start_idx, size_ - start_idx);
                     size_ += count;
 
                     return position;
                 }
                 else
                 {
-                    auto start_idx = static_cast<size_type>(position - begin());
-                    auto end_idx = start_idx + count;
                     auto new_size = size_ + count;
+                    auto new_capacity = next_capacity_(new_size);
+                    auto new_data = allocator_.allocate(new_capacity);
 
-                    // Auxiliary vector for easier swap.
-                    vector tmp{};
-                    tmp.resize_without_copy_(max(new_size, capacity_));
-                    tmp.size_ = new_size;
-
-                    // Copy before insertion index.
-                    copy(begin(), begin() + start_idx, tmp.begin());
+                    relocate_(new_data, data_, start_idx);
+                    relocate_(new_data + start_idx + count,
+                              data_ + start_idx, size_ - start_idx);
 
-                    // Copy after insertion index.
-                    copy(begin() + start_idx, end(), tmp.begin() + end_idx);
+                    if (data_)
+                        allocator_.deallocate(data_, capacity_);
 
-                    swap(tmp);
+                    data_ = new_data;
+                    size_ = new_size;
+                    capacity_ = new_capacity;
 
                     // Position was invalidated!
                     return begin() + start_idx;
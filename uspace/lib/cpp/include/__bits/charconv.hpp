@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_CHARCONV
+#define LIBCPP_BITS_CHARCONV
+
+#include <byteorder.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+
+namespace std
+{
+    /**
+     * 20.19, primitive numeric conversions (C++17). Locale
+     * independent, non-allocating and non-throwing.
+     */
+
+    struct to_chars_result
+    {
+        char* ptr;
+        errc ec;
+    };
+
+    struct from_chars_result
+    {
+        const char* ptr;
+        errc ec;
+    };
+
+    enum class chars_format
+    {
+        scientific = 1,
+        fixed = 2,
+        hex = 4,
+        general = fixed | scientific
+    };
+
+    namespace aux
+    {
+        inline constexpr char digit_chars[] =
+            "0123456789abcdefghijklmnopqrstuvwxyz";
+
+        /**
+         * Two digits at a time halves the number of divisions when
+         * formatting base 10, which dominates the callers.
+         */
+        inline constexpr char digit_pairs[] =
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        template<class T>
+        to_chars_result to_chars_unsigned(char* first, char* last, T value,
+                                          int base)
+        {
+            char buffer[sizeof(T) * 8];
+            char* pos = buffer + sizeof(buffer);
+
+            if (base == 10)
+            {
+                while (value >= T{100})
+                {
+                    auto rem = static_cast<size_t>(value % T{100});
+                    value /= T{100};
+
+                    *--pos = digit_pairs[rem * 2 + 1];
+                    *--pos = digit_pairs[rem * 2];
+                }
+
+                if (value >= T{10})
+                {
+                    auto rem = static_cast<size_t>(value);
+                    *--pos = digit_pairs[rem * 2 + 1];
+                    *--pos = digit_pairs[rem * 2];
+                }
+                else
+                    *--pos = static_cast<char>('0' + value);
+            }
+            else
+            {
+                do
+                {
+                    *--pos = digit_chars[value % static_cast<T>(base)];
+                    value /= static_cast<T>(base);
+                } while (value != 0);
+            }
+
+            auto len = static_cast<size_t>(buffer + sizeof(buffer) - pos);
+            if (static_cast<size_t>(last - first) < len)
+                return to_chars_result{last, errc::value_too_large};
+
+            memcpy(first, pos, len);
+
+            return to_chars_result{first + len, errc{}};
+        }
+
+        inline unsigned digit_value(char c, int base)
+        {
+            unsigned val;
+
+            if (c >= '0' && c <= '9')
+                val = static_cast<unsigned>(c - '0');
+            else if (c >= 'a' && c <= 'z')
+                val = static_cast<unsigned>(c - 'a') + 10;
+            else if (c >= 'A' && c <= 'Z')
+                val = static_cast<unsigned>(c - 'A') + 10;
+            else
+                return static_cast<unsigned>(-1);
+
+            if (val >= static_cast<unsigned>(base))
+                return static_cast<unsigned>(-1);
+
+            return val;
+        }
+
+        /**
+         * Check whether eight consecutive bytes are all decimal
+         * digits and convert them in one go (SWAR). The word tricks
+         * replace eight compare-and-multiply steps and need no
+         * ISA-specific code.
+         */
+        inline bool parse_8digits(const char* str, uint32_t* out)
+        {
+            uint64_t word;
+            memcpy(&word, str, sizeof(word));
+
+            /* The reduction below expects the first character
+             * in the least significant byte. */
+            word = uint64_t_le2host(word);
+
+            /* All bytes must be in '0'..'9'. */
+            constexpr uint64_t ascii_zero = 0x3030303030303030ULL;
+            auto digits = word - ascii_zero;
+            if (((digits | (digits + 0x0606060606060606ULL)) &
+                0xf0f0f0f0f0f0f0f0ULL) != 0)
+                return false;
+
+            /*
+             * Classic pairwise reduction: combine adjacent digits,
+             * then pairs, then quads.
+             */
+            digits = (digits * 10 + (digits >> 8)) & 0x00ff00ff00ff00ffULL;
+            digits = (digits * 100 + (digits >> 16)) &
+                0x0000ffff0000ffffULL;
+            digits = (digits * 10000 + (digits >> 32)) & 0xffffffffULL;
+
+            *out = static_cast<uint32_t>(digits);
+            return true;
+        }
+
+        template<class T>
+        from_chars_result from_chars_unsigned(const char* first,
+                                              const char* last, T& value,
+                                              int base)
+        {
+            constexpr T max = static_cast<T>(-1);
+            T result{};
+            bool overflow{false};
+            auto cur = first;
+
+            if constexpr (sizeof(T) >= sizeof(uint32_t))
+            {
+                if (base == 10)
+                {
+                    /* Bulk-parse eight digits at a time while safe. */
+                    uint32_t block;
+                    while (static_cast<size_t>(last - cur) >= 8 &&
+                        result <= max / T{100000000} / T{2} &&
+                        parse_8digits(cur, &block))
+                    {
+                        result = result * T{100000000} +
+                            static_cast<T>(block);
+                        cur += 8;
+                    }
+                }
+            }
+
+            while (cur != last)
+            {
+                auto digit = digit_value(*cur, base);
+                if (digit == static_cast<unsigned>(-1))
+                    break;
+
+                auto b = static_cast<T>(base);
+                if (result > max / b ||
+                    result * b > max - static_cast<T>(digit))
+                    overflow = true;
+                else
+                    result = result * b + static_cast<T>(digit);
+
+                ++cur;
+            }
+
+            if (cur == first)
+                return from_chars_result{first, errc::invalid_argument};
+
+            if (overflow)
+                return from_chars_result{cur, errc::result_out_of_range};
+
+            value = result;
+
+            return from_chars_result{cur, errc{}};
+        }
+
+        /**
+         * Hexadecimal floating-point formatting ("%a"); done by hand
+         * because the libc printf machinery does not implement it.
+         */
+        inline to_chars_result to_chars_hex_double(char* first, char* last,
+                                                   double value)
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            auto mantissa = bits & ((uint64_t{1} << 52) - 1);
+            auto exponent = static_cast<int>((bits >> 52) & 0x7ff);
+
+            char buffer[40];
+            char* pos = buffer;
+
+            if (bits >> 63)
+                *pos++ = '-';
+
+            if (exponent == 0x7ff)
+            {
+                const char* str = (mantissa == 0) ? "inf" : "nan";
+                memcpy(pos, str, 3);
+                pos += 3;
+            }
+            else
+            {
+                *pos++ = '0';
+                *pos++ = 'x';
+
+                int binexp;
+                if (exponent == 0)
+                {
+                    /* Zero or subnormal: no implicit leading bit. */
+                    *pos++ = '0';
+                    binexp = (mantissa == 0) ? 0 : -1022;
+                }
+                else
+                {
+                    *pos++ = '1';
+                    binexp = exponent - 1023;
+                }
+
+                if (mantissa != 0)
+                {
+                    *pos++ = '.';
+                    int nibbles = 13;
+                    while ((mantissa & 0xf) == 0)
+                    {
+                        mantissa >>= 4;
+                        --nibbles;
+                    }
+
+                    for (int i = nibbles - 1; i >= 0; --i)
+                        *pos++ = digit_chars[(mantissa >> (4 * i)) & 0xf];
+                }
+
+                *pos++ = 'p';
+                *pos++ = (binexp < 0) ? '-' : '+';
+
+                auto magnitude = static_cast<unsigned>(
+                    binexp < 0 ? -binexp : binexp);
+                auto res = to_chars_unsigned(pos, buffer + sizeof(buffer),
+                                             magnitude, 10);
+                pos = res.ptr;
+            }
+
+            auto len = static_cast<size_t>(pos - buffer);
+            if (static_cast<size_t>(last - first) < len)
+                return to_chars_result{last, errc::value_too_large};
+
+            memcpy(first, buffer, len);
+
+            return to_chars_result{first + len, errc{}};
+        }
+    }
+
+    template<class T,
+             class = enable_if_t<is_integral_v<T> && !is_same_v<T, bool>>>
+    to_chars_result to_chars(char* first, char* last, T value, int base = 10)
+    {
+        if (base < 2 || base > 36)
+            return to_chars_result{last, errc::invalid_argument};
+
+        using U = make_unsigned_t<T>;
+        U magnitude = static_cast<U>(value);
+
+        if constexpr (is_signed_v<T>)
+        {
+            if (value < 0)
+            {
+                if (first == last)
+                    return to_chars_result{last, errc::value_too_large};
+
+                *first++ = '-';
+                magnitude = static_cast<U>(U{} - static_cast<U>(value));
+            }
+        }
+
+        return aux::to_chars_unsigned(first, last, magnitude, base);
+    }
+
+    template<class T,
+             class = enable_if_t<is_integral_v<T> && !is_same_v<T, bool>>>
+    from_chars_result from_chars(const char* first, const char* last,
+                                 T& value, int base = 10)
+    {
+        if (base < 2 || base > 36 || first == last)
+            return from_chars_result{first, errc::invalid_argument};
+
+        using U = make_unsigned_t<T>;
+
+        auto cur = first;
+        const bool negative = is_signed_v<T> && *cur == '-';
+        if (negative)
+            ++cur;
+
+        U magnitude{};
+        auto res = aux::from_chars_unsigned(cur, last, magnitude, base);
+        if (res.ec != errc{})
+        {
+            if (res.ec == errc::invalid_argument)
+                return from_chars_result{first, errc::invalid_argument};
+
+            return res;
+        }
+
+        if constexpr (is_signed_v<T>)
+        {
+            constexpr U limit = static_cast<U>(
+                static_cast<make_unsigned_t<T>>(-1) / 2);
+
+            if (negative)
+            {
+                if (magnitude > limit + 1)
+                    return from_chars_result{res.ptr,
+                        errc::result_out_of_range};
+
+                value = static_cast<T>(U{} - magnitude);
+            }
+            else
+            {
+                if (magnitude > limit)
+                    return from_chars_result{res.ptr,
+                        errc::result_out_of_range};
+
+                value = static_cast<T>(magnitude);
+            }
+        }
+        else
+            value = static_cast<T>(magnitude);
+
+        return from_chars_result{res.ptr, errc{}};
+    }
+
+    /**
+     * Floating-point conversions. Formatting uses the printf
+     * machinery with enough digits to round-trip (not the shortest
+     * representation) and parsing goes through strtold on a bounded
+     * copy; both are locale-free on this system.
+     */
+
+    inline to_chars_result to_chars(char* first, char* last, double value,
+                                    chars_format fmt = chars_format::general)
+    {
+        if (fmt == chars_format::hex)
+            return aux::to_chars_hex_double(first, last, value);
+
+        char buffer[64];
+        const char* spec = (fmt == chars_format::fixed) ? "%.17f" :
+            (fmt == chars_format::scientific) ? "%.17e" : "%.17g";
+
+        auto len = snprintf(buffer, sizeof(buffer), spec, value);
+        if (len < 0 || static_cast<size_t>(len) >= sizeof(buffer))
+            return to_chars_result{last, errc::value_too_large};
+
+        if (last - first < len)
+            return to_chars_result{last, errc::value_too_large};
+
+        memcpy(first, buffer, static_cast<size_t>(len));
+
+        return to_chars_result{first + len, errc{}};
+    }
+
+    inline from_chars_result from_chars(const char* first, const char* last,
+                                        double& value,
+                                        chars_format = chars_format::general)
+    {
+        if (first == last)
+            return from_chars_result{first, errc::invalid_argument};
+
+        /*
+         * strtold() skips leading whitespace and accepts an explicit
+         * plus sign; from_chars must reject both.
+         */
+        char head = *first;
+        if (head == '+' || (head >= '\t' && head <= '\r') || head == ' ')
+            return from_chars_result{first, errc::invalid_argument};
+
+        char buffer[128];
+        auto len = static_cast<size_t>(last - first);
+        if (len >= sizeof(buffer))
+            len = sizeof(buffer) - 1;
+
+        memcpy(buffer, first, len);
+        buffer[len] = 0;
+
+        char* end{};
+        errno = 0;
+        auto res = ::strtold(buffer, &end);
+
+        if (end == buffer)
+            return from_chars_result{first, errc::invalid_argument};
+
+        if (errno == ERANGE)
+            return from_chars_result{first + (end - buffer),
+                errc::result_out_of_range};
+
+        value = static_cast<double>(res);
+
+        return from_chars_result{first + (end - buffer), errc{}};
+    }
+}
+
+#endif
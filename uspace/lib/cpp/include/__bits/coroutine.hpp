@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_COROUTINE
+#define LIBCPP_BITS_COROUTINE
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#error "<coroutine> requires compiler coroutine support (-fcoroutines)"
+#else
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace std
+{
+    /**
+     * 17.12.3, coroutine traits (C++20).
+     */
+
+    namespace aux
+    {
+        template<class R, class = void>
+        struct coroutine_traits_base
+        { /* DUMMY BODY */ };
+
+        template<class R>
+        struct coroutine_traits_base<R, void_t<typename R::promise_type>>
+        {
+            using promise_type = typename R::promise_type;
+        };
+    }
+
+    template<class R, class... Args>
+    struct coroutine_traits: aux::coroutine_traits_base<R>
+    { /* DUMMY BODY */ };
+
+    /**
+     * 17.12.4, coroutine handle.
+     */
+
+    template<class Promise = void>
+    struct coroutine_handle;
+
+    template<>
+    struct coroutine_handle<void>
+    {
+        public:
+            constexpr coroutine_handle() noexcept
+                : ptr_{}
+            { /* DUMMY BODY */ }
+
+            constexpr coroutine_handle(nullptr_t) noexcept
+                : ptr_{}
+            { /* DUMMY BODY */ }
+
+            coroutine_handle& operator=(nullptr_t) noexcept
+            {
+                ptr_ = nullptr;
+                return *this;
+            }
+
+            constexpr void* address() const noexcept
+            {
+                return ptr_;
+            }
+
+            static constexpr coroutine_handle from_address(void* addr) noexcept
+            {
+                coroutine_handle handle{};
+                handle.ptr_ = addr;
+
+                return handle;
+            }
+
+            constexpr explicit operator bool() const noexcept
+            {
+                return ptr_ != nullptr;
+            }
+
+            bool done() const
+            {
+                return __builtin_coro_done(ptr_);
+            }
+
+            void operator()() const
+            {
+                resume();
+            }
+
+            void resume() const
+            {
+                __builtin_coro_resume(ptr_);
+            }
+
+            void destroy() const
+            {
+                __builtin_coro_destroy(ptr_);
+            }
+
+        protected:
+            void* ptr_;
+    };
+
+    template<class Promise>
+    struct coroutine_handle: coroutine_handle<void>
+    {
+        public:
+            using coroutine_handle<void>::coroutine_handle;
+
+            static coroutine_handle from_promise(Promise& promise)
+            {
+                coroutine_handle handle{};
+                handle.ptr_ = __builtin_coro_promise(
+                    &promise, alignof(Promise), true);
+
+                return handle;
+            }
+
+            static constexpr coroutine_handle from_address(void* addr) noexcept
+            {
+                coroutine_handle handle{};
+                handle.ptr_ = addr;
+
+                return handle;
+            }
+
+            Promise& promise() const
+            {
+                return *static_cast<Promise*>(__builtin_coro_promise(
+                    ptr_, alignof(Promise), false));
+            }
+    };
+
+    inline bool operator==(coroutine_handle<> lhs,
+                           coroutine_handle<> rhs) noexcept
+    {
+        return lhs.address() == rhs.address();
+    }
+
+    inline bool operator!=(coroutine_handle<> lhs,
+                           coroutine_handle<> rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    inline bool operator<(coroutine_handle<> lhs,
+                          coroutine_handle<> rhs) noexcept
+    {
+        return less<void*>{}(lhs.address(), rhs.address());
+    }
+
+    template<class Promise>
+    struct hash<coroutine_handle<Promise>>
+    {
+        size_t operator()(const coroutine_handle<Promise>& handle)
+            const noexcept
+        {
+            return hash<void*>{}(handle.address());
+        }
+    };
+
+    /**
+     * 17.12.5, no-op coroutines.
+     */
+
+    struct noop_coroutine_promise
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct coroutine_handle<noop_coroutine_promise>
+        : coroutine_handle<void>
+    {
+        public:
+            constexpr explicit operator bool() const noexcept
+            {
+                return true;
+            }
+
+            constexpr bool done() const noexcept
+            {
+                return false;
+            }
+
+            constexpr void operator()() const noexcept
+            { /* DUMMY BODY */ }
+
+            constexpr void resume() const noexcept
+            { /* DUMMY BODY */ }
+
+            constexpr void destroy() const noexcept
+            { /* DUMMY BODY */ }
+
+        private:
+            friend coroutine_handle<noop_coroutine_promise>
+            noop_coroutine() noexcept;
+
+            coroutine_handle()
+            {
+                ptr_ = __builtin_coro_noop();
+            }
+    };
+
+    using noop_coroutine_handle = coroutine_handle<noop_coroutine_promise>;
+
+    inline noop_coroutine_handle noop_coroutine() noexcept
+    {
+        return noop_coroutine_handle{};
+    }
+
+    /**
+     * 17.12.6, trivial awaitables.
+     */
+
+    struct suspend_never
+    {
+        constexpr bool await_ready() const noexcept
+        {
+            return true;
+        }
+
+        constexpr void await_suspend(coroutine_handle<>) const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void await_resume() const noexcept
+        { /* DUMMY BODY */ }
+    };
+
+    struct suspend_always
+    {
+        constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        constexpr void await_suspend(coroutine_handle<>) const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void await_resume() const noexcept
+        { /* DUMMY BODY */ }
+    };
+}
+
+#endif
+#endif
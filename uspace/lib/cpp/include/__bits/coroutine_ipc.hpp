@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_COROUTINE_IPC
+#define LIBCPP_BITS_COROUTINE_IPC
+
+#include <async.h>
+#include <coroutine>
+#include <cstdlib>
+#include <errno.h>
+
+/**
+ * Awaitable adapters over the libc async framework, a vendor
+ * extension. A coroutine awaiting an IPC reply completes without
+ * suspending when the answer has already arrived (the hot path costs
+ * no allocation and no context switch); otherwise the wait parks the
+ * carrying fibril exactly as async_wait_for() would, so coroutines
+ * compose with existing fibril-based code and its locking rules.
+ */
+namespace helenos::async
+{
+    /** Awaiter for the reply to an asynchronous request. */
+    class reply_awaiter
+    {
+        public:
+            explicit reply_awaiter(aid_t aid)
+                : aid_{aid}, retval_{}
+            { /* DUMMY BODY */ }
+
+            bool await_ready()
+            {
+                /* Completed already? Then do not suspend at all. */
+                return async_wait_timeout(aid_, &retval_, 0) != ETIMEOUT;
+            }
+
+            bool await_suspend(std::coroutine_handle<>)
+            {
+                async_wait_for(aid_, &retval_);
+
+                /* The reply is in; continue without rescheduling. */
+                return false;
+            }
+
+            errno_t await_resume() const
+            {
+                return retval_;
+            }
+
+        private:
+            aid_t aid_;
+            errno_t retval_;
+    };
+
+    /** co_await the answer to a previously sent request. */
+    inline reply_awaiter reply_to(aid_t aid)
+    {
+        return reply_awaiter{aid};
+    }
+
+    /**
+     * Fire-and-forget coroutine, e.g. one connection handler. It runs
+     * eagerly on the current fibril until its first suspension and
+     * cleans up after itself.
+     */
+    struct task
+    {
+        struct promise_type
+        {
+            task get_return_object()
+            {
+                return task{};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            { /* DUMMY BODY */ }
+
+            void unhandled_exception()
+            {
+                std::abort();
+            }
+        };
+    };
+}
+
+#endif
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_EXECUTION
+#define LIBCPP_BITS_EXECUTION
+
+#include <__bits/algorithm.hpp>
+#include <cstdlib>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace std::execution
+{
+    /**
+     * 20.18, execution policies (C++17).
+     */
+
+    class sequenced_policy
+    { /* DUMMY BODY */ };
+
+    class parallel_policy
+    { /* DUMMY BODY */ };
+
+    inline constexpr sequenced_policy seq{};
+    inline constexpr parallel_policy par{};
+}
+
+namespace std
+{
+    template<class T>
+    struct is_execution_policy: false_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<class T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+}
+
+namespace std::aux
+{
+    template<class T>
+    inline constexpr bool is_parallel_policy_v = is_same_v<
+        decay_t<T>, execution::parallel_policy
+    >;
+
+    /**
+     * std::thread is fibril-backed; a few runner threads carry the
+     * fibrils of one task, matching what fibril_enable_multithreaded()
+     * spawns.
+     */
+    constexpr size_t parallel_workers{4};
+
+    /** Ranges shorter than this are not worth splitting. */
+    constexpr size_t parallel_min_chunk{1024};
+
+    /** How [0, count) splits into chunks; see parallel_chunks(). */
+    inline size_t parallel_chunk_count(size_t count)
+    {
+        size_t chunks = count / parallel_min_chunk;
+        if (chunks > parallel_workers)
+            chunks = parallel_workers;
+
+        return chunks < 2 ? 1 : chunks;
+    }
+
+    /**
+     * Run fn(chunk, begin, end) over disjoint chunks of [0, count),
+     * the chunks other than the caller's own on worker threads. fn
+     * must be safe to call concurrently on disjoint ranges.
+     */
+    template<class F>
+    void parallel_chunks(size_t count, F fn)
+    {
+        size_t chunks = parallel_chunk_count(count);
+
+        if (chunks < 2)
+        {
+            if (count > 0)
+                fn(size_t{0}, size_t{0}, count);
+            return;
+        }
+
+        ::helenos::fibril_enable_multithreaded();
+
+        vector<thread> workers{};
+        size_t per_chunk = count / chunks;
+
+        for (size_t i = 1; i < chunks; ++i)
+        {
+            size_t begin = i * per_chunk;
+            size_t end = (i + 1 == chunks) ? count : begin + per_chunk;
+
+            workers.emplace_back([=](){
+                fn(i, begin, end);
+            });
+        }
+
+        fn(size_t{0}, size_t{0}, per_chunk);
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+}
+
+namespace std
+{
+    /**
+     * Parallel overloads (C++17 execution policies) for a few
+     * frequently used algorithms. The sequenced policy simply
+     * forwards to the classic overloads; the parallel policy splits
+     * the range between worker threads.
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator, class Function,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    void for_each(ExecutionPolicy&& policy, ForwardIterator first,
+                  ForwardIterator last, Function f)
+    {
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+        {
+            auto count = static_cast<size_t>(distance(first, last));
+
+            aux::parallel_chunks(count, [&](size_t, size_t begin, size_t end){
+                auto it = next(first, begin);
+                for (size_t i = begin; i < end; ++i)
+                    f(*it++);
+            });
+        }
+        else
+            for_each(first, last, move(f));
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class UnaryOperation,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    ForwardIterator2 transform(ExecutionPolicy&& policy, ForwardIterator1 first,
+                               ForwardIterator1 last, ForwardIterator2 result,
+                               UnaryOperation op)
+    {
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+        {
+            auto count = static_cast<size_t>(distance(first, last));
+
+            aux::parallel_chunks(count, [&](size_t, size_t begin, size_t end){
+                auto in = next(first, begin);
+                auto out = next(result, begin);
+                for (size_t i = begin; i < end; ++i)
+                    *out++ = op(*in++);
+            });
+
+            return next(result, count);
+        }
+        else
+            return transform(first, last, result, move(op));
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class ForwardIterator3, class BinaryOperation,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    ForwardIterator3 transform(ExecutionPolicy&& policy, ForwardIterator1 first1,
+                               ForwardIterator1 last1, ForwardIterator2 first2,
+                               ForwardIterator3 result, BinaryOperation op)
+    {
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+        {
+            auto count = static_cast<size_t>(distance(first1, last1));
+
+            aux::parallel_chunks(count, [&](size_t, size_t begin, size_t end){
+                auto in1 = next(first1, begin);
+                auto in2 = next(first2, begin);
+                auto out = next(result, begin);
+                for (size_t i = begin; i < end; ++i)
+                    *out++ = op(*in1++, *in2++);
+            });
+
+            return next(result, count);
+        }
+        else
+            return transform(first1, last1, first2, result, move(op));
+    }
+
+    /**
+     * 29.8.3, reduce (C++17). The binary operation must be
+     * associative and commutative for the parallel overload, as the
+     * standard requires.
+     */
+
+    template<class InputIterator, class T, class BinaryOperation>
+    T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op)
+    {
+        auto acc = move(init);
+        while (first != last)
+            acc = op(move(acc), *first++);
+
+        return acc;
+    }
+
+    template<class InputIterator, class T>
+    T reduce(InputIterator first, InputIterator last, T init)
+    {
+        return reduce(first, last, move(init), plus<>{});
+    }
+
+    template<class InputIterator>
+    typename iterator_traits<InputIterator>::value_type
+    reduce(InputIterator first, InputIterator last)
+    {
+        using value_type = typename iterator_traits<InputIterator>::value_type;
+
+        return reduce(first, last, value_type{}, plus<>{});
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T,
+             class BinaryOperation,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    T reduce(ExecutionPolicy&& policy, ForwardIterator first,
+             ForwardIterator last, T init, BinaryOperation op)
+    {
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+        {
+            auto count = static_cast<size_t>(distance(first, last));
+            if (count == 0)
+                return init;
+
+            /*
+             * Each chunk reduces into its own slot and the slots are
+             * folded sequentially at the end.
+             */
+            vector<T> partial(aux::parallel_chunk_count(count), init);
+
+            aux::parallel_chunks(count,
+                [&](size_t chunk, size_t begin, size_t end){
+                auto it = next(first, begin);
+                auto acc = *it++;
+                for (size_t i = begin + 1; i < end; ++i)
+                    acc = op(move(acc), *it++);
+
+                partial[chunk] = move(acc);
+            });
+
+            auto acc = move(init);
+            for (size_t i = 0; i < partial.size(); ++i)
+                acc = op(move(acc), move(partial[i]));
+
+            return acc;
+        }
+        else
+            return reduce(first, last, move(init), move(op));
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    T reduce(ExecutionPolicy&& policy, ForwardIterator first,
+             ForwardIterator last, T init)
+    {
+        return reduce(forward<ExecutionPolicy>(policy), first, last,
+                      move(init), plus<>{});
+    }
+
+    /**
+     * Parallel sort: the chunks are sorted in parallel and then
+     * merged pairwise.
+     */
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    void sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+              RandomAccessIterator last, Compare comp)
+    {
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+        {
+            using value_type =
+                typename iterator_traits<RandomAccessIterator>::value_type;
+
+            auto count = static_cast<size_t>(last - first);
+
+            aux::parallel_chunks(count, [&](size_t, size_t begin, size_t end){
+                sort(first + begin, first + end, comp);
+            });
+
+            size_t chunks = aux::parallel_chunk_count(count);
+            if (chunks < 2)
+                return;
+
+            size_t per_chunk = count / chunks;
+
+            /* Pairwise merge through a buffer. */
+            vector<value_type> buf{};
+            buf.reserve(count);
+
+            size_t merged = per_chunk;
+            while (merged < count)
+            {
+                size_t mid = merged;
+                size_t end = min(count, (merged / per_chunk + 1) * per_chunk);
+                if (end <= mid)
+                    end = count;
+
+                buf.clear();
+
+                size_t a = 0, b = mid;
+                while (a < mid && b < end)
+                {
+                    if (comp(first[b], first[a]))
+                        buf.push_back(move(first[b++]));
+                    else
+                        buf.push_back(move(first[a++]));
+                }
+                while (a < mid)
+                    buf.push_back(move(first[a++]));
+                while (b < end)
+                    buf.push_back(move(first[b++]));
+
+                for (size_t i = 0; i < buf.size(); ++i)
+                    first[i] = move(buf[i]);
+
+                merged = end;
+            }
+        }
+        else
+            sort(first, last, move(comp));
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator,
+             class = enable_if_t<is_execution_policy_v<decay_t<ExecutionPolicy>>>>
+    void sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+              RandomAccessIterator last)
+    {
+        using value_type =
+            typename iterator_traits<RandomAccessIterator>::value_type;
+
+        sort(forward<ExecutionPolicy>(policy), first, last,
+             less<value_type>{});
+    }
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <__bits/functional/reference_wrapper.hpp>
 #include <__bits/memory/allocator_arg.hpp>
 #include <__bits/memory/allocator_traits.hpp>
+#include <cstddef>
 #include <typeinfo>
 #include <type_traits>
 #include <utility>
@@ -119,19 +120,19 @@ namespace std
                 : callable_{}, callable_size_{other.callable_size_},
                   call_{other.call_}, copy_{other.copy_}, dest_{other.dest_}
             {
-                callable_ = new uint8_t[callable_size_];
-                (*copy_)(callable_, other.callable_);
+                if (other.callable_)
+                {
+                    callable_ = other.is_inline_() ? buffer_
+                        : new uint8_t[callable_size_];
+                    (*copy_)(callable_, other.callable_);
+                }
             }
 
             function(function&& other)
-                : callable_{other.callable_}, callable_size_{other.callable_size_},
-                  call_{other.call_}, copy_{other.copy_}, dest_{other.dest_}
+                : callable_{}, callable_size_{}, call_{},
+                  copy_{}, dest_{}
             {
-                other.callable_ = nullptr;
-                other.callable_size_ = size_t{};
-                other.call_ = nullptr;
-                other.copy_ = nullptr;
-                other.dest_ = nullptr;
+                move_from_(move(other));
             }
 
             // TODO: shall not participate in overloading unless aux::is_callable<F>
@@ -142,7 +143,17 @@ namespace std
                   copy_{(copy_t)aux::copy_callable<F>},
                   dest_{(dest_t)aux::destroy_callable<F>}
             {
-                callable_ = new uint8_t[callable_size_];
+                /**
+                 * Small targets that can't throw while being
+                 * copied around live in the in-object buffer,
+                 * avoiding the allocation entirely.
+                 */
+                if constexpr (sizeof(F) <= buffer_size_ &&
+                    is_nothrow_copy_constructible_v<F>)
+                    callable_ = buffer_;
+                else
+                    callable_ = new uint8_t[callable_size_];
+
                 (*copy_)(callable_, (uint8_t*)&f);
             }
 
@@ -192,18 +203,7 @@ namespace std
             function& operator=(function&& rhs)
             {
                 clear_();
-
-                callable_ = rhs.callable_;
-                callable_size_ = rhs.callable_size_;
-                call_ = rhs.call_;
-                copy_ = rhs.copy_;
-                dest_ = rhs.dest_;
-
-                rhs.callable_ = nullptr;
-                rhs.callable_size_ = size_t{};
-                rhs.call_ = nullptr;
-                rhs.copy_ = nullptr;
-                rhs.dest_ = nullptr;
+                move_from_(move(rhs));
 
                 return *this;
             }
@@ -219,13 +219,9 @@ namespace std
             template<class F>
             function& operator=(F&& f)
             {
-                callable_size_ = sizeof(F);
-                callable_ = new uint8_t[callable_size_];
-                call_ = aux::invoke_callable<F, R, Args...>;
-                copy_ = aux::copy_callable<F>;
-                dest_ = aux::destroy_callable<F>;
+                function{forward<F>(f)}.swap(*this);
 
-                (*copy_)(callable_, (uint8_t*)&f);
+                return *this;
             }
 
             template<class F>
@@ -236,11 +232,7 @@ namespace std
 
             ~function()
             {
-                if (callable_)
-                {
-                    (*dest_)(callable_);
-                    delete[] callable_;
-                }
+                clear_();
             }
 
             /**
@@ -249,11 +241,16 @@ namespace std
 
             void swap(function& other) noexcept
             {
-                std::swap(callable_, other.callable_);
-                std::swap(callable_size_, other.callable_size_);
-                std::swap(call_, other.call_);
-                std::swap(copy_, other.copy_);
-                std::swap(dest_, other.dest_);
+                /**
+                 * Inline targets can't have their pointers
+                 * exchanged (they'd point into the other
+                 * object's buffer), so rotate through a
+                 * temporary instead.
+                 */
+                function tmp{};
+                tmp.move_from_(move(*this));
+                move_from_(move(other));
+                other.move_from_(move(tmp));
             }
 
             template<class F, class A>
@@ -316,20 +313,59 @@ namespace std
             using copy_t = void (*)(uint8_t*, uint8_t*);
             using dest_t = void (*)(uint8_t*);
 
+            static constexpr size_t buffer_size_{4 * sizeof(void*)};
+
+            alignas(max_align_t) uint8_t buffer_[buffer_size_];
             uint8_t* callable_;
             size_t callable_size_;
             call_t call_;
             copy_t copy_;
             dest_t dest_;
 
+            bool is_inline_() const
+            {
+                return callable_ == buffer_;
+            }
+
             void clear_()
             {
                 if (callable_)
                 {
                     (*dest_)(callable_);
-                    delete[] callable_;
+                    if (!is_inline_())
+                        delete[] callable_;
+                    callable_ = nullptr;
+                }
+            }
+
+            /**
+             * Pilfers rhs into an empty *this; inline targets
+             * are copied over (their bytes can't be stolen) and
+             * destroyed in place, heap targets change owner.
+             */
+            void move_from_(function&& rhs)
+            {
+                callable_size_ = rhs.callable_size_;
+                call_ = rhs.call_;
+                copy_ = rhs.copy_;
+                dest_ = rhs.dest_;
+
+                if (!rhs.callable_)
                     callable_ = nullptr;
+                else if (rhs.is_inline_())
+                {
+                    callable_ = buffer_;
+                    (*copy_)(callable_, rhs.callable_);
+                    (*dest_)(rhs.callable_);
                 }
+                else
+                    callable_ = rhs.callable_;
+
+                rhs.callable_ = nullptr;
+                rhs.callable_size_ = size_t{};
+                rhs.call_ = nullptr;
+                rhs.copy_ = nullptr;
+                rhs.dest_ = nullptr;
             }
     };
 
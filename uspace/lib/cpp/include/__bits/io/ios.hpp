@@ -183,13 +183,11 @@ namespace std
             using event_callback = void (*)(event, ios_base&, int);
             void register_callback(event_callback fn, int index);
 
-            static bool sync_with_stdio(bool sync = true)
-            {
-                auto old = sync_;
-                sync_ = sync;
-
-                return old;
-            }
+            /**
+             * Defined in iostream.cpp, where it can reach the
+             * standard stream buffers and retune them.
+             */
+            static bool sync_with_stdio(bool sync = true);
 
         protected:
             ios_base();
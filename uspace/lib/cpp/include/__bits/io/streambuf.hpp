@@ -337,7 +337,7 @@ namespace std
 
                 streamsize i{0};
                 auto eof = traits_type::eof();
-                for (; i <= n; ++i)
+                for (; i < n; ++i)
                 {
                     if (!read_avail_() && traits_type::eq_int_type(uflow(), eof))
                         break;
@@ -381,7 +381,7 @@ namespace std
                     return 0;
 
                 streamsize i{0};
-                for (; i <= n; ++i)
+                for (; i < n; ++i)
                 {
                     if (!write_avail_() && traits_type::eq_int_type(overflow(), traits_type::eof()))
                         break;
@@ -31,6 +31,7 @@
 
 #include <iosfwd>
 #include <cstdio>
+#include <cstring>
 #include <streambuf>
 
 namespace std::aux
@@ -128,11 +129,48 @@ namespace std::aux
     {
         public:
             stdout_streambuf()
-                : basic_streambuf<Char, Traits>{}
+                : basic_streambuf<Char, Traits>{}, buffer_{nullptr}
             { /* DUMMY BODY */ }
 
             virtual ~stdout_streambuf()
-            { /* DUMMY BODY */ }
+            {
+                sync();
+
+                if (buffer_)
+                    delete[] buffer_;
+            }
+
+            /**
+             * While synchronized with stdio (the default) every
+             * write is handed to the FILE layer right away so that
+             * printf and cout output interleaves correctly. Untying
+             * installs an internal put area, turning sputc into a
+             * pointer store, and switches the FILE to full buffering
+             * so flushed blocks pass straight into the fd buffer
+             * without the line-buffered newline scan.
+             */
+            void stdio_sync(bool sync)
+            {
+                if (!sync && !buffer_)
+                {
+                    buffer_ = new char_type[buf_size_];
+                    this->setp(buffer_, buffer_ + buf_size_);
+
+                    fflush(out_);
+                    setvbuf(out_, nullptr, _IOFBF, BUFSIZ);
+                }
+                else if (sync && buffer_)
+                {
+                    flush_buffer_();
+                    this->setp(nullptr, nullptr);
+
+                    delete[] buffer_;
+                    buffer_ = nullptr;
+
+                    fflush(out_);
+                    setvbuf(out_, nullptr, _IOLBF, BUFSIZ);
+                }
+            }
 
         protected:
             using traits_type = Traits;
@@ -142,10 +180,19 @@ namespace std::aux
 
             int_type overflow(int_type c = traits_type::eof()) override
             {
+                if (buffer_ && flush_buffer_() < 0)
+                    return traits_type::eof();
+
                 if (!traits_type::eq_int_type(c, traits_type::eof()))
                 {
                     auto cc = traits_type::to_char_type(c);
-                    fwrite(&cc, sizeof(char_type), 1, out_);
+                    if (this->write_avail_())
+                    {
+                        *this->pptr() = cc;
+                        this->pbump(1);
+                    }
+                    else if (fwrite(&cc, sizeof(char_type), 1, out_) != 1)
+                        return traits_type::eof();
                 }
 
                 return traits_type::not_eof(c);
@@ -153,18 +200,63 @@ namespace std::aux
 
             streamsize xsputn(const char_type* s, streamsize n) override
             {
-                return fwrite(s, sizeof(char_type), n, out_);
+                if (!buffer_)
+                    return fwrite(s, sizeof(char_type), n, out_);
+
+                auto avail = static_cast<streamsize>(
+                    this->epptr() - this->pptr());
+                if (n < avail)
+                {
+                    memcpy(this->pptr(), s, n * sizeof(char_type));
+                    this->pbump(static_cast<int>(n));
+
+                    return n;
+                }
+
+                /* Pending bytes first, then oversized writes go out
+                 * directly instead of through the put area. */
+                if (flush_buffer_() < 0)
+                    return 0;
+
+                if (n >= buf_size_)
+                    return fwrite(s, sizeof(char_type), n, out_);
+
+                memcpy(this->pptr(), s, n * sizeof(char_type));
+                this->pbump(static_cast<int>(n));
+
+                return n;
             }
 
             int sync() override
             {
+                if (buffer_ && flush_buffer_() < 0)
+                    return -1;
+
                 if (fflush(out_))
                     return -1;
                 return 0;
             }
 
         private:
+            int flush_buffer_()
+            {
+                auto pending = static_cast<size_t>(
+                    this->pptr() - this->pbase());
+
+                this->setp(buffer_, buffer_ + buf_size_);
+
+                if (pending > 0 &&
+                    fwrite(buffer_, sizeof(char_type), pending, out_)
+                    != pending)
+                    return -1;
+                return 0;
+            }
+
             FILE* out_{stdout};
+
+            char_type* buffer_;
+
+            static constexpr streamsize buf_size_{4096};
     };
 }
 
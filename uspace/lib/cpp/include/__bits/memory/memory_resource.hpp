@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_MEMORY_RESOURCE
+#define LIBCPP_BITS_MEMORY_RESOURCE
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <forward_list>
+#include <functional>
+#include <list>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace std::pmr
+{
+    /**
+     * 20.12.2, class memory_resource (C++17).
+     */
+    class memory_resource
+    {
+        public:
+            virtual ~memory_resource()
+            { /* DUMMY BODY */ }
+
+            void* allocate(size_t bytes,
+                           size_t alignment = alignof(max_align_t))
+            {
+                return do_allocate(bytes, alignment);
+            }
+
+            void deallocate(void* p, size_t bytes,
+                            size_t alignment = alignof(max_align_t))
+            {
+                do_deallocate(p, bytes, alignment);
+            }
+
+            bool is_equal(const memory_resource& other) const noexcept
+            {
+                return do_is_equal(other);
+            }
+
+        private:
+            virtual void* do_allocate(size_t, size_t) = 0;
+            virtual void do_deallocate(void*, size_t, size_t) = 0;
+            virtual bool do_is_equal(const memory_resource&)
+                const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& lhs,
+                           const memory_resource& rhs) noexcept
+    {
+        return &lhs == &rhs || lhs.is_equal(rhs);
+    }
+
+    inline bool operator!=(const memory_resource& lhs,
+                           const memory_resource& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    memory_resource* new_delete_resource() noexcept;
+    memory_resource* null_memory_resource() noexcept;
+    memory_resource* get_default_resource() noexcept;
+    memory_resource* set_default_resource(memory_resource* r) noexcept;
+
+    /**
+     * 20.12.3, class template polymorphic_allocator.
+     */
+    template<class T>
+    class polymorphic_allocator
+    {
+        public:
+            using value_type = T;
+
+            polymorphic_allocator() noexcept
+                : resource_{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(memory_resource* r)
+                : resource_{r}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(const polymorphic_allocator&) = default;
+
+            template<class U>
+            polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+                : resource_{other.resource()}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator&
+            operator=(const polymorphic_allocator&) = delete;
+
+            T* allocate(size_t n)
+            {
+                return static_cast<T*>(
+                    resource_->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T* p, size_t n)
+            {
+                resource_->deallocate(p, n * sizeof(T), alignof(T));
+            }
+
+            polymorphic_allocator
+            select_on_container_copy_construction() const
+            {
+                return polymorphic_allocator{};
+            }
+
+            memory_resource* resource() const noexcept
+            {
+                return resource_;
+            }
+
+        private:
+            memory_resource* resource_;
+    };
+
+    template<class T1, class T2>
+    bool operator==(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return *lhs.resource() == *rhs.resource();
+    }
+
+    template<class T1, class T2>
+    bool operator!=(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * 20.12.5, class monotonic_buffer_resource.
+     *
+     * Allocation bumps a pointer and deallocation is a no-op; all
+     * memory returns to the upstream resource at once on release()
+     * or destruction. This is the per-request arena: fill it during
+     * the request, release it afterwards.
+     */
+    class monotonic_buffer_resource: public memory_resource
+    {
+        public:
+            explicit monotonic_buffer_resource(memory_resource* upstream)
+                : upstream_{upstream}, current_{}, available_{},
+                  next_size_{initial_chunk_size}, chunks_{}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource()
+                : monotonic_buffer_resource{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(size_t initial_size,
+                                      memory_resource* upstream)
+                : monotonic_buffer_resource{upstream}
+            {
+                if (initial_size > 0)
+                    next_size_ = initial_size;
+            }
+
+            explicit monotonic_buffer_resource(size_t initial_size)
+                : monotonic_buffer_resource{initial_size,
+                                            get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                      memory_resource* upstream)
+                : monotonic_buffer_resource{upstream}
+            {
+                current_ = buffer;
+                available_ = buffer_size;
+                if (buffer_size > 0)
+                    next_size_ = buffer_size * 2;
+            }
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size)
+                : monotonic_buffer_resource{buffer, buffer_size,
+                                            get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&)
+                = delete;
+            monotonic_buffer_resource&
+            operator=(const monotonic_buffer_resource&) = delete;
+
+            ~monotonic_buffer_resource() override
+            {
+                release();
+            }
+
+            void release()
+            {
+                while (chunks_)
+                {
+                    auto next = chunks_->next;
+                    upstream_->deallocate(chunks_, chunks_->size);
+                    chunks_ = next;
+                }
+
+                current_ = nullptr;
+                available_ = 0;
+            }
+
+            memory_resource* upstream_resource() const
+            {
+                return upstream_;
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                auto addr = reinterpret_cast<uintptr_t>(current_);
+                auto aligned = (addr + alignment - 1) & ~(alignment - 1);
+                auto padding = aligned - addr;
+
+                if (current_ == nullptr ||
+                    padding + bytes > available_)
+                {
+                    grow_(bytes + alignment);
+
+                    addr = reinterpret_cast<uintptr_t>(current_);
+                    aligned = (addr + alignment - 1) & ~(alignment - 1);
+                    padding = aligned - addr;
+                }
+
+                current_ = reinterpret_cast<void*>(aligned + bytes);
+                available_ -= padding + bytes;
+
+                return reinterpret_cast<void*>(aligned);
+            }
+
+            void do_deallocate(void*, size_t, size_t) override
+            { /* DUMMY BODY */ }
+
+            bool do_is_equal(const memory_resource& other)
+                const noexcept override
+            {
+                return this == &other;
+            }
+
+        private:
+            static constexpr size_t initial_chunk_size{1024};
+
+            struct chunk
+            {
+                chunk* next;
+                size_t size;
+            };
+
+            void grow_(size_t at_least)
+            {
+                auto size = next_size_;
+                if (size < at_least + sizeof(chunk))
+                    size = at_least + sizeof(chunk);
+
+                auto mem = static_cast<chunk*>(upstream_->allocate(size));
+                mem->next = chunks_;
+                mem->size = size;
+                chunks_ = mem;
+
+                current_ = mem + 1;
+                available_ = size - sizeof(chunk);
+                next_size_ = size * 2;
+            }
+
+            memory_resource* upstream_;
+            void* current_;
+            size_t available_;
+            size_t next_size_;
+            chunk* chunks_;
+    };
+
+    /**
+     * 20.12.6, pool resource classes.
+     */
+    struct pool_options
+    {
+        size_t max_blocks_per_chunk = 0;
+        size_t largest_required_pool_block = 0;
+    };
+
+    /**
+     * Unsynchronized pool: power-of-two size classes with free lists,
+     * refilled in slabs from the upstream resource. Oversized blocks
+     * go to upstream directly. Not thread-safe, as the name says.
+     */
+    class unsynchronized_pool_resource: public memory_resource
+    {
+        public:
+            unsynchronized_pool_resource(const pool_options& opts,
+                                         memory_resource* upstream)
+                : upstream_{upstream}, options_{opts}, slabs_{},
+                  oversized_{}
+            {
+                for (size_t i = 0; i < pool_count; ++i)
+                    free_lists_[i] = nullptr;
+
+                if (options_.max_blocks_per_chunk == 0 ||
+                    options_.max_blocks_per_chunk > default_blocks_per_slab)
+                    options_.max_blocks_per_chunk = default_blocks_per_slab;
+            }
+
+            unsynchronized_pool_resource()
+                : unsynchronized_pool_resource{pool_options{},
+                                               get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(memory_resource* upstream)
+                : unsynchronized_pool_resource{pool_options{}, upstream}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(const pool_options& opts)
+                : unsynchronized_pool_resource{opts, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            unsynchronized_pool_resource(const unsynchronized_pool_resource&)
+                = delete;
+            unsynchronized_pool_resource&
+            operator=(const unsynchronized_pool_resource&) = delete;
+
+            ~unsynchronized_pool_resource() override
+            {
+                release();
+            }
+
+            void release()
+            {
+                while (slabs_)
+                {
+                    auto next = slabs_->next;
+                    upstream_->deallocate(slabs_, slabs_->size);
+                    slabs_ = next;
+                }
+
+                while (oversized_)
+                {
+                    auto next = oversized_->next;
+                    upstream_->deallocate(oversized_, oversized_->size);
+                    oversized_ = next;
+                }
+
+                for (size_t i = 0; i < pool_count; ++i)
+                    free_lists_[i] = nullptr;
+            }
+
+            memory_resource* upstream_resource() const
+            {
+                return upstream_;
+            }
+
+            pool_options options() const
+            {
+                return options_;
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                auto idx = pool_index_(bytes, alignment);
+                if (idx == pool_count)
+                    return allocate_oversized_(bytes);
+
+                if (!free_lists_[idx])
+                    refill_(idx);
+
+                auto block = free_lists_[idx];
+                free_lists_[idx] = block->next;
+
+                return block;
+            }
+
+            void do_deallocate(void* p, size_t bytes,
+                               size_t alignment) override
+            {
+                auto idx = pool_index_(bytes, alignment);
+                if (idx == pool_count)
+                {
+                    deallocate_oversized_(p);
+                    return;
+                }
+
+                auto block = static_cast<block_t*>(p);
+                block->next = free_lists_[idx];
+                free_lists_[idx] = block;
+            }
+
+            bool do_is_equal(const memory_resource& other)
+                const noexcept override
+            {
+                return this == &other;
+            }
+
+        private:
+            static constexpr size_t smallest_block_log{3};
+            static constexpr size_t pool_count{10};
+            static constexpr size_t default_blocks_per_slab{32};
+
+            struct block_t
+            {
+                block_t* next;
+            };
+
+            struct slab_t
+            {
+                slab_t* next;
+                size_t size;
+            };
+
+            static size_t block_size_(size_t idx)
+            {
+                return size_t{1} << (smallest_block_log + idx);
+            }
+
+            size_t pool_index_(size_t bytes, size_t alignment) const
+            {
+                auto needed = bytes > alignment ? bytes : alignment;
+
+                for (size_t i = 0; i < pool_count; ++i)
+                {
+                    if (block_size_(i) >= needed)
+                        return i;
+                }
+
+                return pool_count;
+            }
+
+            void refill_(size_t idx)
+            {
+                auto bsize = block_size_(idx);
+                auto blocks = options_.max_blocks_per_chunk;
+
+                /*
+                 * Blocks must be aligned to their own (power of two)
+                 * size, since pool_index_ places any allocation with
+                 * that alignment requirement here; leave room to round
+                 * the first block up past the slab header.
+                 */
+                auto size = sizeof(slab_t) + bsize * (blocks + 1);
+
+                auto slab = static_cast<slab_t*>(upstream_->allocate(size));
+                slab->next = slabs_;
+                slab->size = size;
+                slabs_ = slab;
+
+                auto start = reinterpret_cast<uintptr_t>(slab + 1);
+                start = (start + bsize - 1) & ~(bsize - 1);
+
+                auto mem = reinterpret_cast<char*>(start);
+                for (size_t i = 0; i < blocks; ++i)
+                {
+                    auto block = reinterpret_cast<block_t*>(mem + i * bsize);
+                    block->next = free_lists_[idx];
+                    free_lists_[idx] = block;
+                }
+            }
+
+            void* allocate_oversized_(size_t bytes)
+            {
+                auto size = sizeof(slab_t) + bytes;
+                auto hdr = static_cast<slab_t*>(upstream_->allocate(size));
+                hdr->next = oversized_;
+                hdr->size = size;
+                oversized_ = hdr;
+
+                return hdr + 1;
+            }
+
+            void deallocate_oversized_(void* p)
+            {
+                auto hdr = static_cast<slab_t*>(p) - 1;
+
+                auto** link = &oversized_;
+                while (*link && *link != hdr)
+                    link = &(*link)->next;
+
+                if (*link)
+                {
+                    *link = hdr->next;
+                    upstream_->deallocate(hdr, hdr->size);
+                }
+            }
+
+            memory_resource* upstream_;
+            pool_options options_;
+            block_t* free_lists_[pool_count];
+            slab_t* slabs_;
+            slab_t* oversized_;
+    };
+
+    /**
+     * 20.12.1, pmr container aliases.
+     */
+    template<class T>
+    using vector = std::vector<T, polymorphic_allocator<T>>;
+
+    template<class T>
+    using deque = std::deque<T, polymorphic_allocator<T>>;
+
+    template<class T>
+    using list = std::list<T, polymorphic_allocator<T>>;
+
+    template<class T>
+    using forward_list = std::forward_list<T, polymorphic_allocator<T>>;
+
+    template<class Key, class Compare = less<Key>>
+    using set = std::set<Key, Compare, polymorphic_allocator<Key>>;
+
+    template<class Key, class T, class Compare = less<Key>>
+    using map = std::map<
+        Key, T, Compare, polymorphic_allocator<pair<const Key, T>>
+    >;
+
+    template<class Char, class Traits = char_traits<Char>>
+    using basic_string = std::basic_string<
+        Char, Traits, polymorphic_allocator<Char>
+    >;
+
+    using string = basic_string<char>;
+}
+
+#endif
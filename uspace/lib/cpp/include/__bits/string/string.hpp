@@ -478,24 +478,20 @@ namespace std
                  *  size() = 0
                  *  capacity() = unspecified
                  */
-                data_ = allocator_.allocate(default_capacity_);
-                capacity_ = default_capacity_;
+                reset_to_sso_();
             }
 
             basic_string(const basic_string& other)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_},
+                : data_{}, size_{other.size_}, capacity_{},
                   allocator_{other.allocator_}
             {
                 init_(other.data(), size_);
             }
 
             basic_string(basic_string&& other)
-                : data_{other.data_}, size_{other.size_},
-                  capacity_{other.capacity_}, allocator_{move(other.allocator_)}
+                : data_{}, size_{}, capacity_{}, allocator_{move(other.allocator_)}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                steal_from_(move(other));
             }
 
             basic_string(const basic_string& other, size_type pos, size_type n = npos,
@@ -508,7 +504,7 @@ namespace std
             }
 
             basic_string(const value_type* str, size_type n, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{}, size_{n}, capacity_{}, allocator_{alloc}
             {
                 init_(str, size_);
             }
@@ -520,9 +516,9 @@ namespace std
             }
 
             basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{}, size_{n}, capacity_{n + 1}, allocator_{alloc}
             {
-                data_ = allocator_.allocate(capacity_);
+                data_ = allocate_(capacity_);
                 for (size_type i = 0; i < size_; ++i)
                     traits_type::assign(data_[i], c);
                 ensure_null_terminator_();
@@ -536,8 +532,8 @@ namespace std
                 if constexpr (is_integral<InputIterator>::value)
                 { // Required by the standard.
                     size_ = static_cast<size_type>(first);
-                    capacity_ = size_;
-                    data_ = allocator_.allocate(capacity_);
+                    capacity_ = size_ + 1;
+                    data_ = allocate_(capacity_);
 
                     for (size_type i = 0; i < size_; ++i)
                         traits_type::assign(data_[i], static_cast<value_type>(last));
@@ -555,22 +551,20 @@ namespace std
             { /* DUMMY BODY */ }
 
             basic_string(const basic_string& other, const allocator_type& alloc)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{}, size_{other.size_}, capacity_{}, allocator_{alloc}
             {
                 init_(other.data(), size_);
             }
 
             basic_string(basic_string&& other, const allocator_type& alloc)
-                : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{}, size_{}, capacity_{}, allocator_{alloc}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                steal_from_(move(other));
             }
 
             ~basic_string()
             {
-                allocator_.deallocate(data_, capacity_);
+                deallocate_();
             }
 
             basic_string& operator=(const basic_string& other)
@@ -1160,9 +1154,23 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::propagate_on_container_swap::value ||
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
-                std::swap(data_, other.data_);
-                std::swap(size_, other.size_);
-                std::swap(capacity_, other.capacity_);
+                if (!is_sso_() && !other.is_sso_())
+                {
+                    std::swap(data_, other.data_);
+                    std::swap(size_, other.size_);
+                    std::swap(capacity_, other.capacity_);
+                    return;
+                }
+
+                /*
+                 * At least one side lives in its inline buffer, whose
+                 * address cannot be exchanged; go through a temporary.
+                 */
+                basic_string tmp{std::move(*this)};
+                deallocate_();
+                steal_from_(std::move(other));
+                other.deallocate_();
+                other.steal_from_(std::move(tmp));
             }
 
             /**
@@ -1481,6 +1489,77 @@ namespace std
             size_type capacity_;
             allocator_type allocator_;
 
+            /**
+             * Small-string optimization: strings of up to sso_chars_
+             * characters live in this inline buffer instead of a heap
+             * block. data_ then points at the buffer, so all read
+             * paths work unchanged; only allocation, deallocation and
+             * ownership transfer need to distinguish the two modes.
+             */
+            static constexpr size_type sso_chars_{22 / sizeof(value_type)};
+            value_type sso_buffer_[sso_chars_ + 1];
+
+            bool is_sso_() const noexcept
+            {
+                return data_ == sso_buffer_;
+            }
+
+            /**
+             * Get storage for at least the given capacity, preferring
+             * the inline buffer. Updates the capacity to what the
+             * returned storage really holds.
+             */
+            value_type* allocate_(size_type& capacity)
+            {
+                if (capacity <= sso_chars_ + 1)
+                {
+                    capacity = sso_chars_ + 1;
+                    return sso_buffer_;
+                }
+
+                return allocator_.allocate(capacity);
+            }
+
+            void deallocate_()
+            {
+                if (data_ && !is_sso_())
+                    allocator_.deallocate(data_, capacity_);
+            }
+
+            /** Make the string an empty inline-buffer string. */
+            void reset_to_sso_()
+            {
+                data_ = sso_buffer_;
+                size_ = 0;
+                capacity_ = sso_chars_ + 1;
+                ensure_null_terminator_();
+            }
+
+            /**
+             * Take over the contents of another string. Any previous
+             * contents must already be released. The donor is left as
+             * a valid empty string.
+             */
+            void steal_from_(basic_string&& other)
+            {
+                if (other.is_sso_())
+                {
+                    data_ = sso_buffer_;
+                    capacity_ = sso_chars_ + 1;
+                    size_ = other.size_;
+                    traits_type::copy(data_, other.data_, size_);
+                    ensure_null_terminator_();
+                }
+                else
+                {
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    capacity_ = other.capacity_;
+                }
+
+                other.reset_to_sso_();
+            }
+
             template<class C, class T, class A>
             friend class basic_stringbuf;
 
@@ -1494,13 +1573,12 @@ namespace std
 
             void init_(const value_type* str, size_type size)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                deallocate_();
 
                 size_ = size;
                 capacity_ = size + 1;
 
-                data_ = allocator_.allocate(capacity_);
+                data_ = allocate_(capacity_);
                 traits_type::copy(data_, str, size);
                 ensure_null_terminator_();
             }
@@ -1526,10 +1604,9 @@ namespace std
 
             void resize_without_copy_(size_type capacity)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                deallocate_();
 
-                data_ = allocator_.allocate(capacity);
+                data_ = allocate_(capacity);
                 size_ = 0;
                 capacity_ = capacity;
                 ensure_null_terminator_();
@@ -1539,14 +1616,18 @@ namespace std
             {
                 if(capacity_ == 0 || capacity_ < capacity)
                 {
-                    auto new_data = allocator_.allocate(capacity);
+                    auto new_data = allocate_(capacity);
 
-                    auto to_copy = min(size, size_);
-                    traits_type::move(new_data, data_, to_copy);
+                    if (new_data != data_)
+                    {
+                        auto to_copy = min(size, size_);
+                        traits_type::move(new_data, data_, to_copy);
 
-                    std::swap(data_, new_data);
+                        std::swap(data_, new_data);
 
-                    allocator_.deallocate(new_data, capacity_);
+                        if (new_data && new_data != sso_buffer_)
+                            allocator_.deallocate(new_data, capacity_);
+                    }
                 }
 
                 capacity_ = capacity;
@@ -1686,7 +1767,7 @@ namespace std
     operator+(const basic_string<Char, Traits, Allocator>& lhs,
               const Char* rhs)
     {
-        return lhs + basic_string<Char, Traits, Allocator>{rhs};
+        return basic_string<Char, Traits, Allocator>{lhs}.append(rhs);
     }
 
     template<class Char, class Traits, class Allocator>
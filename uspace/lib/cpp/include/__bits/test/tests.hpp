@@ -219,6 +219,68 @@ namespace std::test
             void test_multi();
     };
 
+    class synch_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_mutex();
+            void bench_condvar();
+            void bench_promise_future();
+            void test_contended_lock();
+    };
+
+    class charconv_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_to_chars_int();
+            void test_from_chars_int();
+            void test_round_trip();
+    };
+
+    class memory_resource_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_monotonic();
+            void test_pool();
+            void test_pmr_containers();
+    };
+
+    class execution_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_par_for_each();
+            void test_par_transform();
+            void test_par_reduce();
+            void test_par_sort();
+    };
+
+    class flat_unordered_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_map_insert_lookup();
+            void test_map_erase_and_growth();
+            void test_set_operations();
+    };
+
     class numeric_test: public test_suite
     {
         public:
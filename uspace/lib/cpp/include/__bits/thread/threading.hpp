@@ -42,15 +42,41 @@ namespace std::aux
     struct thread_tag
     { /* DUMMY BODY */ };
 
+    /**
+     * Mutex with an inlined uncontended fast path. The state is
+     * driven by atomic operations on state (0 - free, 1 - locked,
+     * 2 - locked with waiters), so lock and unlock without
+     * contention never enter fibril_synch and its process-global
+     * futex. Contended fibrils park on the embedded fibril
+     * primitives.
+     */
+    struct fast_fibril_mutex_t
+    {
+        int state;
+        ::helenos::fibril_mutex_t inner;
+        ::helenos::fibril_condvar_t cv;
+    };
+
+    /**
+     * Waiters synchronize through the embedded mutex, which both
+     * wait and signal take, so a notification can't slip in
+     * between a waiter releasing the user mutex and parking.
+     */
+    struct fast_fibril_condvar_t
+    {
+        ::helenos::fibril_mutex_t inner;
+        ::helenos::fibril_condvar_t cv;
+    };
+
     template<class>
     struct threading_policy;
 
     template<>
     struct threading_policy<fibril_tag>
     {
-        using mutex_type        = ::helenos::fibril_mutex_t;
+        using mutex_type        = fast_fibril_mutex_t;
         using thread_type       = ::helenos::fid_t;
-        using condvar_type      = ::helenos::fibril_condvar_t;
+        using condvar_type      = fast_fibril_condvar_t;
         using time_unit         = ::helenos::usec_t;
         using shared_mutex_type = ::helenos::fibril_rwlock_t;
 
@@ -88,56 +114,105 @@ namespace std::aux
         {
             static void init(mutex_type& mtx)
             {
-                ::helenos::fibril_mutex_initialize(&mtx);
+                mtx.state = 0;
+                ::helenos::fibril_mutex_initialize(&mtx.inner);
+                ::helenos::fibril_condvar_initialize(&mtx.cv);
             }
 
             static void lock(mutex_type& mtx)
             {
-                ::helenos::fibril_mutex_lock(&mtx);
+                int expected{};
+                if (__atomic_compare_exchange_n(&mtx.state, &expected, 1,
+                    false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                    return;
+
+                lock_contended_(mtx);
             }
 
             static void unlock(mutex_type& mtx)
             {
-                ::helenos::fibril_mutex_unlock(&mtx);
+                if (__atomic_exchange_n(&mtx.state, 0,
+                    __ATOMIC_RELEASE) == 2)
+                {
+                    ::helenos::fibril_mutex_lock(&mtx.inner);
+                    ::helenos::fibril_condvar_signal(&mtx.cv);
+                    ::helenos::fibril_mutex_unlock(&mtx.inner);
+                }
             }
 
             static bool try_lock(mutex_type& mtx)
             {
-                return ::helenos::fibril_mutex_trylock(&mtx);
+                int expected{};
+
+                return __atomic_compare_exchange_n(&mtx.state, &expected, 1,
+                    false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
             }
 
             static bool try_lock_for(mutex_type& mtx, time_unit timeout)
             {
-                // TODO: we need fibril_mutex_trylock_for() :/
+                // TODO: we need a timed parking primitive :/
                 return try_lock(mtx);
             }
+
+            private:
+                static void lock_contended_(mutex_type& mtx)
+                {
+                    /**
+                     * Marking the state contended (2) makes the
+                     * eventual unlock signal us; getting 0 back
+                     * means the holder left in the meantime and
+                     * the lock is ours (with a spurious signal
+                     * later at worst).
+                     */
+                    ::helenos::fibril_mutex_lock(&mtx.inner);
+                    while (__atomic_exchange_n(&mtx.state, 2,
+                        __ATOMIC_ACQUIRE) != 0)
+                        ::helenos::fibril_condvar_wait(&mtx.cv, &mtx.inner);
+                    ::helenos::fibril_mutex_unlock(&mtx.inner);
+                }
         };
 
         struct condvar
         {
             static void init(condvar_type& cv)
             {
-                ::helenos::fibril_condvar_initialize(&cv);
+                ::helenos::fibril_mutex_initialize(&cv.inner);
+                ::helenos::fibril_condvar_initialize(&cv.cv);
             }
 
             static void wait(condvar_type& cv, mutex_type& mtx)
             {
-                ::helenos::fibril_condvar_wait(&cv, &mtx);
+                ::helenos::fibril_mutex_lock(&cv.inner);
+                mutex::unlock(mtx);
+                ::helenos::fibril_condvar_wait(&cv.cv, &cv.inner);
+                ::helenos::fibril_mutex_unlock(&cv.inner);
+                mutex::lock(mtx);
             }
 
             static int wait_for(condvar_type& cv, mutex_type& mtx, time_unit timeout)
             {
-                return ::helenos::fibril_condvar_wait_timeout(&cv, &mtx, timeout);
+                ::helenos::fibril_mutex_lock(&cv.inner);
+                mutex::unlock(mtx);
+                auto ret = ::helenos::fibril_condvar_wait_timeout(
+                    &cv.cv, &cv.inner, timeout);
+                ::helenos::fibril_mutex_unlock(&cv.inner);
+                mutex::lock(mtx);
+
+                return ret;
             }
 
             static void signal(condvar_type& cv)
             {
-                ::helenos::fibril_condvar_signal(&cv);
+                ::helenos::fibril_mutex_lock(&cv.inner);
+                ::helenos::fibril_condvar_signal(&cv.cv);
+                ::helenos::fibril_mutex_unlock(&cv.inner);
             }
 
             static void broadcast(condvar_type& cv)
             {
-                ::helenos::fibril_condvar_broadcast(&cv);
+                ::helenos::fibril_mutex_lock(&cv.inner);
+                ::helenos::fibril_condvar_broadcast(&cv.cv);
+                ::helenos::fibril_mutex_unlock(&cv.inner);
             }
         };
 
@@ -45,79 +45,90 @@ namespace std
 
 namespace std::aux
 {
+    /**
+     * Elementwise operations over the closed index range [I, N],
+     * expanded with fold expressions: one instantiation per tuple
+     * type instead of the O(N) recursive structs this used to
+     * create, which bloated binaries and compile times.
+     */
     template<size_t I, size_t N>
     struct tuple_ops
     {
         template<class T, class U>
-        static void assign_copy(T& lhs, const U& rhs)
+        static constexpr void assign_copy(T& lhs, const U& rhs)
         {
-            get<I>(lhs) = get<I>(rhs);
-
-            tuple_ops<I + 1, N>::assign_copy(lhs, rhs);
-        }
-
-        template<class T, class U>
-        static void assign_move(T& lhs, U&& rhs)
-        {
-            get<I>(lhs) = move(get<I>(rhs));
-
-            tuple_ops<I + 1, N>::assign_move(lhs, move(rhs));
-        }
-
-        template<class T, class U>
-        static void swap(T& lhs, U& rhs)
-        {
-            std::swap(get<I>(lhs), get<I>(rhs));
-
-            tuple_ops<I + 1, N>::swap(lhs, rhs);
-        }
-
-        template<class T, class U>
-        static bool eq(const T& lhs, const U& rhs)
-        {
-            return (get<I>(lhs) == get<I>(rhs)) && tuple_ops<I + 1, N>::eq(lhs, rhs);
-        }
-
-        template<class T, class U>
-        static bool lt(const T& lhs, const U& rhs)
-        {
-            return (get<I>(lhs) < get<I>(rhs)) ||
-                (!(get<I>(rhs) < get<I>(lhs)) && tuple_ops<I + 1, N>::lt(lhs, rhs));
+            assign_copy_(lhs, rhs, make_index_sequence<N - I + 1>{});
         }
-    };
 
-    template<size_t N>
-    struct tuple_ops<N, N>
-    {
         template<class T, class U>
-        static void assign_copy(T& lhs, const U& rhs)
+        static constexpr void assign_move(T& lhs, U&& rhs)
         {
-            get<N>(lhs) = get<N>(rhs);
+            assign_move_(lhs, move(rhs), make_index_sequence<N - I + 1>{});
         }
 
         template<class T, class U>
-        static void assign_move(T& lhs, U&& rhs)
+        static constexpr void swap(T& lhs, U& rhs)
         {
-            get<N>(lhs) = move(get<N>(rhs));
+            swap_(lhs, rhs, make_index_sequence<N - I + 1>{});
         }
 
         template<class T, class U>
-        static void swap(T& lhs, U& rhs)
+        static constexpr bool eq(const T& lhs, const U& rhs)
         {
-            std::swap(get<N>(lhs), get<N>(rhs));
+            return eq_(lhs, rhs, make_index_sequence<N - I + 1>{});
         }
 
         template<class T, class U>
-        static bool eq(const T& lhs, const U& rhs)
+        static constexpr bool lt(const T& lhs, const U& rhs)
         {
-            return get<N>(lhs) == get<N>(rhs);
+            return lt_(lhs, rhs, make_index_sequence<N - I + 1>{});
         }
 
-        template<class T, class U>
-        static bool lt(const T& lhs, const U& rhs)
-        {
-            return get<N>(lhs) < get<N>(rhs);
-        }
+        private:
+            template<class T, class U, size_t... Is>
+            static constexpr void assign_copy_(T& lhs, const U& rhs,
+                                               index_sequence<Is...>)
+            {
+                ((get<I + Is>(lhs) = get<I + Is>(rhs)), ...);
+            }
+
+            template<class T, class U, size_t... Is>
+            static constexpr void assign_move_(T& lhs, U&& rhs,
+                                               index_sequence<Is...>)
+            {
+                ((get<I + Is>(lhs) = move(get<I + Is>(rhs))), ...);
+            }
+
+            template<class T, class U, size_t... Is>
+            static constexpr void swap_(T& lhs, U& rhs, index_sequence<Is...>)
+            {
+                (std::swap(get<I + Is>(lhs), get<I + Is>(rhs)), ...);
+            }
+
+            template<class T, class U, size_t... Is>
+            static constexpr bool eq_(const T& lhs, const U& rhs,
+                                      index_sequence<Is...>)
+            {
+                return (... && (get<I + Is>(lhs) == get<I + Is>(rhs)));
+            }
+
+            /**
+             * Lexicographical: each term settles the result and
+             * yields true to short-circuit the fold, or yields
+             * false to fall through to the next element.
+             */
+            template<class T, class U, size_t... Is>
+            static constexpr bool lt_(const T& lhs, const U& rhs,
+                                      index_sequence<Is...>)
+            {
+                bool result{false};
+                (void)((get<I + Is>(lhs) < get<I + Is>(rhs)
+                    ? (result = true)
+                    : (get<I + Is>(rhs) < get<I + Is>(lhs)
+                        ? !(result = false) : false)) || ...);
+
+                return result;
+            }
     };
 }
 
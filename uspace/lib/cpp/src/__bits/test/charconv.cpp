@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <charconv>
+#include <cstring>
+#include <string>
+
+namespace std::test
+{
+    bool charconv_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_to_chars_int();
+        test_from_chars_int();
+        test_round_trip();
+
+        return end();
+    }
+
+    const char* charconv_test::name()
+    {
+        return "charconv";
+    }
+
+    void charconv_test::test_to_chars_int()
+    {
+        char buf[32];
+
+        auto res = std::to_chars(buf, buf + sizeof(buf), 12345);
+        test_eq("to_chars ok", (res.ec == std::errc{}), true);
+        test_eq("to_chars digits",
+                (std::string(buf, res.ptr) == "12345"), true);
+
+        res = std::to_chars(buf, buf + sizeof(buf), -987654321);
+        test_eq("to_chars negative",
+                (std::string(buf, res.ptr) == "-987654321"), true);
+
+        res = std::to_chars(buf, buf + sizeof(buf), 0);
+        test_eq("to_chars zero", (std::string(buf, res.ptr) == "0"), true);
+
+        res = std::to_chars(buf, buf + sizeof(buf), 255, 16);
+        test_eq("to_chars hex", (std::string(buf, res.ptr) == "ff"), true);
+
+        res = std::to_chars(buf, buf + 2, 12345);
+        test_eq("to_chars overflow",
+                (res.ec == std::errc::value_too_large), true);
+    }
+
+    void charconv_test::test_from_chars_int()
+    {
+        const char* digits = "1234567890123";
+        long value{};
+
+        auto res = std::from_chars(digits, digits + 13, value);
+        test_eq("from_chars ok", (res.ec == std::errc{}), true);
+        test_eq("from_chars value", value, 1234567890123L);
+        test_eq("from_chars end", (res.ptr == digits + 13), true);
+
+        const char* neg = "-42abc";
+        int ivalue{};
+        res = std::from_chars(neg, neg + 6, ivalue);
+        test_eq("from_chars negative", ivalue, -42);
+        test_eq("from_chars stops at nondigit",
+                (res.ptr == neg + 3), true);
+
+        const char* junk = "xyz";
+        res = std::from_chars(junk, junk + 3, ivalue);
+        test_eq("from_chars invalid",
+                (res.ec == std::errc::invalid_argument), true);
+
+        const char* big = "999999999999999999999999";
+        res = std::from_chars(big, big + 24, ivalue);
+        test_eq("from_chars overflow",
+                (res.ec == std::errc::result_out_of_range), true);
+
+        const char* hex = "deadBEEF";
+        unsigned uvalue{};
+        res = std::from_chars(hex, hex + 8, uvalue, 16);
+        test_eq("from_chars hex", uvalue, 0xdeadbeefU);
+    }
+
+    void charconv_test::test_round_trip()
+    {
+        /* Values exercising the eight-digit bulk parser. */
+        const long samples[] = {
+            0L, 7L, 99L, 100L, 12345678L, 123456789L,
+            1000000000L, 987654321098765L, -987654321098765L
+        };
+
+        for (auto sample : samples)
+        {
+            char buf[32];
+            auto to_res = std::to_chars(buf, buf + sizeof(buf), sample);
+            test_eq("round trip to", (to_res.ec == std::errc{}), true);
+
+            long back{};
+            auto from_res = std::from_chars(buf, to_res.ptr, back);
+            test_eq("round trip from", (from_res.ec == std::errc{}), true);
+            test_eq("round trip value", back, sample);
+        }
+
+        double dval{};
+        const char* pi = "3.5";
+        auto res = std::from_chars(pi, pi + 3, dval);
+        test_eq("double from_chars", (res.ec == std::errc{}), true);
+        test_eq("double value", (dval == 3.5), true);
+
+        char dbuf[64];
+        auto dres = std::to_chars(dbuf, dbuf + sizeof(dbuf), 2.5);
+        test_eq("double to_chars", (dres.ec == std::errc{}), true);
+
+        double dback{};
+        std::from_chars(dbuf, dres.ptr, dback);
+        test_eq("double round trip", (dback == 2.5), true);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <vector>
+
+namespace std::test
+{
+    bool execution_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_par_for_each();
+        test_par_transform();
+        test_par_reduce();
+        test_par_sort();
+
+        return end();
+    }
+
+    const char* execution_test::name()
+    {
+        return "execution";
+    }
+
+    void execution_test::test_par_for_each()
+    {
+        std::vector<int> data(5000, 1);
+
+        std::for_each(std::execution::par, data.begin(), data.end(),
+            [](int& x){ x *= 2; });
+
+        bool all_doubled{true};
+        for (const auto& x : data)
+            all_doubled = all_doubled && (x == 2);
+
+        test_eq("par for_each applies everywhere", all_doubled, true);
+    }
+
+    void execution_test::test_par_transform()
+    {
+        std::vector<int> src(5000);
+        for (size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<int>(i);
+
+        std::vector<int> dst(src.size());
+        auto res = std::transform(std::execution::par, src.begin(), src.end(),
+            dst.begin(), [](int x){ return x + 1; });
+
+        test_eq("par transform returns end", (res == dst.end()), true);
+
+        bool correct{true};
+        for (size_t i = 0; i < dst.size(); ++i)
+            correct = correct && (dst[i] == static_cast<int>(i) + 1);
+
+        test_eq("par transform values", correct, true);
+    }
+
+    void execution_test::test_par_reduce()
+    {
+        std::vector<long> data(6000, 1L);
+
+        auto seq_sum = std::reduce(data.begin(), data.end(), 0L);
+        auto par_sum = std::reduce(std::execution::par, data.begin(),
+            data.end(), 0L);
+
+        test_eq("sequential reduce", seq_sum, 6000L);
+        test_eq("parallel reduce matches", par_sum, seq_sum);
+    }
+
+    void execution_test::test_par_sort()
+    {
+        std::vector<int> data(8000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<int>((i * 2654435761U) % 100000U);
+
+        std::sort(std::execution::par, data.begin(), data.end());
+
+        bool sorted{true};
+        for (size_t i = 1; i < data.size(); ++i)
+            sorted = sorted && !(data[i] < data[i - 1]);
+
+        test_eq("par sort orders the range", sorted, true);
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <flat_unordered_map>
+#include <flat_unordered_set>
+#include <string>
+#include <utility>
+
+namespace std::test
+{
+    bool flat_unordered_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_map_insert_lookup();
+        test_map_erase_and_growth();
+        test_set_operations();
+
+        return end();
+    }
+
+    const char* flat_unordered_test::name()
+    {
+        return "flat_unordered";
+    }
+
+    void flat_unordered_test::test_map_insert_lookup()
+    {
+        std::flat_unordered_map<int, int> m{};
+
+        test_eq("fresh map empty", m.empty(), true);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto res = m.insert(std::pair<int, int>{i, i * 2});
+            test_eq("insert new succeeds", res.second, true);
+        }
+
+        test_eq("size after inserts", m.size(), 100U);
+
+        auto res = m.insert(std::pair<int, int>{50, 0});
+        test_eq("duplicate insert fails", res.second, false);
+        test_eq("duplicate insert keeps value", res.first->second, 100);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto it = m.find(i);
+            test_eq("find inserted key", (it != m.end()), true);
+            test_eq("mapped value", it->second, i * 2);
+        }
+
+        test_eq("find absent key", (m.find(1000) == m.end()), true);
+
+        m[200] = 7;
+        test_eq("operator[] inserts", m.size(), 101U);
+        test_eq("operator[] value", m[200], 7);
+
+        size_t count{};
+        for (auto& elem : m)
+        {
+            (void) elem;
+            ++count;
+        }
+        test_eq("iteration visits all", count, m.size());
+    }
+
+    void flat_unordered_test::test_map_erase_and_growth()
+    {
+        std::flat_unordered_map<int, int> m{};
+
+        /*
+         * Insert/erase cycles exercise tombstone reuse and the
+         * load-factor based rehashing.
+         */
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 500; ++i)
+                m.insert(std::pair<int, int>{i, i});
+
+            test_eq("size after round insert", m.size(), 500U);
+
+            for (int i = 0; i < 500; i += 2)
+                test_eq("erase present", m.erase(i), 1U);
+
+            test_eq("erase absent", m.erase(10000), 0U);
+            test_eq("size after erases", m.size(), 250U);
+
+            for (int i = 1; i < 500; i += 2)
+                test_eq("odd keys survive", m.contains(i), true);
+            for (int i = 0; i < 500; i += 2)
+                test_eq("even keys gone", m.contains(i), false);
+
+            m.clear();
+            test_eq("clear empties", m.empty(), true);
+        }
+    }
+
+    void flat_unordered_test::test_set_operations()
+    {
+        std::flat_unordered_set<std::string> s{};
+
+        s.insert(std::string{"alpha"});
+        s.insert(std::string{"beta"});
+        s.insert(std::string{"gamma"});
+
+        test_eq("set size", s.size(), 3U);
+        test_eq("set contains", s.contains(std::string{"beta"}), true);
+        test_eq("set lacks", s.contains(std::string{"delta"}), false);
+
+        auto res = s.insert(std::string{"beta"});
+        test_eq("set duplicate insert", res.second, false);
+
+        test_eq("set erase", s.erase(std::string{"beta"}), 1U);
+        test_eq("set erased", s.contains(std::string{"beta"}), false);
+        test_eq("set size after erase", s.size(), 2U);
+
+        std::flat_unordered_set<int> s2{1, 2, 3, 4, 5};
+        auto moved{std::move(s2)};
+        test_eq("moved set size", moved.size(), 5U);
+        test_eq("moved set lookup", moved.contains(3), true);
+    }
+}
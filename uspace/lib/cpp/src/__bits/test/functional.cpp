@@ -121,6 +121,29 @@ namespace std::test
         test("function operator bool", (bool)f2);
         f2 = nullptr;
         test("function nullptr assignment", !f2);
+
+        /* Small target (in-object buffer) and a large one (heap). */
+        int small{10};
+        std::function<int(int)> f3{[small](auto i){ return small + i; }};
+
+        int big[32];
+        for (int i = 0; i < 32; ++i)
+            big[i] = i;
+        std::function<int(int)> f4{[big](auto i){ return big[i]; }};
+
+        auto f5 = f3;
+        test_eq("function small target copy", f5(5), 15);
+
+        auto f6 = std::move(f3);
+        test_eq("function small target move", f6(1), 11);
+        test("function moved-from is empty", !f3);
+
+        f5.swap(f4);
+        test_eq("function swap pt1", f5(20), 20);
+        test_eq("function swap pt2", f4(2), 12);
+
+        f4 = f5;
+        test_eq("function copy assignment", f4(31), 31);
     }
 
     void functional_test::test_bind()
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace std::test
+{
+    bool memory_resource_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_monotonic();
+        test_pool();
+        test_pmr_containers();
+
+        return end();
+    }
+
+    const char* memory_resource_test::name()
+    {
+        return "memory_resource";
+    }
+
+    void memory_resource_test::test_monotonic()
+    {
+        std::pmr::monotonic_buffer_resource arena{};
+
+        auto p1 = arena.allocate(16);
+        auto p2 = arena.allocate(16);
+
+        test_eq("monotonic returns memory", (p1 != nullptr), true);
+        test_eq("monotonic advances", (p1 != p2), true);
+
+        auto p3 = arena.allocate(8, 64);
+        test_eq("monotonic alignment",
+                (reinterpret_cast<uintptr_t>(p3) % 64), uintptr_t{0});
+
+        /* Deallocation is a no-op and must not crash. */
+        arena.deallocate(p1, 16);
+
+        char buf[256];
+        std::pmr::monotonic_buffer_resource small{buf, sizeof(buf)};
+        auto q = small.allocate(32);
+        test_eq("initial buffer used",
+                (q >= buf && q < buf + sizeof(buf)), true);
+
+        /* Exhaust the initial buffer, forcing upstream growth. */
+        auto big = small.allocate(1024);
+        test_eq("upstream growth works", (big != nullptr), true);
+    }
+
+    void memory_resource_test::test_pool()
+    {
+        std::pmr::unsynchronized_pool_resource pool{};
+
+        auto a = pool.allocate(24);
+        auto b = pool.allocate(24);
+        test_eq("pool returns distinct blocks", (a != b), true);
+
+        pool.deallocate(a, 24);
+        auto c = pool.allocate(24);
+        test_eq("pool reuses freed block", (a == c), true);
+
+        auto huge = pool.allocate(100000);
+        test_eq("oversized allocation works", (huge != nullptr), true);
+        pool.deallocate(huge, 100000);
+    }
+
+    void memory_resource_test::test_pmr_containers()
+    {
+        std::pmr::monotonic_buffer_resource arena{};
+        std::pmr::vector<int> v{std::pmr::polymorphic_allocator<int>{&arena}};
+
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+
+        test_eq("pmr vector size", v.size(), 100U);
+
+        bool correct{true};
+        for (int i = 0; i < 100; ++i)
+            correct = correct && (v[static_cast<size_t>(i)] == i);
+
+        test_eq("pmr vector contents", correct, true);
+
+        std::pmr::string str{"a somewhat long string to defeat sso",
+            std::pmr::polymorphic_allocator<char>{&arena}};
+        test_eq("pmr string contents",
+                (str == "a somewhat long string to defeat sso"), true);
+    }
+}
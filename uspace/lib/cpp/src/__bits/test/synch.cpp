@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <fibril_synch.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    template<class F>
+    uint64_t time_ns(F f, unsigned iters)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iters; ++i)
+            f();
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end - begin).count();
+    }
+}
+
+namespace std::test
+{
+    bool synch_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_mutex();
+        bench_condvar();
+        bench_promise_future();
+        test_contended_lock();
+
+        return end();
+    }
+
+    const char* synch_test::name()
+    {
+        return "synch";
+    }
+
+    /**
+     * The microbenchmarks below gate latency regressions in the
+     * C++ synchronization primitives. They compare against the raw
+     * fibril_synch primitives measured in the same run, so the
+     * bounds are self-calibrating rather than wall-clock dependent.
+     */
+
+    void synch_test::bench_mutex()
+    {
+        constexpr unsigned iters{100'000};
+
+        std::mutex mtx;
+        auto cpp = time_ns([&](){ mtx.lock(); mtx.unlock(); }, iters);
+
+        ::helenos::fibril_mutex_t fm;
+        ::helenos::fibril_mutex_initialize(&fm);
+        auto raw = time_ns([&](){
+            ::helenos::fibril_mutex_lock(&fm);
+            ::helenos::fibril_mutex_unlock(&fm);
+        }, iters);
+
+        /* The inlined fast path must not lose to fibril_synch. */
+        test("uncontended mutex at least as fast as fibril_mutex",
+             cpp <= raw);
+    }
+
+    void synch_test::bench_condvar()
+    {
+        constexpr unsigned iters{50'000};
+
+        std::condition_variable cv;
+        auto cpp = time_ns([&](){ cv.notify_one(); }, iters);
+
+        ::helenos::fibril_condvar_t fcv;
+        ::helenos::fibril_condvar_initialize(&fcv);
+        auto raw = time_ns([&](){
+            ::helenos::fibril_condvar_signal(&fcv);
+        }, iters);
+
+        /*
+         * An empty notify takes the condvar's internal mutex, so
+         * it legitimately costs a few times the raw signal; the
+         * generous factor only catches gross regressions (e.g. a
+         * syscall sneaking into the path).
+         */
+        test("empty notify within 10x of fibril_condvar_signal",
+             cpp <= 10 * raw);
+    }
+
+    void synch_test::bench_promise_future()
+    {
+        constexpr unsigned iters{10'000};
+
+        auto total = time_ns([](){
+            std::promise<int> p;
+            auto f = p.get_future();
+            p.set_value(42);
+            f.get();
+        }, iters);
+
+        /*
+         * A ready-value roundtrip never blocks; anything near
+         * 100us apiece means a primitive started entering the
+         * kernel on the uncontended path.
+         */
+        test("promise/future roundtrip under 100us",
+             total / iters < 100'000);
+    }
+
+    void synch_test::test_contended_lock()
+    {
+        std::mutex mtx;
+        int value{};
+
+        mtx.lock();
+
+        std::thread t{[&](){
+            /* Blocks until the main fibril unlocks. */
+            mtx.lock();
+            value = 42;
+            mtx.unlock();
+        }};
+
+        /* Let the thread park on the contended mutex. */
+        std::this_thread::sleep_for(10ms);
+
+        test_eq("contended fibril still parked", value, 0);
+
+        mtx.unlock();
+        t.join();
+
+        test_eq("contended fibril woken and done", value, 42);
+
+        test("try_lock on free mutex", mtx.try_lock());
+        test("try_lock on held mutex fails", !mtx.try_lock());
+        mtx.unlock();
+    }
+}
@@ -38,6 +38,9 @@ namespace std
 
     namespace aux
     {
+        static stdin_streambuf<char>* cin_buf{};
+        static stdout_streambuf<char>* cout_buf{};
+
         ios_base::Init init{};
     }
 
@@ -49,8 +52,11 @@ namespace std
         {
             // TODO: These buffers should be static too
             //       in case somebody reassigns to cout/cin.
-            ::new(&cin) istream{::new aux::stdin_streambuf<char>{}};
-            ::new(&cout) ostream{::new aux::stdout_streambuf<char>{}};
+            aux::cin_buf = ::new aux::stdin_streambuf<char>{};
+            aux::cout_buf = ::new aux::stdout_streambuf<char>{};
+
+            ::new(&cin) istream{aux::cin_buf};
+            ::new(&cout) ostream{aux::cout_buf};
 
             cin.tie(&cout);
         }
@@ -61,4 +67,15 @@ namespace std
         if (--init_cnt_ == 0)
             cout.flush();
     }
+
+    bool ios_base::sync_with_stdio(bool sync)
+    {
+        auto old = sync_;
+        sync_ = sync;
+
+        if (old != sync && aux::cout_buf)
+            aux::cout_buf->stdio_sync(sync);
+
+        return old;
+    }
 }
@@ -39,28 +39,11 @@
 #include <limits.h>
 #include "crypto.h"
 
-/** Hash function procedure definition. */
-typedef void (*hash_fnc_t)(uint32_t *, uint32_t *);
-
 /** Length of HMAC block. */
 #define HMAC_BLOCK_LENGTH  64
 
-/** Ceiling for uint32_t. */
-#define ceil_uint32(val) \
-	(((val) - (uint32_t) (val)) > 0 ? \
-	(uint32_t) ((val) + 1) : (uint32_t) (val))
-
-/** Floor for uint32_t. */
-#define floor_uint32(val) \
-	(((val) - (uint32_t) (val)) < 0 ? \
-	(uint32_t) ((val) - 1) : (uint32_t) (val))
-
-/** Pick value at specified index from array or zero if out of bounds. */
-#define get_at(input, size, i) \
-	((i) < (size) ? (input[i]) : 0)
-
 /** Init values used in SHA1 and MD5 functions. */
-static const uint32_t hash_init[] = {
+static const uint32_t hash_init_values[] = {
 	0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
 };
 
@@ -155,32 +138,181 @@ static void sha1_proc(uint32_t *h, uint32_t *sched_arr)
 
 	memcpy(w, h, (HASH_SHA1 / 4) * sizeof(uint32_t));
 
-	for (size_t k = 0; k < 80; k++) {
-		if (k < 20) {
-			f = (w[1] & w[2]) | (~w[1] & w[3]);
-			cf = 0x5A827999;
-		} else if ((k >= 20) && (k < 40)) {
-			f = w[1] ^ w[2] ^ w[3];
-			cf = 0x6ed9eba1;
-		} else if ((k >= 40) && (k < 60)) {
-			f = (w[1] & w[2]) | (w[1] & w[3]) | (w[2] & w[3]);
-			cf = 0x8f1bbcdc;
-		} else {
-			f = w[1] ^ w[2] ^ w[3];
-			cf = 0xca62c1d6;
-		}
+	/*
+	 * The four twenty-round groups are unrolled so that the
+	 * round function and constant are fixed within each loop
+	 * instead of being re-selected every round.
+	 */
+#define SHA1_ROUND(f_expr, cf_val, k) \
+	do { \
+		f = (f_expr); \
+		cf = (cf_val); \
+		temp = rotl_uint32(w[0], 5) + f + w[4] + cf + sched_arr[k]; \
+		w[4] = w[3]; \
+		w[3] = w[2]; \
+		w[2] = rotl_uint32(w[1], 30); \
+		w[1] = w[0]; \
+		w[0] = temp; \
+	} while (0)
+
+	for (size_t k = 0; k < 20; k++)
+		SHA1_ROUND((w[1] & w[2]) | (~w[1] & w[3]), 0x5A827999, k);
+
+	for (size_t k = 20; k < 40; k++)
+		SHA1_ROUND(w[1] ^ w[2] ^ w[3], 0x6ed9eba1, k);
+
+	for (size_t k = 40; k < 60; k++)
+		SHA1_ROUND((w[1] & w[2]) | (w[1] & w[3]) | (w[2] & w[3]),
+		    0x8f1bbcdc, k);
+
+	for (size_t k = 60; k < 80; k++)
+		SHA1_ROUND(w[1] ^ w[2] ^ w[3], 0xca62c1d6, k);
+
+#undef SHA1_ROUND
 
-		temp = rotl_uint32(w[0], 5) + f + w[4] + cf + sched_arr[k];
+	for (uint8_t k = 0; k < HASH_SHA1 / 4; k++)
+		h[k] += w[k];
+}
 
-		w[4] = w[3];
-		w[3] = w[2];
-		w[2] = rotl_uint32(w[1], 30);
-		w[1] = w[0];
-		w[0] = temp;
+/** Process one 64-byte block through the selected hash function */
+static void hash_block(hash_context_t *ctx, const uint8_t *block)
+{
+	uint32_t sched_arr[80];
+
+	for (size_t k = 0; k < 16; k++) {
+		sched_arr[k] =
+		    (block[k * 4] << 24) |
+		    (block[k * 4 + 1] << 16) |
+		    (block[k * 4 + 2] << 8) |
+		    block[k * 4 + 3];
 	}
 
-	for (uint8_t k = 0; k < HASH_SHA1 / 4; k++)
-		h[k] += w[k];
+	if (ctx->hash_sel == HASH_MD5)
+		md5_proc(ctx->h, sched_arr);
+	else
+		sha1_proc(ctx->h, sched_arr);
+}
+
+/** Start an incremental hash computation.
+ *
+ * @param ctx      Hash context to initialize.
+ * @param hash_sel Hash function selector.
+ *
+ * @return EINVAL when no context is given, otherwise EOK.
+ *
+ */
+errno_t hash_init(hash_context_t *ctx, hash_func_t hash_sel)
+{
+	if (!ctx)
+		return EINVAL;
+
+	ctx->hash_sel = hash_sel;
+	memcpy(ctx->h, hash_init_values, (hash_sel / 4) * sizeof(uint32_t));
+	ctx->block_used = 0;
+	ctx->total_size = 0;
+
+	return EOK;
+}
+
+/** Feed another piece of the message into a hash computation.
+ *
+ * Whole blocks are consumed straight from the caller's buffer;
+ * only a trailing partial block is retained in the context, so
+ * arbitrarily large messages hash in constant memory.
+ *
+ * @param ctx   Hash context.
+ * @param input Input bytes.
+ * @param size  Number of input bytes.
+ *
+ * @return EINVAL when context or input not specified, otherwise EOK.
+ *
+ */
+errno_t hash_update(hash_context_t *ctx, const uint8_t *input, size_t size)
+{
+	if (!ctx || (!input && size > 0))
+		return EINVAL;
+
+	ctx->total_size += size;
+
+	/* Top up a previously buffered partial block. */
+	if (ctx->block_used > 0) {
+		size_t take = min(sizeof(ctx->block) - ctx->block_used, size);
+		memcpy(ctx->block + ctx->block_used, input, take);
+		ctx->block_used += take;
+		input += take;
+		size -= take;
+
+		if (ctx->block_used < sizeof(ctx->block))
+			return EOK;
+
+		hash_block(ctx, ctx->block);
+		ctx->block_used = 0;
+	}
+
+	while (size >= sizeof(ctx->block)) {
+		hash_block(ctx, input);
+		input += sizeof(ctx->block);
+		size -= sizeof(ctx->block);
+	}
+
+	memcpy(ctx->block, input, size);
+	ctx->block_used = size;
+
+	return EOK;
+}
+
+/** Finish an incremental hash computation.
+ *
+ * @param ctx    Hash context.
+ * @param output Result hash byte sequence.
+ *
+ * @return EINVAL when no context is given,
+ *         ENOMEM when pointer for output hash result
+ *         is not allocated, otherwise EOK.
+ *
+ */
+errno_t hash_finalize(hash_context_t *ctx, uint8_t *output)
+{
+	if (!ctx)
+		return EINVAL;
+
+	if (!output)
+		return ENOMEM;
+
+	uint64_t bits_size = ctx->total_size * 8;
+	if (ctx->hash_sel == HASH_MD5)
+		bits_size = uint64_t_byteorder_swap(bits_size);
+
+	/* Terminator bit, then zero padding up to the length field. */
+	uint8_t pad = 0x80;
+	hash_update(ctx, &pad, 1);
+
+	uint8_t zero = 0;
+	while (ctx->block_used != sizeof(ctx->block) - 8)
+		hash_update(ctx, &zero, 1);
+
+	uint8_t length[8];
+	for (size_t i = 0; i < 4; i++) {
+		length[i] = (bits_size >> 32) >> ((3 - i) * 8);
+		length[4 + i] = (bits_size & 0xffffffff) >> ((3 - i) * 8);
+	}
+
+	/* The length bytes complete the final block exactly. */
+	memcpy(ctx->block + ctx->block_used, length, 8);
+	hash_block(ctx, ctx->block);
+	ctx->block_used = 0;
+
+	/* Copy hash parts into final result. */
+	for (size_t i = 0; i < ctx->hash_sel / 4; i++) {
+		uint32_t part = ctx->h[i];
+		if (ctx->hash_sel == HASH_SHA1)
+			part = uint32_t_byteorder_swap(part);
+
+		memcpy(output + i * sizeof(uint32_t), &part,
+		    sizeof(uint32_t));
+	}
+
+	return EOK;
 }
 
 /** Create hash based on selected algorithm.
@@ -206,53 +338,11 @@ errno_t create_hash(uint8_t *input, size_t input_size, uint8_t *output,
 	if (!output)
 		return ENOMEM;
 
-	hash_fnc_t hash_func = (hash_sel == HASH_MD5) ? md5_proc : sha1_proc;
-
-	/* Prepare scheduled input. */
-	uint8_t work_input[input_size + 1];
-	memcpy(work_input, input, input_size);
-	work_input[input_size] = 0x80;
-
-	// FIXME: double?
-	size_t blocks = ceil_uint32((((double) input_size + 1) / 4 + 2) / 16);
-	uint32_t work_arr[blocks * 16];
-	for (size_t i = 0; i < blocks; i++) {
-		for (size_t j = 0; j < 16; j++) {
-			work_arr[i * 16 + j] =
-			    (get_at(work_input, input_size + 1, i * 64 + j * 4) << 24) |
-			    (get_at(work_input, input_size + 1, i * 64 + j * 4 + 1) << 16) |
-			    (get_at(work_input, input_size + 1, i * 64 + j * 4 + 2) << 8) |
-			    get_at(work_input, input_size + 1, i * 64 + j * 4 + 3);
-		}
-	}
-
-	uint64_t bits_size = (uint64_t) (input_size * 8);
-	if (hash_sel == HASH_MD5)
-		bits_size = uint64_t_byteorder_swap(bits_size);
+	hash_context_t ctx;
 
-	work_arr[(blocks - 1) * 16 + 14] = bits_size >> 32;
-	work_arr[(blocks - 1) * 16 + 15] = bits_size & 0xffffffff;
-
-	/* Hash computation. */
-	uint32_t h[hash_sel / 4];
-	memcpy(h, hash_init, (hash_sel / 4) * sizeof(uint32_t));
-	uint32_t sched_arr[80];
-	for (size_t i = 0; i < blocks; i++) {
-		for (size_t k = 0; k < 16; k++)
-			sched_arr[k] = work_arr[i * 16 + k];
-
-		hash_func(h, sched_arr);
-	}
-
-	/* Copy hash parts into final result. */
-	for (size_t i = 0; i < hash_sel / 4; i++) {
-		if (hash_sel == HASH_SHA1)
-			h[i] = uint32_t_byteorder_swap(h[i]);
-
-		memcpy(output + i * sizeof(uint32_t), &h[i], sizeof(uint32_t));
-	}
-
-	return EOK;
+	hash_init(&ctx, hash_sel);
+	hash_update(&ctx, input, input_size);
+	return hash_finalize(&ctx, output);
 }
 
 /** Hash-based message authentication code.
@@ -294,17 +384,19 @@ errno_t hmac(uint8_t *key, size_t key_size, uint8_t *msg, size_t msg_size,
 		i_key_pad[i] = work_key[i] ^ 0x36;
 	}
 
-	uint8_t temp_work[HMAC_BLOCK_LENGTH + max(msg_size, hash_sel)];
-	memcpy(temp_work, i_key_pad, HMAC_BLOCK_LENGTH);
-	memcpy(temp_work + HMAC_BLOCK_LENGTH, msg, msg_size);
-
-	create_hash(temp_work, HMAC_BLOCK_LENGTH + msg_size, temp_hash,
-	    hash_sel);
+	/* Inner and outer passes run incrementally; the message is
+	 * never copied into a concatenation buffer. */
+	hash_context_t ctx;
 
-	memcpy(temp_work, o_key_pad, HMAC_BLOCK_LENGTH);
-	memcpy(temp_work + HMAC_BLOCK_LENGTH, temp_hash, hash_sel);
+	hash_init(&ctx, hash_sel);
+	hash_update(&ctx, i_key_pad, HMAC_BLOCK_LENGTH);
+	hash_update(&ctx, msg, msg_size);
+	hash_finalize(&ctx, temp_hash);
 
-	create_hash(temp_work, HMAC_BLOCK_LENGTH + hash_sel, hash, hash_sel);
+	hash_init(&ctx, hash_sel);
+	hash_update(&ctx, o_key_pad, HMAC_BLOCK_LENGTH);
+	hash_update(&ctx, temp_hash, hash_sel);
+	hash_finalize(&ctx, hash);
 
 	return EOK;
 }
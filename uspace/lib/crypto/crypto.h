@@ -50,6 +50,22 @@ typedef enum {
 	HASH_SHA1 = 20
 } hash_func_t;
 
+/** Incremental hash computation context. */
+typedef struct {
+	hash_func_t hash_sel;
+	/** Interim hash state */
+	uint32_t h[5];
+	/** Buffered partial input block */
+	uint8_t block[64];
+	size_t block_used;
+	/** Total bytes hashed */
+	uint64_t total_size;
+} hash_context_t;
+
+extern errno_t hash_init(hash_context_t *, hash_func_t);
+extern errno_t hash_update(hash_context_t *, const uint8_t *, size_t);
+extern errno_t hash_finalize(hash_context_t *, uint8_t *);
+
 extern errno_t rc4(uint8_t *, size_t, uint8_t *, size_t, size_t, uint8_t *);
 extern errno_t aes_encrypt(uint8_t *, uint8_t *, uint8_t *);
 extern errno_t aes_decrypt(uint8_t *, uint8_t *, uint8_t *);
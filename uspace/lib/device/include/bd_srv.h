@@ -47,6 +47,13 @@ typedef struct bd_ops bd_ops_t;
 typedef struct {
 	bd_ops_t *ops;
 	void *sarg;
+
+	/** I/O scheduler queue (bd_sched_req_t), see bd_srv.c. */
+	fibril_mutex_t sched_lock;
+	fibril_condvar_t sched_cv;
+	list_t sched_queue;
+	/** True while the scheduler fibril is running. */
+	bool sched_active;
 } bd_srvs_t;
 
 /** Server structure (per client session) */
@@ -65,6 +72,8 @@ struct bd_ops {
 	errno_t (*write_blocks)(bd_srv_t *, aoff64_t, size_t, const void *, size_t);
 	errno_t (*get_block_size)(bd_srv_t *, size_t *);
 	errno_t (*get_num_blocks)(bd_srv_t *, aoff64_t *);
+	/** Discard (TRIM) blocks; optional (may be NULL) */
+	errno_t (*discard)(bd_srv_t *, aoff64_t, size_t);
 };
 
 extern void bd_srvs_init(bd_srvs_t *);
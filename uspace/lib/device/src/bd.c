@@ -164,6 +164,29 @@ errno_t bd_sync_cache(bd_t *bd, aoff64_t ba, size_t cnt)
 	return rc;
 }
 
+/** Discard (TRIM) a range of blocks.
+ *
+ * Tell the device the blocks' contents are no longer needed; the
+ * device may release the backing storage. ENOTSUP from devices
+ * without discard support is harmless to ignore.
+ *
+ * @param bd Block device
+ * @param ba Address of first block
+ * @param cnt Number of blocks
+ *
+ * @return EOK on success or an error code
+ */
+errno_t bd_discard(bd_t *bd, aoff64_t ba, size_t cnt)
+{
+	async_exch_t *exch = async_exchange_begin(bd->sess);
+
+	errno_t rc = async_req_3_0(exch, BD_DISCARD, LOWER32(ba),
+	    UPPER32(ba), cnt);
+	async_exchange_end(exch);
+
+	return rc;
+}
+
 errno_t bd_get_block_size(bd_t *bd, size_t *rbsize)
 {
 	sysarg_t bsize;
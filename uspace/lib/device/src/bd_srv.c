@@ -34,14 +34,220 @@
  * @brief Block device server stub
  */
 #include <errno.h>
+#include <fibril.h>
 #include <ipc/bd.h>
 #include <macros.h>
+#include <mem.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include <bd_srv.h>
 
+/*
+ * I/O scheduler with request merging.
+ *
+ * Read and write requests of all clients of a device are funneled
+ * through a per-device queue. A scheduler fibril drains the queue in
+ * batches, sorts each batch by block address (elevator order) and
+ * merges runs of adjacent same-type requests into one driver call
+ * through a combined buffer, so the underlying device sees few large
+ * sequential commands instead of many small interleaved ones.
+ * Completion is signalled back to the waiting connection fibrils.
+ */
+
+#define BD_SCHED_BATCH  16
+
+typedef struct {
+	link_t link;
+	bd_srv_t *srv;
+	bool write;
+	aoff64_t ba;
+	size_t cnt;
+	void *buf;
+	size_t size;
+
+	bool done;
+	errno_t rc;
+	fibril_condvar_t done_cv;
+} bd_sched_req_t;
+
+/** Execute a run of merged, address-adjacent requests. */
+static void bd_sched_run(bd_srvs_t *srvs, bd_sched_req_t **reqs, size_t n)
+{
+	size_t total_size = 0;
+	size_t total_cnt = 0;
+	errno_t rc;
+
+	for (size_t i = 0; i < n; i++) {
+		total_size += reqs[i]->size;
+		total_cnt += reqs[i]->cnt;
+	}
+
+	void *combined = NULL;
+	if (n > 1)
+		combined = malloc(total_size);
+
+	if (combined == NULL) {
+		/* Single request or no memory: issue one by one. */
+		for (size_t i = 0; i < n; i++) {
+			bd_sched_req_t *req = reqs[i];
+
+			if (req->write) {
+				req->rc = srvs->ops->write_blocks(req->srv,
+				    req->ba, req->cnt, req->buf, req->size);
+			} else {
+				req->rc = srvs->ops->read_blocks(req->srv,
+				    req->ba, req->cnt, req->buf, req->size);
+			}
+		}
+		return;
+	}
+
+	if (reqs[0]->write) {
+		/* Gather the buffers and write once. */
+		size_t offs = 0;
+		for (size_t i = 0; i < n; i++) {
+			memcpy((uint8_t *) combined + offs, reqs[i]->buf,
+			    reqs[i]->size);
+			offs += reqs[i]->size;
+		}
+
+		rc = srvs->ops->write_blocks(reqs[0]->srv, reqs[0]->ba,
+		    total_cnt, combined, total_size);
+	} else {
+		/* Read once and scatter to the buffers. */
+		rc = srvs->ops->read_blocks(reqs[0]->srv, reqs[0]->ba,
+		    total_cnt, combined, total_size);
+
+		if (rc == EOK) {
+			size_t offs = 0;
+			for (size_t i = 0; i < n; i++) {
+				memcpy(reqs[i]->buf,
+				    (uint8_t *) combined + offs,
+				    reqs[i]->size);
+				offs += reqs[i]->size;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < n; i++)
+		reqs[i]->rc = rc;
+
+	free(combined);
+}
+
+/** I/O scheduler fibril. */
+static errno_t bd_sched_fibril(void *arg)
+{
+	bd_srvs_t *srvs = (bd_srvs_t *) arg;
+	bd_sched_req_t *batch[BD_SCHED_BATCH];
+
+	while (true) {
+		size_t n = 0;
+
+		fibril_mutex_lock(&srvs->sched_lock);
+		while (list_empty(&srvs->sched_queue))
+			fibril_condvar_wait(&srvs->sched_cv,
+			    &srvs->sched_lock);
+
+		link_t *link;
+		while ((n < BD_SCHED_BATCH) &&
+		    ((link = list_first(&srvs->sched_queue)) != NULL)) {
+			list_remove(link);
+			batch[n++] = list_get_instance(link, bd_sched_req_t,
+			    link);
+		}
+		fibril_mutex_unlock(&srvs->sched_lock);
+
+		/* Elevator: sort the batch by block address. */
+		for (size_t i = 1; i < n; i++) {
+			bd_sched_req_t *key = batch[i];
+			size_t j = i;
+			while ((j > 0) && (batch[j - 1]->ba > key->ba)) {
+				batch[j] = batch[j - 1];
+				j--;
+			}
+			batch[j] = key;
+		}
+
+		/* Execute runs of adjacent same-type requests. */
+		size_t i = 0;
+		while (i < n) {
+			size_t run = 1;
+			while ((i + run < n) &&
+			    (batch[i + run]->write == batch[i]->write) &&
+			    (batch[i + run]->srv == batch[i]->srv) &&
+			    (batch[i + run]->ba ==
+			    batch[i + run - 1]->ba + batch[i + run - 1]->cnt))
+				run++;
+
+			bd_sched_run(srvs, &batch[i], run);
+
+			for (size_t k = 0; k < run; k++) {
+				fibril_mutex_lock(&srvs->sched_lock);
+				batch[i + k]->done = true;
+				fibril_mutex_unlock(&srvs->sched_lock);
+				fibril_condvar_broadcast(
+				    &batch[i + k]->done_cv);
+			}
+
+			i += run;
+		}
+	}
+
+	return EOK;
+}
+
+/** Submit a request to the scheduler and wait for its completion. */
+static errno_t bd_sched_submit(bd_srv_t *srv, bool write, aoff64_t ba,
+    size_t cnt, void *buf, size_t size)
+{
+	bd_srvs_t *srvs = srv->srvs;
+	bd_sched_req_t req = {
+		.srv = srv,
+		.write = write,
+		.ba = ba,
+		.cnt = cnt,
+		.buf = buf,
+		.size = size,
+		.done = false,
+		.rc = EOK
+	};
+
+	link_initialize(&req.link);
+	fibril_condvar_initialize(&req.done_cv);
+
+	fibril_mutex_lock(&srvs->sched_lock);
+
+	if (!srvs->sched_active) {
+		fid_t fid = fibril_create(bd_sched_fibril, srvs);
+		if (fid == 0) {
+			/* No scheduler; execute directly. */
+			fibril_mutex_unlock(&srvs->sched_lock);
+			if (write) {
+				return srvs->ops->write_blocks(srv, ba, cnt,
+				    buf, size);
+			}
+			return srvs->ops->read_blocks(srv, ba, cnt, buf,
+			    size);
+		}
+
+		srvs->sched_active = true;
+		fibril_add_ready(fid);
+	}
+
+	list_append(&req.link, &srvs->sched_queue);
+	fibril_condvar_signal(&srvs->sched_cv);
+
+	while (!req.done)
+		fibril_condvar_wait(&req.done_cv, &srvs->sched_lock);
+
+	fibril_mutex_unlock(&srvs->sched_lock);
+
+	return req.rc;
+}
+
 static void bd_read_blocks_srv(bd_srv_t *srv, ipc_call_t *call)
 {
 	aoff64_t ba;
@@ -73,7 +279,7 @@ static void bd_read_blocks_srv(bd_srv_t *srv, ipc_call_t *call)
 		return;
 	}
 
-	rc = srv->srvs->ops->read_blocks(srv, ba, cnt, buf, size);
+	rc = bd_sched_submit(srv, false, ba, cnt, buf, size);
 	if (rc != EOK) {
 		async_answer_0(&rcall, ENOMEM);
 		async_answer_0(call, ENOMEM);
@@ -130,6 +336,24 @@ static void bd_read_toc_srv(bd_srv_t *srv, ipc_call_t *call)
 	async_answer_0(call, EOK);
 }
 
+static void bd_discard_srv(bd_srv_t *srv, ipc_call_t *call)
+{
+	aoff64_t ba;
+	size_t cnt;
+	errno_t rc;
+
+	ba = MERGE_LOUP32(ipc_get_arg1(call), ipc_get_arg2(call));
+	cnt = ipc_get_arg3(call);
+
+	if (srv->srvs->ops->discard == NULL) {
+		async_answer_0(call, ENOTSUP);
+		return;
+	}
+
+	rc = srv->srvs->ops->discard(srv, ba, cnt);
+	async_answer_0(call, rc);
+}
+
 static void bd_sync_cache_srv(bd_srv_t *srv, ipc_call_t *call)
 {
 	aoff64_t ba;
@@ -170,7 +394,7 @@ static void bd_write_blocks_srv(bd_srv_t *srv, ipc_call_t *call)
 		return;
 	}
 
-	rc = srv->srvs->ops->write_blocks(srv, ba, cnt, data, size);
+	rc = bd_sched_submit(srv, true, ba, cnt, data, size);
 	free(data);
 	async_answer_0(call, rc);
 }
@@ -219,6 +443,11 @@ void bd_srvs_init(bd_srvs_t *srvs)
 {
 	srvs->ops = NULL;
 	srvs->sarg = NULL;
+
+	fibril_mutex_initialize(&srvs->sched_lock);
+	fibril_condvar_initialize(&srvs->sched_cv);
+	list_initialize(&srvs->sched_queue);
+	srvs->sched_active = false;
 }
 
 errno_t bd_conn(ipc_call_t *icall, bd_srvs_t *srvs)
@@ -264,6 +493,9 @@ errno_t bd_conn(ipc_call_t *icall, bd_srvs_t *srvs)
 		case BD_SYNC_CACHE:
 			bd_sync_cache_srv(srv, &call);
 			break;
+		case BD_DISCARD:
+			bd_discard_srv(srv, &call);
+			break;
 		case BD_WRITE_BLOCKS:
 			bd_write_blocks_srv(srv, &call);
 			break;
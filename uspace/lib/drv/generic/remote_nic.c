@@ -35,7 +35,9 @@
  */
 
 #include <assert.h>
+#include <as.h>
 #include <async.h>
+#include <libarch/config.h>
 #include <errno.h>
 #include <ipc/services.h>
 #include <time.h>
@@ -85,7 +87,8 @@ typedef enum {
 	NIC_OFFLOAD_SET,
 	NIC_POLL_GET_MODE,
 	NIC_POLL_SET_MODE,
-	NIC_POLL_NOW
+	NIC_POLL_NOW,
+	NIC_STATS_SHARE
 } nic_funcs_t;
 
 /** Send frame from NIC
@@ -273,6 +276,39 @@ errno_t nic_get_stats(async_sess_t *dev_sess, nic_device_stats_t *stats)
 	return rc;
 }
 
+/** Map the device's statistics into the caller's address space.
+ *
+ * The returned area is read-only and live: the driver updates it in
+ * place, so rates can be sampled at will without IPC round trips.
+ *
+ * @param dev_sess Device session.
+ * @param stats    Place to store the mapped statistics area.
+ *
+ * @return EOK on success or an error code.
+ */
+errno_t nic_stats_share(async_sess_t *dev_sess, nic_device_stats_t **stats)
+{
+	assert(stats);
+
+	async_exch_t *exch = async_exchange_begin(dev_sess);
+
+	errno_t rc = async_req_1_0(exch, DEV_IFACE_ID(NIC_DEV_IFACE),
+	    NIC_STATS_SHARE);
+	if (rc != EOK) {
+		async_exchange_end(exch);
+		return rc;
+	}
+
+	void *dst = NULL;
+	rc = async_share_in_start_0_0(exch, PAGE_SIZE, &dst);
+	async_exchange_end(exch);
+
+	if (rc == EOK)
+		*stats = (nic_device_stats_t *) dst;
+
+	return rc;
+}
+
 /** Request information about the device.
  *
  * @see nic_device_info_t
@@ -1491,6 +1527,39 @@ static void remote_nic_get_stats(ddf_fun_t *dev, void *iface,
 	async_answer_0(call, rc);
 }
 
+static void remote_nic_stats_share(ddf_fun_t *dev, void *iface,
+    ipc_call_t *call)
+{
+	nic_iface_t *nic_iface = (nic_iface_t *) iface;
+
+	if (nic_iface->stats_share == NULL) {
+		async_answer_0(call, ENOTSUP);
+		return;
+	}
+
+	void *area;
+	size_t size;
+	errno_t rc = nic_iface->stats_share(dev, &area, &size);
+	async_answer_0(call, rc);
+	if (rc != EOK)
+		return;
+
+	/* The client follows up with the share request. */
+	ipc_call_t share;
+	size_t share_size = 0;
+	if (!async_share_in_receive(&share, &share_size)) {
+		async_answer_0(&share, EPARTY);
+		return;
+	}
+
+	if (share_size != size) {
+		async_answer_0(&share, ELIMIT);
+		return;
+	}
+
+	(void) async_share_in_finalize(&share, area, AS_AREA_READ);
+}
+
 static void remote_nic_get_device_info(ddf_fun_t *dev, void *iface,
     ipc_call_t *call)
 {
@@ -2496,6 +2565,7 @@ static const remote_iface_func_ptr_t remote_nic_iface_ops[] = {
 	[NIC_GET_ADDRESS] = remote_nic_get_address,
 	[NIC_SET_ADDRESS] = remote_nic_set_address,
 	[NIC_GET_STATS] = remote_nic_get_stats,
+	[NIC_STATS_SHARE] = remote_nic_stats_share,
 	[NIC_GET_DEVICE_INFO] = remote_nic_get_device_info,
 	[NIC_GET_CABLE_STATE] = remote_nic_get_cable_state,
 	[NIC_GET_OPERATION_MODE] = remote_nic_get_operation_mode,
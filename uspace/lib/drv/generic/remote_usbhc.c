@@ -180,26 +180,35 @@ errno_t usbhc_unregister_endpoint(async_exch_t *exch, const usb_pipe_desc_t *pip
  * Issue a USB transfer with a data contained in memory area. That area is
  * temporarily shared with the HC.
  */
-errno_t usbhc_transfer(async_exch_t *exch,
-    const usbhc_iface_transfer_request_t *req, size_t *transferred)
+/** Issue a USB transfer without waiting for its completion.
+ *
+ * The caller-owned @a aid tracks the submitted transfer; collect
+ * it with usbhc_transfer_finish(). Any number of transfers may be
+ * in flight on one exchange, letting stacked drivers pipeline
+ * their hardware operations instead of paying a full IPC round
+ * trip per operation.
+ *
+ * @param exch Exchange to the host controller.
+ * @param req Transfer request.
+ * @param aid Caller-owned tracking structure.
+ *
+ * @return EOK when the transfer was submitted.
+ */
+errno_t usbhc_transfer_start(async_exch_t *exch,
+    const usbhc_iface_transfer_request_t *req, usbhc_transfer_aid_t *aid)
 {
-	if (transferred)
-		*transferred = 0;
-
 	if (!exch)
 		return EBADMEM;
 
-	ipc_call_t call;
-
-	aid_t opening_request = async_send_1(exch, DEV_IFACE_ID(USBHC_DEV_IFACE),
-	    IPC_M_USB_TRANSFER, &call);
+	aid->request = async_send_1(exch, DEV_IFACE_ID(USBHC_DEV_IFACE),
+	    IPC_M_USB_TRANSFER, &aid->call);
 
-	if (opening_request == 0)
+	if (aid->request == 0)
 		return ENOMEM;
 
 	const errno_t ret = async_data_write_start(exch, req, sizeof(*req));
 	if (ret != EOK) {
-		async_forget(opening_request);
+		async_forget(aid->request);
 		return ret;
 	}
 
@@ -208,21 +217,51 @@ errno_t usbhc_transfer(async_exch_t *exch,
 		unsigned flags = (req->dir == USB_DIRECTION_IN) ?
 		    AS_AREA_WRITE : AS_AREA_READ;
 
-		const errno_t ret = async_share_out_start(exch, req->buffer.virt, flags);
-		if (ret != EOK) {
-			async_forget(opening_request);
-			return ret;
+		const errno_t rc = async_share_out_start(exch,
+		    req->buffer.virt, flags);
+		if (rc != EOK) {
+			async_forget(aid->request);
+			return rc;
 		}
 	}
 
-	/* Wait for the answer. */
-	errno_t opening_request_rc;
-	async_wait_for(opening_request, &opening_request_rc);
+	return EOK;
+}
+
+/** Wait for a transfer submitted by usbhc_transfer_start().
+ *
+ * @param aid Tracking structure of the transfer.
+ * @param transferred Bytes actually transferred (may be NULL).
+ *
+ * @return Outcome of the transfer.
+ */
+errno_t usbhc_transfer_finish(usbhc_transfer_aid_t *aid, size_t *transferred)
+{
+	errno_t rc;
+
+	async_wait_for(aid->request, &rc);
+
+	if (transferred) {
+		*transferred = (rc == EOK) ?
+		    ipc_get_arg1(&aid->call) : 0;
+	}
+
+	return (errno_t) rc;
+}
+
+errno_t usbhc_transfer(async_exch_t *exch,
+    const usbhc_iface_transfer_request_t *req, size_t *transferred)
+{
+	usbhc_transfer_aid_t aid;
 
 	if (transferred)
-		*transferred = ipc_get_arg1(&call);
+		*transferred = 0;
 
-	return (errno_t) opening_request_rc;
+	errno_t rc = usbhc_transfer_start(exch, req, &aid);
+	if (rc != EOK)
+		return rc;
+
+	return usbhc_transfer_finish(&aid, transferred);
 }
 
 static void remote_usbhc_default_address_reservation(ddf_fun_t *, void *, ipc_call_t *);
@@ -52,6 +52,7 @@ extern errno_t nic_set_state(async_sess_t *, nic_device_state_t);
 extern errno_t nic_get_address(async_sess_t *, nic_address_t *);
 extern errno_t nic_set_address(async_sess_t *, const nic_address_t *);
 extern errno_t nic_get_stats(async_sess_t *, nic_device_stats_t *);
+extern errno_t nic_stats_share(async_sess_t *, nic_device_stats_t **);
 extern errno_t nic_get_device_info(async_sess_t *, nic_device_info_t *);
 extern errno_t nic_get_cable_state(async_sess_t *, nic_cable_state_t *);
 
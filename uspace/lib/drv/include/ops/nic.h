@@ -52,6 +52,7 @@ typedef struct nic_iface {
 	/** Optional methods */
 	errno_t (*set_address)(ddf_fun_t *, const nic_address_t *);
 	errno_t (*get_stats)(ddf_fun_t *, nic_device_stats_t *);
+	errno_t (*stats_share)(ddf_fun_t *, void **, size_t *);
 	errno_t (*get_device_info)(ddf_fun_t *, nic_device_info_t *);
 	errno_t (*get_cable_state)(ddf_fun_t *, nic_cable_state_t *);
 
@@ -178,6 +178,19 @@ extern errno_t usbhc_device_remove(async_exch_t *, unsigned);
 extern errno_t usbhc_register_endpoint(async_exch_t *, usb_pipe_desc_t *, const usb_endpoint_descriptors_t *);
 extern errno_t usbhc_unregister_endpoint(async_exch_t *, const usb_pipe_desc_t *);
 
+/** Tracking structure of a transfer in flight.
+ *
+ * Owned by the caller; must stay valid until the transfer is
+ * collected with usbhc_transfer_finish().
+ */
+typedef struct {
+	aid_t request;
+	ipc_call_t call;
+} usbhc_transfer_aid_t;
+
+extern errno_t usbhc_transfer_start(async_exch_t *,
+    const usbhc_iface_transfer_request_t *, usbhc_transfer_aid_t *);
+extern errno_t usbhc_transfer_finish(usbhc_transfer_aid_t *, size_t *);
 extern errno_t usbhc_transfer(async_exch_t *, const usbhc_iface_transfer_request_t *, size_t *);
 
 /** Callback for outgoing transfer */
@@ -36,6 +36,7 @@
 #define LIBEXT4_TYPES_H_
 
 #include <block.h>
+#include <fibril_synch.h>
 
 /*
  * Structure of the super block
@@ -232,6 +233,17 @@ typedef struct ext4_filesystem {
 	ext4_superblock_t *superblock;
 	aoff64_t inode_block_limits[4];
 	aoff64_t inode_blocks_per_level[4];
+
+	/** Lazy block group descriptor verification state, one byte
+	 * per group (0 unverified, 1 verified, 2 failed), or NULL */
+	uint8_t *bg_verify;
+	uint32_t bg_verify_count;
+
+	/** Tells the background verification sweep to stop */
+	volatile bool bg_sweep_stop;
+	/** Posted by the background sweep when it exits */
+	fibril_semaphore_t bg_sweep_done;
+	bool bg_sweep_running;
 } ext4_filesystem_t;
 
 /** Size of buffer for volume name. To hold 16 latin-1 chars encoded as UTF-8
@@ -335,6 +335,64 @@ static errno_t ext4_balloc_find_goal(ext4_inode_ref_t *inode_ref, uint32_t *goal
 	return ext4_filesystem_put_block_group_ref(bg_ref);
 }
 
+/*
+ * Per-inode block preallocation.
+ *
+ * When the goal block of an allocation is free, a short run of
+ * consecutive free blocks after it is claimed as well (fully
+ * accounted in the bitmap, group, superblock and i-node counters).
+ * Subsequent allocations for the same i-node are then served from
+ * the claimed run without touching the bitmap - a simple multi-block
+ * allocator for sequential writes. Leftover blocks are given back
+ * when the i-node reference is put at the end of the operation, so
+ * nothing stays claimed across operations.
+ */
+
+#define BALLOC_PREALLOC_SLOTS  8
+#define BALLOC_PREALLOC_MAX    8
+
+typedef struct {
+	bool valid;
+	service_id_t device;
+	uint32_t inode;
+	uint32_t next;       /**< Next preallocated block to hand out. */
+	uint32_t remaining;  /**< Number of preallocated blocks left. */
+} balloc_prealloc_t;
+
+static balloc_prealloc_t prealloc_cache[BALLOC_PREALLOC_SLOTS];
+
+static balloc_prealloc_t *balloc_prealloc_slot(ext4_inode_ref_t *inode_ref)
+{
+	size_t idx = (inode_ref->fs->device * 31 + inode_ref->index) %
+	    BALLOC_PREALLOC_SLOTS;
+
+	return &prealloc_cache[idx];
+}
+
+/** Give back unused preallocated blocks of an i-node.
+ *
+ * Called when an i-node reference is put; serving stale
+ * preallocations across operations is not worth the leak risk.
+ *
+ * @param inode_ref I-node whose preallocation should be released.
+ */
+void ext4_balloc_release_prealloc(ext4_inode_ref_t *inode_ref)
+{
+	balloc_prealloc_t *pa = balloc_prealloc_slot(inode_ref);
+
+	if ((!pa->valid) || (pa->device != inode_ref->fs->device) ||
+	    (pa->inode != inode_ref->index))
+		return;
+
+	/* Invalidate before any blocking call to stay idempotent. */
+	uint32_t next = pa->next;
+	uint32_t remaining = pa->remaining;
+	pa->valid = false;
+
+	for (uint32_t i = 0; i < remaining; i++)
+		(void) ext4_balloc_free_block(inode_ref, next + i);
+}
+
 /** Data block allocation algorithm.
  *
  * @param inode_ref Inode to allocate block for
@@ -354,6 +412,17 @@ errno_t ext4_balloc_alloc_block(ext4_inode_ref_t *inode_ref, uint32_t *fblock)
 	uint32_t goal;
 	uint32_t block_size;
 
+	/* Serve from the i-node's preallocated run if possible. */
+	balloc_prealloc_t *pa = balloc_prealloc_slot(inode_ref);
+	if ((pa->valid) && (pa->device == inode_ref->fs->device) &&
+	    (pa->inode == inode_ref->index) && (pa->remaining > 0)) {
+		*fblock = pa->next++;
+		pa->remaining--;
+		if (pa->remaining == 0)
+			pa->valid = false;
+		return EOK;
+	}
+
 	/* Find GOAL */
 	errno_t rc = ext4_balloc_find_goal(inode_ref, &goal);
 	if (rc != EOK)
@@ -401,9 +470,32 @@ errno_t ext4_balloc_alloc_block(ext4_inode_ref_t *inode_ref, uint32_t *fblock)
 		return rc;
 	}
 
+	uint32_t blocks_in_group =
+	    ext4_superblock_get_blocks_in_group(sb, block_group);
+
+	uint32_t prealloc_extra = 0;
+
 	/* Check if goal is free */
 	if (ext4_bitmap_is_free_bit(bitmap_block->data, index_in_group)) {
 		ext4_bitmap_set_bit(bitmap_block->data, index_in_group);
+
+		/*
+		 * Claim a short run of consecutive free blocks for
+		 * the i-node while the bitmap is at hand, but only if
+		 * no other i-node currently owns the slot.
+		 */
+		if (!pa->valid) {
+			while ((prealloc_extra + 1 < BALLOC_PREALLOC_MAX) &&
+			    (index_in_group + prealloc_extra + 1 <
+			    blocks_in_group) &&
+			    (ext4_bitmap_is_free_bit(bitmap_block->data,
+			    index_in_group + prealloc_extra + 1))) {
+				ext4_bitmap_set_bit(bitmap_block->data,
+				    index_in_group + prealloc_extra + 1);
+				prealloc_extra++;
+			}
+		}
+
 		bitmap_block->dirty = true;
 		rc = block_put(bitmap_block);
 		if (rc != EOK) {
@@ -418,9 +510,6 @@ errno_t ext4_balloc_alloc_block(ext4_inode_ref_t *inode_ref, uint32_t *fblock)
 		goto success;
 	}
 
-	uint32_t blocks_in_group =
-	    ext4_superblock_get_blocks_in_group(sb, block_group);
-
 	uint32_t end_idx = (index_in_group + 63) & ~63;
 	if (end_idx > blocks_in_group)
 		end_idx = blocks_in_group;
@@ -590,26 +679,35 @@ success:
 
 	/* Update superblock free blocks count */
 	uint32_t sb_free_blocks = ext4_superblock_get_free_blocks_count(sb);
-	sb_free_blocks--;
+	sb_free_blocks -= 1 + prealloc_extra;
 	ext4_superblock_set_free_blocks_count(sb, sb_free_blocks);
 
 	/* Update inode blocks (different block size!) count */
 	uint64_t ino_blocks =
 	    ext4_inode_get_blocks_count(sb, inode_ref->inode);
-	ino_blocks += block_size / EXT4_INODE_BLOCK_SIZE;
+	ino_blocks += (1 + prealloc_extra) *
+	    (block_size / EXT4_INODE_BLOCK_SIZE);
 	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
 	inode_ref->dirty = true;
 
 	/* Update block group free blocks count */
 	uint32_t bg_free_blocks =
 	    ext4_block_group_get_free_blocks_count(bg_ref->block_group, sb);
-	bg_free_blocks--;
+	bg_free_blocks -= 1 + prealloc_extra;
 	ext4_block_group_set_free_blocks_count(bg_ref->block_group, sb,
 	    bg_free_blocks);
 	bg_ref->dirty = true;
 
 	rc = ext4_filesystem_put_block_group_ref(bg_ref);
 
+	if (prealloc_extra > 0) {
+		pa->valid = true;
+		pa->device = inode_ref->fs->device;
+		pa->inode = inode_ref->index;
+		pa->next = allocated_block + 1;
+		pa->remaining = prealloc_extra;
+	}
+
 	*fblock = allocated_block;
 	return rc;
 }
@@ -360,6 +360,47 @@ static void ext4_extent_binsearch(ext4_extent_header_t *header,
 	*extent = l - 1;
 }
 
+/*
+ * Memoized extent mappings.
+ *
+ * Walking the extent tree costs one block cache access per level;
+ * sequential access patterns resolve the same leaf extent over and
+ * over. A small direct-mapped cache remembers recently resolved
+ * extents keyed by device and i-node, so repeated mappings within
+ * one extent are answered without touching the tree. Entries of an
+ * i-node are dropped whenever its extent tree is modified.
+ */
+
+#define EXTENT_CACHE_SIZE  16
+
+typedef struct {
+	bool valid;
+	service_id_t device;
+	uint32_t inode;
+	uint32_t first;   /**< First logical block of the extent. */
+	uint32_t count;   /**< Number of blocks in the extent. */
+	uint32_t phys;    /**< Physical block of the extent start. */
+} extent_cache_entry_t;
+
+static extent_cache_entry_t extent_cache[EXTENT_CACHE_SIZE];
+
+static size_t extent_cache_slot(service_id_t device, uint32_t inode)
+{
+	return (device * 31 + inode) % EXTENT_CACHE_SIZE;
+}
+
+/** Drop cached extents of an i-node.
+ *
+ * Called whenever the i-node's extent tree is about to change.
+ */
+static void extent_cache_invalidate(ext4_inode_ref_t *inode_ref)
+{
+	size_t slot = extent_cache_slot(inode_ref->fs->device,
+	    inode_ref->index);
+
+	extent_cache[slot].valid = false;
+}
+
 /** Find physical block in the extent tree by logical block number.
  *
  * There is no need to save path in the tree during this algorithm.
@@ -390,6 +431,18 @@ errno_t ext4_extent_find_block(ext4_inode_ref_t *inode_ref, uint32_t iblock,
 		return EOK;
 	}
 
+	/* Try the memoized mapping first. */
+	size_t slot = extent_cache_slot(inode_ref->fs->device,
+	    inode_ref->index);
+	extent_cache_entry_t *ce = &extent_cache[slot];
+
+	if ((ce->valid) && (ce->device == inode_ref->fs->device) &&
+	    (ce->inode == inode_ref->index) && (iblock >= ce->first) &&
+	    (iblock < ce->first + ce->count)) {
+		*fblock = ce->phys + (iblock - ce->first);
+		return EOK;
+	}
+
 	block_t *block = NULL;
 
 	/* Walk through extent tree */
@@ -432,6 +485,14 @@ errno_t ext4_extent_find_block(ext4_inode_ref_t *inode_ref, uint32_t iblock,
 		phys_block = ext4_extent_get_start(extent) + iblock - first;
 
 		*fblock = phys_block;
+
+		/* Memoize the resolved extent. */
+		ce->valid = true;
+		ce->device = inode_ref->fs->device;
+		ce->inode = inode_ref->index;
+		ce->first = first;
+		ce->count = ext4_extent_get_block_count(extent);
+		ce->phys = ext4_extent_get_start(extent);
 	}
 
 	/* Cleanup */
@@ -619,6 +680,8 @@ static errno_t ext4_extent_release_branch(ext4_inode_ref_t *inode_ref,
 errno_t ext4_extent_release_blocks_from(ext4_inode_ref_t *inode_ref,
     uint32_t iblock_from)
 {
+	extent_cache_invalidate(inode_ref);
+
 	/* Find the first extent to modify */
 	ext4_extent_path_t *path;
 	errno_t rc2;
@@ -964,6 +1027,8 @@ static errno_t ext4_extent_append_extent(ext4_inode_ref_t *inode_ref,
 errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
     uint32_t *fblock, bool update_size)
 {
+	extent_cache_invalidate(inode_ref);
+
 	ext4_superblock_t *sb = inode_ref->fs->superblock;
 	uint64_t inode_size = ext4_inode_get_size(sb, inode_ref->inode);
 	uint32_t block_size = ext4_superblock_get_block_size(sb);
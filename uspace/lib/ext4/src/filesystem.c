@@ -38,6 +38,7 @@
 
 #include <byteorder.h>
 #include <errno.h>
+#include <fibril.h>
 #include <mem.h>
 #include <align.h>
 #include <crypto.h>
@@ -58,6 +59,11 @@
 
 static errno_t ext4_filesystem_check_features(ext4_filesystem_t *, bool *);
 static errno_t ext4_filesystem_init_block_groups(ext4_filesystem_t *);
+static uint16_t ext4_filesystem_bg_checksum(ext4_superblock_t *, uint32_t,
+    ext4_block_group_t *);
+static errno_t ext4_filesystem_bg_verify(ext4_filesystem_t *, uint32_t,
+    ext4_block_group_t *);
+static errno_t ext4_filesystem_bg_sweeper(void *);
 static errno_t ext4_filesystem_alloc_this_inode(ext4_filesystem_t *,
     uint32_t, ext4_inode_ref_t **, int);
 static uint32_t ext4_filesystem_inodes_per_block(ext4_superblock_t *);
@@ -137,6 +143,19 @@ static errno_t ext4_filesystem_init(ext4_filesystem_t *fs, service_id_t service_
 	if (rc != EOK)
 		goto err_2;
 
+	/*
+	 * Block group descriptors are verified lazily on first use
+	 * and by the background sweep, keeping the mount itself
+	 * independent of the volume size. With no state array the
+	 * verification is simply skipped.
+	 */
+	fs->bg_verify_count =
+	    ext4_superblock_get_block_group_count(fs->superblock);
+	fs->bg_verify = calloc(fs->bg_verify_count, sizeof(uint8_t));
+	fs->bg_sweep_stop = false;
+	fs->bg_sweep_running = false;
+	fibril_semaphore_initialize(&fs->bg_sweep_done, 0);
+
 	return EOK;
 err_2:
 	block_cache_fini(fs->device);
@@ -155,6 +174,15 @@ err:
  */
 static void ext4_filesystem_fini(ext4_filesystem_t *fs)
 {
+	/* Wind down the background verification sweep */
+	if (fs->bg_sweep_running) {
+		fs->bg_sweep_stop = true;
+		fibril_semaphore_down(&fs->bg_sweep_done);
+	}
+
+	free(fs->bg_verify);
+	fs->bg_verify = NULL;
+
 	/* Release memory space for superblock */
 	free(fs->superblock);
 
@@ -459,6 +487,16 @@ errno_t ext4_filesystem_open(ext4_instance_t *inst, service_id_t service_id,
 	*size = ext4_inode_get_size(fs->superblock, enode->inode_ref->inode);
 
 	ext4_node_put(root_node);
+
+	/* Verify the remaining block groups in the background. */
+	if (fs->bg_verify != NULL) {
+		fid_t fid = fibril_create(ext4_filesystem_bg_sweeper, fs);
+		if (fid != 0) {
+			fs->bg_sweep_running = true;
+			fibril_add_ready(fid);
+		}
+	}
+
 	*rfs = fs;
 	return EOK;
 error:
@@ -905,6 +943,93 @@ static errno_t ext4_filesystem_init_inode_table(ext4_block_group_ref_t *bg_ref)
  * @return Error code
  *
  */
+/** Verify a block group descriptor on its first use.
+ *
+ * Descriptor checksums (when the filesystem carries them) are
+ * checked once per group and the result is remembered. A group
+ * that fails stays off limits: references to it are refused, which
+ * also holds back allocations from it.
+ *
+ * @param fs   Filesystem
+ * @param bgid Block group index
+ * @param bg   Loaded block group descriptor
+ *
+ * @return EOK if the group is usable, EIO when corrupted.
+ *
+ */
+static errno_t ext4_filesystem_bg_verify(ext4_filesystem_t *fs, uint32_t bgid,
+    ext4_block_group_t *bg)
+{
+	if ((fs->bg_verify == NULL) || (bgid >= fs->bg_verify_count))
+		return EOK;
+
+	if (fs->bg_verify[bgid] == 1)
+		return EOK;
+
+	if (fs->bg_verify[bgid] == 2)
+		return EIO;
+
+	if (ext4_superblock_has_feature_read_only(fs->superblock,
+	    EXT4_FEATURE_RO_COMPAT_GDT_CSUM)) {
+		uint16_t stored = ext4_block_group_get_checksum(bg);
+		uint16_t computed = ext4_filesystem_bg_checksum(fs->superblock,
+		    bgid, bg);
+
+		if (stored != computed) {
+			fs->bg_verify[bgid] = 2;
+			return EIO;
+		}
+	}
+
+	fs->bg_verify[bgid] = 1;
+	return EOK;
+}
+
+/** Background sweep verifying all block group descriptors.
+ *
+ * Read-only: loads each descriptor block and verifies the groups
+ * that on-demand use has not covered yet.
+ */
+static errno_t ext4_filesystem_bg_sweeper(void *arg)
+{
+	ext4_filesystem_t *fs = (ext4_filesystem_t *) arg;
+
+	fibril_detach(fibril_get_id());
+
+	uint32_t descriptors_per_block =
+	    ext4_superblock_get_block_size(fs->superblock) /
+	    ext4_superblock_get_desc_size(fs->superblock);
+	aoff64_t dtable_block =
+	    ext4_superblock_get_first_data_block(fs->superblock) + 1;
+
+	for (uint32_t bgid = 0; bgid < fs->bg_verify_count; bgid++) {
+		if (fs->bg_sweep_stop)
+			break;
+
+		if (fs->bg_verify[bgid] != 0)
+			continue;
+
+		block_t *block;
+		aoff64_t block_id = dtable_block +
+		    (bgid / descriptors_per_block);
+		uint32_t offset = (bgid % descriptors_per_block) *
+		    ext4_superblock_get_desc_size(fs->superblock);
+
+		errno_t rc = block_get(&block, fs->device, block_id, 0);
+		if (rc != EOK)
+			break;
+
+		(void) ext4_filesystem_bg_verify(fs, bgid,
+		    (ext4_block_group_t *) (block->data + offset));
+
+		block_put(block);
+		fibril_yield();
+	}
+
+	fibril_semaphore_up(&fs->bg_sweep_done);
+	return EOK;
+}
+
 errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *fs, uint32_t bgid,
     ext4_block_group_ref_t **ref)
 {
@@ -941,6 +1066,14 @@ errno_t ext4_filesystem_get_block_group_ref(ext4_filesystem_t *fs, uint32_t bgid
 	newref->index = bgid;
 	newref->dirty = false;
 
+	/* First use of a group verifies its descriptor. */
+	rc = ext4_filesystem_bg_verify(fs, bgid, newref->block_group);
+	if (rc != EOK) {
+		block_put(newref->block);
+		free(newref);
+		return rc;
+	}
+
 	*ref = newref;
 
 	if (ext4_block_group_has_flag(newref->block_group,
@@ -1193,6 +1326,12 @@ errno_t ext4_filesystem_get_inode_ref(ext4_filesystem_t *fs, uint32_t index,
  */
 errno_t ext4_filesystem_put_inode_ref(ext4_inode_ref_t *ref)
 {
+	/*
+	 * Give back any block preallocation the operation left
+	 * unused; preallocations never outlive the i-node reference.
+	 */
+	ext4_balloc_release_prealloc(ref);
+
 	/* Check if reference modified */
 	if (ref->dirty) {
 		/* Mark block dirty for writing changes to physical device */
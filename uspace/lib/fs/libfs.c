@@ -198,6 +198,22 @@ static void vfs_out_truncate(ipc_call_t *req)
 	async_answer_0(req, rc);
 }
 
+static void vfs_out_copy(ipc_call_t *req)
+{
+	service_id_t service_id = (service_id_t) ipc_get_arg1(req);
+	fs_index_t src = (fs_index_t) ipc_get_arg2(req);
+	fs_index_t dst = (fs_index_t) ipc_get_arg3(req);
+	aoff64_t size = 0;
+	errno_t rc;
+
+	if (vfs_out_ops->copy != NULL)
+		rc = vfs_out_ops->copy(service_id, src, dst, &size);
+	else
+		rc = ENOTSUP;
+
+	async_answer_2(req, rc, LOWER32(size), UPPER32(size));
+}
+
 static void vfs_out_close(ipc_call_t *req)
 {
 	service_id_t service_id = (service_id_t) ipc_get_arg1(req);
@@ -319,6 +335,9 @@ static void vfs_connection(ipc_call_t *icall, void *arg)
 		case VFS_OUT_TRUNCATE:
 			vfs_out_truncate(&call);
 			break;
+		case VFS_OUT_COPY:
+			vfs_out_copy(&call);
+			break;
 		case VFS_OUT_CLOSE:
 			vfs_out_close(&call);
 			break;
@@ -49,6 +49,8 @@ typedef struct {
 	errno_t (*write)(service_id_t, fs_index_t, aoff64_t, size_t *,
 	    aoff64_t *);
 	errno_t (*truncate)(service_id_t, fs_index_t, aoff64_t);
+	/** Server-side whole-file copy; optional (may be NULL) */
+	errno_t (*copy)(service_id_t, fs_index_t, fs_index_t, aoff64_t *);
 	errno_t (*close)(service_id_t, fs_index_t);
 	errno_t (*destroy)(service_id_t, fs_index_t);
 	errno_t (*sync)(service_id_t, fs_index_t);
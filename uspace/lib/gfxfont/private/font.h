@@ -43,9 +43,13 @@
 #include <types/gfx/bitmap.h>
 #include <types/gfx/context.h>
 #include <types/gfx/font.h>
+#include <types/gfx/glyph.h>
 #include <types/gfx/typeface.h>
 #include <riff/chunk.h>
 
+/** Number of entries in the printable ASCII glyph map (0x20..0x7e) */
+#define GFX_FONT_ASCII_MAP_SIZE 95
+
 /** Font
  *
  * This is private to libgfxfont.
@@ -69,6 +73,19 @@ struct gfx_font {
 	gfx_bitmap_t *bitmap;
 	/** Bitmap rectangle */
 	gfx_rect_t rect;
+	/**
+	 * Fast map from printable ASCII (0x20..0x7e) to the glyph whose
+	 * single-character pattern matches it, filled lazily by
+	 * gfx_font_search_glyph(). Entries of destroyed glyphs are
+	 * cleared.
+	 */
+	struct gfx_glyph *ascii_map[GFX_FONT_ASCII_MAP_SIZE];
+	/**
+	 * True if any glyph has a multi-character pattern. Multi-character
+	 * patterns can shadow single-character ones depending on glyph
+	 * order, so the ASCII map is bypassed while this is set.
+	 */
+	bool long_patterns;
 };
 
 /** Font info
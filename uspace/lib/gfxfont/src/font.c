@@ -347,9 +347,33 @@ errno_t gfx_font_search_glyph(gfx_font_t *font, const char *str,
 	gfx_glyph_t *glyph;
 	size_t msize;
 
+	/*
+	 * Printable ASCII dominates rendered text; serve it from the
+	 * lazily filled direct map instead of walking the glyph list
+	 * and its patterns for every character.
+	 */
+	bool ascii = (str[0] >= 0x20) && (str[0] <= 0x7e) &&
+	    !font->long_patterns;
+	if (ascii) {
+		glyph = font->ascii_map[str[0] - 0x20];
+		if ((glyph != NULL) &&
+		    (gfx_glyph_matches(glyph, str, &msize))) {
+			*rglyph = glyph;
+			*rsize = msize;
+			return EOK;
+		}
+	}
+
 	glyph = gfx_font_first_glyph(font);
 	while (glyph != NULL) {
 		if (gfx_glyph_matches(glyph, str, &msize)) {
+			/*
+			 * Cache single-character ASCII matches; longer
+			 * pattern matches must not shadow them.
+			 */
+			if (ascii && (msize == 1))
+				font->ascii_map[str[0] - 0x20] = glyph;
+
 			*rglyph = glyph;
 			*rsize = msize;
 			return EOK;
@@ -117,6 +117,12 @@ errno_t gfx_glyph_create(gfx_font_t *font, gfx_glyph_metrics_t *metrics,
  */
 void gfx_glyph_destroy(gfx_glyph_t *glyph)
 {
+	/* Drop any fast-map references to this glyph. */
+	for (unsigned i = 0; i < GFX_FONT_ASCII_MAP_SIZE; i++) {
+		if (glyph->font->ascii_map[i] == glyph)
+			glyph->font->ascii_map[i] = NULL;
+	}
+
 	list_remove(&glyph->lglyphs);
 	free(glyph);
 }
@@ -178,6 +184,9 @@ errno_t gfx_glyph_set_pattern(gfx_glyph_t *glyph, const char *pattern)
 		return ENOMEM;
 	}
 
+	if (str_length(pattern) > 1)
+		glyph->font->long_patterns = true;
+
 	list_append(&pat->lpatterns, &glyph->patterns);
 	return EOK;
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup http
+ * @{
+ */
+/**
+ * @file Streaming response body decoder.
+ *
+ * Decodes a response body into caller-supplied buffers, handling
+ * Content-Length and chunked transfer framing. Knowing where a body
+ * ends is also what makes a connection reusable for keep-alive.
+ */
+
+#ifndef HTTP_BODY_H_
+#define HTTP_BODY_H_
+
+#include <stdbool.h>
+
+#include "http.h"
+#include "receive-buffer.h"
+
+typedef enum {
+	/** Body delimited by connection close */
+	http_body_until_close,
+	/** Body delimited by Content-Length */
+	http_body_length,
+	/** Chunked transfer coding */
+	http_body_chunked
+} http_body_mode_t;
+
+typedef struct {
+	receive_buffer_t *rb;
+	http_body_mode_t mode;
+	/** Bytes left in the body or in the current chunk */
+	size_t remaining;
+	/** Whether the end of the body was reached */
+	bool ended;
+	/** Whether we are mid-chunk (expecting a chunk terminator) */
+	bool in_chunk;
+} http_body_t;
+
+extern errno_t http_body_init(http_body_t *, receive_buffer_t *,
+    http_response_t *);
+extern errno_t http_body_read(http_body_t *, void *, size_t, size_t *);
+extern bool http_body_ended(http_body_t *);
+
+#endif
+
+/** @}
+ */
@@ -39,6 +39,7 @@
 #include <adt/list.h>
 #include <inet/addr.h>
 #include <inet/tcp.h>
+#include <stdbool.h>
 
 #include "receive-buffer.h"
 
@@ -52,6 +53,9 @@ typedef struct {
 
 	size_t buffer_size;
 	receive_buffer_t recv_buffer;
+
+	/** Membership in a connection pool's idle list */
+	link_t pool_link;
 } http_t;
 
 typedef struct {
@@ -130,6 +134,7 @@ extern errno_t http_receive_status(receive_buffer_t *, http_version_t *, uint16_
     char **);
 extern errno_t http_receive_response(receive_buffer_t *, http_response_t **,
     size_t, unsigned);
+extern bool http_response_keep_alive(http_response_t *);
 extern void http_response_destroy(http_response_t *);
 extern errno_t http_close(http_t *);
 extern void http_destroy(http_t *);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup http
+ * @{
+ */
+/**
+ * @file Keep-alive connection pool.
+ *
+ * A pool of connections to one host. Fibrils issuing requests in
+ * parallel each obtain their own connection; returned connections
+ * whose response body was fully read (see body.h) are kept for
+ * reuse instead of being torn down, and fibrils over the limit
+ * wait for a connection to come back.
+ */
+
+#ifndef HTTP_POOL_H_
+#define HTTP_POOL_H_
+
+#include <adt/list.h>
+#include <fibril_synch.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "http.h"
+
+typedef struct {
+	char *host;
+	uint16_t port;
+
+	/** Cap on concurrently open connections */
+	size_t limit;
+	/** Connections currently handed out or idle */
+	size_t active;
+	/** Idle connections ready for reuse */
+	list_t idle;
+
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+} http_pool_t;
+
+extern http_pool_t *http_pool_create(const char *, uint16_t, size_t);
+extern errno_t http_pool_get(http_pool_t *, http_t **);
+extern void http_pool_put(http_pool_t *, http_t *, bool);
+extern void http_pool_destroy(http_pool_t *);
+
+#endif
+
+/** @}
+ */
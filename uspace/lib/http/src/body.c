@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup http
+ * @{
+ */
+/**
+ * @file
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <str.h>
+
+#include <http/body.h>
+#include <http/ctype.h>
+
+/** Consume one CRLF (or bare LF) end of line */
+static errno_t body_eol(receive_buffer_t *rb)
+{
+	size_t nrecv;
+	errno_t rc = recv_eol(rb, &nrecv);
+	if (rc == EOK && nrecv == 0)
+		rc = HTTP_EPARSE;
+	return rc;
+}
+
+/** Parse a chunk-size line, ignoring any chunk extensions */
+static errno_t chunk_size_parse(receive_buffer_t *rb, size_t *out_size)
+{
+	size_t size = 0;
+	bool have_digit = false;
+	char c = 0;
+
+	while (true) {
+		errno_t rc = recv_char(rb, &c, true);
+		if (rc != EOK)
+			return rc;
+
+		int digit;
+		if (c >= '0' && c <= '9')
+			digit = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			digit = c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			digit = c - 'A' + 10;
+		else
+			break;
+
+		size = size * 16 + digit;
+		have_digit = true;
+	}
+
+	if (!have_digit)
+		return HTTP_EPARSE;
+
+	/* Skip chunk extensions up to the end of the line. */
+	while (c != '\r' && c != '\n') {
+		errno_t rc = recv_char(rb, &c, true);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (c == '\r') {
+		errno_t rc = recv_char(rb, &c, true);
+		if (rc != EOK)
+			return rc;
+		if (c != '\n')
+			return HTTP_EPARSE;
+	}
+
+	*out_size = size;
+	return EOK;
+}
+
+/** Consume trailer headers up to and including the empty line */
+static errno_t chunk_trailer_discard(receive_buffer_t *rb)
+{
+	while (true) {
+		size_t nrecv;
+		errno_t rc = recv_eol(rb, &nrecv);
+		if (rc != EOK)
+			return rc;
+
+		/* Empty line terminates the trailer. */
+		if (nrecv > 0)
+			return EOK;
+
+		char c;
+		do {
+			rc = recv_char(rb, &c, true);
+			if (rc != EOK)
+				return rc;
+		} while (c != '\n');
+	}
+}
+
+/** Set up body decoding according to the response framing.
+ *
+ * @param body Body decoder to initialize
+ * @param rb Receive buffer positioned just past the header section
+ * @param resp Received response (for framing headers)
+ * @return EOK on success or an error code
+ */
+errno_t http_body_init(http_body_t *body, receive_buffer_t *rb,
+    http_response_t *resp)
+{
+	body->rb = rb;
+	body->mode = http_body_until_close;
+	body->remaining = 0;
+	body->ended = false;
+	body->in_chunk = false;
+
+	char *value = NULL;
+	errno_t rc = http_headers_get(&resp->headers, "Transfer-Encoding",
+	    &value);
+	if (rc == EOK && str_casecmp(value, "chunked") == 0) {
+		body->mode = http_body_chunked;
+		return EOK;
+	}
+
+	rc = http_headers_get(&resp->headers, "Content-Length", &value);
+	if (rc == EOK) {
+		uint64_t length;
+		rc = str_uint64_t(value, NULL, 10, true, &length);
+		if (rc != EOK)
+			return HTTP_EPARSE;
+
+		body->mode = http_body_length;
+		body->remaining = (size_t) length;
+		body->ended = (length == 0);
+	}
+
+	return EOK;
+}
+
+/** Read a piece of the decoded body.
+ *
+ * Reads up to @a size decoded bytes into @a buf. Zero @a *nread
+ * with EOK return means the body has ended.
+ */
+errno_t http_body_read(http_body_t *body, void *buf, size_t size,
+    size_t *nread)
+{
+	errno_t rc;
+
+	*nread = 0;
+
+	if (body->ended)
+		return EOK;
+
+	switch (body->mode) {
+	case http_body_until_close:
+		rc = recv_buffer(body->rb, buf, size, nread);
+		if (rc != EOK)
+			return rc;
+		if (*nread == 0)
+			body->ended = true;
+		return EOK;
+
+	case http_body_length:
+		if (size > body->remaining)
+			size = body->remaining;
+
+		rc = recv_buffer(body->rb, buf, size, nread);
+		if (rc != EOK)
+			return rc;
+		if (*nread == 0)
+			return HTTP_EPARSE;
+
+		body->remaining -= *nread;
+		body->ended = (body->remaining == 0);
+		return EOK;
+
+	case http_body_chunked:
+		if (body->remaining == 0) {
+			if (body->in_chunk) {
+				/* Chunk data is terminated by CRLF. */
+				rc = body_eol(body->rb);
+				if (rc != EOK)
+					return rc;
+				body->in_chunk = false;
+			}
+
+			size_t chunk_size;
+			rc = chunk_size_parse(body->rb, &chunk_size);
+			if (rc != EOK)
+				return rc;
+
+			if (chunk_size == 0) {
+				rc = chunk_trailer_discard(body->rb);
+				if (rc != EOK)
+					return rc;
+				body->ended = true;
+				return EOK;
+			}
+
+			body->remaining = chunk_size;
+			body->in_chunk = true;
+		}
+
+		if (size > body->remaining)
+			size = body->remaining;
+
+		rc = recv_buffer(body->rb, buf, size, nread);
+		if (rc != EOK)
+			return rc;
+		if (*nread == 0)
+			return HTTP_EPARSE;
+
+		body->remaining -= *nread;
+		return EOK;
+	}
+
+	return EINVAL;
+}
+
+/** Whether the end of the body was reached */
+bool http_body_ended(http_body_t *body)
+{
+	return body->ended;
+}
+
+/** @}
+ */
@@ -56,7 +56,7 @@ static errno_t http_receive(void *client_data, void *buf, size_t buf_size,
 
 http_t *http_create(const char *host, uint16_t port)
 {
-	http_t *http = malloc(sizeof(http_t));
+	http_t *http = calloc(1, sizeof(http_t));
 	if (http == NULL)
 		return NULL;
 
@@ -66,11 +66,13 @@ http_t *http_create(const char *host, uint16_t port)
 		return NULL;
 	}
 	http->port = port;
+	link_initialize(&http->pool_link);
 
 	http->buffer_size = 4096;
 	errno_t rc = recv_buffer_init(&http->recv_buffer, http->buffer_size,
 	    http_receive, http);
 	if (rc != EOK) {
+		free(http->host);
 		free(http);
 		return NULL;
 	}
@@ -126,6 +128,7 @@ void http_destroy(http_t *http)
 {
 	(void) http_close(http);
 	recv_buffer_fini(&http->recv_buffer);
+	free(http->host);
 	free(http);
 }
 
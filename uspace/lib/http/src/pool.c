@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup http
+ * @{
+ */
+/**
+ * @file
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <str.h>
+
+#include <http/pool.h>
+
+/** Create a connection pool for one host.
+ *
+ * @param host Host name
+ * @param port Port number
+ * @param limit Cap on concurrently open connections
+ * @return New pool or NULL on allocation failure
+ */
+http_pool_t *http_pool_create(const char *host, uint16_t port, size_t limit)
+{
+	http_pool_t *pool = calloc(1, sizeof(http_pool_t));
+	if (pool == NULL)
+		return NULL;
+
+	pool->host = str_dup(host);
+	if (pool->host == NULL) {
+		free(pool);
+		return NULL;
+	}
+
+	pool->port = port;
+	pool->limit = (limit > 0) ? limit : 1;
+	list_initialize(&pool->idle);
+	fibril_mutex_initialize(&pool->lock);
+	fibril_condvar_initialize(&pool->cv);
+
+	return pool;
+}
+
+/** Obtain a connection from the pool.
+ *
+ * Reuses an idle keep-alive connection when one is available,
+ * opens a new one while under the limit and otherwise waits for a
+ * connection to be returned.
+ *
+ * @param pool Connection pool
+ * @param out_http Place to store the connection
+ * @return EOK on success or an error code
+ */
+errno_t http_pool_get(http_pool_t *pool, http_t **out_http)
+{
+	fibril_mutex_lock(&pool->lock);
+
+	while (list_empty(&pool->idle) && pool->active >= pool->limit)
+		fibril_condvar_wait(&pool->cv, &pool->lock);
+
+	link_t *link = list_first(&pool->idle);
+	if (link != NULL) {
+		list_remove(link);
+		fibril_mutex_unlock(&pool->lock);
+
+		*out_http = list_get_instance(link, http_t, pool_link);
+		return EOK;
+	}
+
+	++pool->active;
+	fibril_mutex_unlock(&pool->lock);
+
+	http_t *http = http_create(pool->host, pool->port);
+	errno_t rc = (http != NULL) ? http_connect(http) : ENOMEM;
+
+	if (rc != EOK) {
+		if (http != NULL)
+			http_destroy(http);
+
+		fibril_mutex_lock(&pool->lock);
+		--pool->active;
+		fibril_condvar_signal(&pool->cv);
+		fibril_mutex_unlock(&pool->lock);
+		return rc;
+	}
+
+	*out_http = http;
+	return EOK;
+}
+
+/** Return a connection to the pool.
+ *
+ * @param pool Connection pool
+ * @param http Connection obtained from http_pool_get()
+ * @param reusable Whether the connection can carry another request
+ *	(response body fully read and the server did not ask for a
+ *	close)
+ */
+void http_pool_put(http_pool_t *pool, http_t *http, bool reusable)
+{
+	/* Tear down outside the lock; it blocks on the TCP service. */
+	if (!reusable)
+		http_destroy(http);
+
+	fibril_mutex_lock(&pool->lock);
+
+	if (reusable)
+		list_append(&http->pool_link, &pool->idle);
+	else
+		--pool->active;
+
+	fibril_condvar_signal(&pool->cv);
+	fibril_mutex_unlock(&pool->lock);
+}
+
+/** Destroy the pool and any idle connections.
+ *
+ * All handed-out connections must have been returned.
+ */
+void http_pool_destroy(http_pool_t *pool)
+{
+	link_t *link;
+
+	while ((link = list_first(&pool->idle)) != NULL) {
+		list_remove(link);
+		http_destroy(list_get_instance(link, http_t, pool_link));
+	}
+
+	free(pool->host);
+	free(pool);
+}
+
+/** @}
+ */
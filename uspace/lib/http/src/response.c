@@ -227,5 +227,22 @@ void http_response_destroy(http_response_t *resp)
 	free(resp);
 }
 
+/** Whether the connection may carry another request.
+ *
+ * HTTP/1.1 defaults to keep-alive unless the server asked for a
+ * close; earlier versions only persist when keep-alive was
+ * explicitly granted.
+ */
+bool http_response_keep_alive(http_response_t *resp)
+{
+	char *value = NULL;
+	errno_t rc = http_headers_get(&resp->headers, "Connection", &value);
+
+	if (resp->version.major == 1 && resp->version.minor >= 1)
+		return (rc != EOK) || (str_casecmp(value, "close") != 0);
+
+	return (rc == EOK) && (str_casecmp(value, "keep-alive") == 0);
+}
+
 /** @}
  */
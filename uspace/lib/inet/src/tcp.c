@@ -32,12 +32,14 @@
 /** @file TCP API
  */
 
+#include <abi/ipc/ipc.h>
 #include <errno.h>
 #include <fibril.h>
 #include <inet/endpoint.h>
 #include <inet/tcp.h>
 #include <ipc/services.h>
 #include <ipc/tcp.h>
+#include <libarch/config.h>
 #include <stdlib.h>
 
 static void tcp_cb_conn(ipc_call_t *, void *);
@@ -454,13 +456,16 @@ errno_t tcp_conn_send(tcp_conn_t *conn, const void *data, size_t bytes)
 
 	exch = async_exchange_begin(conn->tcp->sess);
 	aid_t req = async_send_1(exch, TCP_CONN_SEND, conn->id, NULL);
-	rc = async_data_write_start(exch, data, bytes);
-	async_exchange_end(exch);
 
-	if (rc != EOK) {
-		async_forget(req);
-		return rc;
-	}
+	/*
+	 * Page-sized and larger payloads are pinned in the kernel
+	 * instead of bouncing through a kernel buffer, the same way
+	 * bulk VFS writes are. The buffer is reusable once the data
+	 * write call returns.
+	 */
+	rc = async_data_write_start_flags(exch, data, bytes,
+	    (bytes >= PAGE_SIZE) ? IPC_XF_ZEROCOPY : 0);
+	async_exchange_end(exch);
 
 	if (rc != EOK) {
 		async_forget(req);
@@ -43,6 +43,7 @@
 #include <gfx/render.h>
 #include <io/pixel.h>
 #include <io/pixelmap.h>
+#include <mem.h>
 #include <memgfx/memgc.h>
 #include <stdlib.h>
 #include "../private/memgc.h"
@@ -139,9 +140,26 @@ static errno_t mem_gc_fill_rect(void *arg, gfx_rect_t *rect)
 	pixelmap.height = mgc->rect.p1.y;
 	pixelmap.data = mgc->alloc.pixels;
 
-	for (y = crect.p0.y; y < crect.p1.y; y++) {
-		for (x = crect.p0.x; x < crect.p1.x; x++) {
-			pixelmap_put_pixel(&pixelmap, x, y, mgc->color);
+	/*
+	 * Fill the first row pixel by pixel, then replicate it with
+	 * row-sized copies; the pixel map is contiguous 32bpp.
+	 */
+	if (crect.p0.y < crect.p1.y) {
+		size_t row_px = crect.p1.x - crect.p0.x;
+
+		for (x = crect.p0.x; x < crect.p1.x; x++)
+			pixelmap_put_pixel(&pixelmap, x, crect.p0.y,
+			    mgc->color);
+
+		pixel_t *first = pixelmap_pixel_at(&pixelmap, crect.p0.x,
+		    crect.p0.y);
+
+		for (y = crect.p0.y + 1; y < crect.p1.y; y++) {
+			pixel_t *dp = pixelmap_pixel_at(&pixelmap,
+			    crect.p0.x, y);
+
+			if ((first != NULL) && (dp != NULL))
+				memcpy(dp, first, row_px * sizeof(pixel_t));
 		}
 	}
 
@@ -418,14 +436,21 @@ static errno_t mem_gc_bitmap_render(void *bm, gfx_rect_t *srect0,
 	if ((mbm->flags & bmpf_direct_output) != 0) {
 		/* Nothing to do */
 	} else if ((mbm->flags & bmpf_color_key) == 0) {
-		/* Simple copy */
+		/*
+		 * Simple copy. Both pixel maps are contiguous 32bpp
+		 * (asserted above), so each row is one memcpy instead
+		 * of a per-pixel address computation.
+		 */
+		size_t row_px = crect.p1.x - crect.p0.x;
 		for (y = crect.p0.y; y < crect.p1.y; y++) {
-			for (x = crect.p0.x; x < crect.p1.x; x++) {
-				pixel = pixelmap_get_pixel(&smap,
-				    x - mbm->rect.p0.x - offs.x,
-				    y - mbm->rect.p0.y - offs.y);
-				pixelmap_put_pixel(&dmap, x, y, pixel);
-			}
+			pixel_t *sp = pixelmap_pixel_at(&smap,
+			    crect.p0.x - mbm->rect.p0.x - offs.x,
+			    y - mbm->rect.p0.y - offs.y);
+			pixel_t *dp = pixelmap_pixel_at(&dmap,
+			    crect.p0.x, y);
+
+			if ((sp != NULL) && (dp != NULL))
+				memcpy(dp, sp, row_px * sizeof(pixel_t));
 		}
 	} else if ((mbm->flags & bmpf_colorize) == 0) {
 		/* Color key */
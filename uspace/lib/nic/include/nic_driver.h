@@ -95,8 +95,12 @@ struct nic {
 	 * acquire main_lock first (otherwise deadlock could happen).
 	 */
 	fibril_rwlock_t main_lock;
-	/** Device statistics */
-	nic_device_stats_t stats;
+	/**
+	 * Device statistics, kept in a dedicated shareable memory
+	 * area so that interested monitors can map them read-only and
+	 * sample rates without IPC round trips.
+	 */
+	nic_device_stats_t *stats;
 	/**
 	 * Lock for statistics. You must not hold any other lock from nic_t except
 	 * the main_lock at the same moment. If both this lock and main_lock should
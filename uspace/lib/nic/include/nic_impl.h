@@ -53,6 +53,7 @@ extern errno_t nic_callback_create_impl(ddf_fun_t *dev_fun);
 extern errno_t nic_get_state_impl(ddf_fun_t *dev_fun, nic_device_state_t *state);
 extern errno_t nic_set_state_impl(ddf_fun_t *dev_fun, nic_device_state_t state);
 extern errno_t nic_get_stats_impl(ddf_fun_t *dev_fun, nic_device_stats_t *stats);
+extern errno_t nic_stats_share_impl(ddf_fun_t *, void **, size_t *);
 extern errno_t nic_unicast_get_mode_impl(ddf_fun_t *dev_fun,
     nic_unicast_mode_t *, size_t, nic_address_t *, size_t *);
 extern errno_t nic_unicast_set_mode_impl(ddf_fun_t *dev_fun,
@@ -107,6 +107,8 @@ void nic_driver_implement(driver_ops_t *driver_ops, ddf_dev_ops_t *dev_ops,
 			iface->get_address = nic_get_address_impl;
 		if (!iface->get_stats)
 			iface->get_stats = nic_get_stats_impl;
+		if (!iface->stats_share)
+			iface->stats_share = nic_stats_share_impl;
 		if (!iface->unicast_get_mode)
 			iface->unicast_get_mode = nic_unicast_get_mode_impl;
 		if (!iface->unicast_set_mode)
@@ -530,14 +532,14 @@ void nic_received_frame(nic_t *nic_data, nic_frame_t *frame)
 	fibril_rwlock_write_lock(&nic_data->stats_lock);
 
 	if (nic_data->state == NIC_STATE_ACTIVE && check) {
-		nic_data->stats.receive_packets++;
-		nic_data->stats.receive_bytes += frame->size;
+		nic_data->stats->receive_packets++;
+		nic_data->stats->receive_bytes += frame->size;
 		switch (frame_type) {
 		case NIC_FRAME_MULTICAST:
-			nic_data->stats.receive_multicast++;
+			nic_data->stats->receive_multicast++;
 			break;
 		case NIC_FRAME_BROADCAST:
-			nic_data->stats.receive_broadcast++;
+			nic_data->stats->receive_broadcast++;
 			break;
 		default:
 			break;
@@ -548,13 +550,13 @@ void nic_received_frame(nic_t *nic_data, nic_frame_t *frame)
 	} else {
 		switch (frame_type) {
 		case NIC_FRAME_UNICAST:
-			nic_data->stats.receive_filtered_unicast++;
+			nic_data->stats->receive_filtered_unicast++;
 			break;
 		case NIC_FRAME_MULTICAST:
-			nic_data->stats.receive_filtered_multicast++;
+			nic_data->stats->receive_filtered_multicast++;
 			break;
 		case NIC_FRAME_BROADCAST:
-			nic_data->stats.receive_filtered_broadcast++;
+			nic_data->stats->receive_filtered_broadcast++;
 			break;
 		}
 		fibril_rwlock_write_unlock(&nic_data->stats_lock);
@@ -624,7 +626,20 @@ static nic_t *nic_create(ddf_dev_t *dev)
 
 	memset(&nic_data->mac, 0, sizeof(nic_address_t));
 	memset(&nic_data->default_mac, 0, sizeof(nic_address_t));
-	memset(&nic_data->stats, 0, sizeof(nic_device_stats_t));
+
+	/*
+	 * The statistics live in their own shareable area so that
+	 * monitors can map them read-only and sample transfer rates
+	 * without IPC round trips. A whole page is the sharing
+	 * granularity anyway.
+	 */
+	nic_data->stats = as_area_create(AS_AREA_ANY, PAGE_SIZE,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+	    AS_AREA_UNPAGED);
+	if (nic_data->stats == AS_MAP_FAILED)
+		return NULL;
+
+	memset(nic_data->stats, 0, sizeof(nic_device_stats_t));
 
 	return nic_data;
 }
@@ -928,8 +943,8 @@ nic_t *nic_get_from_ddf_fun(ddf_fun_t *fun)
 void nic_report_send_ok(nic_t *nic_data, size_t packets, size_t bytes)
 {
 	fibril_rwlock_write_lock(&nic_data->stats_lock);
-	nic_data->stats.send_packets += packets;
-	nic_data->stats.send_bytes += bytes;
+	nic_data->stats->send_packets += packets;
+	nic_data->stats->send_bytes += bytes;
 	fibril_rwlock_write_unlock(&nic_data->stats_lock);
 }
 
@@ -947,25 +962,25 @@ void nic_report_send_error(nic_t *nic_data, nic_send_error_cause_t cause,
 		return;
 
 	fibril_rwlock_write_lock(&nic_data->stats_lock);
-	nic_data->stats.send_errors += count;
+	nic_data->stats->send_errors += count;
 	switch (cause) {
 	case NIC_SEC_BUFFER_FULL:
-		nic_data->stats.send_dropped += count;
+		nic_data->stats->send_dropped += count;
 		break;
 	case NIC_SEC_ABORTED:
-		nic_data->stats.send_aborted_errors += count;
+		nic_data->stats->send_aborted_errors += count;
 		break;
 	case NIC_SEC_CARRIER_LOST:
-		nic_data->stats.send_carrier_errors += count;
+		nic_data->stats->send_carrier_errors += count;
 		break;
 	case NIC_SEC_FIFO_OVERRUN:
-		nic_data->stats.send_fifo_errors += count;
+		nic_data->stats->send_fifo_errors += count;
 		break;
 	case NIC_SEC_HEARTBEAT:
-		nic_data->stats.send_heartbeat_errors += count;
+		nic_data->stats->send_heartbeat_errors += count;
 		break;
 	case NIC_SEC_WINDOW_ERROR:
-		nic_data->stats.send_window_errors += count;
+		nic_data->stats->send_window_errors += count;
 		break;
 	case NIC_SEC_OTHER:
 		break;
@@ -984,28 +999,28 @@ void nic_report_receive_error(nic_t *nic_data,
     nic_receive_error_cause_t cause, unsigned count)
 {
 	fibril_rwlock_write_lock(&nic_data->stats_lock);
-	nic_data->stats.receive_errors += count;
+	nic_data->stats->receive_errors += count;
 	switch (cause) {
 	case NIC_REC_BUFFER_FULL:
-		nic_data->stats.receive_dropped += count;
+		nic_data->stats->receive_dropped += count;
 		break;
 	case NIC_REC_LENGTH:
-		nic_data->stats.receive_length_errors += count;
+		nic_data->stats->receive_length_errors += count;
 		break;
 	case NIC_REC_BUFFER_OVERFLOW:
-		nic_data->stats.receive_dropped += count;
+		nic_data->stats->receive_dropped += count;
 		break;
 	case NIC_REC_CRC:
-		nic_data->stats.receive_crc_errors += count;
+		nic_data->stats->receive_crc_errors += count;
 		break;
 	case NIC_REC_FRAME_ALIGNMENT:
-		nic_data->stats.receive_frame_errors += count;
+		nic_data->stats->receive_frame_errors += count;
 		break;
 	case NIC_REC_FIFO_OVERRUN:
-		nic_data->stats.receive_fifo_errors += count;
+		nic_data->stats->receive_fifo_errors += count;
 		break;
 	case NIC_REC_MISSED:
-		nic_data->stats.receive_missed_errors += count;
+		nic_data->stats->receive_missed_errors += count;
 		break;
 	case NIC_REC_OTHER:
 		break;
@@ -1019,7 +1034,7 @@ void nic_report_receive_error(nic_t *nic_data,
 void nic_report_collisions(nic_t *nic_data, unsigned count)
 {
 	fibril_rwlock_write_lock(&nic_data->stats_lock);
-	nic_data->stats.collisions += count;
+	nic_data->stats->collisions += count;
 	fibril_rwlock_write_unlock(&nic_data->stats_lock);
 }
 
@@ -35,7 +35,9 @@
  * @brief Default DDF NIC interface methods implementations
  */
 
+#include <as.h>
 #include <errno.h>
+#include <libarch/config.h>
 #include <str_error.h>
 #include <ipc/services.h>
 #include <ns.h>
@@ -130,7 +132,7 @@ errno_t nic_set_state_impl(ddf_fun_t *fun, nic_device_state_t state)
 		}
 
 		fibril_rwlock_write_lock(&nic_data->stats_lock);
-		memset(&nic_data->stats, 0, sizeof(nic_device_stats_t));
+		memset(nic_data->stats, 0, sizeof(nic_device_stats_t));
 		fibril_rwlock_write_unlock(&nic_data->stats_lock);
 
 		fibril_rwlock_write_lock(&nic_data->rxc_lock);
@@ -241,11 +243,31 @@ errno_t nic_get_stats_impl(ddf_fun_t *fun, nic_device_stats_t *stats)
 	nic_t *nic_data = nic_get_from_ddf_fun(fun);
 	assert (stats != NULL);
 	fibril_rwlock_read_lock(&nic_data->stats_lock);
-	memcpy(stats, &nic_data->stats, sizeof (nic_device_stats_t));
+	memcpy(stats, nic_data->stats, sizeof(nic_device_stats_t));
 	fibril_rwlock_read_unlock(&nic_data->stats_lock);
 	return EOK;
 }
 
+/** Default implementation of the stats_share operation.
+ *
+ * Exposes the NIC's statistics area for read-only mapping by the
+ * client.
+ *
+ * @param fun   The DDF function
+ * @param area  Place to store the address of the statistics area
+ * @param size  Place to store the size of the statistics area
+ *
+ * @return EOK
+ */
+errno_t nic_stats_share_impl(ddf_fun_t *fun, void **area, size_t *size)
+{
+	nic_t *nic_data = nic_get_from_ddf_fun(fun);
+
+	*area = nic_data->stats;
+	*size = PAGE_SIZE;
+	return EOK;
+}
+
 /**
  * Default implementation of unicast_get_mode method.
  *
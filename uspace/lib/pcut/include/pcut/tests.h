@@ -396,6 +396,14 @@
 
 int pcut_main(pcut_item_t *last, int argc, char *argv[]);
 
+/** Whether tests are running inside a persistent batch worker.
+ *
+ * In batch mode one worker task executes many tests, so suite
+ * fixtures may cache expensive state (e.g. prepared file system
+ * images) in statics and consult this to skip rebuilding it.
+ */
+int pcut_is_running_batched(void);
+
 /** Insert code to run all the tests.
  *
  * @param number Item number.
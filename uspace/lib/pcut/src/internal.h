@@ -83,8 +83,17 @@
  */
 #define PCUT_RUN_MODE_SINGLE 2
 
+/** Run tests in batches: one worker task per suite, respawned
+ * past a crashing test. */
+#define PCUT_RUN_MODE_BATCH 3
+
 extern int pcut_run_mode;
 
+extern int pcut_run_suite_batched(const char *self_path, pcut_item_t *suite,
+	pcut_item_t **last);
+extern int pcut_run_test_worker(pcut_item_t *test);
+extern int pcut_batch_worker;
+
 
 pcut_item_t *pcut_fix_list_get_real_head(pcut_item_t *last);
 int pcut_count_tests(pcut_item_t *it);
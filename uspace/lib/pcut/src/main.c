@@ -95,12 +95,30 @@ static pcut_item_t *pcut_find_by_id(pcut_item_t *first, int id) {
  * @param prog_path Path to the current binary (used in forked mode).
  * @return Error code.
  */
+/** Non-zero when this task is a persistent batch worker.
+ *
+ * Suite fixtures can consult pcut_is_running_batched() and keep
+ * expensive state (prepared images etc.) in statics across the
+ * tests of one worker.
+ */
+int pcut_batch_worker = 0;
+
+int pcut_is_running_batched(void) {
+	return pcut_batch_worker;
+}
+
 static int run_suite(pcut_item_t *suite, pcut_item_t **last, const char *prog_path) {
 	int is_first_test = 1;
 	int total_count = 0;
 	int ret_code = PCUT_OUTCOME_PASS;
 	int ret_code_tmp;
 
+#ifdef __HELENOS__
+	if (pcut_run_mode == PCUT_RUN_MODE_BATCH) {
+		return pcut_run_suite_batched(prog_path, suite, last);
+	}
+#endif
+
 	pcut_item_t *it = pcut_get_real_next(suite);
 	if ((it == NULL) || (it->kind == PCUT_KIND_TESTSUITE)) {
 		goto leave_no_print;
@@ -199,6 +217,11 @@ int pcut_main(pcut_item_t *last, int argc, char *argv[]) {
 
 	int run_only_suite = -1;
 	int run_only_test = -1;
+	int batch_suite = -1;
+	int batch_resume_after = -1;
+
+	(void) batch_suite;
+	(void) batch_resume_after;
 
 	int rc, rc_tmp;
 
@@ -233,6 +256,13 @@ int pcut_main(pcut_item_t *last, int argc, char *argv[]) {
 			if (pcut_str_equals(argv[i], "-u")) {
 				pcut_run_mode = PCUT_RUN_MODE_SINGLE;
 			}
+#endif
+#ifdef __HELENOS__
+			if (pcut_str_equals(argv[i], "-b")) {
+				pcut_run_mode = PCUT_RUN_MODE_BATCH;
+			}
+			pcut_is_arg_with_number(argv[i], "-w", &batch_suite);
+			pcut_is_arg_with_number(argv[i], "-f", &batch_resume_after);
 #endif
 		}
 	}
@@ -248,6 +278,41 @@ int pcut_main(pcut_item_t *last, int argc, char *argv[]) {
 
 	PCUT_DEBUG("run_only_suite = %d   run_only_test = %d", run_only_suite, run_only_test);
 
+#ifdef __HELENOS__
+	if (batch_suite > 0) {
+		/*
+		 * Batch worker: execute the suite's tests in this
+		 * task, printing a checkpoint marker after each so
+		 * the parent knows where to resume after a crash.
+		 */
+		pcut_item_t *suite = pcut_find_by_id(items, batch_suite);
+		if ((suite == NULL) || (suite->kind != PCUT_KIND_TESTSUITE)) {
+			printf("Invalid batch suite id!\n");
+			return PCUT_OUTCOME_BAD_INVOCATION;
+		}
+
+		pcut_batch_worker = 1;
+
+		for (it = pcut_get_real_next(suite);
+		    (it != NULL) && (it->kind != PCUT_KIND_TESTSUITE);
+		    it = pcut_get_real_next(it)) {
+			if (it->kind != PCUT_KIND_TEST) {
+				continue;
+			}
+			if ((batch_resume_after >= 0) &&
+			    (it->id <= batch_resume_after)) {
+				continue;
+			}
+
+			printf("##pcut_start %d\n", it->id);
+			rc = pcut_run_test_worker(it);
+			printf("##pcut_done %d %d\n", it->id, rc);
+		}
+
+		return PCUT_OUTCOME_PASS;
+	}
+#endif
+
 	if ((run_only_suite >= 0) && (run_only_test >= 0)) {
 		printf("Specify either -s or -t!\n");
 		return PCUT_OUTCOME_BAD_INVOCATION;
@@ -223,6 +223,189 @@ leave_close_tempfile:
 	return status;
 }
 
+/** Marker lines the batch worker prints around each test. */
+#define BATCH_START_MARKER  "##pcut_start %d\n"
+#define BATCH_DONE_MARKER   "##pcut_done %d %d\n"
+
+/** Find a test's done marker in worker output.
+ *
+ * @param output Captured worker output.
+ * @param id Test id.
+ * @param rc Outcome recorded in the marker is stored here.
+ * @return Position right after the marker or NULL if not present.
+ */
+static char *batch_find_done(char *output, int id, int *rc, char **seg_end) {
+	char marker[MAX_TEST_NUMBER_WIDTH * 2];
+	snprintf(marker, sizeof(marker), "##pcut_done %d ", id);
+
+	char *pos = str_str(output, marker);
+	if (pos == NULL) {
+		return NULL;
+	}
+
+	*seg_end = pos;
+	pos += pcut_str_size(marker);
+	*rc = pcut_str_to_int(pos);
+
+	char *eol = pcut_str_find_char(pos, '\n');
+	return (eol == NULL) ? pos : (eol + 1);
+}
+
+/** Run a whole suite in batch mode.
+ *
+ * One worker task executes the suite's tests in process, writing a
+ * checkpoint marker after each test. If the worker crashes, the
+ * test without a checkpoint is reported as failed and a new worker
+ * resumes right after it, so one spawn covers many tests while a
+ * crash still only takes out the test that caused it. Because the
+ * worker persists across its tests, expensive fixtures kept in
+ * static state (e.g. prepared file system images) are built once
+ * per worker instead of once per test.
+ *
+ * @param self_path Path to the current binary.
+ * @param suite Suite to run.
+ * @param last First item after this suite is stored here.
+ * @return Outcome of the suite.
+ */
+int pcut_run_suite_batched(const char *self_path, pcut_item_t *suite,
+    pcut_item_t **last) {
+	int ret_code = PCUT_OUTCOME_PASS;
+	int resume_after = -1;
+	int done_anything = 0;
+
+	/* Locate the end of the suite for the caller. */
+	pcut_item_t *it = pcut_get_real_next(suite);
+	while ((it != NULL) && (it->kind != PCUT_KIND_TESTSUITE)) {
+		if (it->kind == PCUT_KIND_TEST) {
+			done_anything = 1;
+		}
+		it = pcut_get_real_next(it);
+	}
+	if (last != NULL) {
+		*last = it;
+	}
+	if (!done_anything) {
+		return ret_code;
+	}
+
+	pcut_report_suite_start(suite);
+
+	while (1) {
+		char tempfile_name[PCUT_TEMP_FILENAME_BUFFER_SIZE];
+		snprintf(tempfile_name, PCUT_TEMP_FILENAME_BUFFER_SIZE - 1,
+		    "pcut_%lld.tmp", (unsigned long long) task_get_id());
+		int tempfile;
+		errno_t rc = vfs_lookup_open(tempfile_name,
+		    WALK_REGULAR | WALK_MAY_CREATE, MODE_READ | MODE_WRITE,
+		    &tempfile);
+		if (rc != EOK) {
+			return PCUT_OUTCOME_INTERNAL_ERROR;
+		}
+
+		char suite_argument[MAX_TEST_NUMBER_WIDTH];
+		char resume_argument[MAX_TEST_NUMBER_WIDTH];
+		snprintf(suite_argument, MAX_TEST_NUMBER_WIDTH, "-w%d",
+		    suite->id);
+		snprintf(resume_argument, MAX_TEST_NUMBER_WIDTH, "-f%d",
+		    resume_after);
+
+		const char *const arguments[4] = {
+			self_path,
+			suite_argument,
+			resume_argument,
+			NULL
+		};
+
+		task_exit_t task_exit = TASK_EXIT_UNEXPECTED;
+		int task_retval = 1;
+		task_wait_t batch_task_wait;
+		task_id_t batch_task_id;
+		rc = task_spawnvf(&batch_task_id, &batch_task_wait, self_path,
+		    arguments, fileno(stdin), tempfile, tempfile);
+		if (rc != EOK) {
+			vfs_put(tempfile);
+			vfs_unlink_path(tempfile_name);
+			return PCUT_OUTCOME_INTERNAL_ERROR;
+		}
+
+		rc = task_wait(&batch_task_wait, &task_exit, &task_retval);
+		if (rc != EOK) {
+			vfs_put(tempfile);
+			vfs_unlink_path(tempfile_name);
+			return PCUT_OUTCOME_INTERNAL_ERROR;
+		}
+
+		memset(extra_output_buffer, 0, OUTPUT_BUFFER_SIZE);
+		aoff64_t pos = 0;
+		size_t nread;
+		vfs_read(tempfile, &pos, extra_output_buffer,
+		    OUTPUT_BUFFER_SIZE - 1, &nread);
+		vfs_put(tempfile);
+		vfs_unlink_path(tempfile_name);
+
+		/* Report the checkpointed tests. */
+		int crashed_id = -1;
+		char *output = extra_output_buffer;
+
+		for (it = pcut_get_real_next(suite);
+		    (it != NULL) && (it->kind != PCUT_KIND_TESTSUITE);
+		    it = pcut_get_real_next(it)) {
+			if (it->kind != PCUT_KIND_TEST) {
+				continue;
+			}
+			if ((resume_after >= 0) && (it->id <= resume_after)) {
+				continue;
+			}
+
+			int test_rc;
+			char *seg_end = NULL;
+			char *next = batch_find_done(output, it->id, &test_rc,
+			    &seg_end);
+
+			pcut_report_test_start(it);
+			if (next != NULL) {
+				if (test_rc != PCUT_OUTCOME_PASS) {
+					ret_code = PCUT_OUTCOME_FAIL;
+				}
+
+				/* Report only this test's output. */
+				char saved = *seg_end;
+				*seg_end = 0;
+				pcut_report_test_done_unparsed(it, test_rc,
+				    output, pcut_str_size(output));
+				*seg_end = saved;
+
+				output = next;
+			} else if (task_exit == TASK_EXIT_UNEXPECTED) {
+				/* The test without a checkpoint crashed. */
+				pcut_report_test_done(it, PCUT_OUTCOME_FAIL,
+				    "Test crashed the worker task.", NULL,
+				    output);
+				ret_code = PCUT_OUTCOME_FAIL;
+				crashed_id = it->id;
+				break;
+			} else {
+				pcut_report_test_done(it,
+				    PCUT_OUTCOME_INTERNAL_ERROR,
+				    "Worker finished without running the test.",
+				    NULL, NULL);
+				ret_code = PCUT_OUTCOME_FAIL;
+			}
+		}
+
+		if (crashed_id < 0) {
+			break;
+		}
+
+		/* Respawn the worker past the crashing test. */
+		resume_after = crashed_id;
+	}
+
+	pcut_report_suite_done(suite);
+
+	return ret_code;
+}
+
 void pcut_hook_before_test(pcut_item_t *test) {
 	PCUT_UNUSED(test);
 
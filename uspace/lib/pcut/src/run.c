@@ -259,6 +259,32 @@ int pcut_run_test_forked(pcut_item_t *test) {
 	return rc;
 }
 
+/** Run a test inside a batch worker.
+ *
+ * Like the forked mode the result is not reported (the parent
+ * does that from the checkpoint markers), but assertion failures
+ * long-jump back instead of exiting, so the worker task survives
+ * to run the remaining tests of its batch. Real crashes take the
+ * worker down and are recovered by the parent's checkpointing.
+ *
+ * @param test Test to execute.
+ * @return Error status (zero means success).
+ */
+int pcut_run_test_worker(pcut_item_t *test) {
+	int rc;
+
+	report_test_result = 0;
+	print_test_error = 1;
+	leave_means_exit = 0;
+
+	rc = run_test(test);
+
+	current_test = NULL;
+	current_suite = NULL;
+
+	return rc;
+}
+
 /** Run a test in a single mode.
  *
  * Single mode means that the test is called in the context of the
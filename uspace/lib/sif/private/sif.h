@@ -39,6 +39,7 @@
 
 #include <adt/list.h>
 #include <adt/odict.h>
+#include <stdint.h>
 #include <stdio.h>
 
 /** SIF session */
@@ -49,13 +50,35 @@ struct sif_sess {
 	char *fname;
 	/** Root node */
 	struct sif_node *root;
+	/** Next journal node id to hand out */
+	uint64_t next_id;
+	/** Journal records since the last full write */
+	size_t journal_len;
 };
 
 /** SIF transaction */
 struct sif_trans {
 	struct sif_sess *sess;
+	/** Recorded operations (of sif_op_t) */
+	list_t ops;
 };
 
+/** One journalled operation of a transaction */
+typedef struct {
+	/** Link to trans->ops */
+	link_t lops;
+	/** Operation code (see sif.c) */
+	char op;
+	/** Affected (parent/sibling) node id */
+	uint64_t target;
+	/** Newly created node id, if any */
+	uint64_t nid;
+	/** Node type or attribute name, if any */
+	char *str1;
+	/** Attribute value, if any */
+	char *str2;
+} sif_op_t;
+
 /** SIF attribute */
 typedef struct {
 	/** Node to which this attribute belongs */
@@ -72,6 +95,8 @@ typedef struct {
 struct sif_node {
 	/** Parent node or @c NULL in case of root node */
 	struct sif_node *parent;
+	/** Journal node id */
+	uint64_t id;
 	/** Link to parent->children */
 	link_t lparent;
 	/** Node type */
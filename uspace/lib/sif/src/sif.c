@@ -70,12 +70,25 @@
 
 static errno_t sif_export_node(sif_node_t *, FILE *);
 static errno_t sif_import_node(sif_node_t *, FILE *, sif_node_t **);
+static errno_t sif_export_string(const char *, FILE *);
+static errno_t sif_import_string(FILE *, char **);
+static errno_t sif_export_full(sif_sess_t *);
+static errno_t sif_trans_record(sif_trans_t *, char, uint64_t, uint64_t,
+    const char *, const char *);
+static void sif_ops_delete(sif_trans_t *);
+static void sif_renumber(sif_node_t *, uint64_t *);
+static errno_t sif_replay(sif_sess_t *, FILE *);
 static sif_attr_t *sif_node_first_attr(sif_node_t *);
 static sif_attr_t *sif_node_next_attr(sif_attr_t *);
 static void sif_attr_delete(sif_attr_t *);
 static void *sif_attr_getkey(odlink_t *);
 static int sif_attr_cmp(void *, void *);
 
+/** Journal records triggering a full rewrite (compaction) */
+enum {
+	sif_journal_compact_threshold = 1024
+};
+
 /** Create new SIF node.
  *
  * @param parent Parent node
@@ -182,7 +195,6 @@ errno_t sif_create(const char *fname, sif_sess_t **rsess)
 {
 	sif_sess_t *sess;
 	sif_node_t *root = NULL;
-	sif_trans_t *trans = NULL;
 	errno_t rc;
 	FILE *f;
 
@@ -217,20 +229,14 @@ errno_t sif_create(const char *fname, sif_sess_t **rsess)
 	sess->f = f;
 	sess->root = root;
 
-	/* Run a dummy trasaction to marshall initial repo state to file */
-	rc = sif_trans_begin(sess, &trans);
-	if (rc != EOK)
-		goto error;
-
-	rc = sif_trans_end(trans);
+	/* Marshall initial repo state to file */
+	rc = sif_export_full(sess);
 	if (rc != EOK)
 		goto error;
 
 	*rsess = sess;
 	return EOK;
 error:
-	if (trans != NULL)
-		sif_trans_abort(trans);
 	sif_node_delete(root);
 	if (sess->fname != NULL)
 		free(sess->fname);
@@ -262,7 +268,8 @@ errno_t sif_open(const char *fname, sif_sess_t **rsess)
 		goto error;
 	}
 
-	f = fopen(fname, "r");
+	/* Read-write: transactions append journal records. */
+	f = fopen(fname, "r+");
 	if (f == NULL) {
 		rc = EIO;
 		goto error;
@@ -278,9 +285,20 @@ errno_t sif_open(const char *fname, sif_sess_t **rsess)
 	}
 
 	sess->root = root;
-
 	sess->f = f;
-	sess->root = root;
+
+	/*
+	 * Ids are assigned in export order, so re-deriving them
+	 * after import addresses the same nodes the journal records
+	 * were written against.
+	 */
+	sess->next_id = 1;
+	sif_renumber(root, &sess->next_id);
+
+	rc = sif_replay(sess, f);
+	if (rc != EOK)
+		goto error;
+
 	*rsess = sess;
 	return EOK;
 error:
@@ -382,6 +400,285 @@ const char *sif_node_get_attr(sif_node_t *node, const char *aname)
 	return attr->avalue;
 }
 
+/** Assign journal ids to a subtree in export order.
+ *
+ * @param node Subtree root
+ * @param next Id counter, incremented per node
+ */
+static void sif_renumber(sif_node_t *node, uint64_t *next)
+{
+	sif_node_t *child;
+
+	node->id = (*next)++;
+
+	child = sif_node_first_child(node);
+	while (child != NULL) {
+		sif_renumber(child, next);
+		child = sif_node_next_child(child);
+	}
+}
+
+/** Find a node by journal id.
+ *
+ * @param node Subtree to search
+ * @param id Id to find
+ * @return Node or @c NULL
+ */
+static sif_node_t *sif_node_by_id(sif_node_t *node, uint64_t id)
+{
+	sif_node_t *child;
+	sif_node_t *found;
+
+	if (node->id == id)
+		return node;
+
+	child = sif_node_first_child(node);
+	while (child != NULL) {
+		found = sif_node_by_id(child, id);
+		if (found != NULL)
+			return found;
+
+		child = sif_node_next_child(child);
+	}
+
+	return NULL;
+}
+
+/** Import a decimal number from file.
+ *
+ * @param f File
+ * @param rnum Place to store the number
+ * @return EOK on success, EIO on I/O or format error
+ */
+static errno_t sif_import_number(FILE *f, uint64_t *rnum)
+{
+	uint64_t num = 0;
+	bool any = false;
+	int c;
+
+	c = fgetc(f);
+	while (c == ' ')
+		c = fgetc(f);
+
+	while (c >= '0' && c <= '9') {
+		num = num * 10 + (c - '0');
+		any = true;
+		c = fgetc(f);
+	}
+
+	if (!any)
+		return EIO;
+
+	if (c != EOF)
+		ungetc(c, f);
+
+	*rnum = num;
+	return EOK;
+}
+
+/** Replay journal records following the base tree image.
+ *
+ * @param sess SIF session
+ * @param f Repository file positioned after the base image
+ * @return EOK on success or error code
+ */
+static errno_t sif_replay(sif_sess_t *sess, FILE *f)
+{
+	errno_t rc;
+
+	while (true) {
+		int c = fgetc(f);
+		while (c == '\n' || c == ' ')
+			c = fgetc(f);
+
+		if (c == EOF)
+			break;
+
+		uint64_t target;
+		uint64_t nid = 0;
+		char *str1 = NULL;
+		char *str2 = NULL;
+		sif_node_t *node;
+		sif_node_t *nnode;
+
+		rc = sif_import_number(f, &target);
+		if (rc != EOK)
+			return rc;
+
+		if (c == 'A' || c == 'P' || c == 'B' || c == 'F') {
+			rc = sif_import_number(f, &nid);
+			if (rc != EOK)
+				return rc;
+		}
+
+		if (c != 'D') {
+			(void) fgetc(f); /* separating space */
+			rc = sif_import_string(f, &str1);
+			if (rc != EOK)
+				return rc;
+		}
+
+		if (c == 'S') {
+			rc = sif_import_string(f, &str2);
+			if (rc != EOK) {
+				free(str1);
+				return rc;
+			}
+		}
+
+		node = sif_node_by_id(sess->root, target);
+		if (node == NULL) {
+			free(str1);
+			free(str2);
+			return EIO;
+		}
+
+		rc = EOK;
+		switch (c) {
+		case 'A':
+		case 'P':
+		case 'B':
+		case 'F':
+			nnode = sif_node_new((c == 'A' || c == 'P') ?
+			    node : node->parent);
+			if (nnode == NULL) {
+				rc = ENOMEM;
+				break;
+			}
+
+			nnode->ntype = str1;
+			str1 = NULL;
+			nnode->id = nid;
+			if (nid >= sess->next_id)
+				sess->next_id = nid + 1;
+
+			if (c == 'A')
+				list_append(&nnode->lparent, &node->children);
+			else if (c == 'P')
+				list_prepend(&nnode->lparent, &node->children);
+			else if (c == 'B')
+				list_insert_before(&nnode->lparent,
+				    &node->lparent);
+			else
+				list_insert_after(&nnode->lparent,
+				    &node->lparent);
+			break;
+		case 'S':
+			rc = sif_node_set_attr(NULL, node, str1, str2);
+			break;
+		case 'U':
+			sif_node_unset_attr(NULL, node, str1);
+			break;
+		case 'D':
+			list_remove(&node->lparent);
+			sif_node_delete(node);
+			break;
+		default:
+			rc = EIO;
+		}
+
+		free(str1);
+		free(str2);
+
+		if (rc != EOK)
+			return rc;
+
+		sess->journal_len++;
+	}
+
+	return EOK;
+}
+
+/** Record one operation in a transaction.
+ *
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static errno_t sif_trans_record(sif_trans_t *trans, char op, uint64_t target,
+    uint64_t nid, const char *str1, const char *str2)
+{
+	sif_op_t *rec;
+
+	rec = calloc(1, sizeof(sif_op_t));
+	if (rec == NULL)
+		return ENOMEM;
+
+	rec->op = op;
+	rec->target = target;
+	rec->nid = nid;
+
+	if (str1 != NULL) {
+		rec->str1 = str_dup(str1);
+		if (rec->str1 == NULL) {
+			free(rec);
+			return ENOMEM;
+		}
+	}
+
+	if (str2 != NULL) {
+		rec->str2 = str_dup(str2);
+		if (rec->str2 == NULL) {
+			free(rec->str1);
+			free(rec);
+			return ENOMEM;
+		}
+	}
+
+	link_initialize(&rec->lops);
+	list_append(&rec->lops, &trans->ops);
+	return EOK;
+}
+
+/** Free all recorded operations of a transaction */
+static void sif_ops_delete(sif_trans_t *trans)
+{
+	link_t *link;
+
+	while ((link = list_first(&trans->ops)) != NULL) {
+		sif_op_t *rec = list_get_instance(link, sif_op_t, lops);
+
+		list_remove(link);
+		free(rec->str1);
+		free(rec->str2);
+		free(rec);
+	}
+}
+
+/** Write the full repository image, renumbering the nodes.
+ *
+ * This doubles as journal compaction: the journal is folded into
+ * the base image and starts empty again.
+ *
+ * @param sess SIF session
+ * @return EOK on success or error code
+ */
+static errno_t sif_export_full(sif_sess_t *sess)
+{
+	errno_t rc;
+
+	if (sess->f != NULL)
+		(void) fclose(sess->f);
+
+	sess->f = fopen(sess->fname, "w");
+	if (sess->f == NULL)
+		return EIO;
+
+	sess->next_id = 1;
+	sif_renumber(sess->root, &sess->next_id);
+
+	rc = sif_export_node(sess->root, sess->f);
+	if (rc != EOK)
+		return rc;
+
+	if (fputc('\n', sess->f) == EOF)
+		return EIO;
+
+	if (fflush(sess->f) == EOF)
+		return EIO;
+
+	sess->journal_len = 0;
+	return EOK;
+}
+
 /** Begin SIF transaction.
  *
  * @param trans Transaction
@@ -396,11 +693,17 @@ errno_t sif_trans_begin(sif_sess_t *sess, sif_trans_t **rtrans)
 		return ENOMEM;
 
 	trans->sess = sess;
+	list_initialize(&trans->ops);
 	*rtrans = trans;
 	return EOK;
 }
 
 /** Commit SIF transaction.
+ *
+ * The recorded operations are appended to the repository's journal
+ * so the commit cost tracks the size of the change, not of the
+ * repository; once the journal grows past a threshold it is folded
+ * into a freshly written base image.
  *
  * Commit and free the transaction. If an error is returned, that means
  * the transaction has not been freed (and sif_trans_abort() must be used).
@@ -410,24 +713,59 @@ errno_t sif_trans_begin(sif_sess_t *sess, sif_trans_t **rtrans)
  */
 errno_t sif_trans_end(sif_trans_t *trans)
 {
+	sif_sess_t *sess = trans->sess;
 	errno_t rc;
 
-	(void) fclose(trans->sess->f);
+	if (sess->journal_len + list_count(&trans->ops) >
+	    sif_journal_compact_threshold) {
+		rc = sif_export_full(sess);
+		if (rc != EOK)
+			return rc;
 
-	trans->sess->f = fopen(trans->sess->fname, "w");
-	if (trans->sess->f == NULL)
+		sif_ops_delete(trans);
+		free(trans);
+		return EOK;
+	}
+
+	if (fseek(sess->f, 0, SEEK_END) < 0)
 		return EIO;
 
-	rc = sif_export_node(trans->sess->root, trans->sess->f);
-	if (rc != EOK)
-		return rc;
+	list_foreach(trans->ops, lops, sif_op_t, rec) {
+		if (fprintf(sess->f, "%c %llu", rec->op,
+		    (unsigned long long) rec->target) < 0)
+			return EIO;
 
-	if (fputc('\n', trans->sess->f) == EOF)
-		return EIO;
+		if (rec->op == 'A' || rec->op == 'P' || rec->op == 'B' ||
+		    rec->op == 'F') {
+			if (fprintf(sess->f, " %llu",
+			    (unsigned long long) rec->nid) < 0)
+				return EIO;
+		}
 
-	if (fflush(trans->sess->f) == EOF)
+		if (rec->str1 != NULL) {
+			if (fputc(' ', sess->f) == EOF)
+				return EIO;
+			rc = sif_export_string(rec->str1, sess->f);
+			if (rc != EOK)
+				return rc;
+		}
+
+		if (rec->str2 != NULL) {
+			rc = sif_export_string(rec->str2, sess->f);
+			if (rc != EOK)
+				return rc;
+		}
+
+		if (fputc('\n', sess->f) == EOF)
+			return EIO;
+
+		sess->journal_len++;
+	}
+
+	if (fflush(sess->f) == EOF)
 		return EIO;
 
+	sif_ops_delete(trans);
 	free(trans);
 	return EOK;
 }
@@ -438,6 +776,7 @@ errno_t sif_trans_end(sif_trans_t *trans)
  */
 void sif_trans_abort(sif_trans_t *trans)
 {
+	sif_ops_delete(trans);
 	free(trans);
 }
 
@@ -457,6 +796,7 @@ errno_t sif_node_prepend_child(sif_trans_t *trans, sif_node_t *parent,
     const char *ctype, sif_node_t **rchild)
 {
 	sif_node_t *child;
+	errno_t rc;
 
 	child = sif_node_new(parent);
 	if (child == NULL)
@@ -468,6 +808,14 @@ errno_t sif_node_prepend_child(sif_trans_t *trans, sif_node_t *parent,
 		return ENOMEM;
 	}
 
+	child->id = trans->sess->next_id++;
+
+	rc = sif_trans_record(trans, 'P', parent->id, child->id, ctype, NULL);
+	if (rc != EOK) {
+		sif_node_delete(child);
+		return rc;
+	}
+
 	list_prepend(&child->lparent, &parent->children);
 
 	*rchild = child;
@@ -489,6 +837,7 @@ errno_t sif_node_append_child(sif_trans_t *trans, sif_node_t *parent,
     const char *ctype, sif_node_t **rchild)
 {
 	sif_node_t *child;
+	errno_t rc;
 
 	child = sif_node_new(parent);
 	if (child == NULL)
@@ -500,6 +849,14 @@ errno_t sif_node_append_child(sif_trans_t *trans, sif_node_t *parent,
 		return ENOMEM;
 	}
 
+	child->id = trans->sess->next_id++;
+
+	rc = sif_trans_record(trans, 'A', parent->id, child->id, ctype, NULL);
+	if (rc != EOK) {
+		sif_node_delete(child);
+		return rc;
+	}
+
 	list_append(&child->lparent, &parent->children);
 
 	*rchild = child;
@@ -521,6 +878,7 @@ errno_t sif_node_insert_before(sif_trans_t *trans, sif_node_t *sibling,
     const char *ctype, sif_node_t **rchild)
 {
 	sif_node_t *child;
+	errno_t rc;
 
 	child = sif_node_new(sibling->parent);
 	if (child == NULL)
@@ -532,6 +890,14 @@ errno_t sif_node_insert_before(sif_trans_t *trans, sif_node_t *sibling,
 		return ENOMEM;
 	}
 
+	child->id = trans->sess->next_id++;
+
+	rc = sif_trans_record(trans, 'B', sibling->id, child->id, ctype, NULL);
+	if (rc != EOK) {
+		sif_node_delete(child);
+		return rc;
+	}
+
 	list_insert_before(&child->lparent, &sibling->lparent);
 
 	*rchild = child;
@@ -553,6 +919,7 @@ errno_t sif_node_insert_after(sif_trans_t *trans, sif_node_t *sibling,
     const char *ctype, sif_node_t **rchild)
 {
 	sif_node_t *child;
+	errno_t rc;
 
 	child = sif_node_new(sibling->parent);
 	if (child == NULL)
@@ -564,6 +931,14 @@ errno_t sif_node_insert_after(sif_trans_t *trans, sif_node_t *sibling,
 		return ENOMEM;
 	}
 
+	child->id = trans->sess->next_id++;
+
+	rc = sif_trans_record(trans, 'F', sibling->id, child->id, ctype, NULL);
+	if (rc != EOK) {
+		sif_node_delete(child);
+		return rc;
+	}
+
 	list_insert_after(&child->lparent, &sibling->lparent);
 
 	*rchild = child;
@@ -580,6 +955,9 @@ errno_t sif_node_insert_after(sif_trans_t *trans, sif_node_t *sibling,
  */
 void sif_node_destroy(sif_trans_t *trans, sif_node_t *node)
 {
+	if (trans != NULL)
+		(void) sif_trans_record(trans, 'D', node->id, 0, NULL, NULL);
+
 	list_remove(&node->lparent);
 	sif_node_delete(node);
 }
@@ -630,6 +1008,11 @@ errno_t sif_node_set_attr(sif_trans_t *trans, sif_node_t *node,
 		odict_insert(&attr->lattrs, &node->attrs, NULL);
 	}
 
+	/* Journal replay passes a null transaction. */
+	if (trans != NULL)
+		return sif_trans_record(trans, 'S', node->id, 0, aname,
+		    avalue);
+
 	return EOK;
 }
 
@@ -655,6 +1038,10 @@ void sif_node_unset_attr(sif_trans_t *trans, sif_node_t *node,
 	attr = odict_get_instance(link, sif_attr_t, lattrs);
 	odict_remove(link);
 	sif_attr_delete(attr);
+
+	/* Journal replay passes a null transaction. */
+	if (trans != NULL)
+		(void) sif_trans_record(trans, 'U', node->id, 0, aname, NULL);
 }
 
 /** Export string to file.
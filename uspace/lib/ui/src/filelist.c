@@ -824,26 +824,73 @@ errno_t ui_file_list_read_dir(ui_file_list_t *flist, const char *dirname)
 			goto error;
 	}
 
-	dirent = readdir(dir);
-	while (dirent != NULL) {
-		rc = vfs_stat_path(dirent->d_name, &finfo);
+	/*
+	 * Enumerate with batched per-entry stat data: one exchange
+	 * per buffer instead of a path walk and stat per entry.
+	 * Fall back to readdir plus stat when the batched operation
+	 * is not available.
+	 */
+	aoff64_t pos = 0;
+	bool batched = true;
+
+	while (batched) {
+		/* Aligned for the uint64_t fields of the records */
+		uint64_t rdstore[16384 / sizeof(uint64_t)];
+		char *rdbuf = (char *) rdstore;
+		size_t nentries;
+
+		rc = vfs_read_dirents_stat(dirfd(dir), &pos, rdbuf,
+		    sizeof(rdstore), &nentries);
 		if (rc != EOK) {
-			/* Possibly a stale entry */
-			dirent = readdir(dir);
-			continue;
+			batched = false;
+			break;
 		}
 
-		ui_file_list_entry_attr_init(&attr);
-		attr.name = dirent->d_name;
-		attr.size = finfo.size;
-		attr.isdir = finfo.is_directory;
-		attr.svc = finfo.service;
+		if (nentries == 0)
+			break;
 
-		rc = ui_file_list_entry_append(flist, &attr);
-		if (rc != EOK)
-			goto error;
+		size_t off = 0;
+		size_t i;
+		for (i = 0; i < nentries; i++) {
+			vfs_dirent_stat_t *rec =
+			    (vfs_dirent_stat_t *) (rdbuf + off);
+
+			ui_file_list_entry_attr_init(&attr);
+			attr.name = rec->name;
+			attr.size = rec->size;
+			attr.isdir = rec->is_directory;
+			attr.svc = rec->service;
 
+			rc = ui_file_list_entry_append(flist, &attr);
+			if (rc != EOK)
+				goto error;
+
+			off += VFS_DIRENT_STAT_RECSZ(str_size(rec->name) + 1);
+		}
+	}
+
+	if (!batched) {
 		dirent = readdir(dir);
+		while (dirent != NULL) {
+			rc = vfs_stat_path(dirent->d_name, &finfo);
+			if (rc != EOK) {
+				/* Possibly a stale entry */
+				dirent = readdir(dir);
+				continue;
+			}
+
+			ui_file_list_entry_attr_init(&attr);
+			attr.name = dirent->d_name;
+			attr.size = finfo.size;
+			attr.isdir = finfo.is_directory;
+			attr.svc = finfo.service;
+
+			rc = ui_file_list_entry_append(flist, &attr);
+			if (rc != EOK)
+				goto error;
+
+			dirent = readdir(dir);
+		}
 	}
 
 	closedir(dir);
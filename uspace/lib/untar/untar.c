@@ -30,16 +30,73 @@
  * @{
  */
 /** @file
+ *
+ * Extraction is pipelined: the archive is read sequentially in
+ * large chunks, small files are handed to writer fibrils (running
+ * on multiple threads) that create them in parallel, and large
+ * files are streamed with double-buffered write-behind through the
+ * asynchronous VFS API, so reading the next chunk overlaps writing
+ * the previous one.
  */
 
+#include <adt/list.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <str.h>
 #include <str_error.h>
+#include <vfs/aio.h>
 #include <vfs/vfs.h>
 #include "private/tar.h"
 #include "untar.h"
 
+/** Number of writer fibrils creating small files */
+#define UNTAR_WRITERS  4
+
+/** Queued jobs cap */
+#define UNTAR_QUEUE_MAX_JOBS  16
+
+/** Queued payload bytes cap */
+#define UNTAR_QUEUE_MAX_BYTES  (4 * 1024 * 1024)
+
+/** Files larger than this are streamed instead of queued */
+#define UNTAR_STREAM_THRESHOLD  (256 * 1024)
+
+/** Streaming chunk size (whole blocks) */
+#define UNTAR_CHUNK_SIZE  (128 * 1024)
+
+/** One small file handed over to a writer fibril */
+typedef struct {
+	link_t link;
+	char *path;
+	uint8_t *data;
+	size_t size;
+} untar_job_t;
+
+/** State shared between the reader and the writer fibrils */
+typedef struct {
+	tar_file_t *tar;
+
+	list_t jobs;
+	size_t njobs;
+	size_t nbytes;
+	/** No more jobs will be pushed */
+	bool closed;
+	/** Writer fibrils still running */
+	size_t writers;
+	/** First error encountered by a writer */
+	errno_t rc;
+
+	fibril_mutex_t lock;
+	/** Signalled when jobs arrive or the queue closes */
+	fibril_condvar_t job_cv;
+	/** Signalled when queue space frees up or a writer exits */
+	fibril_condvar_t space_cv;
+} untar_queue_t;
+
 static size_t get_block_count(size_t bytes)
 {
 	return (bytes + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE;
@@ -86,52 +143,273 @@ static errno_t tar_skip_blocks(tar_file_t *tar, size_t valid_data_size)
 	return EOK;
 }
 
-static errno_t tar_handle_normal_file(tar_file_t *tar,
-    const tar_header_t *header)
+/** Create (or truncate) and fill one target file */
+static errno_t untar_write_file(const char *path, const uint8_t *data,
+    size_t size)
+{
+	int fd;
+	errno_t rc = vfs_lookup_open(path, WALK_REGULAR | WALK_MAY_CREATE,
+	    MODE_WRITE, &fd);
+	if (rc != EOK)
+		return rc;
+
+	rc = vfs_resize(fd, 0);
+	if (rc != EOK) {
+		vfs_put(fd);
+		return rc;
+	}
+
+	aoff64_t pos = 0;
+	size_t written = 0;
+
+	while (written < size) {
+		size_t now;
+		rc = vfs_write(fd, &pos, data + written, size - written, &now);
+		if ((rc == EOK) && (now == 0))
+			rc = EIO;
+		if (rc != EOK) {
+			vfs_put(fd);
+			return rc;
+		}
+
+		written += now;
+	}
+
+	vfs_put(fd);
+	return EOK;
+}
+
+static void untar_job_destroy(untar_job_t *job)
 {
-	// FIXME: create the directory first
+	free(job->path);
+	free(job->data);
+	free(job);
+}
+
+/** Writer fibril: create queued files until the queue drains */
+static errno_t untar_writer_fibril(void *arg)
+{
+	untar_queue_t *queue = (untar_queue_t *) arg;
+
+	fibril_detach(fibril_get_id());
+
+	while (true) {
+		fibril_mutex_lock(&queue->lock);
+
+		while (list_empty(&queue->jobs) && !queue->closed)
+			fibril_condvar_wait(&queue->job_cv, &queue->lock);
+
+		link_t *link = list_first(&queue->jobs);
+		if (link == NULL) {
+			/* Closed and drained */
+			queue->writers--;
+			fibril_condvar_broadcast(&queue->space_cv);
+			fibril_mutex_unlock(&queue->lock);
+			break;
+		}
+
+		list_remove(link);
+		untar_job_t *job = list_get_instance(link, untar_job_t, link);
+		queue->njobs--;
+		queue->nbytes -= job->size;
+		fibril_condvar_signal(&queue->space_cv);
+		fibril_mutex_unlock(&queue->lock);
+
+		errno_t rc = untar_write_file(job->path, job->data, job->size);
+		if (rc != EOK) {
+			fibril_mutex_lock(&queue->lock);
+			if (queue->rc == EOK)
+				queue->rc = rc;
+			fibril_mutex_unlock(&queue->lock);
+
+			tar_report(queue->tar, "Failed to write %s: %s.\n",
+			    job->path, str_error(rc));
+		}
+
+		untar_job_destroy(job);
+	}
+
+	return EOK;
+}
+
+/** Queue a small file for a writer fibril, waiting for queue space */
+static void untar_queue_push(untar_queue_t *queue, untar_job_t *job)
+{
+	fibril_mutex_lock(&queue->lock);
+
+	while ((queue->njobs >= UNTAR_QUEUE_MAX_JOBS) ||
+	    ((queue->nbytes > 0) &&
+	    (queue->nbytes + job->size > UNTAR_QUEUE_MAX_BYTES)))
+		fibril_condvar_wait(&queue->space_cv, &queue->lock);
+
+	list_append(&job->link, &queue->jobs);
+	queue->njobs++;
+	queue->nbytes += job->size;
+	fibril_condvar_signal(&queue->job_cv);
+
+	fibril_mutex_unlock(&queue->lock);
+}
+
+/** Close the queue and wait for the writers to drain it */
+static errno_t untar_queue_finish(untar_queue_t *queue)
+{
+	fibril_mutex_lock(&queue->lock);
+
+	queue->closed = true;
+	fibril_condvar_broadcast(&queue->job_cv);
+
+	while (queue->writers > 0)
+		fibril_condvar_wait(&queue->space_cv, &queue->lock);
+
+	errno_t rc = queue->rc;
+	fibril_mutex_unlock(&queue->lock);
 
-	FILE *file = fopen(header->filename, "wb");
-	if (file == NULL) {
+	return rc;
+}
+
+/** Stream a large file with double-buffered write-behind */
+static errno_t tar_stream_large_file(tar_file_t *tar,
+    const tar_header_t *header)
+{
+	int fd;
+	errno_t rc = vfs_lookup_open(header->filename,
+	    WALK_REGULAR | WALK_MAY_CREATE, MODE_WRITE, &fd);
+	if (rc != EOK) {
 		tar_report(tar, "Failed to create %s: %s.\n", header->filename,
-		    str_error(errno));
-		return errno;
+		    str_error(rc));
+		return rc;
 	}
 
-	errno_t rc = EOK;
-	size_t bytes_remaining = header->size;
-	size_t blocks = get_block_count(bytes_remaining);
+	rc = vfs_resize(fd, 0);
+	if (rc != EOK) {
+		vfs_put(fd);
+		return rc;
+	}
+
+	uint8_t *bufs[2];
+	bufs[0] = malloc(UNTAR_CHUNK_SIZE);
+	bufs[1] = malloc(UNTAR_CHUNK_SIZE);
+	if ((bufs[0] == NULL) || (bufs[1] == NULL)) {
+		free(bufs[0]);
+		free(bufs[1]);
+		vfs_put(fd);
+		return ENOMEM;
+	}
+
+	vfs_aio_req_t req;
+	bool pending = false;
+
+	size_t remaining = header->size;
+	size_t blocks = get_block_count(remaining);
+	aoff64_t pos = 0;
+	unsigned cur = 0;
 
 	while (blocks > 0) {
-		uint8_t block[TAR_BLOCK_SIZE];
-		size_t actually_read = tar_read(tar, block, TAR_BLOCK_SIZE);
-		if (actually_read != TAR_BLOCK_SIZE) {
+		size_t chunk_blocks = UNTAR_CHUNK_SIZE / TAR_BLOCK_SIZE;
+		if (chunk_blocks > blocks)
+			chunk_blocks = blocks;
+
+		size_t to_read = chunk_blocks * TAR_BLOCK_SIZE;
+		if (tar_read(tar, bufs[cur], to_read) != to_read) {
 			rc = errno;
 			tar_report(tar, "Failed to read block for %s: %s.\n",
 			    header->filename, str_error(rc));
 			break;
 		}
 
-		size_t to_write = TAR_BLOCK_SIZE;
-		if (bytes_remaining < TAR_BLOCK_SIZE)
-			to_write = bytes_remaining;
+		size_t to_write = remaining;
+		if (to_write > to_read)
+			to_write = to_read;
 
-		size_t actually_written = fwrite(block, 1, to_write, file);
-		if (actually_written != to_write) {
-			rc = errno;
-			tar_report(tar, "Failed to write to %s: %s.\n",
-			    header->filename, str_error(rc));
-			break;
+		/*
+		 * Wait for the previous chunk before its buffer is
+		 * reused; reading this chunk already overlapped it.
+		 */
+		if (pending) {
+			rc = vfs_aio_wait(&req);
+			pending = false;
+
+			if ((rc == EOK) && (req.ntransferred != req.nbytes))
+				rc = EIO;
+			if (rc != EOK) {
+				tar_report(tar, "Failed to write to %s: %s.\n",
+				    header->filename, str_error(rc));
+				break;
+			}
 		}
 
-		blocks--;
-		bytes_remaining -= TAR_BLOCK_SIZE;
+		rc = vfs_aio_write(&req, fd, pos, bufs[cur], to_write);
+		if (rc != EOK)
+			break;
+		pending = true;
+
+		pos += to_write;
+		remaining -= to_write;
+		blocks -= chunk_blocks;
+		cur ^= 1;
 	}
 
-	fclose(file);
+	if (pending) {
+		errno_t wrc = vfs_aio_wait(&req);
+		if ((wrc == EOK) && (req.ntransferred != req.nbytes))
+			wrc = EIO;
+		if ((rc == EOK) && (wrc != EOK)) {
+			tar_report(tar, "Failed to write to %s: %s.\n",
+			    header->filename, str_error(wrc));
+			rc = wrc;
+		}
+	}
+
+	free(bufs[0]);
+	free(bufs[1]);
+	vfs_put(fd);
 	return rc;
 }
 
+static errno_t tar_handle_normal_file(tar_file_t *tar, untar_queue_t *queue,
+    const tar_header_t *header)
+{
+	if (header->size > UNTAR_STREAM_THRESHOLD)
+		return tar_stream_large_file(tar, header);
+
+	/* Small file: read the payload and hand it to a writer. */
+	size_t blocks = get_block_count(header->size);
+	size_t padded = blocks * TAR_BLOCK_SIZE;
+
+	untar_job_t *job = malloc(sizeof(untar_job_t));
+	uint8_t *data = (padded > 0) ? malloc(padded) : NULL;
+	char *path = str_dup(header->filename);
+
+	if ((job == NULL) || (path == NULL) ||
+	    ((padded > 0) && (data == NULL))) {
+		free(job);
+		free(data);
+		free(path);
+		return ENOMEM;
+	}
+
+	if (padded > 0) {
+		size_t actually_read = tar_read(tar, data, padded);
+		if (actually_read != padded) {
+			errno_t rc = errno;
+			tar_report(tar, "Failed to read block for %s: %s.\n",
+			    header->filename, str_error(rc));
+			free(job);
+			free(data);
+			free(path);
+			return rc;
+		}
+	}
+
+	link_initialize(&job->link);
+	job->path = path;
+	job->data = data;
+	job->size = header->size;
+
+	untar_queue_push(queue, job);
+	return EOK;
+}
+
 static errno_t tar_handle_directory(tar_file_t *tar, const tar_header_t *header)
 {
 	errno_t rc = vfs_link_path(header->filename, KIND_DIRECTORY, NULL);
@@ -154,6 +432,33 @@ int untar(tar_file_t *tar)
 		return rc;
 	}
 
+	untar_queue_t queue;
+
+	queue.tar = tar;
+	list_initialize(&queue.jobs);
+	queue.njobs = 0;
+	queue.nbytes = 0;
+	queue.closed = false;
+	queue.writers = 0;
+	queue.rc = EOK;
+	fibril_mutex_initialize(&queue.lock);
+	fibril_condvar_initialize(&queue.job_cv);
+	fibril_condvar_initialize(&queue.space_cv);
+
+	fibril_enable_multithreaded();
+
+	size_t i;
+	for (i = 0; i < UNTAR_WRITERS; i++) {
+		fid_t fid = fibril_create(untar_writer_fibril, &queue);
+		if (fid == 0)
+			break;
+
+		queue.writers++;
+		fibril_add_ready(fid);
+	}
+
+	errno_t ret = EOK;
+
 	while (true) {
 		tar_header_raw_t header_raw;
 		size_t header_ok = tar_read(tar, &header_raw, sizeof(header_raw));
@@ -167,6 +472,7 @@ int untar(tar_file_t *tar)
 
 		if (rc != EOK) {
 			tar_report(tar, "Failed parsing TAR header: %s.\n", str_error(rc));
+			ret = rc;
 			break;
 		}
 
@@ -175,19 +481,28 @@ int untar(tar_file_t *tar)
 			rc = tar_handle_directory(tar, &header);
 			break;
 		case TAR_TYPE_NORMAL:
-			rc = tar_handle_normal_file(tar, &header);
+			if (queue.writers > 0)
+				rc = tar_handle_normal_file(tar, &queue, &header);
+			else
+				rc = tar_stream_large_file(tar, &header);
 			break;
 		default:
 			rc = tar_skip_blocks(tar, header.size);
 			break;
 		}
 
-		if (rc != EOK)
+		if (rc != EOK) {
+			ret = rc;
 			break;
+		}
 	}
 
+	rc = untar_queue_finish(&queue);
+	if (ret == EOK)
+		ret = rc;
+
 	tar_close(tar);
-	return EOK;
+	return ret;
 }
 
 /** @}
@@ -43,28 +43,41 @@
 #include "uri.h"
 #include "internal/ctype.h"
 
-static char *cut_str(const char *start, const char *end)
+static void set_view(uri_view_part_t *part, const char *start, const char *end)
 {
-	size_t size = end - start;
-	return str_ndup(start, size);
+	part->start = start;
+	part->size = end - start;
 }
 
-uri_t *uri_parse(const char *str)
+/** Duplicate a view into an allocated string, NULL views excepted */
+static char *view_dup(uri_view_part_t *part)
 {
-	uri_t *uri = malloc(sizeof(uri_t));
-	if (uri == NULL)
+	if (part->start == NULL)
 		return NULL;
-	memset(uri, 0, sizeof(uri_t));
+	return str_ndup(part->start, part->size);
+}
+
+/** Parse a URI into views into the caller's buffer.
+ *
+ * Unlike uri_parse() nothing is allocated: each component of
+ * @a view points into @a str. The buffer must stay valid (and
+ * unmodified) for as long as the views are used.
+ *
+ * @param str URI string
+ * @param view Parsed component views are stored here
+ * @return EOK on success, EINVAL when the string is not a URI
+ */
+errno_t uri_parse_view(const char *str, uri_view_t *view)
+{
+	memset(view, 0, sizeof(uri_view_t));
 
 	/* scheme ":" */
 	const char *scheme = str;
 	while (*str != 0 && *str != ':')
 		str++;
-	if (*str == 0) {
-		uri_destroy(uri);
-		return NULL;
-	}
-	uri->scheme = cut_str(scheme, str);
+	if (*str == 0)
+		return EINVAL;
+	set_view(&view->scheme, scheme, str);
 
 	/* skip the colon */
 	str++;
@@ -75,58 +88,58 @@ uri_t *uri_parse(const char *str)
 		str++;
 		const char *authority_start = str;
 
-		char *host_or_user_info = NULL;
-		char *port_or_user_credential = NULL;
+		uri_view_part_t host_or_user_info = { NULL, 0 };
+		uri_view_part_t port_or_user_credential = { NULL, 0 };
 
 		while (*str != 0 && *str != '?' && *str != '#' && *str != '@' &&
 		    *str != ':' && *str != '/')
 			str++;
 
-		host_or_user_info = cut_str(authority_start, str);
+		set_view(&host_or_user_info, authority_start, str);
 		if (*str == ':') {
 			str++;
 			const char *second_part = str;
 			while (*str != 0 && *str != '?' && *str != '#' &&
 			    *str != '@' && *str != '/')
 				str++;
-			port_or_user_credential = cut_str(second_part, str);
+			set_view(&port_or_user_credential, second_part, str);
 		}
 
 		if (*str == '@') {
-			uri->user_info = host_or_user_info;
-			uri->user_credential = port_or_user_credential;
+			view->user_info = host_or_user_info;
+			view->user_credential = port_or_user_credential;
 
 			str++;
 			const char *host_start = str;
 			while (*str != 0 && *str != '?' && *str != '#' &&
 			    *str != ':' && *str != '/')
 				str++;
-			uri->host = cut_str(host_start, str);
+			set_view(&view->host, host_start, str);
 
 			if (*str == ':') {
 				str++;
 				const char *port_start = str;
 				while (*str != 0 && *str != '?' && *str != '#' && *str != '/')
 					str++;
-				uri->port = cut_str(port_start, str);
+				set_view(&view->port, port_start, str);
 			}
 		} else {
-			uri->host = host_or_user_info;
-			uri->port = port_or_user_credential;
+			view->host = host_or_user_info;
+			view->port = port_or_user_credential;
 		}
 	}
 
 	const char *path_start = str;
 	while (*str != 0 && *str != '?' && *str != '#')
 		str++;
-	uri->path = cut_str(path_start, str);
+	set_view(&view->path, path_start, str);
 
 	if (*str == '?') {
 		str++;
 		const char *query_start = str;
 		while (*str != 0 && *str != '#')
 			str++;
-		uri->query = cut_str(query_start, str);
+		set_view(&view->query, query_start, str);
 	}
 
 	if (*str == '#') {
@@ -134,10 +147,65 @@ uri_t *uri_parse(const char *str)
 		const char *fragment_start = str;
 		while (*str != 0)
 			str++;
-		uri->fragment = cut_str(fragment_start, str);
+		set_view(&view->fragment, fragment_start, str);
 	}
 
 	assert(*str == 0);
+	return EOK;
+}
+
+/** Decode percent-encoded sequences in place.
+ *
+ * Valid %XX escapes are replaced by the byte they encode; invalid
+ * sequences are kept verbatim. Decoding only ever shrinks the
+ * string, so it happens within the caller's buffer.
+ *
+ * @param str String to decode
+ * @return New string length
+ */
+size_t uri_percent_decode_inplace(char *str)
+{
+	char *rp = str;
+	char *wp = str;
+
+	while (*rp != 0) {
+		uint8_t decoded;
+		const char *endptr;
+
+		if (*rp == '%' &&
+		    uri_percent_parse(rp, &endptr, &decoded) == EOK) {
+			*wp++ = (char) decoded;
+			rp += 3;
+		} else {
+			*wp++ = *rp++;
+		}
+	}
+
+	*wp = 0;
+	return wp - str;
+}
+
+uri_t *uri_parse(const char *str)
+{
+	uri_view_t view;
+
+	if (uri_parse_view(str, &view) != EOK)
+		return NULL;
+
+	uri_t *uri = malloc(sizeof(uri_t));
+	if (uri == NULL)
+		return NULL;
+	memset(uri, 0, sizeof(uri_t));
+
+	uri->scheme = view_dup(&view.scheme);
+	uri->user_info = view_dup(&view.user_info);
+	uri->user_credential = view_dup(&view.user_credential);
+	uri->host = view_dup(&view.host);
+	uri->port = view_dup(&view.port);
+	uri->path = view_dup(&view.path);
+	uri->query = view_dup(&view.query);
+	uri->fragment = view_dup(&view.fragment);
+
 	return uri;
 }
 
@@ -36,6 +36,8 @@
 #ifndef URI_URI_H_
 #define URI_URI_H_
 
+#include <stddef.h>
+
 typedef struct {
 	char *scheme;
 	char *user_info;
@@ -47,7 +49,30 @@ typedef struct {
 	char *fragment;
 } uri_t;
 
+/** One URI component viewed within the caller's buffer.
+ *
+ * @c start is NULL when the component is absent.
+ */
+typedef struct {
+	const char *start;
+	size_t size;
+} uri_view_part_t;
+
+/** URI parsed into views into the caller's buffer (no allocation) */
+typedef struct {
+	uri_view_part_t scheme;
+	uri_view_part_t user_info;
+	uri_view_part_t user_credential;
+	uri_view_part_t host;
+	uri_view_part_t port;
+	uri_view_part_t path;
+	uri_view_part_t query;
+	uri_view_part_t fragment;
+} uri_view_t;
+
 extern uri_t *uri_parse(const char *);
+extern errno_t uri_parse_view(const char *, uri_view_t *);
+extern size_t uri_percent_decode_inplace(char *);
 extern errno_t uri_scheme_parse(const char *, const char **);
 extern bool uri_scheme_validate(const char *);
 extern errno_t uri_percent_parse(const char *, const char **, uint8_t *);
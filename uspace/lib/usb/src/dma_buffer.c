@@ -49,32 +49,52 @@ dma_policy_t dma_policy_create(unsigned flags, size_t chunk_size)
 
 /**
  * As the driver is typically using only a few buffers at once, we cache the
- * physical mapping to avoid calling the kernel unnecessarily often. This cache
- * is global for a task.
- *
- * TODO: "few" is currently limited to one.
+ * physical mappings to avoid calling the kernel unnecessarily often. This
+ * cache is global for a task. With several transfers pipelined over several
+ * endpoints, each sees its buffer's translation stay cached instead of the
+ * buffers evicting each other's single entry as before.
  */
+#define PHYS_MAPPING_CACHE_SIZE  16
+
 static struct {
-	const void *last;
+	const void *virt;
 	uintptr_t phys;
-} phys_mapping_cache = { 0 };
+} phys_mapping_cache[PHYS_MAPPING_CACHE_SIZE];
+
+static size_t phys_mapping_slot(const void *v)
+{
+	/* Chunk bases are page aligned; skip the zero low bits. */
+	return ((uintptr_t) v >> 12) % PHYS_MAPPING_CACHE_SIZE;
+}
 
 static void cache_insert(const void *v, uintptr_t p)
 {
-	phys_mapping_cache.last = v;
-	phys_mapping_cache.phys = p;
+	size_t slot = phys_mapping_slot(v);
+
+	phys_mapping_cache[slot].virt = v;
+	phys_mapping_cache[slot].phys = p;
 }
 
 static void cache_evict(const void *v)
 {
-	if (phys_mapping_cache.last == v)
-		phys_mapping_cache.last = NULL;
+	/*
+	 * The buffer being torn down may have several chunks cached
+	 * under different slots and its size is not known here, so
+	 * drop the whole cache. Teardown is rare compared to lookups
+	 * and the cache is tiny.
+	 */
+	(void) v;
+
+	for (size_t i = 0; i < PHYS_MAPPING_CACHE_SIZE; i++)
+		phys_mapping_cache[i].virt = NULL;
 }
 
 static bool cache_find(const void *v, uintptr_t *p)
 {
-	*p = phys_mapping_cache.phys;
-	return phys_mapping_cache.last == v;
+	size_t slot = phys_mapping_slot(v);
+
+	*p = phys_mapping_cache[slot].phys;
+	return phys_mapping_cache[slot].virt == v;
 }
 
 /**
@@ -181,12 +181,20 @@ static errno_t polling_fibril(void *arg)
 		/* Reset as something might be only a temporary problem. */
 		failed_attempts = 0;
 
-		/* Take a rest before next request. */
-
-		// FIXME TODO: This is broken, the time is in ms not us.
-		// but first we need to fix drivers to actually stop using this,
-		// since polling delay should be implemented in HC schedule
-		fibril_usleep(polling->delay);
+		/*
+		 * Re-arm the next transfer immediately after real
+		 * data: the host controller's periodic schedule
+		 * paces interrupt endpoints by itself and an extra
+		 * delay here only adds input latency. An idle
+		 * device parks this fibril inside the blocking
+		 * transfer above without any wakeups, so only empty
+		 * completions rest for the poll interval to keep a
+		 * misbehaving endpoint from spinning us.
+		 */
+		if (actual_size == 0) {
+			// FIXME TODO: This is broken, the time is in ms not us.
+			fibril_usleep(polling->delay);
+		}
 	}
 
 	const bool failed = failed_attempts > 0;
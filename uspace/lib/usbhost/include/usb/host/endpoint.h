@@ -112,6 +112,18 @@ typedef struct endpoint {
 	 */
 	unsigned packets_per_uframe;
 
+	/** Transfer queue statistics, guarded by the inherited guard */
+	struct {
+		/** Batches activated on this endpoint */
+		uint64_t scheduled;
+		/** Batches that finished (deactivations) */
+		uint64_t completed;
+		/** Fibrils currently queued for activation */
+		unsigned waiting;
+		/** High-water mark of the activation queue */
+		unsigned max_waiting;
+	} stats;
+
 	/* This structure is meant to be extended by overriding. */
 } endpoint_t;
 
@@ -177,14 +177,21 @@ int endpoint_activate_locked(endpoint_t *ep, usb_transfer_batch_t *batch)
 	assert(ep->guard);
 	assert(fibril_mutex_is_locked(ep->guard));
 
+	ep->stats.waiting++;
+	if (ep->stats.waiting > ep->stats.max_waiting)
+		ep->stats.max_waiting = ep->stats.waiting;
+
 	while (ep->online && ep->active_batch != NULL)
 		fibril_condvar_wait(&ep->avail, ep->guard);
 
+	ep->stats.waiting--;
+
 	if (!ep->online)
 		return EINTR;
 
 	assert(ep->active_batch == NULL);
 	ep->active_batch = batch;
+	ep->stats.scheduled++;
 	return EOK;
 }
 
@@ -196,6 +203,9 @@ void endpoint_deactivate_locked(endpoint_t *ep)
 	assert(ep);
 	assert(fibril_mutex_is_locked(ep->guard));
 
+	if (ep->active_batch != NULL)
+		ep->stats.completed++;
+
 	ep->active_batch = NULL;
 	fibril_condvar_signal(&ep->avail);
 }
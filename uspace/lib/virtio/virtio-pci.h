@@ -198,6 +198,11 @@ extern uint16_t virtio_alloc_desc(virtio_dev_t *, uint16_t, uint16_t *);
 extern void virtio_free_desc(virtio_dev_t *, uint16_t, uint16_t *, uint16_t);
 
 extern void virtio_virtq_produce_available(virtio_dev_t *, uint16_t, uint16_t);
+extern void virtio_virtq_produce_available_nonotify(virtio_dev_t *, uint16_t,
+    uint16_t);
+extern void virtio_virtq_notify(virtio_dev_t *, uint16_t);
+extern size_t virtio_virtq_consume_used_batch(virtio_dev_t *, uint16_t,
+    uint16_t *, uint32_t *, size_t);
 extern bool virtio_virtq_consume_used(virtio_dev_t *, uint16_t, uint16_t *,
     uint32_t *);
 
@@ -247,6 +247,24 @@ audio_data_t *audio_pipe_pop(audio_pipe_t *pipe)
 	return adata;
 }
 
+/** Source frames needed to produce @a dst_frames resampled frames. */
+static size_t rate_src_frames(size_t dst_frames, unsigned src_rate,
+    unsigned dst_rate)
+{
+	if (src_rate == dst_rate || src_rate == 0 || dst_rate == 0)
+		return dst_frames;
+	return (dst_frames * src_rate + dst_rate - 1) / dst_rate;
+}
+
+/** Destination frames produced by resampling @a src_frames frames. */
+static size_t rate_dst_frames(size_t src_frames, unsigned src_rate,
+    unsigned dst_rate)
+{
+	if (src_rate == dst_rate || src_rate == 0 || dst_rate == 0)
+		return src_frames;
+	return src_frames * dst_rate / src_rate;
+}
+
 /**
  * Use data store in a pipe and mix it into the provided buffer.
  * @param pipe The piep that should provide data.
@@ -263,7 +281,17 @@ size_t audio_pipe_mix_data(audio_pipe_t *pipe, void *data,
 	const size_t dst_frame_size = pcm_format_frame_size(f);
 	size_t needed_frames = pcm_format_size_to_frames(size, f);
 	size_t copied_size = 0;
+	list_t detached;
 
+	list_initialize(&detached);
+
+	/*
+	 * Only claim the data under the pipe lock; the mixing loops
+	 * proper run with the lock dropped, so producers pushing new
+	 * chunks are never blocked behind sample conversion. The pipe
+	 * has a single consumer and chunk data is immutable, hence the
+	 * claimed ranges cannot change under us.
+	 */
 	fibril_mutex_lock(&pipe->guard);
 	while (needed_frames > 0 && !list_empty(&pipe->list)) {
 		/* Get first audio chunk */
@@ -273,34 +301,74 @@ size_t audio_pipe_mix_data(audio_pipe_t *pipe, void *data,
 		/* Get audio chunk metadata */
 		const size_t src_frame_size =
 		    pcm_format_frame_size(&alink->adata->format);
+		const unsigned src_rate = alink->adata->format.sampling_rate;
 		const size_t available_frames =
 		    audio_data_link_available_frames(alink);
-		const size_t copy_frames = min(available_frames, needed_frames);
-		const size_t dst_copy_size = copy_frames * dst_frame_size;
+		const size_t src_needed = rate_src_frames(needed_frames,
+		    src_rate, f->sampling_rate);
+		const size_t copy_frames = min(available_frames, src_needed);
 		const size_t src_copy_size = copy_frames * src_frame_size;
 
 		assert(src_copy_size <= audio_data_link_remain_size(alink));
 
-		/* Copy audio data */
-		pcm_format_convert_and_mix(data, dst_copy_size,
-		    audio_data_link_start(alink), src_copy_size,
-		    &alink->adata->format, f);
-
 		/* Update values */
-		needed_frames -= copy_frames;
-		copied_size += dst_copy_size;
-		data += dst_copy_size;
-		alink->position += src_copy_size;
+		needed_frames -= (copy_frames == src_needed) ? needed_frames :
+		    rate_dst_frames(copy_frames, src_rate, f->sampling_rate);
 		pipe->bytes -= src_copy_size;
 		pipe->frames -= copy_frames;
-		if (audio_data_link_remain_size(alink) == 0) {
-			list_remove(&alink->link);
-			audio_data_link_destroy(alink);
-		} else {
+
+		list_remove(&alink->link);
+		if (src_copy_size < audio_data_link_remain_size(alink)) {
+			/*
+			 * Partially consumed chunk. Detach a private
+			 * link covering the claimed range and leave the
+			 * rest at the head of the pipe.
+			 */
 			assert(needed_frames == 0);
+
+			audio_data_link_t *rest =
+			    audio_data_link_create(alink->adata);
+			if (rest == NULL) {
+				/* Out of memory; claim the whole chunk. */
+				pipe->bytes -=
+				    audio_data_link_remain_size(alink) -
+				    src_copy_size;
+				pipe->frames -=
+				    audio_data_link_available_frames(alink) -
+				    copy_frames;
+			} else {
+				rest->position = alink->position +
+				    src_copy_size;
+				list_prepend(&rest->link, &pipe->list);
+			}
 		}
+		list_append(&alink->link, &detached);
 	}
 	fibril_mutex_unlock(&pipe->guard);
+
+	/* Mix the claimed chunks without holding the pipe lock. */
+	link_t *l;
+	while ((l = list_first(&detached)) != NULL) {
+		audio_data_link_t *alink = audio_data_link_list_instance(l);
+		const size_t src_frames =
+		    audio_data_link_available_frames(alink);
+		const unsigned src_rate = alink->adata->format.sampling_rate;
+		const size_t dst_frames = min(
+		    pcm_format_size_to_frames(size - copied_size, f),
+		    rate_dst_frames(src_frames, src_rate, f->sampling_rate));
+		const size_t dst_copy_size = dst_frames * dst_frame_size;
+		const size_t src_copy_size = src_frames *
+		    pcm_format_frame_size(&alink->adata->format);
+
+		pcm_format_convert_and_mix(data, dst_copy_size,
+		    audio_data_link_start(alink), src_copy_size,
+		    &alink->adata->format, f);
+
+		copied_size += dst_copy_size;
+		data += dst_copy_size;
+		list_remove(&alink->link);
+		audio_data_link_destroy(alink);
+	}
 	return copied_size;
 }
 
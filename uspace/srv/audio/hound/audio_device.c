@@ -37,6 +37,7 @@
 #include <assert.h>
 #include <async.h>
 #include <errno.h>
+#include <config.h>
 #include <inttypes.h>
 #include <loc.h>
 #include <stdbool.h>
@@ -50,6 +51,9 @@
 /* hardwired to provide ~21ms per fragment */
 #define BUFFER_PARTS   16
 
+/* ~5ms fragments when low latency is requested */
+#define BUFFER_PARTS_LOWLAT   64
+
 static errno_t device_sink_connection_callback(audio_sink_t *sink, bool new);
 static errno_t device_source_connection_callback(audio_source_t *source, bool new);
 static void device_event_callback(ipc_call_t *icall, void *arg);
@@ -362,8 +366,16 @@ static errno_t get_buffer(audio_device_t *dev)
 	const errno_t ret = audio_pcm_get_buffer(dev->sess, &dev->buffer.base,
 	    &preferred_size);
 	if (ret == EOK) {
+		/*
+		 * Smaller fragments mean the mixer is asked for data
+		 * more often, trading CPU time for latency. Only do so
+		 * when the 'hound.lowlat' boot argument asks for it.
+		 */
+		const unsigned parts = config_key_exists("hound.lowlat") ?
+		    BUFFER_PARTS_LOWLAT : BUFFER_PARTS;
+
 		dev->buffer.size = preferred_size;
-		dev->buffer.fragment_size = dev->buffer.size / BUFFER_PARTS;
+		dev->buffer.fragment_size = dev->buffer.size / parts;
 		dev->buffer.position = dev->buffer.base;
 	}
 	return ret;
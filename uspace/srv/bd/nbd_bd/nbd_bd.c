@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup nbd_bd
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Network block device (NBD) client.
+ *
+ * Presents an NBD export as a local block device. The protocol is
+ * driven fully pipelined: any number of block requests may be in
+ * flight at once (each caller fibril sends its tagged request and
+ * sleeps on its completion), and a single receiver fibril matches
+ * the replies, which may arrive in any order, back to the waiting
+ * requests.
+ */
+
+#include <async.h>
+#include <bd_srv.h>
+#include <byteorder.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <inet/endpoint.h>
+#include <inet/host.h>
+#include <inet/tcp.h>
+#include <inttypes.h>
+#include <ipc/services.h>
+#include <loc.h>
+#include <macros.h>
+#include <mem.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include <task.h>
+
+#define NAME "nbd_bd"
+
+#define DEFAULT_BLOCK_SIZE 512
+
+/** Old-style negotiation constants */
+#define NBD_INIT_MAGIC   UINT64_C(0x4e42444d41474943) /* "NBDMAGIC" */
+#define NBD_CLISERV_MAGIC UINT64_C(0x00420281861253)
+
+#define NBD_REQUEST_MAGIC UINT32_C(0x25609513)
+#define NBD_REPLY_MAGIC   UINT32_C(0x67446698)
+
+#define NBD_CMD_READ  0
+#define NBD_CMD_WRITE 1
+
+/** NBD request header */
+typedef struct {
+	uint32_t magic;
+	uint32_t type;
+	uint64_t handle;
+	uint64_t offset;
+	uint32_t length;
+} __attribute__((packed)) nbd_request_t;
+
+/** NBD reply header */
+typedef struct {
+	uint32_t magic;
+	uint32_t error;
+	uint64_t handle;
+} __attribute__((packed)) nbd_reply_t;
+
+/** One in-flight request */
+typedef struct {
+	link_t link;
+	uint64_t handle;
+	/** Read payload destination (NULL for writes) */
+	void *buf;
+	size_t size;
+	/** Completion */
+	bool done;
+	errno_t rc;
+	fibril_condvar_t cv;
+} nbd_pending_t;
+
+static size_t block_size;
+static aoff64_t num_blocks;
+static uint64_t export_size;
+
+static tcp_t *tcp;
+static tcp_conn_t *conn;
+static bool conn_failed = false;
+
+/** Serializes request transmission */
+static FIBRIL_MUTEX_INITIALIZE(tx_lock);
+/** Protects the pending list and handle counter */
+static FIBRIL_MUTEX_INITIALIZE(pending_lock);
+static LIST_INITIALIZE(pending_list);
+static uint64_t next_handle = 1;
+
+static service_id_t service_id;
+static bd_srvs_t bd_srvs;
+
+static void print_usage(void);
+static void nbd_bd_connection(ipc_call_t *icall, void *);
+
+static errno_t nbd_bd_open(bd_srvs_t *, bd_srv_t *);
+static errno_t nbd_bd_close(bd_srv_t *);
+static errno_t nbd_bd_read_blocks(bd_srv_t *, aoff64_t, size_t, void *, size_t);
+static errno_t nbd_bd_write_blocks(bd_srv_t *, aoff64_t, size_t, const void *, size_t);
+static errno_t nbd_bd_get_block_size(bd_srv_t *, size_t *);
+static errno_t nbd_bd_get_num_blocks(bd_srv_t *, aoff64_t *);
+
+static bd_ops_t nbd_bd_ops = {
+	.open = nbd_bd_open,
+	.close = nbd_bd_close,
+	.read_blocks = nbd_bd_read_blocks,
+	.write_blocks = nbd_bd_write_blocks,
+	.get_block_size = nbd_bd_get_block_size,
+	.get_num_blocks = nbd_bd_get_num_blocks
+};
+
+/** Receive exactly @a size bytes from the connection */
+static errno_t nbd_recv_exact(void *buf, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size) {
+		size_t now;
+		errno_t rc = tcp_conn_recv_wait(conn, (uint8_t *)buf + done,
+		    size - done, &now);
+		if (rc != EOK)
+			return rc;
+		if (now == 0)
+			return EIO;
+
+		done += now;
+	}
+
+	return EOK;
+}
+
+/** Fail all in-flight requests (connection is gone) */
+static void nbd_fail_pending(void)
+{
+	fibril_mutex_lock(&pending_lock);
+	conn_failed = true;
+
+	list_foreach(pending_list, link, nbd_pending_t, pending) {
+		pending->done = true;
+		pending->rc = EIO;
+		fibril_condvar_signal(&pending->cv);
+	}
+
+	fibril_mutex_unlock(&pending_lock);
+}
+
+/** Receiver fibril: match replies back to in-flight requests.
+ *
+ * Replies carry the request handle and may arrive in any order;
+ * each one wakes exactly the fibril waiting for it.
+ */
+static errno_t nbd_recv_fibril(void *arg)
+{
+	while (true) {
+		nbd_reply_t reply;
+		errno_t rc = nbd_recv_exact(&reply, sizeof(reply));
+		if (rc != EOK)
+			break;
+
+		if (uint32_t_be2host(reply.magic) != NBD_REPLY_MAGIC)
+			break;
+
+		uint64_t handle = uint64_t_be2host(reply.handle);
+		uint32_t error = uint32_t_be2host(reply.error);
+
+		fibril_mutex_lock(&pending_lock);
+		nbd_pending_t *pending = NULL;
+		list_foreach(pending_list, link, nbd_pending_t, cur) {
+			if (cur->handle == handle) {
+				pending = cur;
+				break;
+			}
+		}
+		fibril_mutex_unlock(&pending_lock);
+
+		if (pending == NULL) {
+			/* Unknown handle; protocol is torn. */
+			break;
+		}
+
+		if (error == 0 && pending->buf != NULL) {
+			/* Read payload follows the reply header. */
+			rc = nbd_recv_exact(pending->buf, pending->size);
+			if (rc != EOK) {
+				fibril_mutex_lock(&pending_lock);
+				pending->done = true;
+				pending->rc = EIO;
+				fibril_condvar_signal(&pending->cv);
+				fibril_mutex_unlock(&pending_lock);
+				break;
+			}
+		}
+
+		fibril_mutex_lock(&pending_lock);
+		pending->done = true;
+		pending->rc = (error == 0) ? EOK : EIO;
+		fibril_condvar_signal(&pending->cv);
+		fibril_mutex_unlock(&pending_lock);
+	}
+
+	nbd_fail_pending();
+	return EOK;
+}
+
+/** Issue one NBD request and wait for its completion.
+ *
+ * @param type NBD_CMD_READ or NBD_CMD_WRITE
+ * @param offset Byte offset in the export
+ * @param length Payload length
+ * @param rbuf Destination for read payload (reads only)
+ * @param wbuf Write payload (writes only)
+ *
+ * @return EOK on success or an error code
+ */
+static errno_t nbd_io(uint32_t type, uint64_t offset, uint32_t length,
+    void *rbuf, const void *wbuf)
+{
+	nbd_pending_t pending;
+	nbd_request_t req;
+	errno_t rc;
+
+	link_initialize(&pending.link);
+	pending.buf = rbuf;
+	pending.size = length;
+	pending.done = false;
+	pending.rc = EOK;
+	fibril_condvar_initialize(&pending.cv);
+
+	fibril_mutex_lock(&pending_lock);
+	if (conn_failed) {
+		fibril_mutex_unlock(&pending_lock);
+		return EIO;
+	}
+	pending.handle = next_handle++;
+	list_append(&pending.link, &pending_list);
+	fibril_mutex_unlock(&pending_lock);
+
+	req.magic = host2uint32_t_be(NBD_REQUEST_MAGIC);
+	req.type = host2uint32_t_be(type);
+	req.handle = host2uint64_t_be(pending.handle);
+	req.offset = host2uint64_t_be(offset);
+	req.length = host2uint32_t_be(length);
+
+	/*
+	 * Send header (and write payload) back to back; other
+	 * requests may interleave only between whole messages.
+	 */
+	fibril_mutex_lock(&tx_lock);
+	rc = tcp_conn_send(conn, &req, sizeof(req));
+	if (rc == EOK && wbuf != NULL)
+		rc = tcp_conn_send(conn, wbuf, length);
+	fibril_mutex_unlock(&tx_lock);
+
+	fibril_mutex_lock(&pending_lock);
+	if (rc != EOK) {
+		list_remove(&pending.link);
+		fibril_mutex_unlock(&pending_lock);
+		return EIO;
+	}
+
+	while (!pending.done)
+		fibril_condvar_wait(&pending.cv, &pending_lock);
+
+	list_remove(&pending.link);
+	fibril_mutex_unlock(&pending_lock);
+
+	return pending.rc;
+}
+
+/** Connect to the NBD server and run the old-style negotiation */
+static errno_t nbd_bd_init(const char *host, const char *port_str)
+{
+	inet_ep2_t epp;
+	uint16_t port;
+	errno_t rc;
+
+	rc = str_uint16_t(port_str, NULL, 10, true, &port);
+	if (rc != EOK) {
+		printf("%s: Invalid port '%s'.\n", NAME, port_str);
+		return EINVAL;
+	}
+
+	inet_ep2_init(&epp);
+	rc = inet_host_plookup_one(host, ip_any, &epp.remote.addr, NULL, NULL);
+	if (rc != EOK) {
+		printf("%s: Error resolving host '%s'.\n", NAME, host);
+		return rc;
+	}
+
+	epp.remote.port = port;
+
+	rc = tcp_create(&tcp);
+	if (rc != EOK)
+		return rc;
+
+	rc = tcp_conn_create(tcp, &epp, NULL, NULL, &conn);
+	if (rc != EOK)
+		return rc;
+
+	rc = tcp_conn_wait_connected(conn);
+	if (rc != EOK) {
+		printf("%s: Error connecting to %s:%u.\n", NAME, host, port);
+		return rc;
+	}
+
+	/* Old-style negotiation */
+	uint64_t init_magic;
+	uint64_t cliserv_magic;
+	uint64_t size_be;
+	uint32_t flags;
+	uint8_t pad[124];
+
+	rc = nbd_recv_exact(&init_magic, sizeof(init_magic));
+	if (rc == EOK)
+		rc = nbd_recv_exact(&cliserv_magic, sizeof(cliserv_magic));
+	if (rc == EOK)
+		rc = nbd_recv_exact(&size_be, sizeof(size_be));
+	if (rc == EOK)
+		rc = nbd_recv_exact(&flags, sizeof(flags));
+	if (rc == EOK)
+		rc = nbd_recv_exact(pad, sizeof(pad));
+	if (rc != EOK) {
+		printf("%s: Error during negotiation.\n", NAME);
+		return EIO;
+	}
+
+	if (uint64_t_be2host(init_magic) != NBD_INIT_MAGIC ||
+	    uint64_t_be2host(cliserv_magic) != NBD_CLISERV_MAGIC) {
+		printf("%s: Server is not speaking old-style NBD.\n", NAME);
+		return EIO;
+	}
+
+	export_size = uint64_t_be2host(size_be);
+	num_blocks = export_size / block_size;
+
+	printf("%s: Export size %" PRIu64 " bytes (%" PRIu64 " blocks).\n",
+	    NAME, export_size, num_blocks);
+
+	fid_t fid = fibril_create(nbd_recv_fibril, NULL);
+	if (fid == 0)
+		return ENOMEM;
+
+	fibril_add_ready(fid);
+
+	bd_srvs_init(&bd_srvs);
+	bd_srvs.ops = &nbd_bd_ops;
+
+	async_set_fallback_port_handler(nbd_bd_connection, NULL);
+	rc = loc_server_register(NAME);
+	if (rc != EOK) {
+		printf("%s: Unable to register driver.\n", NAME);
+		return rc;
+	}
+
+	return EOK;
+}
+
+int main(int argc, char **argv)
+{
+	errno_t rc;
+	char *host;
+	char *port;
+	char *device_name;
+	category_id_t disk_cat;
+
+	printf(NAME ": NBD client block device driver\n");
+
+	block_size = DEFAULT_BLOCK_SIZE;
+
+	++argv;
+	--argc;
+	while (*argv != NULL && (*argv)[0] == '-') {
+		/* Option */
+		if (str_cmp(*argv, "-b") == 0) {
+			if (argc < 2) {
+				printf("Argument missing.\n");
+				print_usage();
+				return -1;
+			}
+
+			rc = str_size_t(argv[1], NULL, 10, true, &block_size);
+			if (rc != EOK || block_size == 0) {
+				printf("Invalid block size '%s'.\n", argv[1]);
+				print_usage();
+				return -1;
+			}
+			++argv;
+			--argc;
+		} else {
+			printf("Invalid option '%s'.\n", *argv);
+			print_usage();
+			return -1;
+		}
+		++argv;
+		--argc;
+	}
+
+	if (argc < 3) {
+		printf("Missing arguments.\n");
+		print_usage();
+		return -1;
+	}
+
+	host = argv[0];
+	port = argv[1];
+	device_name = argv[2];
+
+	if (nbd_bd_init(host, port) != EOK)
+		return -1;
+
+	rc = loc_service_register(device_name, &service_id);
+	if (rc != EOK) {
+		printf("%s: Unable to register device '%s': %s.\n",
+		    NAME, device_name, str_error(rc));
+		return rc;
+	}
+
+	rc = loc_category_get_id("disk", &disk_cat, IPC_FLAG_BLOCKING);
+	if (rc != EOK) {
+		printf("%s: Failed resolving category 'disk': %s\n", NAME,
+		    str_error(rc));
+		return rc;
+	}
+
+	rc = loc_service_add_to_cat(service_id, disk_cat);
+	if (rc != EOK) {
+		printf("%s: Failed adding %s to category: %s",
+		    NAME, device_name, str_error(rc));
+		return rc;
+	}
+
+	printf("%s: Accepting connections\n", NAME);
+	task_retval(0);
+	async_manager();
+
+	/* Not reached */
+	return 0;
+}
+
+static void print_usage(void)
+{
+	printf("Usage: " NAME " [-b <block_size>] <host> <port> "
+	    "<device_name>\n");
+}
+
+static void nbd_bd_connection(ipc_call_t *icall, void *arg)
+{
+	bd_conn(icall, &bd_srvs);
+}
+
+/** Open device. */
+static errno_t nbd_bd_open(bd_srvs_t *bds, bd_srv_t *bd)
+{
+	return EOK;
+}
+
+/** Close device. */
+static errno_t nbd_bd_close(bd_srv_t *bd)
+{
+	return EOK;
+}
+
+/** Read blocks from the device. */
+static errno_t nbd_bd_read_blocks(bd_srv_t *bd, uint64_t ba, size_t cnt,
+    void *buf, size_t size)
+{
+	if (size < cnt * block_size)
+		return EINVAL;
+
+	if ((ba + cnt) * block_size > export_size)
+		return ELIMIT;
+
+	return nbd_io(NBD_CMD_READ, ba * block_size, cnt * block_size, buf,
+	    NULL);
+}
+
+/** Write blocks to the device. */
+static errno_t nbd_bd_write_blocks(bd_srv_t *bd, uint64_t ba, size_t cnt,
+    const void *buf, size_t size)
+{
+	if (size < cnt * block_size)
+		return EINVAL;
+
+	if ((ba + cnt) * block_size > export_size)
+		return ELIMIT;
+
+	return nbd_io(NBD_CMD_WRITE, ba * block_size, cnt * block_size, NULL,
+	    buf);
+}
+
+/** Get device block size. */
+static errno_t nbd_bd_get_block_size(bd_srv_t *bd, size_t *rsize)
+{
+	*rsize = block_size;
+	return EOK;
+}
+
+/** Get number of blocks on device. */
+static errno_t nbd_bd_get_num_blocks(bd_srv_t *bd, aoff64_t *rnb)
+{
+	*rnb = num_blocks;
+	return EOK;
+}
+
+/** @}
+ */
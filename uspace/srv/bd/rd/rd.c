@@ -72,6 +72,7 @@ static errno_t rd_read_blocks(bd_srv_t *, aoff64_t, size_t, void *, size_t);
 static errno_t rd_write_blocks(bd_srv_t *, aoff64_t, size_t, const void *, size_t);
 static errno_t rd_get_block_size(bd_srv_t *, size_t *);
 static errno_t rd_get_num_blocks(bd_srv_t *, aoff64_t *);
+static errno_t rd_discard(bd_srv_t *, aoff64_t, size_t);
 
 /** This rwlock protects the ramdisk's data.
  *
@@ -88,7 +89,8 @@ static bd_ops_t rd_bd_ops = {
 	.read_blocks = rd_read_blocks,
 	.write_blocks = rd_write_blocks,
 	.get_block_size = rd_get_block_size,
-	.get_num_blocks = rd_get_num_blocks
+	.get_num_blocks = rd_get_num_blocks,
+	.discard = rd_discard
 };
 
 static bd_srvs_t bd_srvs;
@@ -195,6 +197,49 @@ static bool rd_init(void)
 	return true;
 }
 
+/** Discard blocks: return their backing frames to the kernel.
+ *
+ * Whole pages covered by the range go back to the kernel and read
+ * as zeroes until written again (fresh frames fault in on demand);
+ * partial pages at the edges are zeroed in place.
+ */
+static errno_t rd_discard(bd_srv_t *bd, aoff64_t ba, size_t cnt)
+{
+	if ((ba + cnt) * block_size > rd_size) {
+		/* Discarding past the end of the device. */
+		return ELIMIT;
+	}
+
+	uintptr_t start = (uintptr_t) rd_addr + ba * block_size;
+	uintptr_t end = start + cnt * block_size;
+	uintptr_t pstart = ALIGN_UP(start, PAGE_SIZE);
+	uintptr_t pend = ALIGN_DOWN(end, PAGE_SIZE);
+
+	fibril_rwlock_write_lock(&rd_lock);
+
+	if (pstart < pend) {
+		errno_t rc = as_area_discard((void *) pstart, pend - pstart);
+		if (rc != EOK && rc != ENOTSUP) {
+			fibril_rwlock_write_unlock(&rd_lock);
+			return rc;
+		}
+
+		/* Without kernel support just zero everything. */
+		if (rc == ENOTSUP)
+			memset((void *) pstart, 0, pend - pstart);
+	}
+
+	/* Partial pages at the edges read back as zeroes too. */
+	if (start < min(pstart, end))
+		memset((void *) start, 0, min(pstart, end) - start);
+	if (max(pend, start) < end)
+		memset((void *) max(pend, start), 0, end - max(pend, start));
+
+	fibril_rwlock_write_unlock(&rd_lock);
+
+	return EOK;
+}
+
 /** Get device block size. */
 static errno_t rd_get_block_size(bd_srv_t *bd, size_t *rsize)
 {
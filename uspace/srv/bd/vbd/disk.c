@@ -37,6 +37,8 @@
 #include <bd_srv.h>
 #include <block.h>
 #include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
 #include <str_error.h>
 #include <io/log.h>
 #include <label/empty.h>
@@ -151,6 +153,77 @@ errno_t vbds_disks_init(void)
 }
 
 /** Check for new/removed disk devices */
+/** State shared by the parallel disk probe fibrils */
+typedef struct {
+	service_id_t *svcs;
+	size_t count;
+	size_t next;
+	size_t running;
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+} vbds_probe_t;
+
+/** Disk probing fibril: claim and add disks until none are left */
+static errno_t vbds_probe_fibril(void *arg)
+{
+	vbds_probe_t *probe = (vbds_probe_t *) arg;
+
+	while (true) {
+		fibril_mutex_lock(&probe->lock);
+		if (probe->next >= probe->count) {
+			probe->running--;
+			fibril_condvar_signal(&probe->cv);
+			fibril_mutex_unlock(&probe->lock);
+			return EOK;
+		}
+
+		service_id_t sid = probe->svcs[probe->next++];
+		fibril_mutex_unlock(&probe->lock);
+
+		errno_t rc = vbds_disk_add(sid);
+		if (rc != EOK) {
+			log_msg(LOG_DEFAULT, LVL_ERROR, "Could not add "
+			    "disk.");
+		}
+	}
+}
+
+/** Probe and add a set of disks in parallel */
+static void vbds_disks_probe(service_id_t *svcs, size_t count)
+{
+	vbds_probe_t probe;
+
+	probe.svcs = svcs;
+	probe.count = count;
+	probe.next = 0;
+	fibril_mutex_initialize(&probe.lock);
+	fibril_condvar_initialize(&probe.cv);
+
+	size_t nworkers = (count < 8) ? count : 8;
+	probe.running = nworkers;
+
+	size_t i;
+	for (i = 1; i < nworkers; i++) {
+		fid_t fid = fibril_create(vbds_probe_fibril, &probe);
+		if (fid == 0) {
+			fibril_mutex_lock(&probe.lock);
+			probe.running--;
+			fibril_mutex_unlock(&probe.lock);
+			continue;
+		}
+
+		fibril_add_ready(fid);
+	}
+
+	/* Probe along with the workers. */
+	vbds_probe_fibril(&probe);
+
+	fibril_mutex_lock(&probe.lock);
+	while (probe.running > 0)
+		fibril_condvar_wait(&probe.cv, &probe.lock);
+	fibril_mutex_unlock(&probe.lock);
+}
+
 static errno_t vbds_disks_check_new(void)
 {
 	bool already_known;
@@ -182,6 +255,7 @@ static errno_t vbds_disks_check_new(void)
 	list_foreach(vbds_disks, ldisks, vbds_disk_t, disk)
 		disk->present = false;
 
+	size_t nnew = 0;
 	for (i = 0; i < count; i++) {
 		already_known = false;
 
@@ -196,17 +270,26 @@ static errno_t vbds_disks_check_new(void)
 		if (!already_known) {
 			log_msg(LOG_DEFAULT, LVL_NOTE, "Found disk '%lu'",
 			    (unsigned long) svcs[i]);
-			rc = vbds_disk_add(svcs[i]);
-			if (rc != EOK) {
-				log_msg(LOG_DEFAULT, LVL_ERROR, "Could not add "
-				    "disk.");
-			}
+			/* Compact the new ids to the front. */
+			svcs[nnew++] = svcs[i];
 		} else {
 			log_msg(LOG_DEFAULT, LVL_DEBUG, "Disk %lu already known",
 			    (unsigned long) svcs[i]);
 		}
 	}
 
+	/*
+	 * Probe the new disks on one fibril each: reading and
+	 * parsing 24 partition tables in parallel makes volume
+	 * setup bounded by the slowest disk, not the sum. The list
+	 * lock is dropped while the probes do their I/O.
+	 */
+	if (nnew > 0) {
+		fibril_mutex_unlock(&vbds_disks_lock);
+		vbds_disks_probe(svcs, nnew);
+		fibril_mutex_lock(&vbds_disks_lock);
+	}
+
 	cur = vbds_disk_first();
 	while (cur != NULL) {
 		next = vbds_disk_next(cur);
@@ -539,7 +622,10 @@ errno_t vbds_disk_add(service_id_t sid)
 	disk->present = true;
 
 	list_initialize(&disk->parts);
+
+	fibril_mutex_lock(&vbds_disks_lock);
 	list_append(&disk->ldisks, &vbds_disks);
+	fibril_mutex_unlock(&vbds_disks_lock);
 
 	log_msg(LOG_DEFAULT, LVL_NOTE, "Recognized disk label. Adding partitions.");
 
@@ -26,6 +26,8 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <align.h>
+#include <as.h>
 #include <async.h>
 #include <errno.h>
 #include <str_error.h>
@@ -35,6 +37,7 @@
 #include <loc.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <task.h>
 
@@ -42,44 +45,128 @@
 
 static char *clip_data = NULL;
 static size_t clip_size = 0;
+/** True if clip_data is an address space area rather than a heap block */
+static bool clip_shared = false;
 static clipboard_tag_t clip_tag = CLIPBOARD_TAG_NONE;
 static FIBRIL_MUTEX_INITIALIZE(clip_mtx);
 static service_id_t svc_id;
 
+/** Free current clipboard contents. Caller must hold @c clip_mtx. */
+static void clip_release(void)
+{
+	if (clip_data != NULL) {
+		if (clip_shared)
+			as_area_destroy(clip_data);
+		else
+			free(clip_data);
+	}
+
+	clip_data = NULL;
+	clip_size = 0;
+	clip_shared = false;
+	clip_tag = CLIPBOARD_TAG_NONE;
+}
+
+/** Accept chunked payload of @a total bytes into a new buffer.
+ *
+ * Large payloads land in an address space area so that they can later
+ * be handed to readers by sharing instead of copying (a single IPC
+ * data transfer could not carry them anyway).
+ */
+static errno_t clip_accept_chunks(size_t total, char **rdata, bool *rshared)
+{
+	const bool shared = (total >= CLIPBOARD_SHARE_THRESHOLD);
+	char *data;
+
+	/* Keep ALIGN_UP below from overflowing */
+	if (total > SIZE_MAX - PAGE_SIZE)
+		return ELIMIT;
+
+	if (shared) {
+		data = as_area_create(AS_AREA_ANY,
+		    ALIGN_UP(total, PAGE_SIZE),
+		    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+		    AS_AREA_UNPAGED);
+		if (data == AS_MAP_FAILED)
+			return ENOMEM;
+	} else {
+		data = malloc(total);
+		if (data == NULL)
+			return ENOMEM;
+	}
+
+	size_t pos = 0;
+	while (pos < total) {
+		ipc_call_t call;
+		size_t chunk;
+
+		if (!async_data_write_receive(&call, &chunk)) {
+			async_answer_0(&call, EINVAL);
+			goto error;
+		}
+
+		if ((chunk == 0) || (chunk > total - pos)) {
+			async_answer_0(&call, EINVAL);
+			goto error;
+		}
+
+		errno_t rc = async_data_write_finalize(&call, data + pos,
+		    chunk);
+		if (rc != EOK)
+			goto error;
+
+		pos += chunk;
+	}
+
+	*rdata = data;
+	*rshared = shared;
+	return EOK;
+
+error:
+	if (shared)
+		as_area_destroy(data);
+	else
+		free(data);
+	return EINVAL;
+}
+
 static void clip_put_data(ipc_call_t *req)
 {
 	char *data;
 	errno_t rc;
 	size_t size;
 
+	bool shared = false;
+
 	switch (ipc_get_arg1(req)) {
 	case CLIPBOARD_TAG_NONE:
 		fibril_mutex_lock(&clip_mtx);
-
-		if (clip_data)
-			free(clip_data);
-
-		clip_data = NULL;
-		clip_size = 0;
-		clip_tag = CLIPBOARD_TAG_NONE;
-
+		clip_release();
 		fibril_mutex_unlock(&clip_mtx);
 		async_answer_0(req, EOK);
 		break;
 	case CLIPBOARD_TAG_DATA:
-		rc = async_data_write_accept((void **) &data, false, 0, 0, 0, &size);
+		size = ipc_get_arg2(req);
+		if (size != 0) {
+			/* Announced total size, chunked transfer. */
+			rc = clip_accept_chunks(size, &data, &shared);
+		} else {
+			/* Single transfer from an older client. */
+			rc = async_data_write_accept((void **) &data, false,
+			    0, 0, 0, &size);
+		}
+
 		if (rc != EOK) {
 			async_answer_0(req, rc);
 			break;
 		}
 
 		fibril_mutex_lock(&clip_mtx);
-
-		if (clip_data)
-			free(clip_data);
+		clip_release();
 
 		clip_data = data;
 		clip_size = size;
+		clip_shared = shared;
 		clip_tag = CLIPBOARD_TAG_DATA;
 
 		fibril_mutex_unlock(&clip_mtx);
@@ -120,6 +207,13 @@ static void clip_get_data(ipc_call_t *req)
 			break;
 		}
 
+		if (clip_shared) {
+			/* Large contents are served via CLIPBOARD_GET_SHARED */
+			async_answer_0(&call, EOVERFLOW);
+			async_answer_0(req, EOVERFLOW);
+			break;
+		}
+
 		errno_t retval = async_data_read_finalize(&call, clip_data, size);
 		if (retval != EOK) {
 			async_answer_0(req, retval);
@@ -140,6 +234,46 @@ static void clip_get_data(ipc_call_t *req)
 	fibril_mutex_unlock(&clip_mtx);
 }
 
+static void clip_get_shared(ipc_call_t *req)
+{
+	fibril_mutex_lock(&clip_mtx);
+
+	ipc_call_t call;
+	size_t size;
+
+	if (!async_share_in_receive(&call, &size)) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(req, EINVAL);
+		goto done;
+	}
+
+	if ((clip_tag != CLIPBOARD_TAG_DATA) || (!clip_shared) ||
+	    (size != ALIGN_UP(clip_size, PAGE_SIZE))) {
+		/* The clipboard has changed since CLIPBOARD_CONTENT */
+		async_answer_0(&call, EOVERFLOW);
+		async_answer_0(req, EOVERFLOW);
+		goto done;
+	}
+
+	/*
+	 * Hand out a writable copy-on-write snapshot: the reader may
+	 * edit the contents in place and only the pages it actually
+	 * touches are copied, while the clipboard's own data stays
+	 * intact.
+	 */
+	errno_t retval = async_share_in_finalize(&call, clip_data,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_COW);
+	if (retval != EOK) {
+		async_answer_0(req, retval);
+		goto done;
+	}
+
+	async_answer_0(req, EOK);
+
+done:
+	fibril_mutex_unlock(&clip_mtx);
+}
+
 static void clip_content(ipc_call_t *req)
 {
 	fibril_mutex_lock(&clip_mtx);
@@ -175,6 +309,9 @@ static void clip_connection(ipc_call_t *icall, void *arg)
 		case CLIPBOARD_CONTENT:
 			clip_content(&call);
 			break;
+		case CLIPBOARD_GET_SHARED:
+			clip_get_shared(&call);
+			break;
 		default:
 			async_answer_0(&call, ENOENT);
 		}
@@ -34,6 +34,8 @@
 #include <dirent.h>
 #include <errno.h>
 #include <io/log.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <vfs/vfs.h>
 #include <loc.h>
 #include <str_error.h>
@@ -86,6 +88,7 @@ void add_driver(driver_list_t *drivers_list, driver_t *drv)
 	fibril_mutex_lock(&drivers_list->drivers_mutex);
 	list_append(&drv->drivers, &drivers_list->drivers);
 	drv->handle = drivers_list->next_handle++;
+	match_index_add_driver(drv);
 	fibril_mutex_unlock(&drivers_list->drivers_mutex);
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "Driver `%s' was added to the list of available "
@@ -253,15 +256,12 @@ driver_t *find_best_match_driver(driver_list_t *drivers_list, dev_node_t *node)
 	}
 
 	/*
-	 * Find driver with the next best score
+	 * Find the driver with the next best score through the
+	 * match-id index instead of crossing every driver's match
+	 * list with the device's.
 	 */
-	list_foreach(drivers_list->drivers, drivers, driver_t, drv) {
-		score = get_match_score(drv, node);
-		if (score > best_score && score < cur_score) {
-			best_score = score;
-			best_drv = drv;
-		}
-	}
+	best_score = match_index_best(node, cur_score, &best_drv);
+	(void) best_score;
 
 	fibril_mutex_unlock(&drivers_list->drivers_mutex);
 	return best_drv;
@@ -420,19 +420,81 @@ driver_t *driver_find_by_name(driver_list_t *drv_list, const char *drv_name)
  *
  * @param driver	The driver to which the devices are passed.
  */
+/** Context shared by the parallel device-passing fibrils. */
+typedef struct {
+	driver_t *driver;
+	dev_node_t *dev;
+	dev_tree_t *tree;
+
+	fibril_mutex_t *lock;
+	fibril_condvar_t *cv;
+	size_t *pending;
+} pass_device_arg_t;
+
+/** Pass one device to its driver and handle the probe result. */
+static void pass_one_device(driver_t *driver, dev_node_t *dev,
+    dev_tree_t *tree)
+{
+	add_device(driver, dev, tree);
+
+	/* Device probe failed, need to try next best driver */
+	if (dev->state == DEVICE_NOT_PRESENT) {
+		fibril_mutex_lock(&driver->driver_mutex);
+		list_remove(&dev->driver_devices);
+		fibril_mutex_unlock(&driver->driver_mutex);
+		/* Give an extra reference to driver_reassign_fibril */
+		dev_add_ref(dev);
+		fid_t fid = fibril_create(driver_reassign_fibril, dev);
+		if (fid == 0) {
+			log_msg(LOG_DEFAULT, LVL_ERROR,
+			    "Error creating fibril to assign driver.");
+			dev_del_ref(dev);
+		}
+		fibril_add_ready(fid);
+	}
+
+	dev_del_ref(dev);
+}
+
+/** Fibril wrapper around pass_one_device(). */
+static errno_t pass_device_fibril(void *arg)
+{
+	pass_device_arg_t *pda = (pass_device_arg_t *) arg;
+
+	pass_one_device(pda->driver, pda->dev, pda->tree);
+
+	fibril_mutex_lock(pda->lock);
+	(*pda->pending)--;
+	fibril_condvar_broadcast(pda->cv);
+	fibril_mutex_unlock(pda->lock);
+
+	free(pda);
+	return EOK;
+}
+
 static void pass_devices_to_driver(driver_t *driver, dev_tree_t *tree)
 {
 	dev_node_t *dev;
 	link_t *link;
 
+	fibril_mutex_t pass_lock;
+	fibril_condvar_t pass_cv;
+	size_t pending = 0;
+
+	fibril_mutex_initialize(&pass_lock);
+	fibril_condvar_initialize(&pass_cv);
+
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "pass_devices_to_driver(driver=\"%s\")",
 	    driver->name);
 
 	fibril_mutex_lock(&driver->driver_mutex);
 
+again:
 	/*
 	 * Go through devices list as long as there is some device
-	 * that has not been passed to the driver.
+	 * that has not been passed to the driver. The devices are
+	 * probed in parallel, one fibril each, so independent
+	 * devices of one driver enumerate concurrently.
 	 */
 	link = driver->devices.head.next;
 	while (link != &driver->devices.head) {
@@ -445,6 +507,13 @@ static void pass_devices_to_driver(driver_t *driver, dev_tree_t *tree)
 			continue;
 		}
 
+		/*
+		 * Mark the device as taken so that the rescan below
+		 * does not start it twice; add_device() would set the
+		 * flag only upon completion.
+		 */
+		dev->passed_to_driver = true;
+
 		dev_add_ref(dev);
 
 		/*
@@ -454,25 +523,29 @@ static void pass_devices_to_driver(driver_t *driver, dev_tree_t *tree)
 		fibril_mutex_unlock(&driver->driver_mutex);
 		fibril_rwlock_write_unlock(&tree->rwlock);
 
-		add_device(driver, dev, tree);
-
-		/* Device probe failed, need to try next best driver */
-		if (dev->state == DEVICE_NOT_PRESENT) {
-			fibril_mutex_lock(&driver->driver_mutex);
-			list_remove(&dev->driver_devices);
-			fibril_mutex_unlock(&driver->driver_mutex);
-			/* Give an extra reference to driver_reassign_fibril */
-			dev_add_ref(dev);
-			fid_t fid = fibril_create(driver_reassign_fibril, dev);
-			if (fid == 0) {
-				log_msg(LOG_DEFAULT, LVL_ERROR,
-				    "Error creating fibril to assign driver.");
-				dev_del_ref(dev);
-			}
-			fibril_add_ready(fid);
+		pass_device_arg_t *pda = calloc(1, sizeof(*pda));
+		fid_t fid = 0;
+		if (pda != NULL) {
+			pda->driver = driver;
+			pda->dev = dev;
+			pda->tree = tree;
+			pda->lock = &pass_lock;
+			pda->cv = &pass_cv;
+			pda->pending = &pending;
+
+			fid = fibril_create(pass_device_fibril, pda);
 		}
 
-		dev_del_ref(dev);
+		if (fid != 0) {
+			fibril_mutex_lock(&pass_lock);
+			pending++;
+			fibril_mutex_unlock(&pass_lock);
+			fibril_add_ready(fid);
+		} else {
+			/* Fall back to passing the device here. */
+			free(pda);
+			pass_one_device(driver, dev, tree);
+		}
 
 		/*
 		 * Lock again as we will work with driver's
@@ -486,6 +559,29 @@ static void pass_devices_to_driver(driver_t *driver, dev_tree_t *tree)
 		link = driver->devices.head.next;
 	}
 
+	/*
+	 * Nothing unpassed right now. If probes are still in flight,
+	 * wait them out and rescan: devices may have arrived while
+	 * they ran. Only when nothing is pending and the scan found
+	 * nothing may the driver enter the running state, still under
+	 * the driver mutex, so no new device can slip by unpassed.
+	 */
+	fibril_mutex_lock(&pass_lock);
+	bool busy = (pending > 0);
+	fibril_mutex_unlock(&pass_lock);
+
+	if (busy) {
+		fibril_mutex_unlock(&driver->driver_mutex);
+
+		fibril_mutex_lock(&pass_lock);
+		while (pending > 0)
+			fibril_condvar_wait(&pass_cv, &pass_lock);
+		fibril_mutex_unlock(&pass_lock);
+
+		fibril_mutex_lock(&driver->driver_mutex);
+		goto again;
+	}
+
 	/*
 	 * Once we passed all devices to the driver, we need to mark the
 	 * driver as running.
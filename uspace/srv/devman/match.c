@@ -33,6 +33,8 @@
 #include <errno.h>
 #include <io/log.h>
 #include <str.h>
+#include <adt/hash_table.h>
+#include <stdlib.h>
 #include <str_error.h>
 #include <stddef.h>
 #include <vfs/vfs.h>
@@ -42,6 +44,145 @@
 
 #define COMMENT	'#'
 
+/*
+ * Match-id index: every match id string registered by any driver
+ * maps, through a hash table, to the drivers (and their scores)
+ * that carry it. Matching a new device then only looks up the
+ * device's own few ids instead of crossing every driver's list
+ * with every device id - a hotplug storm stops being quadratic.
+ */
+
+typedef struct {
+	link_t link;
+	driver_t *drv;
+	int score;
+} match_index_entry_t;
+
+typedef struct {
+	ht_link_t link;
+	const char *id;
+	list_t entries;
+} match_index_node_t;
+
+static hash_table_t match_index;
+static bool match_index_ready = false;
+
+static size_t match_str_hash(const char *str)
+{
+	size_t h = 5381;
+
+	while (*str != '\0')
+		h = h * 33 + (uint8_t) *str++;
+
+	return h;
+}
+
+static size_t mi_key_hash(const void *key)
+{
+	return match_str_hash((const char *) key);
+}
+
+static size_t mi_hash(const ht_link_t *item)
+{
+	match_index_node_t *mn = hash_table_get_inst(item,
+	    match_index_node_t, link);
+	return match_str_hash(mn->id);
+}
+
+static bool mi_key_equal(const void *key, const ht_link_t *item)
+{
+	match_index_node_t *mn = hash_table_get_inst(item,
+	    match_index_node_t, link);
+	return str_cmp((const char *) key, mn->id) == 0;
+}
+
+static const hash_table_ops_t mi_ops = {
+	.hash = mi_hash,
+	.key_hash = mi_key_hash,
+	.key_equal = mi_key_equal,
+	.equal = NULL,
+	.remove_callback = NULL
+};
+
+/** Find the index node of a match id string */
+static match_index_node_t *match_index_find(const char *id)
+{
+	if (!match_index_ready)
+		return NULL;
+
+	ht_link_t *link = hash_table_find(&match_index, id);
+	if (link == NULL)
+		return NULL;
+
+	return hash_table_get_inst(link, match_index_node_t, link);
+}
+
+/** Index all match ids of a driver.
+ *
+ * Called when the driver is added; the caller holds the driver
+ * list lock that also guards matching.
+ */
+void match_index_add_driver(driver_t *drv)
+{
+	if (!match_index_ready) {
+		hash_table_create(&match_index, 0, 0, &mi_ops);
+		match_index_ready = true;
+	}
+
+	list_foreach(drv->match_ids.ids, link, match_id_t, mid) {
+		match_index_node_t *mn = match_index_find(mid->id);
+		if (mn == NULL) {
+			mn = calloc(1, sizeof(match_index_node_t));
+			if (mn == NULL)
+				return;
+
+			mn->id = mid->id;
+			list_initialize(&mn->entries);
+			hash_table_insert(&match_index, &mn->link);
+		}
+
+		match_index_entry_t *entry =
+		    calloc(1, sizeof(match_index_entry_t));
+		if (entry == NULL)
+			return;
+
+		entry->drv = drv;
+		entry->score = mid->score;
+		link_initialize(&entry->link);
+		list_append(&entry->link, &mn->entries);
+	}
+}
+
+/** Find the best-scoring driver below a score bound via the index.
+ *
+ * @param dev Device node to match.
+ * @param cur_score Only scores strictly below this count.
+ * @param best_drv The best driver found is stored here.
+ * @return The best score found, zero when nothing matches.
+ */
+int match_index_best(dev_node_t *dev, int cur_score, driver_t **best_drv)
+{
+	int best_score = 0;
+
+	*best_drv = NULL;
+
+	list_foreach(dev->pfun->match_ids.ids, link, match_id_t, dev_id) {
+		match_index_node_t *mn = match_index_find(dev_id->id);
+		if (mn == NULL)
+			continue;
+
+		list_foreach(mn->entries, link, match_index_entry_t, entry) {
+			int score = entry->score * dev_id->score;
+			if (score > best_score && score < cur_score) {
+				best_score = score;
+				*best_drv = entry->drv;
+			}
+		}
+	}
+
+	return best_score;
+}
+
 /** Compute compound score of driver and device.
  *
  * @param driver Match id of the driver.
@@ -41,6 +41,8 @@
 #define MATCH_EXT ".ma"
 
 extern int get_match_score(driver_t *, dev_node_t *);
+extern void match_index_add_driver(driver_t *);
+extern int match_index_best(dev_node_t *, int, driver_t **);
 extern bool parse_match_ids(char *, match_id_list_t *);
 extern bool read_match_ids(const char *, match_id_list_t *);
 extern char *read_match_id(char **);
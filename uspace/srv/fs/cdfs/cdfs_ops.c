@@ -1053,6 +1053,51 @@ static errno_t iso_readfs(cdfs_t *fs, fs_node_t *rfn,
  * Mount a session with session start offset
  *
  */
+/** Upper bound on the number of directories preloaded at mount time. */
+#define CDFS_PRELOAD_DIRS  64
+
+/** Preload directory metadata.
+ *
+ * Process the directory tree breadth-first starting at the root, up
+ * to a bounded number of directories. The medium is read-only, so
+ * the parsed metadata never goes stale, and reading it while the
+ * drive is already spinning at mount time avoids the pronounced
+ * first-access seek latencies optical media are notorious for. The
+ * bound keeps mount time reasonable for discs with huge trees.
+ *
+ * @param fs  Filesystem instance.
+ * @param rfn Root node.
+ */
+static void cdfs_preload_meta(cdfs_t *fs, fs_node_t *rfn)
+{
+	fs_node_t *queue[CDFS_PRELOAD_DIRS];
+	size_t head = 0;
+	size_t tail = 0;
+
+	queue[tail++] = rfn;
+
+	while (head < tail) {
+		fs_node_t *fn = queue[head++];
+		cdfs_node_t *node = CDFS_NODE(fn);
+
+		if (cdfs_readdir(fs, fn) != EOK)
+			return;
+
+		list_foreach(node->cs_list, link, cdfs_dentry_t, dentry) {
+			if (tail >= CDFS_PRELOAD_DIRS)
+				return;
+
+			fs_node_t *child = get_cached_node(fs,
+			    dentry->index);
+			if (child == NULL)
+				continue;
+
+			if (CDFS_NODE(child)->type == CDFS_DIRECTORY)
+				queue[tail++] = child;
+		}
+	}
+}
+
 static cdfs_t *cdfs_fs_create(service_id_t sid, cdfs_lba_t altroot)
 {
 	cdfs_t *fs = NULL;
@@ -1079,6 +1124,12 @@ static cdfs_t *cdfs_fs_create(service_id_t sid, cdfs_lba_t altroot)
 	if (iso_readfs(fs, rfn, altroot) != EOK)
 		goto error;
 
+	/*
+	 * Eagerly parse the upper part of the directory tree while
+	 * the drive is already busy; lookups then start from memory.
+	 */
+	cdfs_preload_meta(fs, rfn);
+
 	list_append(&fs->link, &cdfs_instances);
 	return fs;
 error:
@@ -44,43 +44,205 @@
 #include <align.h>
 #include <assert.h>
 #include <fibril_synch.h>
+#include <macros.h>
 #include <mem.h>
+#include <stdlib.h>
 
-errno_t exfat_bitmap_is_free(exfat_bs_t *bs, service_id_t service_id,
-    exfat_cluster_t clst)
+/*
+ * The allocation bitmap is kept memory-resident per volume:
+ * queries and updates touch the in-memory copy and only a dirty
+ * byte range is written back (on sync and unmount), instead of a
+ * block cache round trip per allocation query.
+ */
+typedef struct {
+	link_t link;
+	service_id_t service_id;
+	uint8_t *bits;
+	size_t nbytes;
+	/** Dirty byte range; lo > hi means clean */
+	size_t dirty_lo;
+	size_t dirty_hi;
+} bitmap_cache_t;
+
+static LIST_INITIALIZE(bitmap_caches);
+static FIBRIL_MUTEX_INITIALIZE(bitmap_caches_lock);
+
+/** Get (loading if needed) the resident bitmap of a volume.
+ *
+ * The caches lock is held on successful return; the caller
+ * releases it when done with the bits.
+ */
+static errno_t bitmap_cache_get(exfat_bs_t *bs, service_id_t service_id,
+    bitmap_cache_t **rbc)
 {
-	fs_node_t *fn;
-	block_t *b = NULL;
-	exfat_node_t *bitmapp;
-	uint8_t *bitmap;
-	errno_t rc;
-	bool alloc;
+	fibril_mutex_lock(&bitmap_caches_lock);
 
-	clst -= EXFAT_CLST_FIRST;
+	list_foreach(bitmap_caches, link, bitmap_cache_t, bc) {
+		if (bc->service_id == service_id) {
+			*rbc = bc;
+			return EOK;
+		}
+	}
 
-	rc = exfat_bitmap_get(&fn, service_id);
-	if (rc != EOK)
+	/* Load the whole bitmap. */
+	fs_node_t *fn;
+	errno_t rc = exfat_bitmap_get(&fn, service_id);
+	if (rc != EOK) {
+		fibril_mutex_unlock(&bitmap_caches_lock);
 		return rc;
-	bitmapp = EXFAT_NODE(fn);
+	}
 
-	aoff64_t offset = clst / 8;
-	rc = exfat_block_get(&b, bs, bitmapp, offset / BPS(bs), BLOCK_FLAGS_NONE);
-	if (rc != EOK) {
+	exfat_node_t *bitmapp = EXFAT_NODE(fn);
+
+	bitmap_cache_t *bc = calloc(1, sizeof(bitmap_cache_t));
+	if (bc == NULL) {
 		(void) exfat_node_put(fn);
-		return rc;
+		fibril_mutex_unlock(&bitmap_caches_lock);
+		return ENOMEM;
 	}
-	bitmap = (uint8_t *)b->data;
-	alloc = bitmap[offset % BPS(bs)] & (1 << (clst % 8));
 
-	rc = block_put(b);
-	if (rc != EOK) {
+	bc->service_id = service_id;
+	bc->nbytes = bitmapp->size;
+	bc->dirty_lo = 1;
+	bc->dirty_hi = 0;
+	bc->bits = malloc(bc->nbytes);
+	if (bc->bits == NULL) {
+		free(bc);
 		(void) exfat_node_put(fn);
+		fibril_mutex_unlock(&bitmap_caches_lock);
+		return ENOMEM;
+	}
+
+	size_t nblocks = ROUND_UP(bc->nbytes, BPS(bs)) / BPS(bs);
+	for (size_t i = 0; i < nblocks; i++) {
+		block_t *b;
+		rc = exfat_block_get(&b, bs, bitmapp, i, BLOCK_FLAGS_NONE);
+		if (rc != EOK) {
+			free(bc->bits);
+			free(bc);
+			(void) exfat_node_put(fn);
+			fibril_mutex_unlock(&bitmap_caches_lock);
+			return rc;
+		}
+
+		size_t now = min(BPS(bs), bc->nbytes - i * BPS(bs));
+		memcpy(bc->bits + i * BPS(bs), b->data, now);
+		(void) block_put(b);
+	}
+
+	(void) exfat_node_put(fn);
+
+	list_append(&bc->link, &bitmap_caches);
+	*rbc = bc;
+	return EOK;
+}
+
+/** Note a modified bitmap byte. Caches lock held. */
+static void bitmap_cache_mark(bitmap_cache_t *bc, size_t off)
+{
+	if (bc->dirty_lo > bc->dirty_hi) {
+		bc->dirty_lo = off;
+		bc->dirty_hi = off + 1;
+	} else {
+		bc->dirty_lo = min(bc->dirty_lo, off);
+		bc->dirty_hi = max(bc->dirty_hi, off + 1);
+	}
+}
+
+/** Write the dirty part of a volume's bitmap back.
+ *
+ * @param bs Boot sector
+ * @param service_id Volume service id
+ * @return EOK on success or an error code
+ */
+errno_t exfat_bitmap_flush(exfat_bs_t *bs, service_id_t service_id)
+{
+	fs_node_t *fn;
+	errno_t rc = EOK;
+
+	fibril_mutex_lock(&bitmap_caches_lock);
+
+	bitmap_cache_t *bc = NULL;
+	list_foreach(bitmap_caches, link, bitmap_cache_t, cur) {
+		if (cur->service_id == service_id) {
+			bc = cur;
+			break;
+		}
+	}
+
+	if (bc == NULL || bc->dirty_lo > bc->dirty_hi) {
+		fibril_mutex_unlock(&bitmap_caches_lock);
+		return EOK;
+	}
+
+	rc = exfat_bitmap_get(&fn, service_id);
+	if (rc != EOK) {
+		fibril_mutex_unlock(&bitmap_caches_lock);
 		return rc;
 	}
-	rc = exfat_node_put(fn);
+
+	exfat_node_t *bitmapp = EXFAT_NODE(fn);
+
+	size_t first = bc->dirty_lo / BPS(bs);
+	size_t last = (bc->dirty_hi - 1) / BPS(bs);
+
+	for (size_t i = first; i <= last; i++) {
+		block_t *b;
+		rc = exfat_block_get(&b, bs, bitmapp, i, BLOCK_FLAGS_NONE);
+		if (rc != EOK)
+			break;
+
+		size_t now = min(BPS(bs), bc->nbytes - i * BPS(bs));
+		memcpy(b->data, bc->bits + i * BPS(bs), now);
+		b->dirty = true;
+		rc = block_put(b);
+		if (rc != EOK)
+			break;
+	}
+
+	if (rc == EOK) {
+		bc->dirty_lo = 1;
+		bc->dirty_hi = 0;
+	}
+
+	(void) exfat_node_put(fn);
+	fibril_mutex_unlock(&bitmap_caches_lock);
+	return rc;
+}
+
+/** Drop a volume's resident bitmap (after flushing it) */
+void exfat_bitmap_cache_done(exfat_bs_t *bs, service_id_t service_id)
+{
+	(void) exfat_bitmap_flush(bs, service_id);
+
+	fibril_mutex_lock(&bitmap_caches_lock);
+	list_foreach(bitmap_caches, link, bitmap_cache_t, bc) {
+		if (bc->service_id == service_id) {
+			list_remove(&bc->link);
+			free(bc->bits);
+			free(bc);
+			break;
+		}
+	}
+	fibril_mutex_unlock(&bitmap_caches_lock);
+}
+
+errno_t exfat_bitmap_is_free(exfat_bs_t *bs, service_id_t service_id,
+    exfat_cluster_t clst)
+{
+	bitmap_cache_t *bc;
+	errno_t rc;
+	bool alloc;
+
+	clst -= EXFAT_CLST_FIRST;
+
+	rc = bitmap_cache_get(bs, service_id, &bc);
 	if (rc != EOK)
 		return rc;
 
+	alloc = bc->bits[clst / 8] & (1 << (clst % 8));
+	fibril_mutex_unlock(&bitmap_caches_lock);
+
 	if (alloc)
 		return ENOENT;
 
@@ -90,72 +252,39 @@ errno_t exfat_bitmap_is_free(exfat_bs_t *bs, service_id_t service_id,
 errno_t exfat_bitmap_set_cluster(exfat_bs_t *bs, service_id_t service_id,
     exfat_cluster_t clst)
 {
-	fs_node_t *fn;
-	block_t *b = NULL;
-	exfat_node_t *bitmapp;
-	uint8_t *bitmap;
+	bitmap_cache_t *bc;
 	errno_t rc;
 
 	clst -= EXFAT_CLST_FIRST;
 
-	rc = exfat_bitmap_get(&fn, service_id);
+	rc = bitmap_cache_get(bs, service_id, &bc);
 	if (rc != EOK)
 		return rc;
-	bitmapp = EXFAT_NODE(fn);
 
-	aoff64_t offset = clst / 8;
-	rc = exfat_block_get(&b, bs, bitmapp, offset / BPS(bs), BLOCK_FLAGS_NONE);
-	if (rc != EOK) {
-		(void) exfat_node_put(fn);
-		return rc;
-	}
-	bitmap = (uint8_t *)b->data;
-	bitmap[offset % BPS(bs)] |= (1 << (clst % 8));
+	bc->bits[clst / 8] |= (1 << (clst % 8));
+	bitmap_cache_mark(bc, clst / 8);
+	fibril_mutex_unlock(&bitmap_caches_lock);
 
-	b->dirty = true;
-	rc = block_put(b);
-	if (rc != EOK) {
-		(void) exfat_node_put(fn);
-		return rc;
-	}
-
-	return exfat_node_put(fn);
+	return EOK;
 }
 
 errno_t exfat_bitmap_clear_cluster(exfat_bs_t *bs, service_id_t service_id,
     exfat_cluster_t clst)
 {
-	fs_node_t *fn;
-	block_t *b = NULL;
-	exfat_node_t *bitmapp;
-	uint8_t *bitmap;
+	bitmap_cache_t *bc;
 	errno_t rc;
 
 	clst -= EXFAT_CLST_FIRST;
 
-	rc = exfat_bitmap_get(&fn, service_id);
+	rc = bitmap_cache_get(bs, service_id, &bc);
 	if (rc != EOK)
 		return rc;
-	bitmapp = EXFAT_NODE(fn);
-
-	aoff64_t offset = clst / 8;
-	rc = exfat_block_get(&b, bs, bitmapp, offset / BPS(bs),
-	    BLOCK_FLAGS_NONE);
-	if (rc != EOK) {
-		(void) exfat_node_put(fn);
-		return rc;
-	}
-	bitmap = (uint8_t *)b->data;
-	bitmap[offset % BPS(bs)] &= ~(1 << (clst % 8));
 
-	b->dirty = true;
-	rc = block_put(b);
-	if (rc != EOK) {
-		(void) exfat_node_put(fn);
-		return rc;
-	}
+	bc->bits[clst / 8] &= ~(1 << (clst % 8));
+	bitmap_cache_mark(bc, clst / 8);
+	fibril_mutex_unlock(&bitmap_caches_lock);
 
-	return exfat_node_put(fn);
+	return EOK;
 }
 
 errno_t exfat_bitmap_set_clusters(exfat_bs_t *bs, service_id_t service_id,
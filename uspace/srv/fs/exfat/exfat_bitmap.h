@@ -49,6 +49,8 @@ extern errno_t exfat_bitmap_free_clusters(struct exfat_bs *, struct exfat_node *
     exfat_cluster_t);
 extern errno_t exfat_bitmap_replicate_clusters(struct exfat_bs *, struct exfat_node *);
 
+extern errno_t exfat_bitmap_flush(struct exfat_bs *, service_id_t);
+extern void exfat_bitmap_cache_done(struct exfat_bs *, service_id_t);
 extern errno_t exfat_bitmap_is_free(struct exfat_bs *, service_id_t, exfat_cluster_t);
 extern errno_t exfat_bitmap_set_cluster(struct exfat_bs *, service_id_t, exfat_cluster_t);
 extern errno_t exfat_bitmap_clear_cluster(struct exfat_bs *, service_id_t,
@@ -504,6 +504,73 @@ errno_t exfat_uctable_get(fs_node_t **rfn, service_id_t service_id)
 	return exfat_node_get(rfn, service_id, EXFAT_UCTABLE_IDX);
 }
 
+/*
+ * Directory entry position index.
+ *
+ * Linear directory scans dominate the cost of exFAT lookups. A small
+ * direct-mapped index remembers at which directory position a name
+ * was last found. The hint is self-validating: exfat_match() seeks
+ * to the remembered position and verifies that the name still
+ * matches, falling back to the full scan otherwise, so no
+ * invalidation is needed when directories change.
+ */
+
+#define DENTRY_IDX_SIZE  64
+
+typedef struct {
+	bool valid;
+	service_id_t service_id;
+	exfat_cluster_t pfc;
+	char name[EXFAT_FILENAME_LEN + 1];
+	aoff64_t pos;
+} dentry_idx_t;
+
+static dentry_idx_t dentry_idx[DENTRY_IDX_SIZE];
+
+static size_t dentry_idx_slot(service_id_t service_id, exfat_cluster_t pfc,
+    const char *name)
+{
+	size_t hash = service_id * 31 + pfc;
+
+	for (const char *p = name; *p != 0; p++)
+		hash = hash * 33 + (uint8_t) *p;
+
+	return hash % DENTRY_IDX_SIZE;
+}
+
+/** Remember where a name was found in a directory. */
+static void dentry_idx_insert(service_id_t service_id, exfat_cluster_t pfc,
+    const char *name, aoff64_t pos)
+{
+	if (str_size(name) > EXFAT_FILENAME_LEN)
+		return;
+
+	dentry_idx_t *e = &dentry_idx[dentry_idx_slot(service_id, pfc, name)];
+
+	e->valid = true;
+	e->service_id = service_id;
+	e->pfc = pfc;
+	str_cpy(e->name, EXFAT_FILENAME_LEN + 1, name);
+	e->pos = pos;
+}
+
+/** Look up the remembered position of a name in a directory.
+ *
+ * @return True if a hint exists (which still has to be verified).
+ */
+static bool dentry_idx_lookup(service_id_t service_id, exfat_cluster_t pfc,
+    const char *name, aoff64_t *pos)
+{
+	dentry_idx_t *e = &dentry_idx[dentry_idx_slot(service_id, pfc, name)];
+
+	if ((!e->valid) || (e->service_id != service_id) ||
+	    (e->pfc != pfc) || (str_cmp(e->name, name) != 0))
+		return false;
+
+	*pos = e->pos;
+	return true;
+}
+
 errno_t exfat_match(fs_node_t **rfn, fs_node_t *pfn, const char *component)
 {
 	exfat_node_t *parentp = EXFAT_NODE(pfn);
@@ -522,11 +589,36 @@ errno_t exfat_match(fs_node_t **rfn, fs_node_t *pfn, const char *component)
 	if (rc != EOK)
 		return rc;
 
-	while (exfat_directory_read_file(&di, name, EXFAT_FILENAME_LEN, &df,
-	    &ds) == EOK) {
+	/*
+	 * Try the position hint from the directory entry index first;
+	 * a stale hint simply fails the name comparison below and the
+	 * scan starts over from the beginning.
+	 */
+	aoff64_t hint_pos;
+	bool hinted = dentry_idx_lookup(service_id, parentp->firstc,
+	    component, &hint_pos);
+	if (hinted) {
+		if ((exfat_directory_seek(&di, hint_pos) != EOK) ||
+		    (exfat_directory_read_file(&di, name, EXFAT_FILENAME_LEN,
+		    &df, &ds) != EOK) ||
+		    (str_casecmp(name, component) != 0)) {
+			hinted = false;
+			rc = exfat_directory_seek(&di, 0);
+			if (rc != EOK) {
+				(void) exfat_directory_close(&di);
+				return rc;
+			}
+		}
+	}
+
+	while (hinted || exfat_directory_read_file(&di, name,
+	    EXFAT_FILENAME_LEN, &df, &ds) == EOK) {
+		hinted = false;
 		if (str_casecmp(name, component) == 0) {
 			/* hit */
 			exfat_node_t *nodep;
+			dentry_idx_insert(service_id, parentp->firstc,
+			    component, di.pos);
 			aoff64_t o = di.pos %
 			    (BPS(di.bs) / sizeof(exfat_dentry_t));
 			exfat_idx_t *idx = exfat_idx_get_by_pos(service_id,
@@ -1307,12 +1399,17 @@ exfat_mounted(service_id_t service_id, const char *opts, fs_index_t *index,
 static errno_t exfat_unmounted(service_id_t service_id)
 {
 	fs_node_t *rfn;
+	exfat_bs_t *bs;
 	errno_t rc;
 
 	rc = exfat_root_get(&rfn, service_id);
 	if (rc != EOK)
 		return rc;
 
+	/* Fold the resident allocation bitmap back to disk. */
+	bs = block_bb_get(service_id);
+	exfat_bitmap_cache_done(bs, service_id);
+
 	exfat_fs_close(service_id, rfn);
 	return EOK;
 }
@@ -1455,6 +1552,12 @@ static errno_t exfat_sync(service_id_t service_id, fs_index_t index)
 	nodep->dirty = true;
 	rc = exfat_node_sync(nodep);
 
+	/* Also push out pending allocation bitmap updates. */
+	if (rc == EOK) {
+		rc = exfat_bitmap_flush(block_bb_get(service_id),
+		    service_id);
+	}
+
 	exfat_node_put(fn);
 	return rc;
 }
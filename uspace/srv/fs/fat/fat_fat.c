@@ -46,6 +46,7 @@
 #include <byteorder.h>
 #include <align.h>
 #include <assert.h>
+#include <adt/list.h>
 #include <fibril_synch.h>
 #include <mem.h>
 #include <stdlib.h>
@@ -59,6 +60,82 @@
  */
 static FIBRIL_MUTEX_INITIALIZE(fat_alloc_lock);
 
+/*
+ * Per-volume cache of FAT entries (next-cluster values of the
+ * first FAT). A bounded direct-mapped table: chain walks hit
+ * memory instead of a block cache round trip per link, making
+ * seeks within big files cheap while keeping the footprint fixed
+ * regardless of FAT size. Entries are updated on every FAT write.
+ */
+
+/** Entries per volume cache (power of two) */
+#define FAT_CACHE_ENTRIES  16384
+
+typedef struct {
+	link_t link;
+	service_id_t service_id;
+	/** Tag per slot: the cluster number cached, or FAT_CLST_RES0 */
+	fat_cluster_t *tags;
+	fat_cluster_t *values;
+} fat_cache_t;
+
+static LIST_INITIALIZE(fat_caches);
+static FIBRIL_MUTEX_INITIALIZE(fat_caches_lock);
+
+/** Drop a volume's FAT entry cache (on unmount) */
+void fat_cache_done(service_id_t service_id)
+{
+	fibril_mutex_lock(&fat_caches_lock);
+	list_foreach(fat_caches, link, fat_cache_t, fc) {
+		if (fc->service_id == service_id) {
+			list_remove(&fc->link);
+			free(fc->tags);
+			free(fc->values);
+			free(fc);
+			break;
+		}
+	}
+	fibril_mutex_unlock(&fat_caches_lock);
+}
+
+/** Get (creating if needed) the FAT entry cache of a volume.
+ *
+ * The caches lock is held on successful return. NULL means no
+ * cache could be allocated; callers fall back to raw access.
+ */
+static fat_cache_t *fat_cache_get(service_id_t service_id)
+{
+	fibril_mutex_lock(&fat_caches_lock);
+
+	list_foreach(fat_caches, link, fat_cache_t, fc) {
+		if (fc->service_id == service_id)
+			return fc;
+	}
+
+	fat_cache_t *fc = calloc(1, sizeof(fat_cache_t));
+	if (fc == NULL) {
+		fibril_mutex_unlock(&fat_caches_lock);
+		return NULL;
+	}
+
+	fc->tags = malloc(FAT_CACHE_ENTRIES * sizeof(fat_cluster_t));
+	fc->values = malloc(FAT_CACHE_ENTRIES * sizeof(fat_cluster_t));
+	if (fc->tags == NULL || fc->values == NULL) {
+		free(fc->tags);
+		free(fc->values);
+		free(fc);
+		fibril_mutex_unlock(&fat_caches_lock);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < FAT_CACHE_ENTRIES; i++)
+		fc->tags[i] = FAT_CLST_RES0;
+
+	fc->service_id = service_id;
+	list_append(&fc->link, &fat_caches);
+	return fc;
+}
+
 /** Walk the cluster chain.
  *
  * @param bs		Buffer holding the boot sector for the file.
@@ -426,9 +503,24 @@ fat_get_cluster(fat_bs_t *bs, service_id_t service_id, unsigned fatno,
     fat_cluster_t clst, fat_cluster_t *value)
 {
 	errno_t rc;
+	fat_cache_t *fc = NULL;
 
 	assert(fatno < FATCNT(bs));
 
+	/* The cache mirrors the first FAT only. */
+	if (fatno == FAT1) {
+		fc = fat_cache_get(service_id);
+		if (fc != NULL) {
+			size_t slot = clst % FAT_CACHE_ENTRIES;
+			if (fc->tags[slot] == clst) {
+				*value = fc->values[slot];
+				fibril_mutex_unlock(&fat_caches_lock);
+				return EOK;
+			}
+			fibril_mutex_unlock(&fat_caches_lock);
+		}
+	}
+
 	if (FAT_IS_FAT12(bs))
 		rc = fat_get_cluster_fat12(bs, service_id, fatno, clst, value);
 	else if (FAT_IS_FAT16(bs))
@@ -436,6 +528,14 @@ fat_get_cluster(fat_bs_t *bs, service_id_t service_id, unsigned fatno,
 	else
 		rc = fat_get_cluster_fat32(bs, service_id, fatno, clst, value);
 
+	if (rc == EOK && fc != NULL) {
+		fibril_mutex_lock(&fat_caches_lock);
+		size_t slot = clst % FAT_CACHE_ENTRIES;
+		fc->tags[slot] = clst;
+		fc->values[slot] = *value;
+		fibril_mutex_unlock(&fat_caches_lock);
+	}
+
 	return rc;
 }
 
@@ -622,6 +722,17 @@ fat_set_cluster(fat_bs_t *bs, service_id_t service_id, unsigned fatno,
 	else
 		rc = fat_set_cluster_fat32(bs, service_id, fatno, clst, value);
 
+	/* Keep the cached entry in step with the first FAT. */
+	if (rc == EOK && fatno == FAT1) {
+		fat_cache_t *fc = fat_cache_get(service_id);
+		if (fc != NULL) {
+			size_t slot = clst % FAT_CACHE_ENTRIES;
+			fc->tags[slot] = clst;
+			fc->values[slot] = value;
+			fibril_mutex_unlock(&fat_caches_lock);
+		}
+	}
+
 	return rc;
 }
 
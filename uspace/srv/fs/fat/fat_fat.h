@@ -124,6 +124,7 @@ extern errno_t fat_alloc_clusters(struct fat_bs *, service_id_t, unsigned,
 extern errno_t fat_free_clusters(struct fat_bs *, service_id_t, fat_cluster_t);
 extern errno_t fat_alloc_shadow_clusters(struct fat_bs *, service_id_t,
     fat_cluster_t *, unsigned);
+extern void fat_cache_done(service_id_t);
 extern errno_t fat_get_cluster(struct fat_bs *, service_id_t, unsigned,
     fat_cluster_t, fat_cluster_t *);
 extern errno_t fat_set_cluster(struct fat_bs *, service_id_t, unsigned,
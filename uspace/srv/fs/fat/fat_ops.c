@@ -369,6 +369,73 @@ errno_t fat_root_get(fs_node_t **rfn, service_id_t service_id)
 	return fat_node_get(rfn, service_id, 0);
 }
 
+/*
+ * Directory entry position index.
+ *
+ * Linear directory scans dominate the cost of FAT lookups. A small
+ * direct-mapped index remembers at which directory position a name
+ * was last found. The hint is self-validating: fat_match() seeks to
+ * the remembered position and verifies that the name still matches,
+ * falling back to the full scan otherwise, so no invalidation is
+ * needed when directories change.
+ */
+
+#define DENTRY_IDX_SIZE  64
+
+typedef struct {
+	bool valid;
+	service_id_t service_id;
+	fat_cluster_t pfc;
+	char name[FAT_LFN_NAME_SIZE];
+	aoff64_t pos;
+} dentry_idx_t;
+
+static dentry_idx_t dentry_idx[DENTRY_IDX_SIZE];
+
+static size_t dentry_idx_slot(service_id_t service_id, fat_cluster_t pfc,
+    const char *name)
+{
+	size_t hash = service_id * 31 + pfc;
+
+	for (const char *p = name; *p != 0; p++)
+		hash = hash * 33 + (uint8_t) *p;
+
+	return hash % DENTRY_IDX_SIZE;
+}
+
+/** Remember where a name was found in a directory. */
+static void dentry_idx_insert(service_id_t service_id, fat_cluster_t pfc,
+    const char *name, aoff64_t pos)
+{
+	if (str_size(name) >= FAT_LFN_NAME_SIZE)
+		return;
+
+	dentry_idx_t *e = &dentry_idx[dentry_idx_slot(service_id, pfc, name)];
+
+	e->valid = true;
+	e->service_id = service_id;
+	e->pfc = pfc;
+	str_cpy(e->name, FAT_LFN_NAME_SIZE, name);
+	e->pos = pos;
+}
+
+/** Look up the remembered position of a name in a directory.
+ *
+ * @return True if a hint exists (which still has to be verified).
+ */
+static bool dentry_idx_lookup(service_id_t service_id, fat_cluster_t pfc,
+    const char *name, aoff64_t *pos)
+{
+	dentry_idx_t *e = &dentry_idx[dentry_idx_slot(service_id, pfc, name)];
+
+	if ((!e->valid) || (e->service_id != service_id) ||
+	    (e->pfc != pfc) || (str_cmp(e->name, name) != 0))
+		return false;
+
+	*pos = e->pos;
+	return true;
+}
+
 errno_t fat_match(fs_node_t **rfn, fs_node_t *pfn, const char *component)
 {
 	fat_node_t *parentp = FAT_NODE(pfn);
@@ -386,10 +453,47 @@ errno_t fat_match(fs_node_t **rfn, fs_node_t *pfn, const char *component)
 	if (rc != EOK)
 		return rc;
 
-	while (fat_directory_read(&di, name, &d) == EOK) {
+	/*
+	 * Try the position hint from the directory entry index first;
+	 * a stale hint simply fails the name comparison below and the
+	 * scan starts over from the beginning.
+	 */
+	aoff64_t hint_pos = 0;
+	bool hinted = dentry_idx_lookup(service_id, parentp->firstc,
+	    component, &hint_pos);
+	if (hinted) {
+		if ((fat_directory_seek(&di, hint_pos) != EOK) ||
+		    (fat_directory_read(&di, name, &d) != EOK) ||
+		    (fat_dentry_namecmp(name, component) != 0)) {
+			hinted = false;
+			rc = fat_directory_seek(&di, 0);
+			if (rc != EOK) {
+				(void) fat_directory_close(&di);
+				return rc;
+			}
+		}
+	}
+
+	/*
+	 * The position remembered for a hit is the start of the whole
+	 * entry set (the first long name entry, when there is one), so
+	 * that a later hinted read reconstructs the long name; di.pos
+	 * itself points at the short entry after a read.
+	 */
+	aoff64_t set_pos = hint_pos;
+
+	while (true) {
+		if (!hinted) {
+			set_pos = di.pos;
+			if (fat_directory_read(&di, name, &d) != EOK)
+				break;
+		}
+		hinted = false;
 		if (fat_dentry_namecmp(name, component) == 0) {
 			/* hit */
 			fat_node_t *nodep;
+			dentry_idx_insert(service_id, parentp->firstc,
+			    component, set_pos);
 			aoff64_t o = di.pos %
 			    (BPS(di.bs) / sizeof(fat_dentry_t));
 			fat_idx_t *idx = fat_idx_get_by_pos(service_id,
@@ -1196,6 +1300,7 @@ static errno_t fat_unmounted(service_id_t service_id)
 	 */
 	(void) fat_node_fini_by_service_id(service_id);
 	fat_fs_close(service_id, fn);
+	fat_cache_done(service_id);
 
 	void *data;
 	if (fs_instance_get(service_id, &data) == EOK) {
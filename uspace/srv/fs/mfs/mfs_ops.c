@@ -1170,7 +1170,16 @@ mfs_sync(service_id_t service_id, fs_index_t index)
 	struct mfs_node *mnode = fn->data;
 	mnode->ino_i->dirty = true;
 
-	return mfs_node_put(fn);
+	rc = mfs_node_put(fn);
+	if (rc != EOK)
+		return rc;
+
+	/*
+	 * Group commit: put only wrote the metadata into the block
+	 * cache; push everything dirtied so far out to the device in
+	 * one clustered batch so that sync actually means durable.
+	 */
+	return block_cache_flush_all(service_id);
 }
 
 /** Check if a given number is a power of two.
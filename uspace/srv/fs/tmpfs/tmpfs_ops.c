@@ -49,7 +49,10 @@
 #include <stddef.h>
 #include <adt/hash_table.h>
 #include <adt/hash.h>
+#include <align.h>
 #include <as.h>
+#include <libarch/config.h>
+#include <mem.h>
 #include <libfs.h>
 
 /** All root nodes have index 0. */
@@ -181,12 +184,63 @@ static void nodes_remove_callback(ht_link_t *item)
 
 	if (nodep->data) {
 		assert(nodep->type == TMPFS_FILE);
-		free(nodep->data);
+		as_area_destroy(nodep->data);
 	}
 	free(nodep->bp);
 	free(nodep);
 }
 
+/** Resize the anonymous memory area backing a file.
+ *
+ * File contents are kept in dedicated address space areas instead of
+ * heap blocks, so a file's backing memory is page-aligned and can be
+ * shared with clients as-is (e.g. via the VFS pager or IPC area
+ * sharing) without copying. Freshly created areas and grown pages
+ * come from the kernel zeroed.
+ *
+ * @param old      Present backing area or NULL.
+ * @param old_size Present file size.
+ * @param new_size New file size.
+ *
+ * @return New backing area, or NULL if new_size is zero or memory
+ *         is short.
+ */
+static void *tmpfs_data_resize(void *old, size_t old_size, size_t new_size)
+{
+	size_t old_cap = ALIGN_UP(old_size, PAGE_SIZE);
+	size_t new_cap = ALIGN_UP(new_size, PAGE_SIZE);
+
+	if (new_cap == 0) {
+		if (old != NULL)
+			as_area_destroy(old);
+		return NULL;
+	}
+
+	if (old == NULL) {
+		void *data = as_area_create(AS_AREA_ANY, new_cap,
+		    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+		    AS_AREA_UNPAGED);
+		return (data == AS_MAP_FAILED) ? NULL : data;
+	}
+
+	if (new_cap == old_cap)
+		return old;
+
+	if (as_area_resize(old, new_cap, 0) == EOK)
+		return old;
+
+	/* Could not resize in place; allocate anew and copy. */
+	void *data = as_area_create(AS_AREA_ANY, new_cap,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+	    AS_AREA_UNPAGED);
+	if (data == AS_MAP_FAILED)
+		return NULL;
+
+	memcpy(data, old, (old_size < new_size) ? old_size : new_size);
+	as_area_destroy(old);
+	return data;
+}
+
 /** TMPFS nodes hash table operations. */
 hash_table_ops_t nodes_ops = {
 	.hash = nodes_hash,
@@ -563,13 +617,12 @@ tmpfs_write(service_id_t service_id, fs_index_t index, aoff64_t pos,
 	}
 	size_t delta = (pos + size) - nodep->size;
 	/*
-	 * At this point, we are deliberately extremely straightforward and
-	 * simply realloc the contents of the file on every write that grows the
-	 * file. In the end, the situation might not be as bad as it may look:
-	 * our heap allocator can save us and just grow the block whenever
-	 * possible.
+	 * Grow the backing address space area. Growth is page
+	 * granular, so most growing writes do not change the area at
+	 * all and the rest usually resize it in place.
 	 */
-	void *newdata = realloc(nodep->data, nodep->size + delta);
+	void *newdata = tmpfs_data_resize(nodep->data, nodep->size,
+	    nodep->size + delta);
 	if (!newdata) {
 		async_answer_0(&call, ENOMEM);
 		size = 0;
@@ -609,7 +662,7 @@ static errno_t tmpfs_truncate(service_id_t service_id, fs_index_t index,
 	if (size > SIZE_MAX)
 		return ENOMEM;
 
-	void *newdata = realloc(nodep->data, size);
+	void *newdata = tmpfs_data_resize(nodep->data, nodep->size, size);
 	if (!newdata && size)
 		return ENOMEM;
 
@@ -623,6 +676,56 @@ static errno_t tmpfs_truncate(service_id_t service_id, fs_index_t index,
 	return EOK;
 }
 
+/** Copy one file's contents over another, entirely in the server.
+ *
+ * Both files live in this TMPFS instance, so the data moves with a
+ * single memcpy between the backing memory areas instead of being
+ * shuttled through the client in read/write sized pieces.
+ */
+static errno_t tmpfs_copy(service_id_t service_id, fs_index_t src_index,
+    fs_index_t dst_index, aoff64_t *nsize)
+{
+	node_key_t src_key = {
+		.service_id = service_id,
+		.index = src_index
+	};
+
+	ht_link_t *hlp = hash_table_find(&nodes, &src_key);
+	if (!hlp)
+		return ENOENT;
+	tmpfs_node_t *srcp = hash_table_get_inst(hlp, tmpfs_node_t, nh_link);
+
+	node_key_t dst_key = {
+		.service_id = service_id,
+		.index = dst_index
+	};
+
+	hlp = hash_table_find(&nodes, &dst_key);
+	if (!hlp)
+		return ENOENT;
+	tmpfs_node_t *dstp = hash_table_get_inst(hlp, tmpfs_node_t, nh_link);
+
+	if ((srcp->type != TMPFS_FILE) || (dstp->type != TMPFS_FILE))
+		return EINVAL;
+
+	if (srcp == dstp) {
+		*nsize = srcp->size;
+		return EOK;
+	}
+
+	void *newdata = tmpfs_data_resize(dstp->data, dstp->size, srcp->size);
+	if (!newdata && srcp->size)
+		return ENOMEM;
+
+	if (srcp->size > 0)
+		memcpy(newdata, srcp->data, srcp->size);
+
+	dstp->data = newdata;
+	dstp->size = srcp->size;
+	*nsize = srcp->size;
+	return EOK;
+}
+
 static errno_t tmpfs_close(service_id_t service_id, fs_index_t index)
 {
 	return EOK;
@@ -659,6 +762,7 @@ vfs_out_ops_t tmpfs_ops = {
 	.read = tmpfs_read,
 	.write = tmpfs_write,
 	.truncate = tmpfs_truncate,
+	.copy = tmpfs_copy,
 	.close = tmpfs_close,
 	.destroy = tmpfs_destroy,
 	.sync = tmpfs_sync,
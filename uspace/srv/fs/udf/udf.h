@@ -114,6 +114,11 @@ typedef struct udf_node {
 	uint8_t *data;
 	udf_allocator_t *allocators;
 	size_t alloc_size;
+
+	/** Extent position cache: index and cumulative length of
+	 * the extent the last read fell into */
+	size_t last_ext;
+	aoff64_t last_ext_base;
 } udf_node_t;
 
 extern vfs_out_ops_t udf_ops;
@@ -581,6 +581,18 @@ errno_t udf_read_file(size_t *read_len, ipc_call_t *call, udf_node_t *node,
 	size_t i = 0;
 	size_t l = 0;
 
+	/*
+	 * Resume the extent walk from the cached position when the
+	 * read is at or past it - for streaming access the extent
+	 * is found in constant time instead of rescanning from the
+	 * start of the allocation descriptors on every call.
+	 */
+	if (node->last_ext < node->alloc_size &&
+	    pos >= node->last_ext_base) {
+		i = node->last_ext;
+		l = node->last_ext_base;
+	}
+
 	while (i < node->alloc_size) {
 		if (pos >= l + node->allocators[i].length) {
 			l += node->allocators[i].length;
@@ -589,6 +601,9 @@ errno_t udf_read_file(size_t *read_len, ipc_call_t *call, udf_node_t *node,
 			break;
 	}
 
+	node->last_ext = i;
+	node->last_ext_base = l;
+
 	size_t sector_cnt = ALL_UP(l, node->instance->sector_size);
 	size_t sector_num = pos / node->instance->sector_size;
 
@@ -603,6 +618,19 @@ errno_t udf_read_file(size_t *read_len, ipc_call_t *call, udf_node_t *node,
 
 	size_t sector_pos = pos % node->instance->sector_size;
 
+	/*
+	 * Nearing the end of this extent: ask the cache to pull in
+	 * the start of the next one, which is generally not
+	 * physically contiguous, so the automatic sequential
+	 * readahead cannot cross the boundary by itself.
+	 */
+	if (i + 1 < node->alloc_size &&
+	    ALL_UP(node->allocators[i].length, node->instance->sector_size) ==
+	    sector_num - sector_cnt + 1) {
+		(void) block_prefetch(node->instance->service_id,
+		    node->allocators[i + 1].position, 4);
+	}
+
 	if (sector_pos + len < node->instance->sector_size)
 		*read_len = len;
 	else
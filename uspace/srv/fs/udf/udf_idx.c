@@ -178,6 +178,8 @@ errno_t udf_idx_add(udf_node_t **udfn, udf_instance_t *instance, fs_index_t inde
 	udf_node->fs_node = fs_node;
 	udf_node->data = NULL;
 	udf_node->allocators = NULL;
+	udf_node->last_ext = 0;
+	udf_node->last_ext_base = 0;
 
 	fibril_mutex_initialize(&udf_node->lock);
 	fs_node->data = udf_node;
@@ -149,7 +149,10 @@ errno_t ds_window_create(ds_client_t *client, display_wnd_params_t *params,
 	else
 		ds_seat_set_focus(seat, wnd);
 
-	(void) ds_display_paint(wnd->display, NULL);
+	/* Only the area covered by the new window needs repainting. */
+	gfx_rect_t drect;
+	gfx_rect_translate(&wnd->dpos, &wnd->rect, &drect);
+	(void) ds_display_paint(wnd->display, &drect);
 
 	*rgc = wnd;
 	return EOK;
@@ -176,9 +179,13 @@ error:
 void ds_window_destroy(ds_window_t *wnd)
 {
 	ds_display_t *disp;
+	gfx_rect_t drect;
 
 	disp = wnd->display;
 
+	/* Remember the vacated display area before tearing down. */
+	gfx_rect_translate(&wnd->dpos, &wnd->rect, &drect);
+
 	ds_client_remove_window(wnd);
 	ds_display_remove_window(wnd);
 
@@ -190,7 +197,7 @@ void ds_window_destroy(ds_window_t *wnd)
 	free(wnd->caption);
 	free(wnd);
 
-	(void) ds_display_paint(disp, NULL);
+	(void) ds_display_paint(disp, &drect);
 }
 
 /** Bring window to top.
@@ -199,8 +206,13 @@ void ds_window_destroy(ds_window_t *wnd)
  */
 void ds_window_bring_to_top(ds_window_t *wnd)
 {
+	gfx_rect_t drect;
+
 	ds_display_window_to_top(wnd);
-	(void) ds_display_paint(wnd->display, NULL);
+
+	/* Only the raised window's area changes on screen. */
+	gfx_rect_translate(&wnd->dpos, &wnd->rect, &drect);
+	(void) ds_display_paint(wnd->display, &drect);
 }
 
 /** Get generic graphic context from window.
@@ -214,6 +226,15 @@ gfx_context_t *ds_window_get_ctx(ds_window_t *wnd)
 }
 
 /** Paint a window using its backing bitmap.
+ *
+ * Window surfaces are shared memory end to end: the client's pixel
+ * area arrives via IPC area sharing (GC_BITMAP_CREATE) and renders
+ * into the backing bitmap without crossing the IPC data path, so the
+ * only copies left are the compositing blit into the back buffer
+ * performed here and the dirty-rectangle flush to the front buffer.
+ * The backing bitmap must be retained (rather than compositing from
+ * client memory directly) so that expose events can be served
+ * without the client's cooperation.
  *
  * @param wnd Window to paint
  * @param rect Display rectangle to paint to
@@ -107,6 +107,28 @@ static list_t serial_devs;
 
 static FIBRIL_MUTEX_INITIALIZE(discovery_lock);
 
+/*
+ * Relative mouse motion coalescing. High-rate mice report at up to 1 kHz;
+ * forwarding each report as a separate IPC call makes every consumer pay a
+ * round-trip per report. The first motion event of a burst is forwarded
+ * immediately, then a short window is opened during which further deltas
+ * are only accumulated; the window timer flushes the sum as one event.
+ * Non-motion events flush any pending motion first to preserve ordering.
+ */
+#define MOTION_FLUSH_USEC 4000
+
+static FIBRIL_MUTEX_INITIALIZE(motion_lock);
+static fibril_timer_t *motion_timer;
+/** Device the pending motion belongs to */
+static mouse_dev_t *motion_mdev;
+/** Accumulated deltas (protected by motion_lock) */
+static int motion_dx;
+static int motion_dy;
+/** True while the coalescing window is open */
+static bool motion_window;
+
+static void mouse_flush_motion(void);
+
 static void *client_data_create(void)
 {
 	client_t *client = (client_t *) calloc(1, sizeof(client_t));
@@ -249,6 +271,8 @@ void kbd_push_event(kbd_dev_t *kdev, int type, unsigned int key)
 
 	ev.c = layout_parse_ev(kdev->active_layout, &ev);
 
+	mouse_flush_motion();
+
 	list_foreach(clients, link, client_t, client) {
 		if (client->active) {
 			async_exch_t *exch = async_exchange_begin(client->sess);
@@ -259,8 +283,8 @@ void kbd_push_event(kbd_dev_t *kdev, int type, unsigned int key)
 	}
 }
 
-/** Mouse pointer has moved (relative mode). */
-void mouse_push_event_move(mouse_dev_t *mdev, int dx, int dy, int dz)
+/** Send a relative motion event to all active clients. */
+static void mouse_send_move(mouse_dev_t *mdev, int dx, int dy, int dz)
 {
 	list_foreach(clients, link, client_t, client) {
 		if (client->active) {
@@ -288,10 +312,78 @@ void mouse_push_event_move(mouse_dev_t *mdev, int dx, int dy, int dz)
 	}
 }
 
+/** Send accumulated motion, if any. Caller must hold @c motion_lock. */
+static void mouse_flush_motion_locked(void)
+{
+	if ((motion_dx) || (motion_dy)) {
+		mouse_send_move(motion_mdev, motion_dx, motion_dy, 0);
+		motion_dx = 0;
+		motion_dy = 0;
+	}
+}
+
+/** Flush pending motion ahead of a non-motion event. */
+static void mouse_flush_motion(void)
+{
+	fibril_mutex_lock(&motion_lock);
+	mouse_flush_motion_locked();
+	fibril_mutex_unlock(&motion_lock);
+}
+
+/** Coalescing window timer handler. */
+static void motion_timer_fun(void *arg)
+{
+	fibril_mutex_lock(&motion_lock);
+	mouse_flush_motion_locked();
+	motion_window = false;
+	fibril_mutex_unlock(&motion_lock);
+}
+
+/** Mouse pointer has moved (relative mode). */
+void mouse_push_event_move(mouse_dev_t *mdev, int dx, int dy, int dz)
+{
+	fibril_mutex_lock(&motion_lock);
+
+	if ((motion_mdev != NULL) && (motion_mdev != mdev))
+		mouse_flush_motion_locked();
+
+	motion_mdev = mdev;
+
+	if (dz != 0) {
+		/*
+		 * Wheel clicks are discrete; summing them would drop
+		 * scroll steps. Forward them right away, keeping any
+		 * accumulated motion ordered in front.
+		 */
+		mouse_flush_motion_locked();
+		mouse_send_move(mdev, dx, dy, dz);
+		fibril_mutex_unlock(&motion_lock);
+		return;
+	}
+
+	if ((motion_timer == NULL) || (!motion_window)) {
+		/* Forward immediately, then open a coalescing window. */
+		mouse_send_move(mdev, dx, dy, 0);
+
+		if (motion_timer != NULL) {
+			motion_window = true;
+			fibril_timer_set_locked(motion_timer,
+			    MOTION_FLUSH_USEC, motion_timer_fun, NULL);
+		}
+	} else {
+		motion_dx += dx;
+		motion_dy += dy;
+	}
+
+	fibril_mutex_unlock(&motion_lock);
+}
+
 /** Mouse pointer has moved (absolute mode). */
 void mouse_push_event_abs_move(mouse_dev_t *mdev, unsigned int x, unsigned int y,
     unsigned int max_x, unsigned int max_y)
 {
+	mouse_flush_motion();
+
 	list_foreach(clients, link, client_t, client) {
 		if (client->active) {
 			if ((max_x) && (max_y)) {
@@ -307,6 +399,8 @@ void mouse_push_event_abs_move(mouse_dev_t *mdev, unsigned int x, unsigned int y
 /** Mouse button has been pressed. */
 void mouse_push_event_button(mouse_dev_t *mdev, int bnum, int press)
 {
+	mouse_flush_motion();
+
 	list_foreach(clients, link, client_t, client) {
 		if (client->active) {
 			async_exch_t *exch = async_exchange_begin(client->sess);
@@ -320,6 +414,8 @@ void mouse_push_event_button(mouse_dev_t *mdev, int bnum, int press)
 /** Mouse button has been double-clicked. */
 void mouse_push_event_dclick(mouse_dev_t *mdev, int bnum)
 {
+	mouse_flush_motion();
+
 	list_foreach(clients, link, client_t, client) {
 		if (client->active) {
 			async_exch_t *exch = async_exchange_begin(client->sess);
@@ -890,6 +986,9 @@ int main(int argc, char **argv)
 	list_initialize(&mouse_devs);
 	list_initialize(&serial_devs);
 
+	/* Without the timer motion events are simply not coalesced. */
+	motion_timer = fibril_timer_create(&motion_lock);
+
 	serial_console = config_get_value("console");
 
 	/* Add legacy keyboard devices. */
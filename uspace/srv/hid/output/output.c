@@ -281,6 +281,35 @@ static bool srv_update_scroll(outdev_t *dev, chargrid_t *buf)
 	if (dev->top_row == top_row)
 		return false;
 
+	/*
+	 * If the device can shift its displayed rows, do that instead
+	 * of redrawing everything: the back buffer is shifted the
+	 * same way, so the cell comparison below only repaints the
+	 * newly exposed rows (and any unrelated changes).
+	 */
+	int delta = (int) top_row - (int) dev->top_row;
+	if ((dev->ops.scroll != NULL) && (delta > 0) &&
+	    ((sysarg_t) delta < dev->rows)) {
+		dev->ops.scroll(dev, delta);
+
+		for (sysarg_t y = 0; y + delta < dev->rows; y++) {
+			for (sysarg_t x = 0; x < dev->cols; x++) {
+				*chargrid_charfield_at(dev->backbuf, x, y) =
+				    *chargrid_charfield_at(dev->backbuf, x,
+				    y + delta);
+			}
+		}
+
+		/* Force a repaint of the newly exposed rows. */
+		for (sysarg_t y = dev->rows - delta; y < dev->rows; y++) {
+			for (sysarg_t x = 0; x < dev->cols; x++) {
+				charfield_t *bf =
+				    chargrid_charfield_at(dev->backbuf, x, y);
+				bf->ch = (char32_t) -1;
+			}
+		}
+	}
+
 	dev->top_row = top_row;
 
 	for (sysarg_t y = 0; y < dev->rows; y++) {
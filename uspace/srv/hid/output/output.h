@@ -55,6 +55,11 @@ typedef struct {
 	void (*cursor_update)(struct outdev *dev, sysarg_t prev_col,
 	    sysarg_t prev_row, sysarg_t col, sysarg_t row, bool visible);
 	void (*char_update)(struct outdev *dev, sysarg_t col, sysarg_t row);
+	/**
+	 * Optional: shift the displayed rows by delta (positive means
+	 * scrolling up) without redrawing them.
+	 */
+	void (*scroll)(struct outdev *dev, int delta);
 	void (*flush)(struct outdev *dev);
 } outdev_ops_t;
 
@@ -38,6 +38,7 @@
 #include <as.h>
 #include <ddi.h>
 #include <io/chargrid.h>
+#include <mem.h>
 #include "../output.h"
 #include "ega.h"
 
@@ -171,6 +172,16 @@ static void ega_char_update(outdev_t *dev, sysarg_t col, sysarg_t row)
 	draw_char(field, col, row);
 }
 
+static void ega_scroll(outdev_t *dev, int delta)
+{
+	if ((delta <= 0) || ((sysarg_t) delta >= ega.rows))
+		return;
+
+	/* Shift the text VRAM contents up by delta rows. */
+	memmove(ega.addr, ega.addr + FB_POS(0, delta),
+	    FB_POS(0, ega.rows - delta));
+}
+
 static void ega_flush(outdev_t *dev)
 {
 }
@@ -182,6 +193,7 @@ static outdev_ops_t ega_ops = {
 	.get_caps = ega_get_caps,
 	.cursor_update = ega_cursor_update,
 	.char_update = ega_char_update,
+	.scroll = ega_scroll,
 	.flush = ega_flush
 };
 
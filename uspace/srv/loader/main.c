@@ -289,7 +289,18 @@ static int ldr_load(ipc_call_t *req)
 {
 	DPRINTF("LOADER_LOAD()\n");
 
-	errno_t rc = elf_load(program_fd, &prog_info);
+	/*
+	 * Regular applications get their read-only segments demand-
+	 * paged from the file. Servers and drivers are loaded eagerly:
+	 * they may sit in the paging path themselves (VFS, file system
+	 * and block device servers), where taking a page fault that is
+	 * served through their own functionality would deadlock.
+	 */
+	eld_flags_t ldflags = 0;
+	if (str_test_prefix(progname, "/app/"))
+		ldflags |= ELDF_PAGED;
+
+	errno_t rc = elf_load(program_fd, ldflags, &prog_info);
 	if (rc != EOK) {
 		DPRINTF("Failed to load executable for '%s'.\n", progname);
 		async_answer_0(req, EINVAL);
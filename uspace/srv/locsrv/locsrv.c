@@ -94,6 +94,31 @@ static categ_dir_t cdir;
 static FIBRIL_MUTEX_INITIALIZE(callback_sess_mutex);
 static LIST_INITIALIZE(callback_sess_list);
 
+/**
+ * Namespace generation counter. Incremented on every change visible to
+ * consumers (service and namespace registration and removal, category
+ * membership). Consumers compare generations to skip re-reading lists
+ * that have not changed.
+ */
+static sysarg_t loc_gen = 0;
+static FIBRIL_MUTEX_INITIALIZE(loc_gen_mutex);
+
+/** Note a change of the service/category namespace. */
+static void loc_gen_bump(void)
+{
+	fibril_mutex_lock(&loc_gen_mutex);
+	loc_gen++;
+	fibril_mutex_unlock(&loc_gen_mutex);
+}
+
+static sysarg_t loc_gen_get(void)
+{
+	fibril_mutex_lock(&loc_gen_mutex);
+	sysarg_t gen = loc_gen;
+	fibril_mutex_unlock(&loc_gen_mutex);
+	return gen;
+}
+
 service_id_t loc_create_id(void)
 {
 	/*
@@ -312,6 +337,7 @@ static void loc_service_unregister_core(loc_service_t *service)
 	assert(fibril_mutex_is_locked(&services_list_mutex));
 	assert(fibril_mutex_is_locked(&cdir.mutex));
 
+	loc_gen_bump();
 	loc_namespace_delref(service->namespace);
 	list_remove(&(service->services));
 	list_remove(&(service->server_services));
@@ -524,6 +550,7 @@ static void loc_service_register(ipc_call_t *icall, loc_server_t *server)
 	service->server = server;
 
 	/* Insert service into list of all services  */
+	loc_gen_bump();
 	list_append(&service->services, &services_list);
 
 	/* Insert service into list of services supplied by one server */
@@ -881,11 +908,15 @@ static void loc_callback_create(ipc_call_t *icall)
 
 void loc_category_change_event(void)
 {
+	loc_gen_bump();
+
+	const sysarg_t gen = loc_gen_get();
+
 	fibril_mutex_lock(&callback_sess_mutex);
 
 	list_foreach(callback_sess_list, cb_sess_list, cb_sess_t, cb_sess) {
 		async_exch_t *exch = async_exchange_begin(cb_sess->sess);
-		async_msg_0(exch, LOC_EVENT_CAT_CHANGE);
+		async_msg_1(exch, LOC_EVENT_CAT_CHANGE, gen);
 		async_exchange_end(exch);
 	}
 
@@ -1005,6 +1036,12 @@ static void loc_get_categories(ipc_call_t *icall)
 	async_answer_1(icall, retval, act_size);
 }
 
+/** Answer the current namespace generation. */
+static void loc_get_generation(ipc_call_t *icall)
+{
+	async_answer_1(icall, EOK, loc_gen_get());
+}
+
 static void loc_get_namespaces(ipc_call_t *icall)
 {
 	ipc_call_t call;
@@ -1234,6 +1271,7 @@ static void loc_null_create(ipc_call_t *icall)
 	 * Insert service into a dummy list of null server's services so that it
 	 * can be safely removed later.
 	 */
+	loc_gen_bump();
 	list_append(&service->services, &services_list);
 	list_append(&service->server_services, &dummy_null_services);
 	null_services[i] = service;
@@ -1525,6 +1563,9 @@ static void loc_connection_consumer(ipc_call_t *icall, void *arg)
 		case LOC_GET_SERVICES:
 			loc_get_services(&call);
 			break;
+		case LOC_GET_GENERATION:
+			loc_get_generation(&call);
+			break;
 		default:
 			async_answer_0(&call, ENOENT);
 		}
@@ -58,6 +58,11 @@ typedef struct {
 	fibril_mutex_t guard;
 	char *filename;
 	FILE *logfile;
+	/** Buffered messages not yet written to the log file */
+	char *buffer;
+	size_t buffer_used;
+	/** Link into the list of destinations swept by the flusher */
+	link_t link;
 } logger_dest_t;
 
 struct logger_log {
@@ -102,6 +107,8 @@ void logger_connection_handler_writer(ipc_call_t *);
 void parse_initial_settings(void);
 void parse_level_settings(char *);
 
+errno_t log_flusher_start(void);
+
 #endif
 
 /** @}
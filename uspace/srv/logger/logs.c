@@ -31,6 +31,7 @@
  */
 #include <assert.h>
 #include <errno.h>
+#include <fibril.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <str.h>
@@ -39,6 +40,65 @@
 static FIBRIL_MUTEX_INITIALIZE(log_list_guard);
 static LIST_INITIALIZE(log_list);
 
+/*
+ * Messages are appended to a per-destination buffer and written to the
+ * log file by the flusher fibril, so that a client logging a message
+ * never waits on VFS. The buffer is flushed early when a message would
+ * not fit.
+ */
+#define DEST_BUFFER_SIZE  8192
+/** How often the flusher fibril writes buffered messages out */
+#define DEST_FLUSH_PERIOD_USEC  100000
+
+static FIBRIL_MUTEX_INITIALIZE(dest_list_guard);
+static LIST_INITIALIZE(dest_list);
+
+/** Write out buffered messages. Caller must hold the dest guard. */
+static void dest_flush_locked(logger_dest_t *dest)
+{
+	if (dest->buffer_used == 0)
+		return;
+
+	if (dest->logfile == NULL)
+		dest->logfile = fopen(dest->filename, "a");
+
+	if (dest->logfile != NULL) {
+		fwrite(dest->buffer, 1, dest->buffer_used, dest->logfile);
+		fflush(dest->logfile);
+	}
+
+	/* Drop the messages even on failure to bound the buffer. */
+	dest->buffer_used = 0;
+}
+
+static errno_t log_flusher_fibril(void *arg)
+{
+	while (true) {
+		fibril_usleep(DEST_FLUSH_PERIOD_USEC);
+
+		fibril_mutex_lock(&dest_list_guard);
+		list_foreach(dest_list, link, logger_dest_t, dest) {
+			fibril_mutex_lock(&dest->guard);
+			dest_flush_locked(dest);
+			fibril_mutex_unlock(&dest->guard);
+		}
+		fibril_mutex_unlock(&dest_list_guard);
+	}
+
+	return EOK;
+}
+
+/** Start the fibril that periodically flushes buffered messages. */
+errno_t log_flusher_start(void)
+{
+	fid_t fid = fibril_create(log_flusher_fibril, NULL);
+	if (fid == 0)
+		return ENOMEM;
+
+	fibril_add_ready(fid);
+	return EOK;
+}
+
 static logger_log_t *find_log_by_name_and_parent_no_list_lock(const char *name, logger_log_t *parent)
 {
 	list_foreach(log_list, link, logger_log_t, log) {
@@ -60,6 +120,16 @@ static errno_t create_dest(const char *name, logger_dest_t **dest)
 	}
 	result->logfile = NULL;
 	fibril_mutex_initialize(&result->guard);
+
+	/* Without the buffer messages are simply written synchronously. */
+	result->buffer = malloc(DEST_BUFFER_SIZE);
+	result->buffer_used = 0;
+
+	link_initialize(&result->link);
+	fibril_mutex_lock(&dest_list_guard);
+	list_append(&result->link, &dest_list);
+	fibril_mutex_unlock(&dest_list_guard);
+
 	*dest = result;
 	return EOK;
 }
@@ -260,6 +330,14 @@ void log_release(logger_log_t *log)
 	fibril_mutex_unlock(&log->guard);
 
 	if (log->parent == NULL) {
+		fibril_mutex_lock(&dest_list_guard);
+		list_remove(&log->dest->link);
+		fibril_mutex_unlock(&dest_list_guard);
+
+		fibril_mutex_lock(&log->dest->guard);
+		dest_flush_locked(log->dest);
+		fibril_mutex_unlock(&log->dest->guard);
+
 		/*
 		 * Due to lazy file opening in write_to_log(),
 		 * it is possible that no file was actually opened.
@@ -267,6 +345,7 @@ void log_release(logger_log_t *log)
 		if (log->dest->logfile != NULL) {
 			fclose(log->dest->logfile);
 		}
+		free(log->dest->buffer);
 		free(log->dest->filename);
 		free(log->dest);
 	} else {
@@ -284,20 +363,47 @@ void log_release(logger_log_t *log)
 
 void write_to_log(logger_log_t *log, log_level_t level, const char *message)
 {
+	logger_dest_t *dest = log->dest;
+
 	assert(fibril_mutex_is_locked(&log->guard));
-	assert(log->dest != NULL);
-	fibril_mutex_lock(&log->dest->guard);
-	if (log->dest->logfile == NULL)
-		log->dest->logfile = fopen(log->dest->filename, "a");
+	assert(dest != NULL);
+	fibril_mutex_lock(&dest->guard);
+
+	if (dest->buffer != NULL) {
+		/* "[full_name] level: message\n" and the terminating nul */
+		const size_t needed = str_size(log->full_name) +
+		    str_size(log_level_str(level)) + str_size(message) + 6;
+
+		if (needed + 1 <= DEST_BUFFER_SIZE) {
+			if (dest->buffer_used + needed + 1 > DEST_BUFFER_SIZE)
+				dest_flush_locked(dest);
+
+			int n = snprintf(dest->buffer + dest->buffer_used,
+			    DEST_BUFFER_SIZE - dest->buffer_used,
+			    "[%s] %s: %s\n", log->full_name,
+			    log_level_str(level), message);
+			if (n > 0)
+				dest->buffer_used += n;
+
+			fibril_mutex_unlock(&dest->guard);
+			return;
+		}
+
+		/* Oversized message, write it out directly. */
+		dest_flush_locked(dest);
+	}
+
+	if (dest->logfile == NULL)
+		dest->logfile = fopen(dest->filename, "a");
 
-	if (log->dest->logfile != NULL) {
-		fprintf(log->dest->logfile, "[%s] %s: %s\n",
+	if (dest->logfile != NULL) {
+		fprintf(dest->logfile, "[%s] %s: %s\n",
 		    log->full_name, log_level_str(level),
 		    (const char *) message);
-		fflush(log->dest->logfile);
+		fflush(dest->logfile);
 	}
 
-	fibril_mutex_unlock(&log->dest->guard);
+	fibril_mutex_unlock(&dest->guard);
 }
 
 void registered_logs_init(logger_registered_logs_t *logs)
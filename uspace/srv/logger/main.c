@@ -81,6 +81,13 @@ int main(int argc, char *argv[])
 		return -1;
 	}
 
+	rc = log_flusher_start();
+	if (rc != EOK) {
+		printf("%s: Failed to start the flusher: %s.\n", NAME,
+		    str_error(rc));
+		return -1;
+	}
+
 	printf("%s: Accepting connections\n", NAME);
 	async_manager();
 
@@ -39,6 +39,7 @@
 #include <byteorder.h>
 #include <errno.h>
 #include <str_error.h>
+#include <fibril.h>
 #include <fibril_synch.h>
 #include <inet/addr.h>
 #include <inet/eth_addr.h>
@@ -50,6 +51,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <str.h>
+#include <time.h>
 
 #include "dhcp.h"
 #include "dhcp_std.h"
@@ -65,7 +67,6 @@ enum {
 };
 
 #define MAX_MSG_SIZE 1024
-static uint8_t msgbuf[MAX_MSG_SIZE];
 
 /** List of registered links (of dhcp_link_t) */
 static list_t dhcp_links;
@@ -108,8 +109,18 @@ typedef struct {
 	inet_link_info_t link_info;
 	/** Transport */
 	dhcp_transport_t dt;
-	/** Transport timeout */
-	fibril_timer_t *timeout;
+	/** Timer wheel deadline (valid when timer_armed) */
+	struct timespec deadline;
+	/** Timer wheel expiration function */
+	void (*expire)(void *);
+	/** Whether the link has a pending deadline */
+	bool timer_armed;
+	/** Cached DHCPDISCOVER message */
+	uint8_t discover_msg[MAX_MSG_SIZE];
+	size_t discover_size;
+	/** Cached DHCPREQUEST message */
+	uint8_t request_msg[MAX_MSG_SIZE];
+	size_t request_size;
 	/** Number of retries */
 	int retries_left;
 	/** Link state */
@@ -122,6 +133,91 @@ typedef struct {
 
 static void dhcpsrv_recv(void *, void *, size_t);
 
+/*
+ * One timer wheel serves the retransmission deadlines of all
+ * links: a single fibril sleeps until the earliest deadline and
+ * fires the due links one by one, instead of every link keeping
+ * its own timer fibril (and a 50-link appliance waking 50 fibrils
+ * at once every lease interval). Deadlines carry a per-link
+ * random jitter, spreading simultaneous expirations apart.
+ */
+
+static FIBRIL_MUTEX_INITIALIZE(dhcp_timer_lock);
+static FIBRIL_CONDVAR_INITIALIZE(dhcp_timer_cv);
+
+/** Arm a link's retransmission deadline on the timer wheel */
+static void dhcp_timer_arm(dhcp_link_t *dlink, usec_t delay,
+    void (*expire)(void *))
+{
+	struct timespec now;
+	uint32_t jitter = 0;
+
+	getuptime(&now);
+
+	/* Up to an eighth of the delay of burst-suppression jitter */
+	(void) rndgen_uint32(dlink->rndgen, &jitter);
+	delay += jitter % (delay / 8 + 1);
+
+	fibril_mutex_lock(&dhcp_timer_lock);
+	dlink->deadline = now;
+	ts_add_diff(&dlink->deadline, USEC2NSEC(delay));
+	dlink->expire = expire;
+	dlink->timer_armed = true;
+	fibril_condvar_signal(&dhcp_timer_cv);
+	fibril_mutex_unlock(&dhcp_timer_lock);
+}
+
+/** Cancel a link's pending deadline */
+static void dhcp_timer_disarm(dhcp_link_t *dlink)
+{
+	fibril_mutex_lock(&dhcp_timer_lock);
+	dlink->timer_armed = false;
+	fibril_condvar_signal(&dhcp_timer_cv);
+	fibril_mutex_unlock(&dhcp_timer_lock);
+}
+
+/** The timer wheel fibril */
+static errno_t dhcp_timer_fibril(void *arg)
+{
+	while (true) {
+		fibril_mutex_lock(&dhcp_timer_lock);
+
+		dhcp_link_t *first = NULL;
+		list_foreach(dhcp_links, links, dhcp_link_t, dlink) {
+			if (!dlink->timer_armed)
+				continue;
+			if (first == NULL ||
+			    ts_gt(&first->deadline, &dlink->deadline))
+				first = dlink;
+		}
+
+		if (first == NULL) {
+			fibril_condvar_wait(&dhcp_timer_cv, &dhcp_timer_lock);
+			fibril_mutex_unlock(&dhcp_timer_lock);
+			continue;
+		}
+
+		struct timespec now;
+		getuptime(&now);
+
+		if (ts_gt(&first->deadline, &now)) {
+			(void) fibril_condvar_wait_timeout(&dhcp_timer_cv,
+			    &dhcp_timer_lock,
+			    NSEC2USEC(ts_sub_diff(&first->deadline, &now)));
+			fibril_mutex_unlock(&dhcp_timer_lock);
+			continue;
+		}
+
+		first->timer_armed = false;
+		void (*expire)(void *) = first->expire;
+		fibril_mutex_unlock(&dhcp_timer_lock);
+
+		expire(first);
+	}
+
+	return EOK;
+}
+
 /** Decode subnet mask into subnet prefix length. */
 static errno_t subnet_mask_decode(uint32_t mask, int *bits)
 {
@@ -156,17 +252,23 @@ static uint32_t dhcp_uint32_decode(uint8_t *data)
 
 static errno_t dhcp_send_discover(dhcp_link_t *dlink)
 {
-	dhcp_hdr_t *hdr = (dhcp_hdr_t *)msgbuf;
-	uint8_t *opt = msgbuf + sizeof(dhcp_hdr_t);
+	dhcp_hdr_t *hdr = (dhcp_hdr_t *)dlink->discover_msg;
+	uint8_t *opt = dlink->discover_msg + sizeof(dhcp_hdr_t);
 	uint32_t xid;
 	errno_t rc;
 	size_t i;
 
+	/* Retransmissions reuse the composed message (and xid). */
+	if (dlink->discover_size != 0) {
+		return dhcp_send(&dlink->dt, dlink->discover_msg,
+		    dlink->discover_size);
+	}
+
 	rc = rndgen_uint32(dlink->rndgen, &xid);
 	if (rc != EOK)
 		return rc;
 
-	memset(msgbuf, 0, MAX_MSG_SIZE);
+	memset(dlink->discover_msg, 0, MAX_MSG_SIZE);
 	hdr->op = op_bootrequest;
 	hdr->htype = 1; /* AHRD_ETHERNET */
 	hdr->hlen = ETH_ADDR_SIZE;
@@ -190,16 +292,24 @@ static errno_t dhcp_send_discover(dhcp_link_t *dlink)
 
 	opt[i++] = opt_end;
 
-	return dhcp_send(&dlink->dt, msgbuf, sizeof(dhcp_hdr_t) + i);
+	dlink->discover_size = sizeof(dhcp_hdr_t) + i;
+	return dhcp_send(&dlink->dt, dlink->discover_msg,
+	    dlink->discover_size);
 }
 
 static errno_t dhcp_send_request(dhcp_link_t *dlink, dhcp_offer_t *offer)
 {
-	dhcp_hdr_t *hdr = (dhcp_hdr_t *)msgbuf;
-	uint8_t *opt = msgbuf + sizeof(dhcp_hdr_t);
+	dhcp_hdr_t *hdr = (dhcp_hdr_t *)dlink->request_msg;
+	uint8_t *opt = dlink->request_msg + sizeof(dhcp_hdr_t);
 	size_t i;
 
-	memset(msgbuf, 0, MAX_MSG_SIZE);
+	/* Retransmissions reuse the composed message. */
+	if (dlink->request_size != 0) {
+		return dhcp_send(&dlink->dt, dlink->request_msg,
+		    dlink->request_size);
+	}
+
+	memset(dlink->request_msg, 0, MAX_MSG_SIZE);
 	hdr->op = op_bootrequest;
 	hdr->htype = 1; /* AHRD_ETHERNET */
 	hdr->hlen = 6;
@@ -230,7 +340,9 @@ static errno_t dhcp_send_request(dhcp_link_t *dlink, dhcp_offer_t *offer)
 
 	opt[i++] = opt_end;
 
-	return dhcp_send(&dlink->dt, msgbuf, sizeof(dhcp_hdr_t) + i);
+	dlink->request_size = sizeof(dhcp_hdr_t) + i;
+	return dhcp_send(&dlink->dt, dlink->request_msg,
+	    dlink->request_size);
 }
 
 static errno_t dhcp_parse_reply(void *msg, size_t size, dhcp_offer_t *offer)
@@ -423,6 +535,12 @@ static errno_t dhcp_cfg_create(service_id_t iplink, dhcp_offer_t *offer)
 void dhcpsrv_links_init(void)
 {
 	list_initialize(&dhcp_links);
+
+	fid_t fid = fibril_create(dhcp_timer_fibril, NULL);
+	if (fid != 0)
+		fibril_add_ready(fid);
+	else
+		log_msg(LOG_DEFAULT, LVL_ERROR, "Error creating timer fibril");
 }
 
 static dhcp_link_t *dhcpsrv_link_find(service_id_t link_id)
@@ -445,17 +563,16 @@ static void dhcp_link_set_failed(dhcp_link_t *dlink)
 static errno_t dhcp_discover_proc(dhcp_link_t *dlink)
 {
 	dlink->state = ds_selecting;
+	/* New transaction: compose a fresh message (and xid). */
+	dlink->discover_size = 0;
 
 	errno_t rc = dhcp_send_discover(dlink);
 	if (rc != EOK)
 		return EIO;
 
 	dlink->retries_left = dhcp_discover_retries;
-
-	if ((dlink->timeout->state == fts_not_set) ||
-	    (dlink->timeout->state == fts_fired))
-		fibril_timer_set(dlink->timeout, dhcp_discover_timeout_val,
-		    dhcpsrv_discover_timeout, dlink);
+	dhcp_timer_arm(dlink, dhcp_discover_timeout_val,
+	    dhcpsrv_discover_timeout);
 
 	return rc;
 }
@@ -482,11 +599,6 @@ errno_t dhcpsrv_link_add(service_id_t link_id)
 		goto error;
 
 	dlink->link_id = link_id;
-	dlink->timeout = fibril_timer_create(NULL);
-	if (dlink->timeout == NULL) {
-		rc = ENOMEM;
-		goto error;
-	}
 
 	/* Get link hardware address */
 	rc = inetcfg_link_get(link_id, &dlink->link_info);
@@ -520,8 +632,6 @@ errno_t dhcpsrv_link_add(service_id_t link_id)
 error:
 	if (dlink != NULL && dlink->rndgen != NULL)
 		rndgen_destroy(dlink->rndgen);
-	if (dlink != NULL && dlink->timeout != NULL)
-		fibril_timer_destroy(dlink->timeout);
 	free(dlink);
 	return rc;
 }
@@ -556,9 +666,11 @@ static void dhcpsrv_recv_offer(dhcp_link_t *dlink, dhcp_offer_t *offer)
 		return;
 	}
 
-	fibril_timer_clear(dlink->timeout);
+	dhcp_timer_disarm(dlink);
 	dlink->offer = *offer;
 	dlink->state = ds_requesting;
+	/* The offer determines the request message contents. */
+	dlink->request_size = 0;
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "Send DHCPREQUEST");
 	rc = dhcp_send_request(dlink, offer);
@@ -568,8 +680,8 @@ static void dhcpsrv_recv_offer(dhcp_link_t *dlink, dhcp_offer_t *offer)
 	}
 
 	dlink->retries_left = dhcp_request_retries;
-	fibril_timer_set(dlink->timeout, dhcp_request_timeout_val,
-	    dhcpsrv_request_timeout, dlink);
+	dhcp_timer_arm(dlink, dhcp_request_timeout_val,
+	    dhcpsrv_request_timeout);
 }
 
 static void dhcpsrv_recv_ack(dhcp_link_t *dlink, dhcp_offer_t *offer)
@@ -582,7 +694,7 @@ static void dhcpsrv_recv_ack(dhcp_link_t *dlink, dhcp_offer_t *offer)
 		return;
 	}
 
-	fibril_timer_clear(dlink->timeout);
+	dhcp_timer_disarm(dlink);
 	dlink->offer = *offer;
 	dlink->state = ds_bound;
 
@@ -649,8 +761,8 @@ static void dhcpsrv_discover_timeout(void *arg)
 		return;
 	}
 
-	fibril_timer_set(dlink->timeout, dhcp_discover_timeout_val,
-	    dhcpsrv_discover_timeout, dlink);
+	dhcp_timer_arm(dlink, dhcp_discover_timeout_val,
+	    dhcpsrv_discover_timeout);
 }
 
 static void dhcpsrv_request_timeout(void *arg)
@@ -677,8 +789,8 @@ static void dhcpsrv_request_timeout(void *arg)
 		return;
 	}
 
-	fibril_timer_set(dlink->timeout, dhcp_request_timeout_val,
-	    dhcpsrv_request_timeout, dlink);
+	dhcp_timer_arm(dlink, dhcp_request_timeout_val,
+	    dhcpsrv_request_timeout);
 }
 
 /** @}
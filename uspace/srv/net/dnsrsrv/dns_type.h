@@ -116,6 +116,8 @@ typedef struct {
 	char *cname;
 	/** Host address */
 	inet_addr_t addr;
+	/** Time to live of the answer (seconds) */
+	uint32_t ttl;
 } dns_host_info_t;
 
 typedef struct {
@@ -34,10 +34,12 @@
  */
 
 #include <errno.h>
+#include <fibril_synch.h>
 #include <io/log.h>
 #include <mem.h>
 #include <stdlib.h>
 #include <str.h>
+#include <time.h>
 #include "dns_msg.h"
 #include "dns_std.h"
 #include "dns_type.h"
@@ -46,6 +48,111 @@
 
 static uint16_t msg_id;
 
+/*
+ * Resolver cache.
+ *
+ * Successful resolutions are remembered until their TTL expires, so
+ * repeated lookups of the same name (web pages alone ask many times
+ * over) skip the network round trip. Direct-mapped, keyed by name
+ * and requested address version.
+ */
+
+#define DNS_CACHE_SIZE  16
+
+typedef struct {
+	bool valid;
+	char *name;
+	ip_ver_t ver;
+	dns_host_info_t info;
+	struct timespec expires;
+} dns_cache_entry_t;
+
+static dns_cache_entry_t dns_cache[DNS_CACHE_SIZE];
+static FIBRIL_MUTEX_INITIALIZE(dns_cache_lock);
+
+static size_t dns_cache_slot(const char *name, ip_ver_t ver)
+{
+	size_t hash = (size_t) ver;
+
+	for (const char *p = name; *p != 0; p++)
+		hash = hash * 33 + (uint8_t) *p;
+
+	return hash % DNS_CACHE_SIZE;
+}
+
+/** Look up a cached resolution.
+ *
+ * @return Duplicated host info (caller owns it) or NULL.
+ */
+static dns_host_info_t *dns_cache_lookup(const char *name, ip_ver_t ver)
+{
+	struct timespec now;
+	getuptime(&now);
+
+	fibril_mutex_lock(&dns_cache_lock);
+
+	dns_cache_entry_t *e = &dns_cache[dns_cache_slot(name, ver)];
+	if ((!e->valid) || (e->ver != ver) ||
+	    (str_cmp(e->name, name) != 0) ||
+	    (ts_gteq(&now, &e->expires))) {
+		fibril_mutex_unlock(&dns_cache_lock);
+		return NULL;
+	}
+
+	dns_host_info_t *info = calloc(1, sizeof(dns_host_info_t));
+	if (info != NULL) {
+		info->cname = str_dup(e->info.cname);
+		info->addr = e->info.addr;
+		info->ttl = e->info.ttl;
+
+		if (info->cname == NULL) {
+			free(info);
+			info = NULL;
+		}
+	}
+
+	fibril_mutex_unlock(&dns_cache_lock);
+	return info;
+}
+
+/** Remember a successful resolution until its TTL expires. */
+static void dns_cache_insert(const char *name, ip_ver_t ver,
+    dns_host_info_t *info)
+{
+	if (info->ttl == 0)
+		return;
+
+	char *cname = str_dup(info->cname);
+	char *ename = str_dup(name);
+	if ((cname == NULL) || (ename == NULL)) {
+		free(cname);
+		free(ename);
+		return;
+	}
+
+	struct timespec expires;
+	getuptime(&expires);
+	expires.tv_sec += info->ttl;
+
+	fibril_mutex_lock(&dns_cache_lock);
+
+	dns_cache_entry_t *e = &dns_cache[dns_cache_slot(name, ver)];
+	if (e->valid) {
+		free(e->name);
+		free(e->info.cname);
+	}
+
+	e->valid = true;
+	e->name = ename;
+	e->ver = ver;
+	e->info.cname = cname;
+	e->info.addr = info->addr;
+	e->info.ttl = info->ttl;
+	e->expires = expires;
+
+	fibril_mutex_unlock(&dns_cache_lock);
+}
+
 static errno_t dns_name_query(const char *name, dns_qtype_t qtype,
     dns_host_info_t *info)
 {
@@ -146,6 +253,7 @@ static errno_t dns_name_query(const char *name, dns_qtype_t qtype,
 
 			inet_addr_set(dns_uint32_t_decode(rr->rdata, rr->rdata_size),
 			    &info->addr);
+			info->ttl = rr->ttl;
 
 			dns_message_destroy(msg);
 			dns_message_destroy(amsg);
@@ -171,6 +279,7 @@ static errno_t dns_name_query(const char *name, dns_qtype_t qtype,
 			dns_addr128_t_decode(rr->rdata, rr->rdata_size, addr);
 
 			inet_addr_set6(addr, &info->addr);
+			info->ttl = rr->ttl;
 
 			dns_message_destroy(msg);
 			dns_message_destroy(amsg);
@@ -191,6 +300,13 @@ static errno_t dns_name_query(const char *name, dns_qtype_t qtype,
 
 errno_t dns_name2host(const char *name, dns_host_info_t **rinfo, ip_ver_t ver)
 {
+	/* Serve from the cache while the TTL lasts. */
+	dns_host_info_t *cached = dns_cache_lookup(name, ver);
+	if (cached != NULL) {
+		*rinfo = cached;
+		return EOK;
+	}
+
 	dns_host_info_t *info = calloc(1, sizeof(dns_host_info_t));
 	if (info == NULL)
 		return ENOMEM;
@@ -215,10 +331,12 @@ errno_t dns_name2host(const char *name, dns_host_info_t **rinfo, ip_ver_t ver)
 		rc = EINVAL;
 	}
 
-	if (rc == EOK)
+	if (rc == EOK) {
+		dns_cache_insert(name, ver, info);
 		*rinfo = info;
-	else
+	} else {
 		free(info);
+	}
 
 	return rc;
 }
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup ethip
+ * @{
+ */
+/**
+ * @file
+ * @brief Layer 2 forwarding fast path.
+ *
+ * When ethip drives more than one NIC, frames whose destination is
+ * another segment are forwarded NIC-to-NIC right here, without
+ * ever crossing into inetsrv: source addresses seen on received
+ * frames populate a station table (hash on the 48-bit address) and
+ * matched frames go straight out the NIC the station was learned
+ * on. Unknown unicast and group addresses are flooded to the other
+ * NICs, like in any learning bridge.
+ */
+
+#include <adt/hash_table.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <inet/eth_addr.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "bridge.h"
+#include "ethip.h"
+#include "ethip_nic.h"
+
+/** Cap on learned stations; the table is flushed when exceeded */
+#define BRIDGE_MAX_STATIONS  256
+
+/** Individual/group bit of an Ethernet address */
+#define ETH_ADDR_GROUP_BIT  UINT64_C(0x010000000000)
+
+/** One learned station */
+typedef struct {
+	ht_link_t link;
+	/** Station address */
+	uint64_t addr;
+	/** NIC the station was last seen on */
+	ethip_nic_t *nic;
+} bridge_station_t;
+
+static hash_table_t bridge_stations;
+static size_t bridge_station_count;
+static FIBRIL_MUTEX_INITIALIZE(bridge_lock);
+
+static size_t bridge_key_hash(const void *key)
+{
+	const uint64_t *addr = key;
+	return *addr;
+}
+
+static size_t bridge_hash(const ht_link_t *item)
+{
+	bridge_station_t *station =
+	    hash_table_get_inst(item, bridge_station_t, link);
+	return station->addr;
+}
+
+static bool bridge_key_equal(const void *key, const ht_link_t *item)
+{
+	const uint64_t *addr = key;
+	bridge_station_t *station =
+	    hash_table_get_inst(item, bridge_station_t, link);
+	return station->addr == *addr;
+}
+
+static void bridge_remove_cb(ht_link_t *item)
+{
+	free(hash_table_get_inst(item, bridge_station_t, link));
+}
+
+static const hash_table_ops_t bridge_ops = {
+	.hash = bridge_hash,
+	.key_hash = bridge_key_hash,
+	.key_equal = bridge_key_equal,
+	.equal = NULL,
+	.remove_callback = bridge_remove_cb
+};
+
+/** Initialize the bridge station table */
+void ethip_bridge_init(void)
+{
+	hash_table_create(&bridge_stations, 0, 0, &bridge_ops);
+	bridge_station_count = 0;
+}
+
+/** Learn or refresh a station. Bridge lock held. */
+static void bridge_learn(ethip_nic_t *nic, const eth_addr_t *addr)
+{
+	uint64_t key = addr->a;
+
+	if ((key & ETH_ADDR_GROUP_BIT) != 0)
+		return;
+
+	ht_link_t *link = hash_table_find(&bridge_stations, &key);
+	if (link != NULL) {
+		hash_table_get_inst(link, bridge_station_t, link)->nic = nic;
+		return;
+	}
+
+	if (bridge_station_count >= BRIDGE_MAX_STATIONS) {
+		/* Crude aging: start over and re-learn. */
+		hash_table_clear(&bridge_stations);
+		bridge_station_count = 0;
+	}
+
+	bridge_station_t *station = malloc(sizeof(bridge_station_t));
+	if (station == NULL)
+		return;
+
+	station->addr = key;
+	station->nic = nic;
+	hash_table_insert(&bridge_stations, &station->link);
+	bridge_station_count++;
+}
+
+/** Look a station up. Bridge lock held. */
+static ethip_nic_t *bridge_lookup(const eth_addr_t *addr)
+{
+	uint64_t key = addr->a;
+
+	ht_link_t *link = hash_table_find(&bridge_stations, &key);
+	if (link == NULL)
+		return NULL;
+
+	return hash_table_get_inst(link, bridge_station_t, link)->nic;
+}
+
+/** Bridge a received frame.
+ *
+ * Learns the source station and, when the frame is not addressed
+ * to the receiving NIC, forwards or floods it to the other NICs.
+ *
+ * @param nic NIC the frame arrived on.
+ * @param data Raw frame.
+ * @param size Frame size.
+ * @param frame Decoded frame header.
+ *
+ * @return @c true when the frame was consumed by forwarding and
+ *         must not be delivered to the local stack, @c false when
+ *         local processing should continue.
+ *
+ */
+bool ethip_bridge_handle(ethip_nic_t *nic, void *data, size_t size,
+    eth_frame_t *frame)
+{
+	/* With a single NIC there is nothing to bridge. */
+	if (ethip_nic_count() < 2)
+		return false;
+
+	fibril_mutex_lock(&bridge_lock);
+	bridge_learn(nic, &frame->src);
+
+	if (eth_addr_compare(&frame->dest, &nic->mac_addr) == 0) {
+		/* Addressed to us. */
+		fibril_mutex_unlock(&bridge_lock);
+		return false;
+	}
+
+	if ((frame->dest.a & ETH_ADDR_GROUP_BIT) != 0) {
+		/*
+		 * Broadcast/multicast: copy to the other segments
+		 * and let the local stack see it too (ARP etc.).
+		 */
+		fibril_mutex_unlock(&bridge_lock);
+		ethip_nic_bridge_flood(nic, data, size);
+		return false;
+	}
+
+	ethip_nic_t *out = bridge_lookup(&frame->dest);
+	fibril_mutex_unlock(&bridge_lock);
+
+	if (out == nic) {
+		/* Same segment; the destination heard it already. */
+		return true;
+	}
+
+	if (out != NULL) {
+		(void) ethip_nic_send(out, data, size);
+		return true;
+	}
+
+	/* Unknown station: flood the other segments. */
+	ethip_nic_bridge_flood(nic, data, size);
+	return true;
+}
+
+/** @}
+ */
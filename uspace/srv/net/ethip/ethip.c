@@ -46,6 +46,7 @@
 #include <stdlib.h>
 #include <task.h>
 #include "arp.h"
+#include "bridge.h"
 #include "ethip.h"
 #include "ethip_nic.h"
 #include "pdu.h"
@@ -240,6 +241,13 @@ errno_t ethip_received(iplink_srv_t *srv, void *data, size_t size)
 		return rc;
 	}
 
+	/*
+	 * Fast path: frames belonging to another segment are
+	 * forwarded NIC-to-NIC here, never reaching inetsrv.
+	 */
+	if (ethip_bridge_handle(nic, data, size, &frame))
+		return EOK;
+
 	iplink_recv_sdu_t sdu;
 
 	switch (frame.etype_len) {
@@ -265,7 +273,7 @@ errno_t ethip_received(iplink_srv_t *srv, void *data, size_t size)
 		    frame.etype_len);
 	}
 
-	free(frame.data);
+	/* frame.data aliases the received buffer owned by the caller. */
 	return rc;
 }
 
@@ -321,6 +329,8 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
+	ethip_bridge_init();
+
 	rc = ethip_init();
 	if (rc != EOK)
 		return 1;
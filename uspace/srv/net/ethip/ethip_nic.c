@@ -209,6 +209,22 @@ static errno_t ethip_nic_open(service_id_t sid)
 		goto error;
 	}
 
+	/*
+	 * With multiple NICs we bridge between the segments, which
+	 * requires seeing frames addressed to other stations.
+	 */
+	if (list_count(&ethip_nic_list) >= 2) {
+		list_foreach(ethip_nic_list, link, ethip_nic_t, pnic) {
+			rc = nic_unicast_set_mode(pnic->sess,
+			    NIC_UNICAST_PROMISC, NULL, 0);
+			if (rc != EOK) {
+				log_msg(LOG_DEFAULT, LVL_WARN, "Cannot enable "
+				    "promiscuous mode on '%s'; bridging "
+				    "limited to broadcast.", pnic->svc_name);
+			}
+		}
+	}
+
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "Initialized IP link service,");
 
 	return EOK;
@@ -350,6 +366,21 @@ ethip_nic_t *ethip_nic_find_by_iplink_sid(service_id_t iplink_sid)
 	return NULL;
 }
 
+/** Number of NICs currently attached */
+size_t ethip_nic_count(void)
+{
+	return list_count(&ethip_nic_list);
+}
+
+/** Send a raw frame out of every NIC except @a src */
+void ethip_nic_bridge_flood(ethip_nic_t *src, void *data, size_t size)
+{
+	list_foreach(ethip_nic_list, link, ethip_nic_t, nic) {
+		if (nic != src)
+			(void) ethip_nic_send(nic, data, size);
+	}
+}
+
 errno_t ethip_nic_send(ethip_nic_t *nic, void *data, size_t size)
 {
 	errno_t rc;
@@ -39,6 +39,7 @@
 #include <inet/eth_addr.h>
 #include <io/log.h>
 #include <mem.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include "ntrans.h"
 #include "addrobj.h"
@@ -161,9 +162,8 @@ errno_t ndp_translate(addr128_t src_addr, addr128_t ip_addr, eth_addr_t *mac_add
 		return EOK;
 	}
 
-	errno_t rc = ntrans_lookup(ip_addr, mac_addr);
-	if (rc == EOK)
-		return EOK;
+	bool want_refresh = false;
+	errno_t rc = ntrans_lookup_ex(ip_addr, mac_addr, &want_refresh);
 
 	ndp_packet_t packet;
 
@@ -174,11 +174,34 @@ errno_t ndp_translate(addr128_t src_addr, addr128_t ip_addr, eth_addr_t *mac_add
 	eth_addr_solicited_node(ip_addr, &packet.target_hw_addr);
 	ndp_solicited_node_ip(ip_addr, packet.target_proto_addr);
 
+	if (rc == EOK) {
+		/*
+		 * Proactive refresh: keep answering from the cache,
+		 * just fire a solicitation so the entry is renewed
+		 * before it expires - no one stalls on the reply.
+		 */
+		if (want_refresh)
+			(void) ndp_send_packet(ilink, &packet);
+
+		return EOK;
+	}
+
+	/* Recently failed; don't solicit again for every packet. */
+	if (rc == EHOSTUNREACH)
+		return rc;
+
 	rc = ndp_send_packet(ilink, &packet);
 	if (rc != EOK)
 		return rc;
 
 	(void) ntrans_wait_timeout(NDP_REQUEST_TIMEOUT);
 
-	return ntrans_lookup(ip_addr, mac_addr);
+	rc = ntrans_lookup(ip_addr, mac_addr);
+	if (rc != EOK) {
+		/* Remember the failure to fail fast for a while. */
+		(void) ntrans_add_failed(ip_addr);
+		rc = EHOSTUNREACH;
+	}
+
+	return rc;
 }
@@ -40,7 +40,9 @@
 #include <fibril_synch.h>
 #include <inet/eth_addr.h>
 #include <inet/iplink_srv.h>
+#include <stdbool.h>
 #include <stdlib.h>
+#include <time.h>
 #include "ntrans.h"
 
 /** Address translation list (of inet_ntrans_t) */
@@ -48,6 +50,13 @@ static FIBRIL_MUTEX_INITIALIZE(ntrans_list_lock);
 static LIST_INITIALIZE(ntrans_list);
 static FIBRIL_CONDVAR_INITIALIZE(ntrans_cv);
 
+/** How long a resolved entry is served without any refresh (secs) */
+#define NTRANS_VALID_SECS  60
+/** Age at which a served entry asks for a background refresh (secs) */
+#define NTRANS_REFRESH_SECS  25
+/** How long a failed resolution is answered from the cache (secs) */
+#define NTRANS_NEGATIVE_SECS  3
+
 /** Look for address in translation table
  *
  * @param ip_addr IPv6 address
@@ -85,6 +94,8 @@ errno_t ntrans_add(addr128_t ip_addr, eth_addr_t *mac_addr)
 
 	addr128(ip_addr, ntrans->ip_addr);
 	ntrans->mac_addr = *mac_addr;
+	ntrans->state = nt_valid;
+	getuptime(&ntrans->tstamp);
 
 	fibril_mutex_lock(&ntrans_list_lock);
 	prev = ntrans_find(ip_addr);
@@ -100,6 +111,43 @@ errno_t ntrans_add(addr128_t ip_addr, eth_addr_t *mac_addr)
 	return EOK;
 }
 
+/** Record a failed resolution (negative cache entry)
+ *
+ * Lookups of the address fail fast with EHOSTUNREACH until the
+ * entry ages out, instead of a full solicitation round per packet.
+ *
+ * @param ip_addr IPv6 address that could not be resolved
+ *
+ * @return EOK on success
+ * @return ENOMEM if not enough memory
+ *
+ */
+errno_t ntrans_add_failed(addr128_t ip_addr)
+{
+	inet_ntrans_t *ntrans;
+	inet_ntrans_t *prev;
+
+	ntrans = calloc(1, sizeof(inet_ntrans_t));
+	if (ntrans == NULL)
+		return ENOMEM;
+
+	addr128(ip_addr, ntrans->ip_addr);
+	ntrans->state = nt_failed;
+	getuptime(&ntrans->tstamp);
+
+	fibril_mutex_lock(&ntrans_list_lock);
+	prev = ntrans_find(ip_addr);
+	if (prev != NULL) {
+		list_remove(&prev->ntrans_list);
+		free(prev);
+	}
+
+	list_append(&ntrans->ntrans_list, &ntrans_list);
+	fibril_mutex_unlock(&ntrans_list_lock);
+
+	return EOK;
+}
+
 /** Remove entry from translation table
  *
  * @param ip_addr IPv6 address of the entry to be removed
@@ -137,6 +185,37 @@ errno_t ntrans_remove(addr128_t ip_addr)
  */
 errno_t ntrans_lookup(addr128_t ip_addr, eth_addr_t *mac_addr)
 {
+	bool refresh;
+
+	return ntrans_lookup_ex(ip_addr, mac_addr, &refresh);
+}
+
+/** Translate with entry aging and refresh indication
+ *
+ * Like ntrans_lookup(), but entries age: stale entries are still
+ * answered while @a *want_refresh asks the caller to re-solicit in
+ * the background, entries past their lifetime are dropped, and
+ * recent resolution failures are answered with EHOSTUNREACH
+ * without touching the network.
+ *
+ * @param ip_addr      IPv6 address to be translated
+ * @param mac_addr     MAC address to be assigned
+ * @param want_refresh Set when the entry should be refreshed
+ *
+ * @return EOK on success
+ * @return ENOENT when no usable entry exists
+ * @return EHOSTUNREACH when the address recently failed to resolve
+ *
+ */
+errno_t ntrans_lookup_ex(addr128_t ip_addr, eth_addr_t *mac_addr,
+    bool *want_refresh)
+{
+	struct timespec now;
+	sec_t age;
+
+	*want_refresh = false;
+	getuptime(&now);
+
 	fibril_mutex_lock(&ntrans_list_lock);
 	inet_ntrans_t *ntrans = ntrans_find(ip_addr);
 	if (ntrans == NULL) {
@@ -144,8 +223,37 @@ errno_t ntrans_lookup(addr128_t ip_addr, eth_addr_t *mac_addr)
 		return ENOENT;
 	}
 
-	fibril_mutex_unlock(&ntrans_list_lock);
+	age = now.tv_sec - ntrans->tstamp.tv_sec;
+
+	if (ntrans->state == nt_failed) {
+		if (age < NTRANS_NEGATIVE_SECS) {
+			fibril_mutex_unlock(&ntrans_list_lock);
+			return EHOSTUNREACH;
+		}
+
+		/* Negative entry aged out; resolve anew. */
+		list_remove(&ntrans->ntrans_list);
+		fibril_mutex_unlock(&ntrans_list_lock);
+		free(ntrans);
+		return ENOENT;
+	}
+
+	if (age >= NTRANS_VALID_SECS) {
+		/* Expired for good. */
+		list_remove(&ntrans->ntrans_list);
+		fibril_mutex_unlock(&ntrans_list_lock);
+		free(ntrans);
+		return ENOENT;
+	}
+
+	if (age >= NTRANS_REFRESH_SECS && !ntrans->refreshing) {
+		/* One refresh request per entry lifetime. */
+		ntrans->refreshing = true;
+		*want_refresh = true;
+	}
+
 	*mac_addr = ntrans->mac_addr;
+	fibril_mutex_unlock(&ntrans_list_lock);
 	return EOK;
 }
 
@@ -41,17 +41,34 @@
 #include <inet/addr.h>
 #include <inet/eth_addr.h>
 #include <inet/iplink_srv.h>
+#include <stdbool.h>
+#include <time.h>
+
+/** Neighbor entry state */
+typedef enum {
+	/** Resolution succeeded */
+	nt_valid,
+	/** Resolution recently failed (negative cache) */
+	nt_failed
+} ntrans_state_t;
 
 /** Address translation table element */
 typedef struct {
 	link_t ntrans_list;
 	addr128_t ip_addr;
 	eth_addr_t mac_addr;
+	ntrans_state_t state;
+	/** A background refresh has been requested */
+	bool refreshing;
+	/** Uptime when the entry entered its current state */
+	struct timespec tstamp;
 } inet_ntrans_t;
 
 extern errno_t ntrans_add(addr128_t, eth_addr_t *);
+extern errno_t ntrans_add_failed(addr128_t);
 extern errno_t ntrans_remove(addr128_t);
 extern errno_t ntrans_lookup(addr128_t, eth_addr_t *);
+extern errno_t ntrans_lookup_ex(addr128_t, eth_addr_t *, bool *);
 extern errno_t ntrans_wait_timeout(usec_t);
 
 #endif
@@ -48,40 +48,48 @@
 #include "inet_std.h"
 #include "pdu.h"
 
-/** One's complement addition.
- *
- * Result is a + b + carry.
- */
-static uint16_t inet_ocadd16(uint16_t a, uint16_t b)
-{
-	uint32_t s;
-
-	s = (uint32_t)a + (uint32_t)b;
-	return (s & 0xffff) + (s >> 16);
-}
-
 uint16_t inet_checksum_calc(uint16_t ivalue, void *data, size_t size)
 {
-	uint16_t sum;
+	uint64_t acc;
 	uint16_t w;
-	size_t words, i;
 	uint8_t *bdata;
 
-	sum = ~ivalue;
-	words = size / 2;
-	bdata = (uint8_t *)data;
+	acc = (uint16_t) ~ivalue;
+	bdata = (uint8_t *) data;
+
+	/*
+	 * Accumulate four 16-bit words per iteration into a 64-bit
+	 * accumulator; the ones' complement folding is deferred to
+	 * the end, which the deferred-carry property of the Internet
+	 * checksum (RFC 1071) permits. Roughly four times fewer
+	 * additions and no per-word folding compared to the previous
+	 * word-at-a-time loop.
+	 */
+	while (size >= 8) {
+		acc += ((uint16_t) bdata[0] << 8) | bdata[1];
+		acc += ((uint16_t) bdata[2] << 8) | bdata[3];
+		acc += ((uint16_t) bdata[4] << 8) | bdata[5];
+		acc += ((uint16_t) bdata[6] << 8) | bdata[7];
+		bdata += 8;
+		size -= 8;
+	}
 
-	for (i = 0; i < words; i++) {
-		w = ((uint16_t)bdata[2 * i] << 8) | bdata[2 * i + 1];
-		sum = inet_ocadd16(sum, w);
+	while (size >= 2) {
+		acc += ((uint16_t) bdata[0] << 8) | bdata[1];
+		bdata += 2;
+		size -= 2;
 	}
 
-	if (size % 2 != 0) {
-		w = ((uint16_t)bdata[2 * words] << 8);
-		sum = inet_ocadd16(sum, w);
+	if (size != 0) {
+		w = ((uint16_t) bdata[0] << 8);
+		acc += w;
 	}
 
-	return ~sum;
+	/* Fold the deferred carries back into 16 bits. */
+	while ((acc >> 16) != 0)
+		acc = (acc & 0xffff) + (acc >> 16);
+
+	return ~(uint16_t) acc;
 }
 
 /** Encode IPv4 PDU.
@@ -34,12 +34,14 @@
  * @brief Datagram reassembly.
  */
 
+#include <adt/hash_table.h>
 #include <errno.h>
 #include <fibril_synch.h>
 #include <io/log.h>
 #include <macros.h>
 #include <mem.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include "inetsrv.h"
 #include "inet_std.h"
@@ -52,10 +54,22 @@
  */
 typedef struct {
 	link_t map_link;
+	/** Link to the datagram hash table */
+	ht_link_t map_hlink;
+	/** Flow identification (copied from the first fragment) */
+	inet_addr_t src;
+	inet_addr_t dest;
+	uint8_t proto;
+	uint32_t ident;
+	/** Uptime when the reassembly started */
+	struct timespec ctime;
 	/** List of fragments, @c reass_frag_t */
 	list_t frags;
 } reass_dgram_t;
 
+/** Give up on an incomplete datagram after this long (seconds) */
+#define REASS_TIMEOUT_SECS  30
+
 /** One datagram fragment */
 typedef struct {
 	link_t dgram_link;
@@ -64,14 +78,91 @@ typedef struct {
 
 /** Datagram map, list of reass_dgram_t */
 static LIST_INITIALIZE(reass_dgram_map);
+/** Hash index of the datagram map, keyed by the flow identification */
+static hash_table_t reass_dgram_ht;
+static bool reass_dgram_ht_ready = false;
 /** Protects access to @c reass_dgram_map */
 static FIBRIL_MUTEX_INITIALIZE(reass_dgram_map_lock);
 
+/** Flow identification used as the hash key */
+typedef struct {
+	inet_addr_t *src;
+	inet_addr_t *dest;
+	uint8_t proto;
+	uint32_t ident;
+} reass_key_t;
+
+static size_t reass_addr_hash(inet_addr_t *addr)
+{
+	addr32_t v4;
+	addr128_t v6;
+	ip_ver_t ver = inet_addr_get(addr, &v4, &v6);
+
+	if (ver == ip_v4)
+		return v4;
+
+	size_t h = 0;
+	for (unsigned i = 0; i < 16; i++)
+		h = h * 31 + v6[i];
+	return h;
+}
+
+static size_t reass_key_hash(const void *key)
+{
+	const reass_key_t *rkey = key;
+
+	return reass_addr_hash(rkey->src) * 59 +
+	    reass_addr_hash(rkey->dest) * 17 + rkey->proto * 7 + rkey->ident;
+}
+
+static size_t reass_hash(const ht_link_t *item)
+{
+	reass_dgram_t *rdg = hash_table_get_inst(item, reass_dgram_t,
+	    map_hlink);
+	reass_key_t key = {
+		.src = &rdg->src,
+		.dest = &rdg->dest,
+		.proto = rdg->proto,
+		.ident = rdg->ident
+	};
+
+	return reass_key_hash(&key);
+}
+
+static bool reass_key_equal(const void *key, const ht_link_t *item)
+{
+	const reass_key_t *rkey = key;
+	reass_dgram_t *rdg = hash_table_get_inst(item, reass_dgram_t,
+	    map_hlink);
+
+	return inet_addr_compare(&rdg->src, rkey->src) &&
+	    inet_addr_compare(&rdg->dest, rkey->dest) &&
+	    rdg->proto == rkey->proto && rdg->ident == rkey->ident;
+}
+
+static const hash_table_ops_t reass_ht_ops = {
+	.hash = reass_hash,
+	.key_hash = reass_key_hash,
+	.key_equal = reass_key_equal,
+	.equal = NULL,
+	.remove_callback = NULL
+};
+
+/** Make sure the hash index exists. Map lock held. */
+static void reass_ht_ensure(void)
+{
+	if (!reass_dgram_ht_ready) {
+		hash_table_create(&reass_dgram_ht, 0, 0, &reass_ht_ops);
+		reass_dgram_ht_ready = true;
+	}
+}
+
 static reass_dgram_t *reass_dgram_new(void);
 static reass_dgram_t *reass_dgram_get(inet_packet_t *);
 static errno_t reass_dgram_insert_frag(reass_dgram_t *, inet_packet_t *);
 static bool reass_dgram_complete(reass_dgram_t *);
 static void reass_dgram_remove(reass_dgram_t *);
+static void reass_dgram_expire(void);
 static errno_t reass_dgram_deliver(reass_dgram_t *);
 static void reass_dgram_destroy(reass_dgram_t *);
 
@@ -89,6 +180,9 @@ errno_t inet_reass_queue_packet(inet_packet_t *packet)
 
 	fibril_mutex_lock(&reass_dgram_map_lock);
 
+	/* Age out datagrams that will never complete. */
+	reass_dgram_expire();
+
 	/* Get existing or new datagram */
 	rdg = reass_dgram_get(packet);
 	if (rdg == NULL) {
@@ -128,24 +222,32 @@ static reass_dgram_t *reass_dgram_get(inet_packet_t *packet)
 {
 	assert(fibril_mutex_is_locked(&reass_dgram_map_lock));
 
-	list_foreach(reass_dgram_map, map_link, reass_dgram_t, rdg) {
-		link_t *f1_link = list_first(&rdg->frags);
-		assert(f1_link != NULL);
+	reass_ht_ensure();
 
-		reass_frag_t *f1 = list_get_instance(f1_link, reass_frag_t,
-		    dgram_link);
+	reass_key_t key = {
+		.src = &packet->src,
+		.dest = &packet->dest,
+		.proto = packet->proto,
+		.ident = packet->ident
+	};
 
-		if ((inet_addr_compare(&f1->packet.src, &packet->src)) &&
-		    (inet_addr_compare(&f1->packet.dest, &packet->dest)) &&
-		    (f1->packet.proto == packet->proto) &&
-		    (f1->packet.ident == packet->ident)) {
-			/* Match */
-			return rdg;
-		}
-	}
+	ht_link_t *link = hash_table_find(&reass_dgram_ht, &key);
+	if (link != NULL)
+		return hash_table_get_inst(link, reass_dgram_t, map_hlink);
 
 	/* No existing reassembly structure. Create a new one. */
-	return reass_dgram_new();
+	reass_dgram_t *rdg = reass_dgram_new();
+	if (rdg == NULL)
+		return NULL;
+
+	rdg->src = packet->src;
+	rdg->dest = packet->dest;
+	rdg->proto = packet->proto;
+	rdg->ident = packet->ident;
+	getuptime(&rdg->ctime);
+	hash_table_insert(&reass_dgram_ht, &rdg->map_hlink);
+
+	return rdg;
 }
 
 /** Create new datagram reassembly structure.
@@ -283,6 +385,38 @@ static void reass_dgram_remove(reass_dgram_t *rdg)
 {
 	assert(fibril_mutex_is_locked(&reass_dgram_map_lock));
 	list_remove(&rdg->map_link);
+	hash_table_remove_item(&reass_dgram_ht, &rdg->map_hlink);
+}
+
+/** Drop incomplete datagrams whose reassembly timed out.
+ *
+ * Ran on fragment arrival; without this, fragments of datagrams
+ * that never complete would accumulate forever. Map lock held.
+ */
+static void reass_dgram_expire(void)
+{
+	struct timespec now;
+	link_t *cur;
+	link_t *next;
+
+	getuptime(&now);
+
+	cur = list_first(&reass_dgram_map);
+	while (cur != NULL) {
+		next = list_next(cur, &reass_dgram_map);
+
+		reass_dgram_t *rdg = list_get_instance(cur, reass_dgram_t,
+		    map_link);
+
+		if (now.tv_sec - rdg->ctime.tv_sec >= REASS_TIMEOUT_SECS) {
+			log_msg(LOG_DEFAULT, LVL_DEBUG,
+			    "Reassembly timed out, dropping datagram.");
+			reass_dgram_remove(rdg);
+			reass_dgram_destroy(rdg);
+		}
+
+		cur = next;
+	}
 }
 
 /** Deliver complete datagram.
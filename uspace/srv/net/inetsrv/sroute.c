@@ -39,6 +39,7 @@
 #include <fibril_synch.h>
 #include <io/log.h>
 #include <ipc/loc.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <str.h>
 #include "sroute.h"
@@ -49,6 +50,128 @@ static FIBRIL_MUTEX_INITIALIZE(sroute_list_lock);
 static LIST_INITIALIZE(sroute_list);
 static sysarg_t sroute_id = 0;
 
+/*
+ * Longest-prefix-match index over the route list: one binary trie
+ * per address family, walked bit by bit from the most significant
+ * bit. Lookup cost is bounded by the address width instead of the
+ * number of routes. The list stays authoritative (enumeration,
+ * lookup by name/id); the tries are maintained on add/remove.
+ */
+
+typedef struct sroute_trie_node {
+	struct sroute_trie_node *child[2];
+	/** Route whose prefix ends at this node, or NULL */
+	inet_sroute_t *sroute;
+} sroute_trie_node_t;
+
+static sroute_trie_node_t sroute_trie_v4;
+static sroute_trie_node_t sroute_trie_v6;
+
+/**
+ * Cleared when a trie node allocation fails, leaving a route
+ * unindexed; lookups then fall back to scanning the list so the
+ * route does not silently vanish from routing.
+ */
+static bool sroute_trie_complete = true;
+
+/** Last looked-up destination (one-entry route cache) */
+static inet_addr_t sroute_cache_addr;
+static inet_sroute_t *sroute_cache_route;
+static bool sroute_cache_valid = false;
+
+/** Get bit @a i (0 = MSB) of an address of either family */
+static unsigned sroute_addr_bit(ip_ver_t ver, addr32_t v4, const uint8_t *v6,
+    unsigned i)
+{
+	if (ver == ip_v4)
+		return (v4 >> (31 - i)) & 1;
+
+	return (v6[i / 8] >> (7 - i % 8)) & 1;
+}
+
+/** Insert a route into the LPM trie. List lock held. */
+static void sroute_trie_insert(inet_sroute_t *sroute)
+{
+	addr32_t v4 = 0;
+	addr128_t v6;
+	uint8_t bits;
+	ip_ver_t ver = inet_naddr_get(&sroute->dest, &v4, &v6, &bits);
+
+	sroute_trie_node_t *node = (ver == ip_v4) ? &sroute_trie_v4 :
+	    &sroute_trie_v6;
+
+	for (unsigned i = 0; i < bits; i++) {
+		unsigned b = sroute_addr_bit(ver, v4, v6, i);
+
+		if (node->child[b] == NULL) {
+			node->child[b] = calloc(1,
+			    sizeof(sroute_trie_node_t));
+			if (node->child[b] == NULL) {
+				/*
+				 * The route stays unindexed; make
+				 * lookups scan the list instead.
+				 */
+				sroute_trie_complete = false;
+				return;
+			}
+		}
+
+		node = node->child[b];
+	}
+
+	node->sroute = sroute;
+}
+
+/** Remove a route from the LPM trie. List lock held. */
+static void sroute_trie_delete(inet_sroute_t *sroute)
+{
+	addr32_t v4 = 0;
+	addr128_t v6;
+	uint8_t bits;
+	ip_ver_t ver = inet_naddr_get(&sroute->dest, &v4, &v6, &bits);
+
+	sroute_trie_node_t *node = (ver == ip_v4) ? &sroute_trie_v4 :
+	    &sroute_trie_v6;
+
+	for (unsigned i = 0; i < bits; i++) {
+		unsigned b = sroute_addr_bit(ver, v4, v6, i);
+
+		node = node->child[b];
+		if (node == NULL)
+			return;
+	}
+
+	if (node->sroute == sroute)
+		node->sroute = NULL;
+}
+
+/** Longest-prefix-match lookup. List lock held. */
+static inet_sroute_t *sroute_trie_lookup(inet_addr_t *addr)
+{
+	addr32_t v4 = 0;
+	addr128_t v6;
+	ip_ver_t ver = inet_addr_get(addr, &v4, &v6);
+
+	sroute_trie_node_t *node = (ver == ip_v4) ? &sroute_trie_v4 :
+	    &sroute_trie_v6;
+	unsigned width = (ver == ip_v4) ? 32 : 128;
+
+	inet_sroute_t *best = node->sroute;
+
+	for (unsigned i = 0; i < width; i++) {
+		unsigned b = sroute_addr_bit(ver, v4, v6, i);
+
+		node = node->child[b];
+		if (node == NULL)
+			break;
+
+		if (node->sroute != NULL)
+			best = node->sroute;
+	}
+
+	return best;
+}
+
 inet_sroute_t *inet_sroute_new(void)
 {
 	inet_sroute_t *sroute = calloc(1, sizeof(inet_sroute_t));
@@ -78,6 +201,8 @@ void inet_sroute_add(inet_sroute_t *sroute)
 {
 	fibril_mutex_lock(&sroute_list_lock);
 	list_append(&sroute->sroute_list, &sroute_list);
+	sroute_trie_insert(sroute);
+	sroute_cache_valid = false;
 	fibril_mutex_unlock(&sroute_list_lock);
 }
 
@@ -85,22 +210,19 @@ void inet_sroute_remove(inet_sroute_t *sroute)
 {
 	fibril_mutex_lock(&sroute_list_lock);
 	list_remove(&sroute->sroute_list);
+	sroute_trie_delete(sroute);
+	sroute_cache_valid = false;
 	fibril_mutex_unlock(&sroute_list_lock);
 }
 
-/** Find static route object matching address @a addr.
- *
- * @param addr	Address
- */
-inet_sroute_t *inet_sroute_find(inet_addr_t *addr)
+/** Longest-prefix-match scan of the route list. List lock held. */
+static inet_sroute_t *sroute_list_lookup(inet_addr_t *addr)
 {
 	ip_ver_t addr_ver = inet_addr_get(addr, NULL, NULL);
 
 	inet_sroute_t *best = NULL;
 	uint8_t best_bits = 0;
 
-	fibril_mutex_lock(&sroute_list_lock);
-
 	list_foreach(sroute_list, sroute_list, inet_sroute_t, sroute) {
 		uint8_t dest_bits;
 		ip_ver_t dest_ver = inet_naddr_get(&sroute->dest, NULL, NULL,
@@ -115,14 +237,37 @@ inet_sroute_t *inet_sroute_find(inet_addr_t *addr)
 			continue;
 
 		if (inet_naddr_compare_mask(&sroute->dest, addr)) {
-			log_msg(LOG_DEFAULT, LVL_DEBUG, "inet_sroute_find: found candidate %p",
-			    sroute);
-
 			best = sroute;
 			best_bits = dest_bits;
 		}
 	}
 
+	return best;
+}
+
+/** Find static route object matching address @a addr.
+ *
+ * @param addr	Address
+ */
+inet_sroute_t *inet_sroute_find(inet_addr_t *addr)
+{
+	fibril_mutex_lock(&sroute_list_lock);
+
+	/* Repeated sends to one destination hit the cache. */
+	if (sroute_cache_valid &&
+	    inet_addr_compare(&sroute_cache_addr, addr)) {
+		inet_sroute_t *cached = sroute_cache_route;
+		fibril_mutex_unlock(&sroute_list_lock);
+		return cached;
+	}
+
+	inet_sroute_t *best = sroute_trie_complete ?
+	    sroute_trie_lookup(addr) : sroute_list_lookup(addr);
+
+	sroute_cache_addr = *addr;
+	sroute_cache_route = best;
+	sroute_cache_valid = true;
+
 	if (best == NULL)
 		log_msg(LOG_DEFAULT, LVL_DEBUG, "inet_sroute_find: Not found");
 
@@ -144,6 +144,13 @@ tcp_conn_t *tcp_conn_new(inet_ep2_t *epp)
 	fibril_condvar_initialize(&conn->snd_buf_cv);
 	conn->snd_buf_size = SND_BUF_SIZE;
 	conn->snd_buf_used = 0;
+
+	/*
+	 * Congestion control (RFC 5681): start in slow start with a
+	 * small window and no threshold.
+	 */
+	conn->snd_cwnd = 2 * TCP_CWND_MSS;
+	conn->snd_ssthresh = UINT32_MAX;
 	conn->snd_buf_fin = false;
 	conn->snd_buf = calloc(1, conn->snd_buf_size);
 	if (conn->snd_buf == NULL)
@@ -1394,6 +1401,31 @@ void tcp_unexpected_segment(inet_ep2_t *epp, tcp_segment_t *seg)
  * @param epp Endpoint pair with source and destination information
  * @param seg Segment (ownership retained by caller)
  */
+/** Determine whether an endpoint pair stays on this host.
+ *
+ * @param epp Endpoint pair
+ * @return @c true when the remote endpoint is a loopback address
+ */
+static bool tcp_epp_is_loopback(inet_ep2_t *epp)
+{
+	addr32_t v4;
+	addr128_t v6;
+	ip_ver_t ver = inet_addr_get(&epp->remote.addr, &v4, &v6);
+
+	if (ver == ip_v4)
+		return (v4 >> 24) == 127;
+
+	if (ver == ip_v6) {
+		for (unsigned i = 0; i < 15; i++) {
+			if (v6[i] != 0)
+				return false;
+		}
+		return v6[15] == 1;
+	}
+
+	return false;
+}
+
 static void tcp_transmit_segment(inet_ep2_t *epp, tcp_segment_t *seg)
 {
 	tcp_pdu_t *pdu;
@@ -1409,7 +1441,13 @@ static void tcp_transmit_segment(inet_ep2_t *epp, tcp_segment_t *seg)
 
 	tcp_segment_dump(seg);
 
-	if (tcp_conn_lb == tcp_lb_segment) {
+	/*
+	 * Local fast path: segments for loopback destinations never
+	 * leave this server. Handing them straight to the receive
+	 * queue skips PDU encoding, the checksum, and the round
+	 * trip through inetsrv and loopip.
+	 */
+	if (tcp_conn_lb == tcp_lb_segment || tcp_epp_is_loopback(epp)) {
 		/* Loop back segment */
 #if 0
 		tcp_ncsim_bounce_seg(sp, seg);
@@ -111,17 +111,35 @@ static errno_t tcp_rqueue_fibril(void *arg)
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "tcp_rqueue_fibril()");
 
-	while (true) {
+	bool done = false;
+
+	while (!done) {
+		/* Block for the first segment of a batch. */
 		link = prodcons_consume(&rqueue);
-		rqe = list_get_instance(link, tcp_rqueue_entry_t, link);
 
-		if (rqe->seg == NULL) {
+		/*
+		 * Then drain everything that has queued up meanwhile
+		 * without going back to sleep in between: bursts of
+		 * segments (e.g. a window's worth of arrivals) are
+		 * processed back to back, which also lets segments of
+		 * one connection coalesce in the connection's incoming
+		 * queue before the application is woken.
+		 */
+		while (link != NULL) {
+			rqe = list_get_instance(link, tcp_rqueue_entry_t,
+			    link);
+
+			if (rqe->seg == NULL) {
+				free(rqe);
+				done = true;
+				break;
+			}
+
+			rqueue_cb->seg_received(&rqe->epp, rqe->seg);
 			free(rqe);
-			break;
-		}
 
-		rqueue_cb->seg_received(&rqe->epp, rqe->seg);
-		free(rqe);
+			link = prodcons_consume_try(&rqueue);
+		}
 	}
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG2, "tcp_rqueue_fibril() exiting");
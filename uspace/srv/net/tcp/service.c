@@ -142,8 +142,6 @@ static void tcp_service_lst_cstate_change(tcp_conn_t *conn, void *arg,
 	if ((old_state == st_syn_sent || old_state == st_syn_received) &&
 	    (nstate == st_established)) {
 		/* Connection established */
-		clst->conn = NULL;
-
 		rc = tcp_cconn_create(clst->client, conn, &cconn);
 		if (rc != EOK) {
 			/* XXX Could not create client connection */
@@ -167,7 +165,18 @@ static void tcp_service_lst_cstate_change(tcp_conn_t *conn, void *arg,
 		/* XXX */
 	}
 
-	/* Replenish sentinel connection */
+	/*
+	 * Replenish the sentinel connection as soon as the old one
+	 * leaves the listen state - its identity specializes to the
+	 * remote endpoint at SYN arrival, freeing the wildcard slot.
+	 * Further SYNs are then answered while this handshake is
+	 * still in flight, instead of being reset until the old
+	 * connection finished establishing (and instead of
+	 * replenishing again on the establish transition, which
+	 * leaked a second sentinel per accepted connection).
+	 */
+	if (old_state != st_listen || nstate != st_syn_received)
+		return;
 
 	inet_ep2_init(&epp);
 	epp.local = clst->elocal;
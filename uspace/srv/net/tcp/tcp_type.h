@@ -46,6 +46,9 @@
 #include <inet/addr.h>
 #include <inet/endpoint.h>
 
+/** Segment size assumed by the congestion control algorithm. */
+#define TCP_CWND_MSS  1460
+
 struct tcp_conn;
 
 /** Connection state */
@@ -299,6 +302,10 @@ struct tcp_conn {
 	uint32_t snd_nxt;
 	/** Send window */
 	uint32_t snd_wnd;
+	/** Congestion window (bytes) */
+	uint32_t snd_cwnd;
+	/** Slow start threshold (bytes) */
+	uint32_t snd_ssthresh;
 	/** Send urgent pointer */
 	uint32_t snd_up;
 	/** Segment sequence number used for last window update */
@@ -189,8 +189,22 @@ void tcp_tqueue_new_data(tcp_conn_t *conn)
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "%s: tcp_tqueue_new_data()", conn->name);
 
-	/* Number of free sequence numbers in send window */
-	avail_wnd = (conn->snd_una + conn->snd_wnd) - conn->snd_nxt;
+	/*
+	 * Number of free sequence numbers in the send window, limited
+	 * by both the peer's advertised window and our congestion
+	 * window.
+	 */
+	uint32_t eff_wnd = conn->snd_wnd;
+	if (conn->snd_cwnd < eff_wnd)
+		eff_wnd = conn->snd_cwnd;
+
+	/*
+	 * The congestion window may have collapsed below the amount
+	 * currently in flight (after a retransmission timeout), so
+	 * guard against underflow.
+	 */
+	uint32_t in_flight = conn->snd_nxt - conn->snd_una;
+	avail_wnd = (in_flight < eff_wnd) ? (eff_wnd - in_flight) : 0;
 	snd_buf_seqlen = conn->snd_buf_used + (conn->snd_buf_fin ? 1 : 0);
 
 	xfer_seqlen = min(snd_buf_seqlen, avail_wnd);
@@ -244,6 +258,22 @@ void tcp_tqueue_new_data(tcp_conn_t *conn)
  */
 void tcp_tqueue_ack_received(tcp_conn_t *conn)
 {
+	/*
+	 * Congestion window growth (RFC 5681): exponential during
+	 * slow start, roughly one segment per round trip during
+	 * congestion avoidance.
+	 */
+	if (conn->snd_cwnd <= conn->snd_ssthresh) {
+		conn->snd_cwnd += TCP_CWND_MSS;
+	} else {
+		conn->snd_cwnd +=
+		    TCP_CWND_MSS * TCP_CWND_MSS / conn->snd_cwnd;
+	}
+
+	/* Keep the window away from wrap-around. */
+	if (conn->snd_cwnd > (1 << 30))
+		conn->snd_cwnd = (1 << 30);
+
 	link_t *cur, *next;
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "%s: tcp_tqueue_ack_received(%p)", conn->name,
@@ -345,6 +375,15 @@ static void retransmit_timeout_func(void *arg)
 
 	tqe = list_get_instance(link, tcp_tqueue_entry_t, link);
 
+	/*
+	 * Loss detected (RFC 5681): halve the window into the slow
+	 * start threshold and restart from slow start.
+	 */
+	conn->snd_ssthresh = conn->snd_cwnd / 2;
+	if (conn->snd_ssthresh < 2 * TCP_CWND_MSS)
+		conn->snd_ssthresh = 2 * TCP_CWND_MSS;
+	conn->snd_cwnd = TCP_CWND_MSS;
+
 	rt_seg = tcp_segment_dup(tqe->seg);
 	if (rt_seg == NULL) {
 		log_msg(LOG_DEFAULT, LVL_ERROR, "Memory allocation failed.");
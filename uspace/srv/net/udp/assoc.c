@@ -207,6 +207,13 @@ errno_t udp_assoc_add(udp_assoc_t *assoc)
 
 	assoc->ident = aepp;
 	list_append(&assoc->link, &assoc_list);
+
+	/*
+	 * The new association may be a better match for the cached
+	 * endpoint pair than the cached association.
+	 */
+	assoc_cache_assoc = NULL;
+
 	fibril_mutex_unlock(&assoc_list_lock);
 
 	return EOK;
@@ -219,6 +226,8 @@ errno_t udp_assoc_add(udp_assoc_t *assoc)
 void udp_assoc_remove(udp_assoc_t *assoc)
 {
 	fibril_mutex_lock(&assoc_list_lock);
+	if (assoc_cache_assoc == assoc)
+		assoc_cache_assoc = NULL;
 	amap_remove(amap, &assoc->ident);
 	list_remove(&assoc->link);
 	fibril_mutex_unlock(&assoc_list_lock);
@@ -407,6 +416,25 @@ static errno_t udp_assoc_queue_msg(udp_assoc_t *assoc, inet_ep2_t *epp,
 	return EOK;
 }
 
+/*
+ * Connected-association cache.
+ *
+ * Datagram floods typically hit one association with one exact
+ * endpoint pair over and over. Remember the last exact match so that
+ * the common case skips the association map (which tries several
+ * wildcard combinations per lookup). Guarded by assoc_list_lock;
+ * invalidated when an association is removed.
+ */
+static udp_assoc_t *assoc_cache_assoc = NULL;
+static inet_ep2_t assoc_cache_epp;
+
+/** Compare two endpoints for exact equality. */
+static bool inet_ep_equal(inet_ep_t *a, inet_ep_t *b)
+{
+	return (a->port == b->port) &&
+	    (inet_addr_compare(&a->addr, &b->addr) != 0);
+}
+
 /** Find association structure for specified endpoint pair.
  *
  * An association is uniquely identified by an endpoint pair. Look up our
@@ -425,6 +453,16 @@ static udp_assoc_t *udp_assoc_find_ref(inet_ep2_t *epp)
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "udp_assoc_find_ref(%p)", epp);
 	fibril_mutex_lock(&assoc_list_lock);
 
+	/* Exact repeat of the previous match? */
+	if ((assoc_cache_assoc != NULL) &&
+	    (inet_ep_equal(&assoc_cache_epp.local, &epp->local)) &&
+	    (inet_ep_equal(&assoc_cache_epp.remote, &epp->remote))) {
+		assoc = assoc_cache_assoc;
+		udp_assoc_addref(assoc);
+		fibril_mutex_unlock(&assoc_list_lock);
+		return assoc;
+	}
+
 	rc = amap_find_match(amap, epp, &arg);
 	if (rc != EOK) {
 		assert(rc == ENOENT);
@@ -435,6 +473,10 @@ static udp_assoc_t *udp_assoc_find_ref(inet_ep2_t *epp)
 	assoc = (udp_assoc_t *)arg;
 	udp_assoc_addref(assoc);
 
+	/* Remember the match for the next datagram. */
+	assoc_cache_assoc = assoc;
+	assoc_cache_epp = *epp;
+
 	fibril_mutex_unlock(&assoc_list_lock);
 	return assoc;
 }
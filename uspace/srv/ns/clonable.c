@@ -53,9 +53,44 @@ typedef struct {
 /** List of clonable-service connection requests. */
 static list_t cs_req;
 
+/*
+ * Pool of pre-spawned loader instances. Spawning the loader task is
+ * the dominant fixed cost of task creation, so a few loaders are kept
+ * spawned and registered ahead of demand; a connection request served
+ * from the pool skips the whole spawn-and-register round trip and the
+ * pool is refilled in the background.
+ */
+#define LOADER_POOL_SIZE  2
+
+/** Registered loader instance waiting for a client. */
+typedef struct {
+	link_t link;
+	async_sess_t *sess;
+} cs_avail_t;
+
+/** List of parked loader instances (cs_avail_t). */
+static list_t cs_avail;
+
+/** Loaders spawned but not yet handed to a client (parked or in flight). */
+static size_t cs_outstanding;
+
+/** Spawn loaders until a pool's worth is spare beyond pending requests. */
+static void loader_pool_refill(void)
+{
+	while (cs_outstanding < list_count(&cs_req) + LOADER_POOL_SIZE) {
+		if (loader_spawn("loader") != EOK)
+			break;
+
+		cs_outstanding++;
+	}
+}
+
 errno_t ns_clonable_init(void)
 {
 	list_initialize(&cs_req);
+	list_initialize(&cs_avail);
+
+	loader_pool_refill();
 	return EOK;
 }
 
@@ -74,9 +109,32 @@ void ns_clonable_register(ipc_call_t *call)
 {
 	link_t *req_link = list_first(&cs_req);
 	if (req_link == NULL) {
-		/* There was no pending connection request. */
-		printf("%s: Unexpected clonable server.\n", NAME);
-		async_answer_0(call, EBUSY);
+		/* No pending connection request, park it in the pool. */
+		cs_avail_t *avail = malloc(sizeof(cs_avail_t));
+		if (avail == NULL) {
+			/* The loader is lost to the pool. */
+			if (cs_outstanding > 0)
+				cs_outstanding--;
+			async_answer_0(call, ENOMEM);
+			return;
+		}
+
+		async_sess_t *sess;
+
+		async_answer_0(call, EOK);
+
+		sess = async_callback_receive(EXCHANGE_SERIALIZE);
+		if (sess == NULL) {
+			if (cs_outstanding > 0)
+				cs_outstanding--;
+			free(avail);
+			async_answer_0(call, EIO);
+			return;
+		}
+
+		link_initialize(&avail->link);
+		avail->sess = sess;
+		list_append(&avail->link, &cs_avail);
 		return;
 	}
 
@@ -99,6 +157,9 @@ void ns_clonable_register(ipc_call_t *call)
 
 	free(csr);
 	async_hangup(sess);
+
+	if (cs_outstanding > 0)
+		cs_outstanding--;
 }
 
 /** Connect client to clonable service.
@@ -114,6 +175,26 @@ void ns_clonable_forward(service_t service, iface_t iface, ipc_call_t *call)
 {
 	assert(ns_service_is_clonable(service, iface));
 
+	/* Serve the request from the loader pool if possible. */
+	link_t *avail_link = list_first(&cs_avail);
+	if (avail_link != NULL) {
+		cs_avail_t *avail = list_get_instance(avail_link, cs_avail_t,
+		    link);
+		list_remove(avail_link);
+		cs_outstanding--;
+
+		async_exch_t *exch = async_exchange_begin(avail->sess);
+		async_forward_1(call, exch, iface, ipc_get_arg3(call),
+		    IPC_FF_NONE);
+		async_exchange_end(exch);
+
+		async_hangup(avail->sess);
+		free(avail);
+
+		loader_pool_refill();
+		return;
+	}
+
 	cs_req_t *csr = malloc(sizeof(cs_req_t));
 	if (csr == NULL) {
 		async_answer_0(call, ENOMEM);
@@ -129,6 +210,8 @@ void ns_clonable_forward(service_t service, iface_t iface, ipc_call_t *call)
 		return;
 	}
 
+	cs_outstanding++;
+
 	link_initialize(&csr->link);
 	csr->service = service;
 	csr->iface = iface;
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup pipesrv
+ * @{
+ */
+/**
+ * @file Anonymous pipe service.
+ *
+ * Provides blocking FIFO channels for connecting pipeline stages.
+ * Each pipe appears as a pair of location services (pipe/NNNr and
+ * pipe/NNNw); tasks open them as ordinary files through locfs and
+ * the reads and writes forwarded by locfs block on the pipe's ring
+ * buffer. When the write end's last opener goes away readers see
+ * end of file; when the read end is gone writers get EPIPE.
+ */
+
+#include <adt/list.h>
+#include <async.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <ipc/pipesrv.h>
+#include <ipc/services.h>
+#include <ipc/vfs.h>
+#include <loc.h>
+#include <macros.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str_error.h>
+#include <task.h>
+
+#define NAME  "pipesrv"
+
+/** Ring buffer capacity of one pipe */
+#define PIPE_BUF_SIZE  65536
+
+typedef struct {
+	link_t link;
+
+	int id;
+	service_id_t rsid;
+	service_id_t wsid;
+
+	uint8_t *buf;
+	size_t head;
+	size_t used;
+
+	/** The respective end has connected at least once */
+	bool reader_seen;
+	bool writer_seen;
+	/** Currently open connections to the respective end */
+	size_t readers;
+	size_t writers;
+
+	/** Guards the buffer and the end state */
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+} pipe_t;
+
+static LIST_INITIALIZE(pipes);
+static FIBRIL_MUTEX_INITIALIZE(pipes_lock);
+static int next_pipe_id = 1;
+
+static service_id_t ctl_id;
+
+/** Find a pipe by either end's service id. Caller holds pipes_lock. */
+static pipe_t *pipe_find(service_id_t sid)
+{
+	list_foreach(pipes, link, pipe_t, pipe) {
+		if ((pipe->rsid == sid) || (pipe->wsid == sid))
+			return pipe;
+	}
+
+	return NULL;
+}
+
+/** Tear the pipe down. Caller holds pipes_lock. */
+static void pipe_destroy(pipe_t *pipe)
+{
+	loc_service_unregister(pipe->rsid);
+	loc_service_unregister(pipe->wsid);
+
+	list_remove(&pipe->link);
+	free(pipe->buf);
+	free(pipe);
+}
+
+/** Create a new pipe and register its end services */
+static void pipe_create(ipc_call_t *icall)
+{
+	pipe_t *pipe = calloc(1, sizeof(pipe_t));
+	if (pipe == NULL) {
+		async_answer_0(icall, ENOMEM);
+		return;
+	}
+
+	pipe->buf = malloc(PIPE_BUF_SIZE);
+	if (pipe->buf == NULL) {
+		free(pipe);
+		async_answer_0(icall, ENOMEM);
+		return;
+	}
+
+	link_initialize(&pipe->link);
+	fibril_mutex_initialize(&pipe->lock);
+	fibril_condvar_initialize(&pipe->cv);
+
+	fibril_mutex_lock(&pipes_lock);
+	pipe->id = next_pipe_id++;
+	fibril_mutex_unlock(&pipes_lock);
+
+	char *rname;
+	char *wname;
+	if (asprintf(&rname, "pipe/%dr", pipe->id) < 0) {
+		free(pipe->buf);
+		free(pipe);
+		async_answer_0(icall, ENOMEM);
+		return;
+	}
+
+	if (asprintf(&wname, "pipe/%dw", pipe->id) < 0) {
+		free(rname);
+		free(pipe->buf);
+		free(pipe);
+		async_answer_0(icall, ENOMEM);
+		return;
+	}
+
+	errno_t rc = loc_service_register(rname, &pipe->rsid);
+	if (rc == EOK) {
+		rc = loc_service_register(wname, &pipe->wsid);
+		if (rc != EOK)
+			loc_service_unregister(pipe->rsid);
+	}
+
+	free(rname);
+	free(wname);
+
+	if (rc != EOK) {
+		free(pipe->buf);
+		free(pipe);
+		async_answer_0(icall, rc);
+		return;
+	}
+
+	fibril_mutex_lock(&pipes_lock);
+	list_append(&pipe->link, &pipes);
+	fibril_mutex_unlock(&pipes_lock);
+
+	async_answer_1(icall, EOK, pipe->id);
+}
+
+/** Serve one read forwarded by locfs */
+static void pipe_read(pipe_t *pipe, ipc_call_t *icall)
+{
+	ipc_call_t dcall;
+	size_t size;
+
+	if (!async_data_read_receive(&dcall, &size)) {
+		async_answer_0(&dcall, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	fibril_mutex_lock(&pipe->lock);
+
+	/*
+	 * Block until data arrives or the last writer is gone for
+	 * good. Before the write end's first opener shows up the pipe
+	 * is merely not filled yet, not at the end of file.
+	 */
+	while ((pipe->used == 0) &&
+	    !(pipe->writer_seen && (pipe->writers == 0)))
+		fibril_condvar_wait(&pipe->cv, &pipe->lock);
+
+	size_t now = min(size, pipe->used);
+
+	if (now == 0) {
+		/* End of file */
+		fibril_mutex_unlock(&pipe->lock);
+		async_data_read_finalize(&dcall, NULL, 0);
+		async_answer_1(icall, EOK, 0);
+		return;
+	}
+
+	/* The ring may wrap; hand out the first run only. */
+	if (now > PIPE_BUF_SIZE - pipe->head)
+		now = PIPE_BUF_SIZE - pipe->head;
+
+	errno_t rc = async_data_read_finalize(&dcall, pipe->buf + pipe->head,
+	    now);
+	if (rc == EOK) {
+		pipe->head = (pipe->head + now) % PIPE_BUF_SIZE;
+		pipe->used -= now;
+		fibril_condvar_broadcast(&pipe->cv);
+	}
+
+	fibril_mutex_unlock(&pipe->lock);
+	async_answer_1(icall, rc, now);
+}
+
+/** Serve one write forwarded by locfs */
+static void pipe_write(pipe_t *pipe, ipc_call_t *icall)
+{
+	ipc_call_t dcall;
+	size_t size;
+
+	if (!async_data_write_receive(&dcall, &size)) {
+		async_answer_0(&dcall, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	fibril_mutex_lock(&pipe->lock);
+
+	/* Block until there is room or the last reader disappears. */
+	while ((pipe->used == PIPE_BUF_SIZE) &&
+	    !(pipe->reader_seen && (pipe->readers == 0)))
+		fibril_condvar_wait(&pipe->cv, &pipe->lock);
+
+	if (pipe->reader_seen && (pipe->readers == 0)) {
+		fibril_mutex_unlock(&pipe->lock);
+		async_answer_0(&dcall, EPIPE);
+		async_answer_0(icall, EPIPE);
+		return;
+	}
+
+	size_t now = min(size, PIPE_BUF_SIZE - pipe->used);
+	size_t tail = (pipe->head + pipe->used) % PIPE_BUF_SIZE;
+
+	/* Only the first run on wrap-around; short writes are fine. */
+	if (now > PIPE_BUF_SIZE - tail)
+		now = PIPE_BUF_SIZE - tail;
+
+	errno_t rc = async_data_write_finalize(&dcall, pipe->buf + tail, now);
+	if (rc == EOK) {
+		pipe->used += now;
+		fibril_condvar_broadcast(&pipe->cv);
+	}
+
+	fibril_mutex_unlock(&pipe->lock);
+	async_answer_1(icall, rc, now);
+}
+
+/** Serve one pipe end connection (from locfs) until hangup */
+static void pipe_end_connection(pipe_t *pipe, bool write_end,
+    ipc_call_t *icall)
+{
+	async_accept_0(icall);
+
+	while (true) {
+		ipc_call_t call;
+		async_get_call(&call);
+
+		if (!ipc_get_imethod(&call)) {
+			async_answer_0(&call, EOK);
+			break;
+		}
+
+		switch (ipc_get_imethod(&call)) {
+		case VFS_OUT_READ:
+			if (write_end)
+				async_answer_0(&call, ENOTSUP);
+			else
+				pipe_read(pipe, &call);
+			break;
+		case VFS_OUT_WRITE:
+			if (write_end)
+				pipe_write(pipe, &call);
+			else
+				async_answer_0(&call, ENOTSUP);
+			break;
+		case VFS_OUT_SYNC:
+			async_answer_0(&call, EOK);
+			break;
+		default:
+			async_answer_0(&call, ENOTSUP);
+		}
+	}
+
+	/*
+	 * List lock first, pipe lock second, everywhere; the pipe
+	 * can only be torn down here, after both ends went away.
+	 */
+	fibril_mutex_lock(&pipes_lock);
+	fibril_mutex_lock(&pipe->lock);
+	if (write_end)
+		pipe->writers--;
+	else
+		pipe->readers--;
+
+	fibril_condvar_broadcast(&pipe->cv);
+
+	bool both_gone = (pipe->readers == 0) && (pipe->writers == 0) &&
+	    pipe->reader_seen && pipe->writer_seen;
+	fibril_mutex_unlock(&pipe->lock);
+
+	if (both_gone)
+		pipe_destroy(pipe);
+
+	fibril_mutex_unlock(&pipes_lock);
+}
+
+/** Serve the control service */
+static void ctl_connection(ipc_call_t *icall)
+{
+	async_accept_0(icall);
+
+	while (true) {
+		ipc_call_t call;
+		async_get_call(&call);
+
+		if (!ipc_get_imethod(&call)) {
+			async_answer_0(&call, EOK);
+			break;
+		}
+
+		switch (ipc_get_imethod(&call)) {
+		case PIPESRV_CREATE:
+			pipe_create(&call);
+			break;
+		default:
+			async_answer_0(&call, ENOENT);
+		}
+	}
+}
+
+static void pipesrv_connection(ipc_call_t *icall, void *arg)
+{
+	service_id_t sid = ipc_get_arg1(icall);
+
+	if (sid == ctl_id) {
+		ctl_connection(icall);
+		return;
+	}
+
+	/*
+	 * Mark the end alive while still holding the list lock, so
+	 * the pipe cannot be torn down between the lookup and the
+	 * connection getting under way.
+	 */
+	fibril_mutex_lock(&pipes_lock);
+	pipe_t *pipe = pipe_find(sid);
+	bool write_end = (pipe != NULL) && (sid == pipe->wsid);
+
+	if (pipe != NULL) {
+		fibril_mutex_lock(&pipe->lock);
+		if (write_end) {
+			pipe->writer_seen = true;
+			pipe->writers++;
+		} else {
+			pipe->reader_seen = true;
+			pipe->readers++;
+		}
+		fibril_condvar_broadcast(&pipe->cv);
+		fibril_mutex_unlock(&pipe->lock);
+	}
+	fibril_mutex_unlock(&pipes_lock);
+
+	if (pipe == NULL) {
+		async_answer_0(icall, ENOENT);
+		return;
+	}
+
+	pipe_end_connection(pipe, write_end, icall);
+}
+
+int main(int argc, char *argv[])
+{
+	errno_t rc;
+
+	printf("%s: HelenOS pipe service\n", NAME);
+
+	async_set_fallback_port_handler(pipesrv_connection, NULL);
+
+	rc = loc_server_register(NAME);
+	if (rc != EOK) {
+		printf("%s: Failed registering server: %s\n", NAME,
+		    str_error(rc));
+		return rc;
+	}
+
+	rc = loc_service_register(PIPESRV_CTL_SERVICE, &ctl_id);
+	if (rc != EOK) {
+		printf("%s: Failed registering service: %s\n", NAME,
+		    str_error(rc));
+		return rc;
+	}
+
+	printf("%s: Accepting connections\n", NAME);
+	task_retval(0);
+	async_manager();
+
+	/* Never reached */
+	return 0;
+}
+
+/** @}
+ */
@@ -147,8 +147,6 @@ typedef struct {
 	bool append;
 } vfs_file_t;
 
-extern fibril_mutex_t nodes_mutex;
-
 extern fibril_condvar_t fs_list_cv;
 extern fibril_mutex_t fs_list_lock;
 extern list_t fs_list;		/**< List of registered file systems. */
@@ -180,6 +178,7 @@ extern vfs_info_t *fs_handle_to_info(fs_handle_t);
 extern errno_t vfs_get_fstypes(vfs_fstypes_t *);
 
 extern errno_t vfs_lookup_internal(vfs_node_t *, char *, int, vfs_lookup_res_t *);
+extern void vfs_lookup_cache_purge(void);
 extern errno_t vfs_link_internal(vfs_node_t *, char *, vfs_triplet_t *);
 
 extern bool vfs_nodes_init(void);
@@ -208,12 +207,18 @@ extern void vfs_node_delref(vfs_node_t *);
 extern errno_t vfs_open_node_remote(vfs_node_t *);
 
 extern errno_t vfs_op_clone(int oldfd, int newfd, bool desc, int *);
+extern errno_t vfs_op_copy(int srcfd, int dstfd);
 extern errno_t vfs_op_fsprobe(const char *, service_id_t, vfs_fs_probe_info_t *);
 extern errno_t vfs_op_mount(int mpfd, unsigned servid, unsigned flags, unsigned instance, const char *opts, const char *fsname, int *outfd);
 extern errno_t vfs_op_mtab_get(void);
 extern errno_t vfs_op_open(int fd, int flags);
 extern errno_t vfs_op_put(int fd);
+extern void vfs_client_account_io(bool, size_t);
+extern void vfs_client_get_iostats(uint64_t *, uint64_t *, uint64_t *,
+    uint64_t *);
 extern errno_t vfs_op_read(int fd, aoff64_t, size_t *out_bytes);
+extern errno_t vfs_op_readdir_stat(int fd, aoff64_t *, void *, size_t,
+    size_t *, size_t *);
 extern errno_t vfs_op_rename(int basefd, char *old, char *new);
 extern errno_t vfs_op_resize(int fd, int64_t size);
 extern errno_t vfs_op_stat(int fd);
@@ -228,6 +233,7 @@ extern errno_t vfs_op_write(int fd, aoff64_t, size_t *out_bytes);
 extern void vfs_register(ipc_call_t *);
 
 extern void vfs_page_in(ipc_call_t *);
+extern void vfs_pager_invalidate(vfs_triplet_t *, aoff64_t, size_t);
 
 typedef struct {
 	void *buffer;
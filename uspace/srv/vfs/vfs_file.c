@@ -55,6 +55,12 @@ typedef struct {
 	fibril_condvar_t cv;
 	list_t passed_handles;
 	vfs_file_t **files;
+
+	/** I/O accounting of this client */
+	uint64_t bytes_read;
+	uint64_t bytes_written;
+	uint64_t read_ops;
+	uint64_t write_ops;
 } vfs_client_data_t;
 
 typedef struct {
@@ -108,6 +114,40 @@ static void vfs_files_done(vfs_client_data_t *vfs_data)
 	}
 }
 
+/** Account one I/O operation of the calling client.
+ *
+ * @param write True for writes, false for reads.
+ * @param nbytes Bytes transferred.
+ */
+void vfs_client_account_io(bool write, size_t nbytes)
+{
+	vfs_client_data_t *vfs_data = VFS_DATA;
+
+	fibril_mutex_lock(&vfs_data->lock);
+	if (write) {
+		vfs_data->write_ops++;
+		vfs_data->bytes_written += nbytes;
+	} else {
+		vfs_data->read_ops++;
+		vfs_data->bytes_read += nbytes;
+	}
+	fibril_mutex_unlock(&vfs_data->lock);
+}
+
+/** Report the calling client's accumulated I/O counters. */
+void vfs_client_get_iostats(uint64_t *bytes_read, uint64_t *bytes_written,
+    uint64_t *read_ops, uint64_t *write_ops)
+{
+	vfs_client_data_t *vfs_data = VFS_DATA;
+
+	fibril_mutex_lock(&vfs_data->lock);
+	*bytes_read = vfs_data->bytes_read;
+	*bytes_written = vfs_data->bytes_written;
+	*read_ops = vfs_data->read_ops;
+	*write_ops = vfs_data->write_ops;
+	fibril_mutex_unlock(&vfs_data->lock);
+}
+
 void *vfs_client_data_create(void)
 {
 	vfs_client_data_t *vfs_data;
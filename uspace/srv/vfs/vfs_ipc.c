@@ -45,6 +45,14 @@ static void vfs_in_clone(ipc_call_t *req)
 	async_answer_1(req, rc, outfd);
 }
 
+static void vfs_in_copy(ipc_call_t *req)
+{
+	int srcfd = ipc_get_arg1(req);
+	int dstfd = ipc_get_arg2(req);
+	errno_t rc = vfs_op_copy(srcfd, dstfd);
+	async_answer_0(req, rc);
+}
+
 static void vfs_in_fsprobe(ipc_call_t *req)
 {
 	service_id_t service_id = (service_id_t) ipc_get_arg1(req);
@@ -183,6 +191,54 @@ static void vfs_in_read(ipc_call_t *req)
 	async_answer_1(req, rc, bytes);
 }
 
+static void vfs_in_readdir_stat(ipc_call_t *req)
+{
+	int fd = ipc_get_arg1(req);
+	aoff64_t pos = MERGE_LOUP32(ipc_get_arg2(req), ipc_get_arg3(req));
+
+	ipc_call_t dcall;
+	size_t size;
+	if (!async_data_read_receive(&dcall, &size)) {
+		async_answer_0(&dcall, EINVAL);
+		async_answer_0(req, EINVAL);
+		return;
+	}
+
+	void *buf = malloc(size);
+	if (buf == NULL) {
+		async_answer_0(&dcall, ENOMEM);
+		async_answer_0(req, ENOMEM);
+		return;
+	}
+
+	size_t used;
+	size_t count;
+	errno_t rc = vfs_op_readdir_stat(fd, &pos, buf, size, &used, &count);
+	if (rc == EOK) {
+		async_data_read_finalize(&dcall, buf, used);
+		async_answer_3(req, EOK, count, LOWER32(pos), UPPER32(pos));
+	} else {
+		async_answer_0(&dcall, rc);
+		async_answer_0(req, rc);
+	}
+
+	free(buf);
+}
+
+static void vfs_in_get_iostats(ipc_call_t *req)
+{
+	uint64_t bytes_read;
+	uint64_t bytes_written;
+	uint64_t read_ops;
+	uint64_t write_ops;
+
+	vfs_client_get_iostats(&bytes_read, &bytes_written, &read_ops,
+	    &write_ops);
+
+	async_answer_4(req, EOK, bytes_read, bytes_written, read_ops,
+	    write_ops);
+}
+
 static void vfs_in_rename(ipc_call_t *req)
 {
 	/* The common base directory. */
@@ -338,6 +394,9 @@ void vfs_connection(ipc_call_t *icall, void *arg)
 		case VFS_IN_CLONE:
 			vfs_in_clone(&call);
 			break;
+		case VFS_IN_COPY:
+			vfs_in_copy(&call);
+			break;
 		case VFS_IN_FSPROBE:
 			vfs_in_fsprobe(&call);
 			break;
@@ -356,6 +415,12 @@ void vfs_connection(ipc_call_t *icall, void *arg)
 		case VFS_IN_READ:
 			vfs_in_read(&call);
 			break;
+		case VFS_IN_READDIR_STAT:
+			vfs_in_readdir_stat(&call);
+			break;
+		case VFS_IN_GET_IOSTATS:
+			vfs_in_get_iostats(&call);
+			break;
 		case VFS_IN_REGISTER:
 			vfs_register(&call);
 			cont = false;
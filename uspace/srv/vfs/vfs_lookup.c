@@ -237,6 +237,124 @@ static errno_t out_lookup(vfs_triplet_t *base, size_t *pfirst, size_t *plen,
 	return EOK;
 }
 
+/*
+ * Pathname lookup cache.
+ *
+ * Successful plain lookups are remembered in a small direct-mapped
+ * cache keyed by the base node and the canonical path, saving the
+ * IPC round trip to the filesystem server for repeated lookups of
+ * the same names. A hit is only served while the target node is
+ * still present in the node table, whose live size and type are
+ * authoritative. Any namespace-changing lookup (create, unlink,
+ * link, mountpoint access) conservatively purges the whole cache.
+ */
+
+#define DCACHE_BUCKETS    128
+#define DCACHE_PATH_MAX   64
+
+typedef struct {
+	bool valid;
+	vfs_triplet_t base;
+	int lflag;
+	char path[DCACHE_PATH_MAX];
+	vfs_triplet_t res;
+	vfs_node_type_t type;
+} dcache_entry_t;
+
+static dcache_entry_t dcache[DCACHE_BUCKETS];
+static FIBRIL_MUTEX_INITIALIZE(dcache_lock);
+
+static size_t dcache_hash(vfs_triplet_t *base, const char *path, int lflag)
+{
+	size_t hash = 5381;
+
+	hash = hash * 33 + base->fs_handle;
+	hash = hash * 33 + base->service_id;
+	hash = hash * 33 + base->index;
+	hash = hash * 33 + (size_t) lflag;
+
+	for (const char *p = path; *p != 0; p++)
+		hash = hash * 33 + (uint8_t) *p;
+
+	return hash % DCACHE_BUCKETS;
+}
+
+/** Drop all cached pathname lookups.
+ *
+ * Called around every namespace-changing lookup and whenever a mount
+ * point is activated or deactivated.
+ */
+void vfs_lookup_cache_purge(void)
+{
+	fibril_mutex_lock(&dcache_lock);
+	for (size_t i = 0; i < DCACHE_BUCKETS; i++)
+		dcache[i].valid = false;
+	fibril_mutex_unlock(&dcache_lock);
+}
+
+/** Try to serve a lookup from the cache.
+ *
+ * @return True on a hit with @a result filled in.
+ */
+static bool dcache_lookup(vfs_node_t *base, const char *path, int lflag,
+    vfs_lookup_res_t *result)
+{
+	vfs_triplet_t *bt = (vfs_triplet_t *) base;
+	size_t idx = dcache_hash(bt, path, lflag);
+
+	fibril_mutex_lock(&dcache_lock);
+
+	dcache_entry_t *entry = &dcache[idx];
+	if ((!entry->valid) || (entry->lflag != lflag) ||
+	    (entry->base.fs_handle != bt->fs_handle) ||
+	    (entry->base.service_id != bt->service_id) ||
+	    (entry->base.index != bt->index) ||
+	    (str_cmp(entry->path, path) != 0)) {
+		fibril_mutex_unlock(&dcache_lock);
+		return false;
+	}
+
+	vfs_lookup_res_t res;
+	res.triplet = entry->res;
+
+	fibril_mutex_unlock(&dcache_lock);
+
+	/*
+	 * Serve the hit only while the node is alive; its current
+	 * size and type are the authoritative ones.
+	 */
+	vfs_node_t *node = vfs_node_peek(&res);
+	if (!node)
+		return false;
+
+	result->triplet = *((vfs_triplet_t *) node);
+	result->type = node->type;
+	result->size = node->size;
+	vfs_node_put(node);
+
+	return true;
+}
+
+/** Remember a successful lookup. */
+static void dcache_insert(vfs_node_t *base, const char *path, int lflag,
+    vfs_lookup_res_t *result)
+{
+	vfs_triplet_t *bt = (vfs_triplet_t *) base;
+	size_t idx = dcache_hash(bt, path, lflag);
+
+	fibril_mutex_lock(&dcache_lock);
+
+	dcache_entry_t *entry = &dcache[idx];
+	entry->valid = true;
+	entry->base = *bt;
+	entry->lflag = lflag;
+	str_cpy(entry->path, DCACHE_PATH_MAX, path);
+	entry->res = result->triplet;
+	entry->type = result->type;
+
+	fibril_mutex_unlock(&dcache_lock);
+}
+
 static errno_t _vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
     vfs_lookup_res_t *result, size_t len)
 {
@@ -350,6 +468,16 @@ errno_t vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
 
 	assert(path[0] == '/');
 
+	/*
+	 * Lookups which may change the namespace invalidate the whole
+	 * lookup cache, both before and after performing the change so
+	 * that no concurrent lookup can re-insert the old state while
+	 * the change is in flight; correctness over cleverness.
+	 */
+	bool mutating = (lflag & (L_CREATE | L_UNLINK)) != 0;
+	if (mutating)
+		vfs_lookup_cache_purge();
+
 	if (lflag & (L_CREATE | L_UNLINK)) {
 
 		/*
@@ -387,8 +515,25 @@ errno_t vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
 
 		vfs_node_put(parent);
 
+		vfs_lookup_cache_purge();
+
 	} else {
+		/*
+		 * Plain lookups of short paths can be served from and
+		 * feed the lookup cache; namespace-changing flags
+		 * purge it instead.
+		 */
+		bool cacheable = ((lflag &
+		    ~(L_FILE | L_DIRECTORY)) == 0) &&
+		    (result != NULL) && (len < DCACHE_PATH_MAX);
+
+		if (cacheable && dcache_lookup(base, path, lflag, result))
+			return EOK;
+
 		rc = _vfs_lookup_internal(base, path, lflag, result, len);
+
+		if (cacheable && rc == EOK)
+			dcache_insert(base, path, lflag, result);
 	}
 
 	return rc;
@@ -46,14 +46,22 @@
 #include <errno.h>
 #include <macros.h>
 
-/** Mutex protecting the VFS node hash table. */
-FIBRIL_MUTEX_INITIALIZE(nodes_mutex);
-
 #define NODES_BUCKETS_LOG	8
 #define NODES_BUCKETS		(1 << NODES_BUCKETS_LOG)
 
-/** VFS node hash table containing all active, in-memory VFS nodes. */
-hash_table_t nodes;
+/**
+ * Number of shards of the VFS node table. Every node belongs to
+ * exactly one shard, selected by the hash of its triplet, with its
+ * own lock and hash table, so operations on unrelated nodes do not
+ * contend.
+ */
+#define NODES_SHARDS		16
+
+/** Locks protecting the individual VFS node hash table shards. */
+static fibril_mutex_t nodes_mutex[NODES_SHARDS];
+
+/** Sharded VFS node hash table containing all active, in-memory VFS nodes. */
+static hash_table_t nodes[NODES_SHARDS];
 
 #define KEY_FS_HANDLE	0
 #define KEY_DEV_HANDLE	1
@@ -79,7 +87,26 @@ hash_table_ops_t nodes_ops = {
  */
 bool vfs_nodes_init(void)
 {
-	return hash_table_create(&nodes, 0, 0, &nodes_ops);
+	for (unsigned int i = 0; i < NODES_SHARDS; i++) {
+		fibril_mutex_initialize(&nodes_mutex[i]);
+		if (!hash_table_create(&nodes[i], 0, 0, &nodes_ops))
+			return false;
+	}
+
+	return true;
+}
+
+/** Return the shard index a triplet belongs to. */
+static size_t nodes_shard(const vfs_triplet_t *tri)
+{
+	return nodes_key_hash(tri) % NODES_SHARDS;
+}
+
+/** Return the shard index a node belongs to. */
+static size_t node_shard(vfs_node_t *node)
+{
+	vfs_triplet_t tri = node_triplet(node);
+	return nodes_shard(&tri);
 }
 
 static inline void _vfs_node_addref(vfs_node_t *node)
@@ -93,9 +120,11 @@ static inline void _vfs_node_addref(vfs_node_t *node)
  */
 void vfs_node_addref(vfs_node_t *node)
 {
-	fibril_mutex_lock(&nodes_mutex);
+	size_t shard = node_shard(node);
+
+	fibril_mutex_lock(&nodes_mutex[shard]);
 	_vfs_node_addref(node);
-	fibril_mutex_unlock(&nodes_mutex);
+	fibril_mutex_unlock(&nodes_mutex[shard]);
 }
 
 /** Decrement reference count of a VFS node.
@@ -107,8 +136,9 @@ void vfs_node_addref(vfs_node_t *node)
 void vfs_node_delref(vfs_node_t *node)
 {
 	bool free_node = false;
+	size_t shard = node_shard(node);
 
-	fibril_mutex_lock(&nodes_mutex);
+	fibril_mutex_lock(&nodes_mutex[shard]);
 
 	node->refcnt--;
 	if (node->refcnt == 0) {
@@ -117,11 +147,11 @@ void vfs_node_delref(vfs_node_t *node)
 		 * Remove it from the VFS node hash table.
 		 */
 
-		hash_table_remove_item(&nodes, &node->nh_link);
+		hash_table_remove_item(&nodes[shard], &node->nh_link);
 		free_node = true;
 	}
 
-	fibril_mutex_unlock(&nodes_mutex);
+	fibril_mutex_unlock(&nodes_mutex[shard]);
 
 	if (free_node) {
 		/*
@@ -147,9 +177,11 @@ void vfs_node_delref(vfs_node_t *node)
  */
 void vfs_node_forget(vfs_node_t *node)
 {
-	fibril_mutex_lock(&nodes_mutex);
-	hash_table_remove_item(&nodes, &node->nh_link);
-	fibril_mutex_unlock(&nodes_mutex);
+	size_t shard = node_shard(node);
+
+	fibril_mutex_lock(&nodes_mutex[shard]);
+	hash_table_remove_item(&nodes[shard], &node->nh_link);
+	fibril_mutex_unlock(&nodes_mutex[shard]);
 	free(node);
 }
 
@@ -169,12 +201,14 @@ vfs_node_t *vfs_node_get(vfs_lookup_res_t *result)
 {
 	vfs_node_t *node;
 
-	fibril_mutex_lock(&nodes_mutex);
-	ht_link_t *tmp = hash_table_find(&nodes, &result->triplet);
+	size_t shard = nodes_shard(&result->triplet);
+
+	fibril_mutex_lock(&nodes_mutex[shard]);
+	ht_link_t *tmp = hash_table_find(&nodes[shard], &result->triplet);
 	if (!tmp) {
 		node = (vfs_node_t *) malloc(sizeof(vfs_node_t));
 		if (!node) {
-			fibril_mutex_unlock(&nodes_mutex);
+			fibril_mutex_unlock(&nodes_mutex[shard]);
 			return NULL;
 		}
 		memset(node, 0, sizeof(vfs_node_t));
@@ -184,13 +218,13 @@ vfs_node_t *vfs_node_get(vfs_lookup_res_t *result)
 		node->size = result->size;
 		node->type = result->type;
 		fibril_rwlock_initialize(&node->contents_rwlock);
-		hash_table_insert(&nodes, &node->nh_link);
+		hash_table_insert(&nodes[shard], &node->nh_link);
 	} else {
 		node = hash_table_get_inst(tmp, vfs_node_t, nh_link);
 	}
 
 	_vfs_node_addref(node);
-	fibril_mutex_unlock(&nodes_mutex);
+	fibril_mutex_unlock(&nodes_mutex[shard]);
 
 	return node;
 }
@@ -199,13 +233,15 @@ vfs_node_t *vfs_node_peek(vfs_lookup_res_t *result)
 {
 	vfs_node_t *node = NULL;
 
-	fibril_mutex_lock(&nodes_mutex);
-	ht_link_t *tmp = hash_table_find(&nodes, &result->triplet);
+	size_t shard = nodes_shard(&result->triplet);
+
+	fibril_mutex_lock(&nodes_mutex[shard]);
+	ht_link_t *tmp = hash_table_find(&nodes[shard], &result->triplet);
 	if (tmp) {
 		node = hash_table_get_inst(tmp, vfs_node_t, nh_link);
 		_vfs_node_addref(node);
 	}
-	fibril_mutex_unlock(&nodes_mutex);
+	fibril_mutex_unlock(&nodes_mutex[shard]);
 
 	return node;
 }
@@ -251,9 +287,11 @@ vfs_nodes_refcount_sum_get(fs_handle_t fs_handle, service_id_t service_id)
 		.service_id = service_id
 	};
 
-	fibril_mutex_lock(&nodes_mutex);
-	hash_table_apply(&nodes, refcnt_visitor, &rd);
-	fibril_mutex_unlock(&nodes_mutex);
+	for (unsigned int i = 0; i < NODES_SHARDS; i++) {
+		fibril_mutex_lock(&nodes_mutex[i]);
+		hash_table_apply(&nodes[i], refcnt_visitor, &rd);
+		fibril_mutex_unlock(&nodes_mutex[i]);
+	}
 
 	return rd.refcnt;
 }
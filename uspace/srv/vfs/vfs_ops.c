@@ -271,6 +271,7 @@ errno_t vfs_op_mount(int mpfd, unsigned service_id, unsigned flags,
 		vfs_node_addref(mp->node);
 		vfs_node_addref(root);
 		mp->node->mount = root;
+		vfs_lookup_cache_purge();
 	}
 
 	fibril_rwlock_write_unlock(&namespace_rwlock);
@@ -495,6 +496,17 @@ static errno_t vfs_rdwr(int fd, aoff64_t pos, bool read, rdwr_ipc_cb_t ipc_cb,
 		fibril_rwlock_write_unlock(&file->node->contents_rwlock);
 	}
 
+	if ((!read) && (rc == EOK)) {
+		/*
+		 * Let future page faults observe the new contents.
+		 * The exact number of bytes written is known only to
+		 * the client; invalidating from the write position to
+		 * the end of the file errs on the safe side.
+		 */
+		vfs_pager_invalidate((vfs_triplet_t *) file->node, pos,
+		    (size_t) -1);
+	}
+
 	vfs_file_put(file);
 
 	return rc;
@@ -507,7 +519,100 @@ errno_t vfs_rdwr_internal(int fd, aoff64_t pos, bool read, rdwr_io_chunk_t *chun
 
 errno_t vfs_op_read(int fd, aoff64_t pos, size_t *out_bytes)
 {
-	return vfs_rdwr(fd, pos, true, rdwr_ipc_client, out_bytes);
+	errno_t rc = vfs_rdwr(fd, pos, true, rdwr_ipc_client, out_bytes);
+
+	if (rc == EOK)
+		vfs_client_account_io(false, *out_bytes);
+
+	return rc;
+}
+
+/** Batched directory enumeration with per-entry stat data.
+ *
+ * Reads directory entries starting at @a *pos and packs them
+ * together with their size and type (obtained by a server-side
+ * lookup, which hits the lookup cache) into @a buf, so a client
+ * listing a directory needs one exchange per buffer instead of a
+ * path walk and stat per entry.
+ */
+errno_t vfs_op_readdir_stat(int fd, aoff64_t *pos, void *buf, size_t size,
+    size_t *used, size_t *count)
+{
+	char name[256];
+	char path[257];
+
+	*used = 0;
+	*count = 0;
+
+	vfs_file_t *file = vfs_file_get(fd);
+	if (!file)
+		return EBADF;
+
+	if (file->node->type != VFS_NODE_DIRECTORY) {
+		vfs_file_put(file);
+		return EINVAL;
+	}
+
+	errno_t rc = EOK;
+
+	while (true) {
+		rdwr_io_chunk_t chunk = {
+			.buffer = name,
+			.size = sizeof(name) - 1
+		};
+
+		rc = vfs_rdwr_internal(fd, *pos, true, &chunk);
+		if ((rc != EOK) || (chunk.size == 0))
+			break;
+
+		name[sizeof(name) - 1] = '\0';
+
+		size_t nsz = str_size(name) + 1;
+		size_t recsz = VFS_DIRENT_STAT_RECSZ(nsz);
+		if (*used + recsz > size) {
+			/* Buffer full; the entry stays for next time. */
+			break;
+		}
+
+		/* Look the entry up to learn its size and type. */
+		path[0] = '/';
+		str_cpy(path + 1, sizeof(path) - 1, name);
+
+		vfs_lookup_res_t lr;
+		fibril_rwlock_read_lock(&namespace_rwlock);
+		errno_t lrc = vfs_lookup_internal(file->node, path, L_NONE,
+		    &lr);
+		fibril_rwlock_read_unlock(&namespace_rwlock);
+
+		vfs_dirent_stat_t *rec = (vfs_dirent_stat_t *)
+		    ((uint8_t *) buf + *used);
+
+		if (lrc == EOK) {
+			rec->size = lr.size;
+			rec->service = lr.triplet.service_id;
+			rec->is_directory = (lr.type == VFS_NODE_DIRECTORY);
+		} else {
+			/* Possibly a stale entry; report it bare. */
+			rec->size = 0;
+			rec->service = 0;
+			rec->is_directory = false;
+		}
+
+		memcpy(rec->name, name, nsz);
+		memset((uint8_t *) buf + *used + sizeof(*rec) + nsz, 0,
+		    recsz - sizeof(*rec) - nsz);
+
+		*used += recsz;
+		(*count)++;
+		*pos += chunk.size;
+	}
+
+	vfs_file_put(file);
+
+	if ((*count == 0) && (rc != EOK) && (rc != ENOENT))
+		return rc;
+
+	return EOK;
 }
 
 errno_t vfs_op_rename(int basefd, char *old, char *new)
@@ -626,14 +731,91 @@ errno_t vfs_op_resize(int fd, int64_t size)
 
 	errno_t rc = vfs_truncate_internal(file->node->fs_handle,
 	    file->node->service_id, file->node->index, size);
-	if (rc == EOK)
+	if (rc == EOK) {
 		file->node->size = size;
 
+		/* Cached file pages are stale beyond the new size. */
+		vfs_pager_invalidate((vfs_triplet_t *) file->node,
+		    (aoff64_t) size, (size_t) -1);
+	}
+
 	fibril_rwlock_write_unlock(&file->node->contents_rwlock);
 	vfs_file_put(file);
 	return rc;
 }
 
+/** Copy a whole file server-side within one file system instance */
+errno_t vfs_op_copy(int srcfd, int dstfd)
+{
+	vfs_file_t *src = vfs_file_get(srcfd);
+	if (!src)
+		return EBADF;
+
+	vfs_file_t *dst = vfs_file_get(dstfd);
+	if (!dst) {
+		vfs_file_put(src);
+		return EBADF;
+	}
+
+	errno_t rc;
+
+	if (!src->open_read || !dst->open_write ||
+	    (src->node->type != VFS_NODE_FILE) ||
+	    (dst->node->type != VFS_NODE_FILE)) {
+		rc = EINVAL;
+		goto out;
+	}
+
+	/* Only within one file system instance. */
+	if ((src->node->fs_handle != dst->node->fs_handle) ||
+	    (src->node->service_id != dst->node->service_id)) {
+		rc = EXDEV;
+		goto out;
+	}
+
+	if (src->node == dst->node) {
+		rc = EOK;
+		goto out;
+	}
+
+	/* Lock the two nodes in a stable order to avoid deadlocks. */
+	vfs_node_t *first = (src->node < dst->node) ? src->node : dst->node;
+	vfs_node_t *second = (src->node < dst->node) ? dst->node : src->node;
+
+	if (first == src->node) {
+		fibril_rwlock_read_lock(&first->contents_rwlock);
+		fibril_rwlock_write_lock(&second->contents_rwlock);
+	} else {
+		fibril_rwlock_write_lock(&first->contents_rwlock);
+		fibril_rwlock_read_lock(&second->contents_rwlock);
+	}
+
+	async_exch_t *exch = vfs_exchange_grab(src->node->fs_handle);
+
+	sysarg_t size_lo;
+	sysarg_t size_hi;
+	rc = async_req_3_2(exch, VFS_OUT_COPY, src->node->service_id,
+	    src->node->index, dst->node->index, &size_lo, &size_hi);
+
+	vfs_exchange_release(exch);
+
+	if (rc == EOK) {
+		dst->node->size = MERGE_LOUP32(size_lo, size_hi);
+
+		/* Any cached pages of the old contents are stale. */
+		vfs_pager_invalidate((vfs_triplet_t *) dst->node, 0,
+		    (size_t) -1);
+	}
+
+	fibril_rwlock_write_unlock(&dst->node->contents_rwlock);
+	fibril_rwlock_read_unlock(&src->node->contents_rwlock);
+
+out:
+	vfs_file_put(dst);
+	vfs_file_put(src);
+	return rc;
+}
+
 errno_t vfs_op_stat(int fd)
 {
 	vfs_file_t *file = vfs_file_get(fd);
@@ -825,6 +1007,7 @@ errno_t vfs_op_unmount(int mpfd)
 	vfs_node_forget(mp->node->mount);
 	vfs_node_put(mp->node);
 	mp->node->mount = NULL;
+	vfs_lookup_cache_purge();
 
 	fibril_rwlock_write_unlock(&namespace_rwlock);
 
@@ -920,7 +1103,12 @@ errno_t vfs_op_walk(int parentfd, int flags, char *path, int *out_fd)
 
 errno_t vfs_op_write(int fd, aoff64_t pos, size_t *out_bytes)
 {
-	return vfs_rdwr(fd, pos, false, rdwr_ipc_client, out_bytes);
+	errno_t rc = vfs_rdwr(fd, pos, false, rdwr_ipc_client, out_bytes);
+
+	if (rc == EOK)
+		vfs_client_account_io(true, *out_bytes);
+
+	return rc;
 }
 
 /**
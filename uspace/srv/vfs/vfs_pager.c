@@ -40,15 +40,120 @@
 #include <fibril_synch.h>
 #include <errno.h>
 #include <as.h>
+#include <stdlib.h>
+
+/*
+ * Pager page cache.
+ *
+ * Pages faulted in from files are kept around in a small cache keyed
+ * by the file's node triplet and offset. A repeated fault on the
+ * same file page (by the same or another task) is answered from the
+ * cache without any filesystem I/O, and because all mappings are
+ * served from the one cached copy, shared mappings of a file observe
+ * one coherent page instead of the private throw-away copies the
+ * pager used to hand out. Writes through the VFS purge the affected
+ * file's pages.
+ */
+
+#define PAGER_CACHE_PAGES  64
+
+typedef struct {
+	bool valid;
+	vfs_triplet_t triplet;
+	aoff64_t offset;
+	size_t size;
+	void *page;
+} pager_page_t;
+
+static pager_page_t pager_cache[PAGER_CACHE_PAGES];
+static FIBRIL_MUTEX_INITIALIZE(pager_cache_lock);
+
+static size_t pager_cache_slot(vfs_triplet_t *triplet, aoff64_t offset)
+{
+	size_t hash = triplet->fs_handle * 31 + triplet->service_id;
+	hash = hash * 31 + triplet->index;
+	hash = hash * 31 + (size_t) offset;
+	return hash % PAGER_CACHE_PAGES;
+}
+
+/** Drop cached pages of a file overlapping a byte range.
+ *
+ * Called by the write path so that future faults observe the new
+ * contents.
+ *
+ * @param triplet File identity.
+ * @param pos     Start of the modified range.
+ * @param size    Size of the modified range.
+ */
+void vfs_pager_invalidate(vfs_triplet_t *triplet, aoff64_t pos, size_t size)
+{
+	fibril_mutex_lock(&pager_cache_lock);
+
+	for (size_t i = 0; i < PAGER_CACHE_PAGES; i++) {
+		pager_page_t *pp = &pager_cache[i];
+
+		if ((!pp->valid) ||
+		    (pp->triplet.fs_handle != triplet->fs_handle) ||
+		    (pp->triplet.service_id != triplet->service_id) ||
+		    (pp->triplet.index != triplet->index))
+			continue;
+
+		/* (size_t) -1 means "to the end of the file". */
+		bool overlap = (pos < pp->offset + pp->size);
+		if (size != (size_t) -1)
+			overlap = overlap && (pp->offset < pos + size);
+
+		if (overlap) {
+			as_area_destroy(pp->page);
+			pp->valid = false;
+		}
+	}
+
+	fibril_mutex_unlock(&pager_cache_lock);
+}
 
 void vfs_page_in(ipc_call_t *req)
 {
-	aoff64_t offset = ipc_get_arg1(req);
+	/*
+	 * ARG1 is the offset within the paged area; ID2 of the mapping
+	 * (ARG4) holds the file offset the area starts at, so that a
+	 * mapping need not begin at the start of the file.
+	 */
+	aoff64_t offset = ipc_get_arg1(req) + ipc_get_arg4(req);
 	size_t page_size = ipc_get_arg2(req);
 	int fd = ipc_get_arg3(req);
 	void *page;
 	errno_t rc;
 
+	/* Establish the identity of the backing file. */
+	vfs_triplet_t triplet;
+	bool have_triplet = false;
+
+	vfs_file_t *file = vfs_file_get(fd);
+	if (file != NULL) {
+		triplet = *((vfs_triplet_t *) file->node);
+		have_triplet = true;
+		vfs_file_put(file);
+	}
+
+	/* Serve a repeated fault from the page cache. */
+	if (have_triplet) {
+		size_t slot = pager_cache_slot(&triplet, offset);
+
+		fibril_mutex_lock(&pager_cache_lock);
+		pager_page_t *pp = &pager_cache[slot];
+		if ((pp->valid) && (pp->offset == offset) &&
+		    (pp->size == page_size) &&
+		    (pp->triplet.fs_handle == triplet.fs_handle) &&
+		    (pp->triplet.service_id == triplet.service_id) &&
+		    (pp->triplet.index == triplet.index)) {
+			async_answer_1(req, EOK, (sysarg_t) pp->page);
+			fibril_mutex_unlock(&pager_cache_lock);
+			return;
+		}
+		fibril_mutex_unlock(&pager_cache_lock);
+	}
+
 	page = as_area_create(AS_AREA_ANY, page_size,
 	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
 	    AS_AREA_UNPAGED);
@@ -79,12 +184,23 @@ void vfs_page_in(ipc_call_t *req)
 
 	async_answer_1(req, rc, (sysarg_t) page);
 
-	/*
-	 * FIXME:
-	 * This is just for now until we implement proper page cache
-	 * management.  Not keeping the pages around in a cache results in
-	 * inherently non-coherent private mappings.
-	 */
+	if ((rc == EOK) && (have_triplet)) {
+		/* Keep the page for future faults. */
+		size_t slot = pager_cache_slot(&triplet, offset);
+
+		fibril_mutex_lock(&pager_cache_lock);
+		pager_page_t *pp = &pager_cache[slot];
+		if (pp->valid)
+			as_area_destroy(pp->page);
+		pp->valid = true;
+		pp->triplet = triplet;
+		pp->offset = offset;
+		pp->size = page_size;
+		pp->page = page;
+		fibril_mutex_unlock(&pager_cache_lock);
+		return;
+	}
+
 	as_area_destroy(page);
 }
 
@@ -58,6 +58,16 @@ LIST_INITIALIZE(fs_list);
 
 static atomic_int fs_handle_next = 1;
 
+/**
+ * Direct-indexed cache of file system sessions, filled at
+ * registration time. File systems are never unregistered, so a
+ * non-NULL entry stays valid forever and vfs_exchange_grab() can use
+ * it without taking fs_list_lock. Handles beyond the cache capacity
+ * fall back to the locked list search.
+ */
+#define FS_SESS_CACHE  32
+static async_sess_t *fs_sess_cache[FS_SESS_CACHE];
+
 /** Verify the VFS info structure.
  *
  * @param info Info structure to be verified.
@@ -231,6 +241,8 @@ void vfs_register(ipc_call_t *req)
 	 * system a global file system handle.
 	 */
 	fs_info->fs_handle = atomic_fetch_add(&fs_handle_next, 1);
+	if (fs_info->fs_handle < FS_SESS_CACHE)
+		fs_sess_cache[fs_info->fs_handle] = fs_info->sess;
 	async_answer_1(req, EOK, (sysarg_t) fs_info->fs_handle);
 
 	fibril_condvar_broadcast(&fs_list_cv);
@@ -251,10 +263,14 @@ void vfs_register(ipc_call_t *req)
 async_exch_t *vfs_exchange_grab(fs_handle_t handle)
 {
 	/*
-	 * For now, we don't try to be very clever and very fast.
-	 * We simply lookup the session in fs_list and
-	 * begin an exchange.
+	 * The common case is served lock-free from the registration
+	 * time session cache; file systems are never unregistered, so
+	 * a cached session cannot go away.
 	 */
+	if ((handle > 0) && (handle < FS_SESS_CACHE) &&
+	    (fs_sess_cache[handle] != NULL))
+		return async_exchange_begin(fs_sess_cache[handle]);
+
 	fibril_mutex_lock(&fs_list_lock);
 
 	list_foreach(fs_list, fs_link, fs_info_t, fs) {
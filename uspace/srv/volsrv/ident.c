@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup volsrv
+ * @{
+ */
+/**
+ * @file Persistent partition identity cache.
+ *
+ * Remembers which filesystem type was last detected on each
+ * partition (keyed by the stable service name) across restarts.
+ * Probing consults the cache to try the remembered type first, so a
+ * mount storm at startup costs one filesystem probe per partition
+ * instead of one per known filesystem type. Entries are only hints:
+ * every probe still verifies the type against the partition's actual
+ * contents.
+ */
+
+#include <adt/list.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <sif.h>
+#include <stdlib.h>
+#include <str.h>
+
+#include "ident.h"
+
+/** One remembered partition identity. */
+typedef struct {
+	link_t lidents;
+	char *svc_name;
+	char *fstype;
+	sif_node_t *nident;
+} vol_ident_t;
+
+static FIBRIL_MUTEX_INITIALIZE(idents_lock);
+static LIST_INITIALIZE(idents);
+static sif_sess_t *idents_repo = NULL;
+static sif_node_t *idents_nidents = NULL;
+
+/** Find an identity entry by service name. Idents lock must be held. */
+static vol_ident_t *vol_ident_find(const char *svc_name)
+{
+	list_foreach(idents, lidents, vol_ident_t, ident) {
+		if (str_cmp(ident->svc_name, svc_name) == 0)
+			return ident;
+	}
+
+	return NULL;
+}
+
+/** Open (or create) the identity cache repository.
+ *
+ * @param cfg_path Path to the SIF repository file.
+ *
+ * @return EOK on success or an error code.
+ */
+errno_t vol_idents_init(const char *cfg_path)
+{
+	sif_sess_t *repo = NULL;
+	sif_trans_t *trans = NULL;
+	sif_node_t *node;
+	errno_t rc;
+
+	rc = sif_open(cfg_path, &repo);
+	if (rc != EOK) {
+		rc = sif_create(cfg_path, &repo);
+		if (rc != EOK)
+			return rc;
+
+		rc = sif_trans_begin(repo, &trans);
+		if (rc != EOK)
+			goto error;
+
+		rc = sif_node_append_child(trans, sif_get_root(repo),
+		    "idents", &idents_nidents);
+		if (rc != EOK)
+			goto error;
+
+		rc = sif_trans_end(trans);
+		if (rc != EOK)
+			goto error;
+
+		trans = NULL;
+		idents_repo = repo;
+		return EOK;
+	}
+
+	node = sif_node_first_child(sif_get_root(repo));
+	if ((node == NULL) || (str_cmp(sif_node_get_type(node),
+	    "idents") != 0)) {
+		rc = EIO;
+		goto error;
+	}
+
+	idents_nidents = node;
+
+	/* Load the entries. */
+	sif_node_t *nident = sif_node_first_child(node);
+	while (nident != NULL) {
+		const char *svc_name = sif_node_get_attr(nident, "svc_name");
+		const char *fstype = sif_node_get_attr(nident, "fstype");
+
+		if ((svc_name != NULL) && (fstype != NULL)) {
+			vol_ident_t *ident = calloc(1, sizeof(vol_ident_t));
+			if (ident == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+
+			ident->svc_name = str_dup(svc_name);
+			ident->fstype = str_dup(fstype);
+			ident->nident = nident;
+
+			if ((ident->svc_name == NULL) ||
+			    (ident->fstype == NULL)) {
+				free(ident->svc_name);
+				free(ident->fstype);
+				free(ident);
+				rc = ENOMEM;
+				goto error;
+			}
+
+			list_append(&ident->lidents, &idents);
+		}
+
+		nident = sif_node_next_child(nident);
+	}
+
+	idents_repo = repo;
+	return EOK;
+error:
+	if (trans != NULL)
+		sif_trans_abort(trans);
+	(void) sif_close(repo);
+	idents_nidents = NULL;
+	return rc;
+}
+
+/** Close the identity cache repository. */
+void vol_idents_fini(void)
+{
+	link_t *link;
+
+	while ((link = list_first(&idents)) != NULL) {
+		vol_ident_t *ident = list_get_instance(link, vol_ident_t,
+		    lidents);
+
+		list_remove(link);
+		free(ident->svc_name);
+		free(ident->fstype);
+		free(ident);
+	}
+
+	if (idents_repo != NULL) {
+		(void) sif_close(idents_repo);
+		idents_repo = NULL;
+	}
+
+	idents_nidents = NULL;
+}
+
+/** Get the remembered filesystem type of a partition.
+ *
+ * @param svc_name Service name of the partition.
+ *
+ * @return Filesystem type name or NULL if none is remembered. The
+ *         string stays valid until the next vol_ident_set() of the
+ *         same partition.
+ */
+const char *vol_ident_get(const char *svc_name)
+{
+	fibril_mutex_lock(&idents_lock);
+	vol_ident_t *ident = vol_ident_find(svc_name);
+	const char *fstype = (ident != NULL) ? ident->fstype : NULL;
+	fibril_mutex_unlock(&idents_lock);
+
+	return fstype;
+}
+
+/** Remember the filesystem type detected on a partition.
+ *
+ * Failures are not fatal; the cache is only a probe accelerator.
+ *
+ * @param svc_name Service name of the partition.
+ * @param fstype   Detected filesystem type name.
+ */
+void vol_ident_set(const char *svc_name, const char *fstype)
+{
+	sif_trans_t *trans = NULL;
+	errno_t rc;
+
+	if (idents_repo == NULL)
+		return;
+
+	fibril_mutex_lock(&idents_lock);
+
+	vol_ident_t *ident = vol_ident_find(svc_name);
+	if ((ident != NULL) && (ident->fstype != NULL) &&
+	    (str_cmp(ident->fstype, fstype) == 0)) {
+		/* Already up to date. */
+		fibril_mutex_unlock(&idents_lock);
+		return;
+	}
+
+	rc = sif_trans_begin(idents_repo, &trans);
+	if (rc != EOK)
+		goto out;
+
+	if (ident == NULL) {
+		ident = calloc(1, sizeof(vol_ident_t));
+		if (ident == NULL)
+			goto out;
+
+		ident->svc_name = str_dup(svc_name);
+		if (ident->svc_name == NULL) {
+			free(ident);
+			ident = NULL;
+			goto out;
+		}
+
+		rc = sif_node_append_child(trans, idents_nidents, "ident",
+		    &ident->nident);
+		if (rc != EOK) {
+			free(ident->svc_name);
+			free(ident);
+			ident = NULL;
+			goto out;
+		}
+
+		rc = sif_node_set_attr(trans, ident->nident, "svc_name",
+		    svc_name);
+		if (rc != EOK)
+			goto out;
+
+		list_append(&ident->lidents, &idents);
+	}
+
+	char *new_fstype = str_dup(fstype);
+	if (new_fstype == NULL)
+		goto out;
+
+	free(ident->fstype);
+	ident->fstype = new_fstype;
+
+	rc = sif_node_set_attr(trans, ident->nident, "fstype", fstype);
+	if (rc != EOK)
+		goto out;
+
+	rc = sif_trans_end(trans);
+	trans = NULL;
+
+out:
+	if (trans != NULL)
+		sif_trans_abort(trans);
+	fibril_mutex_unlock(&idents_lock);
+}
+
+/** @}
+ */
@@ -36,6 +36,7 @@
 
 #include <adt/list.h>
 #include <errno.h>
+#include <fibril.h>
 #include <fibril_synch.h>
 #include <io/log.h>
 #include <loc.h>
@@ -48,11 +49,15 @@
 
 #include "empty.h"
 #include "mkfs.h"
+#include "ident.h"
 #include "part.h"
 #include "types/part.h"
 #include "volume.h"
 
 static errno_t vol_part_add_locked(vol_parts_t *, service_id_t);
+static errno_t vol_part_create_locked(vol_parts_t *, service_id_t,
+    vol_part_t **);
+static void vol_parts_probe_new(vol_parts_t *, vol_part_t **, size_t);
 static void vol_part_remove_locked(vol_part_t *);
 static errno_t vol_part_find_by_id_ref_locked(vol_parts_t *, service_id_t,
     vol_part_t **);
@@ -100,6 +105,23 @@ static errno_t vol_part_check_new(vol_parts_t *parts)
 
 	fibril_mutex_lock(&parts->lock);
 
+	/*
+	 * Category change events only say that something changed
+	 * somewhere. Remember the location service generation of the
+	 * last sweep so that events which bring no news (e.g. those
+	 * queued up while the previous sweep ran) do not cause another
+	 * full re-read of the partition list.
+	 */
+	sysarg_t gen;
+	rc = loc_get_generation(&gen);
+	if ((rc == EOK) && (gen == parts->loc_gen)) {
+		fibril_mutex_unlock(&parts->lock);
+		return EOK;
+	}
+
+	if (rc == EOK)
+		parts->loc_gen = gen;
+
 	rc = loc_category_get_id("partition", &part_cat, IPC_FLAG_BLOCKING);
 	if (rc != EOK) {
 		log_msg(LOG_DEFAULT, LVL_ERROR, "Failed resolving category 'partition'.");
@@ -115,7 +137,16 @@ static errno_t vol_part_check_new(vol_parts_t *parts)
 		return EIO;
 	}
 
-	/* Check for new partitions */
+	/*
+	 * Check for new partitions. The new ones are only created
+	 * here; probing and mounting them talks to other services
+	 * and runs afterwards, in parallel, without the list lock -
+	 * plugging a multi-disk enclosure does not freeze volume
+	 * management while each partition is probed in turn.
+	 */
+	size_t nnew = 0;
+	vol_part_t **new_parts = calloc(count, sizeof(vol_part_t *));
+
 	for (i = 0; i < count; i++) {
 		already_known = false;
 
@@ -130,14 +161,32 @@ static errno_t vol_part_check_new(vol_parts_t *parts)
 		if (!already_known) {
 			log_msg(LOG_DEFAULT, LVL_DEBUG, "Found partition '%lu'",
 			    (unsigned long) svcs[i]);
-			rc = vol_part_add_locked(parts, svcs[i]);
-			if (rc != EOK) {
-				log_msg(LOG_DEFAULT, LVL_ERROR, "Could not add "
-				    "partition.");
+
+			if (new_parts == NULL) {
+				/* Degraded mode: probe serially. */
+				rc = vol_part_add_locked(parts, svcs[i]);
+				if (rc != EOK) {
+					log_msg(LOG_DEFAULT, LVL_ERROR,
+					    "Could not add partition.");
+				}
+				continue;
 			}
+
+			rc = vol_part_create_locked(parts, svcs[i],
+			    &new_parts[nnew]);
+			if (rc == EOK)
+				nnew++;
 		}
 	}
 
+	if (nnew > 0) {
+		fibril_mutex_unlock(&parts->lock);
+		vol_parts_probe_new(parts, new_parts, nnew);
+		fibril_mutex_lock(&parts->lock);
+	}
+
+	free(new_parts);
+
 	/* Check for removed partitions */
 	cur = list_first(&parts->parts);
 	while (cur != NULL) {
@@ -213,17 +262,41 @@ static errno_t vol_part_probe(vol_part_t *part)
 
 	assert(fibril_mutex_is_locked(&part->parts->lock));
 
-	fst = &fstab[0];
-	while (fst->name != NULL) {
-		rc = vfs_fsprobe(fst->name, part->svc_id, &info);
-		if (rc == EOK)
-			break;
-		++fst;
+	/*
+	 * Try the filesystem type remembered for this partition from
+	 * a previous run first; the probe itself verifies the hint
+	 * against the partition's actual contents.
+	 */
+	fst = NULL;
+	const char *cached = vol_ident_get(part->svc_name);
+	if (cached != NULL) {
+		struct fsname_type *cf = &fstab[0];
+		while (cf->name != NULL) {
+			if (str_cmp(cf->name, cached) == 0) {
+				rc = vfs_fsprobe(cf->name, part->svc_id,
+				    &info);
+				if (rc == EOK)
+					fst = cf;
+				break;
+			}
+			++cf;
+		}
+	}
+
+	if (fst == NULL) {
+		fst = &fstab[0];
+		while (fst->name != NULL) {
+			rc = vfs_fsprobe(fst->name, part->svc_id, &info);
+			if (rc == EOK)
+				break;
+			++fst;
+		}
 	}
 
 	if (fst->name != NULL) {
 		log_msg(LOG_DEFAULT, LVL_DEBUG, "Found %s, label '%s'",
 		    fst->name, info.label);
+		vol_ident_set(part->svc_name, fst->name);
 		label = str_dup(info.label);
 		if (label == NULL) {
 			rc = ENOMEM;
@@ -405,13 +478,58 @@ static errno_t vol_part_mount(vol_part_t *part)
 	return rc;
 }
 
-static errno_t vol_part_add_locked(vol_parts_t *parts, service_id_t sid)
+/** Probe and publish a partition; runs without the list lock.
+ *
+ * The probe and the (potentially slow) mount talk to other
+ * services, so they must not block the partition list. Insertion
+ * re-checks for duplicates in case of a concurrent add.
+ */
+static errno_t vol_part_probe_insert(vol_parts_t *parts, vol_part_t *part)
+{
+	vol_part_t *dup;
+	errno_t rc;
+
+	rc = vol_part_probe(part);
+	if (rc != EOK)
+		goto error;
+
+	rc = vol_part_mount(part);
+	if (rc != EOK)
+		goto error;
+
+	fibril_mutex_lock(&parts->lock);
+	rc = vol_part_find_by_id_ref_locked(parts, part->svc_id, &dup);
+	if (rc == EOK) {
+		vol_part_del_ref(dup);
+		fibril_mutex_unlock(&parts->lock);
+		rc = EEXIST;
+		goto error;
+	}
+
+	list_append(&part->lparts, &parts->parts);
+	fibril_mutex_unlock(&parts->lock);
+
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "Added partition %zu", part->svc_id);
+
+	return EOK;
+
+error:
+	vol_part_delete(part);
+	return rc;
+}
+
+/** Create a partition structure for probing.
+ *
+ * Takes care of duplicate checking under the list lock; the
+ * returned partition is not yet published.
+ */
+static errno_t vol_part_create_locked(vol_parts_t *parts, service_id_t sid,
+    vol_part_t **rpart)
 {
 	vol_part_t *part;
 	errno_t rc;
 
 	assert(fibril_mutex_is_locked(&parts->lock));
-	log_msg(LOG_DEFAULT, LVL_DEBUG, "vol_part_add_locked(%zu)", sid);
 
 	/* Check for duplicates */
 	rc = vol_part_find_by_id_ref_locked(parts, sid, &part);
@@ -432,25 +550,102 @@ static errno_t vol_part_add_locked(vol_parts_t *parts, service_id_t sid)
 	rc = loc_service_get_name(sid, &part->svc_name);
 	if (rc != EOK) {
 		log_msg(LOG_DEFAULT, LVL_ERROR, "Failed getting service name.");
-		goto error;
+		vol_part_delete(part);
+		return rc;
 	}
 
-	rc = vol_part_probe(part);
-	if (rc != EOK)
-		goto error;
+	*rpart = part;
+	return EOK;
+}
 
-	rc = vol_part_mount(part);
-	if (rc != EOK)
-		goto error;
+/** Work shared by the partition probe fibrils */
+typedef struct {
+	vol_parts_t *parts;
+	vol_part_t **new_parts;
+	size_t count;
+	size_t next;
+	size_t running;
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+} vol_probe_work_t;
+
+static errno_t vol_probe_fibril(void *arg)
+{
+	vol_probe_work_t *work = (vol_probe_work_t *) arg;
+
+	while (true) {
+		fibril_mutex_lock(&work->lock);
+		if (work->next >= work->count) {
+			work->running--;
+			fibril_condvar_signal(&work->cv);
+			fibril_mutex_unlock(&work->lock);
+			return EOK;
+		}
 
-	list_append(&part->lparts, &parts->parts);
+		vol_part_t *part = work->new_parts[work->next++];
+		fibril_mutex_unlock(&work->lock);
 
-	log_msg(LOG_DEFAULT, LVL_DEBUG, "Added partition %zu", part->svc_id);
+		errno_t rc = vol_part_probe_insert(work->parts, part);
+		if (rc != EOK && rc != EEXIST) {
+			log_msg(LOG_DEFAULT, LVL_ERROR,
+			    "Could not add partition.");
+		}
+	}
+}
 
-	return EOK;
+/** Probe and publish a batch of new partitions in parallel */
+static void vol_parts_probe_new(vol_parts_t *parts, vol_part_t **new_parts,
+    size_t count)
+{
+	vol_probe_work_t work;
+
+	work.parts = parts;
+	work.new_parts = new_parts;
+	work.count = count;
+	work.next = 0;
+	fibril_mutex_initialize(&work.lock);
+	fibril_condvar_initialize(&work.cv);
+
+	size_t nworkers = (count < 4) ? count : 4;
+	work.running = nworkers;
+
+	for (size_t i = 1; i < nworkers; i++) {
+		fid_t fid = fibril_create(vol_probe_fibril, &work);
+		if (fid == 0) {
+			fibril_mutex_lock(&work.lock);
+			work.running--;
+			fibril_mutex_unlock(&work.lock);
+			continue;
+		}
+
+		fibril_add_ready(fid);
+	}
+
+	/* Probe along with the workers. */
+	vol_probe_fibril(&work);
+
+	fibril_mutex_lock(&work.lock);
+	while (work.running > 0)
+		fibril_condvar_wait(&work.cv, &work.lock);
+	fibril_mutex_unlock(&work.lock);
+}
+
+static errno_t vol_part_add_locked(vol_parts_t *parts, service_id_t sid)
+{
+	vol_part_t *part;
+	errno_t rc;
+
+	assert(fibril_mutex_is_locked(&parts->lock));
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "vol_part_add_locked(%zu)", sid);
+
+	rc = vol_part_create_locked(parts, sid, &part);
+	if (rc != EOK)
+		return rc;
+
+	fibril_mutex_unlock(&parts->lock);
+	rc = vol_part_probe_insert(parts, part);
+	fibril_mutex_lock(&parts->lock);
 
-error:
-	vol_part_delete(part);
 	return rc;
 }
 
@@ -495,6 +690,8 @@ errno_t vol_parts_create(vol_volumes_t *volumes, vol_parts_t **rparts)
 	fibril_mutex_initialize(&parts->lock);
 	list_initialize(&parts->parts);
 	parts->volumes = volumes;
+	/* Force the first sweep regardless of the current generation */
+	parts->loc_gen = (sysarg_t) -1;
 
 	*rparts = parts;
 	return EOK;
@@ -77,6 +77,8 @@ typedef struct vol_parts {
 	list_t parts;
 	/** Underlying volumes */
 	struct vol_volumes *volumes;
+	/** Location service generation of the last partition sweep */
+	sysarg_t loc_gen;
 } vol_parts_t;
 
 #endif
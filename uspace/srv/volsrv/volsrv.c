@@ -48,11 +48,13 @@
 
 #include "mkfs.h"
 #include "part.h"
+#include "ident.h"
 #include "volume.h"
 
 #define NAME  "volsrv"
 
 const char *vol_cfg_file = "/cfg/volsrv.sif";
+const char *vol_ident_cfg_file = "/cfg/volsrv-ident.sif";
 
 static void vol_client_conn(ipc_call_t *, void *);
 
@@ -64,6 +66,9 @@ static errno_t vol_init(void)
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "vol_init()");
 
+	/* Best effort; the identity cache is only a probe accelerator. */
+	(void) vol_idents_init(vol_ident_cfg_file);
+
 	rc = vol_volumes_create(vol_cfg_file, &volumes);
 	if (rc != EOK)
 		goto error;